@@ -14,6 +14,9 @@
 #include <common/bl_common.h>
 #include <common/debug.h>
 #include <common/desc_image_load.h>
+#if IMAGE_PREFETCH
+#include <common/image_prefetch.h>
+#endif
 #include <drivers/auth/auth_mod.h>
 #include <plat/common/platform.h>
 
@@ -41,6 +44,14 @@ struct entry_point_info *bl2_load_images(void)
 	assert(bl2_load_info->h.version >= VERSION_2);
 	bl2_node_info = bl2_load_info->head;
 
+#if IMAGE_PREFETCH
+	/*
+	 * The descriptor list (after any platform/storage-order rework)
+	 * is the load sequence the prefetcher anticipates.
+	 */
+	image_prefetch_plan(bl2_load_info);
+#endif
+
 	while (bl2_node_info) {
 		/*
 		 * Perform platform setup before loading the image,
@@ -41,6 +41,19 @@ BL31_SOURCES		+=	bl31/bl31_main.c				\
 
 ifeq (${ENABLE_PMF}, 1)
 BL31_SOURCES		+=	lib/pmf/pmf_main.c
+ifeq (${SMC_LATENCY_TRACE}, 1)
+BL31_SOURCES		+=	lib/pmf/pmf_smc_trace.c
+endif
+ifeq (${SEC_EXEC_BUDGET}, 1)
+BL31_SOURCES		+=	common/sec_budget.c
+endif
+ifeq (${STACK_HWM}, 1)
+BL31_SOURCES		+=	common/stack_hwm.c
+endif
+endif
+
+ifeq (${BENCH_SVC}, 1)
+BL31_SOURCES		+=	services/std_svc/bench_svc.c
 endif
 
 ifeq (${EL3_EXCEPTION_HANDLING},1)
@@ -67,6 +80,18 @@ BL31_SOURCES		+=	lib/extensions/amu/aarch64/amu.c		\
 				lib/extensions/amu/aarch64/amu_helpers.S
 endif
 
+ifeq (${ENABLE_STATIC_BRANCH},1)
+BL31_SOURCES		+=	lib/static_branch/static_branch.c
+endif
+
+ifeq (${ENABLE_MEM_GUARD},1)
+BL31_SOURCES		+=	lib/mem_guard/mem_guard.c
+endif
+
+ifeq (${ENABLE_ERRATA_PRUNING},1)
+BL31_SOURCES		+=	lib/cpus/errata_prune.c
+endif
+
 ifeq (${ENABLE_SVE_FOR_NS},1)
 BL31_SOURCES		+=	lib/extensions/sve/sve.c
 endif
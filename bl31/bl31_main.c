@@ -16,9 +16,12 @@
 #include <common/debug.h>
 #include <common/runtime_svc.h>
 #include <drivers/console.h>
+#include <lib/cpus/errata_prune.h>
 #include <lib/el3_runtime/context_mgmt.h>
+#include <lib/el3_runtime/cpu_data.h>
 #include <lib/pmf/pmf.h>
 #include <lib/runtime_instr.h>
+#include <lib/static_branch.h>
 #include <plat/common/platform.h>
 #include <services/std_svc.h>
 
@@ -61,6 +64,9 @@ uintptr_t get_arm_std_svc_args(unsigned int svc_mask)
  ******************************************************************************/
 void __init bl31_lib_init(void)
 {
+#if CPU_DATA_CACHELINE_AUDIT
+	cpu_data_audit_check_granule();
+#endif
 	cm_init();
 }
 
@@ -134,6 +140,16 @@ void bl31_main(void)
 		if (rc == 0)
 			WARN("BL31: BL32 initialization failed\n");
 	}
+
+	/*
+	 * All services have registered and every static key has its final
+	 * value: prune the erratum workarounds that do not apply to this
+	 * silicon and rewrite the recorded branch sites before the first
+	 * ERET to a lower EL.
+	 */
+	errata_prune();
+	static_branch_apply();
+
 	/*
 	 * We are ready to enter the next EL. Prepare entry into the image
 	 * corresponding to the desired security state after the next ERET.
@@ -99,9 +99,12 @@ static int get_pe_highest_active_idx(pe_exc_data_t *pe_data)
 void ehf_activate_priority(unsigned int priority)
 {
 	int cur_pri_idx;
-	unsigned int old_mask, run_pri, idx;
+	unsigned int old_mask, idx;
 	pe_exc_data_t *pe_data = this_cpu_data();
 
+#if ENABLE_ASSERTIONS
+	unsigned int run_pri;
+
 	/*
 	 * Query interrupt controller for the running priority, or idle priority
 	 * if no interrupts are being handled. The requested priority must be
@@ -113,35 +116,42 @@ void ehf_activate_priority(unsigned int priority)
 				run_pri, priority);
 		panic();
 	}
+#endif
+
+	cur_pri_idx = get_pe_highest_active_idx(pe_data);
+	idx = pri_to_idx(priority);
 
+#if ENABLE_ASSERTIONS
 	/*
 	 * If there were priority activations already, the requested priority
 	 * must be less (higher priority) than the current highest priority
 	 * activation so far.
 	 */
-	cur_pri_idx = get_pe_highest_active_idx(pe_data);
-	idx = pri_to_idx(priority);
 	if ((cur_pri_idx != EHF_INVALID_IDX) &&
 			(idx >= ((unsigned int) cur_pri_idx))) {
 		ERROR("Activation priority mismatch: req=0x%x current=0x%x\n",
 				priority, IDX_TO_PRI(cur_pri_idx));
 		panic();
 	}
+#endif
 
 	/* Set the bit corresponding to the requested priority */
 	pe_data->active_pri_bits |= PRI_BIT(idx);
 
+	/* Program priority mask for the activated level */
+	old_mask = plat_ic_set_priority_mask(priority);
+
+#if ENABLE_ASSERTIONS
 	/*
-	 * Program priority mask for the activated level. Check that the new
-	 * priority mask is setting a higher priority level than the existing
-	 * mask.
+	 * Check that the new priority mask is setting a higher priority level
+	 * than the existing mask.
 	 */
-	old_mask = plat_ic_set_priority_mask(priority);
 	if (priority >= old_mask) {
 		ERROR("Requested priority (0x%x) lower than Priority Mask (0x%x)\n",
 				priority, old_mask);
 		panic();
 	}
+#endif
 
 	/*
 	 * If this is the first activation, save the priority mask. This will be
@@ -167,7 +177,10 @@ void ehf_deactivate_priority(unsigned int priority)
 {
 	int cur_pri_idx;
 	pe_exc_data_t *pe_data = this_cpu_data();
-	unsigned int old_mask, run_pri, idx;
+	unsigned int old_mask __unused;
+
+#if ENABLE_ASSERTIONS
+	unsigned int run_pri, idx;
 
 	/*
 	 * Query interrupt controller for the running priority, or idle priority
@@ -194,6 +207,7 @@ void ehf_deactivate_priority(unsigned int priority)
 				priority, IDX_TO_PRI(cur_pri_idx));
 		panic();
 	}
+#endif
 
 	/* Clear bit corresponding to highest priority */
 	pe_data->active_pri_bits &= (pe_data->active_pri_bits - 1u);
@@ -208,11 +222,13 @@ void ehf_deactivate_priority(unsigned int priority)
 	else
 		old_mask = plat_ic_set_priority_mask(priority);
 
+#if ENABLE_ASSERTIONS
 	if (old_mask > priority) {
 		ERROR("Deactivation priority (0x%x) lower than Priority Mask (0x%x)\n",
 				priority, old_mask);
 		panic();
 	}
+#endif
 
 	EHF_LOG("deactivate prio=%d\n", get_pe_highest_active_idx(pe_data));
 }
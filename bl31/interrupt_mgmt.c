@@ -9,6 +9,7 @@
 
 #include <common/bl_common.h>
 #include <bl31/interrupt_mgmt.h>
+#include <lib/cassert.h>
 #include <lib/el3_runtime/context_mgmt.h>
 #include <plat/common/platform.h>
 
@@ -38,9 +39,22 @@ typedef struct intr_type_desc {
 	interrupt_type_handler_t handler;
 	uint32_t flags;
 	uint32_t scr_el3[2];
-} intr_type_desc_t;
+} __aligned(1 << INTR_TYPE_DESC_SIZE_SHIFT) intr_type_desc_t;
 
-static intr_type_desc_t intr_type_descs[MAX_INTR_TYPES];
+/*
+ * The table doubles as the dispatch table consulted by the exception vector
+ * code with a single indexed load, so its layout is fixed by the constants in
+ * interrupt_mgmt.h. It holds one extra entry for INTR_TYPE_INVAL which never
+ * has a handler registered: a spurious interrupt reported by the interrupt
+ * controller indexes that entry and takes the same NULL-handler exit as an
+ * unregistered type, without a separate validation branch on the hot path.
+ */
+intr_type_desc_t intr_type_descs[MAX_INTR_TYPES + 1];
+
+CASSERT(__builtin_offsetof(intr_type_desc_t, handler) ==
+	INTR_TYPE_DESC_HANDLER, assert_intr_type_desc_handler_offset_mismatch);
+CASSERT(sizeof(intr_type_desc_t) == (1U << INTR_TYPE_DESC_SIZE_SHIFT),
+	assert_intr_type_desc_size_mismatch);
 
 /*******************************************************************************
  * This function validates the interrupt type.
@@ -219,8 +233,13 @@ int32_t register_interrupt_type_handler(uint32_t type,
  ******************************************************************************/
 interrupt_type_handler_t get_interrupt_type_handler(uint32_t type)
 {
-	if (validate_interrupt_type(type) != 0)
-		return NULL;
+	/*
+	 * Branch-free lookup for the interrupt dispatch path: out of range
+	 * types collapse onto the INTR_TYPE_INVAL entry, which never holds a
+	 * registered handler.
+	 */
+	if (type > MAX_INTR_TYPES)
+		type = INTR_TYPE_INVAL;
 
 	return intr_type_descs[type].handler;
 }
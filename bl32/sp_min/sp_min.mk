@@ -21,6 +21,34 @@ BL32_SOURCES		+=	bl32/sp_min/sp_min_main.c		\
 
 ifeq (${ENABLE_PMF}, 1)
 BL32_SOURCES		+=	lib/pmf/pmf_main.c
+ifeq (${SMC_LATENCY_TRACE}, 1)
+BL32_SOURCES		+=	lib/pmf/pmf_smc_trace.c
+endif
+ifeq (${SEC_EXEC_BUDGET}, 1)
+BL32_SOURCES		+=	common/sec_budget.c
+endif
+ifeq (${SMC_RATE_LIMIT}, 1)
+BL32_SOURCES		+=	common/smc_rate_limit.c
+endif
+ifeq (${STACK_HWM}, 1)
+BL32_SOURCES		+=	common/stack_hwm.c
+endif
+endif
+
+ifeq (${BENCH_SVC}, 1)
+BL32_SOURCES		+=	services/std_svc/bench_svc.c
+endif
+
+ifeq (${ENABLE_STATIC_BRANCH},1)
+BL32_SOURCES		+=	lib/static_branch/static_branch.c
+endif
+
+ifeq (${ENABLE_MEM_GUARD},1)
+BL32_SOURCES		+=	lib/mem_guard/mem_guard.c
+endif
+
+ifeq (${ENABLE_ERRATA_PRUNING},1)
+BL32_SOURCES		+=	lib/cpus/errata_prune.c
 endif
 
 ifeq (${ENABLE_AMU}, 1)
@@ -54,3 +82,24 @@ $(eval $(call assert_boolean,RESET_TO_SP_MIN))
 SP_MIN_WITH_SECURE_FIQ 	?= 0
 $(eval $(call add_define,SP_MIN_WITH_SECURE_FIQ))
 $(eval $(call assert_boolean,SP_MIN_WITH_SECURE_FIQ))
+
+# Flag to answer constant-result query SMCs (version and revision probes)
+# straight from the exception vector, before the register context is saved.
+# The platform enabling it provides sp_min_fast_smc_table, see
+# include/bl32/sp_min/sp_min_fast_smc.h. It is default disabled.
+SP_MIN_FAST_SMC		?= 0
+$(eval $(call add_define,SP_MIN_FAST_SMC))
+$(eval $(call assert_boolean,SP_MIN_FAST_SMC))
+
+# Flag to switch the VFP/Neon context lazily: the unit is disarmed on entry
+# from the normal world and the normal world's register bank is only saved,
+# through an Undefined Instruction trap, if the secure world actually issues
+# a VFP instruction. The platform port is free to override this value. It is
+# default disabled and requires VFP support in the CPU and the toolchain.
+SP_MIN_LAZY_FP_CONTEXT	?= 0
+$(eval $(call add_define,SP_MIN_LAZY_FP_CONTEXT))
+$(eval $(call assert_boolean,SP_MIN_LAZY_FP_CONTEXT))
+
+ifeq (${SP_MIN_LAZY_FP_CONTEXT},1)
+BL32_SOURCES		+=	bl32/sp_min/aarch32/fp_lazy_context.S
+endif
@@ -13,13 +13,17 @@
 
 #include <arch.h>
 #include <arch_helpers.h>
+#include <bl31/interrupt_mgmt.h>
 #include <common/bl_common.h>
 #include <common/debug.h>
 #include <common/runtime_svc.h>
 #include <context.h>
 #include <drivers/console.h>
+#include <lib/cpus/errata_prune.h>
 #include <lib/el3_runtime/context_mgmt.h>
+#include <lib/el3_runtime/cpu_data.h>
 #include <lib/psci/psci.h>
+#include <lib/static_branch.h>
 #include <lib/utils.h>
 #include <plat/common/platform.h>
 #include <platform_sp_min.h>
@@ -170,6 +174,10 @@ void sp_min_main(void)
 	NOTICE("SP_MIN: %s\n", version_string);
 	NOTICE("SP_MIN: %s\n", build_message);
 
+#if CPU_DATA_CACHELINE_AUDIT
+	cpu_data_audit_check_granule();
+#endif
+
 	/* Perform the SP_MIN platform setup */
 	sp_min_platform_setup();
 
@@ -177,6 +185,15 @@ void sp_min_main(void)
 	INFO("SP_MIN: Initializing runtime services\n");
 	runtime_svc_init();
 
+	/*
+	 * All services have registered and every static key has its final
+	 * value: prune the erratum workarounds that do not apply to this
+	 * silicon and rewrite the recorded branch sites before the first
+	 * ERET to the normal world.
+	 */
+	errata_prune();
+	static_branch_apply();
+
 	/*
 	 * We are ready to enter the next EL. Prepare entry into the image
 	 * corresponding to the desired security state after the next ERET.
@@ -235,8 +252,16 @@ void sp_min_fiq(void)
 {
 	uint32_t id;
 
-	id = plat_ic_acknowledge_interrupt();
-	sp_min_plat_fiq_handler(id);
-	plat_ic_end_of_interrupt(id);
+	/*
+	 * Secure interrupt sources can raise bursts of several interrupts
+	 * in close succession. Keep draining the highest priority pending
+	 * group 0 interrupt until none is left, so that a burst costs a
+	 * single world switch instead of one per interrupt.
+	 */
+	do {
+		id = plat_ic_acknowledge_interrupt();
+		sp_min_plat_fiq_handler(id);
+		plat_ic_end_of_interrupt(id);
+	} while (plat_ic_get_pending_interrupt_type() == INTR_TYPE_S_EL1);
 }
 #endif /* SP_MIN_WITH_SECURE_FIQ */
@@ -9,6 +9,7 @@
 #include <stdint.h>
 
 #include <arch_helpers.h>
+#include <common/crash_ram.h>
 #include <common/debug.h>
 #include <drivers/console.h>
 
@@ -214,6 +215,32 @@ static struct frame_record *adjust_frame_record(struct frame_record *fr)
 #endif
 }
 
+#if CRASH_RAM_CAPTURE
+/* Addresses collected while unwinding, recorded in the crash RAM region */
+static uintptr_t unwind_trace[UNWIND_LIMIT];
+static unsigned int unwind_trace_count;
+
+static void record_address(uintptr_t addr)
+{
+	unwind_trace[unwind_trace_count] = addr;
+	unwind_trace_count++;
+}
+
+static void record_trace(void)
+{
+	crash_ram_put_backtrace(unwind_trace, unwind_trace_count);
+	unwind_trace_count = 0U;
+}
+#else
+static void record_address(uintptr_t addr)
+{
+}
+
+static void record_trace(void)
+{
+}
+#endif /* CRASH_RAM_CAPTURE */
+
 static void unwind_stack(struct frame_record *fr, uintptr_t current_pc,
 			 uintptr_t link_register)
 {
@@ -235,6 +262,7 @@ static void unwind_stack(struct frame_record *fr, uintptr_t current_pc,
 
 	/* The level 0 of the backtrace is the current backtrace function */
 	printf(backtrace_str, 0U, el_str, current_pc);
+	record_address(current_pc);
 
 	/*
 	 * The last frame record pointer in the linked list at the beginning of
@@ -268,6 +296,7 @@ static void unwind_stack(struct frame_record *fr, uintptr_t current_pc,
 			return;
 
 		printf(backtrace_str, i, el_str, call_site);
+		record_address(call_site);
 
 		fr = adjust_frame_record(fr->parent);
 	}
@@ -311,6 +340,7 @@ void backtrace(const char *cookie)
 	printf("BACKTRACE: START: %s\n", cookie);
 
 	unwind_stack(fr, (uintptr_t)&backtrace, return_address);
+	record_trace();
 
 	printf("BACKTRACE: END: %s\n", cookie);
 }
@@ -13,7 +13,12 @@
 #include <arch_helpers.h>
 #include <common/bl_common.h>
 #include <common/debug.h>
+#if IMAGE_PREFETCH
+#include <common/image_prefetch.h>
+#endif
 #include <drivers/auth/auth_mod.h>
+#include <drivers/auth/crypto_mod.h>
+#include <drivers/console.h>
 #include <drivers/io/io_storage.h>
 #include <lib/utils.h>
 #include <lib/xlat_tables/xlat_tables_defs.h>
@@ -47,6 +52,112 @@ static int dyn_is_auth_disabled(void)
 }
 #endif /* TRUSTED_BOARD_BOOT */
 
+#if PIPELINED_IMAGE_LOAD
+/*
+ * Size of the chunks an image is loaded in when the load is pipelined with
+ * the hash computation. Chosen to fit comfortably in the L2 cache so that
+ * the hash pass over a chunk hits in cache instead of re-reading DDR.
+ */
+#define PIPELINED_LOAD_CHUNK_SIZE	U(0x20000)
+
+/*
+ * Load an image in chunks, streaming each chunk through the crypto hash as
+ * soon as it has been read. The resulting digest is saved for the
+ * authentication module, which then does not need to hash the image again.
+ * 'prefetched' bytes are already present at image_base (staged by the
+ * next-image prefetcher) and only need the hash pass, not the read.
+ */
+static int load_image_pipelined(uintptr_t image_handle, uintptr_t image_base,
+				size_t image_size, size_t prefetched)
+{
+	unsigned char digest[CRYPTO_MAX_DIGEST_SIZE];
+	unsigned int digest_len;
+	uintptr_t chunk_base = image_base;
+	size_t remaining = image_size;
+	size_t bytes_read;
+	int io_result;
+	int rc;
+
+	rc = crypto_mod_hash_init();
+	if (rc != CRYPTO_SUCCESS) {
+		return -EAUTH;
+	}
+
+	if (prefetched > 0U) {
+		rc = crypto_mod_hash_update((void *)chunk_base, prefetched);
+		if (rc != CRYPTO_SUCCESS) {
+			return -EAUTH;
+		}
+
+		chunk_base += prefetched;
+		remaining -= prefetched;
+	}
+
+	while (remaining > 0U) {
+		size_t chunk_size = MIN(remaining,
+					(size_t)PIPELINED_LOAD_CHUNK_SIZE);
+
+		io_result = io_read(image_handle, chunk_base, chunk_size,
+				    &bytes_read);
+		if ((io_result != 0) || (bytes_read < chunk_size)) {
+			return (io_result != 0) ? io_result : -EIO;
+		}
+
+		rc = crypto_mod_hash_update((void *)chunk_base, chunk_size);
+		if (rc != CRYPTO_SUCCESS) {
+			return -EAUTH;
+		}
+
+		chunk_base += chunk_size;
+		remaining -= chunk_size;
+	}
+
+	rc = crypto_mod_hash_finish(digest, &digest_len);
+	if (rc != CRYPTO_SUCCESS) {
+		return -EAUTH;
+	}
+
+	crypto_mod_prehash_save((void *)image_base, image_size, digest,
+				digest_len);
+
+	return 0;
+}
+
+/*
+ * Hash an image straight out of a memory-mapped source window and save the
+ * digest for the authentication module. Used instead of the chunked read
+ * pipeline when the boot device is directly addressable and there is no
+ * device transfer to overlap the hash with.
+ */
+static int hash_image_in_place(uintptr_t buffer, uintptr_t image_base,
+			       size_t image_size)
+{
+	unsigned char digest[CRYPTO_MAX_DIGEST_SIZE];
+	unsigned int digest_len;
+	int rc;
+
+	rc = crypto_mod_hash_init();
+	if (rc != CRYPTO_SUCCESS) {
+		return -EAUTH;
+	}
+
+	rc = crypto_mod_hash_update((void *)buffer, image_size);
+	if (rc != CRYPTO_SUCCESS) {
+		return -EAUTH;
+	}
+
+	rc = crypto_mod_hash_finish(digest, &digest_len);
+	if (rc != CRYPTO_SUCCESS) {
+		return -EAUTH;
+	}
+
+	crypto_mod_prehash_save((void *)image_base, image_size, digest,
+				digest_len);
+
+	return 0;
+}
+#endif /* PIPELINED_IMAGE_LOAD */
+
 uintptr_t page_align(uintptr_t value, unsigned dir)
 {
 	/* Round up the limit to the next page boundary */
@@ -73,8 +184,11 @@ static int load_image(unsigned int image_id, image_info_t *image_data)
 	uintptr_t image_handle;
 	uintptr_t image_spec;
 	uintptr_t image_base;
+	uintptr_t image_buf;
 	size_t image_size;
+	size_t buf_len;
 	size_t bytes_read;
+	size_t prefetched = 0U;
 	int io_result;
 
 	assert(image_data != NULL);
@@ -123,8 +237,61 @@ static int load_image(unsigned int image_id, image_info_t *image_data)
 
 	/* We have enough space so load the image now */
 	/* TODO: Consider whether to try to recover/retry a partially successful read */
-	io_result = io_read(image_handle, image_base, image_size, &bytes_read);
-	if ((io_result != 0) || (bytes_read < image_size)) {
+#if IMAGE_PREFETCH
+	prefetched = image_prefetch_consume(image_id, image_base, image_size);
+	if (prefetched > 0U) {
+		io_result = io_seek(image_handle, IO_SEEK_SET,
+				    (signed long long)prefetched);
+		if (io_result != 0) {
+			goto exit;
+		}
+	}
+#endif
+	io_result = io_get_buffer(image_handle, &image_buf, &buf_len);
+	if ((io_result == 0) && (buf_len >= image_size)) {
+		/*
+		 * The image is directly addressable (e.g. a FIP on a
+		 * memory-mapped boot device or a preloaded staging area):
+		 * consume the mapped window in place and only copy when the
+		 * image is not already at its load address.
+		 */
+#if PIPELINED_IMAGE_LOAD
+		if (dyn_is_auth_disabled() == 0) {
+			io_result = hash_image_in_place(image_buf, image_base,
+							image_size);
+		}
+#endif
+		if ((io_result == 0) && (image_buf != image_base)) {
+			memcpy((void *)image_base, (void *)image_buf,
+			       image_size);
+		}
+	} else {
+#if PIPELINED_IMAGE_LOAD
+		if (dyn_is_auth_disabled() == 0) {
+			io_result = load_image_pipelined(image_handle,
+							 image_base,
+							 image_size,
+							 prefetched);
+		} else {
+			io_result = io_read(image_handle,
+					    image_base + prefetched,
+					    image_size - prefetched,
+					    &bytes_read);
+			if ((io_result == 0) &&
+			    (bytes_read < (image_size - prefetched))) {
+				io_result = -EIO;
+			}
+		}
+#else
+		io_result = io_read(image_handle, image_base + prefetched,
+				    image_size - prefetched, &bytes_read);
+		if ((io_result == 0) &&
+		    (bytes_read < (image_size - prefetched))) {
+			io_result = -EIO;
+		}
+#endif
+	}
+	if (io_result != 0) {
 		WARN("Failed to load image id=%u (%i)\n", image_id, io_result);
 		goto exit;
 	}
@@ -170,6 +337,17 @@ static int load_auth_image_internal(unsigned int image_id,
 		return rc;
 	}
 
+#if IMAGE_PREFETCH
+	/*
+	 * The storage device is idle from here until the next load
+	 * starts: stage the opening burst of the next planned image
+	 * before the CPU disappears into the authentication below.
+	 */
+	if (is_parent_image == 0) {
+		image_prefetch_kick(image_id);
+	}
+#endif
+
 #if TRUSTED_BOARD_BOOT
 	if (dyn_is_auth_disabled() == 0) {
 		/* Authenticate it */
@@ -213,10 +391,41 @@ int load_auth_image(unsigned int image_id, image_info_t *image_data)
 {
 	int err;
 
+	/*
+	 * Hold log output back while the image streams in and
+	 * authenticates, so console drain time does not inflate the
+	 * measured load time. Buffered output is emitted on exit.
+	 */
+	console_quiet_enter();
+
 	do {
 		err = load_auth_image_internal(image_id, image_data, 0);
+
+#if TRUSTED_BOARD_BOOT
+		if (err != 0) {
+			/*
+			 * The recorded authentication state may refer to
+			 * certificates from the failing source. Drop it so
+			 * that the next attempt re-verifies the whole chain
+			 * from the source it actually boots from.
+			 */
+			auth_mod_invalidate();
+		}
+#endif /* TRUSTED_BOARD_BOOT */
+
+#if IMAGE_PREFETCH
+		if (err != 0) {
+			/*
+			 * Staged bytes may come from the failing source;
+			 * re-read them from whatever boots next.
+			 */
+			image_prefetch_invalidate();
+		}
+#endif
 	} while ((err != 0) && (plat_try_next_boot_source(image_id) != 0));
 
+	console_quiet_exit();
+
 	return err;
 }
 
@@ -0,0 +1,311 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdbool.h>
+#include <string.h>
+
+#include <platform_def.h>
+
+#include <arch_helpers.h>
+#include <common/crash_ram.h>
+#include <common/debug.h>
+#include <lib/cassert.h>
+#include <lib/utils.h>
+
+/*
+ * Crash/log capture ring in persistent RAM. See common/crash_ram.h for the
+ * region layout. All writes are memory-only and each one is cleaned to the
+ * point of coherency, so the captured state survives a watchdog reset taken
+ * right after the store.
+ *
+ * Writers are not serialized: the record ring is only written from panic
+ * paths and from the boot CPU, and a rare interleaving between two CPUs
+ * panicking at the same time corrupts at worst the records involved, which
+ * is acceptable for diagnostics (same trade-off as the buffered console).
+ */
+
+#define RING_SIZE	(CRASH_RAM_SIZE - CRASH_RAM_RING_OFFSET)
+#define REC_ALIGN	U(4)
+
+CASSERT((CRASH_RAM_SIZE & 0x3U) == 0U, assert_crash_ram_size_misaligned);
+CASSERT(CRASH_RAM_SIZE >= (CRASH_RAM_RING_OFFSET + U(0x100)),
+	assert_crash_ram_too_small);
+
+uint32_t crash_ram_ready;
+
+/* Sequence number the current boot started at, records below are inherited */
+static uint32_t boot_start_seq;
+
+static struct crash_ram_header *crash_ram_hdr(void)
+{
+	return (struct crash_ram_header *)CRASH_RAM_BASE;
+}
+
+static uintptr_t crash_ram_ring(void)
+{
+	return CRASH_RAM_BASE + CRASH_RAM_RING_OFFSET;
+}
+
+static void crash_ram_clean(const void *base, size_t size)
+{
+	flush_dcache_range((uintptr_t)base, size);
+}
+
+void crash_ram_init(void)
+{
+	struct crash_ram_header *hdr = crash_ram_hdr();
+
+	if ((hdr->magic != CRASH_RAM_MAGIC) ||
+	    (hdr->size != CRASH_RAM_SIZE) ||
+	    (hdr->write_off >= RING_SIZE)) {
+		/* Virgin or corrupted region: format it */
+		zeromem((void *)CRASH_RAM_BASE, CRASH_RAM_SIZE);
+		hdr->magic = CRASH_RAM_MAGIC;
+		hdr->size = CRASH_RAM_SIZE;
+	}
+
+	hdr->boot_count++;
+	boot_start_seq = hdr->seq;
+	crash_ram_clean(hdr, sizeof(*hdr));
+
+	crash_ram_ready = 1U;
+}
+
+/*
+ * Append one record to the ring. A record never wraps: when it does not fit
+ * before the end of the ring, the tail is left as an end marker and the
+ * record is written at offset zero, overwriting the oldest data.
+ */
+void crash_ram_put(uint8_t type, const void *data, size_t len)
+{
+	struct crash_ram_header *hdr = crash_ram_hdr();
+	struct crash_ram_record *rec;
+	size_t room;
+
+	if (crash_ram_ready == 0U) {
+		return;
+	}
+
+	/* Truncate records that could never fit */
+	if (len > (RING_SIZE - (2U * sizeof(*rec)))) {
+		len = RING_SIZE - (2U * sizeof(*rec));
+	}
+
+	room = sizeof(*rec) + round_up(len, REC_ALIGN);
+
+	if ((hdr->write_off + room + sizeof(*rec)) > RING_SIZE) {
+		/* Mark the unused tail and wrap */
+		if ((hdr->write_off + sizeof(*rec)) <= RING_SIZE) {
+			rec = (struct crash_ram_record *)
+				(crash_ram_ring() + hdr->write_off);
+			memset(rec, 0, sizeof(*rec));
+			crash_ram_clean(rec, sizeof(*rec));
+		}
+		hdr->write_off = 0U;
+	}
+
+	rec = (struct crash_ram_record *)(crash_ram_ring() + hdr->write_off);
+	rec->type = type;
+	rec->flags = (sizeof(uintptr_t) == sizeof(uint64_t)) ?
+		CRASH_RAM_REC_FLAG_64BIT : 0U;
+	rec->len = (uint16_t)len;
+	rec->seq = hdr->seq;
+	memcpy(rec + 1, data, len);
+	crash_ram_clean(rec, room);
+
+	hdr->seq++;
+	hdr->write_off += room;
+
+	/* Terminate the stream for the decoder */
+	rec = (struct crash_ram_record *)(crash_ram_ring() + hdr->write_off);
+	memset(rec, 0, sizeof(*rec));
+	crash_ram_clean(rec, sizeof(*rec));
+
+	crash_ram_clean(hdr, sizeof(*hdr));
+}
+
+void crash_ram_put_str(const char *str)
+{
+	crash_ram_put(CRASH_RAM_REC_TEXT, str, strlen(str));
+}
+
+void crash_ram_put_backtrace(const uintptr_t *addrs, size_t count)
+{
+	crash_ram_put(CRASH_RAM_REC_BACKTRACE, addrs,
+		      count * sizeof(uintptr_t));
+}
+
+/*
+ * Memory-only part of panic(): record where the panic came from before any
+ * console output is attempted. The payload is the caller PC followed by the
+ * name of the panicking function.
+ */
+void crash_ram_record_panic(const char *func)
+{
+	uint8_t payload[sizeof(uintptr_t) + U(64)];
+	uintptr_t pc = (uintptr_t)__builtin_return_address(0U);
+	size_t name_len = strlen(func);
+
+	if (name_len > (sizeof(payload) - sizeof(pc))) {
+		name_len = sizeof(payload) - sizeof(pc);
+	}
+
+	memcpy(payload, &pc, sizeof(pc));
+	memcpy(payload + sizeof(pc), func, name_len);
+
+	crash_ram_put(CRASH_RAM_REC_PANIC, payload, sizeof(pc) + name_len);
+}
+
+static const struct crash_ram_record *crash_ram_rec_at(uint32_t off)
+{
+	const struct crash_ram_record *rec;
+
+	if ((off + sizeof(*rec)) > RING_SIZE) {
+		return NULL;
+	}
+
+	rec = (const struct crash_ram_record *)(crash_ram_ring() + off);
+	if ((rec->type == CRASH_RAM_REC_END) ||
+	    (rec->type > CRASH_RAM_REC_PANIC) ||
+	    ((off + sizeof(*rec) + rec->len) > RING_SIZE)) {
+		return NULL;
+	}
+
+	return rec;
+}
+
+/* The libc printf has no precision support, bounce strings via a buffer */
+static void crash_ram_copy_str(char *buf, size_t buf_size,
+			       const uint8_t *data, size_t len)
+{
+	if (len >= buf_size) {
+		len = buf_size - 1U;
+	}
+	memcpy(buf, data, len);
+	buf[len] = '\0';
+}
+
+static void crash_ram_print_record(const struct crash_ram_record *rec)
+{
+	const uint8_t *payload = (const uint8_t *)(rec + 1);
+	size_t reg_size = ((rec->flags & CRASH_RAM_REC_FLAG_64BIT) != 0U) ?
+		sizeof(uint64_t) : sizeof(uint32_t);
+	char str[80];
+	uint64_t val;
+	size_t i;
+
+	switch (rec->type) {
+	case CRASH_RAM_REC_TEXT:
+		crash_ram_copy_str(str, sizeof(str), payload, rec->len);
+		printf("  [%u] %s\n", rec->seq, str);
+		break;
+	case CRASH_RAM_REC_BACKTRACE:
+		printf("  [%u] backtrace:\n", rec->seq);
+		for (i = 0U; (i + reg_size) <= rec->len; i += reg_size) {
+			val = 0ULL;
+			memcpy(&val, payload + i, reg_size);
+			printf("    %u: 0x%llx\n",
+			       (unsigned int)(i / reg_size),
+			       (unsigned long long)val);
+		}
+		break;
+	case CRASH_RAM_REC_PANIC:
+		if (rec->len < reg_size) {
+			break;
+		}
+		val = 0ULL;
+		memcpy(&val, payload, reg_size);
+		crash_ram_copy_str(str, sizeof(str), payload + reg_size,
+				   rec->len - reg_size);
+		printf("  [%u] PANIC in %s at 0x%llx\n", rec->seq, str,
+		       (unsigned long long)val);
+		break;
+	default:
+		break;
+	}
+}
+
+static void crash_ram_print_regs(void)
+{
+	const uint32_t *slab =
+		(const uint32_t *)(CRASH_RAM_BASE + CRASH_RAM_REGS_OFFSET);
+	const uint8_t *vals = (const uint8_t *)slab + CRASH_RAM_REGS_VALS;
+	size_t reg_size, count, i;
+	uint64_t val;
+
+	if (slab[0] != CRASH_RAM_REGS_MAGIC) {
+		return;
+	}
+
+	reg_size = (slab[1] == CRASH_RAM_REGS_ARCH_AARCH64) ?
+		sizeof(uint64_t) : sizeof(uint32_t);
+	count = (CRASH_RAM_REGS_SIZE - CRASH_RAM_REGS_VALS) / reg_size;
+
+	printf("  registers (AArch%u):\n", slab[1]);
+	for (i = 0U; i < count; i++) {
+		val = 0ULL;
+		memcpy(&val, vals + (i * reg_size), reg_size);
+		printf("    r%u: 0x%llx\n", (unsigned int)i,
+		       (unsigned long long)val);
+	}
+}
+
+/*
+ * Walk the ring and re-emit in sequence order the records written by
+ * previous boots that were never shown, then release them. The ring is
+ * small, so the repeated minimum scan is cheap and runs once per boot.
+ */
+void crash_ram_drain(void)
+{
+	struct crash_ram_header *hdr = crash_ram_hdr();
+	const struct crash_ram_record *rec, *best;
+	uint32_t off, next_seq, printed = 0U;
+
+	if (crash_ram_ready == 0U) {
+		return;
+	}
+
+	/*
+	 * Records inherited from previous boots have a sequence number below
+	 * boot_start_seq; those below drained_seq were already shown. Print
+	 * them in sequence order by repeated minimum scan: the ring holds a
+	 * few dozen records at most and this runs once per boot.
+	 */
+	next_seq = hdr->drained_seq;
+	while (true) {
+		best = NULL;
+		off = 0U;
+		while ((rec = crash_ram_rec_at(off)) != NULL) {
+			if ((rec->seq >= next_seq) &&
+			    (rec->seq < boot_start_seq) &&
+			    ((best == NULL) || (rec->seq < best->seq))) {
+				best = rec;
+			}
+			off += sizeof(*rec) + round_up(rec->len, REC_ALIGN);
+		}
+		if (best == NULL) {
+			break;
+		}
+		if (printed == 0U) {
+			printf("Crash records from previous boots:\n");
+		}
+		crash_ram_print_record(best);
+		printed++;
+		next_seq = best->seq + 1U;
+	}
+
+	crash_ram_print_regs();
+
+	if (hdr->drained_seq != boot_start_seq) {
+		hdr->drained_seq = boot_start_seq;
+		crash_ram_clean(hdr, sizeof(*hdr));
+	}
+
+	/* The register slab describes a crash that has now been reported */
+	((uint32_t *)(CRASH_RAM_BASE + CRASH_RAM_REGS_OFFSET))[0] = 0U;
+	crash_ram_clean((void *)(CRASH_RAM_BASE + CRASH_RAM_REGS_OFFSET),
+			sizeof(uint32_t));
+}
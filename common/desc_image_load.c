@@ -5,15 +5,104 @@
  */
 
 #include <assert.h>
+#include <stdbool.h>
 
 #include <arch_helpers.h>
 #include <common/bl_common.h>
 #include <common/desc_image_load.h>
 #include <common/tbbr/tbbr_img_def.h>
+#if IMAGE_LOAD_STORAGE_ORDER
+#include <drivers/io/io_fip.h>
+#include <drivers/io/io_storage.h>
+#include <plat/common/platform.h>
+#endif
 
 static bl_load_info_t bl_load_info;
 static bl_params_t next_bl_params;
 
+#if IMAGE_LOAD_STORAGE_ORDER
+/*
+ * Upper bound on the number of images the storage-order scheduler can
+ * handle. Longer descriptor lists keep the declared order.
+ */
+#define STORAGE_ORDER_MAX_IMAGES	16U
+
+/*
+ * Reorder the list of loadable images by the offset at which each image
+ * sits within the FIP, so that a boot from sequential-access storage
+ * (eMMC, NAND) reads the package front to back instead of seeking
+ * backwards between interleaved certificates and payloads.
+ *
+ * Images whose storage offset cannot be resolved (not FIP-backed, or the
+ * ToC cache is cold), images that are not loaded at all and the image
+ * carrying the platform setup attribute act as barriers: they keep their
+ * position and only the images between two barriers are sorted among
+ * themselves. The executable hand-off sequence is described separately
+ * by next_handoff_image_id and is not affected by this reordering.
+ */
+static void sort_load_info_by_storage_offset(bl_load_info_t *load_info)
+{
+	bl_load_info_node_t *nodes[STORAGE_ORDER_MAX_IMAGES];
+	unsigned long long keys[STORAGE_ORDER_MAX_IMAGES];
+	bool movable[STORAGE_ORDER_MAX_IMAGES];
+	bl_load_info_node_t *node;
+	unsigned int num = 0U;
+	unsigned int i;
+	unsigned int j;
+
+	for (node = load_info->head; node != NULL;
+	     node = node->next_load_info) {
+		uintptr_t dev_handle;
+		uintptr_t image_spec;
+
+		if (num == STORAGE_ORDER_MAX_IMAGES) {
+			return;
+		}
+
+		nodes[num] = node;
+		movable[num] = false;
+
+		if (((node->image_info->h.attr &
+		      (IMAGE_ATTRIB_SKIP_LOADING |
+		       IMAGE_ATTRIB_PLAT_SETUP)) == 0U) &&
+		    (plat_get_image_source(node->image_id, &dev_handle,
+					   &image_spec) == 0) &&
+		    (fip_get_entry_offset(
+				&((io_uuid_spec_t *)image_spec)->uuid,
+				&keys[num]) == 0)) {
+			movable[num] = true;
+		}
+		num++;
+	}
+
+	/*
+	 * Stable adjacent-swap sort. Swaps never involve a barrier node,
+	 * so each run of movable images is ordered independently.
+	 */
+	for (i = 0U; i < num; i++) {
+		for (j = 0U; (j + 1U) < num; j++) {
+			if (movable[j] && movable[j + 1U] &&
+			    (keys[j] > keys[j + 1U])) {
+				unsigned long long tmp_key = keys[j];
+				bl_load_info_node_t *tmp_node = nodes[j];
+
+				keys[j] = keys[j + 1U];
+				nodes[j] = nodes[j + 1U];
+				keys[j + 1U] = tmp_key;
+				nodes[j + 1U] = tmp_node;
+			}
+		}
+	}
+
+	/* Re-link the list in the new order. */
+	load_info->head = nodes[0];
+	for (i = 0U; (i + 1U) < num; i++) {
+		nodes[i]->next_load_info = nodes[i + 1U];
+	}
+	nodes[num - 1U]->next_load_info = NULL;
+}
+#endif /* IMAGE_LOAD_STORAGE_ORDER */
+
 
 /*******************************************************************************
  * This function flushes the data structures so that they are visible
@@ -117,6 +206,10 @@ bl_load_info_t *get_bl_load_info_from_mem_params_desc(void)
 		}
 	}
 
+#if IMAGE_LOAD_STORAGE_ORDER
+	sort_load_info_by_storage_offset(&bl_load_info);
+#endif
+
 	return &bl_load_info;
 }
 
@@ -207,3 +207,396 @@ int fdt_add_reserved_memory(void *dtb, const char *node_name,
 
 	return 0;
 }
+
+/*
+ * Batched fixups.
+ *
+ * Each libfdt insertion memmoves everything behind the insertion point, so
+ * a sequence of fixups against a large blob moves most of the tree once per
+ * added property. The batch interface instead builds the new nodes in a
+ * small scratch tree, where those memmoves only shuffle a few dozen bytes,
+ * and grafts them into the target blob on commit with a single back-to-front
+ * repacking pass, so that every byte of the target moves at most once.
+ *
+ * Staged nodes that do not exist in the target are inserted whole at the
+ * end of the root node. For a staged node that already exists in the target
+ * (e.g. /reserved-memory), only its subnodes are grafted and its own
+ * properties are dropped, mirroring the create-if-missing behaviour of the
+ * incremental helpers above.
+ */
+
+/* Maximum number of distinct insertion ranges grafted by one commit. */
+#define FDT_FIXUP_MAX_INSERTS	8
+
+struct fdt_fixup_insert {
+	int dst;	/* structure block offset in the target blob */
+	int stage_off;	/* structure block offset of the range in the stage */
+	int len;	/* length of the copied range in bytes */
+};
+
+/*
+ * Return the structure block offset of the FDT_END_NODE token closing the
+ * node at @node, i.e. the insertion point for new subnodes.
+ */
+static int fdt_node_end_offset(const void *fdt, int node)
+{
+	int offset = node;
+	int depth = 0;
+
+	for (;;) {
+		int next;
+		uint32_t tag = fdt_next_tag(fdt, offset, &next);
+
+		switch (tag) {
+		case FDT_BEGIN_NODE:
+			depth++;
+			break;
+		case FDT_END_NODE:
+			depth--;
+			if (depth == 0)
+				return offset;
+			break;
+		case FDT_PROP:
+		case FDT_NOP:
+			break;
+		default:
+			return -FDT_ERR_BADSTRUCTURE;
+		}
+
+		if (next < 0)
+			return -FDT_ERR_BADSTRUCTURE;
+		offset = next;
+	}
+}
+
+/*
+ * Look up @s in the strings block region [@strtab, @strtab + @size).
+ * Only string start positions are considered, which is exactly where the
+ * commit path appends missing names, so lookups after the append pass
+ * always succeed. Returns the string offset, or -1 if not present.
+ */
+static int fdt_fixup_find_string(const char *strtab, int size, const char *s)
+{
+	int offs = 0;
+
+	while (offs < size) {
+		if (strcmp(strtab + offs, s) == 0)
+			return offs;
+		offs += strlen(strtab + offs) + 1;
+	}
+
+	return -1;
+}
+
+/*******************************************************************************
+ * fdt_fixup_batch_begin() - start collecting fixups for one commit
+ * @batch:	batch state to initialize
+ * @dtb:	pointer to the target device tree blob in memory
+ * @stage_buf:	scratch buffer used to stage the new nodes
+ * @stage_size:	size of @stage_buf, a few hundred bytes per staged node
+ *
+ * Initialize @batch and create an empty staging tree in @stage_buf. The
+ * target blob is not touched until fdt_fixup_batch_commit().
+ *
+ * Return: 0 on success, a negative libfdt error value otherwise.
+ ******************************************************************************/
+int fdt_fixup_batch_begin(struct fdt_fixup_batch *batch, void *dtb,
+			  void *stage_buf, size_t stage_size)
+{
+	int ret;
+
+	ret = fdt_check_header(dtb);
+	if (ret != 0)
+		return ret;
+
+	ret = fdt_create_empty_tree(stage_buf, stage_size);
+	if (ret != 0)
+		return ret;
+
+	batch->dtb = dtb;
+	batch->stage = stage_buf;
+
+	return 0;
+}
+
+/*******************************************************************************
+ * fdt_fixup_batch_psci_node() - stage the PSCI node for a batched commit
+ * @batch:	batch initialized by fdt_fixup_batch_begin()
+ *
+ * Batched counterpart of dt_add_psci_node(): stages the same node and
+ * properties, and leaves an existing /psci node in the target untouched.
+ *
+ * Return: 0 on success, -1 otherwise.
+ ******************************************************************************/
+int fdt_fixup_batch_psci_node(struct fdt_fixup_batch *batch)
+{
+	if (fdt_path_offset(batch->dtb, "/psci") >= 0) {
+		WARN("PSCI Device Tree node already exists!\n");
+		return 0;
+	}
+
+	return dt_add_psci_node(batch->stage);
+}
+
+/*******************************************************************************
+ * fdt_fixup_batch_reserved_memory() - stage a reserved memory region
+ * @batch:	batch initialized by fdt_fixup_batch_begin()
+ * @node_name:	name of the subnode to be used
+ * @base:	physical base address of the reserved region
+ * @size:	size of the reserved region
+ *
+ * Batched counterpart of fdt_add_reserved_memory(). When the target blob
+ * already contains /reserved-memory, only the region subnodes are grafted
+ * into it on commit.
+ *
+ * Return: 0 on success, a negative error value otherwise.
+ ******************************************************************************/
+int fdt_fixup_batch_reserved_memory(struct fdt_fixup_batch *batch,
+				    const char *node_name, uintptr_t base,
+				    size_t size)
+{
+	return fdt_add_reserved_memory(batch->stage, node_name, base, size);
+}
+
+/*******************************************************************************
+ * fdt_fixup_batch_commit() - graft the staged nodes into the target blob
+ * @batch:	batch initialized by fdt_fixup_batch_begin()
+ *
+ * Apply all staged fixups to the target blob in one repacking pass: missing
+ * property name strings are appended to the strings block, the tree tail is
+ * shifted from back to front so each byte moves at most once, and the staged
+ * ranges are copied into the gaps. The blob must have the usual libfdt
+ * layout with the strings block last, and enough spare room between its
+ * current content and its total size.
+ *
+ * Return: 0 on success, a negative libfdt error value otherwise.
+ ******************************************************************************/
+int fdt_fixup_batch_commit(struct fdt_fixup_batch *batch)
+{
+	struct fdt_fixup_insert inserts[FDT_FIXUP_MAX_INSERTS];
+	void *dtb = batch->dtb;
+	void *stage = batch->stage;
+	int off_struct = fdt_off_dt_struct(dtb);
+	int size_struct = fdt_size_dt_struct(dtb);
+	int off_strings = fdt_off_dt_strings(dtb);
+	int size_strings = fdt_size_dt_strings(dtb);
+	char *strtab = (char *)dtb + off_strings;
+	int num = 0, total_len = 0, new_strings = 0;
+	int root_end, s_off, i, shift;
+
+	/* The single repacking pass relies on the strings block being last */
+	if ((off_strings < (off_struct + size_struct)) ||
+	    ((off_strings + size_strings) > (int)fdt_totalsize(dtb)))
+		return -FDT_ERR_BADLAYOUT;
+
+	root_end = fdt_node_end_offset(dtb, 0);
+	if (root_end < 0)
+		return root_end;
+
+	/* Turn each staged first level node into one insertion range */
+	fdt_for_each_subnode(s_off, stage, 0) {
+		const char *name = fdt_get_name(stage, s_off, NULL);
+		int s_end = fdt_node_end_offset(stage, s_off);
+		int t_off;
+
+		if ((name == NULL) || (s_end < 0))
+			return -FDT_ERR_BADSTRUCTURE;
+
+		if (num == FDT_FIXUP_MAX_INSERTS)
+			return -FDT_ERR_NOSPACE;
+
+		t_off = fdt_subnode_offset(dtb, 0, name);
+		if (t_off < 0) {
+			/* New node: graft it whole at the end of the root */
+			inserts[num].dst = root_end;
+			inserts[num].stage_off = s_off;
+			inserts[num].len = s_end + (int)sizeof(fdt32_t) - s_off;
+		} else {
+			/* Existing node: graft the staged subnodes only */
+			int sub = fdt_first_subnode(stage, s_off);
+
+			if (sub < 0)
+				continue;
+
+			inserts[num].dst = fdt_node_end_offset(dtb, t_off);
+			if (inserts[num].dst < 0)
+				return inserts[num].dst;
+
+			inserts[num].stage_off = sub;
+			inserts[num].len = s_end - sub;
+		}
+
+		total_len += inserts[num].len;
+		num++;
+	}
+
+	if (num == 0)
+		return 0;
+
+	if ((off_strings + size_strings + total_len) > (int)fdt_totalsize(dtb))
+		return -FDT_ERR_NOSPACE;
+
+	/* Append the property name strings the target does not have yet */
+	for (i = 0; i < num; i++) {
+		int offs = inserts[i].stage_off;
+		int end = offs + inserts[i].len;
+
+		while (offs < end) {
+			int next, len;
+			const struct fdt_property *prop;
+			const char *name;
+
+			if (fdt_next_tag(stage, offs, &next) != FDT_PROP) {
+				offs = next;
+				continue;
+			}
+
+			prop = fdt_offset_ptr(stage, offs, sizeof(*prop));
+			name = fdt_string(stage,
+					  fdt32_to_cpu(prop->nameoff));
+			offs = next;
+
+			if (fdt_fixup_find_string(strtab,
+						  size_strings + new_strings,
+						  name) >= 0)
+				continue;
+
+			len = strlen(name) + 1;
+			if ((off_strings + size_strings + new_strings + len +
+			     total_len) > (int)fdt_totalsize(dtb))
+				return -FDT_ERR_NOSPACE;
+
+			memcpy(strtab + size_strings + new_strings, name, len);
+			new_strings += len;
+		}
+	}
+
+	/* Sort the insertion points so the tail can be shifted in one pass */
+	for (i = 1; i < num; i++) {
+		struct fdt_fixup_insert tmp = inserts[i];
+		int j;
+
+		for (j = i; (j > 0) && (inserts[j - 1].dst > tmp.dst); j--)
+			inserts[j] = inserts[j - 1];
+		inserts[j] = tmp;
+	}
+
+	/* Shift the tail back to front: each byte moves at most once */
+	shift = total_len;
+	for (i = num - 1; i >= 0; i--) {
+		char *src = (char *)dtb + off_struct + inserts[i].dst;
+		int seg_end = (i == (num - 1)) ?
+			(off_strings + size_strings + new_strings) :
+			(off_struct + inserts[i + 1].dst);
+
+		memmove(src + shift, src,
+			seg_end - (off_struct + inserts[i].dst));
+		shift -= inserts[i].len;
+	}
+
+	/* Copy the staged ranges into the gaps opened above */
+	shift = 0;
+	for (i = 0; i < num; i++) {
+		memcpy((char *)dtb + off_struct + inserts[i].dst + shift,
+		       (char *)stage + fdt_off_dt_struct(stage) +
+		       inserts[i].stage_off, inserts[i].len);
+		shift += inserts[i].len;
+	}
+
+	fdt_set_size_dt_struct(dtb, size_struct + total_len);
+	fdt_set_off_dt_strings(dtb, off_strings + total_len);
+	fdt_set_size_dt_strings(dtb, size_strings + new_strings);
+
+	/* Retarget the property name offsets from the stage strings block */
+	shift = 0;
+	for (i = 0; i < num; i++) {
+		int offs = inserts[i].dst + shift;
+		int end = offs + inserts[i].len;
+
+		while (offs < end) {
+			int next, noff;
+			struct fdt_property *prop;
+			const char *name;
+
+			if (fdt_next_tag(dtb, offs, &next) != FDT_PROP) {
+				offs = next;
+				continue;
+			}
+
+			prop = fdt_offset_ptr_w(dtb, offs, sizeof(*prop));
+			name = fdt_string(stage,
+					  fdt32_to_cpu(prop->nameoff));
+			noff = fdt_fixup_find_string((char *)dtb +
+						fdt_off_dt_strings(dtb),
+						size_strings + new_strings,
+						name);
+			if (noff < 0)
+				return -FDT_ERR_INTERNAL;
+
+			prop->nameoff = cpu_to_fdt32(noff);
+			offs = next;
+		}
+
+		shift += inserts[i].len;
+	}
+
+	return 0;
+}
+
+/*
+ * Copy-on-write late binding.
+ *
+ * All fixups above modify the loaded blob destructively, so a boot that
+ * decides late for a different fixup set (e.g. after failing over to a
+ * backup configuration with other memory carve-outs) would have to
+ * re-read the blob from storage. The snapshot below makes that decision
+ * cheap: the blob is captured once right after it is loaded, and can be
+ * rewound to that pristine content with a memcpy before the fixup set
+ * selected at handoff time is applied. Combined with the batch interface
+ * above, one batch can be staged per candidate configuration and the
+ * chosen one committed against the rewound blob.
+ */
+
+/*******************************************************************************
+ * fdt_fixup_cow_init() - snapshot the pristine content of a blob
+ * @cow:	copy-on-write state to initialize
+ * @dtb:	pointer to the loaded device tree blob in memory
+ * @copy_buf:	buffer receiving the pristine copy
+ * @copy_size:	size of @copy_buf, at least the blob's totalsize
+ *
+ * Save a copy of @dtb before any fixup touches it. The whole totalsize
+ * is captured, including the blob's spare room, since libfdt is free to
+ * rearrange anything within it.
+ *
+ * Return: 0 on success, a negative libfdt error value otherwise.
+ ******************************************************************************/
+int fdt_fixup_cow_init(struct fdt_fixup_cow *cow, void *dtb,
+		       void *copy_buf, size_t copy_size)
+{
+	int ret = fdt_check_header(dtb);
+
+	if (ret != 0)
+		return ret;
+
+	if (fdt_totalsize(dtb) > copy_size)
+		return -FDT_ERR_NOSPACE;
+
+	cow->dtb = dtb;
+	cow->pristine = copy_buf;
+	cow->size = fdt_totalsize(dtb);
+	memcpy(copy_buf, dtb, cow->size);
+
+	return 0;
+}
+
+/*******************************************************************************
+ * fdt_fixup_cow_reset() - rewind a blob to its pristine snapshot
+ * @cow:	state initialized by fdt_fixup_cow_init()
+ *
+ * Restore the blob to the content captured by fdt_fixup_cow_init(),
+ * discarding every fixup applied to it since.
+ ******************************************************************************/
+void fdt_fixup_cow_reset(struct fdt_fixup_cow *cow)
+{
+	memcpy(cow->dtb, cow->pristine, cow->size);
+}
@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2026, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdbool.h>
+#include <string.h>
+
+#include <platform_def.h>
+
+#include <libfdt.h>
+
+#include <common/debug.h>
+#include <common/fdt_prop_index.h>
+#include <lib/utils_def.h>
+
+/*
+ * Index capacity, i.e. the total number of properties the indexed blob
+ * may contain. Platforms with larger hardware configuration DTBs can
+ * raise it from platform_def.h; a blob that does not fit entirely is
+ * not indexed at all, so lookups simply stay on the runtime parser.
+ */
+#ifndef FDT_PROP_INDEX_MAX_ENTRIES
+#define FDT_PROP_INDEX_MAX_ENTRIES	512U
+#endif
+
+struct prop_index_entry {
+	int32_t node;		/* Node offset within the blob */
+	uint32_t hash;		/* Hash of the property name */
+	int32_t prop;		/* Offset for fdt_getprop_by_offset() */
+};
+
+static struct prop_index_entry prop_index[FDT_PROP_INDEX_MAX_ENTRIES];
+static unsigned int prop_index_count;
+static const void *indexed_dtb;
+static uint32_t indexed_size;
+
+/*
+ * FNV-1a. Property names are short and drawn from the blob's interned
+ * string table, so a 32-bit hash leaves collisions rare; equal hashes
+ * are disambiguated with a single strcmp at lookup time.
+ */
+static uint32_t prop_name_hash(const char *name)
+{
+	uint32_t hash = 0x811C9DC5U;
+
+	while (*name != '\0') {
+		hash ^= (uint32_t)(unsigned char)*name;
+		hash *= 0x01000193U;
+		name++;
+	}
+
+	return hash;
+}
+
+static bool entry_before(const struct prop_index_entry *a, int32_t node,
+			 uint32_t hash)
+{
+	if (a->node != node) {
+		return a->node < node;
+	}
+
+	return a->hash < hash;
+}
+
+void fdt_prop_index_invalidate(void)
+{
+	indexed_dtb = NULL;
+	prop_index_count = 0U;
+}
+
+void fdt_prop_index_build(const void *dtb)
+{
+	int node;
+
+	fdt_prop_index_invalidate();
+
+	if (fdt_check_header(dtb) != 0) {
+		return;
+	}
+
+	for (node = fdt_next_node(dtb, -1, NULL); node >= 0;
+	     node = fdt_next_node(dtb, node, NULL)) {
+		int prop;
+
+		fdt_for_each_property_offset(prop, dtb, node) {
+			const char *name;
+			unsigned int i;
+			uint32_t hash;
+
+			if (prop_index_count == FDT_PROP_INDEX_MAX_ENTRIES) {
+				WARN("DTB exceeds property index capacity\n");
+				prop_index_count = 0U;
+				return;
+			}
+
+			if (fdt_getprop_by_offset(dtb, prop, &name,
+						  NULL) == NULL) {
+				prop_index_count = 0U;
+				return;
+			}
+
+			hash = prop_name_hash(name);
+
+			/*
+			 * Keep the table sorted on (node, hash). Nodes
+			 * are visited in offset order, so insertion only
+			 * ever shifts entries of the current node.
+			 */
+			i = prop_index_count;
+			while ((i > 0U) &&
+			       !entry_before(&prop_index[i - 1U],
+					     (int32_t)node, hash)) {
+				prop_index[i] = prop_index[i - 1U];
+				i--;
+			}
+			prop_index[i].node = (int32_t)node;
+			prop_index[i].hash = hash;
+			prop_index[i].prop = (int32_t)prop;
+			prop_index_count++;
+		}
+	}
+
+	indexed_dtb = dtb;
+	indexed_size = fdt_totalsize(dtb);
+
+	VERBOSE("Indexed %u DT properties\n", prop_index_count);
+}
+
+const void *fdt_prop_index_getprop(const void *dtb, int node,
+				   const char *name, int *lenp)
+{
+	uint32_t hash;
+	unsigned int lo;
+	unsigned int hi;
+
+	/*
+	 * Stay on the runtime parser for any blob other than the indexed
+	 * one. A size change means a read-write operation moved offsets
+	 * without the index being invalidated; do not trust it either.
+	 */
+	if ((dtb != indexed_dtb) || (fdt_totalsize(dtb) != indexed_size)) {
+		return fdt_getprop(dtb, node, name, lenp);
+	}
+
+	hash = prop_name_hash(name);
+
+	/* Lower bound of (node, hash) in the sorted table */
+	lo = 0U;
+	hi = prop_index_count;
+	while (lo < hi) {
+		unsigned int mid = lo + ((hi - lo) / 2U);
+
+		if (entry_before(&prop_index[mid], (int32_t)node, hash)) {
+			lo = mid + 1U;
+		} else {
+			hi = mid;
+		}
+	}
+
+	/* Equal hashes sit next to each other: compare names to settle */
+	while ((lo < prop_index_count) &&
+	       (prop_index[lo].node == (int32_t)node) &&
+	       (prop_index[lo].hash == hash)) {
+		const char *entry_name;
+		const void *value;
+
+		value = fdt_getprop_by_offset(dtb, prop_index[lo].prop,
+					      &entry_name, lenp);
+		if ((value != NULL) && (strcmp(entry_name, name) == 0)) {
+			return value;
+		}
+
+		lo++;
+	}
+
+	/* The index is complete, so a miss means the property is absent */
+	if (lenp != NULL) {
+		*lenp = -FDT_ERR_NOTFOUND;
+	}
+
+	return NULL;
+}
@@ -13,6 +13,23 @@
 
 #include <common/debug.h>
 #include <common/fdt_wrappers.h>
+#if FDT_PROP_INDEX
+#include <common/fdt_prop_index.h>
+#endif
+
+/*
+ * All read accessors resolve properties through this helper so that the
+ * optional property index can replace the linear libfdt name scan.
+ */
+static const void *fdtw_getprop(const void *dtb, int node, const char *prop,
+		int *lenp)
+{
+#if FDT_PROP_INDEX
+	return fdt_prop_index_getprop(dtb, node, prop, lenp);
+#else
+	return fdt_getprop_namelen(dtb, node, prop, (int)strlen(prop), lenp);
+#endif
+}
 
 /*
  * Read cells from a given property of the given node. At most 2 cells of the
@@ -35,8 +52,7 @@ int fdtw_read_cells(const void *dtb, int node, const char *prop,
 	assert(cells <= 2U);
 
 	/* Access property and obtain its length (in bytes) */
-	value_ptr = fdt_getprop_namelen(dtb, node, prop, (int)strlen(prop),
-			&value_len);
+	value_ptr = fdtw_getprop(dtb, node, prop, &value_len);
 	if (value_ptr == NULL) {
 		WARN("Couldn't find property %s in dtb\n", prop);
 		return -1;
@@ -80,8 +96,7 @@ int fdtw_read_array(const void *dtb, int node, const char *prop,
 	assert(node >= 0);
 
 	/* Access property and obtain its length (in bytes) */
-	value_ptr = fdt_getprop_namelen(dtb, node, prop, (int)strlen(prop),
-			&value_len);
+	value_ptr = fdtw_getprop(dtb, node, prop, &value_len);
 	if (value_ptr == NULL) {
 		WARN("Couldn't find property %s in dtb\n", prop);
 		return -1;
@@ -119,7 +134,7 @@ int fdtw_read_string(const void *dtb, int node, const char *prop,
 	assert(str != NULL);
 	assert(size > 0U);
 
-	ptr = fdt_getprop_namelen(dtb, node, prop, (int)strlen(prop), NULL);
+	ptr = fdtw_getprop(dtb, node, prop, NULL);
 	if (ptr == NULL) {
 		WARN("Couldn't find property %s in dtb\n", prop);
 		return -1;
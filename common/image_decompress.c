@@ -5,18 +5,47 @@
  */
 
 #include <assert.h>
+#include <errno.h>
 #include <stdint.h>
+#include <string.h>
 
 #include <arch_helpers.h>
 #include <common/bl_common.h>
 #include <common/debug.h>
 #include <common/image_decompress.h>
+#include <drivers/io/io_storage.h>
+#include <plat/common/platform.h>
+
+/*
+ * Size of the chunks read from storage in streaming mode. The chunk lives
+ * at the start of the (small) temporary buffer; the rest of the buffer is
+ * the decompressor workspace. Larger chunks keep the decompressor in its
+ * fast loop longer per feed (each inflate() call pays a slow-path entry and
+ * exit of a few bytes), so use the biggest chunk the usual scratch buffers
+ * comfortably accommodate.
+ */
+#define DECOMPRESS_CHUNK_SIZE	U(0x8000)
+
+/*
+ * Number of additional decompression formats that can be registered next
+ * to the default decompressor, each recognized by the magic number its
+ * frame format puts at the start of the compressed data.
+ */
+#define DECOMPRESS_MAX_FORMATS	4U
 
 static uintptr_t decompressor_buf_base;
 static uint32_t decompressor_buf_size;
 static decompressor_t *decompressor;
+static const struct stream_decompressor *stream_decompressor_ops;
 static struct image_info saved_image_info;
 
+static struct {
+	const uint8_t *magic;
+	size_t magic_len;
+	decompressor_t *decompressor;
+} decompress_formats[DECOMPRESS_MAX_FORMATS];
+static unsigned int decompress_format_count;
+
 void image_decompress_init(uintptr_t buf_base, uint32_t buf_size,
 			   decompressor_t *_decompressor)
 {
@@ -25,6 +54,42 @@ void image_decompress_init(uintptr_t buf_base, uint32_t buf_size,
 	decompressor = _decompressor;
 }
 
+/*
+ * Register a decompressor for one more format, so that a package can mix
+ * formats per image (e.g. a ratio-optimized one for storage-constrained
+ * images and a decode-speed-optimized one where CPU time dominates).
+ * Each image is dispatched on the leading magic bytes of its compressed
+ * data; images matching no registered format use the default
+ * decompressor passed to image_decompress_init().
+ */
+void image_decompress_register_format(const uint8_t *magic, size_t magic_len,
+				      decompressor_t *_decompressor)
+{
+	assert(decompress_format_count < DECOMPRESS_MAX_FORMATS);
+	assert((magic != NULL) && (magic_len != 0U));
+
+	decompress_formats[decompress_format_count].magic = magic;
+	decompress_formats[decompress_format_count].magic_len = magic_len;
+	decompress_formats[decompress_format_count].decompressor =
+		_decompressor;
+	decompress_format_count++;
+}
+
+/*
+ * Streaming mode: buf_base/buf_size describe a small scratch buffer (one
+ * read chunk plus decompressor workspace), not a staging area for the whole
+ * compressed image.
+ */
+void image_decompress_init_stream(uintptr_t buf_base, uint32_t buf_size,
+				  const struct stream_decompressor *ops)
+{
+	assert(buf_size > DECOMPRESS_CHUNK_SIZE);
+
+	decompressor_buf_base = buf_base;
+	decompressor_buf_size = buf_size;
+	stream_decompressor_ops = ops;
+}
+
 void image_decompress_prepare(struct image_info *info)
 {
 	/*
@@ -42,6 +107,8 @@ int image_decompress(struct image_info *info)
 {
 	uintptr_t compressed_image_base, image_base, work_base;
 	uint32_t compressed_image_size, work_size;
+	decompressor_t *selected;
+	unsigned int i;
 	int ret;
 
 	/*
@@ -63,9 +130,23 @@ int image_decompress(struct image_info *info)
 	work_base = compressed_image_base + compressed_image_size;
 	work_size = decompressor_buf_size - compressed_image_size;
 
-	ret = decompressor(&compressed_image_base, compressed_image_size,
-			   &image_base, info->image_max_size,
-			   work_base, work_size);
+	/* Select the decompressor from the leading magic bytes */
+	selected = decompressor;
+	for (i = 0U; i < decompress_format_count; i++) {
+		if ((compressed_image_size >=
+		     decompress_formats[i].magic_len) &&
+		    (memcmp((const void *)compressed_image_base,
+			    decompress_formats[i].magic,
+			    decompress_formats[i].magic_len) == 0)) {
+			selected = decompress_formats[i].decompressor;
+			break;
+		}
+	}
+	assert(selected != NULL);
+
+	ret = selected(&compressed_image_base, compressed_image_size,
+		       &image_base, info->image_max_size,
+		       work_base, work_size);
 	if (ret) {
 		ERROR("Failed to decompress image (err=%d)\n", ret);
 		return ret;
@@ -78,3 +159,98 @@ int image_decompress(struct image_info *info)
 
 	return 0;
 }
+
+/*
+ * Load a compressed image and decompress it on the fly, feeding each
+ * storage read chunk straight into the streaming decompressor so that
+ * decompression overlaps the remaining I/O and no full-image staging
+ * buffer is needed. This replaces the load_image()/image_decompress()
+ * pair for images that are not covered by Trusted Board Boot
+ * authentication (the compressed data is consumed as it arrives, so
+ * there is nothing left to authenticate afterwards).
+ */
+int image_decompress_load(unsigned int image_id, struct image_info *info)
+{
+	uintptr_t dev_handle, image_handle, image_spec, out_end;
+	size_t image_size, remaining, bytes_read;
+	int io_result, ret;
+
+	assert(stream_decompressor_ops != NULL);
+	assert(info != NULL);
+
+	io_result = plat_get_image_source(image_id, &dev_handle, &image_spec);
+	if (io_result != 0) {
+		WARN("Failed to obtain reference to image id=%u (%i)\n",
+		     image_id, io_result);
+		return io_result;
+	}
+
+	io_result = io_open(dev_handle, image_spec, &image_handle);
+	if (io_result != 0) {
+		WARN("Failed to access image id=%u (%i)\n",
+		     image_id, io_result);
+		return io_result;
+	}
+
+	io_result = io_size(image_handle, &image_size);
+	if ((io_result != 0) || (image_size == 0U)) {
+		WARN("Failed to determine the size of the image id=%u (%i)\n",
+		     image_id, io_result);
+		goto exit;
+	}
+
+	ret = stream_decompressor_ops->init(info->image_base,
+					    info->image_max_size,
+					    decompressor_buf_base +
+					    DECOMPRESS_CHUNK_SIZE,
+					    decompressor_buf_size -
+					    DECOMPRESS_CHUNK_SIZE);
+	if (ret != 0) {
+		io_result = ret;
+		goto exit;
+	}
+
+	remaining = image_size;
+	while (remaining > 0U) {
+		size_t chunk_size = MIN(remaining,
+					(size_t)DECOMPRESS_CHUNK_SIZE);
+
+		io_result = io_read(image_handle, decompressor_buf_base,
+				    chunk_size, &bytes_read);
+		if ((io_result != 0) || (bytes_read < chunk_size)) {
+			WARN("Failed to load image id=%u (%i)\n",
+			     image_id, io_result);
+			goto exit;
+		}
+
+		ret = stream_decompressor_ops->feed(decompressor_buf_base,
+						    chunk_size);
+		if (ret != 0) {
+			ERROR("Failed to decompress image (err=%d)\n", ret);
+			io_result = ret;
+			goto exit;
+		}
+
+		remaining -= chunk_size;
+	}
+
+	ret = stream_decompressor_ops->finish(&out_end);
+	if (ret != 0) {
+		ERROR("Failed to decompress image (err=%d)\n", ret);
+		io_result = ret;
+		goto exit;
+	}
+
+	info->image_size = out_end - info->image_base;
+
+	flush_dcache_range(info->image_base, info->image_size);
+
+	INFO("Image id=%u loaded: 0x%lx - 0x%lx\n", image_id,
+	     info->image_base, out_end);
+
+exit:
+	(void)io_close(image_handle);
+	(void)io_dev_close(dev_handle);
+
+	return io_result;
+}
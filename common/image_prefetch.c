@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2026, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdbool.h>
+#include <string.h>
+
+#include <platform_def.h>
+
+#include <common/bl_common.h>
+#include <common/debug.h>
+#include <common/image_prefetch.h>
+#include <drivers/io/io_storage.h>
+#include <lib/utils_def.h>
+#include <plat/common/platform.h>
+
+/*
+ * Size of the staging buffer, i.e. of the opening burst read ahead for
+ * the next image. Platforms short on boot SRAM can shrink it from
+ * platform_def.h; one eMMC multi-block transfer's worth is enough to
+ * cover the command setup latency of the follow-up read.
+ */
+#ifndef IMAGE_PREFETCH_BUF_SIZE
+#define IMAGE_PREFETCH_BUF_SIZE		U(0x4000)
+#endif
+
+/* Upper bound on the planned sequence length, as for the storage-order
+ * scheduler. Longer descriptor lists simply stop being prefetched. */
+#define IMAGE_PREFETCH_MAX_IMAGES	16U
+
+static unsigned int prefetch_plan[IMAGE_PREFETCH_MAX_IMAGES];
+static unsigned int prefetch_plan_len;
+
+static struct {
+	unsigned int image_id;
+	size_t size;
+	bool valid;
+} staged;
+
+static uint8_t prefetch_buf[IMAGE_PREFETCH_BUF_SIZE];
+
+void image_prefetch_plan(const bl_load_info_t *load_info)
+{
+	const bl_load_info_node_t *node;
+
+	prefetch_plan_len = 0U;
+
+	for (node = load_info->head; node != NULL;
+	     node = node->next_load_info) {
+		if ((node->image_info->h.attr &
+		     IMAGE_ATTRIB_SKIP_LOADING) != 0U) {
+			continue;
+		}
+		if (prefetch_plan_len == IMAGE_PREFETCH_MAX_IMAGES) {
+			break;
+		}
+		prefetch_plan[prefetch_plan_len] = node->image_id;
+		prefetch_plan_len++;
+	}
+}
+
+void image_prefetch_kick(unsigned int image_id)
+{
+	unsigned int next_id;
+	uintptr_t dev_handle;
+	uintptr_t image_spec;
+	uintptr_t image_handle;
+	uintptr_t buf;
+	size_t buf_len;
+	size_t image_size;
+	size_t burst;
+	size_t bytes_read;
+	unsigned int i;
+
+	for (i = 0U; i < prefetch_plan_len; i++) {
+		if (prefetch_plan[i] == image_id) {
+			break;
+		}
+	}
+	if ((i == prefetch_plan_len) || ((i + 1U) == prefetch_plan_len)) {
+		return;
+	}
+	next_id = prefetch_plan[i + 1U];
+
+	if (staged.valid && (staged.image_id == next_id)) {
+		return;
+	}
+	staged.valid = false;
+
+	if (plat_get_image_source(next_id, &dev_handle, &image_spec) != 0) {
+		return;
+	}
+	if (io_open(dev_handle, image_spec, &image_handle) != 0) {
+		return;
+	}
+
+	/*
+	 * A directly addressable source (memory-mapped FIP, preloaded
+	 * staging area) has no device latency to hide; leave it alone.
+	 */
+	if (io_get_buffer(image_handle, &buf, &buf_len) == 0) {
+		goto exit;
+	}
+
+	if ((io_size(image_handle, &image_size) != 0) ||
+	    (image_size == 0U)) {
+		goto exit;
+	}
+
+	burst = MIN(image_size, (size_t)IMAGE_PREFETCH_BUF_SIZE);
+	if ((io_read(image_handle, (uintptr_t)prefetch_buf, burst,
+		     &bytes_read) != 0) || (bytes_read < burst)) {
+		goto exit;
+	}
+
+	staged.image_id = next_id;
+	staged.size = burst;
+	staged.valid = true;
+
+	VERBOSE("Prefetched %zu bytes of image id=%u\n", burst, next_id);
+
+exit:
+	(void)io_close(image_handle);
+	(void)io_dev_close(dev_handle);
+}
+
+size_t image_prefetch_consume(unsigned int image_id, uintptr_t image_base,
+			      size_t image_size)
+{
+	size_t size;
+
+	if (!staged.valid || (staged.image_id != image_id)) {
+		return 0U;
+	}
+
+	size = MIN(staged.size, image_size);
+	memcpy((void *)image_base, prefetch_buf, size);
+	staged.valid = false;
+
+	return size;
+}
+
+void image_prefetch_invalidate(void)
+{
+	staged.valid = false;
+}
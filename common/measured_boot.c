@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include <platform_def.h>
+
+#include <common/debug.h>
+#include <common/measured_boot.h>
+#include <lib/utils.h>
+
+/*
+ * Size in bytes of the event log staging buffer. A TCG_PCR_EVENT2 entry for
+ * a SHA-256 bank with a 4 byte event payload is 54 bytes, and the spec ID
+ * header event is 65 bytes, so the default holds the header plus well over
+ * the number of images a boot chain loads.
+ */
+#ifndef MEASURED_BOOT_LOG_SIZE
+#define MEASURED_BOOT_LOG_SIZE		U(1024)
+#endif
+
+static uint8_t event_log[MEASURED_BOOT_LOG_SIZE];
+static size_t event_log_len;
+
+static void log_put_u8(uint8_t val)
+{
+	event_log[event_log_len] = val;
+	event_log_len++;
+}
+
+static void log_put_u16(uint16_t val)
+{
+	log_put_u8((uint8_t)val);
+	log_put_u8((uint8_t)(val >> 8));
+}
+
+static void log_put_u32(uint32_t val)
+{
+	log_put_u16((uint16_t)val);
+	log_put_u16((uint16_t)(val >> 16));
+}
+
+static void log_put_bytes(const uint8_t *data, size_t len)
+{
+	memcpy(&event_log[event_log_len], data, len);
+	event_log_len += len;
+}
+
+/*
+ * First log entry: a TCG_PCR_EVENT carrying the TCG_EfiSpecIDEventStruct
+ * "Spec ID Event03", which declares the crypto agile entry format and the
+ * single SHA-256 digest bank of the entries that follow.
+ */
+#define SPEC_ID_EVENT_SIZE		U(65)
+
+static void log_put_spec_id_event(void)
+{
+	static const uint8_t signature[16] = "Spec ID Event03";
+
+	log_put_u32(0U);			/* PCRIndex */
+	log_put_u32(TCG_EV_NO_ACTION);		/* EventType */
+	event_log_len += 20U;			/* Digest, 20 zero bytes */
+	log_put_u32(33U);			/* EventSize */
+	log_put_bytes(signature, sizeof(signature));
+	log_put_u32(0U);			/* platformClass */
+	log_put_u8(0U);				/* specVersionMinor */
+	log_put_u8(2U);				/* specVersionMajor */
+	log_put_u8(0U);				/* specErrata */
+	log_put_u8(1U);				/* uintnSize, UINT32 */
+	log_put_u32(1U);			/* numberOfAlgorithms */
+	log_put_u16(TCG_TPM_ALG_SHA256);	/* digestAlgorithms[0].algId */
+	log_put_u16(TCG_SHA256_DIGEST_SIZE);	/* digestAlgorithms[0].size */
+	log_put_u8(0U);				/* vendorInfoSize */
+}
+
+/* A TCG_PCR_EVENT2 with one SHA-256 digest and the image ID as event data */
+#define PCR_EVENT2_SIZE			(22U + TCG_SHA256_DIGEST_SIZE)
+
+void measured_boot_record(unsigned int img_id, const void *digest_der,
+			  size_t digest_der_len)
+{
+	const uint8_t *der = digest_der;
+	size_t needed = PCR_EVENT2_SIZE;
+
+	/*
+	 * The DigestInfo carried by the certificate ends with the OCTET
+	 * STRING holding the raw digest. Anything shorter than a SHA-256
+	 * digest cannot be one, skip it rather than log a bogus value.
+	 */
+	if (digest_der_len < TCG_SHA256_DIGEST_SIZE) {
+		VERBOSE("Not measuring image %u: unexpected digest\n", img_id);
+		return;
+	}
+
+	if (event_log_len == 0U) {
+		needed += SPEC_ID_EVENT_SIZE;
+	}
+
+	if ((event_log_len + needed) > sizeof(event_log)) {
+		WARN("Measured boot: event log full, image %u not measured\n",
+		     img_id);
+		return;
+	}
+
+	if (event_log_len == 0U) {
+		log_put_spec_id_event();
+		assert(event_log_len == SPEC_ID_EVENT_SIZE);
+	}
+
+	log_put_u32(0U);			/* PCRIndex */
+	log_put_u32(TCG_EV_POST_CODE);		/* EventType */
+	log_put_u32(1U);			/* Digests.Count */
+	log_put_u16(TCG_TPM_ALG_SHA256);	/* Digests[0].AlgorithmId */
+	log_put_bytes(&der[digest_der_len - TCG_SHA256_DIGEST_SIZE],
+		      TCG_SHA256_DIGEST_SIZE);
+	log_put_u32(sizeof(uint32_t));		/* EventSize */
+	log_put_u32(img_id);			/* Event */
+}
+
+uintptr_t measured_boot_publish(uintptr_t dst, size_t max_size)
+{
+	struct bl_aux_param_measured_boot_log param;
+
+	assert((dst & 0x7U) == 0U);
+
+	if (event_log_len == 0U) {
+		return 0U;
+	}
+
+	if ((sizeof(param) + event_log_len) > max_size) {
+		WARN("Measured boot: event log does not fit, not published\n");
+		return 0U;
+	}
+
+	param.h.type = BL_AUX_PARAM_MEASURED_BOOT_LOG;
+	param.h.next = 0U;
+	param.log_addr = dst + sizeof(param);
+	param.log_size = event_log_len;
+
+	memcpy((void *)dst, &param, sizeof(param));
+	memcpy((void *)(dst + sizeof(param)), event_log, event_log_len);
+
+	INFO("Measured boot: %zu byte event log published\n", event_log_len);
+
+	return dst;
+}
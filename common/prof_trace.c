@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <assert.h>
+#include <stdbool.h>
+
+#include <platform_def.h>
+
+#include <common/prof_trace.h>
+
+/*
+ * This file is on the -finstrument-functions exclude list and the hooks
+ * must not call into instrumented code, or every such call would recurse
+ * back into the hook. Everything the hot path touches is therefore
+ * hand-inlined below, including the system register accesses.
+ */
+
+static struct prof_trace_ring *prof_rings[PLATFORM_CORE_COUNT];
+static struct prof_trace_rec *prof_recs[PLATFORM_CORE_COUNT];
+static bool prof_pmu_on[PLATFORM_CORE_COUNT];
+static unsigned int prof_nrings;
+
+static inline unsigned int __attribute__((no_instrument_function))
+prof_core(void)
+{
+#ifdef __aarch64__
+	uint64_t mpidr;
+
+	__asm__ volatile("mrs %0, mpidr_el1" : "=r" (mpidr));
+#else
+	uint32_t mpidr;
+
+	__asm__ volatile("mrc p15, 0, %0, c0, c0, 5" : "=r" (mpidr));
+#endif
+	return (unsigned int)(mpidr & U(0xff));
+}
+
+static inline uint32_t __attribute__((no_instrument_function))
+prof_cycles(void)
+{
+#ifdef __aarch64__
+	uint64_t val;
+
+	__asm__ volatile("mrs %0, pmccntr_el0" : "=r" (val));
+#else
+	uint32_t val;
+
+	__asm__ volatile("mrc p15, 0, %0, c9, c13, 0" : "=r" (val));
+#endif
+	return (uint32_t)val;
+}
+
+/*
+ * The low power paths run C code with the data cache off around WFI;
+ * an uncached ring write racing the cached bookkeeping would corrupt
+ * the stream, so those calls are skipped.
+ */
+static inline bool __attribute__((no_instrument_function))
+prof_cache_on(void)
+{
+#ifdef __aarch64__
+	return true;
+#else
+	uint32_t sctlr;
+
+	__asm__ volatile("mrc p15, 0, %0, c1, c0, 0" : "=r" (sctlr));
+
+	return (sctlr & U(0x4)) != 0U;
+#endif
+}
+
+/* The cycle counter is banked per CPU: each core arms its own lazily */
+static inline void __attribute__((no_instrument_function))
+prof_pmu_enable(void)
+{
+#ifdef __aarch64__
+	uint64_t pmcr;
+
+	__asm__ volatile("mrs %0, pmcr_el0" : "=r" (pmcr));
+	pmcr |= U(0x1);			/* PMCR_EL0.E */
+	__asm__ volatile("msr pmcr_el0, %0" : : "r" (pmcr));
+	__asm__ volatile("msr pmcntenset_el0, %0"
+			 : : "r" ((uint64_t)1 << 31));
+#else
+	uint32_t pmcr;
+
+	__asm__ volatile("mrc p15, 0, %0, c9, c12, 0" : "=r" (pmcr));
+	pmcr |= U(0x1);			/* PMCR.E */
+	__asm__ volatile("mcr p15, 0, %0, c9, c12, 0" : : "r" (pmcr));
+	__asm__ volatile("mcr p15, 0, %0, c9, c12, 1"
+			 : : "r" ((uint32_t)1 << 31));
+#endif
+}
+
+static void __attribute__((no_instrument_function))
+prof_trace_put(void *fn, uint32_t flag)
+{
+	unsigned int core = prof_core();
+	struct prof_trace_ring *ring;
+	struct prof_trace_rec *rec;
+
+	if ((core >= prof_nrings) || !prof_cache_on()) {
+		return;
+	}
+
+	ring = prof_rings[core];
+	if (ring == NULL) {
+		return;
+	}
+
+	if (!prof_pmu_on[core]) {
+		prof_pmu_enable();
+		prof_pmu_on[core] = true;
+	}
+
+	if (ring->count >= ring->capacity) {
+		ring->dropped++;
+		return;
+	}
+
+	rec = &prof_recs[core][ring->count];
+	rec->addr = (uint32_t)(uintptr_t)fn | flag;
+	rec->cycles = prof_cycles();
+	ring->count++;
+}
+
+void __attribute__((no_instrument_function))
+__cyg_profile_func_enter(void *this_fn, void *call_site);
+void __attribute__((no_instrument_function))
+__cyg_profile_func_enter(void *this_fn, void *call_site)
+{
+	(void)call_site;
+
+	prof_trace_put(this_fn, 0U);
+}
+
+void __attribute__((no_instrument_function))
+__cyg_profile_func_exit(void *this_fn, void *call_site);
+void __attribute__((no_instrument_function))
+__cyg_profile_func_exit(void *this_fn, void *call_site)
+{
+	(void)call_site;
+
+	prof_trace_put(this_fn, PROF_TRACE_REC_EXIT);
+}
+
+void prof_trace_init(uintptr_t base, size_t size, unsigned int nrings,
+		     uint32_t image)
+{
+	size_t ring_size = (size / nrings) & ~(sizeof(uint64_t) - 1U);
+	unsigned int i;
+
+	assert((nrings != 0U) && (nrings <= PLATFORM_CORE_COUNT));
+	assert(ring_size > sizeof(struct prof_trace_ring));
+
+	for (i = 0U; i < nrings; i++) {
+		uintptr_t ring_base = base + ((uintptr_t)i * ring_size);
+		struct prof_trace_ring *ring =
+			(struct prof_trace_ring *)ring_base;
+
+		ring->image = image;
+		ring->cpu = i;
+		ring->capacity = (uint32_t)((ring_size - sizeof(*ring)) /
+					    sizeof(struct prof_trace_rec));
+		ring->count = 0U;
+		ring->dropped = 0U;
+		ring->reserved[0] = 0U;
+		ring->reserved[1] = 0U;
+		ring->magic = PROF_TRACE_MAGIC;
+
+		prof_recs[i] = (struct prof_trace_rec *)(ring_base +
+							 sizeof(*ring));
+		prof_rings[i] = ring;
+	}
+
+	/* Headers before the first hook store on another CPU */
+	__asm__ volatile("dsb ish" : : : "memory");
+
+	prof_nrings = nrings;
+}
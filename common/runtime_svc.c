@@ -10,17 +10,34 @@
 
 #include <common/debug.h>
 #include <common/runtime_svc.h>
+#include <common/sec_budget.h>
+#include <common/smc_rate_limit.h>
+#include <lib/pmf/pmf.h>
+#include <lib/pmf/pmf_smc_trace.h>
+
+/*
+ * With PMF_DYN_CAPTURE the latency tracer is compiled in dormant and
+ * only captures once its site is enabled through the capture control
+ * SMC, so production builds can carry it at no dispatch cost.
+ */
+#if SMC_LATENCY_TRACE && PMF_DYN_CAPTURE
+PMF_DEFINE_CAPTURE_SITE(smc_trace, PMF_CAPTURE_SITE_SMC_TRACE)
+#define SMC_TRACE_LIVE()	PMF_CAPTURE_SITE_ENABLED(smc_trace)
+#else
+#define SMC_TRACE_LIVE()	true
+#endif
 
 /*******************************************************************************
  * The 'rt_svc_descs' array holds the runtime service descriptors exported by
  * services by placing them in the 'rt_svc_descs' linker section.
- * The 'rt_svc_descs_indices' array holds the index of a descriptor in the
+ * The 'rt_svc_handlers' array holds the SMC handler of a descriptor in the
  * 'rt_svc_descs' array. When an SMC arrives, the OEN[29:24] bits and the call
  * type[31] bit in the function id are combined to get an index into the
- * 'rt_svc_descs_indices' array. This gives the index of the descriptor in the
- * 'rt_svc_descs' array which contains the SMC handler.
+ * 'rt_svc_handlers' array, from which the handler is fetched with a single
+ * indexed load. A NULL entry denotes an owning entity range no service has
+ * been allocated for.
  ******************************************************************************/
-uint8_t rt_svc_descs_indices[MAX_RT_SVCS];
+rt_svc_handle_t rt_svc_handlers[MAX_RT_SVCS];
 
 #define RT_SVC_DECS_NUM		((RT_SVC_DESCS_END - RT_SVC_DESCS_START)\
 					/ sizeof(rt_svc_desc_t))
@@ -35,24 +52,38 @@ uintptr_t handle_runtime_svc(uint32_t smc_fid,
 			     unsigned int flags)
 {
 	u_register_t x1, x2, x3, x4;
-	unsigned int index;
 	unsigned int idx;
-	const rt_svc_desc_t *rt_svc_descs;
+	rt_svc_handle_t handler;
+	unsigned long long trace_ts;
+	uintptr_t ret;
 
 	assert(handle != NULL);
 	idx = get_unique_oen_from_smc_fid(smc_fid);
 	assert(idx < MAX_RT_SVCS);
 
-	index = rt_svc_descs_indices[idx];
-	if (index >= RT_SVC_DECS_NUM)
+	handler = rt_svc_handlers[idx];
+	if (handler == NULL)
 		SMC_RET1(handle, SMC_UNK);
 
-	rt_svc_descs = (rt_svc_desc_t *) RT_SVC_DESCS_START;
+	/* Shed the call before any handler work when its OEN is over rate */
+	if (!smc_rate_admit(smc_fid))
+		SMC_RET1(handle, SMC_UNK);
 
 	get_smc_params_from_ctx(handle, x1, x2, x3, x4);
 
-	return rt_svc_descs[index].handle(smc_fid, x1, x2, x3, x4, cookie,
-						handle, flags);
+	sec_budget_arm();
+
+	if (SMC_TRACE_LIVE()) {
+		trace_ts = pmf_smc_trace_enter();
+		ret = handler(smc_fid, x1, x2, x3, x4, cookie, handle, flags);
+		pmf_smc_trace_exit(smc_fid, trace_ts);
+	} else {
+		ret = handler(smc_fid, x1, x2, x3, x4, cookie, handle, flags);
+	}
+
+	sec_budget_retire(smc_fid);
+
+	return ret;
 }
 
 /*******************************************************************************
@@ -84,8 +115,8 @@ static int32_t validate_rt_svc_desc(const rt_svc_desc_t *desc)
  * This function calls the initialisation routine in the descriptor exported by
  * a runtime service. Once a descriptor has been validated, its start & end
  * owning entity numbers and the call type are combined to form a unique oen.
- * The unique oen is used as an index into the 'rt_svc_descs_indices' array.
- * The index of the runtime service descriptor is stored at this index.
+ * The unique oen is used as an index into the 'rt_svc_handlers' array.
+ * The SMC handler of the runtime service descriptor is stored at this index.
  ******************************************************************************/
 void __init runtime_svc_init(void)
 {
@@ -102,7 +133,7 @@ void __init runtime_svc_init(void)
 		return;
 
 	/* Initialise internal variables to invalid state */
-	(void)memset(rt_svc_descs_indices, -1, sizeof(rt_svc_descs_indices));
+	(void)memset(rt_svc_handlers, 0, sizeof(rt_svc_handlers));
 
 	rt_svc_descs = (rt_svc_desc_t *) RT_SVC_DESCS_START;
 	for (index = 0U; index < RT_SVC_DECS_NUM; index++) {
@@ -137,8 +168,8 @@ void __init runtime_svc_init(void)
 		}
 
 		/*
-		 * Fill the indices corresponding to the start and end
-		 * owning entity numbers with the index of the
+		 * Fill the entries corresponding to the start and end
+		 * owning entity numbers with the handler of the
 		 * descriptor which will handle the SMCs for this owning
 		 * entity range.
 		 */
@@ -149,6 +180,6 @@ void __init runtime_svc_init(void)
 		assert(start_idx <= end_idx);
 		assert(end_idx < MAX_RT_SVCS);
 		for (; start_idx <= end_idx; start_idx++)
-			rt_svc_descs_indices[start_idx] = index;
+			rt_svc_handlers[start_idx] = service->handle;
 	}
 }
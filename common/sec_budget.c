@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <arch_helpers.h>
+#include <common/debug.h>
+#include <common/sec_budget.h>
+#include <lib/pmf/pmf.h>
+#include <lib/smccc.h>
+#include <lib/utils_def.h>
+#include <plat/common/platform.h>
+
+/*
+ * Per-CPU budget state and statistics. Each CPU only writes its own
+ * entry, so no locking is needed; entries are cache line aligned to
+ * avoid false sharing between cores.
+ */
+static struct sec_budget_pcpu {
+	unsigned long long entry_ts;
+	unsigned long long deadline;
+	unsigned long long worst[OEN_LIMIT];
+	uint32_t overruns[OEN_LIMIT];
+} __aligned(CACHE_WRITEBACK_GRANULE) sec_budget[PLATFORM_CORE_COUNT];
+
+void sec_budget_arm(void)
+{
+	struct sec_budget_pcpu *pcpu = &sec_budget[plat_my_core_pos()];
+
+	pcpu->entry_ts = read_cntpct_el0();
+	pcpu->deadline = pcpu->entry_ts + SEC_EXEC_BUDGET_TICKS;
+}
+
+bool sec_budget_exhausted(void)
+{
+	return read_cntpct_el0() >=
+		sec_budget[plat_my_core_pos()].deadline;
+}
+
+void sec_budget_retire(uint32_t smc_fid)
+{
+	struct sec_budget_pcpu *pcpu = &sec_budget[plat_my_core_pos()];
+	unsigned long long residency = read_cntpct_el0() - pcpu->entry_ts;
+	unsigned int oen = GET_SMC_OEN(smc_fid);
+
+	if (residency > SEC_EXEC_BUDGET_TICKS) {
+		pcpu->overruns[oen]++;
+		/* Only a new worst case is worth a console line */
+		if (residency > pcpu->worst[oen]) {
+			WARN("OEN %u overran the secure budget: %llu > %u ticks\n",
+			     oen, residency, SEC_EXEC_BUDGET_TICKS);
+		}
+	}
+
+	if (residency > pcpu->worst[oen]) {
+		pcpu->worst[oen] = residency;
+	}
+}
+
+/* Retrieval handler for the PMF SMC interface, see sec_budget.h */
+static unsigned long long sec_budget_get_ts(unsigned int tid,
+					    u_register_t mpidr,
+					    unsigned int flags)
+{
+	struct sec_budget_pcpu *pcpu;
+	unsigned int id = tid & PMF_TID_MASK;
+	int cpu_pos = plat_core_pos_by_mpidr(mpidr);
+
+	if (cpu_pos < 0) {
+		return 0ULL;
+	}
+
+	pcpu = &sec_budget[cpu_pos];
+
+	if ((flags & PMF_CACHE_MAINT) != 0U) {
+		inv_dcache_range((uintptr_t)pcpu, sizeof(*pcpu));
+	}
+
+	if (id < SEC_BUDGET_TID_WORST_BASE) {
+		return pcpu->overruns[id];
+	}
+
+	return pcpu->worst[id - SEC_BUDGET_TID_WORST_BASE];
+}
+
+PMF_REGISTER_SERVICE_SMC_OWN(sec_budget, PMF_ARM_TIF_IMPL_ID,
+		PMF_SEC_BUDGET_SVC_ID, SEC_BUDGET_TOTAL_IDS,
+		NULL, sec_budget_get_ts)
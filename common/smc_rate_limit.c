@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <arch_helpers.h>
+#include <common/debug.h>
+#include <common/smc_rate_limit.h>
+#include <lib/pmf/pmf.h>
+#include <lib/smccc.h>
+#include <lib/utils_def.h>
+#include <plat/common/platform.h>
+
+/*
+ * Per-CPU bucket state and statistics. Each CPU only writes its own
+ * entry, so no locking is needed; entries are cache line aligned to
+ * avoid false sharing between cores.
+ */
+static struct smc_rate_pcpu {
+	unsigned long long stamp[OEN_LIMIT];
+	uint32_t tokens[OEN_LIMIT];
+	uint32_t shed[OEN_LIMIT];
+} __aligned(CACHE_WRITEBACK_GRANULE) smc_rate[PLATFORM_CORE_COUNT];
+
+bool smc_rate_admit(uint32_t smc_fid)
+{
+	struct smc_rate_pcpu *pcpu = &smc_rate[plat_my_core_pos()];
+	unsigned int oen = GET_SMC_OEN(smc_fid);
+	unsigned long long now, earned;
+
+	if ((SMC_RATE_LIMIT_EXEMPT & BIT(oen)) != 0U) {
+		return true;
+	}
+
+	/*
+	 * Credit the tokens earned since the last visit. The stamp only
+	 * advances by whole token periods so partial periods are carried,
+	 * and a bucket left alone (stamp 0 after reset) fills up to the
+	 * burst allowance on first use.
+	 */
+	now = read_cntpct_el0();
+	earned = (now - pcpu->stamp[oen]) / SMC_RATE_LIMIT_TOKEN_TICKS;
+	if (earned != 0ULL) {
+		pcpu->tokens[oen] =
+			(uint32_t)MIN((unsigned long long)SMC_RATE_LIMIT_BURST,
+				      pcpu->tokens[oen] + earned);
+		pcpu->stamp[oen] = now - ((now - pcpu->stamp[oen]) %
+					  SMC_RATE_LIMIT_TOKEN_TICKS);
+	}
+
+	if (pcpu->tokens[oen] == 0U) {
+		/* Only the first shed of an OEN is worth a console line */
+		if (pcpu->shed[oen]++ == 0U) {
+			WARN("OEN %u exceeded its SMC rate budget\n", oen);
+		}
+		return false;
+	}
+
+	pcpu->tokens[oen]--;
+
+	return true;
+}
+
+/* Retrieval handler for the PMF SMC interface, see smc_rate_limit.h */
+static unsigned long long smc_rate_get_ts(unsigned int tid,
+					  u_register_t mpidr,
+					  unsigned int flags)
+{
+	struct smc_rate_pcpu *pcpu;
+	unsigned int id = tid & PMF_TID_MASK;
+	int cpu_pos = plat_core_pos_by_mpidr(mpidr);
+
+	if ((cpu_pos < 0) || (id >= OEN_LIMIT)) {
+		return 0ULL;
+	}
+
+	pcpu = &smc_rate[cpu_pos];
+
+	if ((flags & PMF_CACHE_MAINT) != 0U) {
+		inv_dcache_range((uintptr_t)pcpu, sizeof(*pcpu));
+	}
+
+	return pcpu->shed[id];
+}
+
+PMF_REGISTER_SERVICE_SMC_OWN(smc_rate, PMF_ARM_TIF_IMPL_ID,
+		PMF_SMC_RATE_SVC_ID, SMC_RATE_TOTAL_IDS,
+		NULL, smc_rate_get_ts)
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdint.h>
+
+#include <arch_helpers.h>
+#include <common/bl_common.h>
+#include <common/stack_hwm.h>
+#include <lib/pmf/pmf.h>
+#include <plat/common/platform.h>
+
+/*
+ * An unlikely word for a live stack: not a plausible pointer, not zero,
+ * and asymmetric so a partial overwrite still ends the canary run.
+ */
+#define STACK_HWM_CANARY	UL(0xdeadbeef)
+
+/*
+ * Keep a safety margin below the setup code's own stack pointer when
+ * painting the primary CPU's live stack, so the fill cannot race the
+ * frames of the fill loop itself.
+ */
+#define STACK_HWM_LIVE_MARGIN	UL(0x100)
+
+IMPORT_SYM(uintptr_t, __STACKS_START__, stack_hwm_stacks_start)
+IMPORT_SYM(uintptr_t, __STACKS_END__, stack_hwm_stacks_end)
+
+static uintptr_t stack_hwm_slot_base(unsigned int cpu_pos)
+{
+	uintptr_t slot_size = (stack_hwm_stacks_end - stack_hwm_stacks_start) /
+				PLATFORM_CORE_COUNT;
+
+	return stack_hwm_stacks_start + ((uintptr_t)cpu_pos * slot_size);
+}
+
+static uintptr_t stack_hwm_slot_size(void)
+{
+	return (stack_hwm_stacks_end - stack_hwm_stacks_start) /
+		PLATFORM_CORE_COUNT;
+}
+
+/*
+ * Paint the canary pattern over every CPU stack. Runs from the PMF
+ * setup on the primary CPU while the secondaries are still held off, so
+ * their slots are filled whole; the primary's slot is in use under our
+ * feet and is only filled below the current stack pointer.
+ */
+static int stack_hwm_init(void)
+{
+	unsigned int my_pos = plat_my_core_pos();
+	uintptr_t my_sp = (uintptr_t)&my_pos;
+	unsigned int cpu;
+
+	for (cpu = 0U; cpu < PLATFORM_CORE_COUNT; cpu++) {
+		uintptr_t base = stack_hwm_slot_base(cpu);
+		uintptr_t limit = base + stack_hwm_slot_size();
+		uint32_t *word;
+
+		if (cpu == my_pos) {
+			limit = my_sp - STACK_HWM_LIVE_MARGIN;
+		}
+
+		for (word = (uint32_t *)base; (uintptr_t)word < limit;
+		     word++) {
+			*word = STACK_HWM_CANARY;
+		}
+	}
+
+	return 0;
+}
+
+/*
+ * Retrieval handler for the PMF SMC interface: scan the requested CPU's
+ * stack from its base for the first word a push has overwritten and
+ * return the bytes used above it. tid selects nothing here - the CPU is
+ * named by the mpidr argument like every per-CPU PMF read - and the
+ * scan is a plain read of memory the stacks share with this CPU's
+ * coherent view, so no cache maintenance is needed.
+ */
+static unsigned long long stack_hwm_get_ts(unsigned int tid,
+					   u_register_t mpidr,
+					   unsigned int flags)
+{
+	int cpu_pos = plat_core_pos_by_mpidr(mpidr);
+	uintptr_t base, limit;
+	uint32_t *word;
+
+	if (cpu_pos < 0) {
+		return 0ULL;
+	}
+
+	base = stack_hwm_slot_base((unsigned int)cpu_pos);
+	limit = base + stack_hwm_slot_size();
+
+	for (word = (uint32_t *)base; (uintptr_t)word < limit; word++) {
+		if (*word != STACK_HWM_CANARY) {
+			break;
+		}
+	}
+
+	return (unsigned long long)(limit - (uintptr_t)word);
+}
+
+PMF_REGISTER_SERVICE_SMC_OWN(stack_hwm, PMF_ARM_TIF_IMPL_ID,
+		PMF_STACK_HWM_SVC_ID, STACK_HWM_TOTAL_IDS,
+		stack_hwm_init, stack_hwm_get_ts)
@@ -9,6 +9,9 @@
 #include <stdio.h>
 
 #include <common/debug.h>
+#if TF_LOG_BINARY
+#include <common/tf_log_binary.h>
+#endif
 #include <plat/common/platform.h>
 
 /* Set the default maximum log level to the `LOG_LEVEL` build flag */
@@ -37,6 +40,18 @@ void tf_log(const char *fmt, ...)
 	if (log_level > max_log_level)
 		return;
 
+#if TF_LOG_BINARY
+	/*
+	 * Store the format string pointer and the raw arguments instead of
+	 * formatting into the console. The host side tool derives the
+	 * prefix from the log marker leading the format string.
+	 */
+	va_start(args, fmt);
+	tf_log_binary_record(fmt, args);
+	va_end(args);
+	return;
+#endif
+
 	prefix_str = plat_log_get_prefix(log_level);
 
 	while (*prefix_str != '\0') {
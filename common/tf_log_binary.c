@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <common/debug.h>
+#include <common/tf_log_binary.h>
+#include <lib/spinlock.h>
+
+/*
+ * Byte ring holding serialized records. head is the next write position,
+ * tail the next drain position; the ring keeps one byte free so that
+ * head == tail means empty.
+ */
+static unsigned char log_ring[TF_LOG_BINARY_RING_SIZE];
+static unsigned int ring_head;
+static unsigned int ring_tail;
+static unsigned int ring_dropped;
+static spinlock_t ring_lock;
+
+static unsigned int ring_free(void)
+{
+	return (ring_tail + sizeof(log_ring) - ring_head - 1U) %
+	       sizeof(log_ring);
+}
+
+static void ring_push(const unsigned char *data, unsigned int size)
+{
+	unsigned int i;
+
+	for (i = 0U; i < size; i++) {
+		log_ring[ring_head] = data[i];
+		ring_head = (ring_head + 1U) % sizeof(log_ring);
+	}
+}
+
+static unsigned int serialize_u64(unsigned char *buf, uint64_t value)
+{
+	unsigned int i;
+
+	for (i = 0U; i < 8U; i++) {
+		buf[i] = (unsigned char)(value >> (i * 8U));
+	}
+
+	return 8U;
+}
+
+/*
+ * Capture one log message. The format string is scanned for the conversion
+ * specifiers understood by the libc vprintf() - d, i, u, x, p and s with
+ * the l, ll and z length modifiers and %0NN padding - and the matching raw
+ * arguments are stored, 64-bit wide, after the format string address.
+ * The types consumed from the va_list must mirror vprintf() exactly, or
+ * the argument ABI (notably the 64-bit alignment of ll values) breaks.
+ */
+void tf_log_binary_record(const char *fmt, va_list args)
+{
+	/* sync + format address + count + arguments */
+	unsigned char record[2U + 8U + 1U + (TF_LOG_BIN_MAX_ARGS * 8U)];
+	uint64_t value;
+	const char *s = fmt;
+	unsigned int pos = 2U + 8U + 1U;
+	unsigned int nargs = 0U;
+	int l_count;
+
+	record[0] = TF_LOG_BIN_SYNC0;
+	record[1] = TF_LOG_BIN_SYNC1;
+	(void)serialize_u64(&record[2], (uint64_t)(uintptr_t)fmt);
+
+	while ((*s != '\0') && (nargs < TF_LOG_BIN_MAX_ARGS)) {
+		if (*s != '%') {
+			s++;
+			continue;
+		}
+
+		s++;
+		l_count = 0;
+loop:
+		switch (*s) {
+		case '0':
+			s++;
+			while ((*s >= '0') && (*s <= '9')) {
+				s++;
+			}
+			goto loop;
+		case 'z':
+			if (sizeof(size_t) == 8U) {
+				l_count = 2;
+			}
+			s++;
+			goto loop;
+		case 'l':
+			l_count++;
+			s++;
+			goto loop;
+		case 'i':
+		case 'd':
+		case 'u':
+		case 'x':
+			if (l_count > 1) {
+				value = va_arg(args, unsigned long long int);
+			} else if (l_count == 1) {
+				value = va_arg(args, unsigned long int);
+			} else {
+				value = va_arg(args, unsigned int);
+			}
+			pos += serialize_u64(&record[pos], value);
+			nargs++;
+			s++;
+			break;
+		case 's':
+		case 'p':
+			value = (uintptr_t)va_arg(args, void *);
+			pos += serialize_u64(&record[pos], value);
+			nargs++;
+			s++;
+			break;
+		default:
+			/* vprintf() exits here, nothing more to capture */
+			goto out;
+		}
+	}
+out:
+	record[10] = (unsigned char)nargs;
+
+	spin_lock(&ring_lock);
+	if (ring_free() >= pos) {
+		ring_push(record, pos);
+	} else {
+		ring_dropped++;
+	}
+	spin_unlock(&ring_lock);
+}
+
+/*
+ * Drain the ring to the console as raw record bytes. Called by the platform
+ * when idle; the UART cost is paid here instead of in the logging callers.
+ */
+void tf_log_binary_drain(void)
+{
+	unsigned char drop_record[2U + 8U + 1U + 8U];
+	unsigned int pos;
+
+	spin_lock(&ring_lock);
+
+	while (ring_tail != ring_head) {
+		(void)putchar(log_ring[ring_tail]);
+		ring_tail = (ring_tail + 1U) % sizeof(log_ring);
+	}
+
+	if (ring_dropped != 0U) {
+		drop_record[0] = TF_LOG_BIN_SYNC0;
+		drop_record[1] = TF_LOG_BIN_SYNC1;
+		(void)serialize_u64(&drop_record[2], 0U);
+		drop_record[10] = 1U;
+		(void)serialize_u64(&drop_record[11], ring_dropped);
+		ring_dropped = 0U;
+
+		for (pos = 0U; pos < sizeof(drop_record); pos++) {
+			(void)putchar(drop_record[pos]);
+		}
+	}
+
+	spin_unlock(&ring_lock);
+}
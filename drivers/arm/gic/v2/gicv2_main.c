@@ -20,6 +20,29 @@
 
 static const gicv2_driver_data_t *driver_data;
 
+/*
+ * Accessor macros to save/restore distributor registers to/from the context.
+ * The ranges start at INTID 0: the first word(s) of each register type are
+ * the calling CPU's banked SGI/PPI view.
+ */
+#define SAVE_GICD_REGS(base, ctx, intr_num, reg, REG)			\
+	do {								\
+		for (unsigned int int_id = 0U; int_id < (intr_num);	\
+				int_id += (1U << REG##_SHIFT)) {	\
+			ctx->gicd_##reg[int_id >> REG##_SHIFT] =	\
+					gicd_read_##reg(base, int_id);	\
+		}							\
+	} while (false)
+
+#define RESTORE_GICD_REGS(base, ctx, intr_num, reg, REG)		\
+	do {								\
+		for (unsigned int int_id = 0U; int_id < (intr_num);	\
+				int_id += (1U << REG##_SHIFT)) {	\
+			gicd_write_##reg(base, int_id,			\
+				ctx->gicd_##reg[int_id >> REG##_SHIFT]);\
+		}							\
+	} while (false)
+
 /*
  * Spinlock to guard registers needing read-modify-write. APIs protected by this
  * spinlock are used either at boot time (when only a single CPU is active), or
@@ -542,3 +565,122 @@ void gicv2_interrupt_set_cfg(unsigned int id, unsigned int cfg)
 {
 	gicd_set_icfgr(driver_data->gicd_base, id, cfg);
 }
+
+/*******************************************************************************
+ * This function returns the number of interrupts supported by the Distributor,
+ * capped to exclude the special INTIDs 1020-1023.
+ ******************************************************************************/
+static unsigned int gicv2_get_num_interrupts(uintptr_t gicd_base)
+{
+	unsigned int num_ints;
+
+	num_ints = gicd_read_typer(gicd_base);
+	num_ints &= TYPER_IT_LINES_NO_MASK;
+	num_ints = (num_ints + 1U) << 5;
+
+	if (num_ints > (MAX_SPI_ID + 1U)) {
+		num_ints = MAX_SPI_ID + 1U;
+	}
+
+	return num_ints;
+}
+
+/*******************************************************************************
+ * This function saves the GIC Distributor register context, to be restored
+ * with gicv2_distif_init_restore() after the Distributor loses state in a low
+ * power cycle. It must be invoked after the CPU interface is disabled. The
+ * banked SGI/PPI registers are saved for the calling CPU only: other CPUs must
+ * run gicv2_pcpu_distif_init() when they come back online.
+ ******************************************************************************/
+void gicv2_distif_save(gicv2_dist_ctx_t * const dist_ctx)
+{
+	unsigned int num_ints;
+
+	assert(driver_data != NULL);
+	assert(driver_data->gicd_base != 0U);
+	assert(dist_ctx != NULL);
+
+	uintptr_t gicd_base = driver_data->gicd_base;
+
+	num_ints = gicv2_get_num_interrupts(gicd_base);
+
+	/* Save the GICD_CTLR */
+	dist_ctx->gicd_ctlr = gicd_read_ctlr(gicd_base);
+
+	/* Save GICD_IGROUPR for INTIDs 0 - 1019 */
+	SAVE_GICD_REGS(gicd_base, dist_ctx, num_ints, igroupr, IGROUPR);
+
+	/* Save GICD_ISENABLER for INTIDs 0 - 1019 */
+	SAVE_GICD_REGS(gicd_base, dist_ctx, num_ints, isenabler, ISENABLER);
+
+	/* Save GICD_ISPENDR for INTIDs 0 - 1019 */
+	SAVE_GICD_REGS(gicd_base, dist_ctx, num_ints, ispendr, ISPENDR);
+
+	/* Save GICD_ISACTIVER for INTIDs 0 - 1019 */
+	SAVE_GICD_REGS(gicd_base, dist_ctx, num_ints, isactiver, ISACTIVER);
+
+	/* Save GICD_IPRIORITYR for INTIDs 0 - 1019 */
+	SAVE_GICD_REGS(gicd_base, dist_ctx, num_ints, ipriorityr, IPRIORITYR);
+
+	/* Save GICD_ITARGETSR for INTIDs 0 - 1019 */
+	SAVE_GICD_REGS(gicd_base, dist_ctx, num_ints, itargetsr, ITARGETSR);
+
+	/* Save GICD_ICFGR for INTIDs 0 - 1019 */
+	SAVE_GICD_REGS(gicd_base, dist_ctx, num_ints, icfgr, ICFGR);
+
+	/* Save GICD_NSACR for INTIDs 0 - 1019 */
+	SAVE_GICD_REGS(gicd_base, dist_ctx, num_ints, nsacr, NSACR);
+}
+
+/*******************************************************************************
+ * This function restores the GIC Distributor register context saved with
+ * gicv2_distif_save(). Compared with gicv2_distif_init() it writes the saved
+ * words back without recomputing them from the interrupt properties, which
+ * roughly halves the number of Distributor accesses on the wake-up path. The
+ * interrupt groups are disabled while the configuration is written and the
+ * enable, pending and active bits are restored last.
+ ******************************************************************************/
+void gicv2_distif_init_restore(const gicv2_dist_ctx_t * const dist_ctx)
+{
+	unsigned int num_ints;
+	unsigned int ctlr;
+
+	assert(driver_data != NULL);
+	assert(driver_data->gicd_base != 0U);
+	assert(dist_ctx != NULL);
+
+	uintptr_t gicd_base = driver_data->gicd_base;
+
+	num_ints = gicv2_get_num_interrupts(gicd_base);
+
+	/* Disable the distributor before going further */
+	ctlr = gicd_read_ctlr(gicd_base);
+	gicd_write_ctlr(gicd_base,
+			ctlr & ~(CTLR_ENABLE_G0_BIT | CTLR_ENABLE_G1_BIT));
+
+	/* Restore the interrupt configuration before any is enabled */
+	RESTORE_GICD_REGS(gicd_base, dist_ctx, num_ints, icfgr, ICFGR);
+	RESTORE_GICD_REGS(gicd_base, dist_ctx, num_ints, igroupr, IGROUPR);
+	RESTORE_GICD_REGS(gicd_base, dist_ctx, num_ints, ipriorityr,
+			  IPRIORITYR);
+	RESTORE_GICD_REGS(gicd_base, dist_ctx, num_ints, itargetsr, ITARGETSR);
+	RESTORE_GICD_REGS(gicd_base, dist_ctx, num_ints, nsacr, NSACR);
+
+	/*
+	 * The enable, pending and active registers are write-one-to-set: clear
+	 * any stale state before writing the saved words back.
+	 */
+	for (unsigned int int_id = 0U; int_id < num_ints;
+			int_id += (1U << ICENABLER_SHIFT)) {
+		gicd_write_icenabler(gicd_base, int_id, ~0U);
+		gicd_write_icpendr(gicd_base, int_id, ~0U);
+		gicd_write_icactiver(gicd_base, int_id, ~0U);
+	}
+
+	RESTORE_GICD_REGS(gicd_base, dist_ctx, num_ints, ispendr, ISPENDR);
+	RESTORE_GICD_REGS(gicd_base, dist_ctx, num_ints, isactiver, ISACTIVER);
+	RESTORE_GICD_REGS(gicd_base, dist_ctx, num_ints, isenabler, ISENABLER);
+
+	/* Restore the distributor control register last */
+	gicd_write_ctlr(gicd_base, dist_ctx->gicd_ctlr);
+}
@@ -5,6 +5,7 @@
  */
 
 #include <assert.h>
+#include <stdbool.h>
 
 #include <arch.h>
 #include <arch_helpers.h>
@@ -381,8 +382,67 @@ void gicv3_spis_config_defaults(uintptr_t gicd_base)
 		gicd_write_icfgr(gicd_base, index, 0U);
 }
 
+/*
+ * One-word write-back cache for read-modify-write sequences on GIC
+ * Distributor register files. Interrupt property arrays are normally ordered
+ * by interrupt number, so consecutive properties mostly hit the same register
+ * word: the cached word absorbs their updates and is written back once, when
+ * an access moves to another word or the caller flushes it, instead of one
+ * read-modify-write per interrupt.
+ */
+typedef struct gicd_word_cache {
+	/* ID of the first interrupt covered by the cached word */
+	unsigned int id;
+	unsigned int value;
+	bool valid;
+	bool dirty;
+} gicd_word_cache_t;
+
+typedef unsigned int (*gicd_word_read_t)(uintptr_t base, unsigned int id);
+typedef void (*gicd_word_write_t)(uintptr_t base, unsigned int id,
+				  unsigned int val);
+
+static void gicd_word_cache_flush(uintptr_t gicd_base,
+				  gicd_word_cache_t *cache,
+				  gicd_word_write_t write_fn)
+{
+	if (cache->valid && cache->dirty) {
+		write_fn(gicd_base, cache->id, cache->value);
+		cache->dirty = false;
+	}
+}
+
+/*
+ * Return the cached register word holding the state of interrupt `id` in a
+ * register file packing interrupts at `shift` IDs per word, loading and
+ * flushing the cache as needed. The caller is expected to modify the word,
+ * so it is marked dirty here.
+ */
+static unsigned int *gicd_word_cache_get(uintptr_t gicd_base,
+					 gicd_word_cache_t *cache,
+					 unsigned int id, unsigned int shift,
+					 gicd_word_read_t read_fn,
+					 gicd_word_write_t write_fn)
+{
+	unsigned int first_id = id & ~((1U << shift) - 1U);
+
+	if (!cache->valid || (cache->id != first_id)) {
+		gicd_word_cache_flush(gicd_base, cache, write_fn);
+		cache->id = first_id;
+		cache->value = read_fn(gicd_base, first_id);
+		cache->valid = true;
+	}
+
+	cache->dirty = true;
+	return &cache->value;
+}
+
 /*******************************************************************************
  * Helper function to configure properties of secure SPIs
+ *
+ * Register updates are coalesced into whole-word accesses through the caches
+ * above. Enable bits are accumulated on the side and written last, once the
+ * configuration of every interrupt in the array has reached the Distributor.
  ******************************************************************************/
 unsigned int gicv3_secure_spis_config_props(uintptr_t gicd_base,
 		const interrupt_prop_t *interrupt_props,
@@ -392,47 +452,88 @@ unsigned int gicv3_secure_spis_config_props(uintptr_t gicd_base,
 	const interrupt_prop_t *current_prop;
 	unsigned long long gic_affinity_val;
 	unsigned int ctlr_enable = 0U;
+	gicd_word_cache_t igroupr = { 0U };
+	gicd_word_cache_t igrpmodr = { 0U };
+	gicd_word_cache_t icfgr = { 0U };
+	gicd_word_cache_t ipriorityr = { 0U };
+	uint32_t spi_enable[(MAX_SPI_ID >> ISENABLER_SHIFT) + 1U] = { 0U };
+	unsigned int *word;
+	unsigned int bit_shift;
 
 	/* Make sure there's a valid property array */
 	if (interrupt_props_num > 0U)
 		assert(interrupt_props != NULL);
 
 	for (i = 0U; i < interrupt_props_num; i++) {
+		unsigned int id;
+
 		current_prop = &interrupt_props[i];
+		id = current_prop->intr_num;
 
-		if (current_prop->intr_num < MIN_SPI_ID)
+		if (id < MIN_SPI_ID)
 			continue;
 
 		/* Configure this interrupt as a secure interrupt */
-		gicd_clr_igroupr(gicd_base, current_prop->intr_num);
+		word = gicd_word_cache_get(gicd_base, &igroupr, id,
+					   IGROUPR_SHIFT, gicd_read_igroupr,
+					   gicd_write_igroupr);
+		*word &= ~(1U << (id & ((1U << IGROUPR_SHIFT) - 1U)));
 
 		/* Configure this interrupt as G0 or a G1S interrupt */
 		assert((current_prop->intr_grp == INTR_GROUP0) ||
 				(current_prop->intr_grp == INTR_GROUP1S));
+		word = gicd_word_cache_get(gicd_base, &igrpmodr, id,
+					   IGRPMODR_SHIFT, gicd_read_igrpmodr,
+					   gicd_write_igrpmodr);
 		if (current_prop->intr_grp == INTR_GROUP1S) {
-			gicd_set_igrpmodr(gicd_base, current_prop->intr_num);
+			*word |= 1U << (id & ((1U << IGRPMODR_SHIFT) - 1U));
 			ctlr_enable |= CTLR_ENABLE_G1S_BIT;
 		} else {
-			gicd_clr_igrpmodr(gicd_base, current_prop->intr_num);
+			*word &= ~(1U << (id & ((1U << IGRPMODR_SHIFT) - 1U)));
 			ctlr_enable |= CTLR_ENABLE_G0_BIT;
 		}
 
-		/* Set interrupt configuration */
-		gicd_set_icfgr(gicd_base, current_prop->intr_num,
-				current_prop->intr_cfg);
-
-		/* Set the priority of this interrupt */
-		gicd_set_ipriorityr(gicd_base, current_prop->intr_num,
-				current_prop->intr_pri);
+		/* Set interrupt configuration, a 2-bit field */
+		word = gicd_word_cache_get(gicd_base, &icfgr, id,
+					   ICFGR_SHIFT, gicd_read_icfgr,
+					   gicd_write_icfgr);
+		bit_shift = (id & ((1U << ICFGR_SHIFT) - 1U)) << 1;
+		*word &= ~(GIC_CFG_MASK << bit_shift);
+		*word |= ((uint32_t)current_prop->intr_cfg & GIC_CFG_MASK)
+			 << bit_shift;
+
+		/* Set the priority of this interrupt, a byte lane per ID */
+		word = gicd_word_cache_get(gicd_base, &ipriorityr, id,
+					   IPRIORITYR_SHIFT,
+					   gicd_read_ipriorityr,
+					   gicd_write_ipriorityr);
+		bit_shift = (id & ((1U << IPRIORITYR_SHIFT) - 1U)) << 3;
+		*word &= ~(GIC_PRI_MASK << bit_shift);
+		*word |= ((uint32_t)current_prop->intr_pri & GIC_PRI_MASK)
+			 << bit_shift;
 
 		/* Target SPIs to the primary CPU */
 		gic_affinity_val =
 			gicd_irouter_val_from_mpidr(read_mpidr(), 0U);
-		gicd_write_irouter(gicd_base, current_prop->intr_num,
-				gic_affinity_val);
+		gicd_write_irouter(gicd_base, id, gic_affinity_val);
 
-		/* Enable this interrupt */
-		gicd_set_isenabler(gicd_base, current_prop->intr_num);
+		/* Record this interrupt to enable it later */
+		spi_enable[id >> ISENABLER_SHIFT] |=
+			1U << (id & ((1U << ISENABLER_SHIFT) - 1U));
+	}
+
+	gicd_word_cache_flush(gicd_base, &igroupr, gicd_write_igroupr);
+	gicd_word_cache_flush(gicd_base, &igrpmodr, gicd_write_igrpmodr);
+	gicd_word_cache_flush(gicd_base, &icfgr, gicd_write_icfgr);
+	gicd_word_cache_flush(gicd_base, &ipriorityr, gicd_write_ipriorityr);
+
+	/* Enable the interrupts, one whole ISENABLER word at a time */
+	for (i = MIN_SPI_ID >> ISENABLER_SHIFT;
+	     i < ARRAY_SIZE(spi_enable); i++) {
+		if (spi_enable[i] != 0U) {
+			gicd_write_isenabler(gicd_base, i << ISENABLER_SHIFT,
+					     spi_enable[i]);
+		}
 	}
 
 	return ctlr_enable;
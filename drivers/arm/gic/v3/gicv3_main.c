@@ -946,6 +946,57 @@ void gicv3_set_interrupt_type(unsigned int id, unsigned int proc_num,
 	}
 }
 
+/*******************************************************************************
+ * This function programs the properties of a batch of secure SPIs in one go.
+ * Each array entry carries the interrupt number, priority, group and trigger
+ * configuration, as at driver initialisation. The interrupts are first
+ * disabled with whole ICENABLER words and a single wait for pending writes,
+ * instead of one write and one RWP poll per interrupt, then reconfigured and
+ * re-enabled with word-batched Distributor accesses.
+ ******************************************************************************/
+void gicv3_set_secure_spi_props(const interrupt_prop_t *interrupt_props,
+				unsigned int interrupt_props_num)
+{
+	uint32_t spi_disable[(MAX_SPI_ID >> ICENABLER_SHIFT) + 1U] = { 0U };
+	uintptr_t gicd_base;
+	unsigned int i;
+
+	assert(gicv3_driver_data != NULL);
+	assert(gicv3_driver_data->gicd_base != 0U);
+	if (interrupt_props_num > 0U)
+		assert(interrupt_props != NULL);
+
+	gicd_base = gicv3_driver_data->gicd_base;
+
+	for (i = 0U; i < interrupt_props_num; i++) {
+		unsigned int id = interrupt_props[i].intr_num;
+
+		assert((id >= MIN_SPI_ID) && (id <= MAX_SPI_ID));
+		spi_disable[id >> ICENABLER_SHIFT] |=
+			1U << (id & ((1U << ICENABLER_SHIFT) - 1U));
+	}
+
+	/* Serialize read-modify-write to Distributor registers */
+	spin_lock(&gic_lock);
+
+	for (i = MIN_SPI_ID >> ICENABLER_SHIFT;
+	     i < ARRAY_SIZE(spi_disable); i++) {
+		if (spi_disable[i] != 0U) {
+			gicd_write_icenabler(gicd_base, i << ICENABLER_SHIFT,
+					     spi_disable[i]);
+		}
+	}
+
+	/* A single wait covers all the clear enable writes above */
+	gicd_wait_for_pending_write(gicd_base);
+	dsbishst();
+
+	(void)gicv3_secure_spis_config_props(gicd_base, interrupt_props,
+					     interrupt_props_num);
+
+	spin_unlock(&gic_lock);
+}
+
 /*******************************************************************************
  * This function raises the specified Secure Group 0 SGI.
  *
@@ -5,11 +5,13 @@
  */
 
 #include <assert.h>
+#include <stdbool.h>
 #include <stddef.h>
 
 #include <common/debug.h>
 #include <drivers/arm/tzc400.h>
 #include <lib/mmio.h>
+#include <lib/utils.h>
 
 #include "tzc_common_private.h"
 
@@ -38,6 +40,32 @@ typedef struct tzc400_instance {
 
 static tzc400_instance_t tzc400;
 
+/* The TZC-400 cannot implement more than 9 regions (0 to 8). */
+#define TZC400_MAX_REGIONS		U(9)
+
+/*
+ * Shadow copy of the last value programmed into each region register set.
+ * It backs the batched configuration API (tzc400_config_begin() /
+ * tzc400_config_commit()), which compares the requested state against this
+ * cache and only touches the registers that actually change. An entry is
+ * trusted only while `valid` is set; tzc400_config_begin() drops the whole
+ * cache when it finds every gate keeper closed, as that means the
+ * controller has been reset since the cache was filled.
+ */
+typedef struct tzc400_region_state {
+	unsigned long long base;
+	unsigned long long top;
+	unsigned int attr;
+	unsigned int id_access;
+	bool valid;
+} tzc400_region_state_t;
+
+static tzc400_region_state_t tzc400_region_cache[TZC400_MAX_REGIONS];
+static unsigned int tzc400_action_cache;
+static bool tzc400_action_valid;
+static bool tzc400_batch_active;
+static bool tzc400_batch_dirty;
+
 static inline unsigned int _tzc400_read_build_config(uintptr_t base)
 {
 	return mmio_read_32(base + BUILD_CONFIG_OFF);
@@ -143,17 +171,50 @@ static void _tzc400_set_gate_keeper(uintptr_t base, unsigned int filter,
 		;
 }
 
+/*
+ * Close the gate keepers once before the first register that actually
+ * changes within a batch. Batches where every request matches the cached
+ * state never close (or reopen) the filters at all. Outside a batch this
+ * is a no-op and the caller remains responsible for the gate keepers.
+ */
+static void tzc400_batch_prepare_write(void)
+{
+	unsigned int filter;
+
+	if (!tzc400_batch_active || tzc400_batch_dirty) {
+		return;
+	}
+
+	for (filter = 0U; filter < tzc400.num_filters; filter++) {
+		if (_tzc400_get_gate_keeper(tzc400.base, filter) != 0U) {
+			_tzc400_set_gate_keeper(tzc400.base, filter, 0);
+		}
+	}
+
+	tzc400_batch_dirty = true;
+}
+
 void tzc400_set_action(unsigned int action)
 {
 	assert(tzc400.base != 0U);
 	assert(action <= TZC_ACTION_ERR_INT);
 
+	if (tzc400_batch_active && tzc400_action_valid &&
+	    (tzc400_action_cache == action)) {
+		return;
+	}
+
+	tzc400_batch_prepare_write();
+
 	/*
 	 * - Currently no handler is provided to trap an error via interrupt
 	 *   or exception.
 	 * - The interrupt action has not been tested.
 	 */
 	_tzc400_write_action(tzc400.base, action);
+
+	tzc400_action_cache = action;
+	tzc400_action_valid = true;
 }
 
 void tzc400_init(uintptr_t base)
@@ -193,10 +254,30 @@ void tzc400_init(uintptr_t base)
 void tzc400_configure_region0(unsigned int sec_attr,
 			      unsigned int ns_device_access)
 {
+	tzc400_region_state_t *cached = &tzc400_region_cache[0];
+	unsigned int attr;
+
 	assert(tzc400.base != 0U);
 	assert(sec_attr <= TZC_REGION_S_RDWR);
 
+	attr = sec_attr << TZC_REGION_ATTR_SEC_SHIFT;
+
+	if (tzc400_batch_active && cached->valid && (cached->attr == attr) &&
+	    (cached->id_access == ns_device_access)) {
+		VERBOSE("TrustZone : Region 0 unchanged, write skipped\n");
+		return;
+	}
+
+	tzc400_batch_prepare_write();
+
 	_tzc400_configure_region0(tzc400.base, sec_attr, ns_device_access);
+
+	/* Region 0 base and top are fixed by the hardware. */
+	cached->base = 0ULL;
+	cached->top = 0ULL;
+	cached->attr = attr;
+	cached->id_access = ns_device_access;
+	cached->valid = true;
 }
 
 /*
@@ -214,6 +295,9 @@ void tzc400_configure_region(unsigned int filters,
 			     unsigned int sec_attr,
 			     unsigned int nsaid_permissions)
 {
+	tzc400_region_state_t *cached = NULL;
+	unsigned int attr;
+
 	assert(tzc400.base != 0U);
 
 	/* Do range checks on filters and regions. */
@@ -232,8 +316,105 @@ void tzc400_configure_region(unsigned int filters,
 
 	assert(sec_attr <= TZC_REGION_S_RDWR);
 
-	_tzc400_configure_region(tzc400.base, filters, region, region_base,
-				 region_top, sec_attr, nsaid_permissions);
+	attr = (sec_attr << TZC_REGION_ATTR_SEC_SHIFT) |
+	       (filters << TZC_REGION_ATTR_F_EN_SHIFT);
+
+	if (region < TZC400_MAX_REGIONS) {
+		cached = &tzc400_region_cache[region];
+	}
+
+	if (tzc400_batch_active && (cached != NULL) && cached->valid) {
+		if ((cached->base == region_base) &&
+		    (cached->top == region_top) &&
+		    (cached->attr == attr) &&
+		    (cached->id_access == nsaid_permissions)) {
+			VERBOSE("TrustZone : Region %u unchanged, write skipped\n",
+				region);
+			return;
+		}
+
+		/* Only rewrite the registers that actually differ. */
+		tzc400_batch_prepare_write();
+
+		if (cached->base != region_base) {
+			_tzc400_write_region_base(tzc400.base, region,
+						  region_base);
+		}
+		if (cached->top != region_top) {
+			_tzc400_write_region_top(tzc400.base, region,
+						 region_top);
+		}
+		if (cached->attr != attr) {
+			_tzc400_write_region_attributes(tzc400.base, region,
+							attr);
+		}
+		if (cached->id_access != nsaid_permissions) {
+			_tzc400_write_region_id_access(tzc400.base, region,
+						       nsaid_permissions);
+		}
+	} else {
+		tzc400_batch_prepare_write();
+
+		_tzc400_configure_region(tzc400.base, filters, region,
+					 region_base, region_top, sec_attr,
+					 nsaid_permissions);
+	}
+
+	if (cached != NULL) {
+		cached->base = region_base;
+		cached->top = region_top;
+		cached->attr = attr;
+		cached->id_access = nsaid_permissions;
+		cached->valid = true;
+	}
+}
+
+/*
+ * Start a batched reconfiguration. Within a batch, region and action
+ * updates are compared against the cached copy of the hardware state and
+ * identical requests are dropped; the gate keepers are only closed when a
+ * register actually needs rewriting, and only once for the whole batch.
+ * This keeps a resume-time replay of an unchanged configuration from
+ * touching the controller at all.
+ */
+void tzc400_config_begin(void)
+{
+	assert(tzc400.base != 0U);
+	assert(!tzc400_batch_active);
+
+	/*
+	 * If every gate keeper is closed, the controller has been reset
+	 * since the cache was filled: drop it so that each region gets
+	 * fully reprogrammed.
+	 */
+	if (get_gate_keeper_os(tzc400.base) == 0U) {
+		zeromem(tzc400_region_cache, sizeof(tzc400_region_cache));
+		tzc400_action_valid = false;
+	}
+
+	tzc400_batch_active = true;
+	tzc400_batch_dirty = false;
+}
+
+/*
+ * End a batched reconfiguration and open every gate keeper. Filters that
+ * the batch never closed (because nothing changed) are left untouched.
+ */
+void tzc400_config_commit(void)
+{
+	unsigned int filter;
+
+	assert(tzc400.base != 0U);
+	assert(tzc400_batch_active);
+
+	for (filter = 0U; filter < tzc400.num_filters; filter++) {
+		if (_tzc400_get_gate_keeper(tzc400.base, filter) == 0U) {
+			_tzc400_set_gate_keeper(tzc400.base, filter, 1);
+		}
+	}
+
+	tzc400_batch_active = false;
+	tzc400_batch_dirty = false;
 }
 
 void tzc400_enable_filters(void)
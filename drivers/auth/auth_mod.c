@@ -5,12 +5,16 @@
  */
 
 #include <assert.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <string.h>
 
 #include <platform_def.h>
 
 #include <common/debug.h>
+#if MEASURED_BOOT
+#include <common/measured_boot.h>
+#endif
 #include <common/tbbr/cot_def.h>
 #include <drivers/auth/auth_common.h>
 #include <drivers/auth/auth_mod.h>
@@ -34,6 +38,48 @@
 extern const auth_img_desc_t *const *const cot_desc_ptr;
 extern unsigned int auth_img_flags[MAX_NUMBER_IDS];
 
+#if PIPELINED_IMAGE_LOAD
+/*
+ * Cache of signature verifications that already succeeded during this boot
+ * session, keyed by image identifier. A certificate presented again with the
+ * same signed payload, signature and trust anchor is accepted at the cost of
+ * one hash instead of a full public-key operation. This keeps chain
+ * re-verification cheap when auth_mod_invalidate() forces a new walk, as on
+ * boot source fallback.
+ */
+static struct sig_memo {
+	unsigned char digest[CRYPTO_MAX_DIGEST_SIZE];
+	unsigned int digest_len;
+	bool valid;
+} sig_memo[MAX_NUMBER_IDS];
+
+static int auth_sig_digest(void *data_ptr, unsigned int data_len,
+			   void *sig_ptr, unsigned int sig_len,
+			   void *sig_alg_ptr, unsigned int sig_alg_len,
+			   void *pk_ptr, unsigned int pk_len,
+			   unsigned char *digest, unsigned int *digest_len)
+{
+	int rc;
+
+	rc = crypto_mod_hash_init();
+	return_if_error(rc);
+
+	rc = crypto_mod_hash_update(data_ptr, data_len);
+	return_if_error(rc);
+
+	rc = crypto_mod_hash_update(sig_ptr, sig_len);
+	return_if_error(rc);
+
+	rc = crypto_mod_hash_update(sig_alg_ptr, sig_alg_len);
+	return_if_error(rc);
+
+	rc = crypto_mod_hash_update(pk_ptr, pk_len);
+	return_if_error(rc);
+
+	return crypto_mod_hash_finish(digest, digest_len);
+}
+#endif /* PIPELINED_IMAGE_LOAD */
+
 static int cmp_auth_param_type_desc(const auth_param_type_desc_t *a,
 		const auth_param_type_desc_t *b)
 {
@@ -116,6 +162,17 @@ static int auth_hash(const auth_method_param_hash_t *param,
 	rc = crypto_mod_verify_hash(data_ptr, data_len,
 				    hash_der_ptr, hash_der_len);
 
+#if MEASURED_BOOT
+	/*
+	 * The verified reference hash is the measurement of the image, so
+	 * the event log entry comes for free, without rehashing the data.
+	 */
+	if (rc == 0) {
+		measured_boot_record(img_desc->img_id, hash_der_ptr,
+				     hash_der_len);
+	}
+#endif
+
 	return rc;
 }
 
@@ -154,6 +211,11 @@ static int auth_signature(const auth_method_param_sig_t *param,
 	unsigned int data_len, pk_len, pk_hash_len, sig_len, sig_alg_len;
 	unsigned int flags = 0;
 	int rc = 0;
+#if PIPELINED_IMAGE_LOAD
+	unsigned char digest[CRYPTO_MAX_DIGEST_SIZE];
+	unsigned int digest_len = 0;
+	struct sig_memo *memo = &sig_memo[img_desc->img_id];
+#endif
 
 	/* Get the data to be signed from current image */
 	rc = img_parser_get_auth_param(img_desc->img_type, param->data,
@@ -182,6 +244,23 @@ static int auth_signature(const auth_method_param_sig_t *param,
 	}
 	return_if_error(rc);
 
+#if PIPELINED_IMAGE_LOAD
+	/* The signed payload, signature and trust anchor fully determine the
+	 * outcome of this method, so a digest of them can stand in for the
+	 * public-key operations below once it has verified successfully */
+	if (auth_sig_digest(data_ptr, data_len, sig_ptr, sig_len,
+			    sig_alg_ptr, sig_alg_len, pk_ptr, pk_len,
+			    digest, &digest_len) != 0) {
+		digest_len = 0;
+	}
+
+	if ((digest_len != 0U) && memo->valid &&
+	    (memo->digest_len == digest_len) &&
+	    (memcmp(memo->digest, digest, digest_len) == 0)) {
+		return 0;
+	}
+#endif
+
 	if (flags & (ROTPK_IS_HASH | ROTPK_NOT_DEPLOYED)) {
 		/* If the PK is a hash of the key or if the ROTPK is not
 		   deployed on the platform, retrieve the key from the image */
@@ -215,6 +294,14 @@ static int auth_signature(const auth_method_param_sig_t *param,
 						 pk_ptr, pk_len);
 	}
 
+#if PIPELINED_IMAGE_LOAD
+	if ((rc == 0) && (digest_len != 0U)) {
+		memcpy(memo->digest, digest, digest_len);
+		memo->digest_len = digest_len;
+		memo->valid = true;
+	}
+#endif
+
 	return rc;
 }
 
@@ -325,6 +412,21 @@ int auth_mod_get_parent_id(unsigned int img_id, unsigned int *parent_id)
 	return 0;
 }
 
+/*
+ * Invalidate the session authentication state
+ *
+ * Forget which images have been authenticated so that the next call to
+ * load_auth_image() walks and verifies the full certificate chain again.
+ * Called when the boot source changes, as already verified parent
+ * certificates may not match the images about to be loaded. Cached
+ * signature digests are kept: certificates whose content is unchanged
+ * re-verify at the cost of one hash.
+ */
+void auth_mod_invalidate(void)
+{
+	(void)memset(auth_img_flags, 0, sizeof(auth_img_flags));
+}
+
 /*
  * Initialize the different modules in the authentication framework
  */
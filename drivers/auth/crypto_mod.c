@@ -5,6 +5,8 @@
  */
 
 #include <assert.h>
+#include <stdbool.h>
+#include <string.h>
 
 #include <common/debug.h>
 #include <drivers/auth/crypto_mod.h>
@@ -48,6 +50,11 @@ void crypto_mod_init(void)
 	assert(crypto_lib_desc.init != NULL);
 	assert(crypto_lib_desc.verify_signature != NULL);
 	assert(crypto_lib_desc.verify_hash != NULL);
+#if PIPELINED_IMAGE_LOAD
+	assert(crypto_lib_desc.hash_init != NULL);
+	assert(crypto_lib_desc.hash_update != NULL);
+	assert(crypto_lib_desc.hash_finish != NULL);
+#endif
 
 	/* Initialize the cryptographic library */
 	crypto_lib_desc.init();
@@ -103,3 +110,283 @@ int crypto_mod_verify_hash(void *data_ptr, unsigned int data_len,
 	return crypto_lib_desc.verify_hash(data_ptr, data_len,
 					   digest_info_ptr, digest_info_len);
 }
+
+#if PIPELINED_IMAGE_LOAD
+/*
+ * Digest of the image most recently streamed through the hash interface.
+ * The image loader saves it here so that the authentication module can
+ * reuse it instead of hashing the whole image again.
+ */
+static struct {
+	void *data_ptr;
+	unsigned int data_len;
+	unsigned char digest[CRYPTO_MAX_DIGEST_SIZE];
+	unsigned int digest_len;
+} crypto_prehash;
+
+/*
+ * Start a new hash stream. Any previously saved digest is discarded since
+ * it refers to an older image.
+ */
+int crypto_mod_hash_init(void)
+{
+	crypto_prehash.data_len = 0U;
+
+	return crypto_lib_desc.hash_init();
+}
+
+/*
+ * Feed a chunk of data into the current hash stream
+ */
+int crypto_mod_hash_update(void *data_ptr, unsigned int data_len)
+{
+	assert(data_ptr != NULL);
+	assert(data_len != 0U);
+
+	return crypto_lib_desc.hash_update(data_ptr, data_len);
+}
+
+/*
+ * Terminate the current hash stream and retrieve the digest
+ */
+int crypto_mod_hash_finish(unsigned char *digest, unsigned int *digest_len)
+{
+	assert(digest != NULL);
+	assert(digest_len != NULL);
+
+	return crypto_lib_desc.hash_finish(digest, digest_len);
+}
+
+/*
+ * Save the digest of a data region computed while it was loaded
+ */
+void crypto_mod_prehash_save(void *data_ptr, unsigned int data_len,
+			     const unsigned char *digest,
+			     unsigned int digest_len)
+{
+	assert(digest_len <= CRYPTO_MAX_DIGEST_SIZE);
+
+	crypto_prehash.data_ptr = data_ptr;
+	crypto_prehash.data_len = data_len;
+	memcpy(crypto_prehash.digest, digest, digest_len);
+	crypto_prehash.digest_len = digest_len;
+}
+
+/*
+ * Retrieve the saved digest for a data region, if it matches exactly the
+ * region that was streamed. Returns 0 on hit, -1 otherwise.
+ */
+int crypto_mod_prehash_lookup(void *data_ptr, unsigned int data_len,
+			      const unsigned char **digest,
+			      unsigned int *digest_len)
+{
+	if ((crypto_prehash.data_len == 0U) ||
+	    (crypto_prehash.data_ptr != data_ptr) ||
+	    (crypto_prehash.data_len != data_len)) {
+		return -1;
+	}
+
+	*digest = crypto_prehash.digest;
+	*digest_len = crypto_prehash.digest_len;
+
+	return 0;
+}
+#endif /* PIPELINED_IMAGE_LOAD */
+
+#if CRYPTO_ASYNC
+/* Engine ops registered by a platform accelerator driver, may be NULL */
+static const crypto_async_ops_t *crypto_async_ops;
+
+enum crypto_job_state {
+	JOB_FREE = 0,
+	JOB_RUNNING,
+	JOB_DONE,
+};
+
+struct crypto_job {
+	enum crypto_job_state state;
+	int result;
+	crypto_job_cb_t cb;
+	void *cb_arg;
+};
+
+static struct crypto_job crypto_jobs[CRYPTO_ASYNC_QUEUE_DEPTH];
+
+void crypto_mod_async_register(const crypto_async_ops_t *ops)
+{
+	assert(ops != NULL);
+	assert(ops->name != NULL);
+	assert(ops->poll != NULL);
+
+	crypto_async_ops = ops;
+	INFO("Using crypto engine '%s'\n", ops->name);
+}
+
+static void crypto_job_complete(struct crypto_job *job, int result)
+{
+	job->state = JOB_DONE;
+	job->result = result;
+
+	if (job->cb != NULL) {
+		job->cb(job->cb_arg, result);
+	}
+}
+
+static void crypto_job_poll(unsigned int slot)
+{
+	int result = crypto_async_ops->poll(slot);
+
+	if (result != CRYPTO_ASYNC_PENDING) {
+		crypto_job_complete(&crypto_jobs[slot], result);
+	}
+}
+
+/*
+ * Claim a queue slot, making progress on the engine when all slots are
+ * taken. A queue full of completed jobs nobody waited for violates the
+ * wait-once contract and cannot be recovered from.
+ */
+static unsigned int crypto_job_alloc(void)
+{
+	unsigned int i;
+	bool running;
+
+	for (;;) {
+		running = false;
+
+		for (i = 0U; i < CRYPTO_ASYNC_QUEUE_DEPTH; i++) {
+			if (crypto_jobs[i].state == JOB_FREE) {
+				return i;
+			}
+
+			running |= (crypto_jobs[i].state == JOB_RUNNING);
+		}
+
+		assert(running);
+
+		for (i = 0U; i < CRYPTO_ASYNC_QUEUE_DEPTH; i++) {
+			if (crypto_jobs[i].state == JOB_RUNNING) {
+				crypto_job_poll(i);
+			}
+		}
+	}
+}
+
+/*
+ * Queue a signature verification. Parameters are those of
+ * crypto_mod_verify_signature(); the returned job identifier must be
+ * passed to crypto_mod_wait() for the result.
+ */
+int crypto_mod_submit_verify_signature(void *data_ptr, unsigned int data_len,
+				       void *sig_ptr, unsigned int sig_len,
+				       void *sig_alg_ptr,
+				       unsigned int sig_alg_len,
+				       void *pk_ptr, unsigned int pk_len,
+				       crypto_job_cb_t cb, void *cb_arg)
+{
+	unsigned int slot = crypto_job_alloc();
+	struct crypto_job *job = &crypto_jobs[slot];
+	int rc = CRYPTO_ERR_UNKNOWN;
+
+	job->cb = cb;
+	job->cb_arg = cb_arg;
+
+	if ((crypto_async_ops != NULL) &&
+	    (crypto_async_ops->sig_start != NULL)) {
+		rc = crypto_async_ops->sig_start(slot, data_ptr, data_len,
+						 sig_ptr, sig_len,
+						 sig_alg_ptr, sig_alg_len,
+						 pk_ptr, pk_len);
+	}
+
+	if (rc == CRYPTO_SUCCESS) {
+		job->state = JOB_RUNNING;
+	} else {
+		/* No engine or job rejected: run synchronously */
+		crypto_job_complete(job,
+				    crypto_mod_verify_signature(data_ptr,
+								data_len,
+								sig_ptr,
+								sig_len,
+								sig_alg_ptr,
+								sig_alg_len,
+								pk_ptr,
+								pk_len));
+	}
+
+	return (int)slot;
+}
+
+/*
+ * Queue a hash verification. Parameters are those of
+ * crypto_mod_verify_hash(); the returned job identifier must be passed
+ * to crypto_mod_wait() for the result.
+ */
+int crypto_mod_submit_verify_hash(void *data_ptr, unsigned int data_len,
+				  void *digest_info_ptr,
+				  unsigned int digest_info_len,
+				  crypto_job_cb_t cb, void *cb_arg)
+{
+	unsigned int slot = crypto_job_alloc();
+	struct crypto_job *job = &crypto_jobs[slot];
+	int rc = CRYPTO_ERR_UNKNOWN;
+
+	job->cb = cb;
+	job->cb_arg = cb_arg;
+
+	if ((crypto_async_ops != NULL) &&
+	    (crypto_async_ops->hash_start != NULL)) {
+		rc = crypto_async_ops->hash_start(slot, data_ptr, data_len,
+						  digest_info_ptr,
+						  digest_info_len);
+	}
+
+	if (rc == CRYPTO_SUCCESS) {
+		job->state = JOB_RUNNING;
+	} else {
+		crypto_job_complete(job,
+				    crypto_mod_verify_hash(data_ptr, data_len,
+							   digest_info_ptr,
+							   digest_info_len));
+	}
+
+	return (int)slot;
+}
+
+/*
+ * Wait for a job's completion and release its slot. Returns the job's
+ * 'enum crypto_ret_value' result.
+ */
+int crypto_mod_wait(int job)
+{
+	struct crypto_job *j;
+
+	assert((job >= 0) && ((unsigned int)job < CRYPTO_ASYNC_QUEUE_DEPTH));
+
+	j = &crypto_jobs[job];
+	assert(j->state != JOB_FREE);
+
+	while (j->state == JOB_RUNNING) {
+		crypto_job_poll((unsigned int)job);
+	}
+
+	j->state = JOB_FREE;
+
+	return j->result;
+}
+
+/*
+ * Wait for every outstanding job. Results are only delivered through
+ * the completion callbacks.
+ */
+void crypto_mod_wait_all(void)
+{
+	unsigned int i;
+
+	for (i = 0U; i < CRYPTO_ASYNC_QUEUE_DEPTH; i++) {
+		if (crypto_jobs[i].state != JOB_FREE) {
+			(void)crypto_mod_wait((int)i);
+		}
+	}
+}
+#endif /* CRYPTO_ASYNC */
@@ -6,7 +6,7 @@
 
 #include <assert.h>
 #include <errno.h>
-#include <limits.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <string.h>
 
@@ -17,10 +17,11 @@
 
 IMPORT_SYM(uintptr_t, __PARSER_LIB_DESCS_START__,	PARSER_LIB_DESCS_START);
 IMPORT_SYM(uintptr_t, __PARSER_LIB_DESCS_END__,		PARSER_LIB_DESCS_END);
-static unsigned int parser_lib_indices[IMG_MAX_TYPES];
-static img_parser_lib_desc_t *parser_lib_descs;
 
-#define INVALID_IDX		UINT_MAX
+/* Descriptor registered for each image type, compacted once at init time
+ * so the per-image lookups below are a single indexed load. A NULL entry
+ * means no parser handles that type */
+static const img_parser_lib_desc_t *parser_per_type[IMG_MAX_TYPES];
 
 static void validate_desc(img_parser_lib_desc_t *desc)
 {
@@ -34,11 +35,7 @@ static void validate_desc(img_parser_lib_desc_t *desc)
 void img_parser_init(void)
 {
 	unsigned int index, mod_num;
-
-	/* Initialise internal variables to invalid state */
-	for (index = 0; index < IMG_MAX_TYPES; index++) {
-		parser_lib_indices[index] = INVALID_IDX;
-	}
+	img_parser_lib_desc_t *parser_lib_descs;
 
 	/* Calculate how many image parsers are registered. At least one parser
 	 * must be present */
@@ -56,18 +53,19 @@ void img_parser_init(void)
 		parser_lib_descs[index].init();
 
 		/* Ensure only one parser is registered for each image type */
-		assert(parser_lib_indices[parser_lib_descs[index].img_type] ==
-				INVALID_IDX);
+		assert(parser_per_type[parser_lib_descs[index].img_type] ==
+				NULL);
 
-		/* Keep the index of this hash calculator */
-		parser_lib_indices[parser_lib_descs[index].img_type] = index;
+		/* Keep the descriptor handling this image type */
+		parser_per_type[parser_lib_descs[index].img_type] =
+				&parser_lib_descs[index];
 	}
 }
 
 int img_parser_check_integrity(img_type_t img_type,
 			       void *img_ptr, unsigned int img_len)
 {
-	unsigned int idx;
+	const img_parser_lib_desc_t *desc;
 
 	assert(img_ptr != NULL);
 	assert(img_len != 0);
@@ -77,12 +75,12 @@ int img_parser_check_integrity(img_type_t img_type,
 		return IMG_PARSER_OK;
 	}
 
-	/* Find the index of the required image parser */
-	idx = parser_lib_indices[img_type];
-	assert(idx != INVALID_IDX);
+	/* Find the required image parser */
+	desc = parser_per_type[img_type];
+	assert(desc != NULL);
 
 	/* Call the function to check the image integrity */
-	return parser_lib_descs[idx].check_integrity(img_ptr, img_len);
+	return desc->check_integrity(img_ptr, img_len);
 }
 
 /*
@@ -101,7 +99,7 @@ int img_parser_get_auth_param(img_type_t img_type,
 			      void *img_ptr, unsigned int img_len,
 			      void **param_ptr, unsigned int *param_len)
 {
-	unsigned int idx;
+	const img_parser_lib_desc_t *desc;
 
 	assert(type_desc != NULL);
 	assert(img_ptr != NULL);
@@ -117,11 +115,11 @@ int img_parser_get_auth_param(img_type_t img_type,
 		return IMG_PARSER_OK;
 	}
 
-	/* Find the index of the required image parser library */
-	idx = parser_lib_indices[img_type];
-	assert(idx != INVALID_IDX);
+	/* Find the required image parser library */
+	desc = parser_per_type[img_type];
+	assert(desc != NULL);
 
 	/* Call the function to obtain the parameter */
-	return parser_lib_descs[idx].get_auth_param(type_desc, img_ptr, img_len,
+	return desc->get_auth_param(type_desc, img_ptr, img_len,
 			param_ptr, param_len);
 }
@@ -6,6 +6,8 @@
 
 #include <assert.h>
 #include <stddef.h>
+#include <stdint.h>
+#include <string.h>
 
 /* mbed TLS headers */
 #include <mbedtls/memory_buffer_alloc.h>
@@ -14,6 +16,7 @@
 #include <common/debug.h>
 #include <drivers/auth/mbedtls/mbedtls_common.h>
 #include <drivers/auth/mbedtls/mbedtls_config.h>
+#include <lib/utils_def.h>
 #include <plat/common/platform.h>
 
 static void cleanup(void)
@@ -22,6 +25,52 @@ static void cleanup(void)
 	panic();
 }
 
+#if MBEDTLS_ARENA_ALLOC
+/*
+ * Mark-release arena over the platform heap. Trusted Boot verifies one
+ * certificate at a time and discards every mbed TLS object before moving to
+ * the next one, so individual free() calls buy nothing: allocation is a
+ * pointer bump and the whole heap is reclaimed at once by
+ * mbedtls_heap_reset(), keeping the high-water mark at the cost of a single
+ * verification.
+ */
+static unsigned char *arena_base;
+static size_t arena_size;
+static size_t arena_top;
+
+static void *arena_calloc(size_t nmemb, size_t size)
+{
+	unsigned char *ptr;
+	size_t len;
+
+	if ((size != 0U) && (nmemb > (SIZE_MAX / size))) {
+		return NULL;
+	}
+
+	len = round_up(nmemb * size, MBEDTLS_MEMORY_ALIGN_MULTIPLE);
+	if (len > (arena_size - arena_top)) {
+		return NULL;
+	}
+
+	ptr = arena_base + arena_top;
+	arena_top += len;
+
+	(void)memset(ptr, 0, len);
+
+	return ptr;
+}
+
+static void arena_free(void *ptr)
+{
+	/* Allocations are released wholesale by mbedtls_heap_reset() */
+}
+
+void mbedtls_heap_reset(void)
+{
+	arena_top = 0U;
+}
+#endif /* MBEDTLS_ARENA_ALLOC */
+
 /*
  * mbed TLS initialization function
  */
@@ -45,8 +94,14 @@ void mbedtls_init(void)
 		}
 		assert(heap_size >= TF_MBEDTLS_HEAP_SIZE);
 
+#if MBEDTLS_ARENA_ALLOC
+		arena_base = heap_addr;
+		arena_size = heap_size;
+		mbedtls_platform_set_calloc_free(arena_calloc, arena_free);
+#else
 		/* Initialize the mbed TLS heap */
 		mbedtls_memory_buffer_alloc_init(heap_addr, heap_size);
+#endif
 
 #ifdef MBEDTLS_PLATFORM_SNPRINTF_ALT
 		mbedtls_platform_set_snprintf(snprintf);
@@ -15,6 +15,13 @@ endif
 
 MBEDTLS_INC		=	-I${MBEDTLS_DIR}/include
 
+# When enabled, replace the mbed TLS buffer allocator with a mark-release
+# arena that the crypto module resets between verifications, lowering the
+# heap high-water mark.
+MBEDTLS_ARENA_ALLOC	?=	0
+$(eval $(call assert_boolean,MBEDTLS_ARENA_ALLOC))
+$(eval $(call add_define,MBEDTLS_ARENA_ALLOC))
+
 # Specify mbed TLS configuration file
 MBEDTLS_CONFIG_FILE	:=	"<drivers/auth/mbedtls/mbedtls_config.h>"
 $(eval $(call add_define,MBEDTLS_CONFIG_FILE))
@@ -68,6 +68,13 @@ static int verify_signature(void *data_ptr, unsigned int data_len,
 	unsigned char *p, *end;
 	unsigned char hash[MBEDTLS_MD_MAX_SIZE];
 
+	/*
+	 * No mbed TLS object outlives a crypto module call (the streaming hash
+	 * context is torn down in hash_finish() before any verification runs),
+	 * so the previous call's allocations can all be reclaimed here.
+	 */
+	mbedtls_heap_reset();
+
 	/* Get pointers to signature OID and parameters */
 	p = (unsigned char *)sig_alg;
 	end = (unsigned char *)(p + sig_alg_len);
@@ -152,6 +159,9 @@ static int verify_hash(void *data_ptr, unsigned int data_len,
 	size_t len;
 	int rc;
 
+	/* Reclaim the previous call's allocations, see verify_signature() */
+	mbedtls_heap_reset();
+
 	/* Digest info should be an MBEDTLS_ASN1_SEQUENCE */
 	p = (unsigned char *)digest_info_ptr;
 	end = p + digest_info_len;
@@ -189,6 +199,29 @@ static int verify_hash(void *data_ptr, unsigned int data_len,
 	}
 	hash = p;
 
+#if PIPELINED_IMAGE_LOAD
+	/*
+	 * If this data region was already digested while it was loaded, and
+	 * with the same algorithm, reuse that digest instead of hashing the
+	 * whole region a second time.
+	 */
+	if (md_alg == MBEDTLS_MD_SHA256) {
+		const unsigned char *stream_hash;
+		unsigned int stream_hash_len;
+
+		if ((crypto_mod_prehash_lookup(data_ptr, data_len,
+					       &stream_hash,
+					       &stream_hash_len) == 0) &&
+		    (stream_hash_len == mbedtls_md_get_size(md_info))) {
+			if (memcmp(stream_hash, hash, stream_hash_len) != 0) {
+				return CRYPTO_ERR_HASH;
+			}
+
+			return CRYPTO_SUCCESS;
+		}
+	}
+#endif
+
 	/* Calculate the hash of the data */
 	p = (unsigned char *)data_ptr;
 	rc = mbedtls_md(md_info, p, data_len, data_hash);
@@ -205,7 +238,76 @@ static int verify_hash(void *data_ptr, unsigned int data_len,
 	return CRYPTO_SUCCESS;
 }
 
+#if PIPELINED_IMAGE_LOAD
+/*
+ * Streaming hash interface used by the pipelined image loader. TBBR chains
+ * use SHA-256 digests, so the stream is fixed to that algorithm and
+ * verify_hash() only reuses the result when the certificate agrees.
+ */
+static mbedtls_md_context_t stream_md_ctx;
+
+static int hash_init(void)
+{
+	const mbedtls_md_info_t *md_info;
+	int rc;
+
+	md_info = mbedtls_md_info_from_type(MBEDTLS_MD_SHA256);
+	if (md_info == NULL) {
+		return CRYPTO_ERR_HASH;
+	}
+
+	mbedtls_md_free(&stream_md_ctx);
+	mbedtls_md_init(&stream_md_ctx);
+
+	rc = mbedtls_md_setup(&stream_md_ctx, md_info, 0);
+	if (rc != 0) {
+		return CRYPTO_ERR_HASH;
+	}
+
+	rc = mbedtls_md_starts(&stream_md_ctx);
+	if (rc != 0) {
+		return CRYPTO_ERR_HASH;
+	}
+
+	return CRYPTO_SUCCESS;
+}
+
+static int hash_update(void *data_ptr, unsigned int data_len)
+{
+	int rc;
+
+	rc = mbedtls_md_update(&stream_md_ctx, (unsigned char *)data_ptr,
+			       data_len);
+	if (rc != 0) {
+		return CRYPTO_ERR_HASH;
+	}
+
+	return CRYPTO_SUCCESS;
+}
+
+static int hash_finish(unsigned char *digest, unsigned int *digest_len)
+{
+	int rc;
+
+	rc = mbedtls_md_finish(&stream_md_ctx, digest);
+	mbedtls_md_free(&stream_md_ctx);
+	if (rc != 0) {
+		return CRYPTO_ERR_HASH;
+	}
+
+	*digest_len = mbedtls_md_get_size(
+			mbedtls_md_info_from_type(MBEDTLS_MD_SHA256));
+
+	return CRYPTO_SUCCESS;
+}
+#endif /* PIPELINED_IMAGE_LOAD */
+
 /*
  * Register crypto library descriptor
  */
+#if PIPELINED_IMAGE_LOAD
+REGISTER_CRYPTO_LIB(LIB_NAME, init, verify_signature, verify_hash,
+		    hash_init, hash_update, hash_finish);
+#else
 REGISTER_CRYPTO_LIB(LIB_NAME, init, verify_signature, verify_hash);
+#endif
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include <platform_def.h>
+
+#include <drivers/console_buffered.h>
+#include <lib/cassert.h>
+#include <lib/utils_def.h>
+#include <plat/common/platform.h>
+
+CASSERT(IS_POWER_OF_TWO(CONSOLE_BUFFERED_BUF_SIZE),
+	assert_console_buffered_buf_size_is_power_of_two);
+
+/*
+ * One ring per CPU, written only by its owner so stores need no lock. The
+ * indexes are free-running and wrapped on access. A flush drains every ring:
+ * a concurrent flush may lose or repeat characters of another CPU, which is
+ * acceptable for diagnostics output.
+ */
+struct console_ring {
+	unsigned int head;
+	unsigned int tail;
+	unsigned char data[CONSOLE_BUFFERED_BUF_SIZE];
+};
+
+static struct console_ring console_rings[PLATFORM_CORE_COUNT];
+
+static int console_buffered_putc(int character, console_t *console)
+{
+	struct console_ring *ring = &console_rings[plat_my_core_pos()];
+
+	/* Overwrite the oldest character when the ring is full */
+	if ((ring->head - ring->tail) == CONSOLE_BUFFERED_BUF_SIZE) {
+		ring->tail++;
+	}
+
+	ring->data[ring->head % CONSOLE_BUFFERED_BUF_SIZE] =
+		(unsigned char)character;
+	ring->head++;
+
+	return character;
+}
+
+static int console_buffered_flush(console_t *console)
+{
+	console_buffered_t *cbc = (console_buffered_t *)console;
+	console_t *backend = cbc->backend;
+	unsigned int i;
+
+	/* Early console: keep buffering until a backend is bound */
+	if (backend == NULL) {
+		return 0;
+	}
+
+	for (i = 0U; i < PLATFORM_CORE_COUNT; i++) {
+		struct console_ring *ring = &console_rings[i];
+
+		while (ring->tail != ring->head) {
+			(void)backend->putc(
+				ring->data[ring->tail %
+					   CONSOLE_BUFFERED_BUF_SIZE],
+				backend);
+			ring->tail++;
+		}
+	}
+
+	if (backend->flush != NULL) {
+		return backend->flush(backend);
+	}
+
+	return 0;
+}
+
+int console_buffered_register(console_t *backend, console_buffered_t *console)
+{
+	static const console_t init = {
+		.putc = console_buffered_putc,
+		.getc = NULL,
+		.flush = console_buffered_flush,
+	};
+
+	assert((backend != NULL) && (backend->putc != NULL) &&
+	       (console != NULL));
+
+	/* The function pointers of console_t are const qualified */
+	memcpy(&console->console, &init, sizeof(console_t));
+	console->backend = backend;
+
+	return console_register(&console->console);
+}
+
+int console_buffered_register_early(console_buffered_t *console)
+{
+	static const console_t init = {
+		.putc = console_buffered_putc,
+		.getc = NULL,
+		.flush = console_buffered_flush,
+	};
+
+	assert(console != NULL);
+
+	memcpy(&console->console, &init, sizeof(console_t));
+	console->backend = NULL;
+
+	return console_register(&console->console);
+}
+
+void console_buffered_bind(console_t *backend, console_buffered_t *console)
+{
+	assert((backend != NULL) && (backend->putc != NULL) &&
+	       (console != NULL) && (console->backend == NULL));
+
+	console->backend = backend;
+
+	/* Replay everything captured while there was nowhere to send it */
+	(void)console_buffered_flush(&console->console);
+}
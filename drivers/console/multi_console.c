@@ -6,11 +6,27 @@
 
 #include <assert.h>
 
+#include <platform_def.h>
+
 #include <drivers/console.h>
 
+/*
+ * Size in bytes of the buffer backing quiet regions. Characters printed
+ * while a quiet region is active are held back here and only emitted when
+ * the outermost region exits, so that slow console output does not land
+ * inside timed sections. A platform may override this in platform_def.h.
+ */
+#ifndef CONSOLE_QUIET_BUFFER_SIZE
+#define CONSOLE_QUIET_BUFFER_SIZE	U(2048)
+#endif
+
 console_t *console_list;
 uint8_t console_state = CONSOLE_FLAG_BOOT;
 
+static unsigned char quiet_buffer[CONSOLE_QUIET_BUFFER_SIZE];
+static unsigned int quiet_count;
+static unsigned int quiet_depth;
+
 IMPORT_SYM(console_t *, __STACKS_START__, stacks_start)
 IMPORT_SYM(console_t *, __STACKS_END__, stacks_end)
 
@@ -84,7 +100,7 @@ static int do_putc(int c, console_t *console)
 	return console->putc(c, console);
 }
 
-int console_putc(int c)
+static int console_putc_now(int c)
 {
 	int err = ERROR_NO_VALID_CONSOLE;
 	console_t *console;
@@ -99,6 +115,43 @@ int console_putc(int c)
 	return err;
 }
 
+static void console_quiet_drain(void)
+{
+	unsigned int i;
+
+	for (i = 0U; i < quiet_count; i++)
+		(void)console_putc_now(quiet_buffer[i]);
+
+	quiet_count = 0U;
+}
+
+int console_putc(int c)
+{
+	if (quiet_depth > 0U) {
+		if (quiet_count < CONSOLE_QUIET_BUFFER_SIZE) {
+			quiet_buffer[quiet_count++] = (unsigned char)c;
+			return c;
+		}
+		/* Buffer exhausted: degrade to direct output. */
+	}
+
+	return console_putc_now(c);
+}
+
+void console_quiet_enter(void)
+{
+	quiet_depth++;
+}
+
+void console_quiet_exit(void)
+{
+	assert(quiet_depth > 0U);
+
+	quiet_depth--;
+	if (quiet_depth == 0U)
+		console_quiet_drain();
+}
+
 int console_getc(void)
 {
 	int err = ERROR_NO_VALID_CONSOLE;
@@ -124,6 +177,10 @@ int console_flush(void)
 	int err = ERROR_NO_VALID_CONSOLE;
 	console_t *console;
 
+	/* Do not sit on buffered output, e.g. when flushed from a panic. */
+	if (quiet_count > 0U)
+		console_quiet_drain();
+
 	for (console = console_list; console != NULL; console = console->next)
 		if ((console->flags & console_state) && console->flush) {
 			int ret = console->flush(console);
@@ -5,6 +5,7 @@
  */
 
 #include <assert.h>
+#include <stdbool.h>
 
 #include <platform_def.h>
 
@@ -16,6 +17,9 @@
  ***********************************************************/
 static const timer_ops_t *timer_ops;
 
+/* Set when the registered backend ticks from the Arm generic timer */
+static bool timer_is_generic;
+
 /***********************************************************
  * Delay for the given number of microseconds. The driver must
  * be initialized before calling this function.
@@ -27,6 +31,20 @@ void udelay(uint32_t usec)
 		(timer_ops->clk_div != 0U) &&
 		(timer_ops->get_timer_value != NULL));
 
+	if (timer_is_generic) {
+		/*
+		 * Spin on the inline CNTPCT accessors rather than paying an
+		 * indirect get_timer_value() call per iteration. Add an
+		 * extra tick to avoid delaying less than requested.
+		 */
+		uint64_t expire_cnt = timeout_init_us(usec) + 1U;
+
+		while (!timeout_elapsed(expire_cnt))
+			;
+
+		return;
+	}
+
 	uint32_t start, delta, total_delta;
 
 	assert(usec < (UINT32_MAX / timer_ops->clk_div));
@@ -69,4 +87,17 @@ void timer_init(const timer_ops_t *ops_ptr)
 		(ops_ptr->get_timer_value != NULL));
 
 	timer_ops = ops_ptr;
+	timer_is_generic = false;
+}
+
+/***********************************************************
+ * Variant of timer_init() for backends whose tick source is
+ * the Arm generic timer: udelay() then reads CNTPCT directly
+ * through the inline timeout helpers.
+ ***********************************************************/
+void timer_init_generic(const timer_ops_t *ops_ptr)
+{
+	timer_init(ops_ptr);
+
+	timer_is_generic = true;
 }
@@ -36,7 +36,7 @@ void generic_delay_timer_init_args(uint32_t mult, uint32_t div)
 	ops.clk_mult		= mult;
 	ops.clk_div		= div;
 
-	timer_init(&ops);
+	timer_init_generic(&ops);
 
 	VERBOSE("Generic delay timer configured with mult=%u and div=%u\n",
 		mult, div);
@@ -21,6 +21,9 @@ typedef struct {
 	uintptr_t		base;
 	unsigned long long	file_pos;
 	unsigned long long	size;
+	/* Validity window of the optional read-ahead cache */
+	int			cache_lba;
+	size_t			cache_blocks;
 } block_dev_state_t;
 
 #define is_power_of_2(x)	(((x) != 0U) && (((x) & ((x) - 1U)) == 0U))
@@ -171,6 +174,47 @@ static int block_seek(io_entity_t *entity, int mode, signed long long offset)
 	return 0;
 }
 
+/*
+ * Serve a block-aligned read from the read-ahead cache, refilling the
+ * whole cache window with a single device transaction on a miss. Drop-in
+ * for ops->read(): returns the number of bytes made available at buf.
+ * Only used for requests smaller than the cache window; larger reads go
+ * to the device directly.
+ */
+static size_t block_cache_read(block_dev_state_t *cur, int lba, uintptr_t buf,
+			       size_t request)
+{
+	const io_block_spec_t *cache = &cur->dev_spec->cache;
+	size_t block_size = cur->dev_spec->block_size;
+	size_t blocks = request / block_size;
+
+	if ((lba < cur->cache_lba) ||
+	    ((size_t)(lba - cur->cache_lba) + blocks > cur->cache_blocks)) {
+		size_t fill, got;
+		/* Do not prefetch past the end of the opened region */
+		size_t limit = (cur->base + cur->size) / block_size -
+			       (size_t)lba;
+
+		fill = MIN(cache->length, limit * block_size);
+		got = cur->dev_spec->ops.read(lba, cache->offset, fill);
+		got &= ~(block_size - 1U);
+		if (got < request) {
+			/* Serve the partial fill, the caller copes with it */
+			request = got;
+		}
+
+		cur->cache_lba = lba;
+		cur->cache_blocks = got / block_size;
+	}
+
+	memcpy((void *)buf,
+	       (void *)(cache->offset +
+			(size_t)(lba - cur->cache_lba) * block_size),
+	       request);
+
+	return request;
+}
+
 /*
  * This function allows the caller to read any number of bytes
  * from any position. It hides from the caller that the low level
@@ -314,7 +358,13 @@ static int block_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 			request = (request + (block_size - 1U)) &
 				~(block_size - 1U);
 		}
-		request = ops->read(lba, buf->offset, request);
+		if ((cur->dev_spec->cache.length != 0U) &&
+		    (request < cur->dev_spec->cache.length)) {
+			request = block_cache_read(cur, lba, buf->offset,
+						   request);
+		} else {
+			request = ops->read(lba, buf->offset, request);
+		}
 
 		if (request <= skip) {
 			/*
@@ -386,6 +436,9 @@ static int block_write(io_entity_t *entity, const uintptr_t buffer,
 	       (ops->read != 0) &&
 	       (ops->write != 0));
 
+	/* The written range would make any cached window stale */
+	cur->cache_blocks = 0;
+
 	/*
 	 * We don't know the number of bytes that we are going
 	 * to write in every iteration, because it will depend
@@ -519,6 +572,8 @@ static int block_dev_open(const uintptr_t dev_spec, io_dev_info_t **dev_info)
 	       (is_power_of_2(block_size) != 0U) &&
 	       ((buffer->offset % block_size) == 0U) &&
 	       ((buffer->length % block_size) == 0U));
+	assert(((cur->dev_spec->cache.offset % block_size) == 0U) &&
+	       ((cur->dev_spec->cache.length % block_size) == 0U));
 
 	*dev_info = info;	/* cast away const */
 	(void)block_size;
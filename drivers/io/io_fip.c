@@ -25,6 +25,15 @@
 #define MAX_FIP_DEVICES		1
 #endif
 
+/*
+ * Number of Table of Contents entries cached at fip_dev_init() time so that
+ * subsequent file opens do not re-read the ToC from the backend. A platform
+ * may override this if it packs more images into its FIP.
+ */
+#ifndef FIP_TOC_CACHE_MAX_ENTRIES
+#define FIP_TOC_CACHE_MAX_ENTRIES	32
+#endif
+
 /* Useful for printing UUIDs when debugging.*/
 #define PRINT_UUID2(x)								\
 	"%08x-%04hx-%04hx-%02hhx%02hhx-%02hhx%02hhx%02hhx%02hhx%02hhx%02hhx",	\
@@ -60,6 +69,21 @@ static file_state_t current_file = {0};
 static uintptr_t backend_dev_handle;
 static uintptr_t backend_image_spec;
 
+/*
+ * Parsed ToC cache, populated once per fip_dev_init(). While the cache is
+ * valid, fip_file_open() resolves UUIDs with a memory lookup instead of
+ * walking the ToC on the backend device for every image. If the package
+ * holds more entries than the cache, the remaining entries are looked up
+ * on the device as before.
+ */
+static struct {
+	fip_toc_entry_t entries[FIP_TOC_CACHE_MAX_ENTRIES];
+	unsigned int count;
+	/* Non-zero when the whole ToC fitted into the cache */
+	int complete;
+	int valid;
+} toc_cache;
+
 static fip_dev_state_t state_pool[MAX_FIP_DEVICES];
 static io_dev_info_t dev_info_pool[MAX_FIP_DEVICES];
 
@@ -73,6 +97,8 @@ static int fip_file_open(io_dev_info_t *dev_info, const uintptr_t spec,
 static int fip_file_len(io_entity_t *entity, size_t *length);
 static int fip_file_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 			  size_t *length_read);
+static int fip_file_get_buffer(io_entity_t *entity, uintptr_t *buffer,
+				size_t *length);
 static int fip_file_close(io_entity_t *entity);
 static int fip_dev_init(io_dev_info_t *dev_info, const uintptr_t init_params);
 static int fip_dev_close(io_dev_info_t *dev_info);
@@ -113,6 +139,7 @@ static const io_dev_funcs_t fip_dev_funcs = {
 	.seek = NULL,
 	.size = fip_file_len,
 	.read = fip_file_read,
+	.get_buffer = fip_file_get_buffer,
 	.write = NULL,
 	.close = fip_file_close,
 	.dev_init = fip_dev_init,
@@ -212,6 +239,64 @@ static int fip_dev_open(const uintptr_t dev_spec,
 }
 
 
+/*
+ * Read the Table of Contents into the cache. Stops at the null-UUID
+ * terminator entry or when the cache is full, whichever comes first.
+ */
+static int fip_toc_cache_fill(uintptr_t backend_handle)
+{
+	int result;
+	size_t bytes_read;
+	fip_toc_entry_t *entry;
+
+	toc_cache.count = 0;
+	toc_cache.complete = 0;
+	toc_cache.valid = 0;
+
+	result = io_seek(backend_handle, IO_SEEK_SET,
+			 (signed long long)sizeof(fip_toc_header_t));
+	if (result != 0) {
+		return result;
+	}
+
+	while (toc_cache.count < (unsigned int)FIP_TOC_CACHE_MAX_ENTRIES) {
+		entry = &toc_cache.entries[toc_cache.count];
+		result = io_read(backend_handle, (uintptr_t)entry,
+				 sizeof(*entry), &bytes_read);
+		if (result != 0) {
+			return result;
+		}
+
+		if (compare_uuids(&entry->uuid, &uuid_null) == 0) {
+			toc_cache.complete = 1;
+			break;
+		}
+		++toc_cache.count;
+	}
+
+	toc_cache.valid = 1;
+	VERBOSE("FIP ToC cached: %u entries%s\n", toc_cache.count,
+		(toc_cache.complete == 0) ? " (partial)" : "");
+
+	return 0;
+}
+
+/* Look up a UUID in the cached ToC. Returns 0 on hit. */
+static int fip_toc_cache_lookup(const uuid_t *uuid,
+				const fip_toc_entry_t **entry_out)
+{
+	unsigned int index;
+
+	for (index = 0; index < toc_cache.count; ++index) {
+		if (compare_uuids(&toc_cache.entries[index].uuid, uuid) == 0) {
+			*entry_out = &toc_cache.entries[index];
+			return 0;
+		}
+	}
+
+	return -ENOENT;
+}
+
 /* Do some basic package checks. */
 static int fip_dev_init(io_dev_info_t *dev_info, const uintptr_t init_params)
 {
@@ -248,6 +333,15 @@ static int fip_dev_init(io_dev_info_t *dev_info, const uintptr_t init_params)
 			result = -ENOENT;
 		} else {
 			VERBOSE("FIP header looks OK.\n");
+			/*
+			 * Cache the ToC while the backend is open so that
+			 * file opens do not re-walk it on the device. A
+			 * cache fill failure is not fatal: opens fall back
+			 * to the device walk.
+			 */
+			if (fip_toc_cache_fill(backend_handle) != 0) {
+				toc_cache.valid = 0;
+			}
 		}
 	}
 
@@ -266,6 +360,9 @@ static int fip_dev_close(io_dev_info_t *dev_info)
 	backend_dev_handle = (uintptr_t)NULL;
 	backend_image_spec = (uintptr_t)NULL;
 
+	/* The cached ToC refers to the backend being closed. */
+	zeromem(&toc_cache, sizeof(toc_cache));
+
 	return free_dev_info(dev_info);
 }
 
@@ -294,6 +391,29 @@ static int fip_file_open(io_dev_info_t *dev_info, const uintptr_t spec,
 		return -ENOMEM;
 	}
 
+	/*
+	 * Resolve the UUID from the cached ToC when possible, avoiding any
+	 * backend I/O. Only fall through to the device walk when the cache
+	 * could not hold the whole ToC and the UUID was not among the
+	 * cached entries.
+	 */
+	if (toc_cache.valid != 0) {
+		const fip_toc_entry_t *cached_entry;
+
+		if (fip_toc_cache_lookup(&uuid_spec->uuid,
+					 &cached_entry) == 0) {
+			current_file.entry = *cached_entry;
+			current_file.file_pos = 0;
+			entity->info = (uintptr_t)&current_file;
+			return 0;
+		}
+
+		if (toc_cache.complete != 0) {
+			/* The whole ToC is cached: the file is not there. */
+			return -ENOENT;
+		}
+	}
+
 	/* Attempt to access the FIP image */
 	result = io_open(backend_dev_handle, backend_image_spec,
 			 &backend_handle);
@@ -419,6 +539,52 @@ static int fip_file_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 }
 
 
+/* Report the location of a file in a package whose backend is directly
+ * addressable (e.g. a FIP on a memory-mapped NOR), so that the payload can
+ * be consumed straight out of the mapped package without a copy. */
+static int fip_file_get_buffer(io_entity_t *entity, uintptr_t *buffer,
+				size_t *length)
+{
+	int result;
+	file_state_t *fp;
+	uintptr_t backend_handle;
+	uintptr_t backend_buffer;
+	size_t backend_length;
+
+	assert(entity != NULL);
+	assert((buffer != NULL) && (length != NULL));
+	assert(entity->info != (uintptr_t)NULL);
+
+	/* Open the backend, attempt to access the blob image */
+	result = io_open(backend_dev_handle, backend_image_spec,
+			 &backend_handle);
+	if (result != 0) {
+		WARN("Failed to open FIP (%i)\n", result);
+		return -ENOENT;
+	}
+
+	result = io_get_buffer(backend_handle, &backend_buffer,
+			       &backend_length);
+	if (result == 0) {
+		fp = (file_state_t *)entity->info;
+
+		/* The payload must lie within the backend window */
+		if ((fp->entry.offset_address + fp->entry.size) >
+		    (unsigned long long)backend_length) {
+			result = -ENOENT;
+		} else {
+			*buffer = backend_buffer +
+				  (uintptr_t)fp->entry.offset_address;
+			*length = (size_t)fp->entry.size;
+		}
+	}
+
+	io_close(backend_handle);
+
+	return result;
+}
+
+
 /* Close a file in package */
 static int fip_file_close(io_entity_t *entity)
 {
@@ -437,6 +603,33 @@ static int fip_file_close(io_entity_t *entity)
 
 /* Exported functions */
 
+/*
+ * Report the offset of an entry within the package without opening it.
+ * This is only served from the ToC cache: when the cache is cold, or the
+ * entry was beyond its capacity, -ENOENT is returned and the caller must
+ * treat the position as unknown. The storage-order load scheduler uses
+ * this, and a miss there only costs the optimization.
+ */
+int fip_get_entry_offset(const struct uuid *uuid, unsigned long long *offset)
+{
+	const fip_toc_entry_t *entry;
+	int result;
+
+	assert(uuid != NULL);
+	assert(offset != NULL);
+
+	if (toc_cache.valid == 0) {
+		return -ENOENT;
+	}
+
+	result = fip_toc_cache_lookup(uuid, &entry);
+	if (result == 0) {
+		*offset = entry->offset_address;
+	}
+
+	return result;
+}
+
 /* Register the Firmware Image Package driver with the IO abstraction */
 int register_io_dev_fip(const io_dev_connector_t **dev_con)
 {
@@ -46,6 +46,8 @@ static int memmap_block_seek(io_entity_t *entity, int mode,
 static int memmap_block_len(io_entity_t *entity, size_t *length);
 static int memmap_block_read(io_entity_t *entity, uintptr_t buffer,
 			     size_t length, size_t *length_read);
+static int memmap_block_get_buffer(io_entity_t *entity, uintptr_t *buffer,
+				   size_t *length);
 static int memmap_block_write(io_entity_t *entity, const uintptr_t buffer,
 			      size_t length, size_t *length_written);
 static int memmap_block_close(io_entity_t *entity);
@@ -63,6 +65,7 @@ static const io_dev_funcs_t memmap_dev_funcs = {
 	.seek = memmap_block_seek,
 	.size = memmap_block_len,
 	.read = memmap_block_read,
+	.get_buffer = memmap_block_get_buffer,
 	.write = memmap_block_write,
 	.close = memmap_block_close,
 	.dev_init = NULL,
@@ -194,6 +197,25 @@ static int memmap_block_read(io_entity_t *entity, uintptr_t buffer,
 }
 
 
+/* Report the location of a file on the memmap device. The whole file is
+ * directly addressable, so it can be consumed in place without a copy. */
+static int memmap_block_get_buffer(io_entity_t *entity, uintptr_t *buffer,
+				   size_t *length)
+{
+	file_state_t *fp;
+
+	assert(entity != NULL);
+	assert((buffer != NULL) && (length != NULL));
+
+	fp = (file_state_t *) entity->info;
+
+	*buffer = fp->base;
+	*length = (size_t)fp->size;
+
+	return 0;
+}
+
+
 /* Write data to a file on the memmap device */
 static int memmap_block_write(io_entity_t *entity, const uintptr_t buffer,
 			      size_t length, size_t *length_written)
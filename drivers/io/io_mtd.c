@@ -14,12 +14,29 @@
 #include <drivers/io/io_driver.h>
 #include <drivers/io/io_mtd.h>
 #include <lib/utils.h>
+#include <lib/utils_def.h>
+
+/*
+ * Byte size of the read coalescing buffer, 0 to disable coalescing.
+ *
+ * Flash read commands pay a fixed setup cost (command, address and dummy
+ * cycles), so reads shorter than the buffer are widened to fill it and
+ * later requests landing inside the buffered window are split from memory
+ * instead of issuing new commands. This fuses the typical small header
+ * read with the adjacent payload read into a single device transaction.
+ * A platform may override this in platform_def.h.
+ */
+#ifndef MTD_READ_COALESCE_SIZE
+#define MTD_READ_COALESCE_SIZE	0U
+#endif
 
 typedef struct {
 	io_mtd_dev_spec_t	*dev_spec;
 	uintptr_t		base;
 	unsigned long long	offset;		/* Offset in bytes */
 	unsigned long long	size;	/* Size of device in bytes */
+	unsigned long long	ra_offset;	/* Coalescing window offset */
+	size_t			ra_valid;	/* Coalescing window length */
 } mtd_dev_state_t;
 
 io_type_t device_type_mtd(void);
@@ -29,6 +46,8 @@ static int mtd_open(io_dev_info_t *dev_info, const uintptr_t spec,
 static int mtd_seek(io_entity_t *entity, int mode, signed long long offset);
 static int mtd_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 		    size_t *length_read);
+static int mtd_write(io_entity_t *entity, const uintptr_t buffer,
+		     size_t length, size_t *length_written);
 static int mtd_close(io_entity_t *entity);
 static int mtd_dev_open(const uintptr_t dev_spec, io_dev_info_t **dev_info);
 static int mtd_dev_close(io_dev_info_t *dev_info);
@@ -42,6 +61,7 @@ static const io_dev_funcs_t mtd_dev_funcs = {
 	.open		= mtd_open,
 	.seek		= mtd_seek,
 	.read		= mtd_read,
+	.write		= mtd_write,
 	.close		= mtd_close,
 	.dev_close	= mtd_dev_close,
 };
@@ -159,19 +179,84 @@ static int mtd_seek(io_entity_t *entity, int mode, signed long long offset)
 	return 0;
 }
 
+#if MTD_READ_COALESCE_SIZE != 0U
+static uint8_t coalesce_pool[MAX_IO_MTD_DEVICES][MTD_READ_COALESCE_SIZE];
+
+/*
+ * Serve a read request, fusing small adjacent transactions into a single
+ * flash read command. A request shorter than the coalescing buffer issues
+ * one buffer-wide device read; the part of following requests that falls
+ * inside the buffered window is then copied from memory.
+ */
+static int mtd_coalesced_read(mtd_dev_state_t *cur, uintptr_t buffer,
+			      size_t length, size_t *out_length)
+{
+	io_mtd_ops_t *ops = &cur->dev_spec->ops;
+	uint8_t *ra_buf = coalesce_pool[cur - state_pool];
+	unsigned long long offset = cur->offset;
+	size_t in_buf = 0U;
+	size_t ra_len;
+	int ret;
+
+	/* Serve the leading part held in the buffered window, if any */
+	if ((cur->ra_valid != 0U) && (offset >= cur->ra_offset) &&
+	    (offset < (cur->ra_offset + cur->ra_valid))) {
+		in_buf = MIN(length,
+			     (size_t)(cur->ra_offset + cur->ra_valid -
+				      offset));
+		memcpy((void *)buffer, &ra_buf[offset - cur->ra_offset],
+		       in_buf);
+		if (in_buf == length) {
+			*out_length = length;
+			return 0;
+		}
+
+		offset += in_buf;
+		buffer += in_buf;
+		length -= in_buf;
+	}
+
+	/* Remainders wider than the buffer go straight to the device */
+	if (length >= MTD_READ_COALESCE_SIZE) {
+		ret = ops->read(offset, buffer, length, out_length);
+		if (ret == 0) {
+			*out_length += in_buf;
+		}
+
+		return ret;
+	}
+
+	/* Widen the transaction to fill the coalescing buffer */
+	ra_len = (size_t)MIN((unsigned long long)MTD_READ_COALESCE_SIZE,
+			     cur->dev_spec->device_size - offset);
+
+	ret = ops->read(offset, (uintptr_t)ra_buf, ra_len, &cur->ra_valid);
+	if (ret < 0) {
+		cur->ra_valid = 0U;
+		return ret;
+	}
+
+	assert(cur->ra_valid >= length);
+	cur->ra_offset = offset;
+
+	memcpy((void *)buffer, ra_buf, length);
+	*out_length = in_buf + length;
+
+	return 0;
+}
+#endif /* MTD_READ_COALESCE_SIZE != 0U */
+
 static int mtd_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 		    size_t *out_length)
 {
 	mtd_dev_state_t *cur;
-	io_mtd_ops_t *ops;
 	int ret;
 
 	assert(entity->info != (uintptr_t)NULL);
 	assert((length > 0U) && (buffer != (uintptr_t)NULL));
 
 	cur = (mtd_dev_state_t *)entity->info;
-	ops = &cur->dev_spec->ops;
-	assert(ops->read != NULL);
+	assert(cur->dev_spec->ops.read != NULL);
 
 	VERBOSE("Read at %llx into %lx, length %zi\n",
 		cur->offset, buffer, length);
@@ -179,7 +264,12 @@ static int mtd_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 		return -EINVAL;
 	}
 
-	ret = ops->read(cur->offset, buffer, length, out_length);
+#if MTD_READ_COALESCE_SIZE != 0U
+	ret = mtd_coalesced_read(cur, buffer, length, out_length);
+#else
+	ret = cur->dev_spec->ops.read(cur->offset, buffer, length,
+				      out_length);
+#endif
 	if (ret < 0) {
 		return ret;
 	}
@@ -190,6 +280,117 @@ static int mtd_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 	return 0;
 }
 
+/*
+ * Compare an erase block candidate against the device content.
+ *
+ * Return 1 when the device already holds the data, 0 when it differs,
+ * a negative error code otherwise.
+ */
+static int mtd_block_is_same(mtd_dev_state_t *cur, unsigned long long offset,
+			     uintptr_t buffer, size_t length)
+{
+	uint8_t cmp_buf[128U];
+	size_t chunk;
+	size_t read_len;
+	int ret;
+
+	while (length != 0U) {
+		chunk = MIN(length, sizeof(cmp_buf));
+
+		ret = cur->dev_spec->ops.read((unsigned int)offset,
+					      (uintptr_t)cmp_buf, chunk,
+					      &read_len);
+		if (ret < 0) {
+			return ret;
+		}
+
+		if (memcmp(cmp_buf, (void *)buffer, chunk) != 0) {
+			return 0;
+		}
+
+		offset += chunk;
+		buffer += chunk;
+		length -= chunk;
+	}
+
+	return 1;
+}
+
+/*
+ * Write at the current seek position, which must sit on an erase block
+ * boundary, rewriting only the erase blocks whose content actually
+ * changes. Each target block is read back and compared against the new
+ * data first; identical blocks are skipped, so a delta update pays
+ * erase and program time only for the blocks it really modifies.
+ */
+static int mtd_write(io_entity_t *entity, const uintptr_t buffer,
+		     size_t length, size_t *length_written)
+{
+	mtd_dev_state_t *cur;
+	io_mtd_ops_t *ops;
+	unsigned long long offset;
+	unsigned int erase_size;
+	uintptr_t data = buffer;
+	size_t remaining = length;
+	size_t block_len;
+	int ret;
+
+	assert(entity->info != (uintptr_t)NULL);
+	assert((length > 0U) && (buffer != (uintptr_t)NULL));
+
+	cur = (mtd_dev_state_t *)entity->info;
+	ops = &cur->dev_spec->ops;
+	if ((ops->write == NULL) || (ops->erase == NULL)) {
+		return -ENOTSUP;
+	}
+
+	erase_size = cur->dev_spec->erase_size;
+	if ((erase_size == 0U) || ((cur->offset % erase_size) != 0U) ||
+	    ((cur->offset + length) > cur->dev_spec->device_size)) {
+		return -EINVAL;
+	}
+
+	VERBOSE("Write at %llx from %lx, length %zi\n",
+		cur->offset, buffer, length);
+
+#if MTD_READ_COALESCE_SIZE != 0U
+	/* The buffered window may cover data about to change */
+	cur->ra_valid = 0U;
+#endif
+
+	offset = cur->offset;
+	while (remaining != 0U) {
+		block_len = MIN(remaining, (size_t)erase_size);
+
+		ret = mtd_block_is_same(cur, offset, data, block_len);
+		if (ret < 0) {
+			return ret;
+		}
+
+		if (ret == 0) {
+			ret = ops->erase((unsigned int)offset);
+			if (ret < 0) {
+				return ret;
+			}
+
+			ret = ops->write((unsigned int)offset, data,
+					 block_len);
+			if (ret < 0) {
+				return ret;
+			}
+		}
+
+		offset += block_len;
+		data += block_len;
+		remaining -= block_len;
+	}
+
+	*length_written = length;
+	cur->offset = offset;
+
+	return 0;
+}
+
 static int mtd_close(io_entity_t *entity)
 {
 	entity->info = (uintptr_t)NULL;
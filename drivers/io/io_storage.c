@@ -5,22 +5,26 @@
  */
 
 #include <assert.h>
+#include <stdbool.h>
 #include <stddef.h>
 
 #include <platform_def.h>
 
 #include <drivers/io/io_driver.h>
 #include <drivers/io/io_storage.h>
+#include <lib/cassert.h>
+#include <lib/utils_def.h>
 
 /* Storage for a fixed maximum number of IO entities, definable by platform */
 static io_entity_t entity_pool[MAX_IO_HANDLES];
 
-/* Simple way of tracking used storage - each entry is NULL or a pointer to an
- * entity */
-static io_entity_t *entity_map[MAX_IO_HANDLES];
-
-/* Track number of allocated entities */
-static unsigned int entity_count;
+/*
+ * Bitmap of allocated pool slots, bit n covering entity_pool[n]. Allocation
+ * and release are index arithmetic on this word, so the open/close churn of
+ * an image load pays no pool walk.
+ */
+static uint32_t entity_in_use;
+CASSERT(MAX_IO_HANDLES <= 32U, assert_max_io_handles_exceed_entity_bitmap);
 
 /* Array of fixed maximum of registered devices, definable by platform */
 static const io_dev_info_t *devices[MAX_IO_DEVICES];
@@ -28,6 +32,29 @@ static const io_dev_info_t *devices[MAX_IO_DEVICES];
 /* Number of currently registered devices */
 static unsigned int dev_count;
 
+/* Once the platform has finished wiring up its boot devices the registry
+ * becomes read-only: readers may then index it without synchronisation */
+static bool dev_registry_frozen;
+
+/* Results of emulated asynchronous reads, recorded at submission time for
+ * devices whose driver has no background transfer support. Each entry is
+ * indexed by the pool slot of the submitting entity and free when its
+ * entity pointer is NULL */
+static struct async_result {
+	const io_entity_t *entity;
+	size_t length_read;
+} async_results[MAX_IO_HANDLES];
+
+/* Return the pool slot index of an entity */
+static unsigned int entity_index(const io_entity_t *entity)
+{
+	unsigned int index = (unsigned int)(entity - entity_pool);
+
+	assert((entity >= entity_pool) && (index < MAX_IO_HANDLES));
+
+	return index;
+}
+
 /* Extra validation functions only used when asserts are enabled */
 #if ENABLE_ASSERTIONS
 
@@ -91,33 +118,19 @@ static void set_handle(uintptr_t *handle, io_entity_t *entity)
 }
 
 
-/* Locate an entity in the pool, specified by address */
-static int find_first_entity(const io_entity_t *entity, unsigned int *index_out)
-{
-	int result = -ENOENT;
-	for (unsigned int index = 0; index < MAX_IO_HANDLES; ++index) {
-		if (entity_map[index] == entity) {
-			result = 0;
-			*index_out = index;
-			break;
-		}
-	}
-	return result;
-}
-
-
 /* Allocate an entity from the pool and return a pointer to it */
 static int allocate_entity(io_entity_t **entity)
 {
 	int result = -ENOMEM;
 	assert(entity != NULL);
 
-	if (entity_count < MAX_IO_HANDLES) {
-		unsigned int index = 0;
-		result = find_first_entity(NULL, &index);
-		assert(result == 0);
-		*entity = entity_map[index] = &entity_pool[index];
-		++entity_count;
+	for (unsigned int index = 0; index < MAX_IO_HANDLES; ++index) {
+		if ((entity_in_use & BIT_32(index)) == 0U) {
+			entity_in_use |= BIT_32(index);
+			*entity = &entity_pool[index];
+			result = 0;
+			break;
+		}
 	}
 
 	return result;
@@ -127,14 +140,14 @@ static int allocate_entity(io_entity_t **entity)
 /* Release an entity back to the pool */
 static int free_entity(const io_entity_t *entity)
 {
-	int result;
-	unsigned int index = 0;
+	int result = -ENOENT;
+	unsigned int index;
 	assert(entity != NULL);
 
-	result = find_first_entity(entity, &index);
-	if (result ==  0) {
-		entity_map[index] = NULL;
-		--entity_count;
+	index = entity_index(entity);
+	if ((entity_in_use & BIT_32(index)) != 0U) {
+		entity_in_use &= ~BIT_32(index);
+		result = 0;
 	}
 
 	return result;
@@ -149,6 +162,10 @@ int io_register_device(const io_dev_info_t *dev_info)
 	int result = -ENOMEM;
 	assert(dev_info != NULL);
 
+	if (dev_registry_frozen) {
+		return -EPERM;
+	}
+
 	if (dev_count < MAX_IO_DEVICES) {
 		devices[dev_count] = dev_info;
 		dev_count++;
@@ -159,6 +176,13 @@ int io_register_device(const io_dev_info_t *dev_info)
 }
 
 
+/* Seal the device registry against further registrations */
+void io_storage_freeze(void)
+{
+	dev_registry_frozen = true;
+}
+
+
 /* Open a connection to an IO device */
 int io_dev_open(const io_dev_connector_t *dev_con, const uintptr_t dev_spec,
 		uintptr_t *handle)
@@ -290,6 +314,88 @@ int io_read(uintptr_t handle,
 }
 
 
+/* Report the memory-mapped location of an IO entity's content */
+int io_get_buffer(uintptr_t handle, uintptr_t *buffer, size_t *length)
+{
+	int result = -ENOTSUP;
+	assert(is_valid_entity(handle) && (buffer != NULL) && (length != NULL));
+
+	io_entity_t *entity = (io_entity_t *)handle;
+
+	io_dev_info_t *dev = entity->dev_handle;
+
+	if (dev->funcs->get_buffer != NULL)
+		result = dev->funcs->get_buffer(entity, buffer, length);
+
+	return result;
+}
+
+
+/* Submit an asynchronous read on an IO entity */
+int io_read_async(uintptr_t handle, uintptr_t buffer, size_t length)
+{
+	int result;
+	assert(is_valid_entity(handle));
+
+	io_entity_t *entity = (io_entity_t *)handle;
+
+	io_dev_info_t *dev = entity->dev_handle;
+
+	if (dev->funcs->read_async != NULL) {
+		return dev->funcs->read_async(entity, buffer, length);
+	}
+
+	if (dev->funcs->read == NULL) {
+		return -ENODEV;
+	}
+
+	struct async_result *slot = &async_results[entity_index(entity)];
+
+	/* Only one outstanding transfer is allowed per entity */
+	if (slot->entity != NULL) {
+		return -ENOMEM;
+	}
+
+	/* Emulate the submission with a synchronous read, recording the
+	 * transferred length for the later io_poll() */
+
+	result = dev->funcs->read(entity, buffer, length, &slot->length_read);
+	if (result == 0) {
+		slot->entity = entity;
+	}
+
+	return result;
+}
+
+
+/* Wait for completion of an asynchronous read and report its length */
+int io_poll(uintptr_t handle, size_t *length_read)
+{
+	assert(is_valid_entity(handle));
+	assert(length_read != NULL);
+
+	io_entity_t *entity = (io_entity_t *)handle;
+
+	io_dev_info_t *dev = entity->dev_handle;
+
+	if (dev->funcs->poll != NULL) {
+		return dev->funcs->poll(entity, length_read);
+	}
+
+	struct async_result *slot = &async_results[entity_index(entity)];
+
+	/* No transfer was submitted on this entity */
+	if (slot->entity != entity) {
+		return -ENOENT;
+	}
+
+	*length_read = slot->length_read;
+	slot->entity = NULL;
+
+	return 0;
+}
+
+
 /* Write data to an IO entity */
 int io_write(uintptr_t handle,
 		const uintptr_t buffer,
@@ -326,6 +432,9 @@ int io_close(uintptr_t handle)
 	if (dev->funcs->close != NULL)
 		result = dev->funcs->close(entity);
 
+	/* Drop any emulated asynchronous result never collected */
+	async_results[entity_index(entity)].entity = NULL;
+
 	/* Ignore improbable free_entity failure */
 	(void)free_entity(entity);
 
@@ -50,6 +50,41 @@ static bool is_sd_cmd6_enabled(void)
 	return ((mmc_flags & MMC_FLAG_SD_CMD6) != 0U);
 }
 
+static bool is_ddr52_enabled(void)
+{
+	return ((mmc_flags & MMC_FLAG_DDR52) != 0U);
+}
+
+static bool is_hs200_enabled(void)
+{
+	return ((mmc_flags & MMC_FLAG_HS200) != 0U);
+}
+
+/*
+ * Device type checks behind the MMC_DEVICE_TYPE build option. In a
+ * specialized build they fold to constants, so the negotiation path of
+ * the other device family compiles out of the enumeration code.
+ */
+static bool mmc_is_emmc(void)
+{
+#if MMC_DEVICE_TYPE == MMC_EMMC_ONLY
+	return true;
+#elif MMC_DEVICE_TYPE == MMC_SD_ONLY
+	return false;
+#else
+	return mmc_dev_info->mmc_dev_type == MMC_IS_EMMC;
+#endif
+}
+
+static bool mmc_is_sd_hc(void)
+{
+#if MMC_DEVICE_TYPE == MMC_EMMC_ONLY
+	return false;
+#else
+	return mmc_dev_info->mmc_dev_type == MMC_IS_SD_HC;
+#endif
+}
+
 static int mmc_send_cmd(unsigned int idx, unsigned int arg,
 			unsigned int r_type, unsigned int *r_data)
 {
@@ -201,7 +236,7 @@ static int mmc_set_ios(unsigned int clk, unsigned int bus_width)
 	int ret;
 	unsigned int width = bus_width;
 
-	if (mmc_dev_info->mmc_dev_type != MMC_IS_EMMC) {
+	if (!mmc_is_emmc()) {
 		if (width == MMC_BUS_WIDTH_8) {
 			WARN("Wrong bus config for SD-card, force to 4\n");
 			width = MMC_BUS_WIDTH_4;
@@ -229,11 +264,10 @@ static int mmc_fill_device_info(void)
 	unsigned int speed_idx;
 	unsigned int nb_blocks;
 	unsigned int freq_unit;
-	int ret = 0;
+	int ret;
 	struct mmc_csd_sd_v2 *csd_sd_v2;
 
-	switch (mmc_dev_info->mmc_dev_type) {
-	case MMC_IS_EMMC:
+	if (mmc_is_emmc()) {
 		mmc_dev_info->block_size = MMC_BLOCK_SIZE;
 
 		ret = ops->prepare(0, (uintptr_t)&mmc_ext_csd,
@@ -268,10 +302,7 @@ static int mmc_fill_device_info(void)
 
 		mmc_dev_info->device_size = (unsigned long long)nb_blocks *
 			mmc_dev_info->block_size;
-
-		break;
-
-	case MMC_IS_SD:
+	} else if (mmc_dev_info->mmc_dev_type == MMC_IS_SD) {
 		/*
 		 * Use the same mmc_csd struct, as required fields here
 		 * (READ_BL_LEN, C_SIZE, CSIZE_MULT) are common with eMMC.
@@ -285,10 +316,7 @@ static int mmc_fill_device_info(void)
 		mmc_dev_info->device_size = (c_size + 1U) *
 					    BIT_64(mmc_csd.c_size_mult + 2U) *
 					    mmc_dev_info->block_size;
-
-		break;
-
-	case MMC_IS_SD_HC:
+	} else if (mmc_is_sd_hc()) {
 		assert(mmc_csd.csd_structure == 1U);
 
 		mmc_dev_info->block_size = MMC_BLOCK_SIZE;
@@ -299,16 +327,8 @@ static int mmc_fill_device_info(void)
 			 (unsigned long long)csd_sd_v2->c_size_low;
 
 		mmc_dev_info->device_size = (c_size + 1U) << MULT_BY_512K_SHIFT;
-
-		break;
-
-	default:
-		ret = -EINVAL;
-		break;
-	}
-
-	if (ret < 0) {
-		return ret;
+	} else {
+		return -EINVAL;
 	}
 
 	speed_idx = (mmc_csd.tran_speed & CSD_TRAN_SPEED_MULT_MASK) >>
@@ -316,7 +336,7 @@ static int mmc_fill_device_info(void)
 
 	assert(speed_idx > 0U);
 
-	if (mmc_dev_info->mmc_dev_type == MMC_IS_EMMC) {
+	if (mmc_is_emmc()) {
 		mmc_dev_info->max_bus_freq = tran_speed_base[speed_idx];
 	} else {
 		mmc_dev_info->max_bus_freq = sd_tran_speed_base[speed_idx];
@@ -333,6 +353,86 @@ static int mmc_fill_device_info(void)
 	return 0;
 }
 
+/*
+ * Raise an eMMC device above High Speed when the platform driver reported
+ * support for a faster bus speed mode. The request is cross-checked against
+ * the DEVICE_TYPE capability byte read with the EXT_CSD; on failure the
+ * device is left in the mode programmed during enumeration.
+ */
+static int mmc_emmc_switch_bus_speed(unsigned int clk, unsigned int bus_width)
+{
+	unsigned int device_type = mmc_ext_csd[CMD_EXTCSD_DEVICE_TYPE];
+	unsigned int hs_freq = mmc_dev_info->max_bus_freq;
+	unsigned int width = bus_width;
+	int ret;
+
+	if (is_hs200_enabled() && (ops->execute_tuning != NULL) &&
+	    ((device_type & MMC_DEVICE_TYPE_HS200_1V8) != 0U) &&
+	    (width != MMC_BUS_WIDTH_1)) {
+		/*
+		 * HS200: program the timing at the current clock first, then
+		 * raise the bus clock and tune the read sampling point.
+		 */
+		ret = mmc_set_ext_csd(CMD_EXTCSD_HS_TIMING,
+				      MMC_HS_TIMING_HS200);
+		if (ret != 0) {
+			return ret;
+		}
+
+		mmc_dev_info->max_bus_freq = 200000000U;
+
+		ret = ops->set_ios(clk, width);
+		if (ret == 0) {
+			ret = ops->execute_tuning(clk, width);
+			if (ret == 0) {
+				return 0;
+			}
+		}
+
+		/*
+		 * No working sampling point: fall back to High Speed. The
+		 * CMD line is sampled with a fixed delay, so the switch
+		 * command is still reliable at the HS200 clock.
+		 */
+		WARN("HS200 tuning failed, falling back to High Speed\n");
+
+		ret = mmc_set_ext_csd(CMD_EXTCSD_HS_TIMING, MMC_HS_TIMING_HS);
+		if (ret != 0) {
+			return ret;
+		}
+
+		mmc_dev_info->max_bus_freq = hs_freq;
+
+		return ops->set_ios(clk, width);
+	}
+
+	if (is_ddr52_enabled() &&
+	    ((device_type & MMC_DEVICE_TYPE_DDR_52_1V8_3V) != 0U)) {
+		if (width == MMC_BUS_WIDTH_4) {
+			width = MMC_BUS_WIDTH_DDR_4;
+		} else if (width == MMC_BUS_WIDTH_8) {
+			width = MMC_BUS_WIDTH_DDR_8;
+		} else {
+			return 0;
+		}
+
+		/* The High Speed timing must be set before a DDR width */
+		ret = mmc_set_ext_csd(CMD_EXTCSD_HS_TIMING, MMC_HS_TIMING_HS);
+		if (ret != 0) {
+			return ret;
+		}
+
+		ret = mmc_set_ext_csd(CMD_EXTCSD_BUS_WIDTH, width);
+		if (ret != 0) {
+			return ret;
+		}
+
+		return ops->set_ios(clk, width);
+	}
+
+	return 0;
+}
+
 static int sd_switch(unsigned char mode, unsigned char group,
 		     unsigned char func)
 {
@@ -460,7 +560,7 @@ static int mmc_enumerate(unsigned int clk, unsigned int bus_width)
 		return ret;
 	};
 
-	if (mmc_dev_info->mmc_dev_type == MMC_IS_EMMC) {
+	if (mmc_is_emmc()) {
 		ret = mmc_send_op_cond();
 	} else {
 		/* CMD8: Send Interface Condition Command */
@@ -482,7 +582,7 @@ static int mmc_enumerate(unsigned int clk, unsigned int bus_width)
 	}
 
 	/* CMD3: Set Relative Address */
-	if (mmc_dev_info->mmc_dev_type == MMC_IS_EMMC) {
+	if (mmc_is_emmc()) {
 		rca = MMC_FIX_RCA;
 		ret = mmc_send_cmd(MMC_CMD(3), rca << RCA_SHIFT_OFFSET,
 				   MMC_RESPONSE_R1, NULL);
@@ -532,8 +632,15 @@ static int mmc_enumerate(unsigned int clk, unsigned int bus_width)
 		return ret;
 	}
 
-	if (is_sd_cmd6_enabled() &&
-	    (mmc_dev_info->mmc_dev_type == MMC_IS_SD_HC)) {
+	if (mmc_is_emmc() && (mmc_csd.spec_vers == 4U) &&
+	    (is_hs200_enabled() || is_ddr52_enabled())) {
+		ret = mmc_emmc_switch_bus_speed(clk, bus_width);
+		if (ret != 0) {
+			return ret;
+		}
+	}
+
+	if (is_sd_cmd6_enabled() && mmc_is_sd_hc()) {
 		/* Try to switch to High Speed Mode */
 		ret = sd_switch(SD_SWITCH_FUNC_CHECK, 1U, 1U);
 		if (ret != 0) {
@@ -595,7 +702,7 @@ size_t mmc_read_blocks(int lba, uintptr_t buf, size_t size)
 	}
 
 	if (((mmc_ocr_value & OCR_ACCESS_MODE_MASK) == OCR_BYTE_MODE) &&
-	    (mmc_dev_info->mmc_dev_type != MMC_IS_SD_HC)) {
+	    !mmc_is_sd_hc()) {
 		cmd_arg = lba * MMC_BLOCK_SIZE;
 	} else {
 		cmd_arg = lba;
@@ -629,6 +736,101 @@ size_t mmc_read_blocks(int lba, uintptr_t buf, size_t size)
 	return size;
 }
 
+size_t mmc_read_blocks_multi(int lba, const struct mmc_buf *bufs,
+			     unsigned int count)
+{
+	int ret;
+	unsigned int cmd_idx, cmd_arg, i;
+	size_t size = 0U;
+
+	assert((ops != NULL) &&
+	       (bufs != NULL) &&
+	       (count != 0U));
+
+	for (i = 0U; i < count; i++) {
+		assert((bufs[i].size != 0U) &&
+		       ((bufs[i].size & MMC_BLOCK_MASK) == 0U));
+		size += bufs[i].size;
+	}
+
+	if ((ops->prepare_multi == NULL) || (ops->read_multi == NULL)) {
+		goto fallback;
+	}
+
+	ret = ops->prepare_multi(lba, bufs, count);
+	if (ret == -EOPNOTSUPP) {
+		/* The driver cannot handle this list, use single reads */
+		goto fallback;
+	}
+	if (ret != 0) {
+		return 0;
+	}
+
+	if (is_cmd23_enabled()) {
+		/* Set block count */
+		ret = mmc_send_cmd(MMC_CMD(23), size / MMC_BLOCK_SIZE,
+				   MMC_RESPONSE_R1, NULL);
+		if (ret != 0) {
+			return 0;
+		}
+
+		cmd_idx = MMC_CMD(18);
+	} else {
+		if (size > MMC_BLOCK_SIZE) {
+			cmd_idx = MMC_CMD(18);
+		} else {
+			cmd_idx = MMC_CMD(17);
+		}
+	}
+
+	if (((mmc_ocr_value & OCR_ACCESS_MODE_MASK) == OCR_BYTE_MODE) &&
+	    !mmc_is_sd_hc()) {
+		cmd_arg = lba * MMC_BLOCK_SIZE;
+	} else {
+		cmd_arg = lba;
+	}
+
+	ret = mmc_send_cmd(cmd_idx, cmd_arg, MMC_RESPONSE_R1, NULL);
+	if (ret != 0) {
+		return 0;
+	}
+
+	ret = ops->read_multi(lba, bufs, count);
+	if (ret != 0) {
+		return 0;
+	}
+
+	/* Wait buffer empty */
+	do {
+		ret = mmc_device_state();
+		if (ret < 0) {
+			return 0;
+		}
+	} while ((ret != MMC_STATE_TRAN) && (ret != MMC_STATE_DATA));
+
+	if (!is_cmd23_enabled() && (size > MMC_BLOCK_SIZE)) {
+		ret = mmc_send_cmd(MMC_CMD(12), 0, MMC_RESPONSE_R1B, NULL);
+		if (ret != 0) {
+			return 0;
+		}
+	}
+
+	return size;
+
+fallback:
+	size = 0U;
+	for (i = 0U; i < count; i++) {
+		if (mmc_read_blocks(lba, bufs[i].buf, bufs[i].size) !=
+		    bufs[i].size) {
+			return size;
+		}
+		size += bufs[i].size;
+		lba += bufs[i].size / MMC_BLOCK_SIZE;
+	}
+
+	return size;
+}
+
 size_t mmc_write_blocks(int lba, const uintptr_t buf, size_t size)
 {
 	int ret;
@@ -640,7 +842,11 @@ size_t mmc_write_blocks(int lba, const uintptr_t buf, size_t size)
 	       ((buf & MMC_BLOCK_MASK) == 0U) &&
 	       ((size & MMC_BLOCK_MASK) == 0U));
 
-	ret = ops->prepare(lba, buf, size);
+	if (ops->prepare_wr != NULL) {
+		ret = ops->prepare_wr(lba, buf, size);
+	} else {
+		ret = ops->prepare(lba, buf, size);
+	}
 	if (ret != 0) {
 		return 0;
 	}
@@ -696,6 +902,109 @@ size_t mmc_write_blocks(int lba, const uintptr_t buf, size_t size)
 	return size;
 }
 
+size_t mmc_write_blocks_multi(int lba, const struct mmc_buf *bufs,
+			      unsigned int count, unsigned int flags)
+{
+	int ret;
+	unsigned int cmd_idx, cmd_arg, i;
+	size_t size = 0U;
+
+	assert((ops != NULL) &&
+	       (bufs != NULL) &&
+	       (count != 0U));
+
+	for (i = 0U; i < count; i++) {
+		assert((bufs[i].size != 0U) &&
+		       ((bufs[i].buf & MMC_BLOCK_MASK) == 0U) &&
+		       ((bufs[i].size & MMC_BLOCK_MASK) == 0U));
+		size += bufs[i].size;
+	}
+
+	/* A reliable write is requested through the CMD23 argument */
+	assert(((flags & MMC_WR_FLAG_REL) == 0U) || is_cmd23_enabled());
+
+	if ((ops->prepare_wr_multi == NULL) || (ops->write_multi == NULL)) {
+		goto fallback;
+	}
+
+	ret = ops->prepare_wr_multi(lba, bufs, count);
+	if (ret == -EOPNOTSUPP) {
+		/* The driver cannot handle this list, use single writes */
+		goto fallback;
+	}
+	if (ret != 0) {
+		return 0;
+	}
+
+	if (is_cmd23_enabled()) {
+		/* Set block count */
+		cmd_arg = size / MMC_BLOCK_SIZE;
+		if ((flags & MMC_WR_FLAG_REL) != 0U) {
+			cmd_arg |= MMC_CMD23_ARG_REL_WR;
+		}
+
+		ret = mmc_send_cmd(MMC_CMD(23), cmd_arg, MMC_RESPONSE_R1,
+				   NULL);
+		if (ret != 0) {
+			return 0;
+		}
+
+		cmd_idx = MMC_CMD(25);
+	} else {
+		if (size > MMC_BLOCK_SIZE) {
+			cmd_idx = MMC_CMD(25);
+		} else {
+			cmd_idx = MMC_CMD(24);
+		}
+	}
+
+	if ((mmc_ocr_value & OCR_ACCESS_MODE_MASK) == OCR_BYTE_MODE) {
+		cmd_arg = lba * MMC_BLOCK_SIZE;
+	} else {
+		cmd_arg = lba;
+	}
+
+	ret = mmc_send_cmd(cmd_idx, cmd_arg, MMC_RESPONSE_R1, NULL);
+	if (ret != 0) {
+		return 0;
+	}
+
+	ret = ops->write_multi(lba, bufs, count);
+	if (ret != 0) {
+		return 0;
+	}
+
+	/* Wait buffer empty */
+	do {
+		ret = mmc_device_state();
+		if (ret < 0) {
+			return 0;
+		}
+	} while ((ret != MMC_STATE_TRAN) && (ret != MMC_STATE_RCV));
+
+	if (!is_cmd23_enabled() && (size > MMC_BLOCK_SIZE)) {
+		ret = mmc_send_cmd(MMC_CMD(12), 0, MMC_RESPONSE_R1B, NULL);
+		if (ret != 0) {
+			return 0;
+		}
+	}
+
+	return size;
+
+fallback:
+	size = 0U;
+	for (i = 0U; i < count; i++) {
+		if (mmc_write_blocks(lba, bufs[i].buf, bufs[i].size) !=
+		    bufs[i].size) {
+			return size;
+		}
+		size += bufs[i].size;
+		lba += bufs[i].size / MMC_BLOCK_SIZE;
+	}
+
+	return size;
+}
+
 size_t mmc_erase_blocks(int lba, size_t size)
 {
 	int ret;
@@ -794,6 +1103,13 @@ int mmc_init(const struct mmc_ops *ops_ptr, unsigned int clk,
 		(width == MMC_BUS_WIDTH_DDR_4) ||
 		(width == MMC_BUS_WIDTH_DDR_8)));
 
+	/* A specialized build must match the device wired on the board */
+#if MMC_DEVICE_TYPE == MMC_EMMC_ONLY
+	assert(device_info->mmc_dev_type == MMC_IS_EMMC);
+#elif MMC_DEVICE_TYPE == MMC_SD_ONLY
+	assert(device_info->mmc_dev_type != MMC_IS_EMMC);
+#endif
+
 	ops = ops_ptr;
 	mmc_flags = flags;
 	mmc_dev_info = device_info;
@@ -27,6 +27,21 @@
 #define SZ_128M			0x08000000U
 #define SZ_512			0x200U
 
+/*
+ * Bad-block bitmap built once per boot. Bad-block markers are probed in
+ * sequential chunks ahead of the data reads, so each block is probed at
+ * most once and the OOB reads are not interleaved with the data pages,
+ * which would break the controller's sequential read pipelining.
+ * Blocks beyond NAND_BBT_MAX_BLOCKS fall back to direct probing.
+ */
+#ifndef NAND_BBT_MAX_BLOCKS
+#define NAND_BBT_MAX_BLOCKS	4096U
+#endif
+#define NAND_BBT_SCAN_CHUNK	32U
+
+static uint8_t bbt_known[NAND_BBT_MAX_BLOCKS / 8U];
+static uint8_t bbt_bad[NAND_BBT_MAX_BLOCKS / 8U];
+
 static struct rawnand_device rawnand_dev;
 
 #pragma weak plat_get_raw_nand_data
@@ -368,7 +383,7 @@ static int detect_onfi(void)
 }
 #endif
 
-static int nand_mtd_block_is_bad(unsigned int block)
+static int nand_check_block_bad(unsigned int block)
 {
 	unsigned int nbpages_per_block = rawnand_dev.nand_dev->block_size /
 					 rawnand_dev.nand_dev->page_size;
@@ -395,6 +410,45 @@ static int nand_mtd_block_is_bad(unsigned int block)
 	return 0;
 }
 
+static int nand_mtd_block_is_bad(unsigned int block)
+{
+	unsigned int nblocks = rawnand_dev.nand_dev->size /
+			       rawnand_dev.nand_dev->block_size;
+	unsigned int last;
+	unsigned int i;
+	int ret;
+
+	if (block >= NAND_BBT_MAX_BLOCKS) {
+		return nand_check_block_bad(block);
+	}
+
+	if ((bbt_known[block / 8U] & BIT(block % 8U)) == 0U) {
+		/*
+		 * Probe the markers of a whole chunk of blocks in one
+		 * sequential burst before the data reads resume.
+		 */
+		last = MIN(block + NAND_BBT_SCAN_CHUNK,
+			   MIN(nblocks, NAND_BBT_MAX_BLOCKS));
+
+		for (i = block; i < last; i++) {
+			ret = nand_check_block_bad(i);
+			if (ret < 0) {
+				if (i == block) {
+					return ret;
+				}
+				break;
+			}
+
+			bbt_known[i / 8U] |= BIT(i % 8U);
+			if (ret == 1) {
+				bbt_bad[i / 8U] |= BIT(i % 8U);
+			}
+		}
+	}
+
+	return ((bbt_bad[block / 8U] & BIT(block % 8U)) != 0U) ? 1 : 0;
+}
+
 static int nand_mtd_read_page_raw(struct nand_device *nand, unsigned int page,
 				  uintptr_t buffer)
 {
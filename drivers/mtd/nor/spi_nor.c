@@ -25,7 +25,11 @@
 
 #define BANK_SIZE		0x1000000U
 
+#define NOR_DEFAULT_PAGE_SIZE	0x100U
+#define NOR_DEFAULT_ERASE_SIZE	0x10000U
+
 #define SPI_READY_TIMEOUT_US	40000U
+#define SPI_ERASE_TIMEOUT_US	2000000U
 
 static struct nor_device nor_dev;
 
@@ -51,24 +55,56 @@ static int spi_nor_reg(uint8_t reg, uint8_t *buf, size_t len,
 	return spi_mem_exec_op(&op);
 }
 
-static inline int spi_nor_read_id(uint8_t *id)
+/*
+ * In dual-flash mode the two devices answer register reads together, byte
+ * interleaved, so reading two bytes returns one register byte per flash.
+ * The register helpers below therefore always produce or consume a
+ * per-flash pair; in single-flash mode the lone byte is duplicated so
+ * call sites can combine the pair regardless of the topology. Combining
+ * is left to the call sites because it is semantic: a busy poll must wait
+ * for both flashes while a feature check must require the feature on both.
+ */
+static int spi_nor_read_reg_pair(uint8_t reg, uint8_t pair[2])
+{
+	int ret;
+
+	if ((nor_dev.flags & SPI_NOR_DUAL_FLASH) != 0U) {
+		return spi_nor_reg(reg, pair, 2U, SPI_MEM_DATA_IN);
+	}
+
+	ret = spi_nor_reg(reg, pair, 1U, SPI_MEM_DATA_IN);
+	pair[1] = pair[0];
+
+	return ret;
+}
+
+static int spi_nor_write_reg_pair(uint8_t reg, uint8_t pair[2])
+{
+	if ((nor_dev.flags & SPI_NOR_DUAL_FLASH) != 0U) {
+		return spi_nor_reg(reg, pair, 2U, SPI_MEM_DATA_OUT);
+	}
+
+	return spi_nor_reg(reg, pair, 1U, SPI_MEM_DATA_OUT);
+}
+
+static inline int spi_nor_read_id(uint8_t id[2])
 {
-	return spi_nor_reg(SPI_NOR_OP_READ_ID, id, 1U, SPI_MEM_DATA_IN);
+	return spi_nor_read_reg_pair(SPI_NOR_OP_READ_ID, id);
 }
 
-static inline int spi_nor_read_cr(uint8_t *cr)
+static inline int spi_nor_read_cr(uint8_t cr[2])
 {
-	return spi_nor_reg(SPI_NOR_OP_READ_CR, cr, 1U, SPI_MEM_DATA_IN);
+	return spi_nor_read_reg_pair(SPI_NOR_OP_READ_CR, cr);
 }
 
-static inline int spi_nor_read_sr(uint8_t *sr)
+static inline int spi_nor_read_sr(uint8_t sr[2])
 {
-	return spi_nor_reg(SPI_NOR_OP_READ_SR, sr, 1U, SPI_MEM_DATA_IN);
+	return spi_nor_read_reg_pair(SPI_NOR_OP_READ_SR, sr);
 }
 
-static inline int spi_nor_read_fsr(uint8_t *fsr)
+static inline int spi_nor_read_fsr(uint8_t fsr[2])
 {
-	return spi_nor_reg(SPI_NOR_OP_READ_FSR, fsr, 1U, SPI_MEM_DATA_IN);
+	return spi_nor_read_reg_pair(SPI_NOR_OP_READ_FSR, fsr);
 }
 
 static inline int spi_nor_write_en(void)
@@ -76,6 +112,20 @@ static inline int spi_nor_write_en(void)
 	return spi_nor_reg(SPI_NOR_OP_WREN, NULL, 0U, SPI_MEM_DATA_OUT);
 }
 
+/*
+ * Bank/extended address registers address the flash-local space: in
+ * dual-flash mode each flash holds every other byte, so one bank covers
+ * twice the combined address range.
+ */
+static uint32_t spi_nor_bank_size(void)
+{
+	if ((nor_dev.flags & SPI_NOR_DUAL_FLASH) != 0U) {
+		return 2U * BANK_SIZE;
+	}
+
+	return BANK_SIZE;
+}
+
 /*
  * Check if device is ready.
  *
@@ -83,33 +133,33 @@ static inline int spi_nor_write_en(void)
  */
 static int spi_nor_ready(void)
 {
-	uint8_t sr;
+	uint8_t sr[2];
 	int ret;
 
-	ret = spi_nor_read_sr(&sr);
+	ret = spi_nor_read_sr(sr);
 	if (ret != 0) {
 		return ret;
 	}
 
 	if ((nor_dev.flags & SPI_NOR_USE_FSR) != 0U) {
-		uint8_t fsr;
+		uint8_t fsr[2];
 
-		ret = spi_nor_read_fsr(&fsr);
+		ret = spi_nor_read_fsr(fsr);
 		if (ret != 0) {
 			return ret;
 		}
 
-		return (((fsr & FSR_READY) != 0U) && ((sr & SR_WIP) == 0U)) ?
-			0 : 1;
+		return ((((fsr[0] & fsr[1]) & FSR_READY) != 0U) &&
+			(((sr[0] | sr[1]) & SR_WIP) == 0U)) ? 0 : 1;
 	}
 
-	return (((sr & SR_WIP) != 0U) ? 1 : 0);
+	return ((((sr[0] | sr[1]) & SR_WIP) != 0U) ? 1 : 0);
 }
 
-static int spi_nor_wait_ready(void)
+static int spi_nor_wait_ready(unsigned int timeout_us)
 {
 	int ret;
-	uint64_t timeout = timeout_init_us(SPI_READY_TIMEOUT_US);
+	uint64_t timeout = timeout_init_us(timeout_us);
 
 	while (!timeout_elapsed(timeout)) {
 		ret = spi_nor_ready();
@@ -123,15 +173,15 @@ static int spi_nor_wait_ready(void)
 
 static int spi_nor_macronix_quad_enable(void)
 {
-	uint8_t sr;
+	uint8_t sr[2];
 	int ret;
 
-	ret = spi_nor_read_sr(&sr);
+	ret = spi_nor_read_sr(sr);
 	if (ret != 0) {
 		return ret;
 	}
 
-	if ((sr & SR_QUAD_EN_MX) != 0U) {
+	if (((sr[0] & sr[1]) & SR_QUAD_EN_MX) != 0U) {
 		return 0;
 	}
 
@@ -140,26 +190,27 @@ static int spi_nor_macronix_quad_enable(void)
 		return ret;
 	}
 
-	sr |= SR_QUAD_EN_MX;
-	ret = spi_nor_reg(SPI_NOR_OP_WRSR, &sr, 1, SPI_MEM_DATA_OUT);
+	sr[0] |= SR_QUAD_EN_MX;
+	sr[1] |= SR_QUAD_EN_MX;
+	ret = spi_nor_write_reg_pair(SPI_NOR_OP_WRSR, sr);
 	if (ret != 0) {
 		return ret;
 	}
 
-	ret = spi_nor_wait_ready();
+	ret = spi_nor_wait_ready(SPI_READY_TIMEOUT_US);
 	if (ret != 0) {
 		return ret;
 	}
 
-	ret = spi_nor_read_sr(&sr);
-	if ((ret != 0) || ((sr & SR_QUAD_EN_MX) == 0U)) {
+	ret = spi_nor_read_sr(sr);
+	if ((ret != 0) || (((sr[0] & sr[1]) & SR_QUAD_EN_MX) == 0U)) {
 		return -EINVAL;
 	}
 
 	return 0;
 }
 
-static int spi_nor_write_sr_cr(uint8_t *sr_cr)
+static int spi_nor_write_sr_cr(uint8_t *sr_cr, size_t len)
 {
 	int ret;
 
@@ -168,12 +219,12 @@ static int spi_nor_write_sr_cr(uint8_t *sr_cr)
 		return ret;
 	}
 
-	ret = spi_nor_reg(SPI_NOR_OP_WRSR, sr_cr, 2, SPI_MEM_DATA_OUT);
+	ret = spi_nor_reg(SPI_NOR_OP_WRSR, sr_cr, len, SPI_MEM_DATA_OUT);
 	if (ret != 0) {
 		return -EINVAL;
 	}
 
-	ret = spi_nor_wait_ready();
+	ret = spi_nor_wait_ready(SPI_READY_TIMEOUT_US);
 	if (ret != 0) {
 		return ret;
 	}
@@ -183,31 +234,51 @@ static int spi_nor_write_sr_cr(uint8_t *sr_cr)
 
 static int spi_nor_quad_enable(void)
 {
-	uint8_t sr_cr[2];
+	uint8_t sr[2];
+	uint8_t cr[2];
+	uint8_t sr_cr[4];
+	size_t len = 2U;
 	int ret;
 
-	ret = spi_nor_read_cr(&sr_cr[1]);
+	ret = spi_nor_read_cr(cr);
 	if (ret != 0) {
 		return ret;
 	}
 
-	if ((sr_cr[1] & CR_QUAD_EN_SPAN) != 0U) {
+	if (((cr[0] & cr[1]) & CR_QUAD_EN_SPAN) != 0U) {
 		return 0;
 	}
 
-	sr_cr[1] |= CR_QUAD_EN_SPAN;
-	ret = spi_nor_read_sr(&sr_cr[0]);
+	cr[0] |= CR_QUAD_EN_SPAN;
+	cr[1] |= CR_QUAD_EN_SPAN;
+	ret = spi_nor_read_sr(sr);
 	if (ret != 0) {
 		return ret;
 	}
 
-	ret = spi_nor_write_sr_cr(sr_cr);
+	/*
+	 * The WRSR payload is {SR, CR}; in dual-flash mode the data phase
+	 * interleaves one byte per flash, so the register pairs interleave
+	 * too.
+	 */
+	if ((nor_dev.flags & SPI_NOR_DUAL_FLASH) != 0U) {
+		sr_cr[0] = sr[0];
+		sr_cr[1] = sr[1];
+		sr_cr[2] = cr[0];
+		sr_cr[3] = cr[1];
+		len = 4U;
+	} else {
+		sr_cr[0] = sr[0];
+		sr_cr[1] = cr[0];
+	}
+
+	ret = spi_nor_write_sr_cr(sr_cr, len);
 	if (ret != 0) {
 		return ret;
 	}
 
-	ret = spi_nor_read_cr(&sr_cr[1]);
-	if ((ret != 0) || ((sr_cr[1] & CR_QUAD_EN_SPAN) == 0U)) {
+	ret = spi_nor_read_cr(cr);
+	if ((ret != 0) || (((cr[0] & cr[1]) & CR_QUAD_EN_SPAN) == 0U)) {
 		return -EINVAL;
 	}
 
@@ -216,6 +287,7 @@ static int spi_nor_quad_enable(void)
 
 static int spi_nor_clean_bar(void)
 {
+	uint8_t bank[2] = { 0U, 0U };
 	int ret;
 
 	if (nor_dev.selected_bank == 0U) {
@@ -229,13 +301,13 @@ static int spi_nor_clean_bar(void)
 		return ret;
 	}
 
-	return spi_nor_reg(nor_dev.bank_write_cmd, &nor_dev.selected_bank,
-			   1, SPI_MEM_DATA_OUT);
+	return spi_nor_write_reg_pair(nor_dev.bank_write_cmd, bank);
 }
 
 static int spi_nor_write_bar(uint32_t offset)
 {
-	uint8_t selected_bank = offset / BANK_SIZE;
+	uint8_t selected_bank = offset / spi_nor_bank_size();
+	uint8_t bank[2] = { selected_bank, selected_bank };
 	int ret;
 
 	if (selected_bank == nor_dev.selected_bank) {
@@ -247,8 +319,7 @@ static int spi_nor_write_bar(uint32_t offset)
 		return ret;
 	}
 
-	ret = spi_nor_reg(nor_dev.bank_write_cmd, &selected_bank,
-			  1, SPI_MEM_DATA_OUT);
+	ret = spi_nor_write_reg_pair(nor_dev.bank_write_cmd, bank);
 	if (ret != 0) {
 		return ret;
 	}
@@ -260,16 +331,22 @@ static int spi_nor_write_bar(uint32_t offset)
 
 static int spi_nor_read_bar(void)
 {
-	uint8_t selected_bank = 0;
+	uint8_t bank[2] = { 0U, 0U };
 	int ret;
 
-	ret = spi_nor_reg(nor_dev.bank_read_cmd, &selected_bank,
-			  1, SPI_MEM_DATA_IN);
+	ret = spi_nor_read_reg_pair(nor_dev.bank_read_cmd, bank);
 	if (ret != 0) {
 		return ret;
 	}
 
-	nor_dev.selected_bank = selected_bank;
+	/* The bank registers are always written together */
+	if (bank[0] != bank[1]) {
+		ERROR("Dual-flash bank registers differ: %u/%u\n",
+		      bank[0], bank[1]);
+		return -EIO;
+	}
+
+	nor_dev.selected_bank = bank[0];
 
 	return 0;
 }
@@ -293,7 +370,8 @@ int spi_nor_read(unsigned int offset, uintptr_t buffer, size_t length,
 				return ret;
 			}
 
-			remain_len = (BANK_SIZE * (nor_dev.selected_bank + 1)) -
+			remain_len = (spi_nor_bank_size() *
+				      (nor_dev.selected_bank + 1)) -
 				nor_dev.read_op.addr.val;
 			nor_dev.read_op.data.nbytes = MIN(length, remain_len);
 		} else {
@@ -322,10 +400,128 @@ int spi_nor_read(unsigned int offset, uintptr_t buffer, size_t length,
 	return 0;
 }
 
+int spi_nor_write(unsigned int offset, uintptr_t buffer, size_t length)
+{
+	struct spi_mem_op op;
+	size_t page_len;
+	int ret;
+
+	zeromem(&op, sizeof(struct spi_mem_op));
+	op.cmd.opcode = SPI_NOR_OP_PP;
+	op.cmd.buswidth = SPI_MEM_BUSWIDTH_1_LINE;
+	op.addr.nbytes = nor_dev.read_op.addr.nbytes;
+	op.addr.buswidth = SPI_MEM_BUSWIDTH_1_LINE;
+	op.data.buswidth = SPI_MEM_BUSWIDTH_1_LINE;
+	op.data.dir = SPI_MEM_DATA_OUT;
+
+	VERBOSE("%s offset %i length %zu\n", __func__, offset, length);
+
+	while (length != 0U) {
+		if ((nor_dev.flags & SPI_NOR_USE_BANK) != 0U) {
+			ret = spi_nor_write_bar(offset);
+			if (ret != 0) {
+				return ret;
+			}
+		}
+
+		/* A single program operation cannot cross a page boundary */
+		page_len = MIN(length, (size_t)(nor_dev.page_size -
+					(offset % nor_dev.page_size)));
+
+		ret = spi_nor_write_en();
+		if (ret != 0) {
+			spi_nor_clean_bar();
+			return ret;
+		}
+
+		op.addr.val = offset;
+		op.data.buf = (void *)buffer;
+		op.data.nbytes = page_len;
+
+		ret = spi_mem_exec_op(&op);
+		if (ret != 0) {
+			spi_nor_clean_bar();
+			return ret;
+		}
+
+		ret = spi_nor_wait_ready(SPI_READY_TIMEOUT_US);
+		if (ret != 0) {
+			spi_nor_clean_bar();
+			return ret;
+		}
+
+		offset += page_len;
+		buffer += page_len;
+		length -= page_len;
+	}
+
+	if ((nor_dev.flags & SPI_NOR_USE_BANK) != 0U) {
+		ret = spi_nor_clean_bar();
+		if (ret != 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+int spi_nor_erase(unsigned int offset)
+{
+	struct spi_mem_op op;
+	int ret;
+
+	VERBOSE("%s offset %i\n", __func__, offset);
+
+	if ((offset % nor_dev.erase_size) != 0U) {
+		return -EINVAL;
+	}
+
+	if ((nor_dev.flags & SPI_NOR_USE_BANK) != 0U) {
+		ret = spi_nor_write_bar(offset);
+		if (ret != 0) {
+			return ret;
+		}
+	}
+
+	ret = spi_nor_write_en();
+	if (ret != 0) {
+		spi_nor_clean_bar();
+		return ret;
+	}
+
+	zeromem(&op, sizeof(struct spi_mem_op));
+	op.cmd.opcode = SPI_NOR_OP_SE;
+	op.cmd.buswidth = SPI_MEM_BUSWIDTH_1_LINE;
+	op.addr.nbytes = nor_dev.read_op.addr.nbytes;
+	op.addr.buswidth = SPI_MEM_BUSWIDTH_1_LINE;
+	op.addr.val = offset;
+
+	ret = spi_mem_exec_op(&op);
+	if (ret != 0) {
+		spi_nor_clean_bar();
+		return ret;
+	}
+
+	ret = spi_nor_wait_ready(SPI_ERASE_TIMEOUT_US);
+	if (ret != 0) {
+		spi_nor_clean_bar();
+		return ret;
+	}
+
+	if ((nor_dev.flags & SPI_NOR_USE_BANK) != 0U) {
+		ret = spi_nor_clean_bar();
+		if (ret != 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
 int spi_nor_init(unsigned long long *size, unsigned int *erase_size)
 {
 	int ret = 0;
-	uint8_t id;
+	uint8_t id[2];
 
 	/* Default read command used */
 	nor_dev.read_op.cmd.opcode = SPI_NOR_OP_READ;
@@ -334,26 +530,48 @@ int spi_nor_init(unsigned long long *size, unsigned int *erase_size)
 	nor_dev.read_op.addr.buswidth = SPI_MEM_BUSWIDTH_1_LINE;
 	nor_dev.read_op.data.buswidth = SPI_MEM_BUSWIDTH_1_LINE;
 	nor_dev.read_op.data.dir = SPI_MEM_DATA_IN;
+	nor_dev.page_size = NOR_DEFAULT_PAGE_SIZE;
+	nor_dev.erase_size = NOR_DEFAULT_ERASE_SIZE;
 
 	if (plat_get_nor_data(&nor_dev) != 0) {
 		return -EINVAL;
 	}
 
 	assert(nor_dev.size != 0);
+	assert((nor_dev.page_size != 0U) && (nor_dev.erase_size != 0U));
+
+	if (spi_mem_dual_flash()) {
+		/*
+		 * The platform describes one device; with two flashes in
+		 * parallel the combined address space, page pair and sector
+		 * pair are twice as large.
+		 */
+		nor_dev.flags |= SPI_NOR_DUAL_FLASH;
+		nor_dev.size *= 2U;
+		nor_dev.page_size *= 2U;
+		nor_dev.erase_size *= 2U;
+	}
 
-	if (nor_dev.size > BANK_SIZE) {
+	if (nor_dev.size > spi_nor_bank_size()) {
 		nor_dev.flags |= SPI_NOR_USE_BANK;
 	}
 
 	*size = nor_dev.size;
+	*erase_size = nor_dev.erase_size;
 
-	ret = spi_nor_read_id(&id);
+	ret = spi_nor_read_id(id);
 	if (ret != 0) {
 		return ret;
 	}
 
+	if (((nor_dev.flags & SPI_NOR_DUAL_FLASH) != 0U) &&
+	    (id[0] != id[1])) {
+		ERROR("Dual-flash devices differ: 0x%x/0x%x\n", id[0], id[1]);
+		return -EINVAL;
+	}
+
 	if ((nor_dev.flags & SPI_NOR_USE_BANK) != 0U) {
-		switch (id) {
+		switch (id[0]) {
 		case SPANSION_ID:
 			nor_dev.bank_read_cmd = SPINOR_OP_BRRD;
 			nor_dev.bank_write_cmd = SPINOR_OP_BRWR;
@@ -366,7 +584,7 @@ int spi_nor_init(unsigned long long *size, unsigned int *erase_size)
 	}
 
 	if (nor_dev.read_op.data.buswidth == 4U) {
-		switch (id) {
+		switch (id[0]) {
 		case MACRONIX_ID:
 			INFO("Enable Macronix quad support\n");
 			ret = spi_nor_macronix_quad_enable();
@@ -173,6 +173,19 @@ int spi_mem_exec_op(const struct spi_mem_op *op)
 	return ret;
 }
 
+/*
+ * spi_mem_dual_flash() - Tell whether the bus drives two flashes in parallel.
+ *
+ * In dual-flash mode the controller interleaves the data phase over two
+ * identical devices (even bytes on the first flash, odd bytes on the second),
+ * so consumers see a single memory of twice the size and bandwidth but must
+ * handle the interleave in their register accesses.
+ */
+bool spi_mem_dual_flash(void)
+{
+	return (spi_slave.mode & SPI_DUAL_FLASH) != 0U;
+}
+
 /*
  * spi_mem_init_slave() - SPI slave device initialization.
  * @fdt: Pointer to the device tree blob.
@@ -197,6 +210,15 @@ int spi_mem_init_slave(void *fdt, int bus_node, const struct spi_bus_ops *ops)
 		return ret;
 	}
 
+	/*
+	 * Dual-flash is a property of the bus wiring: two identical devices
+	 * share the command lines and interleave the data phase. The single
+	 * subnode then describes the pair.
+	 */
+	if (fdt_getprop(fdt, bus_node, "st,dual-flash", NULL) != NULL) {
+		mode |= SPI_DUAL_FLASH;
+	}
+
 	fdt_for_each_subnode(bus_subnode, fdt, bus_node) {
 		nchips++;
 	}
@@ -5,6 +5,7 @@
  */
 
 #include <assert.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -18,6 +19,27 @@
 static uint8_t mbr_sector[PLAT_PARTITION_BLOCK_SIZE];
 static partition_entry_list_t list;
 
+/*
+ * The parsed table is kept across partition_init() calls so repeated
+ * initialization within a boot stage does not re-read the GPT from
+ * storage. A per-entry name hash spares the strcmp() on lookup misses.
+ */
+static bool table_loaded;
+static unsigned int table_image_id;
+static uint8_t name_hashes[PLAT_PARTITION_MAX_ENTRIES];
+
+static uint8_t partition_name_hash(const char *name)
+{
+	uint8_t hash = 0U;
+
+	while (*name != '\0') {
+		hash = (uint8_t)((hash * 31U) + (uint8_t)*name);
+		name++;
+	}
+
+	return hash;
+}
+
 #if LOG_LEVEL >= LOG_LEVEL_VERBOSE
 static void dump_entries(int num)
 {
@@ -151,6 +173,7 @@ static int load_mbr_entries(uintptr_t image_handle)
 		list.list[i].start = mbr_entry.first_lba * 512;
 		list.list[i].length = mbr_entry.sector_nums * 512;
 		list.list[i].name[0] = mbr_entry.type;
+		name_hashes[i] = partition_name_hash(list.list[i].name);
 	}
 
 	return 0;
@@ -181,6 +204,7 @@ static int verify_partition_gpt(uintptr_t image_handle)
 		if (result != 0) {
 			break;
 		}
+		name_hashes[i] = partition_name_hash(list.list[i].name);
 	}
 	if (i == 0) {
 		return -EINVAL;
@@ -201,6 +225,8 @@ int load_partition_table(unsigned int image_id)
 	mbr_entry_t mbr_entry;
 	int result;
 
+	table_loaded = false;
+
 	result = plat_get_image_source(image_id, &dev_handle, &image_spec);
 	if (result != 0) {
 		WARN("Failed to obtain reference to image id=%u (%i)\n",
@@ -235,10 +261,12 @@ int load_partition_table(unsigned int image_id)
 
 const partition_entry_t *get_partition_entry(const char *name)
 {
+	uint8_t hash = partition_name_hash(name);
 	int i;
 
 	for (i = 0; i < list.entry_count; i++) {
-		if (strcmp(name, list.list[i].name) == 0) {
+		if ((name_hashes[i] == hash) &&
+		    (strcmp(name, list.list[i].name) == 0)) {
 			return &list.list[i];
 		}
 	}
@@ -252,5 +280,13 @@ const partition_entry_list_t *get_partition_entry_list(void)
 
 void partition_init(unsigned int image_id)
 {
-	load_partition_table(image_id);
+	if (table_loaded && (table_image_id == image_id)) {
+		VERBOSE("Partition table already parsed, skipping re-read\n");
+		return;
+	}
+
+	if (load_partition_table(image_id) == 0) {
+		table_loaded = true;
+		table_image_id = image_id;
+	}
 }
@@ -25,6 +25,16 @@
 
 static uint32_t otp_nsec_access[OTP_ACCESS_SIZE] __unused;
 
+/*
+ * Cache of OTP words already loaded from SAFMEM, so that repeated queries of
+ * the same word (board ID, RPN, closed-device bits...) are a load from SRAM
+ * instead of a power/read cycle of the OTP controller. An entry is filled by
+ * bsec_shadow_read_otp() and invalidated when the word is written, programmed
+ * or explicitly dropped with bsec_shadow_cache_invalidate().
+ */
+static uint32_t otp_cache[OTP_MAX_SIZE];
+static uint32_t otp_cache_valid[OTP_ACCESS_SIZE];
+
 static uint32_t bsec_power_safmem(bool power);
 
 /* BSEC access protection */
@@ -468,6 +478,8 @@ uint32_t bsec_write_otp(uint32_t val, uint32_t otp)
 
 	bsec_unlock();
 
+	bsec_shadow_cache_invalidate(otp);
+
 	return result;
 }
 
@@ -540,6 +552,9 @@ uint32_t bsec_program_otp(uint32_t val, uint32_t otp)
 		}
 	}
 
+	/* The word now differs from its shadow until the next refresh */
+	bsec_shadow_cache_invalidate(otp);
+
 	return result;
 }
 
@@ -913,6 +928,16 @@ uint32_t bsec_shadow_read_otp(uint32_t *otp_value, uint32_t word)
 {
 	uint32_t result;
 
+	if (word > STM32MP1_OTP_MAX_ID) {
+		return BSEC_INVALID_PARAM;
+	}
+
+	if ((otp_cache_valid[word / __WORD_BIT] &
+	     BIT(word % __WORD_BIT)) != 0U) {
+		*otp_value = otp_cache[word];
+		return BSEC_OK;
+	}
+
 	result = bsec_shadow_register(word);
 	if (result != BSEC_OK) {
 		ERROR("BSEC: %u Shadowing Error %i\n", word, result);
@@ -922,11 +947,37 @@ uint32_t bsec_shadow_read_otp(uint32_t *otp_value, uint32_t word)
 	result = bsec_read_otp(otp_value, word);
 	if (result != BSEC_OK) {
 		ERROR("BSEC: %u Read Error %i\n", word, result);
+		return result;
 	}
 
+	bsec_lock();
+
+	otp_cache[word] = *otp_value;
+	otp_cache_valid[word / __WORD_BIT] |= BIT(word % __WORD_BIT);
+
+	bsec_unlock();
+
 	return result;
 }
 
+/*
+ * bsec_shadow_cache_invalidate: drop the cached value of an OTP word.
+ *	The next bsec_shadow_read_otp() will reload it from SAFMEM.
+ * otp: OTP number.
+ */
+void bsec_shadow_cache_invalidate(uint32_t otp)
+{
+	if (otp > STM32MP1_OTP_MAX_ID) {
+		return;
+	}
+
+	bsec_lock();
+
+	otp_cache_valid[otp / __WORD_BIT] &= ~BIT(otp % __WORD_BIT);
+
+	bsec_unlock();
+}
+
 /*
  * bsec_check_nsec_access_rights: check non-secure access rights to target OTP.
  * otp: OTP number.
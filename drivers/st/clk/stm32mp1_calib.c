@@ -23,6 +23,7 @@
 #include <drivers/st/stm32mp_clkfunc.h>
 #include <lib/mmio.h>
 #include <lib/spinlock.h>
+#include <lib/timer_mux.h>
 #include <lib/utils_def.h>
 #include <plat/common/platform.h>
 
@@ -390,6 +391,27 @@ void stm32mp1_calib_set_wakeup(bool state)
 	rcc_wakeup = state;
 }
 
+static void stm32mp1_calib_run(void)
+{
+	if (stm32mp1_clk_cal_hsi.ref_freq != 0U) {
+		rcc_calibration(&stm32mp1_clk_cal_hsi);
+	}
+
+	if (stm32mp1_clk_cal_csi.ref_freq != 0U) {
+		rcc_calibration(&stm32mp1_clk_cal_csi);
+	}
+}
+
+/* Periodic expiry from the secure timer multiplexer */
+static void stm32mp1_calib_expiry(struct timer_mux_event *ev)
+{
+	stm32mp1_calib_run();
+}
+
+static struct timer_mux_event calib_event = {
+	.handler = stm32mp1_calib_expiry,
+};
+
 void stm32mp1_calib_it_handler(uint32_t id)
 {
 	uintptr_t rcc_base = stm32mp_rcc_base();
@@ -417,22 +439,11 @@ void stm32mp1_calib_it_handler(uint32_t id)
 
 		break;
 
-	case ARM_IRQ_SEC_PHY_TIMER:
 	default:
 		break;
 	}
 
-	if (stm32mp1_clk_cal_hsi.ref_freq != 0U) {
-		rcc_calibration(&stm32mp1_clk_cal_hsi);
-	}
-
-	if (stm32mp1_clk_cal_csi.ref_freq != 0U) {
-		rcc_calibration(&stm32mp1_clk_cal_csi);
-	}
-
-	if (timer_val != 0U) {
-		write_cntp_tval(timer_val);
-	}
+	stm32mp1_calib_run();
 }
 
 int stm32mp1_calib_start_hsi_cal(void)
@@ -522,11 +533,13 @@ void stm32mp1_calib_init(void)
 	}
 
 	if (timer_val != 0U) {
-		/* Load & enable timer */
+		/* Queue the periodic calibration on the timer multiplexer */
 		INFO("Set calibration timer to %u sec\n",
 		     timer_val / plat_get_syscnt_freq2());
-		write_cntp_tval(timer_val);
-		write_cntp_ctl(BIT(0));
+		calib_event.period = timer_val;
+		if (timer_mux_start(&calib_event, timer_val) != 0) {
+			WARN("No timer slot for the periodic calibration\n");
+		}
 	};
 
 	if (fdt_rcc_enable_it("mcu_sev") < 0) {
@@ -23,8 +23,12 @@
 #include <drivers/st/stm32mp1_clk.h>
 #include <drivers/st/stm32mp1_rcc.h>
 #include <dt-bindings/clock/stm32mp1-clksrc.h>
+#include <lib/cassert.h>
 #include <lib/mmio.h>
 #include <lib/spinlock.h>
+#if STM32MP_CLK_LAZY_GATE && defined(IMAGE_BL32)
+#include <lib/timer_mux.h>
+#endif
 #include <lib/utils_def.h>
 #include <plat/common/platform.h>
 
@@ -162,10 +166,32 @@ static const uint8_t parent_id_clock_id[_PARENT_NB] = {
 	[_CK_MCU] = CK_MCU,
 };
 
+/*
+ * Constant-time lookup tables resolving a clock ID to its slot in
+ * stm32mp1_clk_gate[] and parent_id_clock_id[]. The clock IDs of the DT
+ * binding are dense and bounded by STM32MP1_LAST_CLK, so one byte per ID
+ * replaces the linear scans on the SMC service path. The tables are built
+ * once at probe time; earlier lookups fall back to scanning.
+ */
+#define CLK_ID_INDEX_NONE	0xFFU
+
+static uint8_t gate_id_index[STM32MP1_LAST_CLK];
+static uint8_t parent_id_index[STM32MP1_LAST_CLK];
+static bool clk_id_index_ready;
+
 static unsigned int clock_id2parent_id(unsigned long id)
 {
 	unsigned int n = 0;
 
+	if (clk_id_index_ready) {
+		if ((id >= STM32MP1_LAST_CLK) ||
+		    (parent_id_index[id] == CLK_ID_INDEX_NONE)) {
+			return _UNKNOWN_ID;
+		}
+
+		return parent_id_index[id];
+	}
+
 	for (n = 0; n < ARRAY_SIZE(parent_id_clock_id); n++) {
 		if (parent_id_clock_id[n] == id) {
 			return n;
@@ -692,8 +718,19 @@ const stm32mp1_clk_parent_sel_name[_PARENT_SEL_NB] __unused = {
 /* RCC clock device driver private */
 static unsigned long stm32mp1_osc[NB_OSC];
 static struct spinlock reg_lock;
+/*
+ * Refcounts are protected with one lock per gate so that concurrent SCMI
+ * requests on unrelated clocks do not serialize on a driver-wide lock.
+ */
 static unsigned int gate_refcounts[NB_GATES];
-static struct spinlock refcount_lock;
+static struct spinlock refcount_locks[NB_GATES];
+/*
+ * Gates pinned at init hold a base refcount and stay enabled for the whole
+ * runtime phase: enable/disable requests on them return without taking the
+ * refcount lock. Only the refcounted paths honor the pinned state, the
+ * force and low power sequences still act on the gate.
+ */
+static bool gate_pinned[NB_GATES];
 static struct stm32mp1_pll_settings pll1_settings;
 static uint32_t current_opp_khz;
 static uint32_t pll3cr;
@@ -721,6 +758,43 @@ static const struct stm32mp1_clk_pll *pll_ref(unsigned int idx)
 	return &stm32mp1_clk_pll[idx];
 }
 
+CASSERT(ARRAY_SIZE(stm32mp1_clk_gate) < CLK_ID_INDEX_NONE,
+	assert_too_many_gates_for_id_index);
+
+static void stm32mp1_clk_build_id_index(void)
+{
+	unsigned int i;
+
+	for (i = 0U; i < STM32MP1_LAST_CLK; i++) {
+		gate_id_index[i] = CLK_ID_INDEX_NONE;
+		parent_id_index[i] = CLK_ID_INDEX_NONE;
+	}
+
+	/*
+	 * Several slots may share a clock ID (e.g. CK_AXI backs all APB
+	 * parents): keep the first match, as the scans did.
+	 */
+	for (i = 0U; i < NB_GATES; i++) {
+		unsigned int id = gate_ref(i)->index;
+
+		if ((id < STM32MP1_LAST_CLK) &&
+		    (gate_id_index[id] == CLK_ID_INDEX_NONE)) {
+			gate_id_index[id] = (uint8_t)i;
+		}
+	}
+
+	for (i = 0U; i < ARRAY_SIZE(parent_id_clock_id); i++) {
+		unsigned int id = parent_id_clock_id[i];
+
+		if ((id != _UNKNOWN_ID) && (id < STM32MP1_LAST_CLK) &&
+		    (parent_id_index[id] == CLK_ID_INDEX_NONE)) {
+			parent_id_index[id] = (uint8_t)i;
+		}
+	}
+
+	clk_id_index_ready = true;
+}
+
 static void stm32mp1_clk_lock(struct spinlock *lock)
 {
 	if (stm32mp_lock_available()) {
@@ -736,6 +810,41 @@ static void stm32mp1_clk_unlock(struct spinlock *lock)
 	}
 }
 
+/*
+ * Mirror of the derived parent clock rates, indexed by parent clock ID.
+ * Computing a rate walks several RCC mux and divider registers, and the
+ * SCMI clock get_rate/describe_rates queries from the non-secure world hit
+ * that path continuously. The mirror turns those queries into two loads
+ * and a sequence check. Readers never take a lock: the sequence count is
+ * odd while an update is in flight and readers fall back to the hardware
+ * registers in that window. Writers - the lazy fills below and the
+ * invalidation run by every clock tree mutator - serialize on
+ * rate_mirror_lock.
+ */
+static unsigned long rate_mirror[_PARENT_NB];
+static bool rate_mirror_valid[_PARENT_NB];
+static unsigned int rate_mirror_seq;
+static struct spinlock rate_mirror_lock;
+
+static void stm32mp1_clk_rate_mirror_invalidate(void)
+{
+	unsigned int i;
+
+	stm32mp1_clk_lock(&rate_mirror_lock);
+
+	rate_mirror_seq++;
+	dmbish();
+
+	for (i = 0U; i < (unsigned int)_PARENT_NB; i++) {
+		rate_mirror_valid[i] = false;
+	}
+
+	dmbish();
+	rate_mirror_seq++;
+
+	stm32mp1_clk_unlock(&rate_mirror_lock);
+}
+
 bool stm32mp1_rcc_is_secure(void)
 {
 	uintptr_t rcc_base = stm32mp_rcc_base();
@@ -797,6 +906,17 @@ static int stm32mp1_clk_get_gated_id(unsigned long id)
 {
 	unsigned int i;
 
+	if (clk_id_index_ready) {
+		if ((id < STM32MP1_LAST_CLK) &&
+		    (gate_id_index[id] != CLK_ID_INDEX_NONE)) {
+			return gate_id_index[id];
+		}
+
+		ERROR("%s: clk id %d not found\n", __func__, (uint32_t)id);
+
+		return -EINVAL;
+	}
+
 	for (i = 0U; i < NB_GATES; i++) {
 		if (gate_ref(i)->index == id) {
 			return i;
@@ -935,7 +1055,7 @@ static unsigned long stm32mp1_read_pll_freq(enum stm32mp1_pll_id pll_id,
 	return dfout;
 }
 
-static unsigned long get_clock_rate(int p)
+static unsigned long get_clock_rate_from_hw(int p)
 {
 	uint32_t reg, clkdiv;
 	unsigned long clock = 0;
@@ -1170,6 +1290,112 @@ static bool __clk_is_enabled(struct stm32mp1_clk_gate const *gate)
 	return mmio_read_32(rcc_base + gate->offset) & BIT(gate->bit);
 }
 
+#if STM32MP_CLK_LAZY_GATE && defined(IMAGE_BL32)
+/*
+ * Lazy gate disable with hysteresis. The normal world gates clocks
+ * aggressively, so the same gate sees rapid disable-then-enable
+ * sequences over SCMI (SDMMC between I/O bursts, UART between prints)
+ * and every committed-then-reverted toggle costs two RCC writes. A
+ * disable request dropping the last reference only marks the gate
+ * pending-off; a deferred sweep, one timer mux event shared by all
+ * gates, commits the disable STM32MP_CLK_LAZY_GATE_TICKS later unless a
+ * re-enable claimed the gate back first, in which case both RCC writes
+ * are saved. The pending flags are protected by the per-gate refcount
+ * locks; the lazy lock only covers the sweep arming flag and is never
+ * held while taking another lock.
+ */
+static bool gate_pending_off[NB_GATES];
+static bool lazy_sweep_queued;
+static struct spinlock lazy_lock;
+static struct timer_mux_event lazy_sweep_event;
+
+/* Commit the pending disables that were not claimed back, unlocked */
+static void stm32mp1_clk_lazy_sweep(struct timer_mux_event *ev __unused)
+{
+	unsigned int i;
+
+	stm32mp1_clk_lock(&lazy_lock);
+	lazy_sweep_queued = false;
+	stm32mp1_clk_unlock(&lazy_lock);
+
+	for (i = 0U; i < NB_GATES; i++) {
+		if (!gate_pending_off[i]) {
+			continue;
+		}
+
+		stm32mp1_clk_lock(&refcount_locks[i]);
+
+		if (gate_pending_off[i] && (gate_refcounts[i] == 0U)) {
+			__clk_disable(gate_ref(i));
+		}
+		gate_pending_off[i] = false;
+
+		stm32mp1_clk_unlock(&refcount_locks[i]);
+	}
+}
+
+/* Called with the gate's refcount lock held when its last user left */
+static bool stm32mp1_clk_lazy_defer(unsigned int i)
+{
+	bool arm = false;
+
+	gate_pending_off[i] = true;
+
+	stm32mp1_clk_lock(&lazy_lock);
+	if (!lazy_sweep_queued) {
+		lazy_sweep_queued = true;
+		arm = true;
+	}
+	stm32mp1_clk_unlock(&lazy_lock);
+
+	if (arm) {
+		lazy_sweep_event.handler = stm32mp1_clk_lazy_sweep;
+		lazy_sweep_event.period = 0U;
+
+		if (timer_mux_start(&lazy_sweep_event,
+				    STM32MP_CLK_LAZY_GATE_TICKS) != 0) {
+			/* No free timer slot: disable immediately */
+			stm32mp1_clk_lock(&lazy_lock);
+			lazy_sweep_queued = false;
+			stm32mp1_clk_unlock(&lazy_lock);
+			gate_pending_off[i] = false;
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/* Called with the gate's refcount lock held on a 0 -> 1 transition */
+static bool stm32mp1_clk_lazy_cancel(unsigned int i)
+{
+	if (!gate_pending_off[i]) {
+		return false;
+	}
+
+	/* The gate is still physically enabled: both RCC writes saved */
+	gate_pending_off[i] = false;
+
+	return true;
+}
+
+void stm32mp1_clk_lazy_flush(void)
+{
+	timer_mux_cancel(&lazy_sweep_event);
+	stm32mp1_clk_lazy_sweep(NULL);
+}
+#else
+static bool stm32mp1_clk_lazy_defer(unsigned int i __unused)
+{
+	return false;
+}
+
+static bool stm32mp1_clk_lazy_cancel(unsigned int i __unused)
+{
+	return false;
+}
+#endif /* STM32MP_CLK_LAZY_GATE && defined(IMAGE_BL32) */
+
 /* Oscillators and PLLs are not gated at runtime */
 static bool clock_is_always_on(unsigned long id)
 {
@@ -1233,9 +1459,13 @@ static void __stm32mp1_clk_enable(unsigned long id, bool with_refcnt)
 	}
 #endif
 
-	stm32mp1_clk_lock(&refcount_lock);
+	if (gate_pinned[i]) {
+		return;
+	}
 
-	if (gate_refcounts[i] == 0) {
+	stm32mp1_clk_lock(&refcount_locks[i]);
+
+	if ((gate_refcounts[i] == 0) && !stm32mp1_clk_lazy_cancel(i)) {
 		__clk_enable(gate);
 	}
 
@@ -1244,7 +1474,7 @@ static void __stm32mp1_clk_enable(unsigned long id, bool with_refcnt)
 		panic();
 	}
 
-	stm32mp1_clk_unlock(&refcount_lock);
+	stm32mp1_clk_unlock(&refcount_locks[i]);
 }
 
 static void __stm32mp1_clk_disable(unsigned long id, bool with_refcnt)
@@ -1276,18 +1506,22 @@ static void __stm32mp1_clk_disable(unsigned long id, bool with_refcnt)
 	}
 #endif
 
-	stm32mp1_clk_lock(&refcount_lock);
+	if (gate_pinned[i]) {
+		return;
+	}
+
+	stm32mp1_clk_lock(&refcount_locks[i]);
 
 	if (gate_refcounts[i] == 0) {
 		panic();
 	}
 	gate_refcounts[i]--;
 
-	if (gate_refcounts[i] == 0) {
+	if ((gate_refcounts[i] == 0) && !stm32mp1_clk_lazy_defer(i)) {
 		__clk_disable(gate);
 	}
 
-	stm32mp1_clk_unlock(&refcount_lock);
+	stm32mp1_clk_unlock(&refcount_locks[i]);
 }
 
 void stm32mp_clk_enable(unsigned long id)
@@ -1300,6 +1534,43 @@ void stm32mp_clk_disable(unsigned long id)
 	__stm32mp1_clk_disable(id, true);
 }
 
+void stm32mp1_clk_pin(unsigned long id)
+{
+	int i;
+
+	if (clock_is_always_on(id)) {
+		return;
+	}
+
+	i = stm32mp1_clk_get_gated_id(id);
+	if (i < 0) {
+		ERROR("Clock %d can't be pinned\n", (uint32_t)id);
+		panic();
+	}
+
+	if (gate_pinned[i]) {
+		return;
+	}
+
+	/* Take the base refcount that keeps the gate enabled */
+	__stm32mp1_clk_enable(id, true);
+
+	gate_pinned[i] = true;
+}
+
+bool stm32mp1_clk_is_pinned(unsigned long id)
+{
+	int i;
+
+	if (clock_is_always_on(id)) {
+		return true;
+	}
+
+	i = stm32mp1_clk_get_gated_id(id);
+
+	return (i >= 0) && gate_pinned[i];
+}
+
 void stm32mp1_clk_force_enable(unsigned long id)
 {
 	__stm32mp1_clk_enable(id, false);
@@ -1326,6 +1597,49 @@ bool stm32mp_clk_is_enabled(unsigned long id)
 	return __clk_is_enabled(gate_ref(i));
 }
 
+static unsigned long get_clock_rate(int p)
+{
+	unsigned long rate;
+	unsigned int seq;
+
+	if ((p < 0) || (p >= (int)_PARENT_NB)) {
+		return 0;
+	}
+
+	seq = rate_mirror_seq;
+	dmbish();
+
+	if (((seq & 1U) == 0U) && rate_mirror_valid[p]) {
+		rate = rate_mirror[p];
+		dmbish();
+		if (seq == rate_mirror_seq) {
+			return rate;
+		}
+	}
+
+	rate = get_clock_rate_from_hw(p);
+
+	/*
+	 * Lazily fill the mirror for the next query. Skip the fill if a
+	 * mutator ran while the rate was being computed: the value read
+	 * from the hardware may predate the change.
+	 */
+	stm32mp1_clk_lock(&rate_mirror_lock);
+
+	if (seq == rate_mirror_seq) {
+		rate_mirror_seq++;
+		dmbish();
+		rate_mirror[p] = rate;
+		rate_mirror_valid[p] = true;
+		dmbish();
+		rate_mirror_seq++;
+	}
+
+	stm32mp1_clk_unlock(&rate_mirror_lock);
+
+	return rate;
+}
+
 unsigned long stm32mp_clk_get_rate(unsigned long id)
 {
 	int p = stm32mp1_clk_get_parent(id);
@@ -1495,6 +1809,8 @@ static int stm32mp1_set_hsidiv(uint8_t hsidiv)
 		}
 	}
 
+	stm32mp1_clk_rate_mirror_invalidate();
+
 	return 0;
 }
 
@@ -1625,6 +1941,8 @@ static int stm32mp1_pll_output(enum stm32mp1_pll_id pll_id, uint32_t output)
 	/* Start the requested output */
 	mmio_setbits_32(pllxcr, output << RCC_PLLNCR_DIVEN_SHIFT);
 
+	stm32mp1_clk_rate_mirror_invalidate();
+
 	return 0;
 }
 
@@ -1651,6 +1969,8 @@ static int stm32mp1_pll_stop(enum stm32mp1_pll_id pll_id)
 		}
 	}
 
+	stm32mp1_clk_rate_mirror_invalidate();
+
 	return 0;
 }
 
@@ -1740,6 +2060,8 @@ static int stm32mp1_pll_config(enum stm32mp1_pll_id pll_id,
 
 	stm32mp1_pll_config_output(pll_id, pllcfg);
 
+	stm32mp1_clk_rate_mirror_invalidate();
+
 	return 0;
 }
 
@@ -1780,6 +2102,8 @@ static int stm32mp1_set_clksrc(unsigned int clksrc)
 		}
 	}
 
+	stm32mp1_clk_rate_mirror_invalidate();
+
 	return 0;
 }
 
@@ -1799,6 +2123,8 @@ static int stm32mp1_set_clkdiv(unsigned int clkdiv, uintptr_t address)
 		}
 	}
 
+	stm32mp1_clk_rate_mirror_invalidate();
+
 	return 0;
 }
 
@@ -2148,6 +2474,35 @@ int stm32mp1_set_opp_khz(uint32_t freq_khz)
 	return 0;
 }
 
+/*
+ * Expose an entry of the PLL1 operating point table: CPU frequency and
+ * the voltage the operating point was computed for.
+ * Return 0 on success, a negative value if the index targets no valid
+ * operating point.
+ */
+int stm32mp1_clk_get_opp(unsigned int index, uint32_t *freq_khz,
+			 uint32_t *voltage_mv)
+{
+	assert(freq_khz != NULL);
+	assert(voltage_mv != NULL);
+
+	if (!clk_pll1_settings_are_valid() || (index >= PLAT_MAX_OPP_NB) ||
+	    (pll1_settings.freq[index] == 0U) ||
+	    (pll1_settings.volt[index] == 0U)) {
+		return -1;
+	}
+
+	*freq_khz = pll1_settings.freq[index];
+	*voltage_mv = pll1_settings.volt[index];
+
+	return 0;
+}
+
+uint32_t stm32mp1_clk_get_current_opp_khz(void)
+{
+	return current_opp_khz;
+}
+
 static int clk_get_pll_settings_from_dt(int plloff, unsigned int *pllcfg,
 					uint32_t *fracv, uint32_t *csg,
 					bool *csg_set)
@@ -3428,30 +3783,31 @@ static void sync_earlyboot_clocks_state(void)
 	}
 
 	/*
-	 * Register secure clock parents and init a refcount for
-	 * secure only resources that are not registered from a driver probe.
+	 * Register secure clock parents and pin secure only resources that
+	 * are not registered from a driver probe and stay enabled for the
+	 * whole runtime phase.
 	 * - DDR controller and phy clocks.
 	 * - TZC400, ETZPC and STGEN clocks.
 	 * - RTCAPB clocks on multi-core
 	 */
-	stm32mp_clk_enable(AXIDCG);
+	stm32mp1_clk_pin(AXIDCG);
 
-	stm32mp_clk_enable(DDRC1);
-	stm32mp_clk_enable(DDRC1LP);
-	stm32mp_clk_enable(DDRC2);
-	stm32mp_clk_enable(DDRC2LP);
-	stm32mp_clk_enable(DDRCAPB);
-	stm32mp_clk_enable(DDRPHYC);
-	stm32mp_clk_enable(DDRPHYCLP);
-	stm32mp_clk_enable(DDRPHYCAPB);
-	stm32mp_clk_enable(DDRPHYCAPBLP);
+	stm32mp1_clk_pin(DDRC1);
+	stm32mp1_clk_pin(DDRC1LP);
+	stm32mp1_clk_pin(DDRC2);
+	stm32mp1_clk_pin(DDRC2LP);
+	stm32mp1_clk_pin(DDRCAPB);
+	stm32mp1_clk_pin(DDRPHYC);
+	stm32mp1_clk_pin(DDRPHYCLP);
+	stm32mp1_clk_pin(DDRPHYCAPB);
+	stm32mp1_clk_pin(DDRPHYCAPBLP);
 
-	stm32mp_clk_enable(TZPC);
-	stm32mp_clk_enable(TZC1);
-	stm32mp_clk_enable(TZC2);
-	stm32mp_clk_enable(STGEN_K);
+	stm32mp1_clk_pin(TZPC);
+	stm32mp1_clk_pin(TZC1);
+	stm32mp1_clk_pin(TZC2);
+	stm32mp1_clk_pin(STGEN_K);
 
-	stm32mp_clk_enable(RTCAPB);
+	stm32mp1_clk_pin(RTCAPB);
 }
 
 int stm32mp1_clk_probe(void)
@@ -3460,6 +3816,8 @@ int stm32mp1_clk_probe(void)
 
 	assert(PLLCFG_NB == PLAT_MAX_PLLCFG_NB);
 
+	stm32mp1_clk_build_id_index();
+
 	stm32mp1_osc_init();
 
 	sync_earlyboot_clocks_state();
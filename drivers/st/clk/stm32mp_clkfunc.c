@@ -394,12 +394,15 @@ bool fdt_is_pll1_predefined(void)
 
 /*******************************************************************************
  * This function configures and restores the STGEN counter depending on the
- * connected clock.
+ * connected clock. The counter is stopped for the rescale, which stalls the
+ * generic timers of both worlds, so everything expensive is precomputed
+ * while the counter still runs and the stopped window is reduced to plain
+ * register writes plus one multiply-and-shift correction.
  ******************************************************************************/
 void stm32mp_stgen_config(unsigned long rate)
 {
-	uint32_t cntfid0;
-	unsigned long long counter;
+	unsigned long long counter, target, ratio_q32;
+	uint32_t cntfid0, cntcr, upper, delta;
 
 	cntfid0 = mmio_read_32(STGEN_BASE + CNTFID_OFF);
 
@@ -407,13 +410,33 @@ void stm32mp_stgen_config(unsigned long rate)
 		return;
 	}
 
-	mmio_clrbits_32(STGEN_BASE + CNTCR_OFF, CNTCR_EN);
-	counter = stm32mp_stgen_get_counter() * rate / cntfid0;
-
-	mmio_write_32(STGEN_BASE + CNTCVL_OFF, (uint32_t)counter);
-	mmio_write_32(STGEN_BASE + CNTCVU_OFF, (uint32_t)(counter >> 32));
+	/* Coherent counter snapshot while it is still running */
+	do {
+		upper = mmio_read_32(STGEN_BASE + CNTCVU_OFF);
+		counter = mmio_read_32(STGEN_BASE + CNTCVL_OFF);
+	} while (upper != mmio_read_32(STGEN_BASE + CNTCVU_OFF));
+	counter |= (unsigned long long)upper << 32;
+
+	/*
+	 * The division runs ahead of the halt: the snapshot is scaled to
+	 * the new rate now, and the ticks elapsed between the snapshot
+	 * and the halt are converted in the stopped window with the
+	 * precomputed Q32 ratio, avoiding a second division there.
+	 */
+	target = counter * rate / cntfid0;
+	ratio_q32 = ((unsigned long long)rate << 32) / cntfid0;
+	cntcr = mmio_read_32(STGEN_BASE + CNTCR_OFF);
+
+	mmio_write_32(STGEN_BASE + CNTCR_OFF, cntcr & ~CNTCR_EN);
+
+	/* Halted now: the low word alone covers the elapsed ticks */
+	delta = mmio_read_32(STGEN_BASE + CNTCVL_OFF) - (uint32_t)counter;
+	target += (delta * ratio_q32) >> 32;
+
+	mmio_write_32(STGEN_BASE + CNTCVL_OFF, (uint32_t)target);
+	mmio_write_32(STGEN_BASE + CNTCVU_OFF, (uint32_t)(target >> 32));
 	mmio_write_32(STGEN_BASE + CNTFID_OFF, rate);
-	mmio_setbits_32(STGEN_BASE + CNTCR_OFF, CNTCR_EN);
+	mmio_write_32(STGEN_BASE + CNTCR_OFF, cntcr | CNTCR_EN);
 
 	write_cntfrq_el0((u_register_t)rate);
 
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2026, STMicroelectronics - All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <assert.h>
+#include <stdbool.h>
+
+#include <common/debug.h>
+#include <drivers/st/stm32mp_wait_calib.h>
+#include <lib/utils_def.h>
+
+#include <stm32mp_common.h>
+
+struct wait_calib {
+	/* Peripheral clock cycles the wait must span */
+	unsigned int cycles;
+	/* Historic constant, kept as fallback and upper bound */
+	unsigned int worst_us;
+	/* Kernel clock the class is bound to */
+	unsigned long clock_id;
+	bool bound;
+};
+
+static struct wait_calib wait_calib_table[WAIT_CALIB_NB] = {
+	[WAIT_CALIB_RNG_RESET] = {
+		/* Reset must propagate through the RNG clock domain */
+		.cycles = 4U,
+		.worst_us = 20U,
+	},
+	[WAIT_CALIB_RNG_SEED_POLL] = {
+		/*
+		 * Initial seeding takes a fixed number of RNG clock
+		 * cycles; a poll step of ~200 cycles keeps the overshoot
+		 * past DRDY small without hammering the bus.
+		 */
+		.cycles = 200U,
+		.worst_us = 10U,
+	},
+	[WAIT_CALIB_SDMMC_RESET] = {
+		/* RCC reset synchronizer depth on sdmmc_ker_ck */
+		.cycles = 8U,
+		.worst_us = 2U,
+	},
+	[WAIT_CALIB_SDMMC_SETTLE] = {
+		/*
+		 * The controller state machines need a comfortable number
+		 * of kernel clock cycles out of reset before the first
+		 * command; the historic constant waited a full
+		 * millisecond.
+		 */
+		.cycles = 4096U,
+		.worst_us = 1000U,
+	},
+};
+
+void stm32mp_wait_calib_bind(enum stm32mp_wait_calib_id id,
+			     unsigned long clock_id)
+{
+	assert(id < WAIT_CALIB_NB);
+
+	wait_calib_table[id].clock_id = clock_id;
+	wait_calib_table[id].bound = true;
+
+	VERBOSE("Wait class %u: %u cycles on clock %lu (%u us)\n",
+		id, wait_calib_table[id].cycles, clock_id,
+		stm32mp_wait_calib_us(id));
+}
+
+unsigned int stm32mp_wait_calib_us(enum stm32mp_wait_calib_id id)
+{
+	const struct wait_calib *calib;
+	unsigned long rate;
+	unsigned long long wait_us;
+
+	assert(id < WAIT_CALIB_NB);
+
+	calib = &wait_calib_table[id];
+
+	if (!calib->bound) {
+		return calib->worst_us;
+	}
+
+	/*
+	 * The rate is read at call time, not cached at bind time, so a
+	 * kernel clock reparented after driver probe is still honoured.
+	 */
+	rate = stm32mp_clk_get_rate(calib->clock_id);
+	if (rate == 0U) {
+		return calib->worst_us;
+	}
+
+	wait_us = div_round_up((unsigned long long)calib->cycles * 1000000ULL,
+			       rate);
+	if (wait_us < 1ULL) {
+		wait_us = 1ULL;
+	}
+	if (wait_us > calib->worst_us) {
+		wait_us = calib->worst_us;
+	}
+
+	return (unsigned int)wait_us;
+}
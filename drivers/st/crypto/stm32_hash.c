@@ -6,6 +6,7 @@
 
 #include <assert.h>
 #include <errno.h>
+#include <stdbool.h>
 #include <stdint.h>
 
 #include <libfdt.h>
@@ -16,6 +17,7 @@
 #include <common/debug.h>
 #include <drivers/delay_timer.h>
 #include <drivers/st/stm32_hash.h>
+#include <drivers/st/stm32_iwdg.h>
 #include <drivers/st/stm32mp_reset.h>
 #include <lib/mmio.h>
 #include <lib/utils.h>
@@ -28,9 +30,14 @@
 #define HASH_CR				0x00U
 #define HASH_DIN			0x04U
 #define HASH_STR			0x08U
+#define HASH_IMR			0x20U
 #define HASH_SR				0x24U
+#define HASH_CSR(x)			(0xF8U + ((x) * 0x04U))
 #define HASH_HREG(x)			(0x310U + ((x) * 0x04U))
 
+/* Context swap registers, worst case (SHA-224/SHA-256) */
+#define HASH_CSR_COUNT			54U
+
 /* Control Register */
 #define HASH_CR_INIT			BIT(2)
 #define HASH_CR_DATATYPE_SHIFT		U(4)
@@ -73,10 +80,35 @@ struct stm32_hash_remain {
 	size_t length;
 };
 
+/*
+ * Number of suspended digest computations the driver can hold at once.
+ * A platform may override this in platform_def.h.
+ */
+#ifndef STM32_HASH_CTX_NB
+#define STM32_HASH_CTX_NB		2U
+#endif
+
+/*
+ * Saved state of a suspended digest computation: the peripheral context
+ * swap registers plus the driver word-alignment buffer and selected
+ * digest size.
+ */
+struct stm32_hash_context {
+	bool in_use;
+	uint32_t imr;
+	uint32_t str;
+	uint32_t cr;
+	uint32_t csr[HASH_CSR_COUNT];
+	struct stm32_hash_remain remain;
+	size_t digest_size;
+};
+
 /* Expect a single HASH peripheral */
 static struct stm32_hash_instance stm32_hash;
 static struct stm32_hash_remain stm32_remain;
 
+static struct stm32_hash_context hash_ctx_pool[STM32_HASH_CTX_NB];
+
 static uintptr_t hash_base(void)
 {
 	return stm32_hash.base;
@@ -222,6 +254,10 @@ int stm32_hash_update(const uint8_t *buffer, size_t length)
 
 		buffer += sizeof(uint32_t);
 		remain_length -= sizeof(uint32_t);
+
+		if ((remain_length % U(1024)) == 0U) {
+			stm32_iwdg_checkpoint();
+		}
 	}
 
 	if (remain_length != 0U) {
@@ -290,6 +326,83 @@ void stm32_hash_init(enum stm32_hash_algo_mode mode)
 	zeromem(&stm32_remain, sizeof(stm32_remain));
 }
 
+int stm32_hash_suspend(void)
+{
+	struct stm32_hash_context *ctx = NULL;
+	unsigned int i;
+	int ret;
+
+	for (i = 0U; i < STM32_HASH_CTX_NB; i++) {
+		if (!hash_ctx_pool[i].in_use) {
+			ctx = &hash_ctx_pool[i];
+			break;
+		}
+	}
+
+	if (ctx == NULL) {
+		return -ENOMEM;
+	}
+
+	stm32mp_clk_enable(stm32_hash.clock);
+
+	/* The context registers are consistent once the IP has settled */
+	ret = hash_wait_busy();
+	if (ret != 0) {
+		stm32mp_clk_disable(stm32_hash.clock);
+		return ret;
+	}
+
+	ctx->imr = mmio_read_32(hash_base() + HASH_IMR);
+	ctx->str = mmio_read_32(hash_base() + HASH_STR);
+	ctx->cr = mmio_read_32(hash_base() + HASH_CR);
+
+	for (i = 0U; i < HASH_CSR_COUNT; i++) {
+		ctx->csr[i] = mmio_read_32(hash_base() + HASH_CSR(i));
+	}
+
+	stm32mp_clk_disable(stm32_hash.clock);
+
+	ctx->remain = stm32_remain;
+	ctx->digest_size = stm32_hash.digest_size;
+	zeromem(&stm32_remain, sizeof(stm32_remain));
+
+	ctx->in_use = true;
+
+	return (int)(ctx - hash_ctx_pool);
+}
+
+int stm32_hash_resume(int handle)
+{
+	struct stm32_hash_context *ctx;
+	unsigned int i;
+
+	if ((handle < 0) || (handle >= (int)STM32_HASH_CTX_NB) ||
+	    !hash_ctx_pool[handle].in_use) {
+		return -EINVAL;
+	}
+
+	ctx = &hash_ctx_pool[handle];
+
+	stm32mp_clk_enable(stm32_hash.clock);
+
+	mmio_write_32(hash_base() + HASH_IMR, ctx->imr);
+	mmio_write_32(hash_base() + HASH_STR, ctx->str);
+	mmio_write_32(hash_base() + HASH_CR, ctx->cr | HASH_CR_INIT);
+
+	for (i = 0U; i < HASH_CSR_COUNT; i++) {
+		mmio_write_32(hash_base() + HASH_CSR(i), ctx->csr[i]);
+	}
+
+	stm32mp_clk_disable(stm32_hash.clock);
+
+	stm32_remain = ctx->remain;
+	stm32_hash.digest_size = ctx->digest_size;
+
+	zeromem(ctx, sizeof(*ctx));
+
+	return 0;
+}
+
 int stm32_hash_register(void)
 {
 	struct dt_node_info hash_info;
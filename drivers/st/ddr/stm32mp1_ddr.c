@@ -12,6 +12,7 @@
 #include <arch.h>
 #include <arch_helpers.h>
 #include <common/debug.h>
+#include <drivers/console.h>
 #include <drivers/delay_timer.h>
 #include <drivers/st/stm32mp_pmic.h>
 #include <drivers/st/stm32mp1_ddr.h>
@@ -290,6 +291,30 @@ static void set_reg(const struct ddr_info *priv,
 	}
 }
 
+static void get_reg(const struct ddr_info *priv,
+		    enum reg_type type,
+		    void *param)
+{
+	unsigned int i;
+	enum base_type base = ddr_registers[type].base;
+	uintptr_t base_addr = get_base_addr(priv, base);
+	const struct reg_desc *desc = ddr_registers[type].desc;
+
+	VERBOSE("read %s\n", ddr_registers[type].name);
+	for (i = 0; i < ddr_registers[type].size; i++) {
+		uintptr_t ptr = base_addr + desc[i].offset;
+
+		if (desc[i].par_offset == INVALID_OFFSET) {
+			ERROR("invalid parameter offset for %s", desc[i].name);
+			panic();
+		} else {
+			*((uint32_t *)((uintptr_t)param +
+				       desc[i].par_offset)) =
+				mmio_read_32(ptr);
+		}
+	}
+}
+
 static void stm32mp1_ddrphy_idone_wait(struct stm32mp1_ddrphy *phy)
 {
 	uint32_t pgsr;
@@ -765,6 +790,14 @@ void stm32mp1_ddr_init(struct ddr_info *priv,
 	uint32_t pir, ddr_reten;
 	int ret = -EINVAL;
 
+	/*
+	 * The whole controller/PHY init and DQS training sequence is timed:
+	 * hold log output (multi-line register dumps in particular) back
+	 * until the sequence completes, instead of draining it at UART pace
+	 * in the middle.
+	 */
+	console_quiet_enter();
+
 	if ((config->c_reg.mstr & DDRCTRL_MSTR_DDR3) != 0U) {
 		ret = board_ddr_power_init(STM32MP_DDR3);
 	} else if ((config->c_reg.mstr & DDRCTRL_MSTR_LPDDR2) != 0U) {
@@ -1038,4 +1071,16 @@ void stm32mp1_ddr_init(struct ddr_info *priv,
 	VERBOSE("[0x%lx] pctrl_1 = 0x%x\n",
 		(uintptr_t)&priv->ctl->pctrl_1,
 		mmio_read_32((uintptr_t)&priv->ctl->pctrl_1));
+
+	console_quiet_exit();
+}
+
+/*
+ * Read back the PHY calibration registers once the DQS training sequence has
+ * completed, so that the results can be saved and reused on a later cold boot.
+ */
+void stm32mp1_ddr_get_cal(struct ddr_info *priv,
+			  struct stm32mp1_ddrphy_cal *cal)
+{
+	get_reg(priv, REGPHY_CAL, cal);
 }
@@ -114,38 +114,28 @@ static int ddr_sw_self_refresh_in(void)
 	if (op_mode_changed == 0U)
 		goto selfref_sw_failed;
 
-	/* IOs powering down (PUBL registers) */
-	mmio_setbits_32(ddrphyc_base + DDRPHYC_ACIOCR, DDRPHYC_ACIOCR_ACPDD);
-
-	mmio_setbits_32(ddrphyc_base + DDRPHYC_ACIOCR, DDRPHYC_ACIOCR_ACPDR);
-
-	mmio_clrsetbits_32(ddrphyc_base + DDRPHYC_ACIOCR,
-			   DDRPHYC_ACIOCR_CKPDD_MASK,
-			   DDRPHYC_ACIOCR_CKPDD_0);
-
-	mmio_clrsetbits_32(ddrphyc_base + DDRPHYC_ACIOCR,
-			   DDRPHYC_ACIOCR_CKPDR_MASK,
-			   DDRPHYC_ACIOCR_CKPDR_0);
-
+	/*
+	 * IOs powering down (PUBL registers).
+	 * The PUBL APB accesses are slow and this sequence brackets every
+	 * STANDBY cycle, so the updates are coalesced into a single
+	 * read-modify-write per register.
+	 */
 	mmio_clrsetbits_32(ddrphyc_base + DDRPHYC_ACIOCR,
-			   DDRPHYC_ACIOCR_CSPDD_MASK,
+			   DDRPHYC_ACIOCR_CKPDD_MASK |
+			   DDRPHYC_ACIOCR_CKPDR_MASK |
+			   DDRPHYC_ACIOCR_CSPDD_MASK |
+			   DDRPHYC_ACIOCR_ACOE, /* Disable CA output driver */
+			   DDRPHYC_ACIOCR_ACPDD | DDRPHYC_ACIOCR_ACPDR |
+			   DDRPHYC_ACIOCR_CKPDD_0 | DDRPHYC_ACIOCR_CKPDR_0 |
 			   DDRPHYC_ACIOCR_CSPDD_0);
 
-	/* Disable command/address output driver */
-	mmio_clrbits_32(ddrphyc_base + DDRPHYC_ACIOCR, DDRPHYC_ACIOCR_ACOE);
-
-	mmio_setbits_32(ddrphyc_base + DDRPHYC_DXCCR, DDRPHYC_DXCCR_DXPDD);
-
-	mmio_setbits_32(ddrphyc_base + DDRPHYC_DXCCR, DDRPHYC_DXCCR_DXPDR);
-
-	mmio_clrsetbits_32(ddrphyc_base + DDRPHYC_DSGCR,
-			   DDRPHYC_DSGCR_ODTPDD_MASK,
-			   DDRPHYC_DSGCR_ODTPDD_0);
-
-	mmio_setbits_32(ddrphyc_base + DDRPHYC_DSGCR, DDRPHYC_DSGCR_NL2PD);
+	mmio_setbits_32(ddrphyc_base + DDRPHYC_DXCCR,
+			DDRPHYC_DXCCR_DXPDD | DDRPHYC_DXCCR_DXPDR);
 
 	mmio_clrsetbits_32(ddrphyc_base + DDRPHYC_DSGCR,
+			   DDRPHYC_DSGCR_ODTPDD_MASK |
 			   DDRPHYC_DSGCR_CKEPDD_MASK,
+			   DDRPHYC_DSGCR_ODTPDD_0 | DDRPHYC_DSGCR_NL2PD |
 			   DDRPHYC_DSGCR_CKEPDD_0);
 
 	/* Disable PZQ cell (PUBL register) */
@@ -303,32 +293,26 @@ int ddr_sw_self_refresh_exit(void)
 	/* Enable PZQ cell (PUBL register) */
 	mmio_clrbits_32(ddrphyc_base + DDRPHYC_ZQ0CR0, DDRPHYC_ZQ0CRN_ZQPD);
 
-	/* Enable pad drivers */
-	mmio_clrbits_32(ddrphyc_base + DDRPHYC_ACIOCR, DDRPHYC_ACIOCR_ACPDD);
-
-	/* Enable command/address output driver */
-	mmio_setbits_32(ddrphyc_base + DDRPHYC_ACIOCR, DDRPHYC_ACIOCR_ACOE);
-
-	mmio_clrbits_32(ddrphyc_base + DDRPHYC_ACIOCR,
-			DDRPHYC_ACIOCR_CKPDD_MASK);
-
-	mmio_clrbits_32(ddrphyc_base + DDRPHYC_ACIOCR,
-			DDRPHYC_ACIOCR_CSPDD_MASK);
-
-	mmio_clrbits_32(ddrphyc_base + DDRPHYC_DXCCR, DDRPHYC_DXCCR_DXPDD);
+	/*
+	 * Enable pad drivers and command/address output driver, with the
+	 * updates coalesced into a single read-modify-write per register,
+	 * mirroring the entry sequence.
+	 */
+	mmio_clrsetbits_32(ddrphyc_base + DDRPHYC_ACIOCR,
+			   DDRPHYC_ACIOCR_ACPDD |
+			   DDRPHYC_ACIOCR_CKPDD_MASK |
+			   DDRPHYC_ACIOCR_CSPDD_MASK,
+			   DDRPHYC_ACIOCR_ACOE);
 
-	mmio_clrbits_32(ddrphyc_base + DDRPHYC_DXCCR, DDRPHYC_DXCCR_DXPDR);
+	mmio_clrbits_32(ddrphyc_base + DDRPHYC_DXCCR,
+			DDRPHYC_DXCCR_DXPDD | DDRPHYC_DXCCR_DXPDR);
 
 	/* Release latch */
-	mmio_setbits_32(ddrphyc_base + DDRPHYC_DSGCR, DDRPHYC_DSGCR_CKOE);
-
-	mmio_clrbits_32(ddrphyc_base + DDRPHYC_DSGCR,
-			DDRPHYC_DSGCR_ODTPDD_MASK);
-
-	mmio_clrbits_32(ddrphyc_base + DDRPHYC_DSGCR, DDRPHYC_DSGCR_NL2PD);
-
-	mmio_clrbits_32(ddrphyc_base + DDRPHYC_DSGCR,
-			DDRPHYC_DSGCR_CKEPDD_MASK);
+	mmio_clrsetbits_32(ddrphyc_base + DDRPHYC_DSGCR,
+			   DDRPHYC_DSGCR_ODTPDD_MASK |
+			   DDRPHYC_DSGCR_NL2PD |
+			   DDRPHYC_DSGCR_CKEPDD_MASK,
+			   DDRPHYC_DSGCR_CKOE);
 
 	/* Remove selfrefresh */
 	mmio_clrbits_32(ddrctrl_base + DDRCTRL_PWRCTL,
@@ -390,27 +374,18 @@ static void ddr_sr_mode_ssr(void)
 
 	stm32mp1_clk_rcc_regs_lock();
 
-	mmio_setbits_32(rcc_ddritfcr, RCC_DDRITFCR_DDRC1LPEN);
-
-	mmio_setbits_32(rcc_ddritfcr, RCC_DDRITFCR_DDRC2LPEN);
-
-	mmio_setbits_32(rcc_ddritfcr, RCC_DDRITFCR_DDRC1EN);
-
-	mmio_setbits_32(rcc_ddritfcr, RCC_DDRITFCR_DDRC2EN);
-
-	mmio_setbits_32(rcc_ddritfcr, RCC_DDRITFCR_DDRCAPBLPEN);
-
-	mmio_setbits_32(rcc_ddritfcr, RCC_DDRITFCR_DDRPHYCAPBLPEN);
-
-	mmio_setbits_32(rcc_ddritfcr, RCC_DDRITFCR_DDRCAPBEN);
-
-	mmio_setbits_32(rcc_ddritfcr, RCC_DDRITFCR_DDRPHYCAPBEN);
-
-	mmio_setbits_32(rcc_ddritfcr, RCC_DDRITFCR_DDRPHYCEN);
-
-	mmio_clrbits_32(rcc_ddritfcr, RCC_DDRITFCR_AXIDCGEN);
-
-	mmio_clrbits_32(rcc_ddritfcr, RCC_DDRITFCR_DDRCKMOD_MASK);
+	mmio_clrsetbits_32(rcc_ddritfcr,
+			   RCC_DDRITFCR_AXIDCGEN |
+			   RCC_DDRITFCR_DDRCKMOD_MASK,
+			   RCC_DDRITFCR_DDRC1LPEN |
+			   RCC_DDRITFCR_DDRC2LPEN |
+			   RCC_DDRITFCR_DDRC1EN |
+			   RCC_DDRITFCR_DDRC2EN |
+			   RCC_DDRITFCR_DDRCAPBLPEN |
+			   RCC_DDRITFCR_DDRPHYCAPBLPEN |
+			   RCC_DDRITFCR_DDRCAPBEN |
+			   RCC_DDRITFCR_DDRPHYCAPBEN |
+			   RCC_DDRITFCR_DDRPHYCEN);
 
 	stm32mp1_clk_rcc_regs_unlock();
 
@@ -425,13 +400,11 @@ static void ddr_sr_mode_ssr(void)
 
 	/*
 	 * Disable Clock disable with LP modes
-	 * (used in RUN mode for LPDDR2 with specific timing).
+	 * (used in RUN mode for LPDDR2 with specific timing)
+	 * and automatic Self-Refresh mode, in one access.
 	 */
 	mmio_clrbits_32(ddrctrl_base + DDRCTRL_PWRCTL,
-			DDRCTRL_PWRCTL_EN_DFI_DRAM_CLK_DISABLE);
-
-	/* Disable automatic Self-Refresh mode */
-	mmio_clrbits_32(ddrctrl_base + DDRCTRL_PWRCTL,
+			DDRCTRL_PWRCTL_EN_DFI_DRAM_CLK_DISABLE |
 			DDRCTRL_PWRCTL_SELFREF_EN);
 }
 
@@ -442,15 +415,11 @@ static void ddr_sr_mode_asr(void)
 
 	stm32mp1_clk_rcc_regs_lock();
 
-	mmio_setbits_32(rcc_ddritfcr, RCC_DDRITFCR_AXIDCGEN);
-
-	mmio_setbits_32(rcc_ddritfcr, RCC_DDRITFCR_DDRC1LPEN);
-
-	mmio_setbits_32(rcc_ddritfcr, RCC_DDRITFCR_DDRC2LPEN);
-
-	mmio_setbits_32(rcc_ddritfcr, RCC_DDRITFCR_DDRPHYCLPEN);
-
 	mmio_clrsetbits_32(rcc_ddritfcr, RCC_DDRITFCR_DDRCKMOD_MASK,
+			   RCC_DDRITFCR_AXIDCGEN |
+			   RCC_DDRITFCR_DDRC1LPEN |
+			   RCC_DDRITFCR_DDRC2LPEN |
+			   RCC_DDRITFCR_DDRPHYCLPEN |
 			   RCC_DDRITFCR_DDRCKMOD_ASR1);
 
 	stm32mp1_clk_rcc_regs_unlock();
@@ -466,13 +435,11 @@ static void ddr_sr_mode_asr(void)
 
 	/*
 	 * Enable Clock disable with LP modes
-	 * (used in RUN mode for LPDDR2 with specific timing).
+	 * (used in RUN mode for LPDDR2 with specific timing)
+	 * and automatic Self-Refresh for ASR mode, in one access.
 	 */
 	mmio_setbits_32(ddrctrl_base + DDRCTRL_PWRCTL,
-			DDRCTRL_PWRCTL_EN_DFI_DRAM_CLK_DISABLE);
-
-	/* Enable automatic Self-Refresh for ASR mode */
-	mmio_setbits_32(ddrctrl_base + DDRCTRL_PWRCTL,
+			DDRCTRL_PWRCTL_EN_DFI_DRAM_CLK_DISABLE |
 			DDRCTRL_PWRCTL_SELFREF_EN);
 }
 
@@ -483,15 +450,12 @@ static void ddr_sr_mode_hsr(void)
 
 	stm32mp1_clk_rcc_regs_lock();
 
-	mmio_setbits_32(rcc_ddritfcr, RCC_DDRITFCR_AXIDCGEN);
-
-	mmio_clrbits_32(rcc_ddritfcr, RCC_DDRITFCR_DDRC1LPEN);
-
-	mmio_clrbits_32(rcc_ddritfcr, RCC_DDRITFCR_DDRC2LPEN);
-
-	mmio_setbits_32(rcc_ddritfcr, RCC_DDRITFCR_DDRPHYCLPEN);
-
-	mmio_clrsetbits_32(rcc_ddritfcr, RCC_DDRITFCR_DDRCKMOD_MASK,
+	mmio_clrsetbits_32(rcc_ddritfcr,
+			   RCC_DDRITFCR_DDRC1LPEN |
+			   RCC_DDRITFCR_DDRC2LPEN |
+			   RCC_DDRITFCR_DDRCKMOD_MASK,
+			   RCC_DDRITFCR_AXIDCGEN |
+			   RCC_DDRITFCR_DDRPHYCLPEN |
 			   RCC_DDRITFCR_DDRCKMOD_HSR1);
 
 	stm32mp1_clk_rcc_regs_unlock();
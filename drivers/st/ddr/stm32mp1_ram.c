@@ -17,6 +17,10 @@
 #include <drivers/st/stm32mp1_ram.h>
 #include <lib/mmio.h>
 
+#if STM32MP_DDR_BENCHMARK
+#include <stm32mp1_boot_timeline.h>
+#endif
+
 #define DDR_PATTERN	0xAAAAAAAAU
 #define DDR_ANTIPATTERN	0x55555555U
 
@@ -182,11 +186,215 @@ static uint32_t ddr_check_size(void)
 	return offset;
 }
 
+/*******************************************************************************
+ * This function runs the cold boot DDR tests: data bus, address bus and
+ * memory size check.
+ * Returns 0 if success, and a negative value else.
+ ******************************************************************************/
+static int ddr_cold_boot_tests(uint32_t expected_size)
+{
+	uint32_t uret;
+
+	uret = ddr_test_data_bus();
+	if (uret != 0U) {
+		ERROR("DDR data bus test: can't access memory @ 0x%x\n", uret);
+		return -EIO;
+	}
+
+	uret = ddr_test_addr_bus();
+	if (uret != 0U) {
+		ERROR("DDR addr bus test: can't access memory @ 0x%x\n", uret);
+		return -EIO;
+	}
+
+	uret = ddr_check_size();
+	if (uret < expected_size) {
+		ERROR("DDR size: 0x%x does not match DT config: 0x%x\n",
+		      uret, expected_size);
+		return -EIO;
+	}
+
+	return 0;
+}
+
+#if STM32MP_DDR_BENCHMARK
+/*
+ * Post-training micro-benchmark. The window and operation counts are sized
+ * so the whole run stays within a few milliseconds while still touching
+ * enough rows to expose a marginal training result. It runs on the cold
+ * boot path only, before any image has been loaded, so the DDR content may
+ * be overwritten freely. As for the other DDR tests, the accesses go
+ * through the uncached mapping: the absolute numbers are below the cached
+ * streaming rates, but they track the DQS training margin, which is what
+ * the thresholds gate.
+ */
+#define DDR_BENCH_SIZE		(256U * 1024U)
+#define DDR_BENCH_WORDS		(DDR_BENCH_SIZE / sizeof(uint32_t))
+#define DDR_BENCH_LAT_OPS	4096U
+/* Stride in words, coprime with the window so the chase never collides */
+#define DDR_BENCH_LAT_STRIDE	257U
+
+static uint32_t ddr_bench_mbps(uint32_t bytes, uint64_t ticks)
+{
+	uint64_t freq = read_cntfrq_el0();
+
+	if (ticks == 0U) {
+		return 0U;
+	}
+
+	return (uint32_t)(((uint64_t)bytes * freq) /
+			  (ticks * 1024U * 1024U));
+}
+
+static uint64_t ddr_bench_read(void)
+{
+	volatile uint32_t *p = (volatile uint32_t *)STM32MP_DDR_BASE;
+	uint32_t acc = 0U;
+	uint64_t start;
+	uint32_t i;
+
+	start = read_cntpct_el0();
+
+	for (i = 0U; i < DDR_BENCH_WORDS; i += 8U) {
+		acc += p[i] + p[i + 1U] + p[i + 2U] + p[i + 3U] +
+		       p[i + 4U] + p[i + 5U] + p[i + 6U] + p[i + 7U];
+	}
+
+	/* Keep the accumulation alive */
+	p[0] = acc;
+
+	return read_cntpct_el0() - start;
+}
+
+static uint64_t ddr_bench_write(void)
+{
+	volatile uint32_t *p = (volatile uint32_t *)STM32MP_DDR_BASE;
+	uint64_t start;
+	uint32_t i;
+
+	start = read_cntpct_el0();
+
+	for (i = 0U; i < DDR_BENCH_WORDS; i += 8U) {
+		p[i] = DDR_PATTERN;
+		p[i + 1U] = DDR_PATTERN;
+		p[i + 2U] = DDR_PATTERN;
+		p[i + 3U] = DDR_PATTERN;
+		p[i + 4U] = DDR_PATTERN;
+		p[i + 5U] = DDR_PATTERN;
+		p[i + 6U] = DDR_PATTERN;
+		p[i + 7U] = DDR_PATTERN;
+	}
+
+	dsb();
+
+	return read_cntpct_el0() - start;
+}
+
+static uint64_t ddr_bench_copy(void)
+{
+	volatile uint32_t *src = (volatile uint32_t *)STM32MP_DDR_BASE;
+	volatile uint32_t *dst = src + (DDR_BENCH_WORDS / 2U);
+	uint64_t start;
+	uint32_t i;
+
+	start = read_cntpct_el0();
+
+	for (i = 0U; i < (DDR_BENCH_WORDS / 2U); i += 4U) {
+		dst[i] = src[i];
+		dst[i + 1U] = src[i + 1U];
+		dst[i + 2U] = src[i + 2U];
+		dst[i + 3U] = src[i + 3U];
+	}
+
+	dsb();
+
+	return read_cntpct_el0() - start;
+}
+
+static uint32_t ddr_bench_lat_ns(void)
+{
+	volatile uint32_t *p = (volatile uint32_t *)STM32MP_DDR_BASE;
+	uint64_t freq = read_cntfrq_el0();
+	uint64_t start, ticks;
+	uint32_t idx = 0U;
+	uint32_t i;
+
+	/*
+	 * Build a pointer-chase cycle with a prime stride, so consecutive
+	 * loads hit distant rows and each load depends on the previous one.
+	 */
+	for (i = 0U; i < DDR_BENCH_LAT_OPS; i++) {
+		p[(i * DDR_BENCH_LAT_STRIDE) % DDR_BENCH_WORDS] =
+			((i + 1U) * DDR_BENCH_LAT_STRIDE) % DDR_BENCH_WORDS;
+	}
+
+	start = read_cntpct_el0();
+
+	for (i = 0U; i < DDR_BENCH_LAT_OPS; i++) {
+		idx = p[idx];
+	}
+
+	ticks = read_cntpct_el0() - start;
+
+	/* Keep the chase alive */
+	p[0] = idx;
+
+	if (freq == 0U) {
+		return 0U;
+	}
+
+	return (uint32_t)((ticks * 1000000000ULL) /
+			  (freq * DDR_BENCH_LAT_OPS));
+}
+
+/*
+ * Run the micro-benchmark and compare the results against the optional
+ * per-board thresholds of the DDR node. An absent (or zero) threshold only
+ * disables the gating for that metric, the measurement is still exported
+ * through the boot timeline. The copy rate counts bytes copied, not bytes
+ * transferred on the bus.
+ * Returns 0 when every enabled threshold is met, and -EIO else.
+ */
+static int ddr_benchmark(int node)
+{
+	uint32_t rd_mbps, wr_mbps, cp_mbps, lat_ns;
+	uint32_t rd_min, wr_min, cp_min, lat_max;
+
+	rd_min = fdt_read_uint32_default(node, "st,bench-read-min-mbps", 0U);
+	wr_min = fdt_read_uint32_default(node, "st,bench-write-min-mbps", 0U);
+	cp_min = fdt_read_uint32_default(node, "st,bench-copy-min-mbps", 0U);
+	lat_max = fdt_read_uint32_default(node, "st,bench-latency-max-ns", 0U);
+
+	rd_mbps = ddr_bench_mbps(DDR_BENCH_SIZE, ddr_bench_read());
+	wr_mbps = ddr_bench_mbps(DDR_BENCH_SIZE, ddr_bench_write());
+	cp_mbps = ddr_bench_mbps(DDR_BENCH_SIZE / 2U, ddr_bench_copy());
+	lat_ns = ddr_bench_lat_ns();
+
+	INFO("DDR bench: rd %u MB/s, wr %u MB/s, cp %u MB/s, lat %u ns\n",
+	     rd_mbps, wr_mbps, cp_mbps, lat_ns);
+
+	boot_timeline_record(BOOT_TL_DDR_BENCH_RD_BW, rd_mbps);
+	boot_timeline_record(BOOT_TL_DDR_BENCH_WR_BW, wr_mbps);
+	boot_timeline_record(BOOT_TL_DDR_BENCH_CP_BW, cp_mbps);
+	boot_timeline_record(BOOT_TL_DDR_BENCH_LAT, lat_ns);
+
+	if (((rd_min != 0U) && (rd_mbps < rd_min)) ||
+	    ((wr_min != 0U) && (wr_mbps < wr_min)) ||
+	    ((cp_min != 0U) && (cp_mbps < cp_min)) ||
+	    ((lat_max != 0U) && (lat_ns > lat_max))) {
+		return -EIO;
+	}
+
+	return 0;
+}
+#endif /* STM32MP_DDR_BENCHMARK */
+
 static int stm32mp1_ddr_setup(void)
 {
 	struct ddr_info *priv = &ddr_priv_data;
 	int ret;
 	struct stm32mp1_ddr_config config;
+	bool cal_restored = false;
 	int node, len;
 	uint32_t magic, uret, idx;
 	void *fdt;
@@ -284,6 +492,20 @@ static int stm32mp1_ddr_setup(void)
 
 	stm32mp_clk_disable(RTCAPB);
 
+	/*
+	 * On cold boot, reuse the calibration results saved in Backup SRAM by
+	 * a previous DQS training run instead of retraining, unless the DT
+	 * already provides fixed calibration values. The saved values are
+	 * checked below by the cold boot tests, with a fallback to a full
+	 * training run if they no longer match the memory.
+	 */
+	if (!config.self_refresh && !config.p_cal_present &&
+	    (stm32_get_ddr_cal_from_context(&config.p_cal) == 0)) {
+		INFO("DDR: using saved PHY calibration\n");
+		config.p_cal_present = true;
+		cal_restored = true;
+	}
+
 	/* Disable axidcg clock gating during init */
 	mmio_clrbits_32(priv->rcc + RCC_DDRITFCR, RCC_DDRITFCR_AXIDCGEN);
 
@@ -316,26 +538,75 @@ static int stm32mp1_ddr_setup(void)
 		/* Restore area overwritten by training */
 		stm32_restore_ddr_training_area();
 	} else {
-		uret = ddr_test_data_bus();
-		if (uret != 0U) {
-			ERROR("DDR data bus test: can't access memory @ 0x%x\n",
-			      uret);
-			panic();
+		if (ddr_cold_boot_tests(config.info.size) != 0) {
+			if (!cal_restored) {
+				panic();
+			}
+
+			/*
+			 * The saved calibration no longer matches the memory:
+			 * discard it and fall back to a full training run.
+			 */
+			WARN("DDR: saved PHY calibration rejected, retraining\n");
+			stm32_clean_ddr_cal();
+			config.p_cal_present = false;
+			cal_restored = false;
+
+			mmio_clrbits_32(priv->rcc + RCC_DDRITFCR,
+					RCC_DDRITFCR_AXIDCGEN);
+
+			stm32mp1_ddr_init(priv, &config);
+
+			mmio_setbits_32(priv->rcc + RCC_DDRITFCR,
+					RCC_DDRITFCR_AXIDCGEN);
+
+			if (ddr_cold_boot_tests(config.info.size) != 0) {
+				panic();
+			}
 		}
 
-		uret = ddr_test_addr_bus();
-		if (uret != 0U) {
-			ERROR("DDR addr bus test: can't access memory @ 0x%x\n",
-			      uret);
-			panic();
+		if (!config.p_cal_present) {
+			/* Save training results for the next cold boot */
+			stm32mp1_ddr_get_cal(priv, &config.p_cal);
+			stm32_save_ddr_cal(&config.p_cal);
 		}
 
-		uret = ddr_check_size();
-		if (uret < config.info.size) {
-			ERROR("DDR size: 0x%x does not match DT config: 0x%x\n",
-			      uret, config.info.size);
-			panic();
+#if STM32MP_DDR_BENCHMARK
+		/*
+		 * A marginal training run can pass the functional tests and
+		 * still leave a fraction of the bandwidth on the table. When
+		 * the benchmark misses a per-board threshold, discard the
+		 * calibration in use and retrain once. A second miss is
+		 * reported but does not stop the boot: the board works, only
+		 * slower than provisioned.
+		 */
+		if (ddr_benchmark(node) != 0) {
+			WARN("DDR: benchmark below thresholds, retraining\n");
+			stm32_clean_ddr_cal();
+			config.p_cal_present = false;
+			cal_restored = false;
+
+			mmio_clrbits_32(priv->rcc + RCC_DDRITFCR,
+					RCC_DDRITFCR_AXIDCGEN);
+
+			stm32mp1_ddr_init(priv, &config);
+
+			mmio_setbits_32(priv->rcc + RCC_DDRITFCR,
+					RCC_DDRITFCR_AXIDCGEN);
+
+			if (ddr_cold_boot_tests(config.info.size) != 0) {
+				panic();
+			}
+
+			/* Save the new training results */
+			stm32mp1_ddr_get_cal(priv, &config.p_cal);
+			stm32_save_ddr_cal(&config.p_cal);
+
+			if (ddr_benchmark(node) != 0) {
+				ERROR("DDR: benchmark below thresholds after retraining\n");
+			}
 		}
+#endif
 	}
 
 	/*
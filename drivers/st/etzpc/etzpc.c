@@ -78,6 +78,14 @@ struct dt_id_attr {
 #define PERIPH_LOCK_BIT		BIT(7)
 #define PERIPH_ATTR_MASK	GENMASK(2, 0)
 
+/*
+ * Shadow of the desired DECPROT configuration, written through by
+ * etzpc_configure_decprot() and etzpc_lock_decprot(). The resume path
+ * replays the same configuration, so each write is preceded by a readback
+ * compare and skipped when the hardware already holds the desired state.
+ */
+static uint8_t decprot_shadow[STM32MP1_ETZPC_MAX_ID];
+
 static bool valid_decprot_id(unsigned int id)
 {
 	return id < (unsigned int)etzpc_dev.num_per_sec;
@@ -151,6 +159,14 @@ void etzpc_configure_decprot(uint32_t decprot_id,
 
 	assert(valid_decprot_id(decprot_id));
 
+	decprot_shadow[decprot_id] &= (uint8_t)~PERIPH_ATTR_MASK;
+	decprot_shadow[decprot_id] |= (uint8_t)decprot_attr & PERIPH_ATTR_MASK;
+
+	/* Skip the write if the hardware retained the desired state */
+	if (etzpc_get_decprot(decprot_id) == decprot_attr) {
+		return;
+	}
+
 	mmio_clrsetbits_32(etzpc_dev.base + ETZPC_DECPROT0 + offset,
 			   (uint32_t)ETZPC_DECPROT0_MASK << shift,
 			   masked_decprot << shift);
@@ -188,6 +204,13 @@ void etzpc_lock_decprot(uint32_t decprot_id)
 
 	assert(valid_decprot_id(decprot_id));
 
+	decprot_shadow[decprot_id] |= PERIPH_LOCK_BIT;
+
+	/* Lock bits are sticky: skip the write if already set */
+	if ((mmio_read_32(base_decprot + ETZPC_DECPROT_LOCK0) & shift) != 0U) {
+		return;
+	}
+
 	mmio_write_32(base_decprot + ETZPC_DECPROT_LOCK0, shift);
 }
 
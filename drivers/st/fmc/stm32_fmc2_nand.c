@@ -18,6 +18,7 @@
 #include <drivers/raw_nand.h>
 #include <drivers/st/stm32_fmc2_nand.h>
 #include <drivers/st/stm32_gpio.h>
+#include <drivers/st/stm32_iwdg.h>
 #include <drivers/st/stm32mp_reset.h>
 #include <lib/mmio.h>
 #include <lib/utils_def.h>
@@ -443,11 +444,17 @@ static int stm32_fmc2_ham_calculate(uint8_t *buffer, uint8_t *ecc)
 	return 0;
 }
 
-static int stm32_fmc2_bch_correct(uint8_t *buffer, unsigned int eccsize)
+/* Decoding status of one NAND page sector, saved before re-arming the BCH */
+struct stm32_fmc2_bch_result {
+	uint32_t bchdsr0;
+	uint32_t bchdsr1;
+	uint32_t bchdsr2;
+	uint32_t bchdsr3;
+	uint32_t bchdsr4;
+};
+
+static int stm32_fmc2_bch_wait_decode(struct stm32_fmc2_bch_result *result)
 {
-	uint32_t bchdsr0, bchdsr1, bchdsr2, bchdsr3, bchdsr4;
-	uint16_t pos[8];
-	int i, den;
 	uint64_t timeout = timeout_init_us(TIMEOUT_US_10_MS);
 
 	while ((mmio_read_32(fmc2_base() + FMC2_BCHISR) &
@@ -457,35 +464,49 @@ static int stm32_fmc2_bch_correct(uint8_t *buffer, unsigned int eccsize)
 		}
 	}
 
-	bchdsr0 = mmio_read_32(fmc2_base() + FMC2_BCHDSR0);
-	bchdsr1 = mmio_read_32(fmc2_base() + FMC2_BCHDSR1);
-	bchdsr2 = mmio_read_32(fmc2_base() + FMC2_BCHDSR2);
-	bchdsr3 = mmio_read_32(fmc2_base() + FMC2_BCHDSR3);
-	bchdsr4 = mmio_read_32(fmc2_base() + FMC2_BCHDSR4);
+	result->bchdsr0 = mmio_read_32(fmc2_base() + FMC2_BCHDSR0);
+	result->bchdsr1 = mmio_read_32(fmc2_base() + FMC2_BCHDSR1);
+	result->bchdsr2 = mmio_read_32(fmc2_base() + FMC2_BCHDSR2);
+	result->bchdsr3 = mmio_read_32(fmc2_base() + FMC2_BCHDSR3);
+	result->bchdsr4 = mmio_read_32(fmc2_base() + FMC2_BCHDSR4);
 
 	/* Disable ECC */
 	stm32_fmc2_set_ecc(false);
 
+	return 0;
+}
+
+static int stm32_fmc2_bch_correct(const struct stm32_fmc2_bch_result *result,
+				  uint8_t *buffer, unsigned int eccsize)
+{
+	uint16_t pos[8];
+	int i, den;
+
 	/* No error found */
-	if ((bchdsr0 & FMC2_BCHDSR0_DEF) == 0U) {
+	if ((result->bchdsr0 & FMC2_BCHDSR0_DEF) == 0U) {
 		return 0;
 	}
 
 	/* Too many errors detected */
-	if ((bchdsr0 & FMC2_BCHDSR0_DUE) != 0U) {
+	if ((result->bchdsr0 & FMC2_BCHDSR0_DUE) != 0U) {
 		return -EBADMSG;
 	}
 
-	pos[0] = bchdsr1 & FMC2_BCHDSR1_EBP1_MASK;
-	pos[1] = (bchdsr1 & FMC2_BCHDSR1_EBP2_MASK) >> FMC2_BCHDSR1_EBP2_SHIFT;
-	pos[2] = bchdsr2 & FMC2_BCHDSR2_EBP3_MASK;
-	pos[3] = (bchdsr2 & FMC2_BCHDSR2_EBP4_MASK) >> FMC2_BCHDSR2_EBP4_SHIFT;
-	pos[4] = bchdsr3 & FMC2_BCHDSR3_EBP5_MASK;
-	pos[5] = (bchdsr3 & FMC2_BCHDSR3_EBP6_MASK) >> FMC2_BCHDSR3_EBP6_SHIFT;
-	pos[6] = bchdsr4 & FMC2_BCHDSR4_EBP7_MASK;
-	pos[7] = (bchdsr4 & FMC2_BCHDSR4_EBP8_MASK) >> FMC2_BCHDSR4_EBP8_SHIFT;
-
-	den = (bchdsr0 & FMC2_BCHDSR0_DEN_MASK) >> FMC2_BCHDSR0_DEN_SHIFT;
+	pos[0] = result->bchdsr1 & FMC2_BCHDSR1_EBP1_MASK;
+	pos[1] = (result->bchdsr1 & FMC2_BCHDSR1_EBP2_MASK) >>
+		 FMC2_BCHDSR1_EBP2_SHIFT;
+	pos[2] = result->bchdsr2 & FMC2_BCHDSR2_EBP3_MASK;
+	pos[3] = (result->bchdsr2 & FMC2_BCHDSR2_EBP4_MASK) >>
+		 FMC2_BCHDSR2_EBP4_SHIFT;
+	pos[4] = result->bchdsr3 & FMC2_BCHDSR3_EBP5_MASK;
+	pos[5] = (result->bchdsr3 & FMC2_BCHDSR3_EBP6_MASK) >>
+		 FMC2_BCHDSR3_EBP6_SHIFT;
+	pos[6] = result->bchdsr4 & FMC2_BCHDSR4_EBP7_MASK;
+	pos[7] = (result->bchdsr4 & FMC2_BCHDSR4_EBP8_MASK) >>
+		 FMC2_BCHDSR4_EBP8_SHIFT;
+
+	den = (result->bchdsr0 & FMC2_BCHDSR0_DEN_MASK) >>
+	      FMC2_BCHDSR0_DEN_SHIFT;
 	for (i = 0; i < den; i++) {
 		if (pos[i] < (eccsize * 8U)) {
 			uint8_t bitmask = BIT(pos[i] % 8U);
@@ -518,6 +539,8 @@ static int stm32_fmc2_read_page(struct nand_device *nand,
 	unsigned int eccsteps = nand->page_size / eccsize;
 	uint8_t ecc_corr[FMC2_MAX_ECC_BYTES];
 	uint8_t ecc_cal[FMC2_MAX_ECC_BYTES] = {0U};
+	struct stm32_fmc2_bch_result bch_result;
+	uint8_t *p_prev = NULL;
 	uint8_t *p;
 	unsigned int i;
 	unsigned int s;
@@ -559,10 +582,36 @@ static int stm32_fmc2_read_page(struct nand_device *nand,
 		/* Correct the data */
 		if (nand->ecc.max_bit_corr == FMC2_ECC_HAM) {
 			ret = stm32_fmc2_ham_correct(p, ecc_corr, ecc_cal);
+			if (ret != 0) {
+				return ret;
+			}
 		} else {
-			ret = stm32_fmc2_bch_correct(p, eccsize);
+			/*
+			 * The BCH engine decodes this sector's syndrome now
+			 * that its ECC bytes have been read: apply the
+			 * previous sector's corrections in the meantime, they
+			 * only depend on its saved decoding status.
+			 */
+			if (p_prev != NULL) {
+				ret = stm32_fmc2_bch_correct(&bch_result,
+							     p_prev, eccsize);
+				if (ret != 0) {
+					return ret;
+				}
+			}
+
+			ret = stm32_fmc2_bch_wait_decode(&bch_result);
+			if (ret != 0) {
+				return ret;
+			}
+
+			p_prev = p;
 		}
+	}
 
+	/* Correct the last sector once out of the transfer loop */
+	if (p_prev != NULL) {
+		ret = stm32_fmc2_bch_correct(&bch_result, p_prev, eccsize);
 		if (ret != 0) {
 			return ret;
 		}
@@ -577,6 +626,9 @@ static void stm32_fmc2_read_data(struct nand_device *nand,
 {
 	uintptr_t data_base = stm32_fmc2.cs[stm32_fmc2.cs_sel].data_base;
 
+	/* One page worth of PIO per call: refresh the watchdogs if due */
+	stm32_iwdg_checkpoint();
+
 	if (use_bus8 && (nand->buswidth == NAND_BUS_WIDTH_16)) {
 		stm32_fmc2_set_buswidth_16(false);
 	}
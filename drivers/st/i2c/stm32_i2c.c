@@ -1032,6 +1032,120 @@ int stm32_i2c_mem_write(struct i2c_handle_s *hi2c, uint16_t dev_addr,
 			 p_data, size, timeout_ms, I2C_MODE_MEM);
 }
 
+/*
+ * @brief  Write a sequence of device registers in blocking mode, chained
+ *         with repeated starts: the bus is claimed once for the whole
+ *         sequence and the stop condition is only generated after the last
+ *         register value.
+ * @param  hi2c: Pointer to a struct i2c_handle_s structure that contains
+ *               the configuration information for the specified I2C.
+ * @param  dev_addr: Target device address
+ * @param  mem_add_size: Size of internal memory address
+ * @param  writes: Register address/value pairs to be written, in order
+ * @param  count: Number of register writes
+ * @param  timeout_ms: Timeout duration in milliseconds for the sequence
+ * @retval 0 if OK, negative value else
+ */
+int stm32_i2c_mem_write_seq(struct i2c_handle_s *hi2c, uint16_t dev_addr,
+			    uint16_t mem_add_size,
+			    const struct stm32_i2c_reg_write *writes,
+			    unsigned int count, uint32_t timeout_ms)
+{
+	uint64_t timeout_ref;
+	int rc = -EIO;
+	unsigned int i;
+
+	if ((hi2c->i2c_state != I2C_STATE_READY) || (hi2c->lock != 0U)) {
+		return -EBUSY;
+	}
+
+	if ((writes == NULL) || (count == 0U)) {
+		return -EINVAL;
+	}
+
+	stm32mp_clk_enable(hi2c->clock);
+
+	hi2c->lock = 1;
+
+	timeout_ref = timeout_init_us(I2C_TIMEOUT_BUSY_MS * 1000);
+	if (i2c_wait_flag(hi2c, I2C_FLAG_BUSY, 1, timeout_ref) != 0) {
+		goto bail;
+	}
+
+	hi2c->i2c_state = I2C_STATE_BUSY_TX;
+	hi2c->i2c_mode = I2C_MODE_MEM;
+	hi2c->i2c_err = I2C_ERROR_NONE;
+
+	timeout_ref = timeout_init_us(timeout_ms * 1000);
+
+	for (i = 0U; i < count; i++) {
+		uint16_t mem_addr = writes[i].mem_addr;
+		uint32_t mode = (i == (count - 1U)) ? I2C_AUTOEND_MODE :
+				I2C_SOFTEND_MODE;
+
+		/*
+		 * Each register write is one transfer covering the memory
+		 * address and the value. Intermediate transfers end on a
+		 * repeated start so that the bus is not released in between.
+		 */
+		i2c_transfer_config(hi2c, dev_addr, mem_add_size + 1U, mode,
+				    I2C_GENERATE_START_WRITE);
+
+		if (i2c_wait_txis(hi2c, timeout_ref) != 0) {
+			goto bail;
+		}
+
+		if (mem_add_size == I2C_MEMADD_SIZE_16BIT) {
+			/* Send MSB of Memory Address */
+			mmio_write_8(hi2c->i2c_base_addr + I2C_TXDR,
+				     (uint8_t)((mem_addr & 0xFF00U) >> 8));
+
+			if (i2c_wait_txis(hi2c, timeout_ref) != 0) {
+				goto bail;
+			}
+		}
+
+		/* Send (LSB of) Memory Address */
+		mmio_write_8(hi2c->i2c_base_addr + I2C_TXDR,
+			     (uint8_t)(mem_addr & 0x00FFU));
+
+		if (i2c_wait_txis(hi2c, timeout_ref) != 0) {
+			goto bail;
+		}
+
+		mmio_write_8(hi2c->i2c_base_addr + I2C_TXDR, writes[i].value);
+
+		if ((i != (count - 1U)) &&
+		    (i2c_wait_flag(hi2c, I2C_FLAG_TC, 0, timeout_ref) != 0)) {
+			goto bail;
+		}
+	}
+
+	/*
+	 * No need to Check TC flag, with AUTOEND mode the stop
+	 * is automatically generated.
+	 * Wait until STOPF flag is reset.
+	 */
+	if (i2c_wait_stop(hi2c, timeout_ref) != 0) {
+		goto bail;
+	}
+
+	mmio_write_32(hi2c->i2c_base_addr + I2C_ICR, I2C_FLAG_STOPF);
+
+	mmio_clrbits_32(hi2c->i2c_base_addr + I2C_CR2, I2C_RESET_CR2);
+
+	hi2c->i2c_state = I2C_STATE_READY;
+	hi2c->i2c_mode  = I2C_MODE_NONE;
+
+	rc = 0;
+
+bail:
+	hi2c->lock = 0;
+	stm32mp_clk_disable(hi2c->clock);
+
+	return rc;
+}
+
 /*
  * @brief  Transmits in master mode an amount of data in blocking mode.
  * @param  hi2c: Pointer to a struct i2c_handle_s structure that contains
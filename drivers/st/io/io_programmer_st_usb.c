@@ -24,9 +24,9 @@
 
 #define IO_USB_TIMEOUT_10_SEC	U(10000000)
 #define DETACH_TIMEOUT		U(0x100)
-#define USB_DFU_MAX_XFER_SIZE	1024
+#define USB_DFU_MAX_XFER_SIZE	USBD_DFU_XFER_SIZE
 
-static uint8_t first_usb_buffer[USB_DFU_MAX_XFER_SIZE + 1] __aligned(4);
+static uint8_t *first_usb_buffer;
 static usb_dfu_media_t usb_dfu_fops;
 static uint8_t checksum_is_wrong;
 static uint8_t usb_status;
@@ -144,6 +144,11 @@ static int usb_dev_open(const uintptr_t init_params,
 	assert(dev_info);
 	*dev_info = &usb_dev_info;
 
+	if (first_usb_buffer == NULL) {
+		first_usb_buffer = stm32mp_bounce_alloc(USB_DFU_MAX_XFER_SIZE +
+							1U, sizeof(uint32_t));
+	}
+
 	usb_dfu_fops.write_done = usb_callback_write_done;
 	usb_dfu_fops.read = usb_callback_read;
 	usb_dfu_fops.get_status = usb_callback_get_status;
@@ -15,13 +15,18 @@
 #include <drivers/io/io_driver.h>
 #include <drivers/io/io_storage.h>
 #include <drivers/st/io_stm32image.h>
+#include <lib/cassert.h>
 #include <lib/utils.h>
 #include <plat/common/platform.h>
 
+CASSERT((sizeof(boot_api_image_header_t) +
+	 sizeof(struct stm32image_sparse_table)) == MAX_LBA_SIZE,
+	assert_sparse_table_fills_first_lba);
+
 static uintptr_t backend_dev_handle;
 static uintptr_t backend_image_spec;
 static uint32_t *stm32_img;
-static uint8_t first_lba_buffer[MAX_LBA_SIZE] __aligned(4);
+static uint8_t *first_lba_buffer;
 static struct stm32image_part_info *current_part;
 
 /* STM32 Image driver functions */
@@ -88,6 +93,11 @@ static int stm32image_dev_open(const uintptr_t init_params,
 	assert(dev_info != NULL);
 	*dev_info = (io_dev_info_t *)&stm32image_dev_info;
 
+	if (first_lba_buffer == NULL) {
+		first_lba_buffer = stm32mp_bounce_alloc(MAX_LBA_SIZE,
+							sizeof(uint32_t));
+	}
+
 	stm32image_dev.device_size = device_info->device_size;
 	stm32image_dev.lba_size = device_info->lba_size;
 
@@ -204,7 +214,23 @@ static int stm32image_partition_size(io_entity_t *entity, size_t *length)
 		goto out;
 	}
 
-	if (header->image_length < stm32image_dev.lba_size) {
+	if ((header->option_flags & STM32IMAGE_OPTION_SPARSE) != 0U) {
+		const struct stm32image_sparse_table *table =
+			(const struct stm32image_sparse_table *)
+			(first_lba_buffer + sizeof(boot_api_image_header_t));
+
+		if ((table->magic != STM32IMAGE_SPARSE_MAGIC) ||
+		    (table->segment_count == 0U) ||
+		    (table->segment_count > STM32IMAGE_SPARSE_MAX_SEGMENTS) ||
+		    (table->expanded_length < header->image_length)) {
+			ERROR("%s: bad sparse table in %s\n", __func__,
+			      current_part->name);
+			result = -EINVAL;
+			goto out;
+		}
+
+		*length = table->expanded_length;
+	} else if (header->image_length < stm32image_dev.lba_size) {
 		*length = stm32image_dev.lba_size;
 	} else {
 		*length = header->image_length;
@@ -218,6 +244,85 @@ out:
 	return result;
 }
 
+/*
+ * Read a sparse partition: seek to each packed segment in turn and
+ * zero-fill the holes in between with memset, so stripped padding
+ * costs no storage bandwidth.
+ */
+static int stm32image_partition_read_sparse(uintptr_t buffer, size_t length,
+					    size_t *length_read)
+{
+	const struct stm32image_sparse_table *table =
+		(const struct stm32image_sparse_table *)
+		(first_lba_buffer + sizeof(boot_api_image_header_t));
+	uintptr_t backend_handle;
+	size_t packed_offset = MAX_LBA_SIZE;
+	size_t end = 0U;
+	uint32_t i;
+	int result;
+
+	if ((table->magic != STM32IMAGE_SPARSE_MAGIC) ||
+	    (table->segment_count == 0U) ||
+	    (table->segment_count > STM32IMAGE_SPARSE_MAX_SEGMENTS) ||
+	    (table->expanded_length > length)) {
+		ERROR("%s: bad sparse table\n", __func__);
+		return -EINVAL;
+	}
+
+	result = io_open(backend_dev_handle, backend_image_spec,
+			 &backend_handle);
+	if (result != 0) {
+		ERROR("%s: io_open (%i)\n", __func__, result);
+		return result;
+	}
+
+	for (i = 0U; i < table->segment_count; i++) {
+		const struct stm32image_sparse_segment *seg =
+			&table->segment[i];
+		size_t chunk = round_up(seg->length, stm32image_dev.lba_size);
+		size_t bytes_read;
+
+		if ((seg->offset < end) ||
+		    ((seg->offset + seg->length) > table->expanded_length)) {
+			ERROR("%s: bad sparse segment %u\n", __func__, i);
+			result = -EINVAL;
+			goto out;
+		}
+
+		if (seg->offset > end) {
+			memset((uint8_t *)buffer + end, 0, seg->offset - end);
+		}
+
+		result = io_seek(backend_handle, IO_SEEK_SET,
+				 *stm32_img + packed_offset);
+		if (result != 0) {
+			ERROR("%s: io_seek (%i)\n", __func__, result);
+			goto out;
+		}
+
+		result = io_read(backend_handle, buffer + seg->offset,
+				 chunk, &bytes_read);
+		if (result != 0) {
+			ERROR("%s: io_read (%i)\n", __func__, result);
+			goto out;
+		}
+
+		packed_offset += chunk;
+		end = seg->offset + seg->length;
+	}
+
+	if (end < table->expanded_length) {
+		memset((uint8_t *)buffer + end, 0,
+		       table->expanded_length - end);
+	}
+
+	*length_read = table->expanded_length;
+
+out:
+	io_close(backend_handle);
+	return result;
+}
+
 /* Read data from a partition */
 static int stm32image_partition_read(io_entity_t *entity, uintptr_t buffer,
 				     size_t length, size_t *length_read)
@@ -241,6 +346,16 @@ static int stm32image_partition_read(io_entity_t *entity, uintptr_t buffer,
 	stm32mp_save_loaded_header(header);
 #endif
 
+	if ((header->load_address != 0U) && (header->load_address != buffer)) {
+		ERROR("Wrong load address\n");
+		panic();
+	}
+
+	if ((header->option_flags & STM32IMAGE_OPTION_SPARSE) != 0U) {
+		return stm32image_partition_read_sparse(buffer, length,
+							length_read);
+	}
+
 	/* Part of image already loaded with the header */
 	memcpy(local_buffer, (uint8_t *)first_lba_buffer +
 	       sizeof(boot_api_image_header_t),
@@ -253,11 +368,6 @@ static int stm32image_partition_read(io_entity_t *entity, uintptr_t buffer,
 					  sizeof(boot_api_image_header_t)),
 				stm32image_dev.lba_size);
 
-	if ((header->load_address != 0U) && (header->load_address != buffer)) {
-		ERROR("Wrong load address\n");
-		panic();
-	}
-
 	result = io_open(backend_dev_handle, backend_image_spec,
 			 &backend_handle);
 	if (result != 0) {
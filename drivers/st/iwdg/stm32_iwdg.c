@@ -56,6 +56,10 @@ struct stm32_iwdg_instance {
 
 static struct stm32_iwdg_instance stm32_iwdg[IWDG_MAX_INSTANCE];
 
+/* Cooperative checkpoint state, armed with stm32_iwdg_checkpoint_setup() */
+static uint64_t iwdg_checkpoint_expire;
+static uint32_t iwdg_checkpoint_period_ms;
+
 static int stm32_iwdg_get_dt_node(struct dt_node_info *info, int offset)
 {
 	int node;
@@ -193,6 +197,35 @@ void stm32_iwdg_refresh(void)
 	}
 }
 
+/*
+ * Arm the cooperative refresh checkpoint. Long operations then only need to
+ * call stm32_iwdg_checkpoint() from their inner loops: the watchdogs are
+ * refreshed at most once per period, so drivers can use maximum-size
+ * transfers instead of sizing loop chunks after the watchdog timeout.
+ * A zero period disables the checkpoint and turns it into a no-op.
+ */
+void stm32_iwdg_checkpoint_setup(uint32_t period_ms)
+{
+	iwdg_checkpoint_period_ms = period_ms;
+
+	if (period_ms != 0U) {
+		iwdg_checkpoint_expire = timeout_init_us(period_ms * 1000U);
+	}
+}
+
+void stm32_iwdg_checkpoint(void)
+{
+	if ((iwdg_checkpoint_period_ms == 0U) ||
+	    !timeout_elapsed(iwdg_checkpoint_expire)) {
+		return;
+	}
+
+	stm32_iwdg_refresh();
+
+	iwdg_checkpoint_expire =
+		timeout_init_us(iwdg_checkpoint_period_ms * 1000U);
+}
+
 int stm32_iwdg_init(void)
 {
 	int node = -1;
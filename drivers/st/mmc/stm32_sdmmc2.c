@@ -18,10 +18,15 @@
 #include <drivers/delay_timer.h>
 #include <drivers/mmc.h>
 #include <drivers/st/stm32_gpio.h>
+#include <drivers/st/stm32_iwdg.h>
 #include <drivers/st/stm32_sdmmc2.h>
 #include <drivers/st/stm32mp_reset.h>
+#include <drivers/st/stm32mp_wait_calib.h>
+#include <dt-bindings/clock/stm32mp1-clks.h>
+#include <dt-bindings/interrupt-controller/arm-gic.h>
 #include <lib/mmio.h>
 #include <lib/utils.h>
+#include <lib/xlat_tables/xlat_dma.h>
 #include <plat/common/platform.h>
 
 /* Registers offsets */
@@ -58,6 +63,8 @@
 #define SDMMC_CLKCR_WIDBUS_8		BIT(15)
 #define SDMMC_CLKCR_NEGEDGE		BIT(16)
 #define SDMMC_CLKCR_HWFC_EN		BIT(17)
+#define SDMMC_CLKCR_DDR			BIT(18)
+#define SDMMC_CLKCR_BUSSPEED		BIT(19)
 #define SDMMC_CLKCR_SELCLKRX_0		BIT(20)
 
 /* SDMMC command register */
@@ -93,6 +100,7 @@
 #define SDMMC_STAR_DATAEND		BIT(8)
 #define SDMMC_STAR_DBCKEND		BIT(10)
 #define SDMMC_STAR_DPSMACT		BIT(12)
+#define SDMMC_STAR_TXFIFOHE		BIT(14)
 #define SDMMC_STAR_RXFIFOHF		BIT(15)
 #define SDMMC_STAR_RXFIFOE		BIT(19)
 #define SDMMC_STAR_IDMATE		BIT(27)
@@ -100,6 +108,16 @@
 
 /* SDMMC DMA control register */
 #define SDMMC_IDMACTRLR_IDMAEN		BIT(0)
+#define SDMMC_IDMACTRLR_IDMABMODE	BIT(1)
+#define SDMMC_IDMACTRLR_IDMABACT	BIT(2)
+
+/* SDMMC DMA buffer size register */
+#define SDMMC_IDMABSIZER_BNDT		GENMASK(12, 5)
+#define SDMMC_IDMABSIZER_BNDT_SHIFT	5
+#define SDMMC_IDMA_BUF_GRANULE		32U
+#define SDMMC_IDMA_BUF_MAX_SIZE		((SDMMC_IDMABSIZER_BNDT >> \
+					  SDMMC_IDMABSIZER_BNDT_SHIFT) * \
+					 SDMMC_IDMA_BUF_GRANULE)
 
 #define SDMMC_STATIC_FLAGS		(SDMMC_STAR_CCRCFAIL | \
 					 SDMMC_STAR_DCRCFAIL | \
@@ -114,6 +132,29 @@
 					 SDMMC_STAR_IDMATE   | \
 					 SDMMC_STAR_IDMABTC)
 
+/* Delay block registers, mapped by the second SDMMC "reg" range */
+#define DLYB_CR				0x00U
+#define DLYB_CR_DEN			BIT(0)
+#define DLYB_CR_SEN			BIT(1)
+
+#define DLYB_CFGR			0x04U
+#define DLYB_CFGR_SEL			GENMASK(3, 0)
+#define DLYB_CFGR_SEL_SHIFT		0
+#define DLYB_CFGR_UNIT			GENMASK(14, 8)
+#define DLYB_CFGR_UNIT_SHIFT		8
+#define DLYB_CFGR_LNG			GENMASK(27, 16)
+#define DLYB_CFGR_LNG_SHIFT		16
+#define DLYB_CFGR_LNGF			BIT(31)
+
+#define DLYB_NB_DELAY			11U
+#define DLYB_SEL_MAX			(DLYB_NB_DELAY + 1U)
+#define DLYB_UNIT_MAX			127U
+#define DLYB_LNG_TIMEOUT_US		1000U
+
+/* CMD21 tuning block length, given by the bus width */
+#define SDMMC_TUNING_SIZE_4BIT		64U
+#define SDMMC_TUNING_SIZE_8BIT		128U
+
 #define TIMEOUT_US_10_MS		10000U
 #define TIMEOUT_US_1_S			1000000U
 
@@ -128,6 +169,55 @@
 
 #define DT_SDMMC2_COMPAT		"st,stm32-sdmmc2"
 
+/*
+ * Sleep in wfi() while waiting for command and data completion, with the
+ * awaited status bits unmasked onto the SDMMC interrupt line as the wake-up
+ * event, instead of spinning on SDMMC_STAR. Full rate polling keeps the core
+ * and its AHB port busy for the whole transfer; with STM32MP_BL2_SMP it also
+ * steals memory bandwidth from the jobs overlapped with the I/O. Every wait
+ * unmasks the controller error and hardware timeout flags, so the sleep is
+ * always bounded by the peripheral. Only the IDMA data path sleeps: the FIFO
+ * read path must keep polling to drain the FIFO.
+ */
+#ifndef STM32MP_SDMMC2_WFI_WAIT
+#define STM32MP_SDMMC2_WFI_WAIT		0
+#endif
+
+/*
+ * Adaptive bus clock ramping. The device tree "max-frequency" is sized for
+ * the worst board outlier, so most units leave bus margin unused. Starting
+ * from that safe rate, every ADAPTIVE_CLK_CONFIRM error-free data transfers
+ * step the clock divider one notch towards the specification ceiling of the
+ * selected mode; a data error at a boosted rate reverts to the last proven
+ * divider and records the failed one so it is not probed again. The proven
+ * divider is cached in a TAMP backup register and applied directly on the
+ * next boot. Tuned and DDR paths (HS200, DDR52) keep the device tree rate:
+ * a divider change would invalidate the sampling point found by tuning.
+ */
+#ifndef STM32MP_SDMMC_ADAPTIVE_CLK
+#define STM32MP_SDMMC_ADAPTIVE_CLK	0
+#endif
+
+#if STM32MP_SDMMC_ADAPTIVE_CLK
+/*
+ * Backup register layout:
+ *  [31:16] magic, tells a valid record from backup domain garbage
+ *  [15:8]  lowest divider that produced a data error (0xFF: none)
+ *  [7:0]   last proven divider
+ */
+#define ADAPTIVE_CLK_BKP_REG_ID		U(19)
+#define ADAPTIVE_CLK_MAGIC		U(0x5DC1)
+#define ADAPTIVE_CLK_MAGIC_MASK		GENMASK(31, 16)
+#define ADAPTIVE_CLK_MAGIC_SHIFT	U(16)
+#define ADAPTIVE_CLK_BAD_MASK		GENMASK(15, 8)
+#define ADAPTIVE_CLK_BAD_SHIFT		U(8)
+#define ADAPTIVE_CLK_GOOD_MASK		GENMASK(7, 0)
+#define ADAPTIVE_CLK_DIV_NONE		U(0xFF)
+
+/* Error-free data transfers before a divider is proven and probing resumes */
+#define ADAPTIVE_CLK_CONFIRM		8U
+#endif
+
 static void stm32_sdmmc2_init(void);
 static int stm32_sdmmc2_send_cmd_req(struct mmc_cmd *cmd);
 static int stm32_sdmmc2_send_cmd(struct mmc_cmd *cmd);
@@ -135,6 +225,16 @@ static int stm32_sdmmc2_set_ios(unsigned int clk, unsigned int width);
 static int stm32_sdmmc2_prepare(int lba, uintptr_t buf, size_t size);
 static int stm32_sdmmc2_read(int lba, uintptr_t buf, size_t size);
 static int stm32_sdmmc2_write(int lba, uintptr_t buf, size_t size);
+static int stm32_sdmmc2_prepare_wr(int lba, const uintptr_t buf, size_t size);
+static int stm32_sdmmc2_prepare_multi(int lba, const struct mmc_buf *bufs,
+				      unsigned int count);
+static int stm32_sdmmc2_prepare_wr_multi(int lba, const struct mmc_buf *bufs,
+					 unsigned int count);
+static int stm32_sdmmc2_write_multi(int lba, const struct mmc_buf *bufs,
+				    unsigned int count);
+static int stm32_sdmmc2_read_multi(int lba, const struct mmc_buf *bufs,
+				   unsigned int count);
+static int stm32_sdmmc2_execute_tuning(unsigned int clk, unsigned int width);
 
 static const struct mmc_ops stm32_sdmmc2_ops = {
 	.init		= stm32_sdmmc2_init,
@@ -143,12 +243,237 @@ static const struct mmc_ops stm32_sdmmc2_ops = {
 	.prepare	= stm32_sdmmc2_prepare,
 	.read		= stm32_sdmmc2_read,
 	.write		= stm32_sdmmc2_write,
+	.prepare_wr	= stm32_sdmmc2_prepare_wr,
+	.prepare_multi	= stm32_sdmmc2_prepare_multi,
+	.read_multi	= stm32_sdmmc2_read_multi,
+	.prepare_wr_multi = stm32_sdmmc2_prepare_wr_multi,
+	.write_multi	= stm32_sdmmc2_write_multi,
+	.execute_tuning	= stm32_sdmmc2_execute_tuning,
 };
 
 static struct stm32_sdmmc2_params sdmmc2_params;
 
 static bool next_cmd_is_acmd;
 
+/*
+ * State of a scatter list transfer in IDMA double buffer mode. While a
+ * transfer is in flight, the idle IDMA base register is reloaded with the
+ * next list element each time the controller raises IDMABTC, so the whole
+ * list is served by a single data command.
+ */
+static struct {
+	const struct mmc_buf *bufs;
+	unsigned int count;
+	unsigned int next;
+	bool active;
+} sdmmc2_multi;
+
+#if STM32MP_SDMMC_ADAPTIVE_CLK
+/*
+ * Clock ramp state for the current bus configuration. Dividers grow towards
+ * lower frequencies: safe_div is the device tree rate, floor_div the
+ * specification ceiling of the selected mode, and cur_div what the bus is
+ * running at now.
+ */
+static struct {
+	uint32_t safe_div;
+	uint32_t floor_div;
+	uint32_t cur_div;
+	uint32_t good_div;
+	uint32_t bad_div;
+	uint32_t bus_cfg;
+	unsigned int streak;
+	bool enabled;
+} sdmmc2_adapt;
+
+static void stm32_sdmmc2_adapt_store(void)
+{
+	uint32_t reg = (ADAPTIVE_CLK_MAGIC << ADAPTIVE_CLK_MAGIC_SHIFT) |
+		       ((MIN(sdmmc2_adapt.bad_div, ADAPTIVE_CLK_DIV_NONE) <<
+			 ADAPTIVE_CLK_BAD_SHIFT) & ADAPTIVE_CLK_BAD_MASK) |
+		       (MIN(sdmmc2_adapt.good_div, ADAPTIVE_CLK_DIV_NONE) &
+			ADAPTIVE_CLK_GOOD_MASK);
+
+	stm32mp_clk_enable(RTCAPB);
+	mmio_write_32(tamp_bkpr(ADAPTIVE_CLK_BKP_REG_ID), reg);
+	stm32mp_clk_disable(RTCAPB);
+}
+
+static void stm32_sdmmc2_adapt_program(void)
+{
+	mmio_write_32(sdmmc2_params.reg_base + SDMMC_CLKCR,
+		      SDMMC_CLKCR_HWFC_EN | sdmmc2_adapt.cur_div |
+		      sdmmc2_adapt.bus_cfg |
+		      sdmmc2_params.negedge |
+		      sdmmc2_params.pin_ckin);
+}
+
+/*
+ * Pick the divider to program for a new bus configuration: the cached proven
+ * divider when the backup domain holds a valid record, the safe divider
+ * otherwise. Ramping stays off for tuned and DDR modes and when the device
+ * tree rate already sits at the specification ceiling.
+ */
+static uint32_t stm32_sdmmc2_adapt_setup(uint32_t safe_div, uint32_t floor_div,
+					 uint32_t bus_cfg)
+{
+	uint32_t reg;
+
+	sdmmc2_adapt.safe_div = safe_div;
+	sdmmc2_adapt.floor_div = floor_div;
+	sdmmc2_adapt.bus_cfg = bus_cfg;
+	sdmmc2_adapt.streak = 0U;
+	sdmmc2_adapt.enabled =
+		((bus_cfg & (SDMMC_CLKCR_DDR | SDMMC_CLKCR_BUSSPEED)) == 0U) &&
+		(safe_div > floor_div);
+
+	if (!sdmmc2_adapt.enabled) {
+		sdmmc2_adapt.cur_div = safe_div;
+		return safe_div;
+	}
+
+	stm32mp_clk_enable(RTCAPB);
+	reg = mmio_read_32(tamp_bkpr(ADAPTIVE_CLK_BKP_REG_ID));
+	stm32mp_clk_disable(RTCAPB);
+
+	if (((reg & ADAPTIVE_CLK_MAGIC_MASK) >> ADAPTIVE_CLK_MAGIC_SHIFT) ==
+	    ADAPTIVE_CLK_MAGIC) {
+		uint32_t good = reg & ADAPTIVE_CLK_GOOD_MASK;
+
+		/* The record may predate a clock tree or mode change */
+		sdmmc2_adapt.good_div = MAX(MIN(good, safe_div), floor_div);
+		sdmmc2_adapt.bad_div = (reg & ADAPTIVE_CLK_BAD_MASK) >>
+				       ADAPTIVE_CLK_BAD_SHIFT;
+	} else {
+		sdmmc2_adapt.good_div = safe_div;
+		sdmmc2_adapt.bad_div = ADAPTIVE_CLK_DIV_NONE;
+		stm32_sdmmc2_adapt_store();
+	}
+
+	sdmmc2_adapt.cur_div = sdmmc2_adapt.good_div;
+
+	if (sdmmc2_adapt.cur_div < safe_div) {
+		INFO("SDMMC clock divider %u cached, DT divider %u\n",
+		     sdmmc2_adapt.cur_div, safe_div);
+	}
+
+	return sdmmc2_adapt.cur_div;
+}
+
+/*
+ * An error-free data transfer: once the running divider has accumulated a
+ * full confirmation streak it becomes the proven one, and the next notch is
+ * probed unless it is the specification ceiling or failed before.
+ */
+static void stm32_sdmmc2_adapt_success(void)
+{
+	uint32_t next;
+
+	if (!sdmmc2_adapt.enabled) {
+		return;
+	}
+
+	sdmmc2_adapt.streak++;
+	if (sdmmc2_adapt.streak < ADAPTIVE_CLK_CONFIRM) {
+		return;
+	}
+
+	sdmmc2_adapt.streak = 0U;
+
+	if (sdmmc2_adapt.cur_div < sdmmc2_adapt.good_div) {
+		sdmmc2_adapt.good_div = sdmmc2_adapt.cur_div;
+		stm32_sdmmc2_adapt_store();
+	}
+
+	next = sdmmc2_adapt.cur_div - 1U;
+	if ((sdmmc2_adapt.cur_div > sdmmc2_adapt.floor_div) &&
+	    (next != sdmmc2_adapt.bad_div)) {
+		sdmmc2_adapt.cur_div = next;
+		stm32_sdmmc2_adapt_program();
+	}
+}
+
+/*
+ * A data error while boosted: revert to one notch below the failing divider
+ * before the framework retries the command, and blacklist the failed notch
+ * so neither this boot nor the next one probes it again.
+ */
+static void stm32_sdmmc2_adapt_failure(void)
+{
+	if (!sdmmc2_adapt.enabled ||
+	    (sdmmc2_adapt.cur_div >= sdmmc2_adapt.safe_div)) {
+		return;
+	}
+
+	WARN("SDMMC data error at clock divider %u, falling back to %u\n",
+	     sdmmc2_adapt.cur_div, sdmmc2_adapt.cur_div + 1U);
+
+	sdmmc2_adapt.bad_div = sdmmc2_adapt.cur_div;
+	sdmmc2_adapt.cur_div = MIN(sdmmc2_adapt.cur_div + 1U,
+				   sdmmc2_adapt.safe_div);
+	sdmmc2_adapt.good_div = MAX(sdmmc2_adapt.good_div,
+				    sdmmc2_adapt.cur_div);
+	sdmmc2_adapt.streak = 0U;
+
+	stm32_sdmmc2_adapt_program();
+	stm32_sdmmc2_adapt_store();
+}
+#else
+static uint32_t stm32_sdmmc2_adapt_setup(uint32_t safe_div, uint32_t floor_div,
+					 uint32_t bus_cfg)
+{
+	return safe_div;
+}
+
+static void stm32_sdmmc2_adapt_success(void)
+{
+}
+
+static void stm32_sdmmc2_adapt_failure(void)
+{
+}
+#endif
+
+#if STM32MP_SDMMC2_WFI_WAIT
+/* GIC interrupt ID of the instance, MIN_SPI_ID based, 0 when not known */
+static uint32_t sdmmc2_irq_id;
+
+static void stm32_sdmmc2_wait_arm(uint32_t flags)
+{
+	if (sdmmc2_irq_id != 0U) {
+		mmio_write_32(sdmmc2_params.reg_base + SDMMC_MASKR, flags);
+		stm32mp_wfi_wake_enable(sdmmc2_irq_id);
+	}
+}
+
+static void stm32_sdmmc2_wait_relax(void)
+{
+	if (sdmmc2_irq_id != 0U) {
+		wfi();
+	}
+}
+
+static void stm32_sdmmc2_wait_disarm(void)
+{
+	if (sdmmc2_irq_id != 0U) {
+		stm32mp_wfi_wake_disable(sdmmc2_irq_id);
+		mmio_write_32(sdmmc2_params.reg_base + SDMMC_MASKR, 0U);
+	}
+}
+#else
+static void stm32_sdmmc2_wait_arm(uint32_t flags)
+{
+}
+
+static void stm32_sdmmc2_wait_relax(void)
+{
+}
+
+static void stm32_sdmmc2_wait_disarm(void)
+{
+}
+#endif
+
 #pragma weak plat_sdmmc2_use_dma
 bool plat_sdmmc2_use_dma(unsigned int instance, unsigned int memory)
 {
@@ -218,6 +543,34 @@ static void stm32_sdmmc2_init(void)
 	mdelay(POWER_ON_DELAY);
 }
 
+/*
+ * Service the IDMA double buffer swap during a scatter list transfer:
+ * whenever a buffer completes (IDMABTC), hand the released base register
+ * the next list element so that the hardware never stalls.
+ */
+static void stm32_sdmmc2_idma_reload(uint32_t status)
+{
+	uintptr_t base = sdmmc2_params.reg_base;
+
+	if (!sdmmc2_multi.active || ((status & SDMMC_STAR_IDMABTC) == 0U)) {
+		return;
+	}
+
+	mmio_write_32(base + SDMMC_ICR, SDMMC_STAR_IDMABTC);
+
+	if (sdmmc2_multi.next < sdmmc2_multi.count) {
+		uintptr_t next_buf = sdmmc2_multi.bufs[sdmmc2_multi.next].buf;
+
+		if ((mmio_read_32(base + SDMMC_IDMACTRLR) &
+		     SDMMC_IDMACTRLR_IDMABACT) != 0U) {
+			mmio_write_32(base + SDMMC_IDMABASE0R, next_buf);
+		} else {
+			mmio_write_32(base + SDMMC_IDMABASE1R, next_buf);
+		}
+		sdmmc2_multi.next++;
+	}
+}
+
 static int stm32_sdmmc2_stop_transfer(void)
 {
 	struct mmc_cmd cmd_stop;
@@ -297,6 +650,7 @@ static int stm32_sdmmc2_send_cmd_req(struct mmc_cmd *cmd)
 		break;
 	case MMC_CMD(17):
 	case MMC_CMD(18):
+	case MMC_CMD(21):
 		cmd_reg |= SDMMC_CMDR_CMDTRANS;
 		if (sdmmc2_params.use_dma) {
 			flags_data |= SDMMC_STAR_DCRCFAIL |
@@ -306,6 +660,17 @@ static int stm32_sdmmc2_send_cmd_req(struct mmc_cmd *cmd)
 				      SDMMC_STAR_IDMATE;
 		}
 		break;
+	case MMC_CMD(24):
+	case MMC_CMD(25):
+		cmd_reg |= SDMMC_CMDR_CMDTRANS;
+		if (sdmmc2_params.use_dma) {
+			flags_data |= SDMMC_STAR_DCRCFAIL |
+				      SDMMC_STAR_DTIMEOUT |
+				      SDMMC_STAR_DATAEND |
+				      SDMMC_STAR_TXUNDERR |
+				      SDMMC_STAR_IDMATE;
+		}
+		break;
 	case MMC_ACMD(41):
 		arg_reg |= OCR_3_2_3_3 | OCR_3_3_3_4;
 		break;
@@ -349,6 +714,9 @@ static int stm32_sdmmc2_send_cmd_req(struct mmc_cmd *cmd)
 
 	timeout = timeout_init_us(TIMEOUT_US_10_MS);
 
+	/* CTIMEOUT in flags_cmd guarantees a hardware bounded sleep */
+	stm32_sdmmc2_wait_arm(flags_cmd);
+
 	while ((status & flags_cmd) == 0U) {
 		if (timeout_elapsed(timeout)) {
 			err = -ETIMEDOUT;
@@ -357,19 +725,24 @@ static int stm32_sdmmc2_send_cmd_req(struct mmc_cmd *cmd)
 			goto err_exit;
 		}
 
+		stm32_sdmmc2_wait_relax();
+
 		status = mmio_read_32(base + SDMMC_STAR);
 	}
 
+	stm32_sdmmc2_wait_disarm();
+
 	if ((status & (SDMMC_STAR_CTIMEOUT | SDMMC_STAR_CCRCFAIL)) != 0U) {
 		if ((status & SDMMC_STAR_CTIMEOUT) != 0U) {
 			err = -ETIMEDOUT;
 			/*
 			 * Those timeouts can occur, and framework will handle
 			 * the retries. CMD8 is expected to return this timeout
-			 * for eMMC
+			 * for eMMC, and CMD21 fails on untuned sampling points.
 			 */
 			if (!((cmd->cmd_idx == MMC_CMD(1)) ||
 			      (cmd->cmd_idx == MMC_CMD(13)) ||
+			      (cmd->cmd_idx == MMC_CMD(21)) ||
 			      ((cmd->cmd_idx == MMC_CMD(8)) &&
 			       (cmd->resp_type == MMC_RESPONSE_R7)))) {
 				ERROR("%s: CTIMEOUT (cmd = %d,status = %x)\n",
@@ -377,8 +750,10 @@ static int stm32_sdmmc2_send_cmd_req(struct mmc_cmd *cmd)
 			}
 		} else {
 			err = -EIO;
-			ERROR("%s: CRCFAIL (cmd = %d,status = %x)\n",
-			      __func__, cmd->cmd_idx, status);
+			if (cmd->cmd_idx != MMC_CMD(21)) {
+				ERROR("%s: CRCFAIL (cmd = %d,status = %x)\n",
+				      __func__, cmd->cmd_idx, status);
+			}
 		}
 
 		goto err_exit;
@@ -414,16 +789,30 @@ static int stm32_sdmmc2_send_cmd_req(struct mmc_cmd *cmd)
 
 	status = mmio_read_32(base + SDMMC_STAR);
 
-	timeout = timeout_init_us(TIMEOUT_US_10_MS);
+	/*
+	 * A scatter list transfer moves the whole list with this single
+	 * command, so it needs more than the single-chunk data timeout.
+	 */
+	timeout = timeout_init_us(sdmmc2_multi.active ?
+				  TIMEOUT_US_1_S : TIMEOUT_US_10_MS);
+
+	/* IDMABTC wakes the double buffer reload of scatter list transfers */
+	stm32_sdmmc2_wait_arm(flags_data | SDMMC_STAR_IDMABTC);
 
 	while ((status & flags_data) == 0U) {
 		if (timeout_elapsed(timeout)) {
-			ERROR("%s: timeout 10ms (cmd = %d,status = %x)\n",
+			ERROR("%s: data timeout (cmd = %d,status = %x)\n",
 			      __func__, cmd->cmd_idx, status);
 			err = -ETIMEDOUT;
 			goto err_exit;
 		}
 
+		stm32_sdmmc2_wait_relax();
+
+		stm32_iwdg_checkpoint();
+
+		stm32_sdmmc2_idma_reload(status);
+
 		status = mmio_read_32(base + SDMMC_STAR);
 	};
 
@@ -436,9 +825,15 @@ static int stm32_sdmmc2_send_cmd_req(struct mmc_cmd *cmd)
 	}
 
 err_exit:
+	stm32_sdmmc2_wait_disarm();
 	mmio_write_32(base + SDMMC_ICR, SDMMC_STATIC_FLAGS);
 	mmio_clrbits_32(base + SDMMC_CMDR, SDMMC_CMDR_CMDTRANS);
 
+	if (err != 0) {
+		/* Abandon any scatter list transfer in flight */
+		sdmmc2_multi.active = false;
+	}
+
 	if ((err != 0) && ((status & SDMMC_STAR_DPSMACT) != 0U)) {
 		int ret_stop = stm32_sdmmc2_stop_transfer();
 
@@ -450,16 +845,39 @@ err_exit:
 	return err;
 }
 
+/*
+ * Cumulative count of retried command attempts. A healthy medium keeps it
+ * at zero; a degraded card shows up as a growing count rather than as an
+ * unexplained slow boot. Exported so the boot stage can attribute retries
+ * to the image being loaded. Expected failures (CMD8 probing on eMMC,
+ * retries the framework manages itself) are not counted.
+ */
+static unsigned int cmd_retries;
+
+unsigned int stm32_sdmmc2_get_retry_count(void)
+{
+	return cmd_retries;
+}
+
 static int stm32_sdmmc2_send_cmd(struct mmc_cmd *cmd)
 {
 	int8_t retry;
 	int err = 0;
+	bool data_cmd;
 
 	assert(cmd != NULL);
 
+	data_cmd = (cmd->cmd_idx == MMC_CMD(17)) ||
+		   (cmd->cmd_idx == MMC_CMD(18)) ||
+		   (cmd->cmd_idx == MMC_CMD(24)) ||
+		   (cmd->cmd_idx == MMC_CMD(25));
+
 	for (retry = 0U; retry < 3U; retry++) {
 		err = stm32_sdmmc2_send_cmd_req(cmd);
 		if (err == 0) {
+			if (data_cmd) {
+				stm32_sdmmc2_adapt_success();
+			}
 			return 0;
 		}
 
@@ -468,8 +886,14 @@ static int stm32_sdmmc2_send_cmd(struct mmc_cmd *cmd)
 			return 0; /* Retry managed by framework */
 		}
 
+		/* Retry a failed boosted transfer at the reverted rate */
+		if (data_cmd) {
+			stm32_sdmmc2_adapt_failure();
+		}
+
 		/* Command 8 is expected to fail for eMMC */
 		if (!(cmd->cmd_idx == MMC_CMD(8))) {
+			cmd_retries++;
 			WARN(" CMD%u, Retry: %u, Error: %d\n",
 			     cmd->cmd_idx, retry + 1U, err);
 		}
@@ -497,13 +921,24 @@ static int stm32_sdmmc2_set_ios(unsigned int clk, unsigned int width)
 	case MMC_BUS_WIDTH_8:
 		bus_cfg |= SDMMC_CLKCR_WIDBUS_8;
 		break;
+	case MMC_BUS_WIDTH_DDR_4:
+		bus_cfg |= SDMMC_CLKCR_WIDBUS_4 | SDMMC_CLKCR_DDR |
+			   SDMMC_CLKCR_BUSSPEED;
+		break;
+	case MMC_BUS_WIDTH_DDR_8:
+		bus_cfg |= SDMMC_CLKCR_WIDBUS_8 | SDMMC_CLKCR_DDR |
+			   SDMMC_CLKCR_BUSSPEED;
+		break;
 	default:
 		panic();
 		break;
 	}
 
 	if (sdmmc2_params.device_info->mmc_dev_type == MMC_IS_EMMC) {
-		if (max_bus_freq >= 52000000U) {
+		if (max_bus_freq >= 200000000U) {
+			max_freq = STM32MP_EMMC_HS200_MAX_FREQ;
+			bus_cfg |= SDMMC_CLKCR_BUSSPEED;
+		} else if (max_bus_freq >= 52000000U) {
 			max_freq = STM32MP_EMMC_HIGH_SPEED_MAX_FREQ;
 		} else {
 			max_freq = STM32MP_EMMC_NORMAL_SPEED_MAX_FREQ;
@@ -524,6 +959,16 @@ static int stm32_sdmmc2_set_ios(unsigned int clk, unsigned int width)
 
 	clock_div = div_round_up(clk_rate, freq * 2U);
 
+	if (((bus_cfg & SDMMC_CLKCR_DDR) != 0U) && (clock_div == 0U)) {
+		/* DDR mode is not allowed with the clock divider bypassed */
+		clock_div = 1U;
+	}
+
+	clock_div = stm32_sdmmc2_adapt_setup(clock_div,
+					     div_round_up(clk_rate,
+							  max_freq * 2U),
+					     bus_cfg);
+
 	mmio_write_32(base + SDMMC_CLKCR,
 		      SDMMC_CLKCR_HWFC_EN | clock_div | bus_cfg |
 		      sdmmc2_params.negedge |
@@ -532,6 +977,170 @@ static int stm32_sdmmc2_set_ios(unsigned int clk, unsigned int width)
 	return 0;
 }
 
+static void stm32_sdmmc2_dlyb_set(uint32_t unit, uint32_t sel, bool sampler)
+{
+	uintptr_t dlyb = sdmmc2_params.dlyb_base;
+
+	mmio_write_32(dlyb + DLYB_CR, DLYB_CR_DEN | DLYB_CR_SEN);
+	mmio_write_32(dlyb + DLYB_CFGR,
+		      (unit << DLYB_CFGR_UNIT_SHIFT) |
+		      (sel << DLYB_CFGR_SEL_SHIFT));
+
+	if (!sampler) {
+		mmio_write_32(dlyb + DLYB_CR, DLYB_CR_DEN);
+	}
+}
+
+/*
+ * Find the delay unit whose output covers one clock period, so that the
+ * SEL taps swept by the phase tuning below span a full period.
+ */
+static int stm32_sdmmc2_dlyb_length_tuning(uint32_t *unit, uint32_t *max_sel)
+{
+	uintptr_t dlyb = sdmmc2_params.dlyb_base;
+	uint32_t u, lng;
+	uint64_t timeout;
+
+	for (u = 0U; u <= DLYB_UNIT_MAX; u++) {
+		stm32_sdmmc2_dlyb_set(u, DLYB_SEL_MAX, true);
+
+		timeout = timeout_init_us(DLYB_LNG_TIMEOUT_US);
+		while ((mmio_read_32(dlyb + DLYB_CFGR) &
+			DLYB_CFGR_LNGF) == 0U) {
+			if (timeout_elapsed(timeout)) {
+				return -ETIMEDOUT;
+			}
+		}
+
+		lng = (mmio_read_32(dlyb + DLYB_CFGR) & DLYB_CFGR_LNG) >>
+		      DLYB_CFGR_LNG_SHIFT;
+		if ((lng != 0U) && (lng < BIT(DLYB_NB_DELAY))) {
+			*unit = u;
+			/* Highest delay line output still within the period */
+			*max_sel = 31U - (uint32_t)__builtin_clz(lng);
+			return 0;
+		}
+	}
+
+	return -EINVAL;
+}
+
+/* Read and discard one CMD21 tuning block through the FIFO */
+static int stm32_sdmmc2_send_tuning_block(size_t size)
+{
+	uintptr_t base = sdmmc2_params.reg_base;
+	struct mmc_cmd cmd;
+	uint32_t status;
+	uint64_t timeout;
+	int ret;
+
+	mmio_write_32(base + SDMMC_DTIMER, UINT32_MAX);
+	mmio_write_32(base + SDMMC_DLENR, size);
+	mmio_clrsetbits_32(base + SDMMC_DCTRLR, SDMMC_DCTRLR_CLEAR_MASK,
+			   SDMMC_DCTRLR_DTDIR |
+			   ((uint32_t)__builtin_ctz(size) <<
+			    SDMMC_DCTRLR_DBLOCKSIZE_SHIFT));
+
+	zeromem(&cmd, sizeof(struct mmc_cmd));
+
+	cmd.cmd_idx = MMC_CMD(21);
+	cmd.resp_type = MMC_RESPONSE_R1;
+
+	ret = stm32_sdmmc2_send_cmd_req(&cmd);
+	if (ret != 0) {
+		return ret;
+	}
+
+	timeout = timeout_init_us(TIMEOUT_US_10_MS);
+	do {
+		status = mmio_read_32(base + SDMMC_STAR);
+
+		if ((status & (SDMMC_STAR_DCRCFAIL | SDMMC_STAR_DTIMEOUT |
+			       SDMMC_STAR_RXOVERR)) != 0U) {
+			ret = -EIO;
+			break;
+		}
+
+		if (timeout_elapsed(timeout)) {
+			ret = -ETIMEDOUT;
+			break;
+		}
+
+		if ((status & SDMMC_STAR_RXFIFOE) == 0U) {
+			(void)mmio_read_32(base + SDMMC_FIFOR);
+		}
+	} while ((status & SDMMC_STAR_DATAEND) == 0U);
+
+	if (ret != 0) {
+		mmio_write_32(base + SDMMC_DCTRLR, SDMMC_DCTRLR_FIFORST);
+	}
+
+	mmio_write_32(base + SDMMC_ICR, SDMMC_STATIC_FLAGS);
+
+	if ((ret != 0) && ((status & SDMMC_STAR_DPSMACT) != 0U)) {
+		(void)stm32_sdmmc2_stop_transfer();
+	}
+
+	return ret;
+}
+
+static int stm32_sdmmc2_execute_tuning(unsigned int clk, unsigned int width)
+{
+	uint32_t unit = 0U;
+	uint32_t max_sel = 0U;
+	uint32_t sel;
+	uint32_t cur_len = 0U;
+	uint32_t max_len = 0U;
+	uint32_t end_of_len = 0U;
+	size_t size;
+	int ret;
+
+	if (sdmmc2_params.dlyb_base == 0U) {
+		return -ENOTSUP;
+	}
+
+	if (width == MMC_BUS_WIDTH_8) {
+		size = SDMMC_TUNING_SIZE_8BIT;
+	} else {
+		size = SDMMC_TUNING_SIZE_4BIT;
+	}
+
+	ret = stm32_sdmmc2_dlyb_length_tuning(&unit, &max_sel);
+	if (ret != 0) {
+		mmio_write_32(sdmmc2_params.dlyb_base + DLYB_CR, 0U);
+		return ret;
+	}
+
+	/* Sweep the phases and keep the middle of the longest valid window */
+	for (sel = 0U; sel <= max_sel; sel++) {
+		stm32_sdmmc2_dlyb_set(unit, sel, false);
+
+		if (stm32_sdmmc2_send_tuning_block(size) != 0) {
+			cur_len = 0U;
+			continue;
+		}
+
+		cur_len++;
+		if (cur_len > max_len) {
+			max_len = cur_len;
+			end_of_len = sel;
+		}
+	}
+
+	if (max_len == 0U) {
+		mmio_write_32(sdmmc2_params.dlyb_base + DLYB_CR, 0U);
+		return -EIO;
+	}
+
+	sel = end_of_len - (max_len / 2U);
+	stm32_sdmmc2_dlyb_set(unit, sel, false);
+
+	VERBOSE("%s: unit %u phase %u (window %u)\n",
+		__func__, unit, sel, max_len);
+
+	return 0;
+}
+
 static int stm32_sdmmc2_prepare(int lba, uintptr_t buf, size_t size)
 {
 	struct mmc_cmd cmd;
@@ -550,10 +1159,6 @@ static int stm32_sdmmc2_prepare(int lba, uintptr_t buf, size_t size)
 
 	sdmmc2_params.use_dma = plat_sdmmc2_use_dma(base, buf);
 
-	if (sdmmc2_params.use_dma) {
-		inv_dcache_range(buf, size);
-	}
-
 	/* Prepare CMD 16*/
 	mmio_write_32(base + SDMMC_DTIMER, 0);
 
@@ -583,7 +1188,7 @@ static int stm32_sdmmc2_prepare(int lba, uintptr_t buf, size_t size)
 			      SDMMC_IDMACTRLR_IDMAEN);
 		mmio_write_32(base + SDMMC_IDMABASE0R, buf);
 
-		flush_dcache_range(buf, size);
+		xlat_dma_prepare(buf, size, XLAT_DMA_FROM_DEVICE);
 	}
 
 	data_ctrl |= __builtin_ctz(arg_size) << SDMMC_DCTRLR_DBLOCKSIZE_SHIFT;
@@ -613,7 +1218,7 @@ static int stm32_sdmmc2_read(int lba, uintptr_t buf, size_t size)
 	buffer = (uint32_t *)buf;
 
 	if (sdmmc2_params.use_dma) {
-		inv_dcache_range(buf, size);
+		xlat_dma_complete(buf, size, XLAT_DMA_FROM_DEVICE);
 
 		return 0;
 	}
@@ -660,6 +1265,8 @@ static int stm32_sdmmc2_read(int lba, uintptr_t buf, size_t size)
 			return -ETIMEDOUT;
 		}
 
+		stm32_iwdg_checkpoint();
+
 		if (size < (8U * sizeof(uint32_t))) {
 			if ((mmio_read_32(base + SDMMC_DCNTR) > 0U) &&
 			    ((status & SDMMC_STAR_RXFIFOE) == 0U)) {
@@ -687,14 +1294,395 @@ static int stm32_sdmmc2_read(int lba, uintptr_t buf, size_t size)
 	return 0;
 }
 
+static int stm32_sdmmc2_prepare_wr(int lba, const uintptr_t buf, size_t size)
+{
+	struct mmc_cmd cmd;
+	int ret;
+	uintptr_t base = sdmmc2_params.reg_base;
+	uint32_t data_ctrl = 0U;
+	uint32_t arg_size;
+
+	assert(size != 0U);
+
+	if (size > MMC_BLOCK_SIZE) {
+		arg_size = MMC_BLOCK_SIZE;
+	} else {
+		arg_size = size;
+	}
+
+	sdmmc2_params.use_dma = plat_sdmmc2_use_dma(base, buf);
+
+	/* Prepare CMD 16*/
+	mmio_write_32(base + SDMMC_DTIMER, 0);
+
+	mmio_write_32(base + SDMMC_DLENR, 0);
+
+	mmio_write_32(base + SDMMC_DCTRLR, 0);
+
+	zeromem(&cmd, sizeof(struct mmc_cmd));
+
+	cmd.cmd_idx = MMC_CMD(16);
+	cmd.cmd_arg = arg_size;
+	cmd.resp_type = MMC_RESPONSE_R1;
+
+	ret = stm32_sdmmc2_send_cmd(&cmd);
+	if (ret != 0) {
+		ERROR("CMD16 failed\n");
+		return ret;
+	}
+
+	/* Prepare data command */
+	mmio_write_32(base + SDMMC_DTIMER, UINT32_MAX);
+
+	mmio_write_32(base + SDMMC_DLENR, size);
+
+	if (sdmmc2_params.use_dma) {
+		mmio_write_32(base + SDMMC_IDMACTRLR,
+			      SDMMC_IDMACTRLR_IDMAEN);
+		mmio_write_32(base + SDMMC_IDMABASE0R, buf);
+
+		xlat_dma_prepare(buf, size, XLAT_DMA_TO_DEVICE);
+	}
+
+	data_ctrl |= __builtin_ctz(arg_size) << SDMMC_DCTRLR_DBLOCKSIZE_SHIFT;
+
+	mmio_clrsetbits_32(base + SDMMC_DCTRLR,
+			   SDMMC_DCTRLR_CLEAR_MASK,
+			   data_ctrl);
+
+	return 0;
+}
+
+static int stm32_sdmmc2_prepare_multi(int lba, const struct mmc_buf *bufs,
+				      unsigned int count)
+{
+	struct mmc_cmd cmd;
+	int ret;
+	uintptr_t base = sdmmc2_params.reg_base;
+	uint32_t data_ctrl = SDMMC_DCTRLR_DTDIR;
+	size_t buf_size = bufs[0].size;
+	size_t total = 0U;
+	unsigned int i;
+
+	assert(count != 0U);
+
+	if (count == 1U) {
+		/* Single buffer mode handles any contiguous transfer */
+		sdmmc2_multi.active = false;
+		return stm32_sdmmc2_prepare(lba, bufs[0].buf, bufs[0].size);
+	}
+
+	/*
+	 * Double buffer mode constraints: all elements must be IDMA capable,
+	 * word aligned, and all but the last must share a common size which
+	 * is a granule multiple small enough for the IDMABSIZER field.
+	 */
+	if (((buf_size % SDMMC_IDMA_BUF_GRANULE) != 0U) ||
+	    (buf_size > SDMMC_IDMA_BUF_MAX_SIZE) ||
+	    (bufs[count - 1U].size > buf_size)) {
+		return -EOPNOTSUPP;
+	}
+
+	for (i = 0U; i < count; i++) {
+		if (((bufs[i].buf & GENMASK(1, 0)) != 0U) ||
+		    !plat_sdmmc2_use_dma(base, bufs[i].buf)) {
+			return -EOPNOTSUPP;
+		}
+
+		if ((i < (count - 1U)) && (bufs[i].size != buf_size)) {
+			return -EOPNOTSUPP;
+		}
+
+		total += bufs[i].size;
+		xlat_dma_prepare(bufs[i].buf, bufs[i].size,
+				 XLAT_DMA_FROM_DEVICE);
+	}
+
+	sdmmc2_params.use_dma = true;
+
+	/* Prepare CMD 16*/
+	mmio_write_32(base + SDMMC_DTIMER, 0);
+
+	mmio_write_32(base + SDMMC_DLENR, 0);
+
+	mmio_write_32(base + SDMMC_DCTRLR, 0);
+
+	zeromem(&cmd, sizeof(struct mmc_cmd));
+
+	cmd.cmd_idx = MMC_CMD(16);
+	cmd.cmd_arg = MMC_BLOCK_SIZE;
+	cmd.resp_type = MMC_RESPONSE_R1;
+
+	ret = stm32_sdmmc2_send_cmd(&cmd);
+	if (ret != 0) {
+		ERROR("CMD16 failed\n");
+		return ret;
+	}
+
+	/* Prepare data command */
+	mmio_write_32(base + SDMMC_DTIMER, UINT32_MAX);
+
+	mmio_write_32(base + SDMMC_DLENR, total);
+
+	mmio_write_32(base + SDMMC_IDMABSIZER,
+		      (buf_size / SDMMC_IDMA_BUF_GRANULE) <<
+		      SDMMC_IDMABSIZER_BNDT_SHIFT);
+	mmio_write_32(base + SDMMC_IDMABASE0R, bufs[0].buf);
+	mmio_write_32(base + SDMMC_IDMABASE1R, bufs[1].buf);
+	mmio_write_32(base + SDMMC_IDMACTRLR,
+		      SDMMC_IDMACTRLR_IDMAEN | SDMMC_IDMACTRLR_IDMABMODE);
+
+	data_ctrl |= __builtin_ctz(MMC_BLOCK_SIZE) <<
+		     SDMMC_DCTRLR_DBLOCKSIZE_SHIFT;
+
+	mmio_clrsetbits_32(base + SDMMC_DCTRLR,
+			   SDMMC_DCTRLR_CLEAR_MASK,
+			   data_ctrl);
+
+	sdmmc2_multi.bufs = bufs;
+	sdmmc2_multi.count = count;
+	sdmmc2_multi.next = 2U;
+	sdmmc2_multi.active = true;
+
+	return 0;
+}
+
+static int stm32_sdmmc2_read_multi(int lba, const struct mmc_buf *bufs,
+				   unsigned int count)
+{
+	uintptr_t base = sdmmc2_params.reg_base;
+	unsigned int i;
+
+	if (!sdmmc2_multi.active) {
+		return stm32_sdmmc2_read(lba, bufs[0].buf, bufs[0].size);
+	}
+
+	/*
+	 * The whole list has been transferred while the data command
+	 * completion was polled, the idle IDMA buffer being reloaded on
+	 * each IDMABTC. Only cache maintenance is left to do here.
+	 */
+	sdmmc2_multi.active = false;
+	mmio_write_32(base + SDMMC_IDMACTRLR, 0U);
+
+	for (i = 0U; i < count; i++) {
+		xlat_dma_complete(bufs[i].buf, bufs[i].size,
+				  XLAT_DMA_FROM_DEVICE);
+	}
+
+	return 0;
+}
+
 static int stm32_sdmmc2_write(int lba, uintptr_t buf, size_t size)
 {
+	uint32_t error_flags = SDMMC_STAR_TXUNDERR | SDMMC_STAR_DCRCFAIL |
+			       SDMMC_STAR_DTIMEOUT;
+	uint32_t flags = error_flags | SDMMC_STAR_DATAEND;
+	uint32_t status;
+	uint32_t *buffer;
+	uintptr_t base = sdmmc2_params.reg_base;
+	uintptr_t fifo_reg = base + SDMMC_FIFOR;
+	uint64_t timeout;
+	size_t remaining = size;
+	int ret;
+
+	/* Assert buf is 4 bytes aligned */
+	assert((buf & GENMASK(1, 0)) == 0U);
+
+	buffer = (uint32_t *)buf;
+
+	if (sdmmc2_params.use_dma) {
+		/* The IDMA transfer completes with the data command */
+		return 0;
+	}
+
+	if (size <= MMC_BLOCK_SIZE) {
+		flags |= SDMMC_STAR_DBCKEND;
+	}
+
+	timeout = timeout_init_us(TIMEOUT_US_1_S);
+
+	do {
+		status = mmio_read_32(base + SDMMC_STAR);
+
+		if ((status & error_flags) != 0U) {
+			ERROR("%s: Write error (status = %x)\n", __func__,
+			      status);
+			dump_registers();
+			mmio_write_32(base + SDMMC_DCTRLR,
+				      SDMMC_DCTRLR_FIFORST);
+
+			mmio_write_32(base + SDMMC_ICR,
+				      SDMMC_STATIC_FLAGS);
+
+			ret = stm32_sdmmc2_stop_transfer();
+			if (ret != 0) {
+				return ret;
+			}
+
+			return -EIO;
+		}
+
+		if (timeout_elapsed(timeout)) {
+			ERROR("%s: timeout 1s (status = %x)\n",
+			      __func__, status);
+			dump_registers();
+			mmio_write_32(base + SDMMC_ICR,
+				      SDMMC_STATIC_FLAGS);
+
+			ret = stm32_sdmmc2_stop_transfer();
+			if (ret != 0) {
+				return ret;
+			}
+
+			return -ETIMEDOUT;
+		}
+
+		stm32_iwdg_checkpoint();
+
+		/*
+		 * Transfers are whole blocks, so the 8 word bursts always
+		 * divide the remaining data evenly.
+		 */
+		if ((remaining != 0U) &&
+		    ((status & SDMMC_STAR_TXFIFOHE) != 0U)) {
+			uint32_t count;
+
+			/* Write data to SDMMC Tx FIFO */
+			for (count = 0; count < 8U; count++) {
+				mmio_write_32(fifo_reg, *buffer);
+				buffer++;
+			}
+
+			remaining -= 8U * sizeof(uint32_t);
+		}
+	} while ((status & flags) == 0U);
+
+	mmio_write_32(base + SDMMC_ICR, SDMMC_STATIC_FLAGS);
+
+	if ((status & SDMMC_STAR_DPSMACT) != 0U) {
+		WARN("%s: DPSMACT=1, send stop\n", __func__);
+		return stm32_sdmmc2_stop_transfer();
+	}
+
+	return 0;
+}
+
+static int stm32_sdmmc2_prepare_wr_multi(int lba, const struct mmc_buf *bufs,
+					 unsigned int count)
+{
+	struct mmc_cmd cmd;
+	int ret;
+	uintptr_t base = sdmmc2_params.reg_base;
+	uint32_t data_ctrl = 0U;
+	size_t buf_size = bufs[0].size;
+	size_t total = 0U;
+	unsigned int i;
+
+	assert(count != 0U);
+
+	if (count == 1U) {
+		/* Single buffer mode handles any contiguous transfer */
+		sdmmc2_multi.active = false;
+		return stm32_sdmmc2_prepare_wr(lba, bufs[0].buf,
+					       bufs[0].size);
+	}
+
+	/* Double buffer mode constraints, as on the read path */
+	if (((buf_size % SDMMC_IDMA_BUF_GRANULE) != 0U) ||
+	    (buf_size > SDMMC_IDMA_BUF_MAX_SIZE) ||
+	    (bufs[count - 1U].size > buf_size)) {
+		return -EOPNOTSUPP;
+	}
+
+	for (i = 0U; i < count; i++) {
+		if (((bufs[i].buf & GENMASK(1, 0)) != 0U) ||
+		    !plat_sdmmc2_use_dma(base, bufs[i].buf)) {
+			return -EOPNOTSUPP;
+		}
+
+		if ((i < (count - 1U)) && (bufs[i].size != buf_size)) {
+			return -EOPNOTSUPP;
+		}
+
+		total += bufs[i].size;
+		xlat_dma_prepare(bufs[i].buf, bufs[i].size,
+				 XLAT_DMA_TO_DEVICE);
+	}
+
+	sdmmc2_params.use_dma = true;
+
+	/* Prepare CMD 16*/
+	mmio_write_32(base + SDMMC_DTIMER, 0);
+
+	mmio_write_32(base + SDMMC_DLENR, 0);
+
+	mmio_write_32(base + SDMMC_DCTRLR, 0);
+
+	zeromem(&cmd, sizeof(struct mmc_cmd));
+
+	cmd.cmd_idx = MMC_CMD(16);
+	cmd.cmd_arg = MMC_BLOCK_SIZE;
+	cmd.resp_type = MMC_RESPONSE_R1;
+
+	ret = stm32_sdmmc2_send_cmd(&cmd);
+	if (ret != 0) {
+		ERROR("CMD16 failed\n");
+		return ret;
+	}
+
+	/* Prepare data command */
+	mmio_write_32(base + SDMMC_DTIMER, UINT32_MAX);
+
+	mmio_write_32(base + SDMMC_DLENR, total);
+
+	mmio_write_32(base + SDMMC_IDMABSIZER,
+		      (buf_size / SDMMC_IDMA_BUF_GRANULE) <<
+		      SDMMC_IDMABSIZER_BNDT_SHIFT);
+	mmio_write_32(base + SDMMC_IDMABASE0R, bufs[0].buf);
+	mmio_write_32(base + SDMMC_IDMABASE1R, bufs[1].buf);
+	mmio_write_32(base + SDMMC_IDMACTRLR,
+		      SDMMC_IDMACTRLR_IDMAEN | SDMMC_IDMACTRLR_IDMABMODE);
+
+	data_ctrl |= __builtin_ctz(MMC_BLOCK_SIZE) <<
+		     SDMMC_DCTRLR_DBLOCKSIZE_SHIFT;
+
+	mmio_clrsetbits_32(base + SDMMC_DCTRLR,
+			   SDMMC_DCTRLR_CLEAR_MASK,
+			   data_ctrl);
+
+	sdmmc2_multi.bufs = bufs;
+	sdmmc2_multi.count = count;
+	sdmmc2_multi.next = 2U;
+	sdmmc2_multi.active = true;
+
+	return 0;
+}
+
+static int stm32_sdmmc2_write_multi(int lba, const struct mmc_buf *bufs,
+				    unsigned int count)
+{
+	uintptr_t base = sdmmc2_params.reg_base;
+
+	if (!sdmmc2_multi.active) {
+		return stm32_sdmmc2_write(lba, bufs[0].buf, bufs[0].size);
+	}
+
+	/*
+	 * The whole list has been sent while the data command completion
+	 * was polled, the idle IDMA buffer being reloaded on each IDMABTC.
+	 * Unlike a read, no cache maintenance is needed afterwards.
+	 */
+	sdmmc2_multi.active = false;
+	mmio_write_32(base + SDMMC_IDMACTRLR, 0U);
+
 	return 0;
 }
 
 static int stm32_sdmmc2_dt_get_config(void)
 {
 	int sdmmc_node;
+	int lenp;
 	void *fdt = NULL;
 	const fdt32_t *cuint;
 	struct dt_node_info dt_info;
@@ -737,6 +1725,33 @@ static int stm32_sdmmc2_dt_get_config(void)
 		sdmmc2_params.negedge = SDMMC_CLKCR_NEGEDGE;
 	}
 
+	cuint = fdt_getprop(fdt, sdmmc_node, "reg", &lenp);
+	if ((cuint != NULL) && (lenp >= (int)(4U * sizeof(fdt32_t)))) {
+		/* The optional second range maps the delay block */
+		sdmmc2_params.dlyb_base = fdt32_to_cpu(cuint[2]);
+	}
+
+#if STM32MP_SDMMC2_WFI_WAIT
+	cuint = fdt_getprop(fdt, sdmmc_node, "interrupts", &lenp);
+	if ((cuint != NULL) && (lenp >= (int)(3U * sizeof(fdt32_t))) &&
+	    (fdt32_to_cpu(cuint[0]) == GIC_SPI)) {
+		sdmmc2_irq_id = MIN_SPI_ID + fdt32_to_cpu(cuint[1]);
+	}
+#endif
+
+	if (fdt_getprop(fdt, sdmmc_node, "mmc-ddr-3_3v", NULL) != NULL) {
+		sdmmc2_params.flags |= MMC_FLAG_DDR52;
+	}
+
+	/*
+	 * HS200 needs 1.8V signaling: the property asserts the I/O rail is
+	 * wired accordingly, no voltage switch is performed here.
+	 */
+	if ((fdt_getprop(fdt, sdmmc_node, "mmc-hs200-1_8v", NULL) != NULL) &&
+	    (sdmmc2_params.dlyb_base != 0U)) {
+		sdmmc2_params.flags |= MMC_FLAG_HS200;
+	}
+
 	cuint = fdt_getprop(fdt, sdmmc_node, "bus-width", NULL);
 	if (cuint != NULL) {
 		switch (fdt32_to_cpu(*cuint)) {
@@ -790,14 +1805,19 @@ int stm32_sdmmc2_mmc_init(struct stm32_sdmmc2_params *params)
 
 	stm32mp_clk_enable(sdmmc2_params.clock_id);
 
+	stm32mp_wait_calib_bind(WAIT_CALIB_SDMMC_RESET,
+				sdmmc2_params.clock_id);
+	stm32mp_wait_calib_bind(WAIT_CALIB_SDMMC_SETTLE,
+				sdmmc2_params.clock_id);
+
 	if (stm32mp_reset_assert_to(sdmmc2_params.reset_id, TIMEOUT_US_1MS)) {
 		panic();
 	}
-	udelay(2);
+	udelay(stm32mp_wait_calib_us(WAIT_CALIB_SDMMC_RESET));
 	if (stm32mp_reset_deassert_to(sdmmc2_params.reset_id, TIMEOUT_US_1MS)) {
 		panic();
 	}
-	mdelay(1);
+	udelay(stm32mp_wait_calib_us(WAIT_CALIB_SDMMC_SETTLE));
 
 	sdmmc2_params.clk_rate = stm32mp_clk_get_rate(sdmmc2_params.clock_id);
 	sdmmc2_params.device_info->ocr_voltage = OCR_3_2_3_3 | OCR_3_3_3_4;
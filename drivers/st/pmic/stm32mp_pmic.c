@@ -362,7 +362,23 @@ int pmic_configure_boot_on_regulators(void)
 
 int pmic_set_lp_config(const char *node_name)
 {
-	return pmic_operate(CMD_CONFIG_LP, node_name, NULL);
+	int ret;
+
+	/*
+	 * Batch the regulator low power register writes so that the PMIC
+	 * reconfiguration costs a single chained I2C sequence on the bus
+	 * instead of one bus claim and stop condition per register.
+	 */
+	stpmic1_batch_start();
+
+	ret = pmic_operate(CMD_CONFIG_LP, node_name, NULL);
+	if (ret == 0) {
+		ret = stpmic1_batch_commit();
+	} else {
+		stpmic1_batch_discard();
+	}
+
+	return ret;
 }
 
 int dt_pmic_find_supply(const char **supply_name, const char *regu_name)
@@ -573,6 +589,52 @@ void print_pmic_info_and_debug(void)
 }
 #endif
 
+/*
+ * Apply a set of rail target states back-to-back. Every STPMIC1 rail shares
+ * the same default start-up delay, so the maximum ramp time of a rank is
+ * that constant and it is waited once per rank instead of once per rail.
+ */
+int pmic_apply_regu_transaction(const struct pmic_regu_request *requests,
+				size_t count)
+{
+	bool ramping = false;
+	size_t i;
+	int status;
+
+	for (i = 0U; i < count; i++) {
+		const struct pmic_regu_request *req = &requests[i];
+
+		if ((i != 0U) && (req->ramp_rank != requests[i - 1U].ramp_rank) &&
+		    ramping) {
+			mdelay(STPMIC1_DEFAULT_START_UP_DELAY_MS);
+			ramping = false;
+		}
+
+		if (req->voltage_mv != 0U) {
+			status = stpmic1_regulator_voltage_set(req->name,
+							       req->voltage_mv);
+			if (status != 0) {
+				return status;
+			}
+		}
+
+		if (req->enable) {
+			status = stpmic1_regulator_enable(req->name);
+			if (status != 0) {
+				return status;
+			}
+
+			ramping = true;
+		}
+	}
+
+	if (ramping) {
+		mdelay(STPMIC1_DEFAULT_START_UP_DELAY_MS);
+	}
+
+	return 0;
+}
+
 int pmic_ddr_power_init(enum ddr_type ddr_type)
 {
 	bool buck3_at_1v8 = false;
@@ -603,31 +665,37 @@ int pmic_ddr_power_init(enum ddr_type ddr_type)
 			return status;
 		}
 
-		status = stpmic1_regulator_voltage_set("buck2", buck2_mv);
-		if (status != 0) {
-			return status;
-		}
-
-		status = stpmic1_regulator_enable("buck2");
-		if (status != 0) {
-			return status;
-		}
-
-		mdelay(STPMIC1_DEFAULT_START_UP_DELAY_MS);
-
-		status = stpmic1_regulator_enable("vref_ddr");
-		if (status != 0) {
-			return status;
-		}
-
-		mdelay(STPMIC1_DEFAULT_START_UP_DELAY_MS);
-
-		status = stpmic1_regulator_enable("ldo3");
-		if (status != 0) {
-			return status;
+		{
+			/*
+			 * VREF and the VTT termination (LDO3 in sync mode)
+			 * track each other, so they ramp together once the
+			 * VDD rail (BUCK2) is up.
+			 */
+			const struct pmic_regu_request ddr3_rails[] = {
+				{
+					.name = "buck2",
+					.voltage_mv = buck2_mv,
+					.enable = true,
+					.ramp_rank = 0U,
+				},
+				{
+					.name = "vref_ddr",
+					.enable = true,
+					.ramp_rank = 1U,
+				},
+				{
+					.name = "ldo3",
+					.enable = true,
+					.ramp_rank = 1U,
+				},
+			};
+
+			status = pmic_apply_regu_transaction(ddr3_rails,
+						ARRAY_SIZE(ddr3_rails));
+			if (status != 0) {
+				return status;
+			}
 		}
-
-		mdelay(STPMIC1_DEFAULT_START_UP_DELAY_MS);
 		break;
 
 	case STM32MP_LPDDR2:
@@ -666,36 +734,38 @@ int pmic_ddr_power_init(enum ddr_type ddr_type)
 			return -EPERM;
 		}
 
-		status = stpmic1_regulator_voltage_set("ldo3", ldo3_mv);
-		if (status != 0) {
-			return status;
-		}
-
-		status = stpmic1_regulator_voltage_set("buck2", buck2_mv);
-		if (status != 0) {
-			return status;
-		}
-
-		status = stpmic1_regulator_enable("ldo3");
-		if (status != 0) {
-			return status;
-		}
-
-		mdelay(STPMIC1_DEFAULT_START_UP_DELAY_MS);
-
-		status = stpmic1_regulator_enable("buck2");
-		if (status != 0) {
-			return status;
-		}
-
-		mdelay(STPMIC1_DEFAULT_START_UP_DELAY_MS);
-
-		status = stpmic1_regulator_enable("vref_ddr");
-		if (status != 0) {
-			return status;
+		{
+			/*
+			 * VDD1 (LDO3) must be up before VDD2 (BUCK2), and
+			 * VREF only ramps once VDD2 is stable: each rail
+			 * keeps its own rank.
+			 */
+			const struct pmic_regu_request lpddr_rails[] = {
+				{
+					.name = "ldo3",
+					.voltage_mv = ldo3_mv,
+					.enable = true,
+					.ramp_rank = 0U,
+				},
+				{
+					.name = "buck2",
+					.voltage_mv = buck2_mv,
+					.enable = true,
+					.ramp_rank = 1U,
+				},
+				{
+					.name = "vref_ddr",
+					.enable = true,
+					.ramp_rank = 2U,
+				},
+			};
+
+			status = pmic_apply_regu_transaction(lpddr_rails,
+						ARRAY_SIZE(lpddr_rails));
+			if (status != 0) {
+				return status;
+			}
 		}
-
-		mdelay(STPMIC1_DEFAULT_START_UP_DELAY_MS);
 		break;
 
 	default:
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include <assert.h>
 #include <errno.h>
 #include <string.h>
 
@@ -27,6 +28,50 @@ struct regul_struct {
 static struct i2c_handle_s *pmic_i2c_handle;
 static uint16_t pmic_i2c_addr;
 
+/*
+ * Optional register write batch: while a batch is open, register writes are
+ * merged into this queue and flushed to the PMIC as a single chained I2C
+ * sequence when the batch is committed. Reads of a queued register return
+ * the queued value so that read-modify-write updates keep working.
+ */
+#define PMIC_BATCH_DEPTH	16U
+
+static struct stm32_i2c_reg_write pmic_batch[PMIC_BATCH_DEPTH];
+static unsigned int pmic_batch_count;
+static bool pmic_batch_open;
+
+static struct stm32_i2c_reg_write *pmic_batch_find(uint8_t register_id)
+{
+	unsigned int i;
+
+	for (i = 0U; i < pmic_batch_count; i++) {
+		if (pmic_batch[i].mem_addr == register_id) {
+			return &pmic_batch[i];
+		}
+	}
+
+	return NULL;
+}
+
+static int pmic_batch_write(uint8_t register_id, uint8_t value)
+{
+	struct stm32_i2c_reg_write *entry = pmic_batch_find(register_id);
+
+	if (entry == NULL) {
+		if (pmic_batch_count == PMIC_BATCH_DEPTH) {
+			return -ENOMEM;
+		}
+
+		entry = &pmic_batch[pmic_batch_count];
+		entry->mem_addr = register_id;
+		pmic_batch_count++;
+	}
+
+	entry->value = value;
+
+	return 0;
+}
+
 /* Voltage tables in mV */
 static const uint16_t buck1_voltage_table[] = {
 	725,
@@ -763,8 +808,38 @@ int stpmic1_regulator_voltage_get(const char *name)
 	return (int)regul->voltage_table[value];
 }
 
+int stpmic1_regulator_levels_mv(const char *name, const uint16_t **levels,
+				size_t *levels_count)
+{
+	const struct regul_struct *regul = get_regulator_data(name);
+
+	if (regul == NULL) {
+		return -EINVAL;
+	}
+
+	if (levels_count != NULL) {
+		*levels_count = regul->voltage_table_size;
+	}
+
+	if (levels != NULL) {
+		*levels = regul->voltage_table;
+	}
+
+	return 0;
+}
+
 int stpmic1_register_read(uint8_t register_id,  uint8_t *value)
 {
+	if (pmic_batch_open) {
+		const struct stm32_i2c_reg_write *entry =
+			pmic_batch_find(register_id);
+
+		if (entry != NULL) {
+			*value = entry->value;
+			return 0;
+		}
+	}
+
 	return stm32_i2c_mem_read(pmic_i2c_handle, pmic_i2c_addr,
 				  (uint16_t)register_id,
 				  I2C_MEMADD_SIZE_8BIT, value,
@@ -775,6 +850,10 @@ int stpmic1_register_write(uint8_t register_id, uint8_t value)
 {
 	int status;
 
+	if (pmic_batch_open) {
+		return pmic_batch_write(register_id, value);
+	}
+
 	status = stm32_i2c_mem_write(pmic_i2c_handle, pmic_i2c_addr,
 				     (uint16_t)register_id,
 				     I2C_MEMADD_SIZE_8BIT, &value,
@@ -817,6 +896,65 @@ int stpmic1_register_update(uint8_t register_id, uint8_t value, uint8_t mask)
 	return stpmic1_register_write(register_id, val);
 }
 
+void stpmic1_batch_start(void)
+{
+	pmic_batch_count = 0U;
+	pmic_batch_open = true;
+}
+
+void stpmic1_batch_discard(void)
+{
+	pmic_batch_count = 0U;
+	pmic_batch_open = false;
+}
+
+int stpmic1_batch_commit(void)
+{
+	int status;
+
+	assert(pmic_batch_open);
+
+	pmic_batch_open = false;
+
+	if (pmic_batch_count == 0U) {
+		return 0;
+	}
+
+	status = stm32_i2c_mem_write_seq(pmic_i2c_handle, pmic_i2c_addr,
+					 I2C_MEMADD_SIZE_8BIT, pmic_batch,
+					 pmic_batch_count, I2C_TIMEOUT_MS);
+
+#if ENABLE_ASSERTIONS
+	if (status == 0) {
+		unsigned int i;
+
+		for (i = 0U; i < pmic_batch_count; i++) {
+			uint8_t register_id = (uint8_t)pmic_batch[i].mem_addr;
+			uint8_t readval;
+
+			if ((register_id == WATCHDOG_CONTROL_REG) ||
+			    (register_id > 0x40U)) {
+				continue;
+			}
+
+			status = stpmic1_register_read(register_id, &readval);
+			if (status != 0) {
+				break;
+			}
+
+			if (readval != pmic_batch[i].value) {
+				status = -EIO;
+				break;
+			}
+		}
+	}
+#endif
+
+	pmic_batch_count = 0U;
+
+	return status;
+}
+
 void stpmic1_bind_i2c(struct i2c_handle_s *i2c_handle, uint16_t i2c_addr)
 {
 	pmic_i2c_handle = i2c_handle;
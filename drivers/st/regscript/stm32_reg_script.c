@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2021, STMicroelectronics - All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <assert.h>
+
+#include <arch_helpers.h>
+#include <common/debug.h>
+#include <drivers/st/stm32_reg_script.h>
+#include <lib/mmio.h>
+
+/*
+ * Execute a register script. The loop body touches nothing but the
+ * entry under execution and the target register, so a script runs as
+ * one predictable sweep over its rodata table. params may be NULL when
+ * the script contains no RMW_PARAM entry.
+ */
+void reg_script_run(const struct reg_script_entry *script,
+		    const uint32_t *params)
+{
+	const struct reg_script_entry *entry;
+
+	for (entry = script; entry->op != REG_SCRIPT_OP_END; entry++) {
+		switch (entry->op) {
+		case REG_SCRIPT_OP_WRITE:
+			mmio_write_32(entry->addr, entry->val);
+			break;
+		case REG_SCRIPT_OP_RMW:
+			mmio_clrsetbits_32(entry->addr, entry->mask,
+					   entry->val);
+			break;
+		case REG_SCRIPT_OP_RMW_PARAM:
+			assert(params != NULL);
+			mmio_clrsetbits_32(entry->addr, entry->mask,
+					   params[entry->val]);
+			break;
+		case REG_SCRIPT_OP_POLL:
+			while ((mmio_read_32(entry->addr) & entry->mask) !=
+			       entry->val) {
+				;
+			}
+			break;
+		case REG_SCRIPT_OP_SYNC:
+			dsb();
+			isb();
+			break;
+		default:
+			panic();
+		}
+	}
+}
@@ -27,12 +27,92 @@ static uint8_t id2reg_bit_pos(unsigned int reset_id)
 	return (uint8_t)(reset_id & GENMASK(4, 0));
 }
 
+/*
+ * Reset line state cache
+ *
+ * One entry per RCC reset set/clear register pair, recording the last state
+ * programmed for each line whose state is known. Redundant requests (such as
+ * asserting an already asserted line, common when the non-secure OS cycles
+ * resets through SCMI at driver probe) are answered from the cache without
+ * touching nor polling the RCC. A line whose polling timed out is marked
+ * unknown again so the next request retries the hardware.
+ */
+#define RESET_STATE_CACHE_SIZE		U(12)
+
+struct reset_state_cache {
+	uint32_t offset;
+	uint32_t valid;
+	uint32_t asserted;
+};
+
+static struct reset_state_cache reset_cache[RESET_STATE_CACHE_SIZE];
+static unsigned int reset_cache_count;
+
+static struct reset_state_cache *reset_cache_get(uint32_t offset)
+{
+	unsigned int i;
+
+	for (i = 0U; i < reset_cache_count; i++) {
+		if (reset_cache[i].offset == offset) {
+			return &reset_cache[i];
+		}
+	}
+
+	if (reset_cache_count < RESET_STATE_CACHE_SIZE) {
+		reset_cache[reset_cache_count].offset = offset;
+
+		return &reset_cache[reset_cache_count++];
+	}
+
+	return NULL;
+}
+
+static bool reset_state_is(uint32_t offset, uint32_t bitmsk,
+			   bool assert_not_deassert)
+{
+	struct reset_state_cache *cache = reset_cache_get(offset);
+	uint32_t state = assert_not_deassert ? bitmsk : 0U;
+
+	if (cache == NULL) {
+		return false;
+	}
+
+	return ((cache->valid & bitmsk) != 0U) &&
+	       ((cache->asserted & bitmsk) == state);
+}
+
+static void reset_state_update(uint32_t offset, uint32_t bitmsk,
+			       bool assert_not_deassert, bool known)
+{
+	struct reset_state_cache *cache = reset_cache_get(offset);
+
+	if (cache == NULL) {
+		return;
+	}
+
+	if (!known) {
+		cache->valid &= ~bitmsk;
+		return;
+	}
+
+	cache->valid |= bitmsk;
+	if (assert_not_deassert) {
+		cache->asserted |= bitmsk;
+	} else {
+		cache->asserted &= ~bitmsk;
+	}
+}
+
 int stm32mp_reset_assert_to(uint32_t id, unsigned int to_us)
 {
 	uint32_t offset = id2reg_offset(id);
 	uint32_t bitmsk = BIT(id2reg_bit_pos(id));
 	uintptr_t rcc_base = stm32mp_rcc_base();
 
+	if (reset_state_is(offset, bitmsk, true)) {
+		return 0;
+	}
+
 	mmio_write_32(rcc_base + offset, bitmsk);
 
 	if (to_us != 0) {
@@ -45,19 +125,27 @@ int stm32mp_reset_assert_to(uint32_t id, unsigned int to_us)
 		}
 
 		if ((mmio_read_32(rcc_base + offset) & bitmsk) == 0U) {
+			reset_state_update(offset, bitmsk, true, false);
 			return -ETIMEDOUT;
 		}
 	}
 
+	reset_state_update(offset, bitmsk, true, true);
+
 	return 0;
 }
 
 int stm32mp_reset_deassert_to(uint32_t id, unsigned int to_us)
 {
 	uint32_t offset = id2reg_offset(id) + RCC_RSTCLRR_OFFSET;
+	uint32_t state_offset = id2reg_offset(id);
 	uint32_t bitmsk = BIT(id2reg_bit_pos(id));
 	uintptr_t rcc_base = stm32mp_rcc_base();
 
+	if (reset_state_is(state_offset, bitmsk, false)) {
+		return 0;
+	}
+
 	mmio_write_32(rcc_base + offset, bitmsk);
 
 	if (to_us != 0) {
@@ -70,13 +158,100 @@ int stm32mp_reset_deassert_to(uint32_t id, unsigned int to_us)
 		}
 
 		if ((mmio_read_32(rcc_base + offset) & bitmsk) != 0U) {
+			reset_state_update(state_offset, bitmsk, false, false);
 			return -ETIMEDOUT;
 		}
 	}
 
+	reset_state_update(state_offset, bitmsk, false, true);
+
 	return 0;
 }
 
+static int reset_op_multi_to(const uint32_t *ids, size_t count,
+			     bool assert_not_deassert, unsigned int to_us)
+{
+	uint32_t offsets[RESET_STATE_CACHE_SIZE];
+	uint32_t masks[RESET_STATE_CACHE_SIZE];
+	uint32_t wr_offset = assert_not_deassert ? 0U : RCC_RSTCLRR_OFFSET;
+	uintptr_t rcc_base = stm32mp_rcc_base();
+	unsigned int used = 0U;
+	unsigned int j;
+	size_t i;
+	int ret = 0;
+
+	/* Coalesce the lines into one bitmask per RCC reset register */
+	for (i = 0U; i < count; i++) {
+		uint32_t offset = id2reg_offset(ids[i]);
+		uint32_t bitmsk = BIT(id2reg_bit_pos(ids[i]));
+
+		if (reset_state_is(offset, bitmsk, assert_not_deassert)) {
+			continue;
+		}
+
+		for (j = 0U; j < used; j++) {
+			if (offsets[j] == offset) {
+				break;
+			}
+		}
+
+		if (j == used) {
+			if (used == RESET_STATE_CACHE_SIZE) {
+				return -ENOMEM;
+			}
+
+			offsets[used] = offset;
+			masks[used] = 0U;
+			used++;
+		}
+
+		masks[j] |= bitmsk;
+	}
+
+	for (j = 0U; j < used; j++) {
+		mmio_write_32(rcc_base + offsets[j] + wr_offset, masks[j]);
+	}
+
+	for (j = 0U; j < used; j++) {
+		if (to_us != 0U) {
+			uint32_t state = assert_not_deassert ? masks[j] : 0U;
+			uint64_t timeout_ref = timeout_init_us(to_us);
+
+			while ((mmio_read_32(rcc_base + offsets[j]) &
+				masks[j]) != state) {
+				if (timeout_elapsed(timeout_ref)) {
+					break;
+				}
+			}
+
+			if ((mmio_read_32(rcc_base + offsets[j]) &
+			     masks[j]) != state) {
+				reset_state_update(offsets[j], masks[j],
+						   assert_not_deassert, false);
+				ret = -ETIMEDOUT;
+				continue;
+			}
+		}
+
+		reset_state_update(offsets[j], masks[j],
+				   assert_not_deassert, true);
+	}
+
+	return ret;
+}
+
+int stm32mp_reset_assert_multi_to(const uint32_t *ids, size_t count,
+				  unsigned int to_us)
+{
+	return reset_op_multi_to(ids, count, true, to_us);
+}
+
+int stm32mp_reset_deassert_multi_to(const uint32_t *ids, size_t count,
+				    unsigned int to_us)
+{
+	return reset_op_multi_to(ids, count, false, to_us);
+}
+
 void stm32mp_reset_assert_deassert_to_mcu(bool assert_not_deassert)
 {
 	uintptr_t rcc_base = stm32mp_rcc_base();
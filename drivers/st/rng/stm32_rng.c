@@ -16,7 +16,9 @@
 #include <drivers/delay_timer.h>
 #include <drivers/st/stm32_rng.h>
 #include <drivers/st/stm32mp_reset.h>
+#include <drivers/st/stm32mp_wait_calib.h>
 #include <lib/mmio.h>
+#include <lib/spinlock.h>
 
 #define DT_RNG_COMPAT		"st,stm32-rng"
 #define RNG_CR			0x00U
@@ -34,10 +36,22 @@
 #define RNG_SR_SEIS		BIT(6)
 
 #define RNG_TIMEOUT_US		100000
-#define RNG_TIMEOUT_STEP_US	10
 
 #define TIMEOUT_US_1MS		U(1000)
 
+/*
+ * Size in bytes of the entropy pool, 0 disables pooling. The pool is topped
+ * up by stm32_rng_pool_refill(), meant to be called from idle hooks: only
+ * words already signalled by DRDY are harvested, the call never waits on
+ * generation. Consumers served from the pool get their bytes as a memory
+ * copy and only fall back to polling the peripheral when it runs dry. The
+ * RNG kernel clock is left running once pooling has started, so words
+ * accumulate between hooks.
+ */
+#ifndef STM32_RNG_POOL_SIZE
+#define STM32_RNG_POOL_SIZE	U(64)
+#endif
+
 struct stm32_rng_instance {
 	uintptr_t base;
 	unsigned long clock;
@@ -45,6 +59,96 @@ struct stm32_rng_instance {
 
 static struct stm32_rng_instance stm32_rng;
 
+#if STM32_RNG_POOL_SIZE != 0U
+static uint8_t rng_pool[STM32_RNG_POOL_SIZE];
+static uint32_t rng_pool_level;
+static bool rng_pool_running;
+static struct spinlock rng_pool_lock;
+
+static void rng_pool_lock_get(void)
+{
+	if (stm32mp_lock_available()) {
+		spin_lock(&rng_pool_lock);
+	}
+}
+
+static void rng_pool_lock_put(void)
+{
+	if (stm32mp_lock_available()) {
+		spin_unlock(&rng_pool_lock);
+	}
+}
+#endif
+
+/*
+ * Recovery sequence recommended by the SoC reference manual on a seed
+ * error. Return 0 when the RNG recovered, -EIO when the error persists.
+ */
+static int stm32_rng_seed_error_recover(void)
+{
+	uint8_t i;
+
+	mmio_clrbits_32(stm32_rng.base + RNG_SR, RNG_SR_SEIS);
+	dmb();
+	for (i = 12U; i != 0U; i--) {
+		(void)mmio_read_32(stm32_rng.base + RNG_DR);
+	}
+	dmb();
+
+	if ((mmio_read_32(stm32_rng.base + RNG_SR) & RNG_SR_SEIS) != 0U) {
+		return -EIO;
+	}
+
+	return 0;
+}
+
+#if STM32_RNG_POOL_SIZE != 0U
+void stm32_rng_pool_refill(void)
+{
+	uintptr_t base = stm32_rng.base;
+
+	if (base == 0U) {
+		return;
+	}
+
+	rng_pool_lock_get();
+
+	if (!rng_pool_running) {
+		stm32mp_clk_enable(stm32_rng.clock);
+		rng_pool_running = true;
+	}
+
+	if ((mmio_read_32(base + RNG_CR) & RNG_CR_RNGEN) == 0U) {
+		mmio_write_32(base + RNG_CR, RNG_CR_RNGEN | RNG_CR_CED);
+	}
+
+	while (rng_pool_level <= (STM32_RNG_POOL_SIZE - sizeof(uint32_t))) {
+		uint32_t status = mmio_read_32(base + RNG_SR);
+		uint32_t data32;
+
+		if ((status & (RNG_SR_SECS | RNG_SR_SEIS)) != 0U) {
+			/* Do not pool suspect words, leave it to readers */
+			(void)stm32_rng_seed_error_recover();
+			break;
+		}
+
+		if ((status & RNG_SR_DRDY) == 0U) {
+			break;
+		}
+
+		data32 = mmio_read_32(base + RNG_DR);
+		memcpy(&rng_pool[rng_pool_level], &data32, sizeof(data32));
+		rng_pool_level += sizeof(data32);
+	}
+
+	rng_pool_lock_put();
+}
+#else
+void stm32_rng_pool_refill(void)
+{
+}
+#endif
+
 /*
  * stm32_rng_read - Read a number of random bytes from RNG
  * out: pointer to the output buffer
@@ -64,6 +168,27 @@ int stm32_rng_read(uint8_t *out, uint32_t size)
 		return -EPERM;
 	}
 
+#if STM32_RNG_POOL_SIZE != 0U
+	rng_pool_lock_get();
+
+	if (rng_pool_level != 0U) {
+		uint32_t taken = MIN(len, rng_pool_level);
+
+		rng_pool_level -= taken;
+		memcpy(buf, &rng_pool[rng_pool_level], taken);
+		/* Never hand out the same bytes twice */
+		memset(&rng_pool[rng_pool_level], 0, taken);
+		buf += taken;
+		len -= taken;
+	}
+
+	rng_pool_lock_put();
+
+	if (len == 0U) {
+		return 0;
+	}
+#endif
+
 	stm32mp_clk_enable(stm32_rng.clock);
 
 	if ((mmio_read_32(stm32_rng.base + RNG_CR) & RNG_CR_RNGEN) == 0U) {
@@ -72,31 +197,20 @@ int stm32_rng_read(uint8_t *out, uint32_t size)
 	}
 
 	while (len != 0U) {
-		nb_tries = RNG_TIMEOUT_US / RNG_TIMEOUT_STEP_US;
+		uint32_t step_us = stm32mp_wait_calib_us(WAIT_CALIB_RNG_SEED_POLL);
+
+		nb_tries = RNG_TIMEOUT_US / step_us;
 		do {
 			uint32_t status = mmio_read_32(stm32_rng.base + RNG_SR);
 
 			if ((status & (RNG_SR_SECS | RNG_SR_SEIS)) != 0U) {
-				uint8_t i;
-
-				/* Recommended by the SoC reference manual */
-				mmio_clrbits_32(stm32_rng.base + RNG_SR,
-						RNG_SR_SEIS);
-				dmb();
-				for (i = 12; i != 0; i--) {
-					(void)mmio_read_32(stm32_rng.base +
-							   RNG_DR);
-				}
-				dmb();
-
-				if ((mmio_read_32(stm32_rng.base + RNG_SR) &
-				     RNG_SR_SEIS) != 0U) {
+				if (stm32_rng_seed_error_recover() != 0) {
 					ERROR("RNG noise\n");
 					panic();
 				}
 			}
 
-			udelay(RNG_TIMEOUT_STEP_US);
+			udelay(step_us);
 			nb_tries--;
 			if (nb_tries == 0) {
 				rc = -ETIMEDOUT;
@@ -168,6 +282,9 @@ int stm32_rng_init(void)
 	}
 	stm32_rng.clock = (unsigned long)dt_rng.clock;
 
+	stm32mp_wait_calib_bind(WAIT_CALIB_RNG_RESET, stm32_rng.clock);
+	stm32mp_wait_calib_bind(WAIT_CALIB_RNG_SEED_POLL, stm32_rng.clock);
+
 	stm32mp_clk_enable(stm32_rng.clock);
 	stm32mp_clk_disable(stm32_rng.clock);
 
@@ -176,7 +293,7 @@ int stm32_rng_init(void)
 					    TIMEOUT_US_1MS))
 			panic();
 
-		udelay(20);
+		udelay(stm32mp_wait_calib_us(WAIT_CALIB_RNG_RESET));
 		if (stm32mp_reset_deassert_to((unsigned long)dt_rng.reset,
 					      TIMEOUT_US_1MS))
 			panic();
@@ -418,6 +418,53 @@ void stm32_rtc_get_timestamp(struct stm32_rtc_time *tamp_ts)
 	stm32_rtc_regs_unlock();
 }
 
+/*******************************************************************************
+ * This function latches the raw timestamp registers from interrupt
+ * context: a pending timestamp is copied and its flags are cleared in a
+ * handful of MMIO accesses, while the BCD decode is left to
+ * stm32_rtc_calendar_to_time(), to be run outside the interrupt context.
+ * Returns true when a timestamp was pending.
+ ******************************************************************************/
+bool stm32_rtc_latch_timestamp(struct stm32_rtc_calendar *cal)
+{
+	bool latched = false;
+
+	assert(cal != NULL);
+
+	stm32_rtc_regs_lock();
+	stm32mp_clk_enable(rtc_dev.clock);
+
+	if ((mmio_read_32(rtc_dev.base + RTC_SR) & RTC_SR_TSF) != 0U) {
+		cal->ssr = 0U;
+		cal->tr = mmio_read_32(rtc_dev.base + RTC_TSTR);
+		cal->dr = mmio_read_32(rtc_dev.base + RTC_TSDR);
+		mmio_setbits_32(rtc_dev.base + RTC_SCR, RTC_SCR_CTSF);
+		if ((mmio_read_32(rtc_dev.base + RTC_SR) & RTC_SR_TSOVF) !=
+		    0U) {
+			/* Overflow detected */
+			mmio_setbits_32(rtc_dev.base + RTC_SCR, RTC_SCR_CTSOVF);
+		}
+
+		latched = true;
+	}
+
+	stm32mp_clk_disable(rtc_dev.clock);
+	stm32_rtc_regs_unlock();
+
+	return latched;
+}
+
+/*******************************************************************************
+ * This function decodes latched calendar register values into the time
+ * structure, without touching the hardware.
+ ******************************************************************************/
+void stm32_rtc_calendar_to_time(struct stm32_rtc_calendar *cal,
+				struct stm32_rtc_time *tm)
+{
+	stm32_rtc_get_time(cal, tm);
+	stm32_rtc_get_date(cal, tm);
+}
+
 /*******************************************************************************
  * This function enable the timestamp bit for tamper and secure timestamp
  * access.
@@ -13,7 +13,9 @@
 
 #include "base.h"
 #include "clock.h"
+#include "perf_domain.h"
 #include "reset_domain.h"
+#include "voltage_domain.h"
 
 #define SCMI_VERSION			0x20000U
 #define SCMI_IMPL_VERSION		0U
@@ -103,6 +105,14 @@ scmi_msg_handler_t scmi_msg_get_base_handler(struct scmi_msg *msg);
  */
 scmi_msg_handler_t scmi_msg_get_clock_handler(struct scmi_msg *msg);
 
+/*
+ * scmi_msg_get_perfd_handler - Return a handler for a performance domain
+ * message
+ * @msg - message to process
+ * Return a function handler for the message or NULL
+ */
+scmi_msg_handler_t scmi_msg_get_perfd_handler(struct scmi_msg *msg);
+
 /*
  * scmi_msg_get_rd_handler - Return a handler for a reset domain message
  * @msg - message to process
@@ -110,6 +120,13 @@ scmi_msg_handler_t scmi_msg_get_clock_handler(struct scmi_msg *msg);
  */
 scmi_msg_handler_t scmi_msg_get_rd_handler(struct scmi_msg *msg);
 
+/*
+ * scmi_msg_get_voltd_handler - Return a handler for a voltage domain message
+ * @msg - message to process
+ * Return a function handler for the message or NULL
+ */
+scmi_msg_handler_t scmi_msg_get_voltd_handler(struct scmi_msg *msg);
+
 /*
  * Process Read, process and write response for input SCMI message
  *
@@ -0,0 +1,426 @@
+// SPDX-License-Identifier: BSD-3-Clause
+/*
+ * Copyright (c) 2015-2020, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2019-2021, Linaro Limited
+ */
+#include <cdefs.h>
+#include <string.h>
+
+#include <common/confine_array_index.h>
+#include <drivers/st/scmi-msg.h>
+#include <drivers/st/scmi.h>
+#include <lib/utils_def.h>
+
+#include "common.h"
+
+#pragma weak plat_scmi_perfd_count
+#pragma weak plat_scmi_perfd_get_name
+#pragma weak plat_scmi_perfd_sustained_level
+#pragma weak plat_scmi_perfd_levels_array
+#pragma weak plat_scmi_perfd_get_level
+#pragma weak plat_scmi_perfd_set_level
+#pragma weak plat_scmi_perfd_get_limits
+#pragma weak plat_scmi_perfd_set_limits
+
+static bool message_id_is_supported(unsigned int message_id);
+
+size_t plat_scmi_perfd_count(unsigned int agent_id __unused)
+{
+	return 0U;
+}
+
+const char *plat_scmi_perfd_get_name(unsigned int agent_id __unused,
+				     unsigned int scmi_id __unused)
+{
+	return NULL;
+}
+
+unsigned int plat_scmi_perfd_sustained_level(unsigned int agent_id __unused,
+					     unsigned int scmi_id __unused)
+{
+	return 0U;
+}
+
+int32_t plat_scmi_perfd_levels_array(unsigned int agent_id __unused,
+				     unsigned int scmi_id __unused,
+				     size_t start_index __unused,
+				     struct scmi_perfd_level *levels __unused,
+				     size_t *nb_elts __unused)
+{
+	return SCMI_NOT_SUPPORTED;
+}
+
+int32_t plat_scmi_perfd_get_level(unsigned int agent_id __unused,
+				  unsigned int scmi_id __unused,
+				  unsigned int *level __unused)
+{
+	return SCMI_NOT_SUPPORTED;
+}
+
+int32_t plat_scmi_perfd_set_level(unsigned int agent_id __unused,
+				  unsigned int scmi_id __unused,
+				  unsigned int level __unused)
+{
+	return SCMI_NOT_SUPPORTED;
+}
+
+int32_t plat_scmi_perfd_get_limits(unsigned int agent_id __unused,
+				   unsigned int scmi_id __unused,
+				   unsigned int *range_max __unused,
+				   unsigned int *range_min __unused)
+{
+	return SCMI_NOT_SUPPORTED;
+}
+
+int32_t plat_scmi_perfd_set_limits(unsigned int agent_id __unused,
+				   unsigned int scmi_id __unused,
+				   unsigned int range_max __unused,
+				   unsigned int range_min __unused)
+{
+	return SCMI_NOT_SUPPORTED;
+}
+
+static void report_version(struct scmi_msg *msg)
+{
+	struct scmi_protocol_version_p2a return_values = {
+		.status = SCMI_SUCCESS,
+		.version = SCMI_PROTOCOL_VERSION_PERF_DOMAIN,
+	};
+
+	if (msg->in_size != 0U) {
+		scmi_status_response(msg, SCMI_PROTOCOL_ERROR);
+		return;
+	}
+
+	scmi_write_response(msg, &return_values, sizeof(return_values));
+}
+
+static void report_attributes(struct scmi_msg *msg)
+{
+	size_t domain_count = plat_scmi_perfd_count(msg->agent_id);
+	struct scmi_perfd_protocol_attributes_p2a return_values = {
+		.status = SCMI_SUCCESS,
+		.attributes = domain_count & SCMI_PERFD_COUNT_MASK,
+	};
+
+	if (msg->in_size != 0U) {
+		scmi_status_response(msg, SCMI_PROTOCOL_ERROR);
+		return;
+	}
+
+	scmi_write_response(msg, &return_values, sizeof(return_values));
+}
+
+static void report_message_attributes(struct scmi_msg *msg)
+{
+	struct scmi_protocol_message_attributes_a2p *in_args = (void *)msg->in;
+	struct scmi_protocol_message_attributes_p2a return_values = {
+		.status = SCMI_SUCCESS,
+		/* For this protocol, attributes shall be zero */
+		.attributes = 0U,
+	};
+
+	if (msg->in_size != sizeof(*in_args)) {
+		scmi_status_response(msg, SCMI_PROTOCOL_ERROR);
+		return;
+	}
+
+	if (!message_id_is_supported(in_args->message_id)) {
+		scmi_status_response(msg, SCMI_NOT_FOUND);
+		return;
+	}
+
+	scmi_write_response(msg, &return_values, sizeof(return_values));
+}
+
+static void scmi_perfd_domain_attributes(struct scmi_msg *msg)
+{
+	const struct scmi_perfd_attributes_a2p *in_args = (void *)msg->in;
+	struct scmi_perfd_attributes_p2a return_values = {
+		.status = SCMI_SUCCESS,
+		.attributes = SCMI_PERFD_ATTR_LIMITS_SET |
+			      SCMI_PERFD_ATTR_LEVEL_SET,
+	};
+	const char *name = NULL;
+	unsigned int domain_id = 0U;
+	unsigned int sustained = 0U;
+
+	if (msg->in_size != sizeof(*in_args)) {
+		scmi_status_response(msg, SCMI_PROTOCOL_ERROR);
+		return;
+	}
+
+	if (in_args->domain_id >= plat_scmi_perfd_count(msg->agent_id)) {
+		scmi_status_response(msg, SCMI_INVALID_PARAMETERS);
+		return;
+	}
+
+	domain_id = confine_array_index(in_args->domain_id,
+					plat_scmi_perfd_count(msg->agent_id));
+
+	name = plat_scmi_perfd_get_name(msg->agent_id, domain_id);
+	if (name == NULL) {
+		scmi_status_response(msg, SCMI_NOT_FOUND);
+		return;
+	}
+
+	COPY_NAME_IDENTIFIER(return_values.name, name);
+
+	/*
+	 * Performance levels are expressed in kilohertz so that the
+	 * level-to-frequency mapping computed by the agent from the
+	 * sustained operating point is the identity.
+	 */
+	sustained = plat_scmi_perfd_sustained_level(msg->agent_id, domain_id);
+	return_values.sustained_freq_khz = sustained;
+	return_values.sustained_perf_level = sustained;
+
+	scmi_write_response(msg, &return_values, sizeof(return_values));
+}
+
+#define LEVELS_ARRAY_SIZE_MAX	(SCMI_PLAYLOAD_MAX - \
+				 sizeof(struct scmi_perfd_describe_levels_p2a))
+
+#define LEVEL_DESC_SIZE		sizeof(struct scmi_perfd_level_desc)
+
+static void write_level_desc_array_in_buffer(char *dest,
+					     struct scmi_perfd_level *levels,
+					     size_t nb_elt)
+{
+	uint32_t *out = (uint32_t *)(uintptr_t)dest;
+	size_t n;
+
+	ASSERT_SYM_PTR_ALIGN(out);
+
+	for (n = 0U; n < nb_elt; n++) {
+		out[3 * n] = levels[n].performance_level;
+		out[(3 * n) + 1] = levels[n].power_cost;
+		out[(3 * n) + 2] = levels[n].latency_us &
+				   SCMI_PERFD_LEVEL_ATTR_LATENCY_MASK;
+	}
+}
+
+static void scmi_perfd_describe_levels(struct scmi_msg *msg)
+{
+	const struct scmi_perfd_describe_levels_a2p *in_args = (void *)msg->in;
+	struct scmi_perfd_describe_levels_p2a p2a = {
+		.status = SCMI_SUCCESS,
+	};
+	size_t nb_levels;
+	int32_t status;
+	unsigned int domain_id;
+
+	if (msg->in_size != sizeof(*in_args)) {
+		scmi_status_response(msg, SCMI_PROTOCOL_ERROR);
+		return;
+	}
+
+	if (in_args->domain_id >= plat_scmi_perfd_count(msg->agent_id)) {
+		scmi_status_response(msg, SCMI_INVALID_PARAMETERS);
+		return;
+	}
+
+	domain_id = confine_array_index(in_args->domain_id,
+					plat_scmi_perfd_count(msg->agent_id));
+
+	status = plat_scmi_perfd_levels_array(msg->agent_id, domain_id, 0U,
+					      NULL, &nb_levels);
+	if (status == SCMI_SUCCESS) {
+		/* Currently a handful of operating points, stack suffices */
+		struct scmi_perfd_level
+			plat_levels[LEVELS_ARRAY_SIZE_MAX / LEVEL_DESC_SIZE];
+		size_t max_nb = LEVELS_ARRAY_SIZE_MAX / LEVEL_DESC_SIZE;
+		size_t ret_nb;
+		size_t rem_nb;
+
+		if (in_args->level_index >= nb_levels) {
+			scmi_status_response(msg, SCMI_INVALID_PARAMETERS);
+			return;
+		}
+
+		ret_nb = MIN(nb_levels - in_args->level_index, max_nb);
+		rem_nb = nb_levels - in_args->level_index - ret_nb;
+
+		status = plat_scmi_perfd_levels_array(msg->agent_id, domain_id,
+						      in_args->level_index,
+						      plat_levels, &ret_nb);
+		if (status == SCMI_SUCCESS) {
+			write_level_desc_array_in_buffer(msg->out + sizeof(p2a),
+							 plat_levels, ret_nb);
+
+			p2a.num_levels_flags =
+				SCMI_PERFD_DESCRIBE_LEVELS_NUM_LEVELS_FLAGS(ret_nb,
+									    rem_nb);
+			p2a.status = SCMI_SUCCESS;
+
+			memcpy(msg->out, &p2a, sizeof(p2a));
+			msg->out_size_out = sizeof(p2a) +
+					    ret_nb * LEVEL_DESC_SIZE;
+		}
+	}
+
+	if (status != SCMI_SUCCESS) {
+		scmi_status_response(msg, status);
+	} else {
+		/*
+		 * Message payload is already writen to msg->out, and
+		 * msg->out_size_out updated.
+		 */
+	}
+}
+
+static void scmi_perfd_limits_set(struct scmi_msg *msg)
+{
+	const struct scmi_perfd_limits_set_a2p *in_args = (void *)msg->in;
+	unsigned int domain_id = 0U;
+	int32_t status;
+
+	if (msg->in_size != sizeof(*in_args)) {
+		scmi_status_response(msg, SCMI_PROTOCOL_ERROR);
+		return;
+	}
+
+	if (in_args->domain_id >= plat_scmi_perfd_count(msg->agent_id)) {
+		scmi_status_response(msg, SCMI_INVALID_PARAMETERS);
+		return;
+	}
+
+	domain_id = confine_array_index(in_args->domain_id,
+					plat_scmi_perfd_count(msg->agent_id));
+
+	status = plat_scmi_perfd_set_limits(msg->agent_id, domain_id,
+					    in_args->range_max,
+					    in_args->range_min);
+
+	scmi_status_response(msg, status);
+}
+
+static void scmi_perfd_limits_get(struct scmi_msg *msg)
+{
+	const struct scmi_perfd_limits_get_a2p *in_args = (void *)msg->in;
+	struct scmi_perfd_limits_get_p2a return_values = {
+		.status = SCMI_SUCCESS,
+	};
+	unsigned int domain_id = 0U;
+	unsigned int range_max = 0U;
+	unsigned int range_min = 0U;
+	int32_t status;
+
+	if (msg->in_size != sizeof(*in_args)) {
+		scmi_status_response(msg, SCMI_PROTOCOL_ERROR);
+		return;
+	}
+
+	if (in_args->domain_id >= plat_scmi_perfd_count(msg->agent_id)) {
+		scmi_status_response(msg, SCMI_INVALID_PARAMETERS);
+		return;
+	}
+
+	domain_id = confine_array_index(in_args->domain_id,
+					plat_scmi_perfd_count(msg->agent_id));
+
+	status = plat_scmi_perfd_get_limits(msg->agent_id, domain_id,
+					    &range_max, &range_min);
+	if (status != SCMI_SUCCESS) {
+		scmi_status_response(msg, status);
+		return;
+	}
+
+	return_values.range_max = range_max;
+	return_values.range_min = range_min;
+
+	scmi_write_response(msg, &return_values, sizeof(return_values));
+}
+
+static void scmi_perfd_level_set(struct scmi_msg *msg)
+{
+	const struct scmi_perfd_level_set_a2p *in_args = (void *)msg->in;
+	unsigned int domain_id = 0U;
+	int32_t status;
+
+	if (msg->in_size != sizeof(*in_args)) {
+		scmi_status_response(msg, SCMI_PROTOCOL_ERROR);
+		return;
+	}
+
+	if (in_args->domain_id >= plat_scmi_perfd_count(msg->agent_id)) {
+		scmi_status_response(msg, SCMI_INVALID_PARAMETERS);
+		return;
+	}
+
+	domain_id = confine_array_index(in_args->domain_id,
+					plat_scmi_perfd_count(msg->agent_id));
+
+	status = plat_scmi_perfd_set_level(msg->agent_id, domain_id,
+					   in_args->performance_level);
+
+	scmi_status_response(msg, status);
+}
+
+static void scmi_perfd_level_get(struct scmi_msg *msg)
+{
+	const struct scmi_perfd_level_get_a2p *in_args = (void *)msg->in;
+	struct scmi_perfd_level_get_p2a return_values = {
+		.status = SCMI_SUCCESS,
+	};
+	unsigned int domain_id = 0U;
+	unsigned int level = 0U;
+	int32_t status;
+
+	if (msg->in_size != sizeof(*in_args)) {
+		scmi_status_response(msg, SCMI_PROTOCOL_ERROR);
+		return;
+	}
+
+	if (in_args->domain_id >= plat_scmi_perfd_count(msg->agent_id)) {
+		scmi_status_response(msg, SCMI_INVALID_PARAMETERS);
+		return;
+	}
+
+	domain_id = confine_array_index(in_args->domain_id,
+					plat_scmi_perfd_count(msg->agent_id));
+
+	status = plat_scmi_perfd_get_level(msg->agent_id, domain_id, &level);
+	if (status != SCMI_SUCCESS) {
+		scmi_status_response(msg, status);
+		return;
+	}
+
+	return_values.performance_level = level;
+
+	scmi_write_response(msg, &return_values, sizeof(return_values));
+}
+
+static const scmi_msg_handler_t scmi_perfd_handler_table[] = {
+	[SCMI_PROTOCOL_VERSION] = report_version,
+	[SCMI_PROTOCOL_ATTRIBUTES] = report_attributes,
+	[SCMI_PROTOCOL_MESSAGE_ATTRIBUTES] = report_message_attributes,
+	[SCMI_PERFD_DOMAIN_ATTRIBUTES] = scmi_perfd_domain_attributes,
+	[SCMI_PERFD_DESCRIBE_LEVELS] = scmi_perfd_describe_levels,
+	[SCMI_PERFD_LIMITS_SET] = scmi_perfd_limits_set,
+	[SCMI_PERFD_LIMITS_GET] = scmi_perfd_limits_get,
+	[SCMI_PERFD_LEVEL_SET] = scmi_perfd_level_set,
+	[SCMI_PERFD_LEVEL_GET] = scmi_perfd_level_get,
+};
+
+static bool message_id_is_supported(unsigned int message_id)
+{
+	return (message_id < ARRAY_SIZE(scmi_perfd_handler_table)) &&
+	       (scmi_perfd_handler_table[message_id] != NULL);
+}
+
+scmi_msg_handler_t scmi_msg_get_perfd_handler(struct scmi_msg *msg)
+{
+	const size_t array_size = ARRAY_SIZE(scmi_perfd_handler_table);
+	unsigned int message_id = 0U;
+
+	if (msg->message_id >= array_size) {
+		VERBOSE("Performance domain handle not found %u\n",
+			msg->message_id);
+		return NULL;
+	}
+
+	message_id = confine_array_index(msg->message_id, array_size);
+
+	return scmi_perfd_handler_table[message_id];
+}
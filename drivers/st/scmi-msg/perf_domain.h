@@ -0,0 +1,154 @@
+/* SPDX-License-Identifier: BSD-3-Clause */
+/*
+ * Copyright (c) 2015-2020, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2019-2021, Linaro Limited
+ */
+#ifndef SCMI_MSG_PERF_DOMAIN_H
+#define SCMI_MSG_PERF_DOMAIN_H
+
+#include <stdint.h>
+
+#include <lib/utils_def.h>
+
+#define SCMI_PROTOCOL_VERSION_PERF_DOMAIN	0x20000U
+
+/*
+ * Identifiers of the SCMI Performance Domain Management Protocol commands
+ */
+enum scmi_perfd_command_id {
+	SCMI_PERFD_DOMAIN_ATTRIBUTES = 0x003,
+	SCMI_PERFD_DESCRIBE_LEVELS = 0x004,
+	SCMI_PERFD_LIMITS_SET = 0x005,
+	SCMI_PERFD_LIMITS_GET = 0x006,
+	SCMI_PERFD_LEVEL_SET = 0x007,
+	SCMI_PERFD_LEVEL_GET = 0x008,
+};
+
+/*
+ * PROTOCOL_ATTRIBUTES
+ */
+
+#define SCMI_PERFD_COUNT_MASK			GENMASK_32(15, 0)
+
+/* Statistics shared memory is not supported, related fields stay zero */
+struct scmi_perfd_protocol_attributes_p2a {
+	int32_t status;
+	uint32_t attributes;
+	uint32_t statistics_address_low;
+	uint32_t statistics_address_high;
+	uint32_t statistics_len;
+};
+
+/*
+ * PERFORMANCE_DOMAIN_ATTRIBUTES
+ */
+
+#define SCMI_PERFD_ATTR_LIMITS_SET		BIT_32(31)
+#define SCMI_PERFD_ATTR_LEVEL_SET		BIT_32(30)
+
+/* Macro for scmi_perfd_attributes_p2a:name */
+#define SCMI_PERFD_ATTR_NAME_SZ			16U
+
+struct scmi_perfd_attributes_a2p {
+	uint32_t domain_id;
+};
+
+struct scmi_perfd_attributes_p2a {
+	int32_t status;
+	uint32_t attributes;
+	uint32_t rate_limit;
+	uint32_t sustained_freq_khz;
+	uint32_t sustained_perf_level;
+	char name[SCMI_PERFD_ATTR_NAME_SZ];
+};
+
+/*
+ * PERFORMANCE_DESCRIBE_LEVELS
+ */
+
+#define SCMI_PERFD_LEVELS_COUNT_MASK		GENMASK_32(11, 0)
+#define SCMI_PERFD_LEVELS_REMAINING_MASK	GENMASK_32(31, 16)
+#define SCMI_PERFD_LEVELS_REMAINING_POS		16
+
+#define SCMI_PERFD_DESCRIBE_LEVELS_NUM_LEVELS_FLAGS(_nb_levels, _rem_levels) \
+	( \
+		((_nb_levels) & SCMI_PERFD_LEVELS_COUNT_MASK) | \
+		(((_rem_levels) << SCMI_PERFD_LEVELS_REMAINING_POS) & \
+		 SCMI_PERFD_LEVELS_REMAINING_MASK) \
+	)
+
+#define SCMI_PERFD_LEVEL_ATTR_LATENCY_MASK	GENMASK_32(15, 0)
+
+struct scmi_perfd_describe_levels_a2p {
+	uint32_t domain_id;
+	uint32_t level_index;
+};
+
+struct scmi_perfd_describe_levels_p2a {
+	int32_t status;
+	uint32_t num_levels_flags;
+	/* Level entries follow in packet payload */
+};
+
+/* Level description entry as carried in the DESCRIBE_LEVELS payload */
+struct scmi_perfd_level_desc {
+	uint32_t performance_level;
+	uint32_t power_cost;
+	uint32_t attributes;
+};
+
+/*
+ * PERFORMANCE_LIMITS_SET
+ */
+
+struct scmi_perfd_limits_set_a2p {
+	uint32_t domain_id;
+	uint32_t range_max;
+	uint32_t range_min;
+};
+
+struct scmi_perfd_limits_set_p2a {
+	int32_t status;
+};
+
+/*
+ * PERFORMANCE_LIMITS_GET
+ */
+
+struct scmi_perfd_limits_get_a2p {
+	uint32_t domain_id;
+};
+
+struct scmi_perfd_limits_get_p2a {
+	int32_t status;
+	uint32_t range_max;
+	uint32_t range_min;
+};
+
+/*
+ * PERFORMANCE_LEVEL_SET
+ */
+
+struct scmi_perfd_level_set_a2p {
+	uint32_t domain_id;
+	uint32_t performance_level;
+};
+
+struct scmi_perfd_level_set_p2a {
+	int32_t status;
+};
+
+/*
+ * PERFORMANCE_LEVEL_GET
+ */
+
+struct scmi_perfd_level_get_a2p {
+	uint32_t domain_id;
+};
+
+struct scmi_perfd_level_get_p2a {
+	int32_t status;
+	uint32_t performance_level;
+};
+
+#endif /* SCMI_MSG_PERF_DOMAIN_H */
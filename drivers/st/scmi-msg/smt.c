@@ -5,9 +5,12 @@
  */
 #include <assert.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <string.h>
 
+#include <arch_helpers.h>
+#include <common/sec_budget.h>
 #include <drivers/st/scmi-msg.h>
 #include <drivers/st/scmi.h>
 #include <lib/cassert.h>
@@ -43,6 +46,33 @@ struct smt_header {
 CASSERT(SCMI_PLAYLOAD_MAX + sizeof(struct smt_header) <= SMT_BUF_SLOT_SIZE,
 	assert_scmi_message_max_length_fits_in_smt_buffer_slot);
 
+/**
+ * struct smt_msg_entry - One message of a batch transfer
+ *
+ * @length: Byte size of message payload (variable) + ::message_header (32bit)
+ * @message_header: SCMI message header
+ * payload: SCMI message payload data
+ *
+ * When SMT_FLAG_BATCH is set in smt_header::flags, the agent packs several
+ * messages in the channel, each message being a 32bit length followed by the
+ * message header and the payload, 32bit aligned. The first message reuses
+ * smt_header::length and ::message_header so a batch of one is a regular SMT
+ * transfer. The server drains the whole batch in a single entry and writes
+ * each response in place over its message: the agent shall pad each queued
+ * message to the size of the expected response. A zero length word or the
+ * end of the shared memory terminates the batch.
+ */
+struct smt_msg_entry {
+	uint32_t length;
+	uint32_t message_header;
+	uint32_t payload[];
+};
+
+CASSERT(offsetof(struct smt_header, message_header) -
+	offsetof(struct smt_header, length) ==
+	offsetof(struct smt_msg_entry, message_header),
+	assert_smt_batch_entry_layout_matches_smt_header);
+
 /* Flag set in smt_header::status when SMT does not contain pending message */
 #define SMT_STATUS_FREE			BIT(0)
 /* Flag set in smt_header::status when SMT reports an error */
@@ -50,6 +80,8 @@ CASSERT(SCMI_PLAYLOAD_MAX + sizeof(struct smt_header) <= SMT_BUF_SLOT_SIZE,
 
 /* Flag set in smt_header::flags when SMT uses interrupts */
 #define SMT_FLAG_INTR_ENABLED		BIT(1)
+/* Flag set in smt_header::flags when the channel carries a message batch */
+#define SMT_FLAG_BATCH			BIT(2)
 
 /* Bit fields packed in smt_header::message_header */
 #define SMT_MSG_ID_MASK			GENMASK_32(7, 0)
@@ -61,12 +93,14 @@ CASSERT(SCMI_PLAYLOAD_MAX + sizeof(struct smt_header) <= SMT_BUF_SLOT_SIZE,
 #define SMT_MSG_PROT_ID_MASK		GENMASK_32(17, 10)
 #define SMT_HDR_PROT_ID(_hdr)		(((_hdr) & SMT_MSG_PROT_ID_MASK) >> 10)
 
+#if !SCMI_SMT_ZERO_COPY
 /*
  * Provision input message payload buffers for fastcall SMC context entries
  * and for interrupt context execution entries.
  */
 static uint32_t fast_smc_payload[PLATFORM_CORE_COUNT][SCMI_PLAYLOAD_U32_MAX];
 static uint32_t interrupt_payload[PLATFORM_CORE_COUNT][SCMI_PLAYLOAD_U32_MAX];
+#endif
 
 /* SMP protection on channel access */
 static struct spinlock smt_channels_lock;
@@ -105,14 +139,18 @@ static struct smt_header *channel_to_smt_hdr(struct scmi_msg_channel *chan)
  * references to input payload in secure memory and output message buffer
  * in shared memory.
  */
-static void scmi_proccess_smt(unsigned int agent_id, uint32_t *payload_buf)
+static void scmi_proccess_smt(unsigned int agent_id,
+			      uint32_t *payload_buf __unused)
 {
 	struct scmi_msg_channel *chan;
 	struct smt_header *smt_hdr;
+	struct smt_msg_entry *entry;
 	size_t in_payload_size;
 	uint32_t smt_status;
 	struct scmi_msg msg;
+	uintptr_t shm_end;
 	bool error = true;
+	bool batch;
 
 	chan = plat_scmi_get_channel(agent_id);
 	if (chan == NULL) {
@@ -122,6 +160,16 @@ static void scmi_proccess_smt(unsigned int agent_id, uint32_t *payload_buf)
 	smt_hdr = channel_to_smt_hdr(chan);
 	assert(smt_hdr);
 
+#if SCMI_SMT_ZERO_COPY
+	/*
+	 * The agent posts messages through an uncached mapping: discard any
+	 * cached copy of the area before reading it. The processing below
+	 * then works on this snapshot, agent writes racing with it are not
+	 * observed.
+	 */
+	inv_dcache_range(chan->shm_addr, chan->shm_size);
+#endif
+
 	smt_status = __atomic_load_n(&smt_hdr->status, __ATOMIC_RELAXED);
 
 	if (!channel_set_busy(chan)) {
@@ -129,63 +177,141 @@ static void scmi_proccess_smt(unsigned int agent_id, uint32_t *payload_buf)
 		goto out;
 	}
 
-	in_payload_size = __atomic_load_n(&smt_hdr->length, __ATOMIC_RELAXED) -
-			  sizeof(smt_hdr->message_header);
-
-	if (in_payload_size > SCMI_PLAYLOAD_MAX) {
-		VERBOSE("SCMI payload too big %u", in_payload_size);
-		goto out;
-	}
-
 	if (smt_status & (SMT_STATUS_ERROR | SMT_STATUS_FREE)) {
 		VERBOSE("SCMI channel bad status 0x%x",
 			smt_hdr->status & (SMT_STATUS_ERROR | SMT_STATUS_FREE));
 		goto out;
 	}
 
-	/* Fill message */
-	zeromem(&msg, sizeof(msg));
-	msg.in = (char *)payload_buf;
-	msg.in_size = in_payload_size;
-	msg.out = (char *)smt_hdr->payload;
-	msg.out_size = chan->shm_size - sizeof(*smt_hdr);
+	batch = (__atomic_load_n(&smt_hdr->flags, __ATOMIC_RELAXED) &
+		 SMT_FLAG_BATCH) != 0U;
+	shm_end = chan->shm_addr + chan->shm_size;
+	entry = (struct smt_msg_entry *)&smt_hdr->length;
+
+	/* Drain all messages queued in the channel in this single entry */
+	while (true) {
+		in_payload_size = __atomic_load_n(&entry->length,
+						  __ATOMIC_RELAXED) -
+				  sizeof(entry->message_header);
+
+		if ((in_payload_size > SCMI_PLAYLOAD_MAX) ||
+		    (((uintptr_t)entry->payload + in_payload_size) >
+		     shm_end)) {
+			VERBOSE("SCMI payload too big %u", in_payload_size);
+			goto out;
+		}
 
-	assert(msg.out && msg.out_size >= sizeof(int32_t));
+		if (batch && (in_payload_size < sizeof(int32_t))) {
+			VERBOSE("SCMI batched message too small %u",
+				in_payload_size);
+			goto out;
+		}
 
-	/* Here the payload is copied in secure memory */
-	memcpy(msg.in, smt_hdr->payload, in_payload_size);
+		/* Fill message */
+		zeromem(&msg, sizeof(msg));
+#if SCMI_SMT_ZERO_COPY
+		/*
+		 * Handlers parse the payload in place in the shared area.
+		 * They read each input field before writing the response
+		 * over it, and confine index parameters after validation.
+		 */
+		msg.in = (char *)entry->payload;
+#else
+		msg.in = (char *)payload_buf;
+#endif
+		msg.in_size = in_payload_size;
+		msg.out = (char *)entry->payload;
+		/*
+		 * In a batch, the response shall not spill over the next
+		 * queued message, hence it is bound to the message size.
+		 */
+		msg.out_size = batch ? in_payload_size :
+			       (size_t)(shm_end - (uintptr_t)entry->payload);
+
+		assert(msg.out && msg.out_size >= sizeof(int32_t));
+
+#if !SCMI_SMT_ZERO_COPY
+		/* Here the payload is copied in secure memory */
+		memcpy(msg.in, entry->payload, in_payload_size);
+#endif
+
+		msg.protocol_id = SMT_HDR_PROT_ID(entry->message_header);
+		msg.message_id = SMT_HDR_MSG_ID(entry->message_header);
+		msg.agent_id = agent_id;
+
+		scmi_process_message(&msg);
+
+		/* Update message length with the length of the response */
+		entry->length = msg.out_size_out +
+				sizeof(entry->message_header);
+
+		if (!batch) {
+			break;
+		}
 
-	msg.protocol_id = SMT_HDR_PROT_ID(smt_hdr->message_header);
-	msg.message_id = SMT_HDR_MSG_ID(smt_hdr->message_header);
-	msg.agent_id = agent_id;
+		/*
+		 * Secure budget checkpoint: rather than overrunning the
+		 * execution budget, leave the remaining queued messages
+		 * unconsumed. Their in-place responses are unwritten, which
+		 * is how the agent detects the partial drain and re-rings
+		 * the doorbell for the remainder.
+		 */
+		if (sec_budget_exhausted()) {
+			break;
+		}
 
-	scmi_process_message(&msg);
+		entry = (struct smt_msg_entry *)((uintptr_t)entry->payload +
+						 round_up(in_payload_size,
+							  sizeof(uint32_t)));
 
-	/* Update message length with the length of the response message */
-	smt_hdr->length = msg.out_size_out + sizeof(smt_hdr->message_header);
+		if ((((uintptr_t)entry + sizeof(*entry)) > shm_end) ||
+		    (__atomic_load_n(&entry->length, __ATOMIC_RELAXED) ==
+		     0U)) {
+			break;
+		}
+	}
 
 	channel_release_busy(chan);
 	error = false;
 
 out:
+#if SCMI_SMT_ZERO_COPY
+	/*
+	 * Make the responses visible to the agent's uncached reads before
+	 * the channel is reported free.
+	 */
+	clean_dcache_range(chan->shm_addr, chan->shm_size);
+#endif
 	if (error) {
 		VERBOSE("SCMI error");
 		smt_hdr->status |= SMT_STATUS_ERROR | SMT_STATUS_FREE;
 	} else {
 		smt_hdr->status |= SMT_STATUS_FREE;
 	}
+#if SCMI_SMT_ZERO_COPY
+	clean_dcache_range((uintptr_t)&smt_hdr->status,
+			   sizeof(smt_hdr->status));
+#endif
 }
 
 void scmi_smt_fastcall_smc_entry(unsigned int agent_id)
 {
+#if SCMI_SMT_ZERO_COPY
+	scmi_proccess_smt(agent_id, NULL);
+#else
 	scmi_proccess_smt(agent_id,
 			  fast_smc_payload[plat_my_core_pos()]);
+#endif
 }
 
 void scmi_smt_interrupt_entry(unsigned int agent_id)
 {
+#if SCMI_SMT_ZERO_COPY
+	scmi_proccess_smt(agent_id, NULL);
+#else
 	scmi_proccess_smt(agent_id,
 			  interrupt_payload[plat_my_core_pos()]);
+#endif
 }
 
 /* Init a SMT header for a shared memory buffer: state it a free/no-error */
@@ -197,6 +323,10 @@ void scmi_smt_init_agent_channel(struct scmi_msg_channel *chan)
 		if (smt_header != NULL) {
 			memset(smt_header, 0, sizeof(*smt_header));
 			smt_header->status = SMT_STATUS_FREE;
+#if SCMI_SMT_ZERO_COPY
+			flush_dcache_range((uintptr_t)smt_header,
+					   sizeof(*smt_header));
+#endif
 
 			return;
 		}
@@ -0,0 +1,425 @@
+// SPDX-License-Identifier: BSD-3-Clause
+/*
+ * Copyright (c) 2015-2020, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2019-2021, Linaro Limited
+ */
+#include <cdefs.h>
+#include <string.h>
+
+#include <common/confine_array_index.h>
+#include <drivers/st/scmi-msg.h>
+#include <drivers/st/scmi.h>
+#include <lib/utils_def.h>
+
+#include "common.h"
+
+#pragma weak plat_scmi_voltd_count
+#pragma weak plat_scmi_voltd_get_name
+#pragma weak plat_scmi_voltd_levels_array
+#pragma weak plat_scmi_voltd_levels_by_step
+#pragma weak plat_scmi_voltd_get_level
+#pragma weak plat_scmi_voltd_set_level
+#pragma weak plat_scmi_voltd_get_config
+#pragma weak plat_scmi_voltd_set_config
+
+static bool message_id_is_supported(unsigned int message_id);
+
+size_t plat_scmi_voltd_count(unsigned int agent_id __unused)
+{
+	return 0U;
+}
+
+const char *plat_scmi_voltd_get_name(unsigned int agent_id __unused,
+				     unsigned int scmi_id __unused)
+{
+	return NULL;
+}
+
+int32_t plat_scmi_voltd_levels_array(unsigned int agent_id __unused,
+				     unsigned int scmi_id __unused,
+				     size_t start_index __unused,
+				     long *levels __unused,
+				     size_t *nb_elts __unused)
+{
+	return SCMI_NOT_SUPPORTED;
+}
+
+int32_t plat_scmi_voltd_levels_by_step(unsigned int agent_id __unused,
+				       unsigned int scmi_id __unused,
+				       long *min_max_step __unused)
+{
+	return SCMI_NOT_SUPPORTED;
+}
+
+int32_t plat_scmi_voltd_get_level(unsigned int agent_id __unused,
+				  unsigned int scmi_id __unused,
+				  long *level_uv __unused)
+{
+	return SCMI_NOT_SUPPORTED;
+}
+
+int32_t plat_scmi_voltd_set_level(unsigned int agent_id __unused,
+				  unsigned int scmi_id __unused,
+				  long level_uv __unused)
+{
+	return SCMI_NOT_SUPPORTED;
+}
+
+int32_t plat_scmi_voltd_get_config(unsigned int agent_id __unused,
+				   unsigned int scmi_id __unused,
+				   uint32_t *config __unused)
+{
+	return SCMI_NOT_SUPPORTED;
+}
+
+int32_t plat_scmi_voltd_set_config(unsigned int agent_id __unused,
+				   unsigned int scmi_id __unused,
+				   uint32_t config __unused)
+{
+	return SCMI_NOT_SUPPORTED;
+}
+
+static void report_version(struct scmi_msg *msg)
+{
+	struct scmi_protocol_version_p2a return_values = {
+		.status = SCMI_SUCCESS,
+		.version = SCMI_PROTOCOL_VERSION_VOLTAGE_DOMAIN,
+	};
+
+	if (msg->in_size != 0U) {
+		scmi_status_response(msg, SCMI_PROTOCOL_ERROR);
+		return;
+	}
+
+	scmi_write_response(msg, &return_values, sizeof(return_values));
+}
+
+static void report_attributes(struct scmi_msg *msg)
+{
+	size_t domain_count = plat_scmi_voltd_count(msg->agent_id);
+	struct scmi_protocol_attributes_p2a return_values = {
+		.status = SCMI_SUCCESS,
+		.attributes = domain_count & SCMI_VOLTAGE_DOMAIN_COUNT_MASK,
+	};
+
+	if (msg->in_size != 0U) {
+		scmi_status_response(msg, SCMI_PROTOCOL_ERROR);
+		return;
+	}
+
+	scmi_write_response(msg, &return_values, sizeof(return_values));
+}
+
+static void report_message_attributes(struct scmi_msg *msg)
+{
+	struct scmi_protocol_message_attributes_a2p *in_args = (void *)msg->in;
+	struct scmi_protocol_message_attributes_p2a return_values = {
+		.status = SCMI_SUCCESS,
+		/* For this protocol, attributes shall be zero */
+		.attributes = 0U,
+	};
+
+	if (msg->in_size != sizeof(*in_args)) {
+		scmi_status_response(msg, SCMI_PROTOCOL_ERROR);
+		return;
+	}
+
+	if (!message_id_is_supported(in_args->message_id)) {
+		scmi_status_response(msg, SCMI_NOT_FOUND);
+		return;
+	}
+
+	scmi_write_response(msg, &return_values, sizeof(return_values));
+}
+
+static void scmi_voltd_domain_attributes(struct scmi_msg *msg)
+{
+	const struct scmi_voltd_attributes_a2p *in_args = (void *)msg->in;
+	struct scmi_voltd_attributes_p2a return_values = {
+		.status = SCMI_SUCCESS,
+	};
+	const char *name = NULL;
+	unsigned int domain_id = 0U;
+
+	if (msg->in_size != sizeof(*in_args)) {
+		scmi_status_response(msg, SCMI_PROTOCOL_ERROR);
+		return;
+	}
+
+	if (in_args->domain_id >= plat_scmi_voltd_count(msg->agent_id)) {
+		scmi_status_response(msg, SCMI_INVALID_PARAMETERS);
+		return;
+	}
+
+	domain_id = confine_array_index(in_args->domain_id,
+					plat_scmi_voltd_count(msg->agent_id));
+
+	name = plat_scmi_voltd_get_name(msg->agent_id, domain_id);
+	if (name == NULL) {
+		scmi_status_response(msg, SCMI_NOT_FOUND);
+		return;
+	}
+
+	COPY_NAME_IDENTIFIER(return_values.name, name);
+
+	scmi_write_response(msg, &return_values, sizeof(return_values));
+}
+
+#define LEVELS_ARRAY_SIZE_MAX	(SCMI_PLAYLOAD_MAX - \
+				 sizeof(struct scmi_voltd_describe_levels_p2a))
+
+#define SCMI_LEVELS_BY_ARRAY(_nb_levels, _rem_levels) \
+	SCMI_VOLTD_DESCRIBE_LEVELS_FLAGS((_nb_levels), \
+					 SCMI_VOLTD_LEVELS_FORMAT_LIST, \
+					 (_rem_levels))
+#define SCMI_LEVELS_BY_STEP \
+	SCMI_VOLTD_DESCRIBE_LEVELS_FLAGS(3U, \
+					 SCMI_VOLTD_LEVELS_FORMAT_RANGE, \
+					 0U)
+
+#define LEVEL_DESC_SIZE		sizeof(int32_t)
+
+static void write_level_desc_array_in_buffer(char *dest, long *levels,
+					     size_t nb_elt)
+{
+	int32_t *out = (int32_t *)(uintptr_t)dest;
+	size_t n;
+
+	ASSERT_SYM_PTR_ALIGN(out);
+
+	for (n = 0U; n < nb_elt; n++) {
+		out[n] = (int32_t)levels[n];
+	}
+}
+
+static void scmi_voltd_describe_levels(struct scmi_msg *msg)
+{
+	const struct scmi_voltd_describe_levels_a2p *in_args = (void *)msg->in;
+	struct scmi_voltd_describe_levels_p2a p2a = {
+		.status = SCMI_SUCCESS,
+	};
+	size_t nb_levels;
+	int32_t status;
+	unsigned int domain_id;
+
+	if (msg->in_size != sizeof(*in_args)) {
+		scmi_status_response(msg, SCMI_PROTOCOL_ERROR);
+		return;
+	}
+
+	if (in_args->domain_id >= plat_scmi_voltd_count(msg->agent_id)) {
+		scmi_status_response(msg, SCMI_INVALID_PARAMETERS);
+		return;
+	}
+
+	domain_id = confine_array_index(in_args->domain_id,
+					plat_scmi_voltd_count(msg->agent_id));
+
+	/* Platform may support array level description */
+	status = plat_scmi_voltd_levels_array(msg->agent_id, domain_id, 0U,
+					      NULL, &nb_levels);
+	if (status == SCMI_SUCCESS) {
+		/* Currently 21 cells max, so it's affordable for the stack */
+		long plat_levels[LEVELS_ARRAY_SIZE_MAX / LEVEL_DESC_SIZE];
+		size_t max_nb = LEVELS_ARRAY_SIZE_MAX / LEVEL_DESC_SIZE;
+		size_t ret_nb = MIN(nb_levels - in_args->level_index, max_nb);
+		size_t rem_nb = nb_levels - in_args->level_index - ret_nb;
+
+		status = plat_scmi_voltd_levels_array(msg->agent_id, domain_id,
+						      in_args->level_index,
+						      plat_levels, &ret_nb);
+		if (status == SCMI_SUCCESS) {
+			write_level_desc_array_in_buffer(msg->out + sizeof(p2a),
+							 plat_levels, ret_nb);
+
+			p2a.flags = SCMI_LEVELS_BY_ARRAY(ret_nb, rem_nb);
+			p2a.status = SCMI_SUCCESS;
+
+			memcpy(msg->out, &p2a, sizeof(p2a));
+			msg->out_size_out = sizeof(p2a) +
+					    ret_nb * LEVEL_DESC_SIZE;
+		}
+	} else if (status == SCMI_NOT_SUPPORTED) {
+		long triplet[3] = { 0L, 0L, 0L };
+
+		/* Platform may support min/max/step triplet description */
+		status = plat_scmi_voltd_levels_by_step(msg->agent_id,
+							domain_id, triplet);
+		if (status == SCMI_SUCCESS) {
+			write_level_desc_array_in_buffer(msg->out + sizeof(p2a),
+							 triplet, 3U);
+
+			p2a.flags = SCMI_LEVELS_BY_STEP;
+			p2a.status = SCMI_SUCCESS;
+
+			memcpy(msg->out, &p2a, sizeof(p2a));
+			msg->out_size_out = sizeof(p2a) +
+					    (3U * LEVEL_DESC_SIZE);
+		}
+	} else {
+		/* Fallthrough generic exit sequence below with error status */
+	}
+
+	if (status != SCMI_SUCCESS) {
+		scmi_status_response(msg, status);
+	} else {
+		/*
+		 * Message payload is already writen to msg->out, and
+		 * msg->out_size_out updated.
+		 */
+	}
+}
+
+static void scmi_voltd_config_set(struct scmi_msg *msg)
+{
+	const struct scmi_voltd_config_set_a2p *in_args = (void *)msg->in;
+	unsigned int domain_id = 0U;
+	int32_t status;
+
+	if (msg->in_size != sizeof(*in_args)) {
+		scmi_status_response(msg, SCMI_PROTOCOL_ERROR);
+		return;
+	}
+
+	if (in_args->domain_id >= plat_scmi_voltd_count(msg->agent_id)) {
+		scmi_status_response(msg, SCMI_INVALID_PARAMETERS);
+		return;
+	}
+
+	domain_id = confine_array_index(in_args->domain_id,
+					plat_scmi_voltd_count(msg->agent_id));
+
+	status = plat_scmi_voltd_set_config(msg->agent_id, domain_id,
+					    in_args->config &
+					    SCMI_VOLTD_CONFIG_MASK);
+
+	scmi_status_response(msg, status);
+}
+
+static void scmi_voltd_config_get(struct scmi_msg *msg)
+{
+	const struct scmi_voltd_config_get_a2p *in_args = (void *)msg->in;
+	struct scmi_voltd_config_get_p2a return_values = {
+		.status = SCMI_SUCCESS,
+	};
+	unsigned int domain_id = 0U;
+	uint32_t config = 0U;
+	int32_t status;
+
+	if (msg->in_size != sizeof(*in_args)) {
+		scmi_status_response(msg, SCMI_PROTOCOL_ERROR);
+		return;
+	}
+
+	if (in_args->domain_id >= plat_scmi_voltd_count(msg->agent_id)) {
+		scmi_status_response(msg, SCMI_INVALID_PARAMETERS);
+		return;
+	}
+
+	domain_id = confine_array_index(in_args->domain_id,
+					plat_scmi_voltd_count(msg->agent_id));
+
+	status = plat_scmi_voltd_get_config(msg->agent_id, domain_id, &config);
+	if (status != SCMI_SUCCESS) {
+		scmi_status_response(msg, status);
+		return;
+	}
+
+	return_values.config = config;
+
+	scmi_write_response(msg, &return_values, sizeof(return_values));
+}
+
+static void scmi_voltd_level_set(struct scmi_msg *msg)
+{
+	const struct scmi_voltd_level_set_a2p *in_args = (void *)msg->in;
+	unsigned int domain_id = 0U;
+	int32_t status;
+
+	if (msg->in_size != sizeof(*in_args)) {
+		scmi_status_response(msg, SCMI_PROTOCOL_ERROR);
+		return;
+	}
+
+	if (in_args->domain_id >= plat_scmi_voltd_count(msg->agent_id)) {
+		scmi_status_response(msg, SCMI_INVALID_PARAMETERS);
+		return;
+	}
+
+	domain_id = confine_array_index(in_args->domain_id,
+					plat_scmi_voltd_count(msg->agent_id));
+
+	status = plat_scmi_voltd_set_level(msg->agent_id, domain_id,
+					   in_args->voltage_level);
+
+	scmi_status_response(msg, status);
+}
+
+static void scmi_voltd_level_get(struct scmi_msg *msg)
+{
+	const struct scmi_voltd_level_get_a2p *in_args = (void *)msg->in;
+	struct scmi_voltd_level_get_p2a return_values = {
+		.status = SCMI_SUCCESS,
+	};
+	unsigned int domain_id = 0U;
+	long level_uv = 0L;
+	int32_t status;
+
+	if (msg->in_size != sizeof(*in_args)) {
+		scmi_status_response(msg, SCMI_PROTOCOL_ERROR);
+		return;
+	}
+
+	if (in_args->domain_id >= plat_scmi_voltd_count(msg->agent_id)) {
+		scmi_status_response(msg, SCMI_INVALID_PARAMETERS);
+		return;
+	}
+
+	domain_id = confine_array_index(in_args->domain_id,
+					plat_scmi_voltd_count(msg->agent_id));
+
+	status = plat_scmi_voltd_get_level(msg->agent_id, domain_id,
+					   &level_uv);
+	if (status != SCMI_SUCCESS) {
+		scmi_status_response(msg, status);
+		return;
+	}
+
+	return_values.voltage_level = (int32_t)level_uv;
+
+	scmi_write_response(msg, &return_values, sizeof(return_values));
+}
+
+static const scmi_msg_handler_t scmi_voltd_handler_table[] = {
+	[SCMI_PROTOCOL_VERSION] = report_version,
+	[SCMI_PROTOCOL_ATTRIBUTES] = report_attributes,
+	[SCMI_PROTOCOL_MESSAGE_ATTRIBUTES] = report_message_attributes,
+	[SCMI_VOLTAGE_DOMAIN_ATTRIBUTES] = scmi_voltd_domain_attributes,
+	[SCMI_VOLTAGE_DESCRIBE_LEVELS] = scmi_voltd_describe_levels,
+	[SCMI_VOLTAGE_CONFIG_SET] = scmi_voltd_config_set,
+	[SCMI_VOLTAGE_CONFIG_GET] = scmi_voltd_config_get,
+	[SCMI_VOLTAGE_LEVEL_SET] = scmi_voltd_level_set,
+	[SCMI_VOLTAGE_LEVEL_GET] = scmi_voltd_level_get,
+};
+
+static bool message_id_is_supported(unsigned int message_id)
+{
+	return (message_id < ARRAY_SIZE(scmi_voltd_handler_table)) &&
+	       (scmi_voltd_handler_table[message_id] != NULL);
+}
+
+scmi_msg_handler_t scmi_msg_get_voltd_handler(struct scmi_msg *msg)
+{
+	const size_t array_size = ARRAY_SIZE(scmi_voltd_handler_table);
+	unsigned int message_id = 0U;
+
+	if (msg->message_id >= array_size) {
+		VERBOSE("Voltage domain handle not found %u\n",
+			msg->message_id);
+		return NULL;
+	}
+
+	message_id = confine_array_index(msg->message_id, array_size);
+
+	return scmi_voltd_handler_table[message_id];
+}
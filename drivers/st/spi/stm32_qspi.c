@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: GPL-2.0+ OR BSD-3-Clause
  */
 
+#include <stdbool.h>
+
 #include <libfdt.h>
 
 #include <platform_def.h>
@@ -67,6 +69,10 @@
 #define QSPI_SR_SMF		BIT(3)
 #define QSPI_SR_TOF		BIT(4)
 #define QSPI_SR_BUSY		BIT(5)
+#define QSPI_SR_FLEVEL_MASK	GENMASK_32(13, 8)
+#define QSPI_SR_FLEVEL_SHIFT	8U
+
+#define QSPI_FIFO_SIZE		16U
 
 /* QUADSPI flag clear register */
 #define QSPI_FCR_CTEF		BIT(0)
@@ -107,6 +113,7 @@ struct stm32_qspi_ctrl {
 	size_t mm_size;
 	unsigned long clock_id;
 	unsigned int reset_id;
+	bool dual_flash;
 };
 
 static struct stm32_qspi_ctrl stm32_qspi;
@@ -162,42 +169,66 @@ static int stm32_qspi_wait_cmd(const struct spi_mem_op *op)
 	return ret;
 }
 
-static void stm32_qspi_read_fifo(uint8_t *val, uintptr_t addr)
-{
-	*val = mmio_read_8(addr);
-}
-
-static void stm32_qspi_write_fifo(uint8_t *val, uintptr_t addr)
-{
-	mmio_write_8(addr, *val);
-}
-
+/*
+ * Move data through the FIFO in bursts sized by the FIFO fill level
+ * instead of one byte per status poll, using word accesses while the
+ * buffer alignment allows. This keeps the FIFO streaming at the flash
+ * bandwidth for the indirect transfers which cannot use the memory
+ * mapped window (writes, and reads beyond it).
+ */
 static int stm32_qspi_poll(const struct spi_mem_op *op)
 {
-	void (*fifo)(uint8_t *val, uintptr_t addr);
-	uint32_t len;
-	uint8_t *buf;
-
-	if (op->data.dir == SPI_MEM_DATA_IN) {
-		fifo = stm32_qspi_read_fifo;
-	} else {
-		fifo = stm32_qspi_write_fifo;
-	}
-
-	buf = (uint8_t *)op->data.buf;
+	bool read = (op->data.dir == SPI_MEM_DATA_IN);
+	uint32_t len = op->data.nbytes;
+	uint8_t *buf = (uint8_t *)op->data.buf;
 
-	for (len = op->data.nbytes; len != 0U; len--) {
+	while (len != 0U) {
 		uint64_t timeout = timeout_init_us(QSPI_FIFO_TIMEOUT_US);
+		uint32_t avail;
+
+		/* Wait for data in the FIFO (read) or room in it (write) */
+		for ( ; ; ) {
+			avail = (mmio_read_32(qspi_base() + QSPI_SR) &
+				 QSPI_SR_FLEVEL_MASK) >> QSPI_SR_FLEVEL_SHIFT;
+			if (!read) {
+				avail = QSPI_FIFO_SIZE - avail;
+			}
+
+			if (avail != 0U) {
+				break;
+			}
 
-		while ((mmio_read_32(qspi_base() + QSPI_SR) &
-			QSPI_SR_FTF) == 0U) {
 			if (timeout_elapsed(timeout)) {
 				ERROR("%s: fifo timeout\n", __func__);
 				return -ETIMEDOUT;
 			}
 		}
 
-		fifo(buf++, qspi_base() + QSPI_DR);
+		avail = MIN(avail, len);
+		len -= avail;
+
+		while ((avail >= sizeof(uint32_t)) &&
+		       (((uintptr_t)buf & 3U) == 0U)) {
+			if (read) {
+				*(uint32_t *)buf =
+					mmio_read_32(qspi_base() + QSPI_DR);
+			} else {
+				mmio_write_32(qspi_base() + QSPI_DR,
+					      *(uint32_t *)buf);
+			}
+			buf += sizeof(uint32_t);
+			avail -= sizeof(uint32_t);
+		}
+
+		while (avail != 0U) {
+			if (read) {
+				*buf = mmio_read_8(qspi_base() + QSPI_DR);
+			} else {
+				mmio_write_8(qspi_base() + QSPI_DR, *buf);
+			}
+			buf++;
+			avail--;
+		}
 	}
 
 	return 0;
@@ -252,6 +283,24 @@ static int stm32_qspi_exec_op(const struct spi_mem_op *op)
 		return ret;
 	}
 
+	/*
+	 * In dual-flash mode every bus beat moves one byte per flash, so an
+	 * indirect transfer must be even in length and start on an even
+	 * address. Memory mapped reads are byte-addressed by the window and
+	 * have no such constraint.
+	 */
+	if (stm32_qspi.dual_flash && (op->data.nbytes != 0U) &&
+	    (((op->data.nbytes & 1U) != 0U) || ((op->addr.val & 1ULL) != 0U))) {
+		size_t mm_max = op->addr.val + op->data.nbytes + 1U;
+
+		if ((op->data.dir != SPI_MEM_DATA_IN) ||
+		    (mm_max >= stm32_qspi.mm_size) ||
+		    (op->addr.buswidth == 0U)) {
+			ERROR("%s: unaligned dual-flash access\n", __func__);
+			return -EINVAL;
+		}
+	}
+
 	addr_max = op->addr.val + op->data.nbytes + 1U;
 
 	if ((op->data.dir == SPI_MEM_DATA_IN) && (op->data.nbytes != 0U)) {
@@ -345,7 +394,8 @@ static int stm32_qspi_claim_bus(unsigned int cs)
 
 	/* Set chip select and enable the controller */
 	cr = QSPI_CR_EN;
-	if (cs == 1U) {
+	if (!stm32_qspi.dual_flash && (cs == 1U)) {
+		/* FSEL is ignored while both flashes are driven */
 		cr |= QSPI_CR_FSEL;
 	}
 
@@ -416,6 +466,20 @@ static int stm32_qspi_set_mode(unsigned int mode)
 		return -ENODEV;
 	}
 
+	/*
+	 * Dual-flash mode reads the two devices in parallel with byte
+	 * interleaving, doubling the sustained read bandwidth. Commands and
+	 * addresses are broadcast to both flashes, which must be identical
+	 * and hold the de-interleaved halves of the image (see the fiptool
+	 * "interleave" command).
+	 */
+	stm32_qspi.dual_flash = (mode & SPI_DUAL_FLASH) != 0U;
+	if (stm32_qspi.dual_flash) {
+		mmio_setbits_32(qspi_base() + QSPI_CR, QSPI_CR_DFM);
+	} else {
+		mmio_clrbits_32(qspi_base() + QSPI_CR, QSPI_CR_DFM);
+	}
+
 	VERBOSE("%s: mode=0x%x\n", __func__, mode);
 
 	if ((mode & SPI_RX_QUAD) != 0U) {
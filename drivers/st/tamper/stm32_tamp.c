@@ -16,6 +16,7 @@
 #include <drivers/st/stm32_rtc.h>
 #include <drivers/st/stm32_tamp.h>
 #include <lib/mmio.h>
+#include <lib/spinlock.h>
 
 #define DT_TAMP_COMPAT			"st,stm32-tamp"
 /* STM32 Registers */
@@ -98,6 +99,21 @@ struct stm32_tamp_instance {
 
 static struct stm32_tamp_instance stm32_tamp;
 
+/*
+ * Events latched by the interrupt handler and drained from the idle
+ * path. The interrupt context only snapshots and acknowledges the
+ * hardware state; classification, event callbacks and logging run at
+ * low priority from stm32_tamp_drain_events(). The spinlock orders the
+ * handler against a drain running on another core; the drain is called
+ * with FIQs masked, so the lock is never taken recursively on one core.
+ */
+static struct {
+	struct spinlock lock;
+	uint32_t pending;
+	bool ts_valid;
+	struct stm32_rtc_calendar ts;
+} stm32_tamp_events;
+
 static void stm32_tamp_set_secured(unsigned long base)
 {
 	mmio_clrbits_32(base + STM32_TAMP_SMCR, STM32_TAMP_SMCR_DPROT);
@@ -257,13 +273,52 @@ void stm32_tamp_configure_external(struct stm32_tamp_ext *ext_tamper_list,
 void stm32_tamp_it_handler(void)
 {
 	uint32_t it = mmio_read_32(stm32_tamp.base + STM32_TAMP_SR);
+	struct stm32_rtc_calendar ts;
+	bool ts_latched;
+
+	/* Raw timestamp registers only; decoding is deferred too */
+	ts_latched = stm32_rtc_latch_timestamp(&ts);
+
+	/* Acknowledge the hardware, deferring the event handling */
+	mmio_setbits_32(stm32_tamp.base + STM32_TAMP_SCR, it);
+
+	spin_lock(&stm32_tamp_events.lock);
+
+	stm32_tamp_events.pending |= it;
+	if (ts_latched && !stm32_tamp_events.ts_valid) {
+		stm32_tamp_events.ts = ts;
+		stm32_tamp_events.ts_valid = true;
+	}
+
+	spin_unlock(&stm32_tamp_events.lock);
+}
+
+void stm32_tamp_drain_events(void)
+{
+	uint32_t it;
 	uint8_t tamp = 0;
+	bool ts_valid;
+	struct stm32_rtc_calendar ts;
 	struct stm32_rtc_time tamp_ts;
 	struct stm32_tamp_int *int_list = stm32_tamp.int_tamp;
 	struct stm32_tamp_ext *ext_list = stm32_tamp.ext_tamp;
 
-	if (stm32_rtc_is_timestamp_enable()) {
-		stm32_rtc_get_timestamp(&tamp_ts);
+	if (stm32_tamp_events.pending == 0U) {
+		return;
+	}
+
+	spin_lock(&stm32_tamp_events.lock);
+
+	it = stm32_tamp_events.pending;
+	stm32_tamp_events.pending = 0U;
+	ts_valid = stm32_tamp_events.ts_valid;
+	ts = stm32_tamp_events.ts;
+	stm32_tamp_events.ts_valid = false;
+
+	spin_unlock(&stm32_tamp_events.lock);
+
+	if (ts_valid) {
+		stm32_rtc_calendar_to_time(&ts, &tamp_ts);
 		INFO("Tamper Event Occurred\n");
 		INFO("Date : %u/%u\n \t Time : %u:%u:%u\n",
 		     tamp_ts.day, tamp_ts.month, tamp_ts.hour,
@@ -283,8 +338,6 @@ void stm32_tamp_it_handler(void)
 				int_list[tamp].func(int_id);
 			}
 
-			mmio_setbits_32(stm32_tamp.base + STM32_TAMP_SCR,
-					BIT(int_id + 16U));
 			it &= ~BIT(int_id + 16U);
 		}
 		tamp++;
@@ -305,8 +358,6 @@ tamp_ext:
 				ext_list[tamp].func(ext_id);
 			}
 
-			mmio_setbits_32(stm32_tamp.base + STM32_TAMP_SCR,
-					BIT(ext_id));
 			it &= ~BIT(ext_id);
 		}
 		tamp++;
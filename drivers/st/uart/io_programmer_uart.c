@@ -35,7 +35,9 @@ static const uint8_t command_tab[] = {
 	DOWNLOAD_COMMAND
 };
 
-static uint8_t header_buffer[512] __aligned(4);
+#define HEADER_BUFFER_SIZE	512U
+
+static uint8_t *header_buffer;
 static int32_t header_length_read;
 
 /* UART device functions */
@@ -136,6 +138,11 @@ static int uart_dev_open(const uintptr_t init_params, io_dev_info_t **dev_info)
 
 	uart_handle_programmer = (UART_HandleTypeDef *)init_params;
 
+	if (header_buffer == NULL) {
+		header_buffer = stm32mp_bounce_alloc(HEADER_BUFFER_SIZE,
+						     sizeof(uint32_t));
+	}
+
 	/* Init UART to enable FIFO mode */
 	if (HAL_UART_Init(uart_handle_programmer) != HAL_OK) {
 		return -EIO;
@@ -0,0 +1,321 @@
+/*
+ * Copyright (c) 2021, STMicroelectronics - All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <string.h>
+
+#include <platform_def.h>
+
+#include <arch_helpers.h>
+#include <drivers/delay_timer.h>
+#include <drivers/st/stm32_uart_dma.h>
+#include <drivers/st/stm32_uart_regs.h>
+#include <drivers/st/stm32mp_clkfunc.h>
+#include <lib/cassert.h>
+#include <lib/mmio.h>
+#include <lib/xlat_tables/xlat_dma.h>
+
+/* DMA controller registers */
+#define DMA_LISR			U(0x00)
+#define DMA_HISR			U(0x04)
+#define DMA_LIFCR			U(0x08)
+#define DMA_HIFCR			U(0x0C)
+#define DMA_SCR(x)			(U(0x10) + (U(0x18) * (x)))
+#define DMA_SNDTR(x)			(U(0x14) + (U(0x18) * (x)))
+#define DMA_SPAR(x)			(U(0x18) + (U(0x18) * (x)))
+#define DMA_SM0AR(x)			(U(0x1C) + (U(0x18) * (x)))
+#define DMA_SFCR(x)			(U(0x24) + (U(0x18) * (x)))
+
+/* DMA_SxCR register fields */
+#define DMA_SCR_EN			BIT(0)
+#define DMA_SCR_DIR_MEM2PERIPH		BIT(6)
+#define DMA_SCR_MINC			BIT(10)
+#define DMA_SCR_TRBUFF			BIT(20)
+
+/* DMA_SxFCR register fields */
+#define DMA_SFCR_DMDIS			BIT(2)
+
+/*
+ * Streams 0 to 3 report in LISR/LIFCR and streams 4 to 7 in HISR/HIFCR,
+ * each in a 6-bit group whose in-register offset is not linear.
+ */
+#define DMA_ISR_TEIF			BIT(3)
+#define DMA_ISR_TCIF			BIT(5)
+#define DMA_ISR_ALL			GENMASK(5, 0)
+
+/* DMAMUX channel configuration */
+#define DMAMUX_CCR(x)			(U(0x04) * (x))
+#define DMAMUX_CCR_DMAREQ_ID		GENMASK(7, 0)
+
+#define UART_DMA_FLUSH_TIMEOUT_US	100000U
+
+CASSERT(IS_POWER_OF_TWO(STM32_UART_DMA_LANE_SIZE),
+	assert_uart_dma_lane_size_is_power_of_two);
+
+static uint32_t dma_flag_shift(uint32_t stream)
+{
+	static const uint8_t shift[4] = { 0U, 6U, 16U, 22U };
+
+	return shift[stream % 4U];
+}
+
+static uint32_t dma_isr(const struct stm32_uart_dma *dev)
+{
+	uint32_t reg = (dev->cfg.stream < 4U) ? DMA_LISR : DMA_HISR;
+
+	return mmio_read_32(dev->cfg.dma_base + reg) >>
+	       dma_flag_shift(dev->cfg.stream);
+}
+
+static void dma_clear_flags(const struct stm32_uart_dma *dev)
+{
+	uint32_t reg = (dev->cfg.stream < 4U) ? DMA_LIFCR : DMA_HIFCR;
+
+	mmio_write_32(dev->cfg.dma_base + reg,
+		      DMA_ISR_ALL << dma_flag_shift(dev->cfg.stream));
+}
+
+static void dma_stop(const struct stm32_uart_dma *dev)
+{
+	uintptr_t scr = dev->cfg.dma_base + DMA_SCR(dev->cfg.stream);
+
+	mmio_clrbits_32(scr, DMA_SCR_EN);
+
+	while ((mmio_read_32(scr) & DMA_SCR_EN) != 0U) {
+		;
+	}
+
+	dma_clear_flags(dev);
+}
+
+static void uart_putc_polled(const struct stm32_uart_dma *dev, uint8_t ch)
+{
+	while ((mmio_read_32(dev->cfg.uart_base + USART_ISR) &
+		USART_ISR_TXE) == 0U) {
+		;
+	}
+
+	mmio_write_32(dev->cfg.uart_base + USART_TDR, ch);
+}
+
+static uint32_t lane_level(const struct stm32_uart_dma_lane *lane)
+{
+	return lane->head - lane->tail;
+}
+
+/*
+ * Start a burst covering the contiguous span at the tail of the highest
+ * priority non-empty lane. The span is cleaned to memory first since the
+ * DMA reads it behind the data cache.
+ */
+static void dma_start_burst(struct stm32_uart_dma *dev)
+{
+	uint32_t i;
+
+	for (i = 0U; i < STM32_UART_DMA_NR_LANES; i++) {
+		struct stm32_uart_dma_lane *lane = &dev->lane[i];
+		uint32_t offset;
+		uint32_t len;
+
+		if (lane_level(lane) == 0U) {
+			continue;
+		}
+
+		offset = lane->tail % STM32_UART_DMA_LANE_SIZE;
+		len = MIN(lane_level(lane),
+			  STM32_UART_DMA_LANE_SIZE - offset);
+
+		xlat_dma_prepare((uintptr_t)&lane->data[offset], len,
+				 XLAT_DMA_TO_DEVICE);
+
+		mmio_write_32(dev->cfg.dma_base + DMA_SNDTR(dev->cfg.stream),
+			      len);
+		mmio_write_32(dev->cfg.dma_base + DMA_SM0AR(dev->cfg.stream),
+			      (uint32_t)(uintptr_t)&lane->data[offset]);
+		mmio_write_32(dev->cfg.dma_base + DMA_SCR(dev->cfg.stream),
+			      DMA_SCR_DIR_MEM2PERIPH | DMA_SCR_MINC |
+			      DMA_SCR_TRBUFF | DMA_SCR_EN);
+
+		dev->active_lane = i;
+		dev->active_len = len;
+		dev->active = true;
+		return;
+	}
+}
+
+/*
+ * Retire the burst in flight when it completed. A transfer error parks the
+ * driver in polled mode: the queues keep filling and every flush drains
+ * them through the CPU instead.
+ */
+static void dma_retire_burst(struct stm32_uart_dma *dev)
+{
+	uint32_t isr;
+
+	if (!dev->active) {
+		return;
+	}
+
+	isr = dma_isr(dev);
+
+	if ((isr & DMA_ISR_TEIF) != 0U) {
+		dma_stop(dev);
+		dev->active = false;
+		dev->broken = true;
+		return;
+	}
+
+	if ((isr & DMA_ISR_TCIF) == 0U) {
+		return;
+	}
+
+	dma_clear_flags(dev);
+	dev->lane[dev->active_lane].tail += dev->active_len;
+	dev->active = false;
+}
+
+void stm32_uart_dma_pump(struct stm32_uart_dma *console)
+{
+	if (console->broken) {
+		return;
+	}
+
+	dma_retire_burst(console);
+
+	if (!console->active) {
+		dma_start_burst(console);
+	}
+}
+
+size_t stm32_uart_dma_write(struct stm32_uart_dma *console, unsigned int lane,
+			    const uint8_t *buf, size_t size)
+{
+	struct stm32_uart_dma_lane *ring;
+	size_t queued = 0U;
+
+	assert(lane < STM32_UART_DMA_NR_LANES);
+
+	ring = &console->lane[lane];
+
+	while (queued < size) {
+		if (lane_level(ring) == STM32_UART_DMA_LANE_SIZE) {
+			/* Try to retire a burst to make room */
+			stm32_uart_dma_pump(console);
+
+			if (lane_level(ring) == STM32_UART_DMA_LANE_SIZE) {
+				ring->dropped += size - queued;
+				break;
+			}
+		}
+
+		ring->data[ring->head % STM32_UART_DMA_LANE_SIZE] =
+			buf[queued];
+		ring->head++;
+		queued++;
+	}
+
+	stm32_uart_dma_pump(console);
+
+	return queued;
+}
+
+static int stm32_uart_dma_putc(int character, console_t *console)
+{
+	struct stm32_uart_dma *dev = (struct stm32_uart_dma *)console;
+	uint8_t ch = (uint8_t)character;
+
+	(void)stm32_uart_dma_write(dev, STM32_UART_DMA_LANE_CONSOLE, &ch, 1U);
+
+	return character;
+}
+
+static int stm32_uart_dma_flush(console_t *console)
+{
+	struct stm32_uart_dma *dev = (struct stm32_uart_dma *)console;
+	uint64_t timeout = timeout_init_us(UART_DMA_FLUSH_TIMEOUT_US);
+	uint32_t i;
+
+	while (!dev->broken) {
+		bool empty = !dev->active;
+
+		for (i = 0U; i < STM32_UART_DMA_NR_LANES; i++) {
+			if (lane_level(&dev->lane[i]) != 0U) {
+				empty = false;
+			}
+		}
+
+		if (empty) {
+			return 0;
+		}
+
+		stm32_uart_dma_pump(dev);
+
+		if (timeout_elapsed(timeout)) {
+			/* The stream is stuck: finish by polled TX */
+			dma_stop(dev);
+			dev->active = false;
+			dev->broken = true;
+		}
+	}
+
+	/* Polled fallback, also serving the panic path */
+	for (i = 0U; i < STM32_UART_DMA_NR_LANES; i++) {
+		struct stm32_uart_dma_lane *lane = &dev->lane[i];
+
+		while (lane_level(lane) != 0U) {
+			uart_putc_polled(dev,
+					 lane->data[lane->tail %
+						    STM32_UART_DMA_LANE_SIZE]);
+			lane->tail++;
+		}
+	}
+
+	while ((mmio_read_32(dev->cfg.uart_base + USART_ISR) &
+		USART_ISR_TC) == 0U) {
+		;
+	}
+
+	return 0;
+}
+
+int stm32_uart_dma_register(const struct stm32_uart_dma_cfg *cfg,
+			    struct stm32_uart_dma *console)
+{
+	static const console_t init = {
+		.putc = stm32_uart_dma_putc,
+		.getc = NULL,
+		.flush = stm32_uart_dma_flush,
+	};
+
+	assert((console != NULL) && (cfg != NULL));
+	assert(cfg->stream < 8U);
+
+	memset(console, 0, sizeof(*console));
+	/* The function pointers of console_t are const qualified */
+	memcpy(&console->console, &init, sizeof(console_t));
+	console->cfg = *cfg;
+
+	stm32mp_clk_enable(cfg->dma_clock);
+	stm32mp_clk_enable(cfg->dmamux_clock);
+
+	/* Route the USART TX request to the stream */
+	mmio_clrsetbits_32(cfg->dmamux_base + DMAMUX_CCR(cfg->mux_chan),
+			   DMAMUX_CCR_DMAREQ_ID,
+			   cfg->request & DMAMUX_CCR_DMAREQ_ID);
+
+	dma_stop(console);
+
+	mmio_write_32(cfg->dma_base + DMA_SPAR(cfg->stream),
+		      (uint32_t)(cfg->uart_base + USART_TDR));
+	/* Direct mode, byte at a time: the USART paces the stream */
+	mmio_write_32(cfg->dma_base + DMA_SFCR(cfg->stream), 0U);
+
+	/* Let the USART raise TX DMA requests */
+	mmio_setbits_32(cfg->uart_base + USART_CR3, USART_CR3_DMAT);
+
+	return console_register(&console->console);
+}
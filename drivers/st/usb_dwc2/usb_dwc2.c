@@ -419,9 +419,19 @@ usb_status_t usb_dwc2_write_packet(void *handle, uint8_t *src,
 				   uint8_t ch_ep_num, uint16_t len)
 {
 	uint32_t count32b, i, j;
+	volatile uint32_t *fifo = dwc2_handle.usb_fifo[ch_ep_num];
 	/*usb_dwc2_global_t *USBx = (usb_dwc2_global_t *)handle;*/
 
 	count32b =  (len + 3) / 4;
+
+	if (((uintptr_t)src & 3U) == 0U) {
+		/* Aligned source: push whole words straight to the FIFO */
+		for (i = 0; i < count32b; i++, src += 4)
+			*fifo = *(uint32_t *)src;
+
+		return USBD_OK;
+	}
+
 	for (i = 0; i < count32b; i++, src += 4) {
 		uint32_t src_copy = 0;
 
@@ -429,7 +439,7 @@ usb_status_t usb_dwc2_write_packet(void *handle, uint8_t *src,
 		for (j = 0; j < 4; j++)
 			src_copy += (*(src + j)) << (8 * j);
 
-		*dwc2_handle.usb_fifo[ch_ep_num] = src_copy;
+		*fifo = src_copy;
 	}
 
 	return USBD_OK;
@@ -448,14 +458,20 @@ void *usb_dwc2_read_packet(void *handle, uint8_t *dest, uint16_t len)
 {
 	uint32_t i = 0;
 	uint32_t count32b = (len + 3) / 4;
+	volatile uint32_t *fifo = dwc2_handle.usb_fifo[0];
 	/*usb_dwc2_global_t *USBx = (usb_dwc2_global_t *)handle;*/
 
 	VERBOSE("read packet length %i to 0x%lx\n", len, (uintptr_t)dest);
 
-	for (i = 0; i < count32b; i++, dest += 4) {
-		*(uint32_t *)dest = *dwc2_handle.usb_fifo[0];
-		dsb();
-	}
+	/*
+	 * The FIFO pops one word per strongly-ordered read, so no barrier
+	 * is needed between accesses; a single one after the packet orders
+	 * the drained data against the status register reads that follow.
+	 */
+	for (i = 0; i < count32b; i++, dest += 4)
+		*(uint32_t *)dest = *fifo;
+
+	dsb();
 
 	return ((void *)dest);
 }
@@ -277,6 +277,11 @@
 #define FPEXC_EN_BIT		(U(1) << 30)
 #define FPEXC_RESET_VAL		FPEXC_RES1
 
+/* MVFR0 definitions */
+#define MVFR0_SIMDREG_SHIFT	U(0)
+#define MVFR0_SIMDREG_MASK	U(0xf)
+#define MVFR0_SIMDREG_D32	U(0x2)
+
 /* SPSR/CPSR definitions */
 #define SPSR_FIQ_BIT		(U(1) << 0)
 #define SPSR_IRQ_BIT		(U(1) << 1)
@@ -425,8 +430,13 @@
 #define PMCR_LP_BIT		(U(1) << 7)
 #define PMCR_LC_BIT		(U(1) << 6)
 #define PMCR_DP_BIT		(U(1) << 5)
+#define PMCR_C_BIT		(U(1) << 2)
+#define PMCR_E_BIT		(U(1) << 0)
 #define	PMCR_RESET_VAL		U(0x0)
 
+/* PMCNTENSET definitions */
+#define PMCNTENSET_C_BIT	(U(1) << 31)
+
 /*******************************************************************************
  * Definitions of register offsets, fields and macros for CPU system
  * instructions.
@@ -541,6 +551,8 @@
 /* Debug register defines. The format is: coproc, opt1, CRn, CRm, opt2 */
 #define HDCR		p15, 4, c1, c1, 1
 #define PMCR		p15, 0, c9, c12, 0
+#define PMCNTENSET	p15, 0, c9, c12, 1
+#define PMCCNTR		p15, 0, c9, c13, 0
 #define CNTHP_TVAL	p15, 4, c14, c2, 0
 #define CNTHP_CTL	p15, 4, c14, c2, 1
 
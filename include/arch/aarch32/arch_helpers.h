@@ -286,6 +286,9 @@ DEFINE_COPROCR_WRITE_FUNC_64(icc_sgi1r, ICC_SGI1R_EL1_64)
 DEFINE_COPROCR_RW_FUNCS(hdcr, HDCR)
 DEFINE_COPROCR_RW_FUNCS(cnthp_ctl, CNTHP_CTL)
 DEFINE_COPROCR_READ_FUNC(pmcr, PMCR)
+DEFINE_COPROCR_WRITE_FUNC(pmcr, PMCR)
+DEFINE_COPROCR_WRITE_FUNC(pmcntenset, PMCNTENSET)
+DEFINE_COPROCR_RW_FUNCS(pmccntr, PMCCNTR)
 
 /*
  * Address translation
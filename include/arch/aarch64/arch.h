@@ -692,6 +692,9 @@
 #define PMCR_EL0_P_BIT		(U(1) << 1)
 #define PMCR_EL0_E_BIT		(U(1) << 0)
 
+/* PMCNTENSET_EL0 definitions */
+#define PMCNTENSET_EL0_C_BIT	(U(1) << 31)
+
 /*******************************************************************************
  * Definitions for system register interface to SVE
  ******************************************************************************/
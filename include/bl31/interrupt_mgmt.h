@@ -19,6 +19,15 @@
 #define MAX_INTR_TYPES			U(3)
 #define INTR_TYPE_INVAL			MAX_INTR_TYPES
 
+/*******************************************************************************
+ * Layout of an entry of the interrupt type dispatch table, shared with the
+ * exception vector code which indexes the table directly. The handler is the
+ * first field so the vector path fetches it with a single indexed load; the
+ * entry size is a power of two so the index is a shift, not a multiply.
+ ******************************************************************************/
+#define INTR_TYPE_DESC_HANDLER		U(0x0)
+#define INTR_TYPE_DESC_SIZE_SHIFT	U(5)
+
 /* Interrupt routing modes */
 #define INTR_ROUTING_MODE_PE		0
 #define INTR_ROUTING_MODE_ANY		1
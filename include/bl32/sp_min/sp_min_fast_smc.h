@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef SP_MIN_FAST_SMC_H
+#define SP_MIN_FAST_SMC_H
+
+#include <stdint.h>
+
+/*
+ * Constant-result fast SMC dispatch.
+ *
+ * With SP_MIN_FAST_SMC=1 the SMC vector probes this table before the
+ * general purpose register context is saved: a function id listed here
+ * is answered with the recorded r0/r1 values straight from the
+ * exception vector, with the caller's state still in registers. Only
+ * query-class calls whose answer is a build-time constant belong here -
+ * the fast path runs no C code, takes no locks, never changes the
+ * security state and does not appear in the SMC latency trace.
+ *
+ * The platform enabling SP_MIN_FAST_SMC provides the table, terminated
+ * by a zero function id. r1 is loaded even for single-result calls:
+ * SMCCC leaves unused result registers undefined.
+ */
+struct sp_min_fast_smc_ent {
+	uint32_t fid;
+	uint32_t ret0;
+	uint32_t ret1;
+};
+
+extern const struct sp_min_fast_smc_ent sp_min_fast_smc_table[];
+
+#endif /* SP_MIN_FAST_SMC_H */
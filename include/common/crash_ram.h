@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef CRASH_RAM_H
+#define CRASH_RAM_H
+
+#include <lib/utils_def.h>
+
+/*
+ * Crash/log capture region in persistent RAM (reserved DDR or backup SRAM).
+ * The region survives a warm or watchdog reset, so the diagnostics written
+ * at crash time are complete even when the console never gets drained. The
+ * platform provides the region through CRASH_RAM_BASE and CRASH_RAM_SIZE in
+ * platform_def.h when CRASH_RAM_CAPTURE is enabled.
+ *
+ * Region layout (all fields little-endian):
+ *   +0x00  region header, see struct crash_ram_header
+ *   +CRASH_RAM_REGS_OFFSET
+ *          fixed register slab, written by the assembly crash paths where
+ *          no C runtime is available: a magic/arch word pair followed by
+ *          the general purpose registers and a few fault syndrome
+ *          registers. Only the latest crash is kept here.
+ *   +CRASH_RAM_RING_OFFSET
+ *          record ring. Records carry a type, a length and a free-running
+ *          sequence number; they never wrap in the middle, the tail of the
+ *          ring is skipped instead. The oldest records are overwritten.
+ *
+ * The same layout is parsed by the host-side decoder in tools/crashring.
+ */
+
+#define CRASH_RAM_MAGIC			U(0x43524d31)	/* "CRM1" */
+
+/* Register slab */
+#define CRASH_RAM_REGS_OFFSET		U(0x20)
+#define CRASH_RAM_REGS_SIZE		U(0x140)
+#define CRASH_RAM_REGS_MAGIC		U(0x43525247)	/* "CRRG" */
+/* Value of the arch word */
+#define CRASH_RAM_REGS_ARCH_AARCH32	U(32)
+#define CRASH_RAM_REGS_ARCH_AARCH64	U(64)
+/* Register values follow the magic and arch words */
+#define CRASH_RAM_REGS_VALS		U(0x8)
+
+/* Record ring */
+#define CRASH_RAM_RING_OFFSET		U(0x160)
+
+/* Record types */
+#define CRASH_RAM_REC_END		U(0)
+#define CRASH_RAM_REC_TEXT		U(1)
+#define CRASH_RAM_REC_BACKTRACE		U(2)
+#define CRASH_RAM_REC_PANIC		U(3)
+/*
+ * Register mismatch found by a suspend/resume shadow compare. The payload
+ * is three little-endian 32-bit words: the register address, the value
+ * snapshot before suspend and the value read back after resume.
+ */
+#define CRASH_RAM_REC_REG_DIFF		U(4)
+
+/* Record flags */
+#define CRASH_RAM_REC_FLAG_64BIT	U(0x1)
+
+#ifndef __ASSEMBLER__
+
+#include <stddef.h>
+#include <stdint.h>
+
+struct crash_ram_header {
+	uint32_t magic;
+	uint32_t size;		/* Total region size, header included */
+	uint32_t boot_count;
+	uint32_t write_off;	/* Offset of the next record in the ring */
+	uint32_t seq;		/* Sequence number of the next record */
+	uint32_t drained_seq;	/* Highest sequence re-emitted on the console */
+	uint32_t reserved[2];
+};
+
+struct crash_ram_record {
+	uint8_t type;
+	uint8_t flags;
+	uint16_t len;		/* Payload length, header excluded */
+	uint32_t seq;
+};
+
+/*
+ * Set to a non zero value once the region is initialized; checked by the
+ * assembly crash paths before they write the register slab, so that a very
+ * early panic does not store through an unmapped or unclocked region.
+ */
+extern uint32_t crash_ram_ready;
+
+void crash_ram_init(void);
+void crash_ram_put(uint8_t type, const void *data, size_t len);
+void crash_ram_put_str(const char *str);
+void crash_ram_put_backtrace(const uintptr_t *addrs, size_t count);
+void crash_ram_record_panic(const char *func);
+/*
+ * Re-emit on the console the records left over by previous boots, together
+ * with the register slab if an assembly crash path filled it. Meant to be
+ * called once the boot console is up, outside of any hot path.
+ */
+void crash_ram_drain(void);
+
+#endif /* __ASSEMBLER__ */
+
+#endif /* CRASH_RAM_H */
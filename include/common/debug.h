@@ -97,12 +97,25 @@ void backtrace(const char *cookie);
 
 void __dead2 do_panic(void);
 
+#if CRASH_RAM_CAPTURE
+/* Memory-only capture of the panic location, see common/crash_ram.c */
+void crash_ram_record_panic(const char *func);
+
+#define panic()					\
+	do {					\
+		crash_ram_record_panic(__func__); \
+		backtrace(__func__);		\
+		(void)console_flush();		\
+		do_panic();			\
+	} while (false)
+#else
 #define panic()				\
 	do {				\
 		backtrace(__func__);	\
 		(void)console_flush();	\
 		do_panic();		\
 	} while (false)
+#endif
 
 /* Function called when stack protection check code detects a corrupted stack */
 void __dead2 __stack_chk_fail(void);
@@ -12,4 +12,39 @@ int dt_add_psci_cpu_enable_methods(void *fdt);
 int fdt_add_reserved_memory(void *dtb, const char *node_name,
 			    uintptr_t base, size_t size);
 
+/*
+ * Batched fixups: new nodes are staged in a small scratch tree, where
+ * libfdt's insertions only move a few bytes, and grafted into the target
+ * blob with a single repacking pass on commit.
+ */
+struct fdt_fixup_batch {
+	void *dtb;
+	void *stage;
+};
+
+int fdt_fixup_batch_begin(struct fdt_fixup_batch *batch, void *dtb,
+			  void *stage_buf, size_t stage_size);
+int fdt_fixup_batch_psci_node(struct fdt_fixup_batch *batch);
+int fdt_fixup_batch_reserved_memory(struct fdt_fixup_batch *batch,
+				    const char *node_name, uintptr_t base,
+				    size_t size);
+int fdt_fixup_batch_commit(struct fdt_fixup_batch *batch);
+
+/*
+ * Copy-on-write late binding: snapshot the blob once after load, apply
+ * fixups destructively as usual, and rewind to the snapshot when a
+ * different fixup set must be applied instead. Batches staged against
+ * the blob stay valid across a rewind, so they act as reusable patch
+ * lists committed against the pristine content at handoff time.
+ */
+struct fdt_fixup_cow {
+	void *dtb;
+	void *pristine;
+	size_t size;
+};
+
+int fdt_fixup_cow_init(struct fdt_fixup_cow *cow, void *dtb,
+		       void *copy_buf, size_t copy_size);
+void fdt_fixup_cow_reset(struct fdt_fixup_cow *cow);
+
 #endif /* FDT_FIXUP_H */
@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2026, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef FDT_PROP_INDEX_H
+#define FDT_PROP_INDEX_H
+
+/*
+ * Optional side index over a device tree blob, enabled with
+ * FDT_PROP_INDEX=1. One pass over the blob at load time records every
+ * (node offset, property name hash) pair; the fdt_wrappers.c read
+ * accessors then resolve properties with a binary search and a single
+ * confirming string compare, instead of one strcmp per property per
+ * lookup as in fdt_get_property_namelen().
+ */
+
+/*
+ * Index @dtb. Replaces any previously built index. Properties beyond
+ * the index capacity are left to the runtime parser fallback.
+ */
+void fdt_prop_index_build(const void *dtb);
+
+/*
+ * Drop the index. Must be called when the indexed blob is modified in
+ * a way that moves offsets (any libfdt read-write operation).
+ */
+void fdt_prop_index_invalidate(void);
+
+/*
+ * fdt_getprop() equivalent going through the index. Falls back to the
+ * runtime parser when @dtb is not the indexed blob or the property was
+ * not indexed.
+ */
+const void *fdt_prop_index_getprop(const void *dtb, int node,
+				   const char *name, int *lenp);
+
+#endif /* FDT_PROP_INDEX_H */
@@ -16,9 +16,27 @@ typedef int (decompressor_t)(uintptr_t *in_buf, size_t in_len,
 			     uintptr_t *out_buf, size_t out_len,
 			     uintptr_t work_buf, size_t work_len);
 
+/*
+ * Streaming decompressor interface: init() is given the output range and a
+ * workspace, feed() consumes one chunk of compressed input, finish()
+ * reports the end of the decompressed output.
+ */
+struct stream_decompressor {
+	int (*init)(uintptr_t out_buf, size_t out_len, uintptr_t work_buf,
+		    size_t work_len);
+	int (*feed)(uintptr_t in_buf, size_t in_len);
+	int (*finish)(uintptr_t *out_end);
+};
+
 void image_decompress_init(uintptr_t buf_base, uint32_t buf_size,
 			   decompressor_t *decompressor);
+void image_decompress_register_format(const uint8_t *magic, size_t magic_len,
+				      decompressor_t *decompressor);
 void image_decompress_prepare(struct image_info *info);
 int image_decompress(struct image_info *info);
 
+void image_decompress_init_stream(uintptr_t buf_base, uint32_t buf_size,
+				  const struct stream_decompressor *ops);
+int image_decompress_load(unsigned int image_id, struct image_info *info);
+
 #endif /* IMAGE_DECOMPRESS_H */
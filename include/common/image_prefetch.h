@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2026, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef IMAGE_PREFETCH_H
+#define IMAGE_PREFETCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <common/bl_common.h>
+
+/*
+ * Speculative next-image prefetch for the BL2 load sequence.
+ *
+ * The list of images BL2 loads is fully deterministic per board, so once
+ * an image has finished streaming in, the identity of the next read the
+ * boot flow will issue is already known. While the CPU authenticates the
+ * image it just loaded the storage device sits idle; the prefetcher uses
+ * that window to stage the opening burst of the next image in the plan
+ * into an on-chip buffer, which the next load then consumes before going
+ * back to the device for the remainder.
+ *
+ * The prefetcher is only a cache of data that is re-read through the
+ * normal load path on a miss: a dropped or mismatched prefetch is never
+ * an error.
+ */
+
+/* Record the planned load sequence from the BL2 image descriptor list. */
+void image_prefetch_plan(const bl_load_info_t *load_info);
+
+/*
+ * Stage the opening burst of the image that follows 'image_id' in the
+ * planned sequence. Called when the storage device goes idle, before the
+ * CPU-bound authentication of the current image starts.
+ */
+void image_prefetch_kick(unsigned int image_id);
+
+/*
+ * Copy staged bytes for 'image_id' to 'image_base', if any. Returns the
+ * number of bytes consumed (0 on a prefetch miss); the caller resumes
+ * the device read at that offset. 'image_size' bounds the copy.
+ */
+size_t image_prefetch_consume(unsigned int image_id, uintptr_t image_base,
+			      size_t image_size);
+
+/*
+ * Drop any staged data, e.g. when falling back to an alternate boot
+ * source whose contents may differ from the prefetched bytes.
+ */
+void image_prefetch_invalidate(void);
+
+#endif /* IMAGE_PREFETCH_H */
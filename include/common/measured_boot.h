@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef MEASURED_BOOT_H
+#define MEASURED_BOOT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <export/lib/bl_aux_params/bl_aux_params_exp.h>
+#include <lib/utils_def.h>
+
+/*
+ * Measured boot event log, TCG PC Client Platform Firmware Profile layout
+ * (crypto agile, single SHA-256 bank). The digests are not recomputed: each
+ * entry reuses the image hash the Trusted Board Boot flow has already
+ * verified, so measuring adds no extra image read or hashing pass.
+ *
+ * The log is built in BL2 private memory while images are authenticated and
+ * published to a next-stage visible buffer with measured_boot_publish(),
+ * which prepends a BL aux parameter (lib/bl_aux_params) describing it.
+ */
+
+/* TCG event types and algorithm identifiers used by the log */
+#define TCG_EV_NO_ACTION		U(0x00000003)
+#define TCG_EV_POST_CODE		U(0x00000001)
+#define TCG_TPM_ALG_SHA256		U(0x000B)
+#define TCG_SHA256_DIGEST_SIZE		U(32)
+
+/* BL aux parameter publishing the log, in the vendor-specific type range */
+#define BL_AUX_PARAM_MEASURED_BOOT_LOG	U(0x4D424C47)
+
+struct bl_aux_param_measured_boot_log {
+	struct bl_aux_param_header h;
+	uint64_t log_addr;
+	uint64_t log_size;
+};
+
+/*
+ * Append an event for image 'img_id' to the log. 'digest_der' points to the
+ * DER encoded DigestInfo carried by the verified certificate, whose trailing
+ * TCG_SHA256_DIGEST_SIZE bytes are the raw digest. Records nothing when the
+ * log is full or the digest is not a SHA-256.
+ */
+void measured_boot_record(unsigned int img_id, const void *digest_der,
+			  size_t digest_der_len);
+
+/*
+ * Copy the event log to 'dst', prefixed with the aux parameter list head
+ * describing it, 'max_size' bytes being available there. The destination
+ * must be readable by the consumer of the log. Return the parameter list
+ * head address to hand to the next image, or 0 when nothing was recorded
+ * or the log does not fit.
+ */
+uintptr_t measured_boot_publish(uintptr_t dst, size_t max_size);
+
+#endif /* MEASURED_BOOT_H */
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef PROF_TRACE_H
+#define PROF_TRACE_H
+
+#include <lib/utils_def.h>
+
+/*
+ * Function-level cycle attribution for debug builds (PROF_INSTRUMENT=1).
+ * Every C function compiled into the firmware calls the
+ * -finstrument-functions hooks, which append an 8-byte record - the
+ * function address tagged with an exit bit, and the PMU cycle counter -
+ * to a per-CPU ring in a RAM region the platform hands to
+ * prof_trace_init(). The host decoder in tools/proftrace replays the
+ * enter/exit stream against an nm(1) listing of the image and prints
+ * self and cumulative cycles per function.
+ *
+ * The rings fill and stop rather than wrap: a wrapped stream loses the
+ * enter/exit pairing the attribution is built on. Records overflowing a
+ * full ring are only counted.
+ *
+ * An interrupt-driven PC sampler cannot observe this firmware: BL2 and
+ * the SP_min monitor both execute with the secure interrupt masked, so
+ * a sampling interrupt could only ever land in the normal world. The
+ * enter/exit trace costs more per call but attributes every cycle, on
+ * exactly the builds (DEBUG) where the overhead is acceptable.
+ */
+
+#define PROF_TRACE_MAGIC	U(0x50545231)	/* 'PTR1' */
+
+/* Image identifier stored in the ring header */
+#define PROF_TRACE_IMG_BL2	U(2)
+#define PROF_TRACE_IMG_BL32	U(32)
+
+/* Bit 0 of the record address word flags a function exit */
+#define PROF_TRACE_REC_EXIT	U(0x1)
+
+#ifndef __ASSEMBLER__
+
+#include <stddef.h>
+#include <stdint.h>
+
+struct prof_trace_rec {
+	uint32_t addr;		/* Function address, bit 0 = exit */
+	uint32_t cycles;	/* PMU cycle counter at the hook */
+};
+
+struct prof_trace_ring {
+	uint32_t magic;
+	uint32_t image;		/* PROF_TRACE_IMG_* */
+	uint32_t cpu;
+	uint32_t capacity;	/* Records the ring can hold */
+	uint32_t count;		/* Records written */
+	uint32_t dropped;	/* Records lost after the ring filled */
+	uint32_t reserved[2];
+};
+
+/*
+ * Carve @size bytes at @base into @nrings per-CPU rings tagged with
+ * @image and start tracing. The caller maps the region beforehand; hook
+ * calls before this return immediately, so the window from reset to the
+ * first usable RAM is not covered.
+ */
+void prof_trace_init(uintptr_t base, size_t size, unsigned int nrings,
+		     uint32_t image);
+
+#endif /* __ASSEMBLER__ */
+
+#endif /* PROF_TRACE_H */
@@ -101,8 +101,8 @@ CASSERT(RT_SVC_DESC_HANDLE == __builtin_offsetof(rt_svc_desc_t, handle), \
 /*
  * This function combines the call type and the owning entity number
  * corresponding to a runtime service to generate a unique owning entity number.
- * This unique oen is used to access an entry in the 'rt_svc_descs_indices'
- * array. The entry contains the index of the service descriptor in the
+ * This unique oen is used to access an entry in the 'rt_svc_handlers' array.
+ * The entry contains the handler of the service descriptor in the
  * 'rt_svc_descs' array.
  */
 static inline uint32_t get_unique_oen(uint32_t oen, uint32_t call_type)
@@ -113,7 +113,7 @@ static inline uint32_t get_unique_oen(uint32_t oen, uint32_t call_type)
 
 /*
  * This function generates the unique owning entity number from the SMC Function
- * ID. This unique oen is used to access an entry in the 'rt_svc_descs_indices'
+ * ID. This unique oen is used to access an entry in the 'rt_svc_handlers'
  * array to invoke the corresponding runtime service handler during SMC
  * handling.
  */
@@ -132,7 +132,7 @@ IMPORT_SYM(uintptr_t, __RT_SVC_DESCS_START__,		RT_SVC_DESCS_START);
 IMPORT_SYM(uintptr_t, __RT_SVC_DESCS_END__,		RT_SVC_DESCS_END);
 void init_crash_reporting(void);
 
-extern uint8_t rt_svc_descs_indices[MAX_RT_SVCS];
+extern rt_svc_handle_t rt_svc_handlers[MAX_RT_SVCS];
 
 #endif /*__ASSEMBLER__*/
 #endif /* RUNTIME_SVC_H */
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef SEC_BUDGET_H
+#define SEC_BUDGET_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <lib/utils_def.h>
+
+/*
+ * Secure world execution budget, built with SEC_EXEC_BUDGET=1.
+ *
+ * Every runtime service dispatch arms a per-CPU deadline of
+ * SEC_EXEC_BUDGET_TICKS generic timer ticks. Services whose work is
+ * divisible poll sec_budget_exhausted() at their natural checkpoints
+ * and defer the remainder when the deadline has passed (the SCMI SMT
+ * batch loop does this: unconsumed messages stay queued and the agent
+ * re-rings the doorbell), which caps their secure residency at one unit
+ * of work past the budget. Indivisible handlers cannot be cut short:
+ * the secure timer cannot preempt Monitor mode, where exceptions are
+ * masked for the whole dispatch, so for them the deadline is
+ * accounting only. Every dispatch is measured on retire, and per-OEN
+ * overrun counts and worst-case residencies are kept per CPU; together
+ * they turn the budget into a verifiable bound - a soak run with zero
+ * overruns demonstrates the bound held, and any overrun names the
+ * service that broke it.
+ *
+ * The statistics are read back through the PMF "get time-stamp" SMC
+ * using service id PMF_SEC_BUDGET_SVC_ID: tid = OEN returns the overrun
+ * count of that owning entity, tid = SEC_BUDGET_TID_WORST_BASE + OEN
+ * its worst residency in ticks.
+ */
+
+#define PMF_SEC_BUDGET_SVC_ID		6
+
+#define SEC_BUDGET_TID_WORST_BASE	U(64)
+#define SEC_BUDGET_TOTAL_IDS		U(128)
+
+#if SEC_EXEC_BUDGET
+void sec_budget_arm(void);
+bool sec_budget_exhausted(void);
+void sec_budget_retire(uint32_t smc_fid);
+#else
+static inline void sec_budget_arm(void)
+{
+}
+
+static inline bool sec_budget_exhausted(void)
+{
+	return false;
+}
+
+static inline void sec_budget_retire(uint32_t smc_fid)
+{
+}
+#endif /* SEC_EXEC_BUDGET */
+
+#endif /* SEC_BUDGET_H */
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef SMC_RATE_LIMIT_H
+#define SMC_RATE_LIMIT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <lib/utils_def.h>
+
+/*
+ * Per-OEN SMC rate limiter, built with SMC_RATE_LIMIT=1.
+ *
+ * Every runtime service dispatch draws a token from a per-CPU, per-OEN
+ * token bucket before the handler runs. A bucket holds at most
+ * SMC_RATE_LIMIT_BURST tokens and earns one token every
+ * SMC_RATE_LIMIT_TOKEN_TICKS generic timer ticks, so a service calling
+ * slower than the refill rate never sees the limiter while a caller
+ * looping on SMCs is capped at the refill rate once its burst
+ * allowance is spent. Calls arriving with an empty bucket are shed with
+ * SMC_UNK before any handler work, bounding the secure CPU time any one
+ * owning entity can consume and preserving isolation between services -
+ * a normal world driver spinning on SCMI cannot starve the secure timer
+ * work dispatched under another OEN.
+ *
+ * Owning entities whose bit is set in SMC_RATE_LIMIT_EXEMPT are never
+ * shed. The default exempts the Arm architecture (OEN 0) and standard
+ * service (OEN 4) ranges: shedding a PSCI power state transition would
+ * trade a performance problem for a functional one.
+ *
+ * Shed counts are kept per CPU and per OEN and read back through the
+ * PMF "get time-stamp" SMC using service id PMF_SMC_RATE_SVC_ID with
+ * tid = OEN, naming the service that hit the limit.
+ */
+
+#define PMF_SMC_RATE_SVC_ID	9
+
+#define SMC_RATE_TOTAL_IDS	U(64)
+
+#if SMC_RATE_LIMIT
+bool smc_rate_admit(uint32_t smc_fid);
+#else
+static inline bool smc_rate_admit(uint32_t smc_fid)
+{
+	return true;
+}
+#endif /* SMC_RATE_LIMIT */
+
+#endif /* SMC_RATE_LIMIT_H */
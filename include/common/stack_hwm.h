@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef STACK_HWM_H
+#define STACK_HWM_H
+
+#include <platform_def.h>
+
+/*
+ * Stack high-water-mark reporting, built with STACK_HWM=1.
+ *
+ * The per-CPU stacks are filled with a canary pattern during the PMF
+ * setup on the cold boot path, and the high-water mark of a stack is
+ * recovered on demand by scanning from its base for the first word the
+ * canary no longer covers. Together with the static worst-case chains
+ * from "make stack-report" (STACK_USAGE=1) this bounds
+ * PLATFORM_STACK_SIZE from both sides: the static analysis gives the
+ * ceiling the sizing must clear, the measured mark shows how much of
+ * the reservation a real workload ever touched.
+ *
+ * The marks are read back through the PMF "get time-stamp" SMC using
+ * service id PMF_STACK_HWM_SVC_ID: tid = CPU position returns the
+ * largest number of stack bytes that CPU has used. The scan runs on the
+ * CPU servicing the SMC, so a mark can be read without disturbing the
+ * CPU it describes. The primary CPU's own stack is already live when
+ * the canaries are laid down and is only filled below the stack pointer
+ * of the setup code, so its mark has the setup-time depth as a floor.
+ */
+
+#define PMF_STACK_HWM_SVC_ID		7
+
+#define STACK_HWM_TOTAL_IDS		PLATFORM_CORE_COUNT
+
+#endif /* STACK_HWM_H */
@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef TF_LOG_BINARY_H
+#define TF_LOG_BINARY_H
+
+#include <stdarg.h>
+
+/*
+ * Binary log mode: tf_log() stores the format string pointer and the raw
+ * arguments into a RAM ring instead of formatting into the console. The
+ * ring is drained to the console as framed binary records when the platform
+ * decides it is idle, and the tools/binlog host tool renders the records
+ * back into text using the firmware ELF to resolve the strings.
+ *
+ * Record wire format, all fields little-endian:
+ *   sync bytes 0xB1 0x5A, u64 format string address, u8 argument count,
+ *   then one u64 per argument. A record with a zero format address carries
+ *   the number of messages dropped on ring overflow as its only argument.
+ */
+#define TF_LOG_BIN_SYNC0	0xB1
+#define TF_LOG_BIN_SYNC1	0x5A
+
+/* One argument per conversion specifier handled by the libc vprintf() */
+#define TF_LOG_BIN_MAX_ARGS	8U
+
+/* Capture RAM, can be overridden by the platform */
+#ifndef TF_LOG_BINARY_RING_SIZE
+#define TF_LOG_BINARY_RING_SIZE	4096U
+#endif
+
+void tf_log_binary_record(const char *fmt, va_list args);
+void tf_log_binary_drain(void);
+
+#endif /* TF_LOG_BINARY_H */
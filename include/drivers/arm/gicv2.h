@@ -156,6 +156,26 @@ typedef struct gicv2_driver_data {
 	unsigned int interrupt_props_num;
 } gicv2_driver_data_t;
 
+/*
+ * Number of registers of the given type needed to cover INTIDs 0 - 1019.
+ * GICv2 has no Redistributor, so unlike the GICv3 context the ranges start at
+ * INTID 0 and their first word(s) hold the saving CPU's banked SGI/PPI view.
+ */
+#define GICV2_NUM_CTX_REGS(reg_name)	\
+	DIV_ROUND_UP_2EVAL(MAX_SPI_ID + U(1), (1U << reg_name ## _SHIFT))
+
+typedef struct gicv2_dist_ctx {
+	uint32_t gicd_ctlr;
+	uint32_t gicd_igroupr[GICV2_NUM_CTX_REGS(IGROUPR)];
+	uint32_t gicd_isenabler[GICV2_NUM_CTX_REGS(ISENABLER)];
+	uint32_t gicd_ispendr[GICV2_NUM_CTX_REGS(ISPENDR)];
+	uint32_t gicd_isactiver[GICV2_NUM_CTX_REGS(ISACTIVER)];
+	uint32_t gicd_ipriorityr[GICV2_NUM_CTX_REGS(IPRIORITYR)];
+	uint32_t gicd_itargetsr[GICV2_NUM_CTX_REGS(ITARGETSR)];
+	uint32_t gicd_icfgr[GICV2_NUM_CTX_REGS(ICFGR)];
+	uint32_t gicd_nsacr[GICV2_NUM_CTX_REGS(NSACR)];
+} gicv2_dist_ctx_t;
+
 /*******************************************************************************
  * Function prototypes
  ******************************************************************************/
@@ -183,6 +203,8 @@ void gicv2_set_interrupt_pending(unsigned int id);
 void gicv2_clear_interrupt_pending(unsigned int id);
 unsigned int gicv2_set_pmr(unsigned int mask);
 void gicv2_interrupt_set_cfg(unsigned int id, unsigned int cfg);
+void gicv2_distif_save(gicv2_dist_ctx_t * const dist_ctx);
+void gicv2_distif_init_restore(const gicv2_dist_ctx_t * const dist_ctx);
 
 #endif /* __ASSEMBLER__ */
 #endif /* GICV2_H */
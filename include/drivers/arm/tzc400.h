@@ -112,6 +112,8 @@ void tzc400_configure_region(unsigned int filters,
 			     unsigned int sec_attr,
 			     unsigned int nsaid_permissions);
 void tzc400_set_action(unsigned int action);
+void tzc400_config_begin(void);
+void tzc400_config_commit(void);
 void tzc400_enable_filters(void);
 void tzc400_disable_filters(void);
 void tzc400_clear_all_interrupts(void);
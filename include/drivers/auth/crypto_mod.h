@@ -37,8 +37,24 @@ typedef struct crypto_lib_desc_s {
 	/* Verify a hash. Return one of the 'enum crypto_ret_value' options */
 	int (*verify_hash)(void *data_ptr, unsigned int data_len,
 			   void *digest_info_ptr, unsigned int digest_info_len);
+
+#if PIPELINED_IMAGE_LOAD
+	/* Streaming hash interface used by the pipelined image loader to
+	 * digest an image chunk by chunk while it is being loaded. The
+	 * library decides which algorithm the stream uses and reports it
+	 * through 'hash_finish'. Return one of the 'enum crypto_ret_value'
+	 * options */
+	int (*hash_init)(void);
+	int (*hash_update)(void *data_ptr, unsigned int data_len);
+	int (*hash_finish)(unsigned char *digest, unsigned int *digest_len);
+#endif
 } crypto_lib_desc_t;
 
+#if PIPELINED_IMAGE_LOAD
+/* Maximum size of a digest produced by the streaming hash interface */
+#define CRYPTO_MAX_DIGEST_SIZE	64U
+#endif
+
 /* Public functions */
 void crypto_mod_init(void);
 int crypto_mod_verify_signature(void *data_ptr, unsigned int data_len,
@@ -48,7 +64,94 @@ int crypto_mod_verify_signature(void *data_ptr, unsigned int data_len,
 int crypto_mod_verify_hash(void *data_ptr, unsigned int data_len,
 			   void *digest_info_ptr, unsigned int digest_info_len);
 
+#if PIPELINED_IMAGE_LOAD
+int crypto_mod_hash_init(void);
+int crypto_mod_hash_update(void *data_ptr, unsigned int data_len);
+int crypto_mod_hash_finish(unsigned char *digest, unsigned int *digest_len);
+void crypto_mod_prehash_save(void *data_ptr, unsigned int data_len,
+			     const unsigned char *digest,
+			     unsigned int digest_len);
+int crypto_mod_prehash_lookup(void *data_ptr, unsigned int data_len,
+			      const unsigned char **digest,
+			      unsigned int *digest_len);
+#endif
+
+#if CRYPTO_ASYNC
+/*
+ * Asynchronous verification queue.
+ *
+ * A platform crypto accelerator driver (e.g. CRYP or PKA) registers a
+ * set of engine ops at init; verifications submitted through the queue
+ * then run on the engine while the CPU does other work, until the
+ * caller waits for the result. When no engine is registered, or the
+ * engine rejects a job (unsupported algorithm, key size...), the job
+ * runs synchronously on the crypto library and is already complete when
+ * the submit call returns, so callers need not care which way it went.
+ *
+ * Every submitted job must be waited for exactly once, either by its
+ * identifier or through crypto_mod_wait_all().
+ */
+
+/* Jobs in flight, including completed ones not yet waited for */
+#define CRYPTO_ASYNC_QUEUE_DEPTH	4U
+
+/* Returned by the engine 'poll' op while a job is still running */
+#define CRYPTO_ASYNC_PENDING		(-1)
+
+/* Invoked on job completion with one of 'enum crypto_ret_value' */
+typedef void (*crypto_job_cb_t)(void *cb_arg, int result);
+
+typedef struct crypto_async_ops_s {
+	const char *name;
+
+	/* Start a verification on the engine for the given queue slot.
+	 * Return CRYPTO_SUCCESS if the job was accepted; any other value
+	 * makes the job fall back to the synchronous library. Either op
+	 * may be NULL if the engine does not implement it */
+	int (*sig_start)(unsigned int slot,
+			 void *data_ptr, unsigned int data_len,
+			 void *sig_ptr, unsigned int sig_len,
+			 void *sig_alg_ptr, unsigned int sig_alg_len,
+			 void *pk_ptr, unsigned int pk_len);
+	int (*hash_start)(unsigned int slot,
+			  void *data_ptr, unsigned int data_len,
+			  void *digest_info_ptr,
+			  unsigned int digest_info_len);
+
+	/* Return CRYPTO_ASYNC_PENDING while the slot's job is running,
+	 * else its 'enum crypto_ret_value' result */
+	int (*poll)(unsigned int slot);
+} crypto_async_ops_t;
+
+void crypto_mod_async_register(const crypto_async_ops_t *ops);
+int crypto_mod_submit_verify_signature(void *data_ptr, unsigned int data_len,
+				       void *sig_ptr, unsigned int sig_len,
+				       void *sig_alg_ptr,
+				       unsigned int sig_alg_len,
+				       void *pk_ptr, unsigned int pk_len,
+				       crypto_job_cb_t cb, void *cb_arg);
+int crypto_mod_submit_verify_hash(void *data_ptr, unsigned int data_len,
+				  void *digest_info_ptr,
+				  unsigned int digest_info_len,
+				  crypto_job_cb_t cb, void *cb_arg);
+int crypto_mod_wait(int job);
+void crypto_mod_wait_all(void);
+#endif /* CRYPTO_ASYNC */
+
 /* Macro to register a cryptographic library */
+#if PIPELINED_IMAGE_LOAD
+#define REGISTER_CRYPTO_LIB(_name, _init, _verify_signature, _verify_hash, \
+			    _hash_init, _hash_update, _hash_finish) \
+	const crypto_lib_desc_t crypto_lib_desc = { \
+		.name = _name, \
+		.init = _init, \
+		.verify_signature = _verify_signature, \
+		.verify_hash = _verify_hash, \
+		.hash_init = _hash_init, \
+		.hash_update = _hash_update, \
+		.hash_finish = _hash_finish \
+	}
+#else
 #define REGISTER_CRYPTO_LIB(_name, _init, _verify_signature, _verify_hash) \
 	const crypto_lib_desc_t crypto_lib_desc = { \
 		.name = _name, \
@@ -56,6 +159,7 @@ int crypto_mod_verify_hash(void *data_ptr, unsigned int data_len,
 		.verify_signature = _verify_signature, \
 		.verify_hash = _verify_hash \
 	}
+#endif
 
 extern const crypto_lib_desc_t crypto_lib_desc;
 
@@ -9,4 +9,12 @@
 
 void mbedtls_init(void);
 
+#if MBEDTLS_ARENA_ALLOC
+void mbedtls_heap_reset(void);
+#else
+static inline void mbedtls_heap_reset(void)
+{
+}
+#endif
+
 #endif /* MBEDTLS_COMMON_H */
@@ -30,6 +30,13 @@
  * Trusted Boot
  */
 
+/*
+ * Use the CPU-specific multiply-accumulate kernels for bignum operations,
+ * the dominant cost of RSA and ECDSA image verification. The library falls
+ * back to plain C on cores without a suitable implementation.
+ */
+#define MBEDTLS_HAVE_ASM
+
 #define MBEDTLS_PLATFORM_MEMORY
 #define MBEDTLS_PLATFORM_NO_STD_FUNCTIONS
 /* Prevent mbed TLS from using snprintf so that it can use tf_snprintf. */
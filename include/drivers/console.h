@@ -71,6 +71,13 @@ void console_set_scope(console_t *console, unsigned int scope);
 void console_switch_state(unsigned int new_state);
 /* Output a character on all consoles registered for the current state. */
 int console_putc(int c);
+/*
+ * Enter/leave a quiet region: while at least one region is active, output is
+ * buffered and only emitted once the outermost region exits (or on
+ * console_flush()). Regions may nest.
+ */
+void console_quiet_enter(void);
+void console_quiet_exit(void);
 /* Read a character (blocking) from any console registered for current state. */
 int console_getc(void);
 /* Flush all consoles registered for the current state. */
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef CONSOLE_BUFFERED_H
+#define CONSOLE_BUFFERED_H
+
+#include <drivers/console.h>
+
+/*
+ * Byte size of the per-CPU ring buffers. Must be a power of two. Platforms
+ * may override it from platform_def.h.
+ */
+#ifndef CONSOLE_BUFFERED_BUF_SIZE
+#define CONSOLE_BUFFERED_BUF_SIZE	U(512)
+#endif
+
+#ifndef __ASSEMBLER__
+
+typedef struct {
+	console_t console;
+	console_t *backend;
+} console_buffered_t;
+
+/*
+ * Initialize and register a buffered console wrapping the already
+ * initialized backend console. Characters are stored in a lock-free per-CPU
+ * ring buffer and only reach the backend when the console is flushed, so
+ * logging on runtime paths costs a memory write instead of a UART drain.
+ * The oldest characters are overwritten when a ring overflows. The caller
+ * keeps the backend out of the scopes served by the buffered console, and
+ * arranges for console_flush() to run on idle and panic paths.
+ */
+int console_buffered_register(console_t *backend,
+			      console_buffered_t *console);
+
+/*
+ * Register a buffered console with no backend yet, so that output issued
+ * before any hardware console can be brought up (e.g. before clock and
+ * pinmux init) is captured in the rings instead of being lost. Flushing
+ * is a no-op until console_buffered_bind() provides the backend, which
+ * replays the buffered characters through it. Until then the rings also
+ * stay intact in memory for debugger inspection if the boot dies early.
+ */
+int console_buffered_register_early(console_buffered_t *console);
+
+/* Late-bind the backend of an early buffered console and drain the rings */
+void console_buffered_bind(console_t *backend, console_buffered_t *console);
+
+#endif /*__ASSEMBLER__*/
+
+#endif /* CONSOLE_BUFFERED_H */
@@ -49,5 +49,6 @@ static inline bool timeout_elapsed(uint64_t expire_cnt)
 void mdelay(uint32_t msec);
 void udelay(uint32_t usec);
 void timer_init(const timer_ops_t *ops_ptr);
+void timer_init_generic(const timer_ops_t *ops_ptr);
 
 #endif /* DELAY_TIMER_H */
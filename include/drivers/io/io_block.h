@@ -19,6 +19,14 @@ typedef struct io_block_dev_spec {
 	io_block_spec_t	buffer;
 	io_block_ops_t	ops;
 	size_t		block_size;
+	/*
+	 * Optional read-ahead cache memory. When length is non-zero, small
+	 * reads are served from this window and refills fetch the whole
+	 * window in one device transaction, so the many short sequential
+	 * reads issued for image metadata stop costing one transaction
+	 * each. Leave zeroed to keep the driver uncached.
+	 */
+	io_block_spec_t	cache;
 } io_block_dev_spec_t;
 
 struct io_dev_connector;
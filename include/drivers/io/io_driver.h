@@ -43,6 +43,21 @@ typedef struct io_dev_funcs {
 	int (*size)(io_entity_t *entity, size_t *length);
 	int (*read)(io_entity_t *entity, uintptr_t buffer, size_t length,
 			size_t *length_read);
+	/* Optional asynchronous read support. read_async submits a transfer
+	 * and returns without waiting for the data; poll completes it and
+	 * reports the transferred length. Drivers without background
+	 * transfer capability may leave both NULL: the framework then
+	 * emulates the pair with a synchronous read at submission time */
+	int (*read_async)(io_entity_t *entity, uintptr_t buffer,
+			size_t length);
+	int (*poll)(io_entity_t *entity, size_t *length_read);
+	/* Optional zero-copy access. get_buffer reports the location of the
+	 * entity's whole content in the memory map, for devices whose backing
+	 * store is directly addressable. Drivers whose content cannot be
+	 * accessed in place leave it NULL: the framework then reports
+	 * -ENOTSUP and callers fall back to read */
+	int (*get_buffer)(io_entity_t *entity, uintptr_t *buffer,
+			size_t *length);
 	int (*write)(io_entity_t *entity, const uintptr_t buffer,
 			size_t length, size_t *length_written);
 	int (*close)(io_entity_t *entity);
@@ -56,4 +71,9 @@ typedef struct io_dev_funcs {
 /* Register an IO device */
 int io_register_device(const io_dev_info_t *dev_info);
 
+/* Seal the device registry once platform setup is complete. Further
+ * registrations are refused, which lets readers treat the registered set
+ * as immutable for the rest of the boot stage */
+void io_storage_freeze(void);
+
 #endif /* IO_DRIVER_H */
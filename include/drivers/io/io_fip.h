@@ -8,7 +8,10 @@
 #define IO_FIP_H
 
 struct io_dev_connector;
+struct uuid;
 
 int register_io_dev_fip(const struct io_dev_connector **dev_con);
+int fip_get_entry_offset(const struct uuid *uuid,
+			 unsigned long long *offset);
 
 #endif /* IO_FIP_H */
@@ -44,6 +44,15 @@ typedef struct io_mtd_ops {
 	 * Return 0 on success, a negative error code otherwise.
 	 */
 	int (*write)(unsigned int offset, uintptr_t buffer, size_t length);
+
+	/*
+	 * Erase the erase block containing a given offset.
+	 *
+	 * @offset: Offset in bytes of the block to erase, aligned on the
+	 *	    device erase size.
+	 * Return 0 on success, a negative error code otherwise.
+	 */
+	int (*erase)(unsigned int offset);
 } io_mtd_ops_t;
 
 typedef struct io_mtd_dev_spec {
@@ -99,6 +99,22 @@ int io_read(uintptr_t handle, uintptr_t buffer, size_t length,
 int io_write(uintptr_t handle, const uintptr_t buffer, size_t length,
 		size_t *length_written);
 
+
+/* Asynchronous operations. io_read_async() submits a transfer and returns
+ * immediately; io_poll() waits for its completion and reports the length
+ * transferred. Only one transfer may be outstanding per entity. On devices
+ * whose driver has no background transfer support, the transfer is carried
+ * out synchronously at submission time and io_poll() only reports it. */
+int io_read_async(uintptr_t handle, uintptr_t buffer, size_t length);
+
+int io_poll(uintptr_t handle, size_t *length_read);
+
+/* Zero-copy access. io_get_buffer() reports the location of the whole entity
+ * content in the memory map, so that it can be consumed in place without an
+ * intermediate io_read() copy. Returns -ENOTSUP on devices whose content is
+ * not directly addressable, in which case the caller must use io_read(). */
+int io_get_buffer(uintptr_t handle, uintptr_t *buffer, size_t *length);
+
 int io_close(uintptr_t handle);
 
 
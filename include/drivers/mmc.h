@@ -60,6 +60,7 @@
 #define CMD_EXTCSD_PARTITION_CONFIG	179
 #define CMD_EXTCSD_BUS_WIDTH		183
 #define CMD_EXTCSD_HS_TIMING		185
+#define CMD_EXTCSD_DEVICE_TYPE		196
 #define CMD_EXTCSD_SEC_CNT		212
 
 #define PART_CFG_BOOT_PARTITION1_ENABLE	(U(1) << 3)
@@ -75,6 +76,19 @@
 #define MMC_BOOT_MODE_HS_TIMING		(U(1) << 3)
 #define MMC_BOOT_MODE_DDR		(U(2) << 3)
 
+/* Values in EXT CSD HS_TIMING register */
+#define MMC_HS_TIMING_DEFAULT		U(0)
+#define MMC_HS_TIMING_HS		U(1)
+#define MMC_HS_TIMING_HS200		U(2)
+
+/* Capability bits in EXT CSD DEVICE_TYPE register */
+#define MMC_DEVICE_TYPE_HS_26		BIT(0)
+#define MMC_DEVICE_TYPE_HS_52		BIT(1)
+#define MMC_DEVICE_TYPE_DDR_52_1V8_3V	BIT(2)
+#define MMC_DEVICE_TYPE_DDR_52_1V2	BIT(3)
+#define MMC_DEVICE_TYPE_HS200_1V8	BIT(4)
+#define MMC_DEVICE_TYPE_HS200_1V2	BIT(5)
+
 #define EXTCSD_SET_CMD			(U(0) << 24)
 #define EXTCSD_SET_BITS			(U(1) << 24)
 #define EXTCSD_CLR_BITS			(U(2) << 24)
@@ -105,6 +119,17 @@
 
 #define MMC_FLAG_CMD23			(U(1) << 0)
 #define MMC_FLAG_SD_CMD6		(U(1) << 1)
+#define MMC_FLAG_DDR52			(U(1) << 2)
+#define MMC_FLAG_HS200			(U(1) << 3)
+
+/*
+ * mmc_write_blocks_multi() transfer flags. A reliable write guarantees
+ * atomicity at block granularity across power loss; it is requested
+ * through bit 31 of the CMD23 argument and thus needs MMC_FLAG_CMD23.
+ */
+#define MMC_WR_FLAG_REL			(U(1) << 0)
+
+#define MMC_CMD23_ARG_REL_WR		(U(1) << 31)
 
 #define CMD8_CHECK_PATTERN		U(0xAA)
 #define VHS_2_7_3_6_V			BIT(8)
@@ -122,6 +147,12 @@ struct mmc_cmd {
 	unsigned int	resp_data[4];
 };
 
+/* One element of a scatter list handed to mmc_read_blocks_multi() */
+struct mmc_buf {
+	uintptr_t	buf;
+	size_t		size;
+};
+
 struct mmc_ops {
 	void (*init)(void);
 	int (*send_cmd)(struct mmc_cmd *cmd);
@@ -129,6 +160,35 @@ struct mmc_ops {
 	int (*prepare)(int lba, uintptr_t buf, size_t size);
 	int (*read)(int lba, uintptr_t buf, size_t size);
 	int (*write)(int lba, const uintptr_t buf, size_t size);
+	/*
+	 * Optional scatter list support: transfer several buffers with a
+	 * single data command. A driver may return -EOPNOTSUPP from
+	 * prepare_multi() for lists it cannot handle, in which case the
+	 * framework falls back to one command per buffer.
+	 */
+	int (*prepare_multi)(int lba, const struct mmc_buf *bufs,
+			     unsigned int count);
+	int (*read_multi)(int lba, const struct mmc_buf *bufs,
+			  unsigned int count);
+	/*
+	 * Optional write data path. Controllers whose data path is not
+	 * direction agnostic provide prepare_wr(); the framework falls
+	 * back to prepare() when it is NULL. The scatter list pair
+	 * mirrors prepare_multi()/read_multi(), including the
+	 * -EOPNOTSUPP fallback contract.
+	 */
+	int (*prepare_wr)(int lba, const uintptr_t buf, size_t size);
+	int (*prepare_wr_multi)(int lba, const struct mmc_buf *bufs,
+				unsigned int count);
+	int (*write_multi)(int lba, const struct mmc_buf *bufs,
+			   unsigned int count);
+	/*
+	 * Optional sampling point tuning, required for the HS200 bus speed
+	 * mode. The framework invokes it right after raising the bus clock;
+	 * the driver sends CMD21 tuning blocks while stepping its sampling
+	 * delay and returns a negative error code if no delay works.
+	 */
+	int (*execute_tuning)(unsigned int clk, unsigned int width);
 };
 
 struct mmc_csd_emmc {
@@ -241,6 +301,15 @@ enum mmc_device_type {
 	MMC_IS_SD_HC,
 };
 
+/*
+ * Values of the MMC_DEVICE_TYPE build option. MMC_ALL_DEVICES keeps the
+ * runtime mmc_dev_type checks, the other values specialize the driver
+ * for a single device family at build time.
+ */
+#define MMC_ALL_DEVICES			0
+#define MMC_EMMC_ONLY			1
+#define MMC_SD_ONLY			2
+
 struct mmc_device_info {
 	unsigned long long	device_size;	/* Size of device in bytes */
 	unsigned int		block_size;	/* Block size in bytes */
@@ -250,7 +319,11 @@ struct mmc_device_info {
 };
 
 size_t mmc_read_blocks(int lba, uintptr_t buf, size_t size);
+size_t mmc_read_blocks_multi(int lba, const struct mmc_buf *bufs,
+			     unsigned int count);
 size_t mmc_write_blocks(int lba, const uintptr_t buf, size_t size);
+size_t mmc_write_blocks_multi(int lba, const struct mmc_buf *bufs,
+			      unsigned int count, unsigned int flags);
 size_t mmc_erase_blocks(int lba, size_t size);
 size_t mmc_rpmb_read_blocks(int lba, uintptr_t buf, size_t size);
 size_t mmc_rpmb_write_blocks(int lba, const uintptr_t buf, size_t size);
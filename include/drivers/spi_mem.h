@@ -82,6 +82,7 @@ struct spi_mem_op {
 #define SPI_TX_QUAD	BIT(7)			/* transmit with 4 wires */
 #define SPI_RX_DUAL	BIT(8)			/* receive with 2 wires */
 #define SPI_RX_QUAD	BIT(9)			/* receive with 4 wires */
+#define SPI_DUAL_FLASH	BIT(10)			/* two flashes, byte-interleaved */
 
 struct spi_bus_ops {
 	/*
@@ -124,6 +125,7 @@ struct spi_bus_ops {
 };
 
 int spi_mem_exec_op(const struct spi_mem_op *op);
+bool spi_mem_dual_flash(void);
 int spi_mem_init_slave(void *fdt, int bus_node,
 		       const struct spi_bus_ops *ops);
 
@@ -23,6 +23,9 @@
 #define SPINOR_OP_BRWR		0x17U	/* Bank register write */
 #define SPINOR_OP_BRRD		0x16U	/* Bank register read */
 
+#define SPI_NOR_OP_PP		0x02U	/* Page program (up to 256 bytes) */
+#define SPI_NOR_OP_SE		0xD8U	/* Sector erase (usually 64KiB) */
+
 #define SPI_NOR_OP_READ		0x03U	/* Read data bytes (low frequency) */
 #define SPI_NOR_OP_READ_FAST	0x0BU	/* Read data bytes (high frequency) */
 #define SPI_NOR_OP_READ_1_1_2	0x3BU	/* Read data bytes (Dual Output SPI) */
@@ -33,10 +36,13 @@
 /* Flags for NOR specific configuration */
 #define SPI_NOR_USE_FSR		BIT(0)
 #define SPI_NOR_USE_BANK	BIT(1)
+#define SPI_NOR_DUAL_FLASH	BIT(2)
 
 struct nor_device {
 	struct spi_mem_op read_op;
 	uint32_t size;
+	uint32_t page_size;
+	uint32_t erase_size;
 	uint32_t flags;
 	uint8_t selected_bank;
 	uint8_t bank_write_cmd;
@@ -45,6 +51,8 @@ struct nor_device {
 
 int spi_nor_read(unsigned int offset, uintptr_t buffer, size_t length,
 		 size_t *length_read);
+int spi_nor_write(unsigned int offset, uintptr_t buffer, size_t length);
+int spi_nor_erase(unsigned int offset);
 int spi_nor_init(unsigned long long *device_size, unsigned int *erase_size);
 
 /*
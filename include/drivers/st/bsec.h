@@ -126,6 +126,7 @@ uint32_t bsec_read_permanent_lock(uint32_t otp, bool *value);
 uint32_t bsec_otp_lock(uint32_t service);
 
 uint32_t bsec_shadow_read_otp(uint32_t *otp_value, uint32_t word);
+void bsec_shadow_cache_invalidate(uint32_t otp);
 uint32_t bsec_check_nsec_access_rights(uint32_t otp);
 
 #endif /* BSEC_H */
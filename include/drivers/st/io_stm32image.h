@@ -9,11 +9,40 @@
 
 #include <drivers/io/io_driver.h>
 #include <drivers/partition/partition.h>
+#include <lib/utils_def.h>
 
 #define MAX_LBA_SIZE		512
 #define MAX_PART_NAME_SIZE	(EFI_NAMELEN + 1)
 #define STM32_PART_NUM		(PLAT_PARTITION_MAX_ENTRIES - STM32_TF_A_COPIES)
 
+/*
+ * Sparse image support: the stm32image tool can strip large zero-filled
+ * regions from the payload.  Such images carry this bit in the header
+ * option flags and a segment table right after the STM32 header, sized
+ * so that header plus table fill the first LBA exactly.  Each segment
+ * gives the destination offset and length of one packed data run; the
+ * loader zero-fills the holes in between.
+ */
+#define STM32IMAGE_OPTION_SPARSE	BIT(2)
+
+/* Magic = 'S' 'P' 'R' 'S' */
+#define STM32IMAGE_SPARSE_MAGIC		U(0x53505253)
+#define STM32IMAGE_SPARSE_MAX_SEGMENTS	U(30)
+
+struct stm32image_sparse_segment {
+	uint32_t offset;
+	uint32_t length;
+};
+
+struct stm32image_sparse_table {
+	uint32_t magic;
+	uint32_t expanded_length;
+	uint32_t segment_count;
+	uint32_t reserved;
+	struct stm32image_sparse_segment
+		segment[STM32IMAGE_SPARSE_MAX_SEGMENTS];
+};
+
 struct stm32image_part_info {
 	char name[MAX_PART_NAME_SIZE];
 	uint32_t binary_type;
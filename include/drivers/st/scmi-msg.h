@@ -167,6 +167,105 @@ int32_t plat_scmi_clock_get_state(unsigned int agent_id, unsigned int scmi_id);
 int32_t plat_scmi_clock_set_state(unsigned int agent_id, unsigned int scmi_id,
 				  bool enable_not_disable);
 
+/* Handlers for SCMI Performance Domain protocol services */
+
+/*
+ * struct scmi_perfd_level - Description of a performance level
+ * @performance_level: Performance level value, expressed in kilohertz
+ * @power_cost: Power cost of the level, in platform specific units
+ * @latency_us: Worst case transition latency to this level, in microseconds
+ */
+struct scmi_perfd_level {
+	unsigned int performance_level;
+	unsigned int power_cost;
+	unsigned int latency_us;
+};
+
+/*
+ * Return number of performance domains for the agent
+ * @agent_id: SCMI agent ID
+ * Return number of performance domains
+ */
+size_t plat_scmi_perfd_count(unsigned int agent_id);
+
+/*
+ * Get performance domain string ID (aka name)
+ * @agent_id: SCMI agent ID
+ * @scmi_id: SCMI performance domain ID
+ * Return pointer to name or NULL
+ */
+const char *plat_scmi_perfd_get_name(unsigned int agent_id,
+				     unsigned int scmi_id);
+
+/*
+ * Get the sustained performance level of a performance domain
+ * @agent_id: SCMI agent ID
+ * @scmi_id: SCMI performance domain ID
+ * Return sustained performance level or 0 if not supported
+ */
+unsigned int plat_scmi_perfd_sustained_level(unsigned int agent_id,
+					     unsigned int scmi_id);
+
+/*
+ * Get performance domain levels as an array of level descriptions
+ *
+ * @agent_id: SCMI agent ID
+ * @scmi_id: SCMI performance domain ID
+ * @start_index: Level index to start from when @levels is not NULL
+ * @levels: If NULL, function returns, else output level array
+ * @nb_elts: Array size of @levels.
+ * Return an SCMI compliant error code
+ */
+int32_t plat_scmi_perfd_levels_array(unsigned int agent_id,
+				     unsigned int scmi_id, size_t start_index,
+				     struct scmi_perfd_level *levels,
+				     size_t *nb_elts);
+
+/*
+ * Get current performance level
+ * @agent_id: SCMI agent ID
+ * @scmi_id: SCMI performance domain ID
+ * @level: Output performance level
+ * Return an SCMI compliant error code
+ */
+int32_t plat_scmi_perfd_get_level(unsigned int agent_id, unsigned int scmi_id,
+				  unsigned int *level);
+
+/*
+ * Set performance level, platform executes the full operating point
+ * transition sequence (voltage and frequency) in the request context.
+ * @agent_id: SCMI agent ID
+ * @scmi_id: SCMI performance domain ID
+ * @level: Target performance level
+ * Return a compliant SCMI error code
+ */
+int32_t plat_scmi_perfd_set_level(unsigned int agent_id, unsigned int scmi_id,
+				  unsigned int level);
+
+/*
+ * Get performance level limits
+ * @agent_id: SCMI agent ID
+ * @scmi_id: SCMI performance domain ID
+ * @range_max: Output maximum allowed performance level
+ * @range_min: Output minimum allowed performance level
+ * Return an SCMI compliant error code
+ */
+int32_t plat_scmi_perfd_get_limits(unsigned int agent_id, unsigned int scmi_id,
+				   unsigned int *range_max,
+				   unsigned int *range_min);
+
+/*
+ * Set performance level limits
+ * @agent_id: SCMI agent ID
+ * @scmi_id: SCMI performance domain ID
+ * @range_max: Maximum allowed performance level
+ * @range_min: Minimum allowed performance level
+ * Return a compliant SCMI error code
+ */
+int32_t plat_scmi_perfd_set_limits(unsigned int agent_id, unsigned int scmi_id,
+				   unsigned int range_max,
+				   unsigned int range_min);
+
 /* Handlers for SCMI Reset Domain protocol services */
 
 /*
@@ -204,4 +303,92 @@ int32_t plat_scmi_rd_autonomous(unsigned int agent_id, unsigned int scmi_id,
 int32_t plat_scmi_rd_set_state(unsigned int agent_id, unsigned int scmi_id,
 			       bool assert_not_deassert);
 
+/* Handlers for SCMI Voltage Domain protocol services */
+
+/* Platform-to-agent configuration values for a voltage domain state */
+#define SCMI_VOLTD_CONFIG_ON	0x7U
+#define SCMI_VOLTD_CONFIG_OFF	0U
+
+/*
+ * Return number of voltage domains for the agent
+ * @agent_id: SCMI agent ID
+ * Return number of voltage domains
+ */
+size_t plat_scmi_voltd_count(unsigned int agent_id);
+
+/*
+ * Get voltage domain string ID (aka name)
+ * @agent_id: SCMI agent ID
+ * @scmi_id: SCMI voltage domain ID
+ * Return pointer to name or NULL
+ */
+const char *plat_scmi_voltd_get_name(unsigned int agent_id,
+				     unsigned int scmi_id);
+
+/*
+ * Get voltage domain possible levels as an array of voltages in microvolts.
+ *
+ * @agent_id: SCMI agent ID
+ * @scmi_id: SCMI voltage domain ID
+ * @start_index: Level index to start from when @levels is not NULL
+ * @levels: If NULL, function returns, else output levels array
+ * @nb_elts: Array size of @levels.
+ * Return an SCMI compliant error code
+ */
+int32_t plat_scmi_voltd_levels_array(unsigned int agent_id,
+				     unsigned int scmi_id, size_t start_index,
+				     long *levels, size_t *nb_elts);
+
+/*
+ * Get voltage domain possible levels as range with regular steps in microvolts
+ *
+ * @agent_id: SCMI agent ID
+ * @scmi_id: SCMI voltage domain ID
+ * @min_max_step: 3 cell array for min, max and step voltage data
+ * Return an SCMI compliant error code
+ */
+int32_t plat_scmi_voltd_levels_by_step(unsigned int agent_id,
+				       unsigned int scmi_id,
+				       long *min_max_step);
+
+/*
+ * Get current voltage level in microvolts
+ * @agent_id: SCMI agent ID
+ * @scmi_id: SCMI voltage domain ID
+ * @level_uv: Output voltage level
+ * Return an SCMI compliant error code
+ */
+int32_t plat_scmi_voltd_get_level(unsigned int agent_id, unsigned int scmi_id,
+				  long *level_uv);
+
+/*
+ * Set voltage level in microvolts
+ * @agent_id: SCMI agent ID
+ * @scmi_id: SCMI voltage domain ID
+ * @level_uv: Target voltage level
+ * Return a compliant SCMI error code
+ */
+int32_t plat_scmi_voltd_set_level(unsigned int agent_id, unsigned int scmi_id,
+				  long level_uv);
+
+/*
+ * Get voltage domain state configuration (enabled or disabled)
+ * @agent_id: SCMI agent ID
+ * @scmi_id: SCMI voltage domain ID
+ * @config: Output configuration value
+ * Return an SCMI compliant error code
+ */
+int32_t plat_scmi_voltd_get_config(unsigned int agent_id, unsigned int scmi_id,
+				   uint32_t *config);
+
+/*
+ * Set voltage domain state configuration (enabled or disabled)
+ * @agent_id: SCMI agent ID
+ * @scmi_id: SCMI voltage domain ID
+ * @config: Target configuration value
+ * Return a compliant SCMI error code
+ */
+int32_t plat_scmi_voltd_set_config(unsigned int agent_id, unsigned int scmi_id,
+				   uint32_t config);
+
 #endif /* SCMI_MSG_H */
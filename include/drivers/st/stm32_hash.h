@@ -21,4 +21,20 @@ int stm32_hash_final_update(const uint8_t *buffer, uint32_t buf_length,
 void stm32_hash_init(enum stm32_hash_algo_mode mode);
 int stm32_hash_register(void);
 
+/*
+ * Suspend the digest computation in progress into a free context of the
+ * driver pool so that the peripheral can serve another stream. Return the
+ * context handle on success, -ENOMEM if the pool is exhausted or a negative
+ * error code if the peripheral does not settle.
+ */
+int stm32_hash_suspend(void);
+
+/*
+ * Resume the digest computation saved in context @handle, as returned by
+ * stm32_hash_suspend(), and release the context. The stream interrupted by
+ * the suspend call must have completed or been suspended itself.
+ * Return 0 on success, -EINVAL on an invalid or free handle.
+ */
+int stm32_hash_resume(int handle);
+
 #endif /* STM32_HASH_H */
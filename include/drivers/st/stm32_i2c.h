@@ -246,6 +246,11 @@ struct i2c_handle_s {
 	uint32_t saved_frequency;		/* Saved frequency value  */
 };
 
+struct stm32_i2c_reg_write {
+	uint16_t mem_addr;			/* Internal memory address */
+	uint8_t value;				/* Value to be written    */
+};
+
 #define I2C_ADDRESSINGMODE_7BIT		0x00000001U
 #define I2C_ADDRESSINGMODE_10BIT	0x00000002U
 
@@ -311,6 +316,10 @@ int stm32_i2c_init(struct i2c_handle_s *hi2c,
 int stm32_i2c_mem_write(struct i2c_handle_s *hi2c, uint16_t dev_addr,
 			uint16_t mem_addr, uint16_t mem_add_size,
 			uint8_t *p_data, uint16_t size, uint32_t timeout_ms);
+int stm32_i2c_mem_write_seq(struct i2c_handle_s *hi2c, uint16_t dev_addr,
+			    uint16_t mem_add_size,
+			    const struct stm32_i2c_reg_write *writes,
+			    unsigned int count, uint32_t timeout_ms);
 int stm32_i2c_mem_read(struct i2c_handle_s *hi2c, uint16_t dev_addr,
 		       uint16_t mem_addr, uint16_t mem_add_size,
 		       uint8_t *p_data, uint16_t size, uint32_t timeout_ms);
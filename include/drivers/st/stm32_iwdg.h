@@ -9,12 +9,19 @@
 
 #include <stdint.h>
 
+#include <lib/utils_def.h>
+
 #define IWDG_HW_ENABLED			BIT(0)
 #define IWDG_DISABLE_ON_STOP		BIT(1)
 #define IWDG_DISABLE_ON_STANDBY		BIT(2)
 
+/* Suggested cooperative refresh period during long boot stage operations */
+#define IWDG_CHECKPOINT_PERIOD_MS	U(100)
+
 int stm32_iwdg_init(void);
 void stm32_iwdg_refresh(void);
+void stm32_iwdg_checkpoint_setup(uint32_t period_ms);
+void stm32_iwdg_checkpoint(void);
 void __dead2 stm32_iwdg_it_handler(int id);
 
 #endif /* STM32_IWDG_H */
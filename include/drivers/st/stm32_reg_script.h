@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2021, STMicroelectronics - All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef STM32_REG_SCRIPT_H
+#define STM32_REG_SCRIPT_H
+
+#include <stdint.h>
+
+#include <lib/utils_def.h>
+
+/*
+ * Compact register scripts for fixed peripheral programming sequences.
+ *
+ * A script is a const table of entries, each one register operation:
+ * plain write, read-modify-write under a mask, a poll until masked bits
+ * reach a value, or a barrier. reg_script_run() executes the table in a
+ * single dense loop, so sequences that were scattered write-one-register
+ * C statements (suspend entry and wake re-initialization in particular)
+ * become straight-line table walks with no intervening call chains, and
+ * their timing is the same on every run.
+ *
+ * The few values that are not known at build time (for instance the
+ * low-power mode configuration) are passed through a small parameter
+ * array: an RMW_PARAM entry takes its value from params[] by index, so
+ * the script itself stays const and lives in rodata.
+ */
+
+#define REG_SCRIPT_OP_END	U(0)
+#define REG_SCRIPT_OP_WRITE	U(1)
+#define REG_SCRIPT_OP_RMW	U(2)
+#define REG_SCRIPT_OP_RMW_PARAM	U(3)
+#define REG_SCRIPT_OP_POLL	U(4)
+#define REG_SCRIPT_OP_SYNC	U(5)
+
+struct reg_script_entry {
+	uint32_t op;
+	uint32_t addr;
+	uint32_t mask;
+	uint32_t val;
+};
+
+/* Write val to addr */
+#define REG_SCRIPT_WRITE(_addr, _val) \
+	{ .op = REG_SCRIPT_OP_WRITE, .addr = (_addr), .val = (_val) }
+
+/* Clear the mask bits of addr, then set the val bits */
+#define REG_SCRIPT_RMW(_addr, _mask, _val) \
+	{ .op = REG_SCRIPT_OP_RMW, .addr = (_addr), .mask = (_mask), \
+	  .val = (_val) }
+
+#define REG_SCRIPT_SETBITS(_addr, _bits) \
+	REG_SCRIPT_RMW(_addr, _bits, _bits)
+
+#define REG_SCRIPT_CLRBITS(_addr, _bits) \
+	REG_SCRIPT_RMW(_addr, _bits, 0U)
+
+/* As REG_SCRIPT_RMW, with the value taken from params[_idx] at run time */
+#define REG_SCRIPT_RMW_PARAM(_addr, _mask, _idx) \
+	{ .op = REG_SCRIPT_OP_RMW_PARAM, .addr = (_addr), .mask = (_mask), \
+	  .val = (_idx) }
+
+/* Busy-wait until the mask bits of addr read back as val */
+#define REG_SCRIPT_POLL(_addr, _mask, _val) \
+	{ .op = REG_SCRIPT_OP_POLL, .addr = (_addr), .mask = (_mask), \
+	  .val = (_val) }
+
+/* Data synchronization and instruction barrier */
+#define REG_SCRIPT_SYNC() \
+	{ .op = REG_SCRIPT_OP_SYNC }
+
+#define REG_SCRIPT_END \
+	{ .op = REG_SCRIPT_OP_END }
+
+void reg_script_run(const struct reg_script_entry *script,
+		    const uint32_t *params);
+
+#endif /* STM32_REG_SCRIPT_H */
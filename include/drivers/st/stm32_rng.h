@@ -10,4 +10,12 @@
 int stm32_rng_read(uint8_t *out, uint32_t size);
 int stm32_rng_init(void);
 
+/*
+ * Top up the driver entropy pool with words the RNG already generated,
+ * without waiting on generation. Meant to be called from idle hooks so
+ * that stm32_rng_read() is served as a memory copy. No-op before init or
+ * when the pool is disabled (STM32_RNG_POOL_SIZE set to 0).
+ */
+void stm32_rng_pool_refill(void);
+
 #endif /* STM32_RNG_H */
@@ -69,6 +69,9 @@ unsigned long long stm32_rtc_diff_calendar(struct stm32_rtc_calendar *current,
 void stm32_rtc_set_tamper_timestamp(void);
 bool stm32_rtc_is_timestamp_enable(void);
 void stm32_rtc_get_timestamp(struct stm32_rtc_time *tamp_ts);
+bool stm32_rtc_latch_timestamp(struct stm32_rtc_calendar *cal);
+void stm32_rtc_calendar_to_time(struct stm32_rtc_calendar *cal,
+				struct stm32_rtc_time *tm);
 int stm32_rtc_init(void);
 
 /* SMP protection on RTC registers access */
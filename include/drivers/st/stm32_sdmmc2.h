@@ -14,6 +14,7 @@
 
 struct stm32_sdmmc2_params {
 	uintptr_t		reg_base;
+	uintptr_t		dlyb_base;
 	unsigned int		clk_rate;
 	unsigned int		bus_width;
 	unsigned int		flags;
@@ -29,6 +30,7 @@ struct stm32_sdmmc2_params {
 };
 
 unsigned long long stm32_sdmmc2_mmc_get_device_size(void);
+unsigned int stm32_sdmmc2_get_retry_count(void);
 int stm32_sdmmc2_mmc_init(struct stm32_sdmmc2_params *params);
 bool plat_sdmmc2_use_dma(unsigned int instance, unsigned int memory);
 
@@ -130,10 +130,17 @@ struct stm32_tamp_ext {
 void stm32_tamp_write_mcounter(void);
 
 /*
- * stm32_tamp_it_handler : Interrupt handler
+ * stm32_tamp_it_handler : Interrupt handler, only latches and
+ * acknowledges the hardware state
  */
 void stm32_tamp_it_handler(void);
 
+/*
+ * stm32_tamp_drain_events : Classify, log and run the callbacks of the
+ * latched events; called from the idle path, with FIQs masked
+ */
+void stm32_tamp_drain_events(void);
+
 /*
  * stm32_tamp_configure_internal: Configure internal tamper
  * tamper_list: List of tamper to enable
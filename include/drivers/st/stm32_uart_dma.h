@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2021, STMicroelectronics - All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef STM32_UART_DMA_H
+#define STM32_UART_DMA_H
+
+#include <drivers/console.h>
+#include <lib/utils_def.h>
+
+/*
+ * Number of software TX lanes. Lane 0 has the highest priority and always
+ * drains first; the console putc path feeds it. Platforms may override the
+ * lane count and the per-lane ring size from platform_def.h.
+ */
+#ifndef STM32_UART_DMA_NR_LANES
+#define STM32_UART_DMA_NR_LANES		U(2)
+#endif
+
+/* Byte size of each lane ring. Must be a power of two. */
+#ifndef STM32_UART_DMA_LANE_SIZE
+#define STM32_UART_DMA_LANE_SIZE	U(2048)
+#endif
+
+/* Lane served by the console putc callback */
+#define STM32_UART_DMA_LANE_CONSOLE	U(0)
+
+#ifndef __ASSEMBLER__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+struct stm32_uart_dma_cfg {
+	uintptr_t uart_base;	/* Initialized and enabled USART */
+	uintptr_t dma_base;	/* DMA controller serving the stream */
+	uint32_t stream;	/* DMA stream number, 0 to 7 */
+	unsigned long dma_clock;	/* DMA controller clock identifier */
+	uintptr_t dmamux_base;	/* DMAMUX routing the stream request */
+	uint32_t mux_chan;	/* DMAMUX channel wired to the stream */
+	unsigned long dmamux_clock;	/* DMAMUX clock identifier */
+	uint32_t request;	/* DMAMUX request line of the USART TX */
+};
+
+struct stm32_uart_dma_lane {
+	uint32_t head;
+	uint32_t tail;
+	uint32_t dropped;
+	uint8_t data[STM32_UART_DMA_LANE_SIZE];
+};
+
+struct stm32_uart_dma {
+	console_t console;
+	struct stm32_uart_dma_cfg cfg;
+	struct stm32_uart_dma_lane lane[STM32_UART_DMA_NR_LANES];
+	uint32_t active_lane;
+	uint32_t active_len;
+	bool active;
+	bool broken;
+};
+
+/*
+ * Initialize a DMA-fed multi-lane TX console on an already configured USART
+ * and register it with the console framework. Characters and lane writes
+ * are queued in RAM and moved to the USART by the DMA stream, so bulk
+ * diagnostics cost memory writes instead of a polled TX drain. The flush
+ * callback waits for the queues to empty and falls back to polled TX if the
+ * stream faults, so crash output cannot be lost behind a wedged DMA. The
+ * DMA controller and stream must be assigned to the secure world and left
+ * out of the non-secure device tree. |console| must point to storage valid
+ * for the lifetime of the console.
+ */
+int stm32_uart_dma_register(const struct stm32_uart_dma_cfg *cfg,
+			    struct stm32_uart_dma *console);
+
+/*
+ * Queue |size| bytes on a TX lane. Lanes with a lower index preempt the
+ * others at each DMA burst boundary. Returns the number of bytes queued,
+ * which is less than |size| when the lane ring is full and the stream is
+ * already busy draining it.
+ */
+size_t stm32_uart_dma_write(struct stm32_uart_dma *console, unsigned int lane,
+			    const uint8_t *buf, size_t size);
+
+/*
+ * Retire a completed DMA burst and start the next one from the highest
+ * priority non-empty lane. Cheap when there is nothing to do; platforms
+ * call it from their idle path so queued diagnostics trickle out without
+ * blocking any runtime service.
+ */
+void stm32_uart_dma_pump(struct stm32_uart_dma *console);
+
+#endif /*__ASSEMBLER__*/
+
+#endif /* STM32_UART_DMA_H */
@@ -39,6 +39,22 @@ bool stm32mp1_rcc_is_mckprot(void);
 void stm32mp1_clk_force_enable(unsigned long id);
 void stm32mp1_clk_force_disable(unsigned long id);
 
+/*
+ * Pin a clock enabled for the whole runtime phase: further refcounted
+ * enable/disable requests on it return without lock nor refcount update.
+ */
+void stm32mp1_clk_pin(unsigned long id);
+bool stm32mp1_clk_is_pinned(unsigned long id);
+
+#if STM32MP_CLK_LAZY_GATE
+/*
+ * Commit every pending lazy gate disable immediately. Must be called
+ * before entering a low power state so that deferred gates do not keep
+ * their peripheral clocked across the suspend entry.
+ */
+void stm32mp1_clk_lazy_flush(void);
+#endif
+
 unsigned long stm32mp_clk_timer_get_rate(unsigned long id);
 
 bool stm32mp1_rtc_get_read_twice(void);
@@ -51,6 +67,9 @@ unsigned long stm32mp1_clk_rcc2id(unsigned int offset, unsigned int bit);
 
 int stm32mp1_round_opp_khz(uint32_t *freq_khz);
 int stm32mp1_set_opp_khz(uint32_t freq_khz);
+int stm32mp1_clk_get_opp(unsigned int index, uint32_t *freq_khz,
+			 uint32_t *voltage_mv);
+uint32_t stm32mp1_clk_get_current_opp_khz(void);
 
 void stm32mp1_clock_suspend(void);
 void stm32mp1_clock_resume(void);
@@ -171,5 +171,7 @@ struct stm32mp1_ddr_config {
 int stm32mp1_ddr_clk_enable(struct ddr_info *priv, uint32_t mem_speed);
 void stm32mp1_ddr_init(struct ddr_info *priv,
 		       struct stm32mp1_ddr_config *config);
+void stm32mp1_ddr_get_cal(struct ddr_info *priv,
+			  struct stm32mp1_ddrphy_cal *cal);
 
 #endif /* STM32MP1_DDR_H */
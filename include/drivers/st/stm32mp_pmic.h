@@ -8,11 +8,28 @@
 #define STM32MP_PMIC_H
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 
 #include <platform_def.h>
 
 #include <drivers/st/stm32mp_regulator.h>
 
+/*
+ * pmic_regu_request - One rail target state within a regulator transaction
+ *
+ * Requests are applied in table order. Rails sharing a ramp_rank have their
+ * register writes issued back-to-back and wait a single start-up delay,
+ * instead of one delay per rail. A higher ramp_rank only starts once the
+ * previous rank has ramped, which expresses rail dependencies.
+ */
+struct pmic_regu_request {
+	const char *name;
+	uint16_t voltage_mv;	/* 0: keep the programmed voltage */
+	uint8_t ramp_rank;
+	bool enable;
+};
+
 /*
  * dt_pmic_status - Check PMIC status from device tree
  *
@@ -46,6 +63,15 @@ int dt_pmic_find_supply(const char **supply_name, const char *regu_name);
  */
 int pmic_set_regulator_min_voltage(const char *regu_name);
 
+/*
+ * pmic_apply_regu_transaction - Apply a set of rail target states
+ * back-to-back, overlapping the ramp waits of rails sharing a ramp_rank
+ *
+ * Returns 0 on success, and negative values on errors
+ */
+int pmic_apply_regu_transaction(const struct pmic_regu_request *requests,
+				size_t count);
+
 /*
  * initialize_pmic_i2c - Initialize I2C for the PMIC control
  *
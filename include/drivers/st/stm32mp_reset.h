@@ -7,6 +7,7 @@
 #ifndef STM32MP_RESET_H
 #define STM32MP_RESET_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 /*
@@ -47,6 +48,30 @@ static inline void stm32mp_reset_release(uint32_t reset_id)
 	(void)stm32mp_reset_deassert_to(reset_id, 0);
 }
 
+/*
+ * Assert several target resets with a single write per RCC register,
+ * if @to_us non null, wait until every reset is asserted
+ *
+ * @reset_ids: Array of reset controller IDs
+ * @count: Number of IDs in @reset_ids
+ * @to_us: Timeout in microsecond per register, or 0 if not waiting
+ * Return 0 on success and -ETIMEDOUT if waiting and timeout expired
+ */
+int stm32mp_reset_assert_multi_to(const uint32_t *reset_ids, size_t count,
+				  unsigned int to_us);
+
+/*
+ * Deassert several target resets with a single write per RCC register,
+ * if @to_us non null, wait until every reset is deasserted
+ *
+ * @reset_ids: Array of reset controller IDs
+ * @count: Number of IDs in @reset_ids
+ * @to_us: Timeout in microsecond per register, or 0 if not waiting
+ * Return 0 on success and -ETIMEDOUT if waiting and timeout expired
+ */
+int stm32mp_reset_deassert_multi_to(const uint32_t *reset_ids, size_t count,
+				    unsigned int to_us);
+
 /*
  * Manage reset control for the MCU reset
  *
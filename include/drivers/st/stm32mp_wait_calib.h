@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2026, STMicroelectronics - All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef STM32MP_WAIT_CALIB_H
+#define STM32MP_WAIT_CALIB_H
+
+/*
+ * Calibrated micro-delays for peripheral drivers.
+ *
+ * Several drivers pulse a reset line or poll a status flag with fixed
+ * delay constants sized for the slowest kernel clock the peripheral
+ * supports. The actual requirement is a number of peripheral clock
+ * cycles, so at the clock rates a given board really runs these
+ * constants over-wait by one to three orders of magnitude.
+ *
+ * Each wait class below carries its cycle requirement and its historic
+ * worst-case constant. A driver binds its class to the kernel clock it
+ * found in the device tree; stm32mp_wait_calib_us() then converts the
+ * cycle count at the current clock rate, clamped between 1us and the
+ * worst-case value. Unbound classes keep the worst-case behaviour.
+ */
+enum stm32mp_wait_calib_id {
+	WAIT_CALIB_RNG_RESET,		/* RNG reset pulse width */
+	WAIT_CALIB_RNG_SEED_POLL,	/* RNG seed-ready poll step */
+	WAIT_CALIB_SDMMC_RESET,		/* SDMMC reset pulse width */
+	WAIT_CALIB_SDMMC_SETTLE,	/* SDMMC post-reset settle */
+	WAIT_CALIB_NB
+};
+
+void stm32mp_wait_calib_bind(enum stm32mp_wait_calib_id id,
+			     unsigned long clock_id);
+unsigned int stm32mp_wait_calib_us(enum stm32mp_wait_calib_id id);
+
+#endif /* STM32MP_WAIT_CALIB_H */
@@ -160,6 +160,8 @@ int stpmic1_regulator_disable(const char *name);
 bool stpmic1_is_regulator_enabled(const char *name);
 int stpmic1_regulator_voltage_set(const char *name, uint16_t millivolts);
 int stpmic1_regulator_voltage_get(const char *name);
+int stpmic1_regulator_levels_mv(const char *name, const uint16_t **levels,
+				size_t *levels_count);
 int stpmic1_regulator_pull_down_set(const char *name);
 int stpmic1_regulator_mask_reset_set(const char *name);
 int stpmic1_lp_copy_reg(const char *name);
@@ -168,6 +170,15 @@ int stpmic1_lp_set_mode(const char *name, uint8_t hplp);
 int stpmic1_lp_set_voltage(const char *name, uint16_t millivolts);
 void stpmic1_bind_i2c(struct i2c_handle_s *i2c_handle, uint16_t i2c_addr);
 
+/*
+ * Batch PMIC register writes into a single chained I2C sequence. While a
+ * batch is open, register writes are queued and merged; the queue is sent
+ * to the PMIC on commit. Reads of a queued register return the queued value.
+ */
+void stpmic1_batch_start(void);
+void stpmic1_batch_discard(void);
+int stpmic1_batch_commit(void);
+
 int stpmic1_get_version(unsigned long *version);
 void stpmic1_dump_regulators(void);
 
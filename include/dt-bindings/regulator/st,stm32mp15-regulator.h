@@ -0,0 +1,19 @@
+/* SPDX-License-Identifier: BSD-3-Clause */
+/*
+ * Copyright (c) 2021, STMicroelectronics - All Rights Reserved
+ */
+
+#ifndef _DT_BINDINGS_STM32MP15_REGULATOR_H
+#define _DT_BINDINGS_STM32MP15_REGULATOR_H
+
+/* SCMI voltage domain identifiers */
+#define VOLTD_SCMI0_BUCK1	0
+#define VOLTD_SCMI0_BUCK3	1
+#define VOLTD_SCMI0_BUCK4	2
+#define VOLTD_SCMI0_LDO1	3
+#define VOLTD_SCMI0_LDO2	4
+#define VOLTD_SCMI0_LDO4	5
+#define VOLTD_SCMI0_LDO5	6
+#define VOLTD_SCMI0_LDO6	7
+
+#endif /* _DT_BINDINGS_STM32MP15_REGULATOR_H */
@@ -96,6 +96,18 @@ static inline void bakery_lock_init(bakery_lock_t *bakery) {}
 void bakery_lock_get(bakery_lock_t *bakery);
 void bakery_lock_release(bakery_lock_t *bakery);
 
+#if USE_COHERENT_MEM || BAKERY_LOCK_SINGLE_CPU
+static inline void bakery_lock_set_contended(void) {}
+#else
+/*
+ * Tell the bakery lock implementation that more than one CPU may now contend
+ * for locks. Until this is called (before the first secondary CPU is powered
+ * on), bakery_lock_get() takes a fast path that skips the full ticket
+ * allocation walk over all CPU slots. The transition is one-way.
+ */
+void bakery_lock_set_contended(void);
+#endif
+
 #define DEFINE_BAKERY_LOCK(_name) bakery_lock_t _name __section("bakery_lock")
 
 #define DECLARE_BAKERY_LOCK(_name) extern bakery_lock_t _name
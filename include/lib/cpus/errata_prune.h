@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef ERRATA_PRUNE_H
+#define ERRATA_PRUNE_H
+
+/*
+ * Timestamp ids of the errata_rst_svc PMF service. One timestamp is
+ * captured when the reset function starts applying workarounds and one
+ * after each workaround slot, so consecutive differences give the
+ * cycles spent per workaround on the last core to reset.
+ */
+#define ERRATA_TS_RESET_ENTRY		0
+#define ERRATA_TS_A53_826319		1
+#define ERRATA_TS_A53_836870		2
+#define ERRATA_TS_A53_855873		3
+#define ERRATA_TS_TOTAL_IDS		4
+
+#ifndef __ASSEMBLER__
+
+#if ENABLE_ERRATA_PRUNING
+void errata_prune(void);
+#else
+static inline void errata_prune(void)
+{
+}
+#endif
+
+#else /* __ASSEMBLER__ */
+
+#include <lib/static_branch.h>
+
+#if ENABLE_ERRATA_PRUNING
+	/*
+	 * Mark a workaround call on the reset path as prunable. The key
+	 * must have a matching entry in errata_prune_list.
+	 */
+	.macro errata_prune_site _key, _target
+	static_branch_site \_key, \_target
+	.endm
+#else
+	/* The key symbols only exist when the pruning pass is built in. */
+	.macro errata_prune_site _key, _target
+	.endm
+#endif
+
+#endif /* __ASSEMBLER__ */
+
+#endif /* ERRATA_PRUNE_H */
@@ -138,6 +138,18 @@ CASSERT(CPU_DATA_CRASH_BUF_OFFSET == __builtin_offsetof
 CASSERT(CPU_DATA_SIZE == sizeof(cpu_data_t),
 		assert_cpu_data_size_mismatch);
 
+/*
+ * Each CPU's entry must occupy an exclusive set of cache lines: the block
+ * is cache line aligned and sized in whole lines, so no two CPUs' hot
+ * fields can ever share a line. This only holds if
+ * CACHE_WRITEBACK_GRANULE covers the granule of the hardware the image
+ * runs on; CPU_DATA_CACHELINE_AUDIT adds the corresponding runtime check.
+ */
+CASSERT((sizeof(cpu_data_t) % CACHE_WRITEBACK_GRANULE) == 0U,
+		assert_cpu_data_not_cacheline_multiple);
+CASSERT((__alignof(cpu_data_t) % CACHE_WRITEBACK_GRANULE) == 0U,
+		assert_cpu_data_not_cacheline_aligned);
+
 CASSERT(CPU_DATA_CPU_OPS_PTR == __builtin_offsetof
 		(cpu_data_t, cpu_ops_ptr),
 		assert_cpu_data_cpu_ops_ptr_offset_mismatch);
@@ -167,6 +179,17 @@ struct cpu_data *_cpu_data(void);
 void init_cpu_data_ptr(void);
 void init_cpu_ops(void);
 
+#if CPU_DATA_CACHELINE_AUDIT
+/*
+ * Audit mode diagnostics: verify the hardware cache writeback granule
+ * against CACHE_WRITEBACK_GRANULE, and report how often other CPUs have
+ * touched a given CPU's cpu_data block (each such access is a potential
+ * bounce of a cache line the owner keeps hot).
+ */
+void cpu_data_audit_check_granule(void);
+uint64_t cpu_data_audit_get_remote_count(uint32_t cpu_index);
+#endif
+
 #define get_cpu_data(_m)		   _cpu_data()->_m
 #define set_cpu_data(_m, _v)		   _cpu_data()->_m = (_v)
 #define get_cpu_data_by_index(_ix, _m)	   _cpu_data_by_index(_ix)->_m
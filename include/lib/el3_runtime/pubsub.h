@@ -71,9 +71,13 @@
  *
  * The extern declaration is there to satisfy MISRA C-2012 rule 8.4.
  */
+/*
+ * The callback pointer is only referenced from the linker script, so it must
+ * be marked used to survive link-time optimization.
+ */
 #define SUBSCRIBE_TO_EVENT(event, func) \
 	extern pubsub_cb_t __cb_func_##func##event __pubsub_section(event); \
-	pubsub_cb_t __cb_func_##func##event __pubsub_section(event) = (func)
+	pubsub_cb_t __cb_func_##func##event __pubsub_section(event) __used = (func)
 
 /*
  * Iterate over subscribed handlers for a defined event. 'event' is the name of
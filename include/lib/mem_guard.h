@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef MEM_GUARD_H
+#define MEM_GUARD_H
+
+#include <stddef.h>
+
+/*
+ * Debug-build corruption detector for shared firmware state.
+ *
+ * A guarded region is a data structure that is written only through a
+ * small set of known call sites once boot has completed, such as the
+ * PSCI power domain tree. Each region is sealed with a checksum;
+ * mem_guard_check() recomputes the checksums at quiet points (typically
+ * before entering an idle or suspend state) and panics with a report
+ * naming the region when one no longer matches, so a stray write is
+ * caught within one idle period instead of surfacing later as an
+ * unrelated assertion.
+ *
+ * Hardware watchpoints cannot provide this: self-hosted debug
+ * exceptions are ignored at the highest implemented exception level
+ * (Monitor mode here), so a watchpoint can never fire on the firmware's
+ * own accesses. Checking at quiet points loses the faulting PC but
+ * still bounds the corruption window and identifies the victim.
+ *
+ * Legitimate writers bracket their update with
+ * mem_guard_begin_update()/mem_guard_end_update(), identifying the
+ * region by its base address; the region is resealed and re-armed when
+ * the last concurrent updater leaves. A region under update is skipped
+ * by mem_guard_check(), so the bracketing must be held across the write
+ * and nothing more.
+ *
+ * With ENABLE_MEM_GUARD=0 every call compiles to nothing.
+ */
+
+#if ENABLE_MEM_GUARD
+void mem_guard_register(const char *name, const void *base, size_t size);
+void mem_guard_begin_update(const void *base);
+void mem_guard_end_update(const void *base);
+void mem_guard_check(const char *where);
+#else
+static inline void mem_guard_register(const char *name, const void *base,
+				      size_t size)
+{
+}
+
+static inline void mem_guard_begin_update(const void *base)
+{
+}
+
+static inline void mem_guard_end_update(const void *base)
+{
+}
+
+static inline void mem_guard_check(const char *where)
+{
+}
+#endif /* ENABLE_MEM_GUARD */
+
+#endif /* MEM_GUARD_H */
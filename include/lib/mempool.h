@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef MEMPOOL_H
+#define MEMPOOL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Boot-phase-aware memory pool.
+ *
+ * A bump allocator over a statically reserved backing store, meant to be
+ * shared by drivers that would otherwise each reserve their worst-case
+ * bounce buffer for the lifetime of the image. The backing store is then
+ * sized for the peak demand of one boot path instead of the sum of every
+ * enabled driver's needs. Each allocation carries its own alignment, so
+ * one pool serves plain byte buffers as well as cache line or DMA
+ * aligned ones.
+ *
+ * Individual allocations cannot be freed, for the reasons given in
+ * lib/object_pool.h. Instead the pool tracks boot phases: entering a
+ * phase records the current fill level, leaving it releases every
+ * allocation made since in one go. Buffers that only serve a bounded
+ * stage of the boot (e.g. partition table parsing) are recycled
+ * wholesale for the stages that follow.
+ */
+
+#define MEMPOOL_PHASE_DEPTH	4U
+
+#if MEMPOOL_LAYOUT
+/*
+ * Precomputed placement for the persistent (phase 0) allocations of one
+ * pool, generated by tools/poolplan from the allocation log of a
+ * reference boot. Entries follow the allocation order; each one pins the
+ * buffer of that turn to a fixed offset chosen offline to spread the
+ * buffers across the cache sets. A pool whose allocation sequence has
+ * drifted from its layout (size or alignment mismatch) falls back to
+ * plain bump allocation and logs the drift, so a stale layout degrades
+ * to today's behaviour instead of corrupting placement.
+ */
+struct mempool_layout_entry {
+	uint32_t size;
+	uint32_t align;
+	uint32_t offset;
+};
+
+struct mempool_layout {
+	const char *pool;	/* Matches struct mempool .name */
+	uint32_t count;
+	const struct mempool_layout_entry *entries;
+};
+
+/*
+ * Return the layout for the named pool, or NULL to leave it on bump
+ * allocation. The weak default returns NULL; the platform overrides it
+ * with the tools/poolplan generated file.
+ */
+const struct mempool_layout *plat_mempool_layout(const char *pool);
+#endif
+
+struct mempool {
+	uint8_t *base;
+	size_t size;
+	const char *name;
+
+	/* Bytes allocated, including alignment padding. */
+	size_t used;
+
+	/* Fill levels recorded by the open phases, innermost last. */
+	size_t marks[MEMPOOL_PHASE_DEPTH];
+	unsigned int depth;
+
+#if MEMPOOL_LAYOUT
+	const struct mempool_layout *layout;
+	bool layout_probed;
+	/* Phase 0 allocations served so far, the layout entry cursor. */
+	uint32_t seq;
+#endif
+};
+
+/* Create a pool over a statically allocated backing array. */
+#define MEMPOOL(_pool_name, _backing)				\
+	struct mempool _pool_name = {				\
+		.base = (_backing),				\
+		.size = sizeof(_backing),			\
+		.name = #_pool_name,				\
+		.used = 0U,					\
+		.depth = 0U,					\
+	}
+
+/*
+ * Create an empty pool whose backing store is only known at runtime, e.g.
+ * a DDR region that exists once training completed. The pool panics on
+ * any allocation until mempool_seed() hands it its backing store.
+ */
+#define MEMPOOL_UNSEEDED(_pool_name)				\
+	struct mempool _pool_name = {				\
+		.base = NULL,					\
+		.size = 0U,					\
+		.name = #_pool_name,				\
+	}
+
+/*
+ * Allocate 'size' bytes aligned on 'align' (a power of two) from a pool.
+ * Return the address of the buffer. Panic on exhaustion.
+ */
+void *mempool_alloc(struct mempool *pool, size_t size, size_t align);
+
+/* Hand an unseeded pool its backing store. */
+void mempool_seed(struct mempool *pool, void *base, size_t size);
+
+/*
+ * Enter/leave a boot phase. Leaving a phase releases every allocation
+ * made since the matching mempool_phase_enter(). Phases nest up to
+ * MEMPOOL_PHASE_DEPTH levels.
+ */
+void mempool_phase_enter(struct mempool *pool);
+void mempool_phase_exit(struct mempool *pool);
+
+/* Bytes left in the pool, not counting future alignment padding. */
+size_t mempool_free_space(const struct mempool *pool);
+
+#endif /* MEMPOOL_H */
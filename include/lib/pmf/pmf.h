@@ -40,7 +40,32 @@
  */
 #define PMF_SMC_GET_TIMESTAMP_32	U(0x82000010)
 #define PMF_SMC_GET_TIMESTAMP_64	U(0xC2000010)
-#define PMF_NUM_SMC_CALLS		2
+#if PMF_RING_BUFFER
+#define PMF_SMC_GET_RING_ENTRY_32	U(0x82000011)
+#define PMF_SMC_GET_RING_ENTRY_64	U(0xC2000011)
+#endif
+#if PMF_DYN_CAPTURE
+#define PMF_SMC_CAPTURE_CTL_32		U(0x82000012)
+#define PMF_SMC_CAPTURE_CTL_64		U(0xC2000012)
+#endif
+#define PMF_NUM_SMC_CALLS		(2 + (2 * PMF_RING_BUFFER) + \
+					 (2 * PMF_DYN_CAPTURE))
+
+/*
+ * Operations of the capture control SMC. The site to operate on is
+ * identified by its site id; PMF_CAPTURE_CTL_COUNT ignores it and
+ * returns the number of capture sites built into the image.
+ */
+#define PMF_CAPTURE_CTL_DISABLE		U(0)
+#define PMF_CAPTURE_CTL_ENABLE		U(1)
+#define PMF_CAPTURE_CTL_QUERY		U(2)
+#define PMF_CAPTURE_CTL_COUNT		U(3)
+
+/*
+ * Argument to the ring entry SMCs requesting the number of time-stamps
+ * captured so far instead of an entry.
+ */
+#define PMF_RING_QUERY_COUNT		U(0xFFFFFFFF)
 
 /*
  * The macros below are used to identify
@@ -53,8 +78,29 @@
 /* Following are the supported PMF service IDs */
 #define PMF_PSCI_STAT_SVC_ID	0
 #define PMF_RT_INSTR_SVC_ID	1
+#define PMF_SMC_TRACE_SVC_ID	2
+#define PMF_ERRATA_RST_SVC_ID	3
+
+/* Following are the well-known PMF capture site IDs */
+#define PMF_CAPTURE_SITE_SMC_TRACE	U(0)
 
 #if ENABLE_PMF
+/*
+ * Time-stamp source. The generic counter is the default; the PMU cycle
+ * counter trades the system-wide time base for CPU-cycle resolution. The
+ * cycle counter only counts on the CPU reading it and must have been enabled
+ * with pmf_init_cycle_counter() on every CPU capturing time-stamps.
+ */
+#if PMF_CYCLE_COUNTER
+#ifdef __aarch64__
+#define PMF_READ_TIMESTAMP()	read_pmccntr_el0()
+#else
+#define PMF_READ_TIMESTAMP()	read_pmccntr()
+#endif
+#else
+#define PMF_READ_TIMESTAMP()	read_cntpct_el0()
+#endif
+
 /*
  * Convenience macros for capturing time-stamp.
  */
@@ -68,7 +114,7 @@
 
 #define PMF_CAPTURE_TIMESTAMP(_name, _tid, _flags)			\
 	do {								\
-		unsigned long long ts = read_cntpct_el0();		\
+		unsigned long long ts = PMF_READ_TIMESTAMP();		\
 		if (((_flags) & PMF_CACHE_MAINT) != 0U)			\
 			pmf_capture_timestamp_with_cache_maint_ ## _name((_tid), ts);\
 		else							\
@@ -77,7 +123,7 @@
 
 #define PMF_CAPTURE_AND_GET_TIMESTAMP(_name, _tid, _flags, _tsval)	\
 	do {								\
-		(_tsval) = read_cntpct_el0();				\
+		(_tsval) = PMF_READ_TIMESTAMP();			\
 		CASSERT(sizeof(_tsval) == sizeof(unsigned long long), invalid_tsval_size);\
 		if (((_flags) & PMF_CACHE_MAINT) != 0U)			\
 			pmf_capture_timestamp_with_cache_maint_ ## _name((_tid), (_tsval));\
@@ -85,6 +131,23 @@
 			pmf_capture_timestamp_ ## _name((_tid), (_tsval));\
 	} while (0)
 
+/*
+ * Convenience macros for runtime-togglable capture sites. The predicate
+ * compiles to a single nop when the site is disabled (with
+ * ENABLE_STATIC_BRANCH; a load and compare otherwise), so capture code
+ * can stay in production hot paths at no cost until a site is enabled
+ * through the capture control SMC.
+ */
+#define PMF_CAPTURE_SITE_ENABLED(_site)					\
+	static_branch_unlikely(&pmf_capture_site_ ## _site.key)
+
+#define PMF_CAPTURE_TIMESTAMP_DYN(_name, _site, _tid, _flags)		\
+	do {								\
+		if (PMF_CAPTURE_SITE_ENABLED(_site)) {			\
+			PMF_CAPTURE_TIMESTAMP(_name, _tid, _flags);	\
+		}							\
+	} while (0)
+
 #define PMF_WRITE_TIMESTAMP(_name, _tid, _flags, _wrval)		\
 	do {								\
 		CASSERT(sizeof(_wrval) == sizeof(unsigned long long), invalid_wrval_size);\
@@ -151,6 +214,8 @@
 #define PMF_DECLARE_CAPTURE_TIMESTAMP(_name)
 #define PMF_DECLARE_GET_TIMESTAMP(_name)
 #define PMF_CAPTURE_TIMESTAMP(_name, _tid, _flags)
+#define PMF_CAPTURE_SITE_ENABLED(_site)				false
+#define PMF_CAPTURE_TIMESTAMP_DYN(_name, _site, _tid, _flags)
 #define PMF_GET_TIMESTAMP_BY_MPIDR(_name, _tid, _mpidr, _flags, _tsval)
 #define PMF_GET_TIMESTAMP_BY_INDEX(_name, _tid, _cpuid, _flags, _tsval)
 
@@ -164,6 +229,21 @@ int pmf_get_timestamp_smc(unsigned int tid,
 		u_register_t mpidr,
 		unsigned int flags,
 		unsigned long long *ts_value);
+#if PMF_CYCLE_COUNTER
+void pmf_init_cycle_counter(void);
+#endif
+#if PMF_RING_BUFFER
+int pmf_get_ring_entry_smc(u_register_t mpidr,
+		unsigned int offset,
+		unsigned int flags,
+		unsigned int *tid,
+		unsigned long long *ts_value);
+#endif
+#if PMF_DYN_CAPTURE
+int pmf_capture_ctl_smc(unsigned int site_id,
+		unsigned int op,
+		unsigned int *state);
+#endif
 int pmf_setup(void);
 uintptr_t pmf_smc_handler(unsigned int smc_fid,
 		u_register_t x1,
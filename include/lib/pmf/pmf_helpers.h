@@ -13,6 +13,7 @@
 
 #include <arch_helpers.h>
 #include <common/bl_common.h>
+#include <lib/static_branch.h>
 #include <plat/common/platform.h>
 
 /*
@@ -147,6 +148,37 @@ typedef struct pmf_svc_desc {
 		.get_ts = _getts_by_mpidr				\
 	};
 
+/*
+ * Runtime-togglable capture site. Each site carries its own static key;
+ * the descriptors collect in the 'pmf_capture_sites' linker section so
+ * the capture control SMC can look a site up by its id. The section
+ * lives in writable data, as the key is flipped at runtime.
+ */
+typedef struct pmf_capture_site {
+	/* Name of the capture site */
+	const char *name;
+
+	/* Well-known id the control SMC addresses the site by */
+	unsigned int site_id;
+
+	/* Key gating the capture instructions at the site */
+	struct static_key key;
+} pmf_capture_site_t;
+
+/*
+ * Convenience macros to define a capture site and to reference one
+ * defined in another translation unit.
+ */
+#define PMF_DEFINE_CAPTURE_SITE(_site, _site_id)		\
+	pmf_capture_site_t pmf_capture_site_ ## _site		\
+	__section("pmf_capture_sites") __used = {		\
+		.name = #_site,					\
+		.site_id = (_site_id),				\
+	};
+
+#define PMF_DECLARE_CAPTURE_SITE(_site)				\
+	extern pmf_capture_site_t pmf_capture_site_ ## _site;
+
 /* PMF internal functions */
 void __pmf_dump_timestamp(unsigned int tid, unsigned long long ts);
 void __pmf_store_timestamp(uintptr_t base_addr,
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef PMF_SMC_TRACE_H
+#define PMF_SMC_TRACE_H
+
+#include <stdint.h>
+
+/*
+ * Runtime service latency tracer.
+ *
+ * Time-stamps are captured around the runtime service handler dispatch
+ * and the measured latency is binned, per CPU, into power-of-two
+ * histogram buckets keyed by the SMC owning entity number (OEN), so the
+ * tail latency of every secure service remains observable in production.
+ * OENs are bound to histogram slots in the order they are first
+ * dispatched; SMCs arriving once every slot is bound are only counted.
+ *
+ * The histograms are read back through the PMF "get time-stamp" SMC
+ * using service id PMF_SMC_TRACE_SVC_ID and the tid layout below: tids
+ * below SMC_TRACE_TID_OEN_BASE return bucket counts, with the slot in
+ * tid[7:4] and the bucket in tid[3:0]; the next SMC_TRACE_OEN_SLOTS
+ * tids return the OEN bound to a slot (SMC_TRACE_OEN_FREE when unused)
+ * and SMC_TRACE_TID_DROPPED returns the count of unbinned SMCs.
+ */
+
+/*
+ * Histogram geometry. Bucket n counts latencies of [2^n, 2^(n + 1))
+ * time-stamp ticks; the last bucket also absorbs anything slower.
+ */
+#define SMC_TRACE_OEN_SLOTS	8U
+#define SMC_TRACE_NUM_BUCKETS	16U
+
+/* Value reported for a histogram slot no OEN was bound to yet */
+#define SMC_TRACE_OEN_FREE	0xFFU
+
+/* tid space of the PMF service */
+#define SMC_TRACE_TID_OEN_BASE	(SMC_TRACE_OEN_SLOTS * SMC_TRACE_NUM_BUCKETS)
+#define SMC_TRACE_TID_DROPPED	(SMC_TRACE_TID_OEN_BASE + SMC_TRACE_OEN_SLOTS)
+#define SMC_TRACE_TOTAL_IDS	(SMC_TRACE_TID_DROPPED + 1U)
+
+#if SMC_LATENCY_TRACE
+unsigned long long pmf_smc_trace_enter(void);
+void pmf_smc_trace_exit(uint32_t smc_fid, unsigned long long entry_ts);
+#else
+static inline unsigned long long pmf_smc_trace_enter(void)
+{
+	return 0ULL;
+}
+
+static inline void pmf_smc_trace_exit(uint32_t smc_fid,
+				      unsigned long long entry_ts)
+{
+}
+#endif /* SMC_LATENCY_TRACE */
+
+#endif /* PMF_SMC_TRACE_H */
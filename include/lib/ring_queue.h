@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef RING_QUEUE_H
+#define RING_QUEUE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <platform_def.h>
+
+#include <lib/utils_def.h>
+
+/*
+ * Bounded lock-free ring queues for inter-core firmware communication.
+ *
+ * Two flavours are provided:
+ *
+ * - The single-producer/single-consumer queue uses no exclusive access
+ *   instruction. Like the normal memory bakery lock it performs the cache
+ *   maintenance needed when the two sides access the queue with mismatched
+ *   memory attributes (e.g. one core still runs with its data cache
+ *   disabled), relying only on single-copy atomicity of aligned accesses.
+ *
+ * - The multi-producer/multi-consumer queue uses exclusive load/store
+ *   sequences and therefore requires every participant to access the queue
+ *   memory as cacheable Normal memory, like the exclusive spin locks.
+ *
+ * Queue depths must be powers of two. Both flavours carry pointer-sized
+ * values and return false on full/empty rather than blocking. The backing
+ * storage is supplied by the caller at init.
+ */
+
+typedef struct spsc_queue {
+	/* Consumer index, only written by the consumer */
+	volatile uint32_t head __aligned(CACHE_WRITEBACK_GRANULE);
+	/* Producer index, only written by the producer */
+	volatile uint32_t tail __aligned(CACHE_WRITEBACK_GRANULE);
+	/* Slot array, only written by the producer */
+	volatile uintptr_t *slots __aligned(CACHE_WRITEBACK_GRANULE);
+	uint32_t depth;
+} spsc_queue_t;
+
+void spsc_queue_init(spsc_queue_t *q, uintptr_t *slots, uint32_t depth);
+bool spsc_queue_push(spsc_queue_t *q, uintptr_t val);
+bool spsc_queue_pop(spsc_queue_t *q, uintptr_t *val);
+
+/*
+ * Each cell owns a full cache line so that producers dirtying neighbouring
+ * cells never contend on the same line.
+ */
+typedef struct mpmc_cell {
+	volatile uint32_t seq;
+	volatile uintptr_t data;
+} __aligned(CACHE_WRITEBACK_GRANULE) mpmc_cell_t;
+
+typedef struct mpmc_queue {
+	/* Enqueue position, claimed with a compare-and-swap */
+	volatile uint32_t enq __aligned(CACHE_WRITEBACK_GRANULE);
+	/* Dequeue position, claimed with a compare-and-swap */
+	volatile uint32_t deq __aligned(CACHE_WRITEBACK_GRANULE);
+	mpmc_cell_t *cells __aligned(CACHE_WRITEBACK_GRANULE);
+	uint32_t depth;
+} mpmc_queue_t;
+
+void mpmc_queue_init(mpmc_queue_t *q, mpmc_cell_t *cells, uint32_t depth);
+bool mpmc_queue_push(mpmc_queue_t *q, uintptr_t val);
+bool mpmc_queue_pop(mpmc_queue_t *q, uintptr_t *val);
+
+#endif /* RING_QUEUE_H */
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef STATIC_BRANCH_H
+#define STATIC_BRANCH_H
+
+#include <lib/utils_def.h>
+
+/*
+ * Site record flags. Hand-written assembly is always assembled in A32 (or
+ * A64) state, while C sites follow the image's instruction set, so each
+ * record carries the encoding state of its site instruction.
+ */
+#define STATIC_BRANCH_SITE_T32	U(1)
+
+#ifndef __ASSEMBLER__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Boot-time patched branches for runtime-constant predicates.
+ *
+ * A static key is a boolean whose value is fixed once cold boot has
+ * completed. Conditions on the SMC dispatch and context switch hot paths
+ * test keys through static_branch_unlikely(), which compiles to a single
+ * nop (or direct branch) plus a site record in the "static_branch_sites"
+ * linker section. static_branch_apply() rewrites every recorded
+ * instruction according to the final key values, so the hot paths carry
+ * no dependent load and compare once the system is up.
+ *
+ * Keys may only be flipped with static_key_enable()/static_key_disable()
+ * before static_branch_apply() runs; the BL main functions apply the
+ * patches once, after all services have registered. The image's code
+ * must still be writable at that point: a platform that enables
+ * ENABLE_STATIC_BRANCH must keep its code mapping read-write until the
+ * patches have been applied.
+ *
+ * static_key_set() additionally re-patches the sites of a single key
+ * after static_branch_apply() has run, for predicates that are toggled
+ * from a runtime control interface. The nop and the branch are both
+ * single complete instructions, so concurrent CPUs fetch one or the
+ * other; callers using it must keep the code mapping writable for the
+ * lifetime of the image.
+ */
+struct static_key {
+	uint8_t enabled;
+};
+
+#define STATIC_KEY_INIT(_enabled)	{ .enabled = (_enabled) }
+
+static inline void static_key_enable(struct static_key *key)
+{
+	key->enabled = 1U;
+}
+
+static inline void static_key_disable(struct static_key *key)
+{
+	key->enabled = 0U;
+}
+
+#if ENABLE_STATIC_BRANCH
+/*
+ * The test compiles to a nop at the branch site and is assumed false
+ * until patched. The site address, the branch target and the key are
+ * recorded for the boot-time patching pass; the "i" constraint requires
+ * 'key' to resolve to a link-time constant address.
+ */
+static inline bool static_branch_unlikely(const struct static_key *key)
+{
+#if defined(__aarch64__)
+	__asm__ goto (
+		"1:	nop\n"
+		"	.pushsection static_branch_sites, \"a\"\n"
+		"	.align	3\n"
+		"	.quad	1b, %l[l_true], %c[k], 0\n"
+		"	.popsection\n"
+		: : [k] "i" (key) : : l_true);
+#elif defined(__thumb2__)
+	/* A 32-bit nop, so that the site can hold an encoding T4 b.w. */
+	__asm__ goto (
+		"1:	nop.w\n"
+		"	.pushsection static_branch_sites, \"a\"\n"
+		"	.align	2\n"
+		"	.word	1b, %l[l_true], %c[k], 1\n"
+		"	.popsection\n"
+		: : [k] "i" (key) : : l_true);
+#else
+	__asm__ goto (
+		"1:	nop\n"
+		"	.pushsection static_branch_sites, \"a\"\n"
+		"	.align	2\n"
+		"	.word	1b, %l[l_true], %c[k], 0\n"
+		"	.popsection\n"
+		: : [k] "i" (key) : : l_true);
+#endif
+	return false;
+l_true:
+	return true;
+}
+
+void static_branch_apply(void);
+void static_key_set(struct static_key *key, bool enable);
+#else
+static inline bool static_branch_unlikely(const struct static_key *key)
+{
+	return key->enabled != 0U;
+}
+
+static inline void static_branch_apply(void)
+{
+}
+
+static inline void static_key_set(struct static_key *key, bool enable)
+{
+	key->enabled = enable ? 1U : 0U;
+}
+#endif /* ENABLE_STATIC_BRANCH */
+
+#else /* __ASSEMBLER__ */
+
+#if ENABLE_STATIC_BRANCH
+	/*
+	 * Record a patchable branch site in hand-written assembly. The nop
+	 * is rewritten to "b \_target" by static_branch_apply() when \_key
+	 * ends up enabled. The key must be an object of type
+	 * struct static_key defined in a translation unit.
+	 */
+	.macro static_branch_site _key, _target
+6060:	nop
+	.pushsection static_branch_sites, "a"
+#if defined(__aarch64__)
+	.align	3
+	.quad	6060b, \_target, \_key, 0
+#else
+	.align	2
+	.word	6060b, \_target, \_key, 0
+#endif
+	.popsection
+	.endm
+#else
+	/* Without the patching pass the site always falls through. */
+	.macro static_branch_site _key, _target
+	.endm
+#endif /* ENABLE_STATIC_BRANCH */
+
+#endif /* __ASSEMBLER__ */
+
+#endif /* STATIC_BRANCH_H */
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef TIMER_MUX_H
+#define TIMER_MUX_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Secure timer multiplexer.
+ *
+ * The secure world owns a single banked generic timer compare, so every
+ * timed service would otherwise monopolize it. This service multiplexes
+ * the one compare over any number of software events: events are kept
+ * deadline-ordered in a min-heap (O(log n) insertion and cancellation),
+ * the hardware is always programmed with the earliest deadline, and the
+ * interrupt handler runs every event whose deadline has passed,
+ * re-arming periodic ones. The platform routes its secure physical
+ * timer interrupt to timer_mux_it_handler().
+ *
+ * Handlers run from the interrupt path with the mux unlocked, so they
+ * may start or cancel events, including their own.
+ *
+ * Each event expiry captures a PMF time-stamp under service id
+ * PMF_TIMER_MUX_SVC_ID with the event id as tid, on the CPU that took
+ * the interrupt, so expiry jitter can be audited from the normal world
+ * through the PMF SMC interface.
+ */
+
+#define PMF_TIMER_MUX_SVC_ID	8
+
+#define TIMER_MUX_MAX_EVENTS	8U
+
+struct timer_mux_event {
+	/*
+	 * Set by the caller before the first timer_mux_start(): the expiry
+	 * handler and the re-arm interval in generic timer ticks (0 for a
+	 * one-shot event).
+	 */
+	void (*handler)(struct timer_mux_event *ev);
+	uint64_t period;
+
+	/* Internal, maintained by the service */
+	uint64_t deadline;
+	unsigned int id;
+	unsigned int pos;
+	bool queued;
+};
+
+int timer_mux_start(struct timer_mux_event *ev, uint64_t delay_ticks);
+void timer_mux_cancel(struct timer_mux_event *ev);
+void timer_mux_it_handler(void);
+
+#endif /* TIMER_MUX_H */
@@ -13,6 +13,14 @@
 
 #define DFU_DESCRIPTOR_TYPE		0x21
 
+/*
+ * Max DFU packet size, advertised as wTransferSize in the DFU functional
+ * descriptor. Each DFU_DNLOAD block costs a control transfer round trip
+ * plus DFU_GETSTATUS polling on the host side, so a larger block size
+ * directly cuts the per-megabyte protocol overhead when flashing.
+ */
+#define USBD_DFU_XFER_SIZE		4096
+
 /* bmAttribute :
  * bitCanDnload = 1(bit 0)
  * bitCanUpload = 1(bit 1)
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef XLAT_DMA_H
+#define XLAT_DMA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Cache management for buffers shared with non-coherent DMA masters.
+ *
+ * Drivers hand a buffer to the device with xlat_dma_prepare() and take
+ * it back with xlat_dma_complete(), stating the transfer direction from
+ * the device's point of view. The pair issues the minimal direction
+ * aware maintenance instead of the conservative full clean+invalidate
+ * that hand-rolled call sites tend to accumulate:
+ *
+ *  - to-device: clean before the transfer, nothing after;
+ *  - from-device: invalidate before the transfer (or clean+invalidate
+ *    when the buffer does not cover whole writeback granules, so that
+ *    unrelated data sharing an edge line is not destroyed) and
+ *    invalidate again after it, against lines speculatively refilled
+ *    while the device was writing;
+ *  - bidirectional: the union of both.
+ *
+ * Buffers with a transfer lifetime beyond single operations can instead
+ * be taken out of the coherency problem entirely with
+ * xlat_dma_mark_coherent(), which remaps them non-cacheable through
+ * xlat_change_mem_attributes(). The region must obey that function's
+ * page granularity rules.
+ */
+
+/* Transfer direction, from the DMA master's point of view */
+enum xlat_dma_dir {
+	XLAT_DMA_TO_DEVICE,
+	XLAT_DMA_FROM_DEVICE,
+	XLAT_DMA_BIDIRECTIONAL,
+};
+
+/* Make a buffer safe to hand to a DMA master for a transfer */
+void xlat_dma_prepare(uintptr_t base, size_t size, enum xlat_dma_dir dir);
+
+/* Make a buffer safe to read back after the transfer completed */
+void xlat_dma_complete(uintptr_t base, size_t size, enum xlat_dma_dir dir);
+
+/*
+ * Remap a long-lived DMA buffer non-cacheable in the active translation
+ * context. Returns 0 on success or the xlat_change_mem_attributes()
+ * error code.
+ */
+int xlat_dma_mark_coherent(uintptr_t base, size_t size);
+
+#endif /* XLAT_DMA_H */
@@ -364,5 +364,18 @@ int xlat_get_mem_attributes_ctx(const xlat_ctx_t *ctx, uintptr_t base_va,
 				uint32_t *attr);
 int xlat_get_mem_attributes(uintptr_t base_va, uint32_t *attr);
 
+/*
+ * Fold last-level tables whose entries are uniform (same attributes,
+ * physically contiguous, block-aligned) into block descriptors in their
+ * parent table, reducing the number of TLB entries the address space needs.
+ *
+ * Meant to be called once, after the last mmap update and before the
+ * address space enters service. It is safe to call with the MMU enabled.
+ * Blocks never absorb pages of a dynamic region, so such regions can still
+ * be removed afterwards.
+ */
+void xlat_promote_block_mappings_ctx(xlat_ctx_t *ctx);
+void xlat_promote_block_mappings(void);
+
 #endif /*__ASSEMBLER__*/
 #endif /* XLAT_TABLES_V2_H */
@@ -63,6 +63,9 @@ struct xlat_ctx {
 	struct mmap_region *mmap;
 	int mmap_num;
 
+	/* Number of regions currently stored in the mmap array. */
+	int mmap_count;
+
 	/*
 	 * Array of finer-grain translation tables.
 	 * For example, if the initial lookup level is 1 then this array would
@@ -80,6 +83,14 @@ struct xlat_ctx {
 
 	int next_table;
 
+#if XLAT_TABLES_POOL
+	/*
+	 * Number of shared pool pages currently held by this context.
+	 * `tables_num` acts as the per-context allocation quota.
+	 */
+	int tables_used;
+#endif
+
 	/*
 	 * Base translation table. It doesn't need to have the same amount of
 	 * entries as the ones used for other levels.
@@ -108,7 +119,7 @@ struct xlat_ctx {
 	int xlat_regime;
 };
 
-#if PLAT_XLAT_TABLES_DYNAMIC
+#if PLAT_XLAT_TABLES_DYNAMIC && !XLAT_TABLES_POOL
 #define XLAT_ALLOC_DYNMAP_STRUCT(_ctx_name, _xlat_tables_count)		\
 	static int _ctx_name##_mapped_regions[_xlat_tables_count];
 
@@ -122,7 +133,13 @@ struct xlat_ctx {
 	/* do nothing */
 #endif /* PLAT_XLAT_TABLES_DYNAMIC */
 
-#ifdef PLAT_XLAT_BASE
+#if XLAT_TABLES_POOL
+/* Table pages are claimed from the shared pool in xlat_tables_pool.c. */
+#define XLAT_TABLES(_ctx_name, _xlat_tables_count, _section_name)
+
+#define XLAT_CTX_TABLES(_ctx_name)	NULL
+
+#elif defined(PLAT_XLAT_BASE)
 #define tf_xlat_tables		(void *)PLAT_XLAT_BASE
 
 #define XLAT_TABLES(_ctx_name, _xlat_tables_count, _section_name)		\
@@ -132,10 +149,14 @@ struct xlat_ctx {
 			XLAT_TABLE_ENTRIES * _xlat_tables_count),		\
 			invalid_plat_xlat_size);
 
+#define XLAT_CTX_TABLES(_ctx_name)	_ctx_name##_xlat_tables
+
 #else
 #define XLAT_TABLES(_ctx_name, _xlat_tables_count, _section_name)			\
 	static uint64_t _ctx_name##_xlat_tables[_xlat_tables_count][XLAT_TABLE_ENTRIES]	\
 		__aligned(XLAT_TABLE_SIZE) __section(_section_name);
+
+#define XLAT_CTX_TABLES(_ctx_name)	_ctx_name##_xlat_tables
 #endif
 
 #ifdef PLAT_BASE_XLAT_BASE
@@ -171,11 +192,12 @@ struct xlat_ctx {
 		.pa_max_address = (_phy_addr_space_size) - 1ULL,	\
 		.mmap = _ctx_name##_mmap,				\
 		.mmap_num = (_mmap_count),				\
+		.mmap_count = 0,					\
 		.base_level = GET_XLAT_TABLE_LEVEL_BASE(_virt_addr_space_size),\
 		.base_table = _ctx_name##_base_xlat_table,		\
 		.base_table_entries =					\
 			GET_NUM_BASE_LEVEL_ENTRIES(_virt_addr_space_size),\
-		.tables = _ctx_name##_xlat_tables,			\
+		.tables = XLAT_CTX_TABLES(_ctx_name),			\
 		.tables_num = _xlat_tables_count,			\
 		 XLAT_REGISTER_DYNMAP_STRUCT(_ctx_name)			\
 		.xlat_regime = (_xlat_regime),				\
@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef BENCH_SVC_H
+#define BENCH_SVC_H
+
+#include <stdint.h>
+
+#include <lib/utils_def.h>
+
+/*
+ * SMC benchmark service, built with BENCH_SVC=1. It occupies function IDs
+ * 0x40-0x5F of the Standard Service SMC32 fast call range, after the
+ * window reserved for SDEI.
+ */
+#define BENCH_SVC_VERSION		U(0x84000040)
+#define BENCH_SVC_ECHO			U(0x84000041)
+#define BENCH_SVC_ECHO_TS		U(0x84000042)
+/* Hold EL3 for x1 generic timer ticks before returning */
+#define BENCH_SVC_SPIN			U(0x84000043)
+
+#define BENCH_SVC_VERSION_MAJOR		U(0x0)
+#define BENCH_SVC_VERSION_MINOR		U(0x2)
+
+#define BENCH_SVC_FID_MASK		U(0xffe0)
+#define BENCH_SVC_FID_VALUE		U(0x40)
+#define is_bench_svc_fid(_fid) \
+	(((_fid) & BENCH_SVC_FID_MASK) == BENCH_SVC_FID_VALUE)
+
+/*
+ * PMF service exposing the EL3 entry and exit time-stamps of the last
+ * BENCH_SVC_ECHO_TS call on each CPU, retrieved with
+ * PMF_SMC_GET_TIMESTAMP.
+ */
+#define PMF_BENCH_SVC_ID		5
+#define BENCH_TS_ENTER			U(0)
+#define BENCH_TS_EXIT			U(1)
+#define BENCH_TS_TOTAL_IDS		U(2)
+
+uintptr_t bench_svc_smc_handler(uint32_t smc_fid,
+				u_register_t x1,
+				u_register_t x2,
+				u_register_t x3,
+				u_register_t x4,
+				void *cookie,
+				void *handle,
+				u_register_t flags);
+
+#endif /* BENCH_SVC_H */
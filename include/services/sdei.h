@@ -33,6 +33,13 @@
 #define SDEI_PRIVATE_RESET			0xC4000031U
 #define SDEI_SHARED_RESET			0xC4000032U
 
+/*
+ * Implementation-specific: validate a shared event registration snapshot
+ * on resume from suspend, so the client can skip replaying its
+ * register/enable/bind sequence when firmware state survived.
+ */
+#define SDEI_EVENT_RESUME_VALIDATE		0xC4000033U
+
 /* SDEI_EVENT_REGISTER flags */
 #define SDEI_REGF_RM_ANY	0ULL
 #define SDEI_REGF_RM_PE		1ULL
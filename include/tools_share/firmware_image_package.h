@@ -14,6 +14,16 @@
 /* This is used as a signature to validate the blob header */
 #define TOC_HEADER_NAME	0xAA640001
 
+/*
+ * ToC Entry flags, bits [3:0]: compression format of the payload, as
+ * recorded by fiptool --comp. Purely informational for the loader, which
+ * recognizes the format from the payload's own magic bytes.
+ */
+#define FIP_TOC_ENTRY_COMP_MASK		UINT64_C(0xF)
+#define FIP_TOC_ENTRY_COMP_NONE		UINT64_C(0x0)
+#define FIP_TOC_ENTRY_COMP_ZLIB		UINT64_C(0x1)
+#define FIP_TOC_ENTRY_COMP_LZ4		UINT64_C(0x2)
+
 
 /* ToC Entry UUIDs */
 #define UUID_TRUSTED_UPDATE_FIRMWARE_SCP_BL2U \
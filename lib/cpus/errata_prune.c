@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Boot-time pruning of CPU erratum workarounds.
+ *
+ * The reset functions in lib/cpus apply every workaround that is
+ * compiled in and rely on a revision check inside each workaround to
+ * skip silicon that is not affected. The check still costs a call, a
+ * revision compare and a return on every core power cycle. Workaround
+ * call sites on the reset path are therefore recorded with a static
+ * branch skip key: once the boot CPU has read the exact MIDR,
+ * errata_prune() enables the key of every workaround that cannot apply
+ * to this revision, and the patching pass replaces those calls with a
+ * branch around them.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <arch_helpers.h>
+#include <common/debug.h>
+#include <cortex_a53.h>
+#include <lib/cpus/errata_prune.h>
+#include <lib/pmf/pmf.h>
+#include <lib/static_branch.h>
+#include <lib/utils_def.h>
+
+#if defined(__aarch64__) && ENABLE_PMF
+PMF_REGISTER_SERVICE_SMC(errata_rst_svc, PMF_ERRATA_RST_SVC_ID,
+			 ERRATA_TS_TOTAL_IDS, PMF_STORE_ENABLE)
+#endif
+
+/* Skip keys referenced by the branch sites in the CPU reset functions. */
+struct static_key errata_a53_826319_skip = STATIC_KEY_INIT(0);
+struct static_key errata_a53_836870_skip = STATIC_KEY_INIT(0);
+struct static_key errata_a53_855873_skip = STATIC_KEY_INIT(0);
+
+/* Affected revision range checks, mirroring cpu_rev_var_ls/_hs */
+#define ERRATA_REV_LS		U(0)
+#define ERRATA_REV_HS		U(1)
+
+/* Compare MIDR values on implementer and part number only */
+#define ERRATA_PRUNE_MIDR_MASK	((MIDR_IMPL_MASK << MIDR_IMPL_SHIFT) | \
+				 (MIDR_PN_MASK << MIDR_PN_SHIFT))
+
+struct errata_prune_entry {
+	uint32_t midr;		/* MIDR of the CPU the erratum applies to */
+	uint8_t chk;		/* Affected revision range check */
+	uint8_t rev_var;	/* Range bound, variant and revision packed */
+	struct static_key *skip;
+};
+
+/*
+ * An entry whose workaround is not compiled in is harmless: no branch
+ * site references its key, so enabling it patches nothing.
+ */
+static const struct errata_prune_entry errata_prune_list[] = {
+	{ CORTEX_A53_MIDR, ERRATA_REV_LS, 0x02U, &errata_a53_826319_skip },
+	{ CORTEX_A53_MIDR, ERRATA_REV_LS, 0x03U, &errata_a53_836870_skip },
+	{ CORTEX_A53_MIDR, ERRATA_REV_HS, 0x03U, &errata_a53_855873_skip },
+};
+
+/*******************************************************************************
+ * Enable the skip key of every recorded workaround that cannot apply to
+ * the MIDR revision of this silicon. Must run on the primary CPU before
+ * static_branch_apply(); all cores are assumed to be the same revision.
+ ******************************************************************************/
+void errata_prune(void)
+{
+	uint32_t midr = (uint32_t)read_midr();
+	uint32_t rev_var = (((midr >> MIDR_VAR_SHIFT) & 0xfU) << 4) |
+			   (midr & 0xfU);
+	unsigned int pruned = 0U;
+	size_t i;
+
+	for (i = 0U; i < ARRAY_SIZE(errata_prune_list); i++) {
+		const struct errata_prune_entry *e = &errata_prune_list[i];
+		bool applies;
+
+		if ((midr & ERRATA_PRUNE_MIDR_MASK) !=
+		    (e->midr & ERRATA_PRUNE_MIDR_MASK)) {
+			continue;
+		}
+
+		if (e->chk == ERRATA_REV_LS) {
+			applies = rev_var <= e->rev_var;
+		} else {
+			applies = rev_var >= e->rev_var;
+		}
+
+		if (!applies) {
+			static_key_enable(e->skip);
+			pruned++;
+		}
+	}
+
+	if (pruned != 0U) {
+		INFO("Pruned %u erratum workaround call(s), midr = 0x%x\n",
+		     pruned, midr);
+	}
+}
@@ -38,6 +38,17 @@ void cm_init(void)
 	 */
 }
 
+/*
+ * Note on TLB and instruction cache maintenance: world switches do not
+ * require any. Monitor mode translations are tagged separately from the
+ * lower exception levels and non-secure entries are tagged by ASID, so
+ * re-entering either world with an unchanged context hits valid entries.
+ * Do not add broadcast TLBIALLIS/ICIALLUIS here to paper over a
+ * translation issue: it invalidates the non-secure world's cached
+ * translations on every SMC and the page table re-walks show up as a
+ * non-secure performance regression.
+ */
+
 /*******************************************************************************
  * The following function initializes the cpu_context 'ctx' for
  * first use, and sets the initial entrypoint state as specified by the
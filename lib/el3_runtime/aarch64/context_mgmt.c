@@ -48,6 +48,16 @@ void __init cm_init(void)
 	 */
 }
 
+/*
+ * Note that world switches need no TLB or instruction cache maintenance:
+ * EL3 translations are tagged separately from the lower ELs, and
+ * non-secure entries are tagged by ASID/VMID, so re-entering a world
+ * with an unchanged context hits valid TLB entries. Adding broadcast
+ * TLBI ALLE1IS/IC IALLUIS on the SMC path would throw away the
+ * non-secure world's cached translations on every call and surface as
+ * page table walk overhead in SMC-heavy workloads.
+ */
+
 /*******************************************************************************
  * The following function initializes the cpu_context 'ctx' for
  * first use, and sets the initial entrypoint state as specified by the
@@ -561,6 +571,33 @@ void cm_el1_sysregs_context_restore(uint32_t security_state)
 #endif
 }
 
+/*******************************************************************************
+ * Combination of cm_el1_sysregs_context_restore() and
+ * cm_set_next_eret_context() with a single context lookup. This is the
+ * steady-state world switch sequence of a secure payload dispatcher: the
+ * rest of the exit state (SCR_EL3, SPSR_EL3, ELR_EL3) is restored from the
+ * context by el3_exit without recomputation, so pairing the two calls here
+ * leaves no duplicated work on the yield path.
+ ******************************************************************************/
+void cm_el1_sysregs_context_restore_and_set_next(uint32_t security_state)
+{
+	cpu_context_t *ctx;
+
+	ctx = cm_get_context(security_state);
+	assert(ctx != NULL);
+
+	el1_sysregs_context_restore(get_sysregs_ctx(ctx));
+
+#if IMAGE_BL31
+	if (security_state == SECURE)
+		PUBLISH_EVENT(cm_entering_secure_world);
+	else
+		PUBLISH_EVENT(cm_entering_normal_world);
+#endif
+
+	cm_set_next_context(ctx);
+}
+
 /*******************************************************************************
  * This function populates ELR_EL3 member of 'cpu_context' pertaining to the
  * given security state with the given entrypoint
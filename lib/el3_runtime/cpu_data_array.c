@@ -9,5 +9,72 @@
 #include <lib/cassert.h>
 #include <lib/el3_runtime/cpu_data.h>
 
+#if CPU_DATA_CACHELINE_AUDIT
+#include <assert.h>
+
+#include <arch_helpers.h>
+#include <common/debug.h>
+#include <plat/common/platform.h>
+#endif
+
 /* The per_cpu_ptr_cache_t space allocation */
 cpu_data_t percpu_data[PLATFORM_CORE_COUNT];
+
+#if CPU_DATA_CACHELINE_AUDIT
+/*
+ * One counter per CPU, each on its own cache line so that the audit
+ * instrumentation does not introduce the sharing it is meant to expose.
+ * The increments are deliberately not atomic: concurrent remote accesses
+ * may drop counts, which is acceptable for a diagnostic.
+ */
+static struct cpu_data_audit {
+	uint64_t remote_accesses;
+} __aligned(CACHE_WRITEBACK_GRANULE) cpu_data_audit[PLATFORM_CORE_COUNT];
+
+/*
+ * Audited variant of the accessor normally provided in assembly. Every
+ * access to another CPU's block can bounce a cache line its owner keeps
+ * hot, so tally it against the block being touched. Unlike the assembly
+ * version, this requires a valid stack.
+ */
+cpu_data_t *_cpu_data_by_index(uint32_t cpu_index)
+{
+	if (cpu_index != plat_my_core_pos()) {
+		cpu_data_audit[cpu_index].remote_accesses++;
+	}
+
+	return &percpu_data[cpu_index];
+}
+
+/* Number of times other CPUs have touched this CPU's cpu_data block. */
+uint64_t cpu_data_audit_get_remote_count(uint32_t cpu_index)
+{
+	assert(cpu_index < PLATFORM_CORE_COUNT);
+
+	return cpu_data_audit[cpu_index].remote_accesses;
+}
+
+/*
+ * The build-time asserts in cpu_data.h guarantee cache line exclusivity
+ * of the per-CPU blocks only if CACHE_WRITEBACK_GRANULE covers the cache
+ * writeback granule of the hardware this image actually runs on. Check
+ * it against CTR on the running core.
+ */
+void cpu_data_audit_check_granule(void)
+{
+	u_register_t cwg = (read_ctr_el0() >> CTR_CWG_SHIFT) & CTR_CWG_MASK;
+	size_t granule;
+
+	/* A zero CWG field means the granule is not reported. */
+	if (cwg == 0U) {
+		return;
+	}
+
+	granule = (size_t)4U << cwg;
+	if (granule > CACHE_WRITEBACK_GRANULE) {
+		ERROR("cpu_data: CACHE_WRITEBACK_GRANULE %u below hardware granule %zu\n",
+		      CACHE_WRITEBACK_GRANULE, granule);
+		panic();
+	}
+}
+#endif /* CPU_DATA_CACHELINE_AUDIT */
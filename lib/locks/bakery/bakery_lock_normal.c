@@ -56,6 +56,19 @@ IMPORT_SYM(uintptr_t, __PERCPU_BAKERY_LOCK_END__, BAKERY_LOCK_END);
 #define PERCPU_BAKERY_LOCK_SIZE (BAKERY_LOCK_END - BAKERY_LOCK_START)
 #endif
 
+/*
+ * While only one CPU has ever been powered on, locks cannot be contended and
+ * the ticket allocation walk over every CPU slot is pure overhead. Keep a
+ * one-way "contended" flag, set by the CPU_ON path before the first secondary
+ * is released, and take a short cut until then. BAKERY_LOCK_SINGLE_CPU forces
+ * the short cut at build time for platforms that never start a secondary.
+ */
+#if BAKERY_LOCK_SINGLE_CPU
+#define bakery_lock_is_contended(is_cached)	false
+#else
+static bool bakery_lock_contended;
+#endif
+
 static inline bakery_lock_t *get_bakery_info(unsigned int cpu_ix,
 					     bakery_lock_t *lock)
 {
@@ -79,6 +92,31 @@ static inline void read_cache_op(uintptr_t addr, bool cached)
 		dccivac(addr);
 }
 
+#if !BAKERY_LOCK_SINGLE_CPU
+void bakery_lock_set_contended(void)
+{
+#ifdef __aarch64__
+	unsigned int is_cached = read_sctlr_el3() & SCTLR_C_BIT;
+#else
+	unsigned int is_cached = read_sctlr() & SCTLR_C_BIT;
+#endif
+
+	bakery_lock_contended = true;
+
+	/*
+	 * Make the update visible to CPUs that read the flag with their data
+	 * cache disabled, i.e. a secondary in its early warm boot.
+	 */
+	write_cache_op((uintptr_t)&bakery_lock_contended, is_cached);
+}
+
+static inline bool bakery_lock_is_contended(unsigned int is_cached)
+{
+	read_cache_op((uintptr_t)&bakery_lock_contended, is_cached);
+	return bakery_lock_contended;
+}
+#endif
+
 /* Helper function to check if the lock is acquired */
 static inline bool is_lock_acquired(const bakery_info_t *my_bakery_info,
 							int is_cached)
@@ -173,6 +211,23 @@ void bakery_lock_get(bakery_lock_t *lock)
 	is_cached = read_sctlr() & SCTLR_C_BIT;
 #endif
 
+	if (!bakery_lock_is_contended(is_cached)) {
+		/*
+		 * No other CPU can compete for the lock: record the
+		 * acquisition with a valid ticket so that release and the
+		 * recursion assert behave as usual, and so that a secondary
+		 * powered on while we hold the lock waits for us correctly.
+		 */
+		bakery_info_t *my_bakery_info = get_bakery_info(me, lock);
+
+		assert(!is_lock_acquired(my_bakery_info, is_cached));
+
+		my_bakery_info->lock_data = make_bakery_data(CHOSEN_TICKET, 1U);
+		write_cache_op((uintptr_t)my_bakery_info, is_cached);
+		dmbld();
+		return;
+	}
+
 	/* Get a ticket */
 	my_ticket = bakery_get_ticket(lock, me, is_cached);
 
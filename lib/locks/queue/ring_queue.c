@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <assert.h>
+
+#include <arch_helpers.h>
+#include <lib/ring_queue.h>
+
+/*
+ * Compare-and-swap helper implemented with exclusive accesses, see
+ * ring_queue_cas.S. Atomically stores new_val to *addr if the current value
+ * equals old_val, and returns the value observed at *addr: the exchange
+ * succeeded when it equals old_val.
+ */
+uint32_t ring_queue_cas(volatile uint32_t *addr, uint32_t old_val,
+			uint32_t new_val);
+
+/*
+ * The single-producer/single-consumer queue mirrors the cache maintenance
+ * model of bakery_lock_normal.c: each side cleans what it wrote and
+ * cleans/invalidates before reading what the peer wrote, so that the queue
+ * keeps working when one participant accesses memory non-cacheable.
+ */
+static inline bool dcache_enabled(void)
+{
+#ifdef __aarch64__
+	return (read_sctlr_el3() & SCTLR_C_BIT) != 0U;
+#else
+	return (read_sctlr() & SCTLR_C_BIT) != 0U;
+#endif
+}
+
+static inline void write_cache_op(uintptr_t addr, bool cached)
+{
+	if (cached) {
+		dccvac(addr);
+	} else {
+		dcivac(addr);
+	}
+
+	dsbish();
+}
+
+static inline void read_cache_op(uintptr_t addr, bool cached)
+{
+	if (cached) {
+		dccivac(addr);
+	}
+}
+
+void spsc_queue_init(spsc_queue_t *q, uintptr_t *slots, uint32_t depth)
+{
+	bool cached = dcache_enabled();
+
+	assert((depth != 0U) && ((depth & (depth - 1U)) == 0U));
+
+	q->head = 0U;
+	q->tail = 0U;
+	q->slots = slots;
+	q->depth = depth;
+
+	write_cache_op((uintptr_t)&q->head, cached);
+	write_cache_op((uintptr_t)&q->tail, cached);
+	write_cache_op((uintptr_t)&q->slots, cached);
+}
+
+bool spsc_queue_push(spsc_queue_t *q, uintptr_t val)
+{
+	bool cached = dcache_enabled();
+	uint32_t tail = q->tail;
+	uint32_t slot = tail & (q->depth - 1U);
+
+	read_cache_op((uintptr_t)&q->head, cached);
+	if ((tail - q->head) == q->depth) {
+		return false;
+	}
+
+	q->slots[slot] = val;
+	write_cache_op((uintptr_t)&q->slots[slot], cached);
+
+	/* Order the slot update before the index publication */
+	dmbish();
+
+	q->tail = tail + 1U;
+	write_cache_op((uintptr_t)&q->tail, cached);
+
+	return true;
+}
+
+bool spsc_queue_pop(spsc_queue_t *q, uintptr_t *val)
+{
+	bool cached = dcache_enabled();
+	uint32_t head = q->head;
+	uint32_t slot = head & (q->depth - 1U);
+
+	read_cache_op((uintptr_t)&q->tail, cached);
+	if (q->tail == head) {
+		return false;
+	}
+
+	/* Order the index read before the slot read */
+	dmbish();
+
+	read_cache_op((uintptr_t)&q->slots[slot], cached);
+	*val = q->slots[slot];
+
+	/* Order the slot read before the slot release */
+	dmbish();
+
+	q->head = head + 1U;
+	write_cache_op((uintptr_t)&q->head, cached);
+
+	return true;
+}
+
+/*
+ * Bounded multi-producer/multi-consumer queue. Every cell carries a
+ * sequence number encoding its state: producers wait for seq == pos and
+ * claim a cell by moving the enqueue position with a compare-and-swap,
+ * consumers wait for seq == pos + 1 and recycle the cell with
+ * seq = pos + depth. Winning the position race gives exclusive ownership
+ * of the cell, so the data field itself needs no atomics.
+ */
+void mpmc_queue_init(mpmc_queue_t *q, mpmc_cell_t *cells, uint32_t depth)
+{
+	uint32_t i;
+
+	assert((depth != 0U) && ((depth & (depth - 1U)) == 0U));
+
+	for (i = 0U; i < depth; i++) {
+		cells[i].seq = i;
+	}
+
+	q->enq = 0U;
+	q->deq = 0U;
+	q->cells = cells;
+	q->depth = depth;
+
+	dsbish();
+}
+
+bool mpmc_queue_push(mpmc_queue_t *q, uintptr_t val)
+{
+	mpmc_cell_t *cell;
+	uint32_t pos = q->enq;
+
+	for (;;) {
+		int32_t diff;
+
+		cell = &q->cells[pos & (q->depth - 1U)];
+		diff = (int32_t)(cell->seq - pos);
+
+		if (diff == 0) {
+			uint32_t seen = ring_queue_cas(&q->enq, pos, pos + 1U);
+
+			if (seen == pos) {
+				break;
+			}
+
+			pos = seen;
+		} else if (diff < 0) {
+			/* The cell was not recycled yet: queue is full */
+			return false;
+		} else {
+			/* Another producer claimed this cell, move on */
+			pos = q->enq;
+		}
+	}
+
+	cell->data = val;
+
+	/* Publish the data before the sequence number hands the cell over */
+	dmbst();
+
+	cell->seq = pos + 1U;
+
+	return true;
+}
+
+bool mpmc_queue_pop(mpmc_queue_t *q, uintptr_t *val)
+{
+	mpmc_cell_t *cell;
+	uint32_t pos = q->deq;
+
+	for (;;) {
+		int32_t diff;
+
+		cell = &q->cells[pos & (q->depth - 1U)];
+		diff = (int32_t)(cell->seq - (pos + 1U));
+
+		if (diff == 0) {
+			uint32_t seen = ring_queue_cas(&q->deq, pos, pos + 1U);
+
+			if (seen == pos) {
+				break;
+			}
+
+			pos = seen;
+		} else if (diff < 0) {
+			/* No producer handed this cell over: queue is empty */
+			return false;
+		} else {
+			/* Another consumer claimed this cell, move on */
+			pos = q->deq;
+		}
+	}
+
+	/* Order the sequence observation before the data read */
+	dmbld();
+
+	*val = cell->data;
+
+	/* Order the data read before the cell recycle */
+	dmbish();
+
+	cell->seq = pos + q->depth;
+
+	return true;
+}
@@ -0,0 +1,9 @@
+#
+# Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+RING_QUEUE_SOURCES	:=	$(addprefix lib/locks/queue/,	\
+				${ARCH}/ring_queue_cas.S	\
+				ring_queue.c)
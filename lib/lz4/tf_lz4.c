@@ -0,0 +1,268 @@
+/*
+ * Copyright (c) 2026, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include <common/debug.h>
+#include <tf_lz4.h>
+
+/*
+ * Decoder for the LZ4 frame format, as produced by the lz4(1) command.
+ * LZ4 trades some compression ratio against a plain byte-copy decode
+ * loop, which makes it the better choice when storage reads are fast
+ * and CPU decode time dominates the load of a compressed image.
+ *
+ * Checksums carried by the frame (xxHash32 of the header, blocks and
+ * content) are skipped, not verified: images that need integrity
+ * protection are covered by Trusted Board Boot authentication of the
+ * compressed payload.
+ */
+
+/* Magic = 0x184D2204, stored little-endian */
+const uint8_t lz4f_magic[4] = { 0x04, 0x22, 0x4D, 0x18 };
+
+/* Frame descriptor FLG byte */
+#define LZ4F_FLG_VERSION_MASK	0xC0U
+#define LZ4F_FLG_VERSION_1	0x40U
+#define LZ4F_FLG_B_CHECKSUM	0x10U
+#define LZ4F_FLG_C_SIZE		0x08U
+#define LZ4F_FLG_C_CHECKSUM	0x04U
+#define LZ4F_FLG_DICT_ID	0x01U
+
+/* Block size word: high bit set means the block is stored uncompressed */
+#define LZ4F_BLOCK_UNCOMPRESSED	0x80000000U
+#define LZ4F_BLOCK_SIZE_MASK	0x7FFFFFFFU
+
+/* Sequence token nibbles of 15 continue in extension bytes */
+#define LZ4_TOKEN_NIBBLE_MAX	15U
+#define LZ4_MATCH_LEN_BASE	4U
+
+static uint32_t lz4_read_le32(const uint8_t *p)
+{
+	return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+	       ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/*
+ * Read a sequence length continued in extension bytes: each 255 byte adds
+ * 255 and the first byte below 255 ends the length.
+ */
+static int lz4_read_length(const uint8_t **ip_ptr, const uint8_t *in_end,
+			   size_t *len)
+{
+	const uint8_t *ip = *ip_ptr;
+	uint8_t byte;
+
+	do {
+		if (ip == in_end) {
+			return -EIO;
+		}
+		byte = *ip;
+		ip++;
+		*len += byte;
+	} while (byte == 0xFFU);
+
+	*ip_ptr = ip;
+
+	return 0;
+}
+
+/*
+ * Decompress one LZ4 block. Matches may reference data decoded by earlier
+ * blocks of the frame, so bounds run from @out_start (start of the frame
+ * output) to @out_limit while @op_ptr tracks the write position.
+ */
+static int lz4_decompress_block(const uint8_t *ip, const uint8_t *in_end,
+				const uint8_t *out_start, uint8_t **op_ptr,
+				const uint8_t *out_limit)
+{
+	uint8_t *op = *op_ptr;
+
+	while (ip < in_end) {
+		size_t lit_len, match_len, offset;
+		const uint8_t *match;
+		uint8_t token;
+
+		token = *ip;
+		ip++;
+
+		/* Literals run */
+		lit_len = (size_t)(token >> 4);
+		if (lit_len == LZ4_TOKEN_NIBBLE_MAX) {
+			if (lz4_read_length(&ip, in_end, &lit_len) != 0) {
+				return -EIO;
+			}
+		}
+
+		if (((size_t)(in_end - ip) < lit_len) ||
+		    ((size_t)(out_limit - op) < lit_len)) {
+			return -EIO;
+		}
+		memcpy(op, ip, lit_len);
+		ip += lit_len;
+		op += lit_len;
+
+		/* The last sequence of a block ends after its literals */
+		if (ip == in_end) {
+			break;
+		}
+
+		/* Match copy */
+		if ((size_t)(in_end - ip) < 2U) {
+			return -EIO;
+		}
+		offset = (size_t)ip[0] | ((size_t)ip[1] << 8);
+		ip += 2;
+		if ((offset == 0U) || (offset > (size_t)(op - out_start))) {
+			return -EIO;
+		}
+
+		match_len = (size_t)(token & 0xFU);
+		if (match_len == LZ4_TOKEN_NIBBLE_MAX) {
+			if (lz4_read_length(&ip, in_end, &match_len) != 0) {
+				return -EIO;
+			}
+		}
+		match_len += LZ4_MATCH_LEN_BASE;
+
+		if ((size_t)(out_limit - op) < match_len) {
+			return -EIO;
+		}
+
+		/*
+		 * Overlapping copies (offset < match_len) replicate the
+		 * last @offset bytes, so copy one byte at a time.
+		 */
+		match = op - offset;
+		while (match_len > 0U) {
+			*op = *match;
+			op++;
+			match++;
+			match_len--;
+		}
+	}
+
+	*op_ptr = op;
+
+	return 0;
+}
+
+/*
+ * lz4_decompress - decompress an LZ4 frame
+ * @in_buf: source of compressed input. Upon exit, the end of input.
+ * @in_len: length of in_buf
+ * @out_buf: destination of decompressed output. Upon exit, the end of output.
+ * @out_len: length of out_buf
+ * @work_buf: workspace (unused, LZ4 decodes without one)
+ * @work_len: length of workspace
+ */
+int lz4_decompress(uintptr_t *in_buf, size_t in_len, uintptr_t *out_buf,
+		   size_t out_len, uintptr_t work_buf, size_t work_len)
+{
+	const uint8_t *ip = (const uint8_t *)*in_buf;
+	const uint8_t *in_end = ip + in_len;
+	uint8_t *out_start = (uint8_t *)*out_buf;
+	const uint8_t *out_limit = out_start + out_len;
+	uint8_t *op = out_start;
+	size_t desc_len;
+	uint8_t flg;
+	int ret;
+
+	(void)work_buf;
+	(void)work_len;
+
+	/* Magic plus the two mandatory descriptor bytes and its checksum */
+	if ((in_len < (sizeof(lz4f_magic) + 3U)) ||
+	    (memcmp(ip, lz4f_magic, sizeof(lz4f_magic)) != 0)) {
+		ERROR("lz4: not an LZ4 frame\n");
+		return -EIO;
+	}
+	ip += sizeof(lz4f_magic);
+
+	flg = ip[0];
+	if ((flg & LZ4F_FLG_VERSION_MASK) != LZ4F_FLG_VERSION_1) {
+		ERROR("lz4: unsupported frame version\n");
+		return -EIO;
+	}
+
+	/* FLG, BD, optional content size and dictionary ID, header checksum */
+	desc_len = 3U;
+	if ((flg & LZ4F_FLG_C_SIZE) != 0U) {
+		desc_len += 8U;
+	}
+	if ((flg & LZ4F_FLG_DICT_ID) != 0U) {
+		desc_len += 4U;
+	}
+	if ((size_t)(in_end - ip) < desc_len) {
+		ERROR("lz4: truncated frame header\n");
+		return -EIO;
+	}
+	ip += desc_len;
+
+	for (;;) {
+		uint32_t block_word, block_len;
+
+		if ((size_t)(in_end - ip) < 4U) {
+			ERROR("lz4: premature end of input\n");
+			return -EIO;
+		}
+		block_word = lz4_read_le32(ip);
+		ip += 4;
+
+		/* EndMark */
+		if (block_word == 0U) {
+			break;
+		}
+
+		block_len = block_word & LZ4F_BLOCK_SIZE_MASK;
+		if ((size_t)(in_end - ip) < (size_t)block_len) {
+			ERROR("lz4: premature end of input\n");
+			return -EIO;
+		}
+
+		if ((block_word & LZ4F_BLOCK_UNCOMPRESSED) != 0U) {
+			if ((size_t)(out_limit - op) < (size_t)block_len) {
+				ERROR("lz4: output buffer too small\n");
+				return -EIO;
+			}
+			memcpy(op, ip, block_len);
+			op += block_len;
+		} else {
+			ret = lz4_decompress_block(ip, ip + block_len,
+						   out_start, &op, out_limit);
+			if (ret != 0) {
+				ERROR("lz4: corrupt block\n");
+				return ret;
+			}
+		}
+		ip += block_len;
+
+		if ((flg & LZ4F_FLG_B_CHECKSUM) != 0U) {
+			if ((size_t)(in_end - ip) < 4U) {
+				ERROR("lz4: premature end of input\n");
+				return -EIO;
+			}
+			ip += 4;
+		}
+	}
+
+	if ((flg & LZ4F_FLG_C_CHECKSUM) != 0U) {
+		if ((size_t)(in_end - ip) < 4U) {
+			ERROR("lz4: premature end of input\n");
+			return -EIO;
+		}
+		ip += 4;
+	}
+
+	VERBOSE("lz4: %zu byte input\n", (size_t)((uintptr_t)ip - *in_buf));
+	VERBOSE("lz4: %zu byte output\n", (size_t)(op - out_start));
+
+	*in_buf = (uintptr_t)ip;
+	*out_buf = (uintptr_t)op;
+
+	return 0;
+}
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <assert.h>
+#include <stdint.h>
+
+#include <common/debug.h>
+#include <lib/mem_guard.h>
+#include <lib/spinlock.h>
+
+#define MEM_GUARD_MAX_REGIONS	8U
+
+struct mem_guard_region {
+	const char *name;
+	const uint8_t *base;
+	size_t size;
+	uint32_t seal;
+	unsigned int updaters;
+};
+
+static struct mem_guard_region regions[MEM_GUARD_MAX_REGIONS];
+static unsigned int num_regions;
+static spinlock_t mem_guard_lock;
+
+/*
+ * Byte-wise rotate-and-xor digest: no alignment requirement on the
+ * region, and position dependent so swapped bytes do not cancel out.
+ */
+static uint32_t mem_guard_digest(const uint8_t *base, size_t size)
+{
+	uint32_t digest = 0U;
+	size_t i;
+
+	for (i = 0U; i < size; i++) {
+		digest = (digest << 7) | (digest >> 25);
+		digest ^= base[i];
+	}
+
+	return digest;
+}
+
+static struct mem_guard_region *mem_guard_find(const void *base)
+{
+	unsigned int i;
+
+	for (i = 0U; i < num_regions; i++) {
+		if (regions[i].base == base) {
+			return &regions[i];
+		}
+	}
+
+	return NULL;
+}
+
+void mem_guard_register(const char *name, const void *base, size_t size)
+{
+	struct mem_guard_region *region;
+
+	assert(size != 0U);
+
+	spin_lock(&mem_guard_lock);
+
+	assert(mem_guard_find(base) == NULL);
+	if (num_regions == MEM_GUARD_MAX_REGIONS) {
+		spin_unlock(&mem_guard_lock);
+		ERROR("Too many guarded regions, raise MEM_GUARD_MAX_REGIONS\n");
+		panic();
+	}
+
+	region = &regions[num_regions];
+	num_regions++;
+
+	region->name = name;
+	region->base = base;
+	region->size = size;
+	region->updaters = 0U;
+	region->seal = mem_guard_digest(base, size);
+
+	spin_unlock(&mem_guard_lock);
+}
+
+void mem_guard_begin_update(const void *base)
+{
+	struct mem_guard_region *region;
+
+	spin_lock(&mem_guard_lock);
+
+	region = mem_guard_find(base);
+	assert(region != NULL);
+	region->updaters++;
+
+	spin_unlock(&mem_guard_lock);
+}
+
+void mem_guard_end_update(const void *base)
+{
+	struct mem_guard_region *region;
+
+	spin_lock(&mem_guard_lock);
+
+	region = mem_guard_find(base);
+	assert(region != NULL);
+	assert(region->updaters != 0U);
+	region->updaters--;
+	if (region->updaters == 0U) {
+		region->seal = mem_guard_digest(region->base, region->size);
+	}
+
+	spin_unlock(&mem_guard_lock);
+}
+
+void mem_guard_check(const char *where)
+{
+	unsigned int i;
+
+	spin_lock(&mem_guard_lock);
+
+	for (i = 0U; i < num_regions; i++) {
+		struct mem_guard_region *region = &regions[i];
+		uint32_t digest;
+
+		if (region->updaters != 0U) {
+			continue;
+		}
+
+		digest = mem_guard_digest(region->base, region->size);
+		if (digest == region->seal) {
+			continue;
+		}
+
+		spin_unlock(&mem_guard_lock);
+		ERROR("Guarded region '%s' corrupted (checked at %s)\n",
+		      region->name, where);
+		ERROR("  base 0x%lx size %zu digest 0x%x expected 0x%x\n",
+		      (uintptr_t)region->base, region->size, digest,
+		      region->seal);
+		backtrace("mem_guard");
+		panic();
+	}
+
+	spin_unlock(&mem_guard_lock);
+}
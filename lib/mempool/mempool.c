@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <assert.h>
+
+#include <common/debug.h>
+#include <lib/mempool.h>
+#include <lib/utils_def.h>
+
+#if MEMPOOL_LAYOUT
+#pragma weak plat_mempool_layout
+
+const struct mempool_layout *plat_mempool_layout(const char *pool __unused)
+{
+	return NULL;
+}
+
+/*
+ * Serve a phase 0 allocation from the precomputed layout. Returns 0 when
+ * the pool is not under layout control, which drops the caller back on
+ * the bump path. A sequence drift parts the pool from its layout for the
+ * rest of the boot: the offsets already handed out stay valid, only the
+ * remaining allocations lose their pinning.
+ */
+static uintptr_t mempool_layout_place(struct mempool *pool, size_t size,
+				      size_t align)
+{
+	const struct mempool_layout_entry *entry;
+
+	if (pool->depth != 0U) {
+		return 0U;
+	}
+
+	if (!pool->layout_probed) {
+		pool->layout = plat_mempool_layout(pool->name);
+		pool->layout_probed = true;
+	}
+
+	if (pool->layout == NULL) {
+		/* Allocation log of the reference boot for tools/poolplan */
+		NOTICE("MEMPOOL %s #%u size %zu align %zu\n", pool->name,
+		       pool->seq, size, align);
+		pool->seq++;
+		return 0U;
+	}
+
+	if (pool->seq >= pool->layout->count) {
+		WARN("mempool %s: layout exhausted at #%u\n", pool->name,
+		     pool->seq);
+		pool->layout = NULL;
+		return 0U;
+	}
+
+	entry = &pool->layout->entries[pool->seq];
+	if ((entry->size != size) || (entry->align != align) ||
+	    ((entry->offset & (align - 1U)) != 0U) ||
+	    ((entry->offset + size) > pool->size)) {
+		WARN("mempool %s: stale layout at #%u\n", pool->name,
+		     pool->seq);
+		pool->layout = NULL;
+		return 0U;
+	}
+
+	pool->seq++;
+	pool->used = MAX(pool->used, (size_t)entry->offset + size);
+
+	return (uintptr_t)pool->base + entry->offset;
+}
+#endif /* MEMPOOL_LAYOUT */
+
+void *mempool_alloc(struct mempool *pool, size_t size, size_t align)
+{
+	uintptr_t limit = (uintptr_t)pool->base + pool->size;
+	uintptr_t chunk;
+
+	assert((align != 0U) && ((align & (align - 1U)) == 0U));
+
+#if MEMPOOL_LAYOUT
+	chunk = mempool_layout_place(pool, size, align);
+	if (chunk != 0U) {
+		return (void *)chunk;
+	}
+#endif
+
+	chunk = round_up((uintptr_t)pool->base + pool->used, align);
+	if ((chunk > limit) || (size > (limit - chunk))) {
+		ERROR("Cannot allocate %zu bytes out of pool (%zu bytes left)\n",
+		      size, mempool_free_space(pool));
+		panic();
+	}
+
+	pool->used = (chunk + size) - (uintptr_t)pool->base;
+
+	return (void *)chunk;
+}
+
+void mempool_seed(struct mempool *pool, void *base, size_t size)
+{
+	assert((pool->size == 0U) && (pool->used == 0U));
+
+	pool->base = base;
+	pool->size = size;
+}
+
+void mempool_phase_enter(struct mempool *pool)
+{
+	assert(pool->depth < MEMPOOL_PHASE_DEPTH);
+
+	pool->marks[pool->depth] = pool->used;
+	pool->depth++;
+}
+
+void mempool_phase_exit(struct mempool *pool)
+{
+	assert(pool->depth > 0U);
+
+	pool->depth--;
+	pool->used = pool->marks[pool->depth];
+}
+
+size_t mempool_free_space(const struct mempool *pool)
+{
+	return pool->size - pool->used;
+}
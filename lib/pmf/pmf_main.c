@@ -49,6 +49,192 @@ static int pmf_svc_descs_indices[PMF_SVC_DESCS_MAX];
  */
 static int pmf_num_services;
 
+#if PMF_RING_BUFFER
+/*
+ * Per-CPU time-stamp history. Every time-stamp stored by a PMF service is
+ * also appended here together with its tid, so that repeated captures (e.g.
+ * PSCI suspend/resume pairs over thousands of cycles) can be read back after
+ * the measurement instead of sampling one overwritten slot per SMC.
+ * Each CPU appends to its own ring, so no locking is needed; the `head`
+ * counter is monotonic and older entries are overwritten once the ring is
+ * full.
+ */
+#ifndef PLAT_PMF_RING_DEPTH
+#define PLAT_PMF_RING_DEPTH	256
+#endif
+
+CASSERT((PLAT_PMF_RING_DEPTH & (PLAT_PMF_RING_DEPTH - 1)) == 0,
+	assert_pmf_ring_depth_not_power_of_2);
+
+typedef struct pmf_ring_entry {
+	unsigned long long ts;
+	unsigned int tid;
+} pmf_ring_entry_t;
+
+static struct pmf_ring {
+	pmf_ring_entry_t entries[PLAT_PMF_RING_DEPTH];
+	unsigned int head;
+} __aligned(CACHE_WRITEBACK_GRANULE) pmf_rings[PLATFORM_CORE_COUNT];
+
+static void pmf_ring_record(unsigned int tid, unsigned long long ts,
+			    int cache_maint)
+{
+	struct pmf_ring *ring = &pmf_rings[plat_my_core_pos()];
+	pmf_ring_entry_t *entry;
+
+	entry = &ring->entries[ring->head & (PLAT_PMF_RING_DEPTH - 1U)];
+	entry->ts = ts;
+	entry->tid = tid;
+	ring->head++;
+
+	if (cache_maint != 0) {
+		flush_dcache_range((uintptr_t)entry, sizeof(*entry));
+		flush_dcache_range((uintptr_t)&ring->head,
+				   sizeof(ring->head));
+	}
+}
+
+/*
+ * This function retrieves a time-stamp history entry for the CPU identified
+ * by `mpidr`. `offset` counts backwards from the most recent capture; the
+ * special PMF_RING_QUERY_COUNT value returns the monotonic capture count
+ * instead, so callers can size their drain loop.
+ */
+int pmf_get_ring_entry_smc(u_register_t mpidr,
+		unsigned int offset,
+		unsigned int flags,
+		unsigned int *tid,
+		unsigned long long *ts_value)
+{
+	struct pmf_ring *ring;
+	pmf_ring_entry_t *entry;
+	unsigned int avail;
+	int cpu_pos;
+
+	assert((tid != NULL) && (ts_value != NULL));
+
+	*tid = 0U;
+	*ts_value = 0ULL;
+
+	cpu_pos = plat_core_pos_by_mpidr(mpidr);
+	if (cpu_pos < 0)
+		return -EINVAL;
+
+	ring = &pmf_rings[cpu_pos];
+
+	if ((flags & PMF_CACHE_MAINT) != 0U)
+		inv_dcache_range((uintptr_t)&ring->head, sizeof(ring->head));
+
+	if (offset == PMF_RING_QUERY_COUNT) {
+		*ts_value = ring->head;
+		return 0;
+	}
+
+	avail = MIN(ring->head, (unsigned int)PLAT_PMF_RING_DEPTH);
+	if (offset >= avail)
+		return -EINVAL;
+
+	entry = &ring->entries[(ring->head - 1U - offset) &
+			       (PLAT_PMF_RING_DEPTH - 1U)];
+
+	if ((flags & PMF_CACHE_MAINT) != 0U)
+		inv_dcache_range((uintptr_t)entry, sizeof(*entry));
+
+	*tid = entry->tid;
+	*ts_value = entry->ts;
+
+	return 0;
+}
+#endif /* PMF_RING_BUFFER */
+
+#if PMF_DYN_CAPTURE
+/*
+ * Runtime-togglable capture sites collect in the 'pmf_capture_sites'
+ * linker section, one descriptor with its own static key per site.
+ */
+IMPORT_SYM(uintptr_t, __PMF_CAPTURE_SITES_START__, PMF_CAPTURE_SITES_START);
+IMPORT_SYM(uintptr_t, __PMF_CAPTURE_SITES_END__, PMF_CAPTURE_SITES_END);
+
+static pmf_capture_site_t *get_capture_site(unsigned int site_id)
+{
+	pmf_capture_site_t *site =
+		(pmf_capture_site_t *)PMF_CAPTURE_SITES_START;
+	pmf_capture_site_t *end =
+		(pmf_capture_site_t *)PMF_CAPTURE_SITES_END;
+
+	for (; site < end; site++) {
+		if (site->site_id == site_id) {
+			return site;
+		}
+	}
+
+	return NULL;
+}
+
+/*
+ * This function toggles or queries the capture site identified by
+ * `site_id` on behalf of the capture control SMC. Enabling a site
+ * re-patches its capture instructions in, so the instrumentation only
+ * costs anything while a measurement is running.
+ */
+int pmf_capture_ctl_smc(unsigned int site_id,
+		unsigned int op,
+		unsigned int *state)
+{
+	pmf_capture_site_t *site;
+
+	assert(state != NULL);
+
+	*state = 0U;
+
+	if (op == PMF_CAPTURE_CTL_COUNT) {
+		*state = (unsigned int)
+			((PMF_CAPTURE_SITES_END - PMF_CAPTURE_SITES_START) /
+			 sizeof(pmf_capture_site_t));
+		return 0;
+	}
+
+	site = get_capture_site(site_id);
+	if (site == NULL)
+		return -EINVAL;
+
+	switch (op) {
+	case PMF_CAPTURE_CTL_DISABLE:
+		static_key_set(&site->key, false);
+		break;
+	case PMF_CAPTURE_CTL_ENABLE:
+		static_key_set(&site->key, true);
+		break;
+	case PMF_CAPTURE_CTL_QUERY:
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	*state = (site->key.enabled != 0U) ? 1U : 0U;
+
+	return 0;
+}
+#endif /* PMF_DYN_CAPTURE */
+
+#if PMF_CYCLE_COUNTER
+/*
+ * Enable the PMU cycle counter used as PMF time-stamp source. The counter
+ * is banked per CPU: platforms must call this on every CPU that captures
+ * time-stamps, typically from their per-CPU power on path.
+ */
+void pmf_init_cycle_counter(void)
+{
+#ifdef __aarch64__
+	write_pmcntenset_el0(PMCNTENSET_EL0_C_BIT);
+	write_pmcr_el0(read_pmcr_el0() | PMCR_EL0_E_BIT);
+#else
+	write_pmcntenset(PMCNTENSET_C_BIT);
+	write_pmcr(read_pmcr() | PMCR_E_BIT);
+#endif
+}
+#endif /* PMF_CYCLE_COUNTER */
+
 /*
  * This is the main PMF function that initialize registered
  * PMF services and also sort them in ascending order.
@@ -58,6 +244,10 @@ int pmf_setup(void)
 	int rc, ii, jj = 0;
 	int pmf_svc_descs_num, temp_val;
 
+#if PMF_CYCLE_COUNTER
+	pmf_init_cycle_counter();
+#endif
+
 	/* If no PMF services are registered then simply bail out */
 	pmf_svc_descs_num = (PMF_SVC_DESCS_END - PMF_SVC_DESCS_START)/
 				 sizeof(pmf_svc_desc_t);
@@ -218,6 +408,10 @@ void __pmf_store_timestamp(uintptr_t base_addr,
 	unsigned long long *ts_addr = (unsigned long long *)calc_ts_addr(base_addr,
 				 tid, plat_my_core_pos());
 	*ts_addr = ts;
+
+#if PMF_RING_BUFFER
+	pmf_ring_record(tid, ts, 0);
+#endif
 }
 
 /*
@@ -233,6 +427,10 @@ void __pmf_store_timestamp_with_cache_maint(uintptr_t base_addr,
 				 tid, plat_my_core_pos());
 	*ts_addr = ts;
 	flush_dcache_range((uintptr_t)ts_addr, sizeof(unsigned long long));
+
+#if PMF_RING_BUFFER
+	pmf_ring_record(tid, ts, 1);
+#endif
 }
 
 /*
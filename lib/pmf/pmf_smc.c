@@ -25,6 +25,12 @@ uintptr_t pmf_smc_handler(unsigned int smc_fid,
 {
 	int rc;
 	unsigned long long ts_value;
+#if PMF_RING_BUFFER
+	unsigned int tid;
+#endif
+#if PMF_DYN_CAPTURE
+	unsigned int state;
+#endif
 
 	if (((smc_fid >> FUNCID_CC_SHIFT) & FUNCID_CC_MASK) == SMC_32) {
 
@@ -44,6 +50,36 @@ uintptr_t pmf_smc_handler(unsigned int smc_fid,
 			SMC_RET3(handle, rc, (uint32_t)ts_value,
 					(uint32_t)(ts_value >> 32));
 		}
+
+#if PMF_RING_BUFFER
+		if (smc_fid == PMF_SMC_GET_RING_ENTRY_32) {
+			/*
+			 * Return error code, the entry tid and its
+			 * time-stamp to the caller.
+			 * x0 --> error code.
+			 * x1 --> tid of the history entry.
+			 * x2 - x3 --> time-stamp value.
+			 */
+			rc = pmf_get_ring_entry_smc(x1, (unsigned int)x2,
+					(unsigned int)x3, &tid, &ts_value);
+			SMC_RET4(handle, rc, tid, (uint32_t)ts_value,
+					(uint32_t)(ts_value >> 32));
+		}
+#endif
+
+#if PMF_DYN_CAPTURE
+		if (smc_fid == PMF_SMC_CAPTURE_CTL_32) {
+			/*
+			 * Return error code and the state of the capture
+			 * site (or the site count) to the caller.
+			 * x0 --> error code.
+			 * x1 --> site state/count.
+			 */
+			rc = pmf_capture_ctl_smc((unsigned int)x1,
+					(unsigned int)x2, &state);
+			SMC_RET2(handle, rc, state);
+		}
+#endif
 	} else {
 		if (smc_fid == PMF_SMC_GET_TIMESTAMP_64) {
 			/*
@@ -56,6 +92,35 @@ uintptr_t pmf_smc_handler(unsigned int smc_fid,
 					(unsigned int)x3, &ts_value);
 			SMC_RET2(handle, rc, ts_value);
 		}
+
+#if PMF_RING_BUFFER
+		if (smc_fid == PMF_SMC_GET_RING_ENTRY_64) {
+			/*
+			 * Return error code, the entry tid and its
+			 * time-stamp to the caller.
+			 * x0 --> error code.
+			 * x1 --> tid of the history entry.
+			 * x2 --> time-stamp value.
+			 */
+			rc = pmf_get_ring_entry_smc(x1, (unsigned int)x2,
+					(unsigned int)x3, &tid, &ts_value);
+			SMC_RET3(handle, rc, tid, ts_value);
+		}
+#endif
+
+#if PMF_DYN_CAPTURE
+		if (smc_fid == PMF_SMC_CAPTURE_CTL_64) {
+			/*
+			 * Return error code and the state of the capture
+			 * site (or the site count) to the caller.
+			 * x0 --> error code.
+			 * x1 --> site state/count.
+			 */
+			rc = pmf_capture_ctl_smc((unsigned int)x1,
+					(unsigned int)x2, &state);
+			SMC_RET2(handle, rc, state);
+		}
+#endif
 	}
 
 	WARN("Unimplemented PMF Call: 0x%x \n", smc_fid);
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <string.h>
+
+#include <arch_helpers.h>
+#include <lib/pmf/pmf.h>
+#include <lib/pmf/pmf_smc_trace.h>
+#include <lib/smccc.h>
+#include <lib/utils_def.h>
+#include <plat/common/platform.h>
+
+/*
+ * Per-CPU histograms. Each CPU only ever writes its own entry, so no
+ * locking is needed; entries are cache line aligned to avoid false
+ * sharing between cores.
+ */
+static struct smc_trace_pcpu {
+	uint8_t oen[SMC_TRACE_OEN_SLOTS];
+	uint32_t hist[SMC_TRACE_OEN_SLOTS][SMC_TRACE_NUM_BUCKETS];
+	uint32_t dropped;
+} __aligned(CACHE_WRITEBACK_GRANULE) smc_trace[PLATFORM_CORE_COUNT];
+
+static int pmf_smc_trace_init(void)
+{
+	unsigned int i;
+
+	for (i = 0U; i < PLATFORM_CORE_COUNT; i++) {
+		(void)memset(smc_trace[i].oen, (int)SMC_TRACE_OEN_FREE,
+			     sizeof(smc_trace[i].oen));
+	}
+
+	return 0;
+}
+
+/*
+ * Capture the dispatch entry time-stamp. The value is opaque to the
+ * caller and only meant to be passed back to pmf_smc_trace_exit().
+ */
+unsigned long long pmf_smc_trace_enter(void)
+{
+	return PMF_READ_TIMESTAMP();
+}
+
+/*
+ * Bin the latency of a completed dispatch into the histogram of the
+ * SMC's OEN on the current CPU.
+ */
+void pmf_smc_trace_exit(uint32_t smc_fid, unsigned long long entry_ts)
+{
+	struct smc_trace_pcpu *pcpu = &smc_trace[plat_my_core_pos()];
+	unsigned long long delta = PMF_READ_TIMESTAMP() - entry_ts;
+	uint8_t oen = (uint8_t)GET_SMC_OEN(smc_fid);
+	unsigned int slot;
+	unsigned int bucket;
+
+	for (slot = 0U; slot < SMC_TRACE_OEN_SLOTS; slot++) {
+		if (pcpu->oen[slot] == oen) {
+			break;
+		}
+
+		if (pcpu->oen[slot] == SMC_TRACE_OEN_FREE) {
+			pcpu->oen[slot] = oen;
+			break;
+		}
+	}
+
+	if (slot == SMC_TRACE_OEN_SLOTS) {
+		pcpu->dropped++;
+		return;
+	}
+
+	bucket = 0U;
+	while ((delta > 1ULL) && (bucket < (SMC_TRACE_NUM_BUCKETS - 1U))) {
+		delta >>= 1;
+		bucket++;
+	}
+
+	pcpu->hist[slot][bucket]++;
+}
+
+/*
+ * Retrieval handler for the PMF SMC interface, decoding the tid layout
+ * described in pmf_smc_trace.h.
+ */
+static unsigned long long pmf_smc_trace_get_ts(unsigned int tid,
+					       u_register_t mpidr,
+					       unsigned int flags)
+{
+	struct smc_trace_pcpu *pcpu;
+	unsigned int id = tid & PMF_TID_MASK;
+	int cpu_pos = plat_core_pos_by_mpidr(mpidr);
+
+	if (cpu_pos < 0) {
+		return 0ULL;
+	}
+
+	pcpu = &smc_trace[cpu_pos];
+
+	if ((flags & PMF_CACHE_MAINT) != 0U) {
+		inv_dcache_range((uintptr_t)pcpu, sizeof(*pcpu));
+	}
+
+	if (id < SMC_TRACE_TID_OEN_BASE) {
+		return pcpu->hist[id / SMC_TRACE_NUM_BUCKETS]
+				 [id % SMC_TRACE_NUM_BUCKETS];
+	}
+
+	if (id < SMC_TRACE_TID_DROPPED) {
+		return pcpu->oen[id - SMC_TRACE_TID_OEN_BASE];
+	}
+
+	return pcpu->dropped;
+}
+
+PMF_REGISTER_SERVICE_SMC_OWN(smc_trace, PMF_ARM_TIF_IMPL_ID,
+		PMF_SMC_TRACE_SVC_ID, SMC_TRACE_TOTAL_IDS,
+		pmf_smc_trace_init, pmf_smc_trace_get_ts)
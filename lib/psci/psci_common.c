@@ -13,6 +13,7 @@
 #include <common/debug.h>
 #include <context.h>
 #include <lib/el3_runtime/context_mgmt.h>
+#include <lib/mem_guard.h>
 #include <lib/utils.h>
 #include <plat/common/platform.h>
 
@@ -62,6 +63,16 @@ DEFINE_PSCI_LOCK(psci_locks[PSCI_NUM_NON_CPU_PWR_DOMAINS]);
 
 cpu_pd_node_t psci_cpu_pd_nodes[PLATFORM_CORE_COUNT];
 
+/*
+ * Ancestor node indices of each CPU, one row per CPU with the parent at
+ * power level 'lvl' in column 'lvl - 1'. The rows are filled once at setup
+ * by walking the parent_node links, so that every later lookup indexes this
+ * dense array instead of chasing pointers across the scattered
+ * psci_non_cpu_pd_nodes cachelines on each idle entry.
+ */
+static unsigned int psci_cpu_parent_nodes[PLATFORM_CORE_COUNT]
+					 [PLAT_MAX_PWR_LVL];
+
 /*******************************************************************************
  * Pointer to functions exported by the platform to complete power mgmt. ops
  ******************************************************************************/
@@ -286,12 +297,14 @@ static plat_local_state_t get_non_cpu_pd_node_local_state(
 static void set_non_cpu_pd_node_local_state(unsigned int parent_idx,
 		plat_local_state_t state)
 {
+	mem_guard_begin_update(psci_non_cpu_pd_nodes);
 	psci_non_cpu_pd_nodes[parent_idx].local_state = state;
 #if !(USE_COHERENT_MEM || HW_ASSISTED_COHERENCY || WARMBOOT_ENABLE_DCACHE_EARLY)
 	flush_dcache_range(
 			(uintptr_t) &psci_non_cpu_pd_nodes[parent_idx],
 			sizeof(psci_non_cpu_pd_nodes[parent_idx]));
 #endif
+	mem_guard_end_update(psci_non_cpu_pd_nodes);
 }
 
 /******************************************************************************
@@ -304,15 +317,15 @@ void psci_get_target_local_pwr_states(unsigned int end_pwrlvl,
 				      psci_power_state_t *target_state)
 {
 	unsigned int parent_idx, lvl;
+	unsigned int cpu_idx = plat_my_core_pos();
 	plat_local_state_t *pd_state = target_state->pwr_domain_state;
 
 	pd_state[PSCI_CPU_PWR_LVL] = psci_get_cpu_local_state();
-	parent_idx = psci_cpu_pd_nodes[plat_my_core_pos()].parent_node;
 
 	/* Copy the local power state from node to state_info */
 	for (lvl = PSCI_CPU_PWR_LVL + 1U; lvl <= end_pwrlvl; lvl++) {
+		parent_idx = psci_cpu_parent_nodes[cpu_idx][lvl - 1U];
 		pd_state[lvl] = get_non_cpu_pd_node_local_state(parent_idx);
-		parent_idx = psci_non_cpu_pd_nodes[parent_idx].parent_node;
 	}
 
 	/* Set the the higher levels to RUN */
@@ -330,6 +343,7 @@ static void psci_set_target_local_pwr_states(unsigned int end_pwrlvl,
 					const psci_power_state_t *target_state)
 {
 	unsigned int parent_idx, lvl;
+	unsigned int cpu_idx = plat_my_core_pos();
 	const plat_local_state_t *pd_state = target_state->pwr_domain_state;
 
 	psci_set_cpu_local_state(pd_state[PSCI_CPU_PWR_LVL]);
@@ -340,16 +354,43 @@ static void psci_set_target_local_pwr_states(unsigned int end_pwrlvl,
 	 */
 	psci_flush_cpu_data(psci_svc_cpu_data.local_state);
 
-	parent_idx = psci_cpu_pd_nodes[plat_my_core_pos()].parent_node;
-
 	/* Copy the local_state from state_info */
 	for (lvl = 1U; lvl <= end_pwrlvl; lvl++) {
+		parent_idx = psci_cpu_parent_nodes[cpu_idx][lvl - 1U];
 		set_non_cpu_pd_node_local_state(parent_idx, pd_state[lvl]);
-		parent_idx = psci_non_cpu_pd_nodes[parent_idx].parent_node;
 	}
 }
 
 
+/*******************************************************************************
+ * This function precomputes psci_cpu_parent_nodes[] from the parent_node
+ * links set up by populate_power_domain_tree(). It must be invoked before
+ * the first psci_get_parent_pwr_domain_nodes() call.
+ ******************************************************************************/
+void __init psci_init_parent_pwr_domain_nodes(void)
+{
+	unsigned int cpu_idx, lvl, parent_node;
+
+	for (cpu_idx = 0U; cpu_idx < (unsigned int)PLATFORM_CORE_COUNT;
+	     cpu_idx++) {
+		parent_node = psci_cpu_pd_nodes[cpu_idx].parent_node;
+
+		for (lvl = PSCI_CPU_PWR_LVL + 1U; lvl <= PLAT_MAX_PWR_LVL;
+		     lvl++) {
+			psci_cpu_parent_nodes[cpu_idx][lvl - 1U] = parent_node;
+			parent_node =
+				psci_non_cpu_pd_nodes[parent_node].parent_node;
+		}
+	}
+
+	/*
+	 * Flush the table as it will be read by CPUs during warm boot,
+	 * possibly before data cache is enabled.
+	 */
+	psci_flush_dcache_range((uintptr_t)psci_cpu_parent_nodes,
+				sizeof(psci_cpu_parent_nodes));
+}
+
 /*******************************************************************************
  * PSCI helper function to get the parent nodes corresponding to a cpu_index.
  ******************************************************************************/
@@ -357,14 +398,12 @@ void psci_get_parent_pwr_domain_nodes(unsigned int cpu_idx,
 				      unsigned int end_lvl,
 				      unsigned int *node_index)
 {
-	unsigned int parent_node = psci_cpu_pd_nodes[cpu_idx].parent_node;
 	unsigned int i;
 	unsigned int *node = node_index;
 
 	for (i = PSCI_CPU_PWR_LVL + 1U; i <= end_lvl; i++) {
-		*node = parent_node;
+		*node = psci_cpu_parent_nodes[cpu_idx][i - 1U];
 		node++;
-		parent_node = psci_non_cpu_pd_nodes[parent_node].parent_node;
 	}
 }
 
@@ -376,16 +415,15 @@ void psci_get_parent_pwr_domain_nodes(unsigned int cpu_idx,
 void psci_set_pwr_domains_to_run(unsigned int end_pwrlvl)
 {
 	unsigned int parent_idx, cpu_idx = plat_my_core_pos(), lvl;
-	parent_idx = psci_cpu_pd_nodes[cpu_idx].parent_node;
 
 	/* Reset the local_state to RUN for the non cpu power domains. */
 	for (lvl = PSCI_CPU_PWR_LVL + 1U; lvl <= end_pwrlvl; lvl++) {
+		parent_idx = psci_cpu_parent_nodes[cpu_idx][lvl - 1U];
 		set_non_cpu_pd_node_local_state(parent_idx,
 				PSCI_LOCAL_STATE_RUN);
 		psci_set_req_local_pwr_state(lvl,
 					     cpu_idx,
 					     PSCI_LOCAL_STATE_RUN);
-		parent_idx = psci_non_cpu_pd_nodes[parent_idx].parent_node;
 	}
 
 	/* Set the affinity info state to ON */
@@ -424,11 +462,11 @@ void psci_do_state_coordination(unsigned int end_pwrlvl,
 	plat_local_state_t target_state, *req_states;
 
 	assert(end_pwrlvl <= PLAT_MAX_PWR_LVL);
-	parent_idx = psci_cpu_pd_nodes[cpu_idx].parent_node;
 
 	/* For level 0, the requested state will be equivalent
 	   to target state */
 	for (lvl = PSCI_CPU_PWR_LVL + 1U; lvl <= end_pwrlvl; lvl++) {
+		parent_idx = psci_cpu_parent_nodes[cpu_idx][lvl - 1U];
 
 		/* First update the requested power state */
 		psci_set_req_local_pwr_state(lvl, cpu_idx,
@@ -452,8 +490,6 @@ void psci_do_state_coordination(unsigned int end_pwrlvl,
 		/* Break early if the negotiated target power state is RUN */
 		if (is_local_state_run(state_info->pwr_domain_state[lvl]) != 0)
 			break;
-
-		parent_idx = psci_non_cpu_pd_nodes[parent_idx].parent_node;
 	}
 
 	/*
@@ -473,6 +509,87 @@ void psci_do_state_coordination(unsigned int end_pwrlvl,
 	psci_set_target_local_pwr_states(end_pwrlvl, state_info);
 }
 
+#if PSCI_LAZY_PD_LOCKS
+/******************************************************************************
+ * Variant of psci_do_state_coordination() which also acquires the parent
+ * power domain locks, each one only when coordination actually reaches the
+ * corresponding level. A CPU whose negotiated target state at some level
+ * turns out to be RUN never touches the locks above that level, so
+ * independent CPU-level suspends on different clusters do not contend on
+ * the higher level locks. Locks are still taken in increasing level order,
+ * preserving the lock hierarchy with respect to the eager callers.
+ *
+ * The requested states recorded above the returned level land in this
+ * CPU's own per-CPU slots as single-byte writes. The CPU which eventually
+ * coordinates one of those levels does so under the corresponding lock and
+ * observes each slot either before or after this update; both orders are
+ * valid serializations, exactly as if this suspend had completed before or
+ * after that coordination. Target states are only written to the locked
+ * nodes: the nodes above necessarily stay in RUN while this CPU runs.
+ *
+ * Returns the highest power level whose lock is held on exit; the caller
+ * must pass it to psci_release_pwr_domain_locks().
+ *****************************************************************************/
+unsigned int psci_do_state_coordination_lazy(unsigned int end_pwrlvl,
+					     psci_power_state_t *state_info)
+{
+	unsigned int lvl, parent_idx, cpu_idx = plat_my_core_pos();
+	unsigned int start_idx;
+	unsigned int ncpus;
+	unsigned int locked_lvl = PSCI_CPU_PWR_LVL;
+	plat_local_state_t target_state, *req_states;
+
+	assert(end_pwrlvl <= PLAT_MAX_PWR_LVL);
+
+	for (lvl = PSCI_CPU_PWR_LVL + 1U; lvl <= end_pwrlvl; lvl++) {
+		parent_idx = psci_cpu_parent_nodes[cpu_idx][lvl - 1U];
+
+		/* Coordination reaches this level: take its lock now */
+		psci_lock_get(&psci_non_cpu_pd_nodes[parent_idx]);
+		locked_lvl = lvl;
+
+		/* First update the requested power state */
+		psci_set_req_local_pwr_state(lvl, cpu_idx,
+					     state_info->pwr_domain_state[lvl]);
+
+		/* Get the requested power states for this power level */
+		start_idx = psci_non_cpu_pd_nodes[parent_idx].cpu_start_idx;
+		req_states = psci_get_req_local_pwr_states(lvl, start_idx);
+
+		/*
+		 * Let the platform coordinate amongst the requested states at
+		 * this power level and return the target local power state.
+		 */
+		ncpus = psci_non_cpu_pd_nodes[parent_idx].ncpus;
+		target_state = plat_get_target_pwr_state(lvl,
+							 req_states,
+							 ncpus);
+
+		state_info->pwr_domain_state[lvl] = target_state;
+
+		/* Break early if the negotiated target power state is RUN */
+		if (is_local_state_run(state_info->pwr_domain_state[lvl]) != 0)
+			break;
+	}
+
+	/*
+	 * Record this CPU's requested states at the levels coordination did
+	 * not reach and report their target as RUN, without taking the
+	 * corresponding locks.
+	 */
+	for (lvl = lvl + 1U; lvl <= end_pwrlvl; lvl++) {
+		psci_set_req_local_pwr_state(lvl, cpu_idx,
+					     state_info->pwr_domain_state[lvl]);
+		state_info->pwr_domain_state[lvl] = PSCI_LOCAL_STATE_RUN;
+	}
+
+	/* Update the target state in the locked power domain nodes only */
+	psci_set_target_local_pwr_states(locked_lvl, state_info);
+
+	return locked_lvl;
+}
+#endif /* PSCI_LAZY_PD_LOCKS */
+
 /******************************************************************************
  * This function validates a suspend request by making sure that if a standby
  * state is requested then no power level is turned off and the highest power
@@ -553,6 +670,29 @@ unsigned int psci_find_max_off_lvl(const psci_power_state_t *state_info)
 	return PSCI_INVALID_PWR_LVL;
 }
 
+/******************************************************************************
+ * This function finds the level of cache maintenance to perform when powering
+ * down to the 'state_info' state. It defaults to the highest power level
+ * which will be powered down. Platforms whose shallow power down states
+ * retain some cache levels can cap it through the optional
+ * pwr_domain_pwrdown_cache_lvl hook, e.g. to skip the L2 flush when the
+ * cluster cache stays powered. The hook can only reduce the default level.
+ *****************************************************************************/
+unsigned int psci_find_pwrdown_cache_lvl(const psci_power_state_t *state_info)
+{
+	unsigned int max_off_lvl = psci_find_max_off_lvl(state_info);
+	unsigned int cache_lvl;
+
+	if (psci_plat_pm_ops->pwr_domain_pwrdown_cache_lvl == NULL)
+		return max_off_lvl;
+
+	cache_lvl = psci_plat_pm_ops->pwr_domain_pwrdown_cache_lvl(state_info);
+	if (cache_lvl > max_off_lvl)
+		cache_lvl = max_off_lvl;
+
+	return cache_lvl;
+}
+
 /******************************************************************************
  * This functions finds the level of the highest power domain which will be
  * placed in a low power state during a suspend operation.
@@ -825,7 +965,7 @@ void psci_warmboot_entrypoint(void)
 
 #if ENABLE_PSCI_STAT
 	/*
-	 * Update PSCI stats.
+	 * Update PSCI stats for the non CPU power domains.
 	 * Caches are off when writing stats data on the power down path.
 	 * Since caches are now enabled, it's necessary to do cache
 	 * maintenance before reading that same data.
@@ -838,6 +978,11 @@ void psci_warmboot_entrypoint(void)
 	 * in the reverse order to which they were acquired.
 	 */
 	psci_release_pwr_domain_locks(end_pwrlvl, parent_nodes);
+
+#if ENABLE_PSCI_STAT
+	/* The CPU counters are private to this CPU, no lock needed. */
+	psci_stats_update_pwr_up_cpu(&state_info);
+#endif
 }
 
 /*******************************************************************************
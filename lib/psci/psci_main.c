@@ -46,43 +46,167 @@ int psci_cpu_on(u_register_t target_cpu,
 	return psci_cpu_on_start(target_cpu, &ep);
 }
 
+/*
+ * Power on a set of cpus with one locked section and batched cache
+ * maintenance. This is not a PSCI SMC: it is an EL3-side interface for
+ * platform services that bring several secondaries up at once, so that they
+ * do not pay a full psci_cpu_on() round trip per CPU. All targets share the
+ * same entry point and context id.
+ */
+int psci_cpu_on_multi(const u_register_t *target_cpus,
+		      unsigned int target_count,
+		      uintptr_t entrypoint,
+		      u_register_t context_id)
+{
+	int rc;
+	unsigned int i;
+	entry_point_info_t ep;
+
+	if ((target_cpus == NULL) || (target_count == 0U) ||
+	    (target_count > (unsigned int)PLATFORM_CORE_COUNT))
+		return PSCI_E_INVALID_PARAMS;
+
+	/* Determine if the cpus exist or not */
+	for (i = 0U; i < target_count; i++) {
+		rc = psci_validate_mpidr(target_cpus[i]);
+		if (rc != PSCI_E_SUCCESS)
+			return PSCI_E_INVALID_PARAMS;
+	}
+
+	/* Validate the entry point and get the entry_point_info */
+	rc = psci_validate_entry_point(&ep, entrypoint, context_id);
+	if (rc != PSCI_E_SUCCESS)
+		return rc;
+
+	return psci_cpu_on_multi_start(target_cpus, target_count, &ep);
+}
+
 unsigned int psci_version(void)
 {
 	return PSCI_MAJOR_VER | PSCI_MINOR_VER;
 }
 
-int psci_cpu_suspend(unsigned int power_state,
-		     uintptr_t entrypoint,
-		     u_register_t context_id)
+#if PSCI_SUSPEND_STATE_CACHE
+/*
+ * Cache of validated CPU_SUSPEND power_state parameters. An OS uses only a
+ * handful of distinct power_state values, so after the first request the
+ * validation and target state composition are pure repeated work. The cache
+ * is per core and only ever accessed by its owner, so no locking is needed.
+ */
+#define SUSPEND_STATE_CACHE_ENTRIES	4U
+
+struct suspend_state_cache_entry {
+	unsigned int power_state;
+	unsigned int target_pwrlvl;
+	psci_power_state_t state_info;
+	bool valid;
+};
+
+static struct suspend_state_cache_entry
+	suspend_state_cache[PLATFORM_CORE_COUNT][SUSPEND_STATE_CACHE_ENTRIES];
+static unsigned int suspend_state_cache_next[PLATFORM_CORE_COUNT];
+
+static bool psci_suspend_state_lookup(unsigned int power_state,
+				      psci_power_state_t *state_info,
+				      unsigned int *target_pwrlvl)
+{
+	struct suspend_state_cache_entry *line =
+		suspend_state_cache[plat_my_core_pos()];
+	unsigned int i;
+
+	for (i = 0U; i < SUSPEND_STATE_CACHE_ENTRIES; i++) {
+		if (line[i].valid && (line[i].power_state == power_state)) {
+			*state_info = line[i].state_info;
+			*target_pwrlvl = line[i].target_pwrlvl;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static void psci_suspend_state_insert(unsigned int power_state,
+				      const psci_power_state_t *state_info,
+				      unsigned int target_pwrlvl)
+{
+	unsigned int idx = plat_my_core_pos();
+	struct suspend_state_cache_entry *entry =
+		&suspend_state_cache[idx][suspend_state_cache_next[idx]];
+
+	suspend_state_cache_next[idx] =
+		(suspend_state_cache_next[idx] + 1U) %
+		SUSPEND_STATE_CACHE_ENTRIES;
+
+	entry->power_state = power_state;
+	entry->target_pwrlvl = target_pwrlvl;
+	entry->state_info = *state_info;
+	entry->valid = true;
+}
+#endif /* PSCI_SUSPEND_STATE_CACHE */
+
+/*
+ * Validate a CPU_SUSPEND power_state parameter and compose the target state
+ * and suspend level it requests. With PSCI_SUSPEND_STATE_CACHE, results are
+ * remembered per core keyed by the raw power_state value, so repeat suspend
+ * requests go straight to the platform handler.
+ */
+static int psci_get_suspend_state(unsigned int power_state,
+				  unsigned int is_power_down_state,
+				  psci_power_state_t *state_info,
+				  unsigned int *target_pwrlvl)
 {
 	int rc;
-	unsigned int target_pwrlvl, is_power_down_state;
-	entry_point_info_t ep;
-	psci_power_state_t state_info = { {PSCI_LOCAL_STATE_RUN} };
-	plat_local_state_t cpu_pd_state;
+
+#if PSCI_SUSPEND_STATE_CACHE
+	if (psci_suspend_state_lookup(power_state, state_info, target_pwrlvl))
+		return PSCI_E_SUCCESS;
+#endif
 
 	/* Validate the power_state parameter */
-	rc = psci_validate_power_state(power_state, &state_info);
+	rc = psci_validate_power_state(power_state, state_info);
 	if (rc != PSCI_E_SUCCESS) {
 		assert(rc == PSCI_E_INVALID_PARAMS);
 		return rc;
 	}
 
-	/*
-	 * Get the value of the state type bit from the power state parameter.
-	 */
-	is_power_down_state = psci_get_pstate_type(power_state);
-
 	/* Sanity check the requested suspend levels */
-	assert(psci_validate_suspend_req(&state_info, is_power_down_state)
+	assert(psci_validate_suspend_req(state_info, is_power_down_state)
 			== PSCI_E_SUCCESS);
 
-	target_pwrlvl = psci_find_target_suspend_lvl(&state_info);
-	if (target_pwrlvl == PSCI_INVALID_PWR_LVL) {
+	*target_pwrlvl = psci_find_target_suspend_lvl(state_info);
+	if (*target_pwrlvl == PSCI_INVALID_PWR_LVL) {
 		ERROR("Invalid target power level for suspend operation\n");
 		panic();
 	}
 
+#if PSCI_SUSPEND_STATE_CACHE
+	psci_suspend_state_insert(power_state, state_info, *target_pwrlvl);
+#endif
+
+	return PSCI_E_SUCCESS;
+}
+
+int psci_cpu_suspend(unsigned int power_state,
+		     uintptr_t entrypoint,
+		     u_register_t context_id)
+{
+	int rc;
+	unsigned int target_pwrlvl, is_power_down_state;
+	entry_point_info_t ep;
+	psci_power_state_t state_info = { {PSCI_LOCAL_STATE_RUN} };
+	plat_local_state_t cpu_pd_state;
+
+	/*
+	 * Get the value of the state type bit from the power state parameter.
+	 */
+	is_power_down_state = psci_get_pstate_type(power_state);
+
+	/* Validate the power_state parameter and get the target state */
+	rc = psci_get_suspend_state(power_state, is_power_down_state,
+				    &state_info, &target_pwrlvl);
+	if (rc != PSCI_E_SUCCESS)
+		return rc;
+
 	/* Fast path for CPU standby.*/
 	if (is_cpu_standby_req(is_power_down_state, target_pwrlvl)) {
 		if  (psci_plat_pm_ops->cpu_standby == NULL)
@@ -119,8 +243,8 @@ int psci_cpu_suspend(unsigned int power_state,
 #if ENABLE_PSCI_STAT
 		plat_psci_stat_accounting_stop(&state_info);
 
-		/* Update PSCI stats */
-		psci_stats_update_pwr_up(PSCI_CPU_PWR_LVL, &state_info);
+		/* Update PSCI stats: only the CPU level is involved here */
+		psci_stats_update_pwr_up_cpu(&state_info);
 #endif
 
 		return PSCI_E_SUCCESS;
@@ -109,7 +109,7 @@ int psci_do_cpu_off(unsigned int end_pwrlvl)
 	/*
 	 * Arch. management. Initiate power down sequence.
 	 */
-	psci_do_pwrdown_sequence(psci_find_max_off_lvl(&state_info));
+	psci_do_pwrdown_sequence(psci_find_pwrdown_cache_lvl(&state_info));
 
 #if ENABLE_RUNTIME_INSTRUMENTATION
 	PMF_CAPTURE_TIMESTAMP(rt_instr_svc,
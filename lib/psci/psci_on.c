@@ -133,6 +133,12 @@ int psci_cpu_on_start(u_register_t target_cpu,
 		       AFF_STATE_ON_PENDING);
 	}
 
+	/*
+	 * A second CPU is about to start running: bakery locks must stop
+	 * using their uncontended fast path before it can contend for them.
+	 */
+	bakery_lock_set_contended();
+
 	/*
 	 * Perform generic, architecture and platform specific handling.
 	 */
@@ -159,6 +165,169 @@ exit:
 	return rc;
 }
 
+/*******************************************************************************
+ * Clean and invalidate the aff_info_state of every CPU in the sorted target
+ * set with a single ranged operation. The per-cpu data array is contiguous,
+ * so one flush of the span covering the first to the last target replaces a
+ * separate flush (and its barriers) per CPU.
+ ******************************************************************************/
+static void psci_flush_aff_info_states(const int *target_idx,
+				       unsigned int target_count)
+{
+	uintptr_t start = (uintptr_t)
+		&(_cpu_data_by_index((uint32_t)target_idx[0])->
+			psci_svc_cpu_data.aff_info_state);
+	uintptr_t end = (uintptr_t)
+		&(_cpu_data_by_index((uint32_t)target_idx[target_count - 1U])->
+			psci_svc_cpu_data.aff_info_state);
+
+	flush_dcache_range(start, (end - start) + sizeof(aff_info_state_t));
+}
+
+/*******************************************************************************
+ * Generic handler to power on a set of cpus in one go. It performs the same
+ * sequence as psci_cpu_on_start() for every target, but takes all the per-cpu
+ * locks up front and batches the aff_info_state cache maintenance into one
+ * ranged clean+invalidate per pass, so that bringing N secondaries up does
+ * not pay N sequential lock/flush round trips.
+ *
+ * The target list must hold distinct CPUs; it is sorted by core position so
+ * that locks are always taken in ascending order and concurrent callers with
+ * overlapping sets cannot deadlock. The batch is validated as a whole before
+ * any state is modified: if any target cannot be powered on, the error for
+ * the first offending target is returned and no CPU is started.
+ ******************************************************************************/
+int psci_cpu_on_multi_start(const u_register_t *target_cpus,
+			    unsigned int target_count,
+			    const entry_point_info_t *ep)
+{
+	int rc = PSCI_E_SUCCESS;
+	u_register_t target_mpidr[PLATFORM_CORE_COUNT];
+	int target_idx[PLATFORM_CORE_COUNT];
+	aff_info_state_t target_aff_state;
+	unsigned int i;
+
+	/* Calling function must supply valid input arguments */
+	assert(target_cpus != NULL);
+	assert((target_count > 0U) &&
+	       (target_count <= (unsigned int)PLATFORM_CORE_COUNT));
+	assert(ep != NULL);
+
+	/*
+	 * This function must only be called on platforms where the
+	 * CPU_ON platform hooks have been implemented.
+	 */
+	assert((psci_plat_pm_ops->pwr_domain_on != NULL) &&
+	       (psci_plat_pm_ops->pwr_domain_on_finish != NULL));
+
+	for (i = 0U; i < target_count; i++) {
+		target_idx[i] = plat_core_pos_by_mpidr(target_cpus[i]);
+		assert(target_idx[i] >= 0);
+		target_mpidr[i] = target_cpus[i];
+	}
+
+	/* Sort the targets by core position; equal positions are duplicates */
+	for (i = 1U; i < target_count; i++) {
+		int idx = target_idx[i];
+		u_register_t mpidr = target_mpidr[i];
+		unsigned int j = i;
+
+		while ((j > 0U) && (target_idx[j - 1U] >= idx)) {
+			if (target_idx[j - 1U] == idx)
+				return PSCI_E_INVALID_PARAMS;
+			target_idx[j] = target_idx[j - 1U];
+			target_mpidr[j] = target_mpidr[j - 1U];
+			j--;
+		}
+		target_idx[j] = idx;
+		target_mpidr[j] = mpidr;
+	}
+
+	/* Protect against multiple CPUs trying to turn ON the same targets */
+	for (i = 0U; i < target_count; i++)
+		psci_spin_lock_cpu(target_idx[i]);
+
+	/*
+	 * Refresh and validate the state of the whole batch before modifying
+	 * anything. See psci_cpu_on_start() for why the cache maintenance
+	 * ahead of the state read is needed.
+	 */
+	psci_flush_aff_info_states(target_idx, target_count);
+	for (i = 0U; i < target_count; i++) {
+		rc = cpu_on_validate_state(
+			psci_get_aff_info_state_by_idx(target_idx[i]));
+		if (rc != PSCI_E_SUCCESS)
+			goto exit;
+	}
+
+	/*
+	 * Let the Secure Payload Dispatcher do its bookkeeping and mark the
+	 * whole batch ON_PENDING before the combined flush.
+	 */
+	for (i = 0U; i < target_count; i++) {
+		if ((psci_spd_pm != NULL) && (psci_spd_pm->svc_on != NULL))
+			psci_spd_pm->svc_on(target_mpidr[i]);
+
+		psci_set_aff_info_state_by_idx(target_idx[i],
+					       AFF_STATE_ON_PENDING);
+	}
+
+	psci_flush_aff_info_states(target_idx, target_count);
+
+	/*
+	 * Retry any update that was invalidated by an off-going target CPU,
+	 * as in psci_cpu_on_start(). This is the rare path, so the retries
+	 * flush individually.
+	 */
+	for (i = 0U; i < target_count; i++) {
+		target_aff_state =
+			psci_get_aff_info_state_by_idx(target_idx[i]);
+		if (target_aff_state != AFF_STATE_ON_PENDING) {
+			assert(target_aff_state == AFF_STATE_OFF);
+			psci_set_aff_info_state_by_idx(target_idx[i],
+						       AFF_STATE_ON_PENDING);
+			flush_cpu_data_by_index((unsigned int)target_idx[i],
+					psci_svc_cpu_data.aff_info_state);
+
+			assert(psci_get_aff_info_state_by_idx(target_idx[i]) ==
+			       AFF_STATE_ON_PENDING);
+		}
+	}
+
+	/*
+	 * One transition to the contended bakery lock path covers the whole
+	 * batch of secondaries about to start running.
+	 */
+	bakery_lock_set_contended();
+
+	for (i = 0U; i < target_count; i++) {
+		int on_rc = psci_plat_pm_ops->pwr_domain_on(target_mpidr[i]);
+
+		assert((on_rc == PSCI_E_SUCCESS) ||
+		       (on_rc == PSCI_E_INTERN_FAIL));
+
+		if (on_rc == PSCI_E_SUCCESS)
+			/* Store the re-entry information for the NS world. */
+			cm_init_context_by_index((unsigned int)target_idx[i],
+						 ep);
+		else {
+			/* Restore the state on error. */
+			psci_set_aff_info_state_by_idx(target_idx[i],
+						       AFF_STATE_OFF);
+			flush_cpu_data_by_index((unsigned int)target_idx[i],
+					psci_svc_cpu_data.aff_info_state);
+			if (rc == PSCI_E_SUCCESS)
+				rc = on_rc;
+		}
+	}
+
+exit:
+	for (i = target_count; i > 0U; i--)
+		psci_spin_unlock_cpu(target_idx[i - 1U]);
+
+	return rc;
+}
+
 /*******************************************************************************
  * The following function finish an earlier power on request. They
  * are called by the common finisher routine in psci_common.c. The `state_info`
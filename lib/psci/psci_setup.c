@@ -13,6 +13,7 @@
 #include <context.h>
 #include <lib/el3_runtime/context_mgmt.h>
 #include <lib/cpus/errata_report.h>
+#include <lib/mem_guard.h>
 #include <plat/common/platform.h>
 
 #include "psci_private.h"
@@ -201,6 +202,9 @@ int __init psci_setup(const psci_lib_args_t *lib_args)
 	/* Populate the power domain arrays using the platform topology map */
 	populate_power_domain_tree(topology_tree);
 
+	/* Precompute the ancestor node indices of each CPU */
+	psci_init_parent_pwr_domain_nodes();
+
 	/* Update the CPU limits for each node in psci_non_cpu_pd_nodes */
 	psci_update_pwrlvl_limits();
 
@@ -260,6 +264,18 @@ int __init psci_setup(const psci_lib_args_t *lib_args)
 	psci_caps |=  define_psci_cap(PSCI_STAT_COUNT_AARCH64);
 #endif
 
+	/*
+	 * Seal the PSCI state that must no longer change, or changes only
+	 * through set_non_cpu_pd_node_local_state() which brackets its
+	 * write for the guard. The CPU nodes are left out: their cpu_lock
+	 * spinlocks are taken and released on every CPU_ON.
+	 */
+	mem_guard_register("psci_non_cpu_pd_nodes", psci_non_cpu_pd_nodes,
+			   sizeof(psci_non_cpu_pd_nodes));
+	mem_guard_register("psci_plat_pm_ops", &psci_plat_pm_ops,
+			   sizeof(psci_plat_pm_ops));
+	mem_guard_register("psci_caps", &psci_caps, sizeof(psci_caps));
+
 	return 0;
 }
 
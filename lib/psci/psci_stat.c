@@ -33,9 +33,17 @@ static int last_cpu_in_non_cpu_pd[PSCI_NUM_NON_CPU_PWR_DOMAINS] = {
 /*
  * Following are used to store PSCI STAT values for
  * CPU and non CPU power domains.
+ *
+ * CPU stats are only ever written by their owning CPU and are read without
+ * locks by PSCI_STAT_RESIDENCY/COUNT queries. Each CPU entry sits in its own
+ * cacheline so that lock-free updates on one core do not bounce a line that
+ * another core is updating. Non CPU domain stats are shared and keep relying
+ * on the power domain locks held by the callers.
  */
-static psci_stat_t psci_cpu_stat[PLATFORM_CORE_COUNT]
-				[PLAT_MAX_PWR_LVL_STATES];
+static struct psci_cpu_stat_pcpu {
+	psci_stat_t stat[PLAT_MAX_PWR_LVL_STATES];
+} __aligned(CACHE_WRITEBACK_GRANULE) psci_cpu_stat[PLATFORM_CORE_COUNT];
+
 static psci_stat_t psci_non_cpu_stat[PSCI_NUM_NON_CPU_PWR_DOMAINS]
 				[PLAT_MAX_PWR_LVL_STATES];
 
@@ -102,20 +110,19 @@ void psci_stats_update_pwr_down(unsigned int end_pwrlvl,
 }
 
 /*******************************************************************************
- * This function updates the PSCI STATS(residency time and count) for CPU
- * and NON-CPU power domains.
- * It is called with caches enabled and locks acquired(for NON-CPU domain)
+ * This function updates the PSCI STATS(residency time and count) for the
+ * calling CPU power domain.
+ * The counters are private to this CPU, so no power domain lock is needed:
+ * callers may invoke it after releasing the locks to shorten the serialized
+ * window on the resume path.
  ******************************************************************************/
-void psci_stats_update_pwr_up(unsigned int end_pwrlvl,
-			const psci_power_state_t *state_info)
+void psci_stats_update_pwr_up_cpu(const psci_power_state_t *state_info)
 {
-	unsigned int lvl, parent_idx;
 	int cpu_idx = (int) plat_my_core_pos();
 	int stat_idx;
 	plat_local_state_t local_state;
 	u_register_t residency;
 
-	assert(end_pwrlvl <= PLAT_MAX_PWR_LVL);
 	assert(state_info != NULL);
 
 	/* Get the index into the stats array */
@@ -127,8 +134,27 @@ void psci_stats_update_pwr_up(unsigned int end_pwrlvl,
 	    state_info, cpu_idx);
 
 	/* Update CPU stats. */
-	psci_cpu_stat[cpu_idx][stat_idx].residency += residency;
-	psci_cpu_stat[cpu_idx][stat_idx].count++;
+	psci_cpu_stat[cpu_idx].stat[stat_idx].residency += residency;
+	psci_cpu_stat[cpu_idx].stat[stat_idx].count++;
+}
+
+/*******************************************************************************
+ * This function updates the PSCI STATS(residency time and count) for the
+ * NON-CPU power domains between the CPU level and 'end_pwrlvl'.
+ * It is called with caches enabled and the power domain locks acquired, as
+ * the stats and `last_cpu_in_non_cpu_pd[]` are shared between CPUs.
+ ******************************************************************************/
+void psci_stats_update_pwr_up(unsigned int end_pwrlvl,
+			const psci_power_state_t *state_info)
+{
+	unsigned int lvl, parent_idx;
+	int cpu_idx = (int) plat_my_core_pos();
+	int stat_idx;
+	plat_local_state_t local_state;
+	u_register_t residency;
+
+	assert(end_pwrlvl <= PLAT_MAX_PWR_LVL);
+	assert(state_info != NULL);
 
 	/*
 	 * Check what power domains above CPU were off
@@ -217,7 +243,7 @@ static int psci_get_stat(u_register_t target_cpu, unsigned int power_state,
 		*psci_stat = psci_non_cpu_stat[parent_idx][stat_idx];
 	} else {
 		/* Get the cpu power domain stats */
-		*psci_stat = psci_cpu_stat[target_idx][stat_idx];
+		*psci_stat = psci_cpu_stat[target_idx].stat[stat_idx];
 	}
 
 	return PSCI_E_SUCCESS;
@@ -61,6 +61,11 @@ static void psci_suspend_to_standby_finisher(int cpu_idx,
 	psci_set_pwr_domains_to_run(end_pwrlvl);
 
 	psci_release_pwr_domain_locks(end_pwrlvl, parent_nodes);
+
+#if ENABLE_PSCI_STAT
+	/* The CPU counters are private to this CPU, no lock needed. */
+	psci_stats_update_pwr_up_cpu(&state_info);
+#endif
 }
 
 /*******************************************************************************
@@ -120,11 +125,11 @@ static void psci_suspend_to_pwrdown_start(unsigned int end_pwrlvl,
 #endif
 
 	/*
-	 * Arch. management. Initiate power down sequence.
-	 * TODO : Introduce a mechanism to query the cache level to flush
-	 * and the cpu-ops power down to perform from the platform.
+	 * Arch. management. Initiate power down sequence. The cache levels
+	 * flushed default to the deepest level being powered down, and the
+	 * platform can cap them for states which retain some caches.
 	 */
-	psci_do_pwrdown_sequence(max_off_lvl);
+	psci_do_pwrdown_sequence(psci_find_pwrdown_cache_lvl(state_info));
 
 #if ENABLE_RUNTIME_INSTRUMENTATION
 	PMF_CAPTURE_TIMESTAMP(rt_instr_svc,
@@ -159,6 +164,7 @@ void psci_cpu_suspend_start(const entry_point_info_t *ep,
 	int skip_wfi = 0;
 	int idx = (int) plat_my_core_pos();
 	unsigned int parent_nodes[PLAT_MAX_PWR_LVL] = {0};
+	unsigned int lock_lvl = end_pwrlvl;
 
 	/*
 	 * This function must only be called on platforms where the
@@ -170,6 +176,22 @@ void psci_cpu_suspend_start(const entry_point_info_t *ep,
 	/* Get the parent nodes */
 	psci_get_parent_pwr_domain_nodes(idx, end_pwrlvl, parent_nodes);
 
+#if PSCI_LAZY_PD_LOCKS
+	/*
+	 * Check for a pending wake-up interrupt before any state is
+	 * recorded; with lazy lock acquisition there is no lock contention
+	 * window to sample afterwards.
+	 */
+	if (read_isr_el1() != 0U)
+		return;
+
+	/*
+	 * Coordinate the target state level by level, taking each parent
+	 * lock only while coordination actually reaches that level, so
+	 * independent CPU-level suspends proceed in parallel.
+	 */
+	lock_lvl = psci_do_state_coordination_lazy(end_pwrlvl, state_info);
+#else
 	/*
 	 * This function acquires the lock corresponding to each power
 	 * level so that by the time all locks are taken, the system topology
@@ -193,10 +215,11 @@ void psci_cpu_suspend_start(const entry_point_info_t *ep,
 	 * the end level specified.
 	 */
 	psci_do_state_coordination(end_pwrlvl, state_info);
+#endif
 
 #if ENABLE_PSCI_STAT
-	/* Update the last cpu for each level till end_pwrlvl */
-	psci_stats_update_pwr_down(end_pwrlvl, state_info);
+	/* Update the last cpu for each level entering a low power state */
+	psci_stats_update_pwr_down(lock_lvl, state_info);
 #endif
 
 	if (is_power_down_state != 0U)
@@ -214,12 +237,14 @@ void psci_cpu_suspend_start(const entry_point_info_t *ep,
 	plat_psci_stat_accounting_start(state_info);
 #endif
 
+#if !PSCI_LAZY_PD_LOCKS
 exit:
+#endif
 	/*
 	 * Release the locks corresponding to each power level in the
 	 * reverse order to which they were acquired.
 	 */
-	psci_release_pwr_domain_locks(end_pwrlvl, parent_nodes);
+	psci_release_pwr_domain_locks(lock_lvl, parent_nodes);
 
 	if (skip_wfi == 1)
 		return;
@@ -128,17 +128,72 @@ class IndexPreprocessor(RomlibApplication):
         self.args.add_argument("-o", "--output", help="Output file", metavar="output",
                                default="jmpvar.s")
         self.args.add_argument("--deps", help="Dependency file")
+        self.args.add_argument("--hot-list", help="Function-frequency list for profile-guided "
+                               "ordering of the jump table", metavar="hot_list")
         self.args.add_argument("file", help="Input file")
 
+    @staticmethod
+    def parse_hot_list(file_name):
+        """
+        Parses a function-frequency list: one function name per line, most frequently called
+        first. Anything after the name on a line (e.g. a call count from a profiling dump) is
+        ignored, as are comment and empty lines.
+        """
+        hot_functions = []
+
+        with open(file_name, "r") as hot_list_file:
+            for line in hot_list_file.readlines():
+                line_elements = line.split()
+
+                if line.startswith("#") or not line_elements:
+                    continue
+
+                if line_elements[0] not in hot_functions:
+                    hot_functions.append(line_elements[0])
+
+        return hot_functions
+
+    def reorder_items(self, items):
+        """
+        Reorders the jump table entries so the hottest functions occupy adjacent entries at the
+        top of the table. Functions missing from the hot list keep their relative order after the
+        hot ones, and reserved slots keep their original index so existing holes stay put.
+        """
+        hot_functions = self.parse_hot_list(self.config.hot_list)
+
+        functions = [item for item in items if item["type"] == "function"]
+        table_functions = set(function["function_name"] for function in functions)
+
+        for hot_function in hot_functions:
+            if hot_function not in table_functions:
+                print("romlib_generator.py: warning: hot list function '%s' is not in the "
+                      "jump table" % hot_function, file=sys.stderr)
+
+        def hot_rank(item):
+            if item["function_name"] in hot_functions:
+                return hot_functions.index(item["function_name"])
+            return len(hot_functions)
+
+        # sort() is stable so functions with equal rank keep their original order
+        functions.sort(key=hot_rank)
+
+        function_iterator = iter(functions)
+        return [item if item["type"] == "reserved" else next(function_iterator)
+                for item in items]
+
     def main(self):
         """
         After parsing the input index file it generates a clean output with all includes resolved.
         Using --deps option it also outputs the dependencies in makefile format like gcc's with -M.
+        Using --hot-list option the jump table entries are reordered by call frequency.
         """
 
         index_file_parser = IndexFileParser()
         index_file_parser.parse(self.config.file)
 
+        if self.config.hot_list:
+            index_file_parser.items = self.reorder_items(index_file_parser.items)
+
         with open(self.config.output, "w") as output_file:
             for item in index_file_parser.items:
                 if item["type"] == "function":
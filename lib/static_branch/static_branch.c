@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <assert.h>
+#include <stdint.h>
+
+#include <arch_helpers.h>
+#include <common/debug.h>
+#include <lib/static_branch.h>
+#include <lib/utils_def.h>
+
+/* Site record emitted by static_branch_unlikely() and static_branch_site. */
+struct static_branch_site {
+	uintptr_t site;
+	uintptr_t target;
+	const struct static_key *key;
+	uintptr_t flags;
+};
+
+IMPORT_SYM(uintptr_t, __STATIC_BRANCH_SITES_START__, SITES_START);
+IMPORT_SYM(uintptr_t, __STATIC_BRANCH_SITES_END__, SITES_END);
+
+#if defined(__aarch64__)
+static void patch_site(const struct static_branch_site *s, bool branch)
+{
+	uint32_t insn = U(0xd503201f);		/* nop */
+	int64_t offset = (int64_t)s->target - (int64_t)s->site;
+
+	if (branch) {
+		/* Encode "b target", range +-128MB */
+		assert((offset >= -(1LL << 27)) && (offset < (1LL << 27)));
+		insn = U(0x14000000) |
+		       (uint32_t)(((uint64_t)offset >> 2) & U(0x03ffffff));
+	}
+
+	*(uint32_t *)s->site = insn;
+}
+#else
+static void patch_site_t32(uintptr_t site, uintptr_t target, bool branch)
+{
+	uint16_t hw1 = 0xf3afU;			/* nop.w */
+	uint16_t hw2 = 0x8000U;
+	/* The T32 branch offset is relative to the site PC, site + 4 */
+	int32_t offset = (int32_t)target - (int32_t)site - 4;
+	uint32_t s, i1, i2, j1, j2;
+
+	if (branch) {
+		/* Encode "b.w target" (encoding T4), range +-16MB */
+		assert((offset >= -(1 << 24)) && (offset < (1 << 24)));
+		s = ((uint32_t)offset >> 24) & 1U;
+		i1 = ((uint32_t)offset >> 23) & 1U;
+		i2 = ((uint32_t)offset >> 22) & 1U;
+		j1 = (~i1 & 1U) ^ s;
+		j2 = (~i2 & 1U) ^ s;
+		hw1 = (uint16_t)(0xf000U | (s << 10) |
+				 (((uint32_t)offset >> 12) & 0x3ffU));
+		hw2 = (uint16_t)(0x9000U | (j1 << 13) | (j2 << 11) |
+				 (((uint32_t)offset >> 1) & 0x7ffU));
+	}
+
+	/* T32 sites are only guaranteed halfword aligned */
+	((uint16_t *)site)[0] = hw1;
+	((uint16_t *)site)[1] = hw2;
+}
+
+static void patch_site_a32(uintptr_t site, uintptr_t target, bool branch)
+{
+	uint32_t insn = U(0xe320f000);		/* nop */
+	/* The A32 branch offset is relative to the site PC, site + 8 */
+	int32_t offset = (int32_t)target - (int32_t)site - 8;
+
+	if (branch) {
+		/* Encode "b target", range +-32MB */
+		assert((offset >= -(1 << 25)) && (offset < (1 << 25)));
+		insn = U(0xea000000) |
+		       (((uint32_t)offset >> 2) & U(0x00ffffff));
+	}
+
+	*(uint32_t *)site = insn;
+}
+
+/*
+ * C sites follow the image's instruction set but hand-written assembly
+ * is always assembled in A32 state, so the encoding is a per-site
+ * property rather than a build-wide one.
+ */
+static void patch_site(const struct static_branch_site *s, bool branch)
+{
+	if ((s->flags & STATIC_BRANCH_SITE_T32) != 0U) {
+		patch_site_t32(s->site, s->target, branch);
+	} else {
+		patch_site_a32(s->site, s->target, branch);
+	}
+}
+#endif
+
+/* Make the patched instructions visible to the fetch side */
+static void sync_patched_sites(void)
+{
+	dsbish();
+#if defined(__aarch64__)
+	__asm__ volatile ("ic ialluis" : : : "memory");
+#else
+	/* ICIALLUIS */
+	__asm__ volatile ("mcr p15, 0, %0, c7, c1, 0" : : "r" (0U) : "memory");
+	/* BPIALLIS */
+	__asm__ volatile ("mcr p15, 0, %0, c7, c1, 6" : : "r" (0U) : "memory");
+#endif
+	dsbish();
+	isb();
+}
+
+/*******************************************************************************
+ * Rewrite every recorded branch site according to the final value of its
+ * key. This must run on the primary cpu before any secondary is released,
+ * and while the image's code is still mapped writable.
+ ******************************************************************************/
+void static_branch_apply(void)
+{
+	const struct static_branch_site *site =
+		(const struct static_branch_site *)SITES_START;
+	const struct static_branch_site *end =
+		(const struct static_branch_site *)SITES_END;
+	unsigned int count = 0U;
+
+	for (; site < end; site++) {
+		patch_site(site, site->key->enabled != 0U);
+		clean_dcache_range(site->site, sizeof(uint32_t));
+		count++;
+	}
+
+	if (count == 0U) {
+		return;
+	}
+
+	sync_patched_sites();
+
+	INFO("Patched %u static branch site(s)\n", count);
+}
+
+/*******************************************************************************
+ * Flip a single key at runtime and re-patch its sites. Both the nop and
+ * the branch are single complete instructions, so CPUs concurrently
+ * executing through a site fetch one encoding or the other; the caller
+ * must keep the image's code mapped writable. Toggles of the same key
+ * from several CPUs at once are not supported.
+ ******************************************************************************/
+void static_key_set(struct static_key *key, bool enable)
+{
+	const struct static_branch_site *site =
+		(const struct static_branch_site *)SITES_START;
+	const struct static_branch_site *end =
+		(const struct static_branch_site *)SITES_END;
+	unsigned int count = 0U;
+
+	if ((key->enabled != 0U) == enable) {
+		return;
+	}
+
+	key->enabled = enable ? 1U : 0U;
+
+	for (; site < end; site++) {
+		if (site->key != key) {
+			continue;
+		}
+
+		patch_site(site, enable);
+		clean_dcache_range(site->site, sizeof(uint32_t));
+		count++;
+	}
+
+	if (count != 0U) {
+		sync_patched_sites();
+	}
+}
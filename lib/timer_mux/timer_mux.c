@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <assert.h>
+#include <errno.h>
+
+#include <arch_helpers.h>
+#include <lib/pmf/pmf.h>
+#include <lib/spinlock.h>
+#include <lib/timer_mux.h>
+#include <lib/utils_def.h>
+
+PMF_REGISTER_SERVICE_SMC(timer_mux, PMF_TIMER_MUX_SVC_ID,
+		TIMER_MUX_MAX_EVENTS, PMF_STORE_ENABLE)
+
+/*
+ * Min-heap of pending events, ordered by absolute deadline. Each event
+ * carries its heap position so cancellation is O(log n) without a
+ * search. The lock only covers the heap and the hardware compare;
+ * expiry handlers run unlocked.
+ */
+static struct timer_mux_event *heap[TIMER_MUX_MAX_EVENTS];
+static unsigned int count;
+static unsigned int next_id;
+static spinlock_t timer_mux_lock;
+
+static void heap_swap(unsigned int a, unsigned int b)
+{
+	struct timer_mux_event *tmp = heap[a];
+
+	heap[a] = heap[b];
+	heap[b] = tmp;
+	heap[a]->pos = a;
+	heap[b]->pos = b;
+}
+
+static void heap_sift_up(unsigned int pos)
+{
+	while (pos != 0U) {
+		unsigned int parent = (pos - 1U) / 2U;
+
+		if (heap[parent]->deadline <= heap[pos]->deadline) {
+			break;
+		}
+
+		heap_swap(parent, pos);
+		pos = parent;
+	}
+}
+
+static void heap_sift_down(unsigned int pos)
+{
+	for ( ; ; ) {
+		unsigned int child = (2U * pos) + 1U;
+
+		if (child >= count) {
+			break;
+		}
+
+		if (((child + 1U) < count) &&
+		    (heap[child + 1U]->deadline < heap[child]->deadline)) {
+			child++;
+		}
+
+		if (heap[pos]->deadline <= heap[child]->deadline) {
+			break;
+		}
+
+		heap_swap(pos, child);
+		pos = child;
+	}
+}
+
+static void heap_insert(struct timer_mux_event *ev)
+{
+	assert(count < TIMER_MUX_MAX_EVENTS);
+
+	heap[count] = ev;
+	ev->pos = count;
+	ev->queued = true;
+	count++;
+	heap_sift_up(ev->pos);
+}
+
+static void heap_remove(struct timer_mux_event *ev)
+{
+	unsigned int pos = ev->pos;
+
+	assert(heap[pos] == ev);
+
+	ev->queued = false;
+	count--;
+	if (pos == count) {
+		return;
+	}
+
+	heap[pos] = heap[count];
+	heap[pos]->pos = pos;
+	heap_sift_up(pos);
+	heap_sift_down(pos);
+}
+
+/*
+ * Program the hardware compare with the earliest deadline, or disable
+ * it when nothing is pending. The down-counter is 32 bits: a deadline
+ * further out is clamped, which only costs a spurious interrupt that
+ * finds no expired event and re-arms.
+ */
+static void timer_mux_arm(uint64_t now)
+{
+	uint64_t delta;
+
+	if (count == 0U) {
+		write_cntp_ctl(0U);
+		return;
+	}
+
+	if (heap[0]->deadline > now) {
+		delta = MIN(heap[0]->deadline - now, (uint64_t)INT32_MAX);
+	} else {
+		delta = 1U;
+	}
+
+	write_cntp_tval((uint32_t)delta);
+	write_cntp_ctl(BIT(0));
+}
+
+/*
+ * Queue an event delay_ticks from now. An already queued event is moved
+ * to the new deadline. The event id used for the PMF expiry stamps is
+ * assigned on the first start and kept for the lifetime of the event.
+ */
+int timer_mux_start(struct timer_mux_event *ev, uint64_t delay_ticks)
+{
+	assert(ev->handler != NULL);
+
+	spin_lock(&timer_mux_lock);
+
+	if (!ev->queued && (ev->id == 0U)) {
+		if (next_id == TIMER_MUX_MAX_EVENTS) {
+			spin_unlock(&timer_mux_lock);
+			return -ENOMEM;
+		}
+		next_id++;
+		ev->id = next_id;
+	}
+
+	if (ev->queued) {
+		heap_remove(ev);
+	}
+
+	ev->deadline = read64_cntpct() + delay_ticks;
+	heap_insert(ev);
+	timer_mux_arm(read64_cntpct());
+
+	spin_unlock(&timer_mux_lock);
+
+	return 0;
+}
+
+void timer_mux_cancel(struct timer_mux_event *ev)
+{
+	spin_lock(&timer_mux_lock);
+
+	if (ev->queued) {
+		heap_remove(ev);
+		timer_mux_arm(read64_cntpct());
+	}
+
+	spin_unlock(&timer_mux_lock);
+}
+
+void timer_mux_it_handler(void)
+{
+	spin_lock(&timer_mux_lock);
+
+	for ( ; ; ) {
+		struct timer_mux_event *ev;
+		uint64_t now = read64_cntpct();
+
+		if ((count == 0U) || (heap[0]->deadline > now)) {
+			timer_mux_arm(now);
+			break;
+		}
+
+		ev = heap[0];
+		heap_remove(ev);
+		if (ev->period != 0U) {
+			ev->deadline += ev->period;
+			heap_insert(ev);
+		}
+
+		/*
+		 * Run the handler unlocked so it can start or cancel
+		 * events. The expiry stamp is taken right before it runs.
+		 */
+		spin_unlock(&timer_mux_lock);
+		PMF_CAPTURE_TIMESTAMP(timer_mux, ev->id - 1U,
+				      PMF_NO_CACHE_MAINT);
+		ev->handler(ev);
+		spin_lock(&timer_mux_lock);
+	}
+
+	spin_unlock(&timer_mux_lock);
+}
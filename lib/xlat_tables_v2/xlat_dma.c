@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <assert.h>
+#include <stdbool.h>
+
+#include <platform_def.h>
+
+#include <arch_helpers.h>
+#include <lib/utils_def.h>
+#include <lib/xlat_tables/xlat_dma.h>
+#include <lib/xlat_tables/xlat_tables_v2.h>
+
+/*
+ * A pure invalidate is only safe when no line of the buffer is shared
+ * with unrelated data, i.e. when the buffer covers whole writeback
+ * granules. Otherwise the dirty head and tail of the edge lines must be
+ * written back before the lines are discarded.
+ */
+static bool granule_aligned(uintptr_t base, size_t size)
+{
+	return (((base | size) & (CACHE_WRITEBACK_GRANULE - 1U)) == 0U);
+}
+
+void xlat_dma_prepare(uintptr_t base, size_t size, enum xlat_dma_dir dir)
+{
+	assert(size != 0U);
+
+	switch (dir) {
+	case XLAT_DMA_TO_DEVICE:
+		clean_dcache_range(base, size);
+		break;
+	case XLAT_DMA_FROM_DEVICE:
+		if (granule_aligned(base, size)) {
+			inv_dcache_range(base, size);
+		} else {
+			flush_dcache_range(base, size);
+		}
+		break;
+	case XLAT_DMA_BIDIRECTIONAL:
+	default:
+		flush_dcache_range(base, size);
+		break;
+	}
+}
+
+void xlat_dma_complete(uintptr_t base, size_t size, enum xlat_dma_dir dir)
+{
+	assert(size != 0U);
+
+	if (dir != XLAT_DMA_TO_DEVICE) {
+		/*
+		 * Discard lines speculatively refilled while the device
+		 * owned the buffer. xlat_dma_prepare() wrote any dirty
+		 * edge lines back, so nothing of value is lost here.
+		 */
+		inv_dcache_range(base, size);
+	}
+}
+
+int xlat_dma_mark_coherent(uintptr_t base, size_t size)
+{
+	uint32_t attr;
+	int ret;
+
+	ret = xlat_get_mem_attributes(base, &attr);
+	if (ret != 0) {
+		return ret;
+	}
+
+	/* Push the last cacheable contents out before the switch */
+	flush_dcache_range(base, size);
+
+	attr &= ~MT_TYPE_MASK;
+	attr |= MT_NON_CACHEABLE;
+
+	return xlat_change_mem_attributes(base, size, attr);
+}
@@ -7,9 +7,30 @@
 XLAT_TABLES_LIB_SRCS	:=	$(addprefix lib/xlat_tables_v2/,	\
 				${ARCH}/enable_mmu.S			\
 				${ARCH}/xlat_tables_arch.c		\
+				xlat_dma.c				\
 				xlat_tables_context.c			\
 				xlat_tables_core.c			\
 				xlat_tables_utils.c)
 
 XLAT_TABLES_LIB_V2	:=	1
 $(eval $(call add_define,XLAT_TABLES_LIB_V2))
+
+# When every translation context in the image covers PLAT_VIRT_ADDR_SPACE_SIZE
+# of virtual address space, the initial lookup level and the table walk depth
+# are build time constants and the compiler can specialize the table walk.
+XLAT_TABLES_STATIC_LEVELS	?=	0
+$(eval $(call assert_boolean,XLAT_TABLES_STATIC_LEVELS))
+$(eval $(call add_define,XLAT_TABLES_STATIC_LEVELS))
+
+# Carve translation table pages from a single shared pool, bounded by a per
+# context quota, instead of reserving a worst-case sized private array for
+# every context at build time. With dynamic mapping enabled, the pages of
+# fully unmapped sub-tables are returned to the pool. The pool holds
+# PLAT_XLAT_TABLES_POOL_SIZE pages (MAX_XLAT_TABLES if undefined).
+XLAT_TABLES_POOL		?=	0
+$(eval $(call assert_boolean,XLAT_TABLES_POOL))
+$(eval $(call add_define,XLAT_TABLES_POOL))
+
+ifeq (${XLAT_TABLES_POOL},1)
+XLAT_TABLES_LIB_SRCS	+=	lib/xlat_tables_v2/xlat_tables_pool.c
+endif
@@ -36,6 +36,36 @@ static inline __attribute__((unused)) void xlat_clean_dcache_range(uintptr_t add
  * handling for it.
  */
 
+#if XLAT_TABLES_POOL
+
+/* Returns a pointer to an empty translation table. */
+static uint64_t *xlat_table_get_empty(xlat_ctx_t *ctx)
+{
+	return xlat_table_pool_alloc(ctx);
+}
+
+/* Increments region count for a given table. */
+static void xlat_table_inc_regions_count(const xlat_ctx_t *ctx,
+					 const uint64_t *table)
+{
+	(*xlat_table_pool_regions_count(table))++;
+}
+
+/* Decrements region count for a given table. */
+static void xlat_table_dec_regions_count(const xlat_ctx_t *ctx,
+					 const uint64_t *table)
+{
+	(*xlat_table_pool_regions_count(table))--;
+}
+
+/* Returns 0 if the specified table isn't empty, otherwise 1. */
+static bool xlat_table_is_empty(const xlat_ctx_t *ctx, const uint64_t *table)
+{
+	return *xlat_table_pool_regions_count(table) == 0;
+}
+
+#else /* XLAT_TABLES_POOL */
+
 /*
  * Returns the index of the array corresponding to the specified translation
  * table.
@@ -89,8 +119,20 @@ static bool xlat_table_is_empty(const xlat_ctx_t *ctx, const uint64_t *table)
 	return ctx->tables_mapped_regions[xlat_table_get_index(ctx, table)] == 0;
 }
 
+#endif /* XLAT_TABLES_POOL */
+
 #else /* PLAT_XLAT_TABLES_DYNAMIC */
 
+#if XLAT_TABLES_POOL
+
+/* Returns a pointer to an empty translation table. */
+static uint64_t *xlat_table_get_empty(xlat_ctx_t *ctx)
+{
+	return xlat_table_pool_alloc(ctx);
+}
+
+#else /* XLAT_TABLES_POOL */
+
 /* Returns a pointer to the first empty translation table. */
 static uint64_t *xlat_table_get_empty(xlat_ctx_t *ctx)
 {
@@ -99,6 +141,8 @@ static uint64_t *xlat_table_get_empty(xlat_ctx_t *ctx)
 	return ctx->tables[ctx->next_table++];
 }
 
+#endif /* XLAT_TABLES_POOL */
+
 #endif /* PLAT_XLAT_TABLES_DYNAMIC */
 
 /*
@@ -348,7 +392,8 @@ static void xlat_tables_unmap_region(xlat_ctx_t *ctx, mmap_region_t *mm,
 				     const unsigned int table_entries,
 				     const unsigned int level)
 {
-	assert((level >= ctx->base_level) && (level <= XLAT_TABLE_LEVEL_MAX));
+	assert((level >= ctx_base_level(ctx)) &&
+	       (level <= XLAT_TABLE_LEVEL_MAX));
 
 	uint64_t *subtable;
 	uint64_t desc;
@@ -398,6 +443,9 @@ static void xlat_tables_unmap_region(xlat_ctx_t *ctx, mmap_region_t *mm,
 				table_base[table_idx] = INVALID_DESC;
 				xlat_arch_tlbi_va(table_idx_va,
 						  ctx->xlat_regime);
+#if XLAT_TABLES_POOL
+				xlat_table_pool_release(ctx, subtable);
+#endif
 			}
 
 		} else {
@@ -412,7 +460,7 @@ static void xlat_tables_unmap_region(xlat_ctx_t *ctx, mmap_region_t *mm,
 			break;
 	}
 
-	if (level > ctx->base_level)
+	if (level > ctx_base_level(ctx))
 		xlat_table_dec_regions_count(ctx, table_base);
 }
 
@@ -561,7 +609,8 @@ static uintptr_t xlat_tables_map_region(xlat_ctx_t *ctx, mmap_region_t *mm,
 				   unsigned int table_entries,
 				   unsigned int level)
 {
-	assert((level >= ctx->base_level) && (level <= XLAT_TABLE_LEVEL_MAX));
+	assert((level >= ctx_base_level(ctx)) &&
+	       (level <= XLAT_TABLE_LEVEL_MAX));
 
 	uintptr_t mm_end_va = mm->base_va + mm->size - 1U;
 
@@ -577,7 +626,7 @@ static uintptr_t xlat_tables_map_region(xlat_ctx_t *ctx, mmap_region_t *mm,
 	table_idx = xlat_tables_va_to_index(table_base_va, table_idx_va, level);
 
 #if PLAT_XLAT_TABLES_DYNAMIC
-	if (level > ctx->base_level)
+	if (level > ctx_base_level(ctx))
 		xlat_table_inc_regions_count(ctx, table_base);
 #endif
 
@@ -758,13 +807,39 @@ static int mmap_add_region_check(const xlat_ctx_t *ctx, const mmap_region_t *mm)
 	return 0;
 }
 
+/*
+ * Function that finds, by binary search, the position that keeps the mmap
+ * array sorted as described in mmap_add_region_ctx(): ascending end VA
+ * first, and ascending size among regions with the same end VA. Returns the
+ * index at which the given region must be inserted.
+ */
+static int mmap_find_insert_idx(const xlat_ctx_t *ctx, const mmap_region_t *mm)
+{
+	const mmap_region_t *mmap = ctx->mmap;
+	uintptr_t end_va = mm->base_va + mm->size - 1U;
+	int lo = 0;
+	int hi = ctx->mmap_count;
+
+	while (lo < hi) {
+		int mid = (lo + hi) / 2;
+		uintptr_t mid_end_va = mmap[mid].base_va + mmap[mid].size - 1U;
+
+		if ((mid_end_va < end_va) ||
+		    ((mid_end_va == end_va) && (mmap[mid].size < mm->size)))
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	return lo;
+}
+
 void mmap_add_region_ctx(xlat_ctx_t *ctx, const mmap_region_t *mm)
 {
-	mmap_region_t *mm_cursor = ctx->mmap, *mm_destination;
-	const mmap_region_t *mm_end = ctx->mmap + ctx->mmap_num;
-	const mmap_region_t *mm_last;
+	mmap_region_t *mm_cursor;
 	unsigned long long end_pa = mm->base_pa + mm->size - 1U;
 	uintptr_t end_va = mm->base_va + mm->size - 1U;
+	int idx;
 	int ret;
 
 	/* Ignore empty regions */
@@ -805,44 +880,22 @@ void mmap_add_region_ctx(xlat_ctx_t *ctx, const mmap_region_t *mm)
 	 * Overlapping is only allowed for static regions.
 	 */
 
-	while (((mm_cursor->base_va + mm_cursor->size - 1U) < end_va)
-	       && (mm_cursor->size != 0U)) {
-		++mm_cursor;
-	}
-
-	while (((mm_cursor->base_va + mm_cursor->size - 1U) == end_va) &&
-	       (mm_cursor->size != 0U) && (mm_cursor->size < mm->size)) {
-		++mm_cursor;
-	}
-
-	/*
-	 * Find the last entry marker in the mmap
-	 */
-	mm_last = ctx->mmap;
-	while ((mm_last->size != 0U) && (mm_last < mm_end)) {
-		++mm_last;
-	}
-
-	/*
-	 * Check if we have enough space in the memory mapping table.
-	 * This shouldn't happen as we have checked in mmap_add_region_check
-	 * that there is free space.
-	 */
-	assert(mm_last->size == 0U);
+	idx = mmap_find_insert_idx(ctx, mm);
+	mm_cursor = ctx->mmap + idx;
 
 	/* Make room for new region by moving other regions up by one place */
-	mm_destination = mm_cursor + 1;
-	(void)memmove(mm_destination, mm_cursor,
-		(uintptr_t)mm_last - (uintptr_t)mm_cursor);
+	(void)memmove(mm_cursor + 1, mm_cursor,
+		      sizeof(mmap_region_t) * (size_t)(ctx->mmap_count - idx));
 
 	/*
 	 * Check we haven't lost the empty sentinel from the end of the array.
 	 * This shouldn't happen as we have checked in mmap_add_region_check
 	 * that there is free space.
 	 */
-	assert(mm_end->size == 0U);
+	assert(ctx->mmap[ctx->mmap_num].size == 0U);
 
 	*mm_cursor = *mm;
+	ctx->mmap_count++;
 
 	if (end_pa > ctx->max_pa)
 		ctx->max_pa = end_pa;
@@ -900,7 +953,7 @@ static void mmap_alloc_va_align_ctx(xlat_ctx_t *ctx, mmap_region_t *mm)
 	 * the addresses and size are aligned to PAGE_SIZE are inside
 	 * mmap_add_region.
 	 */
-	for (unsigned int level = ctx->base_level; level <= 2U; ++level) {
+	for (unsigned int level = ctx_base_level(ctx); level <= 2U; ++level) {
 
 		if ((align_check & XLAT_BLOCK_MASK(level)) != 0U)
 			continue;
@@ -936,12 +989,159 @@ void mmap_add_ctx(xlat_ctx_t *ctx, const mmap_region_t *mm)
 
 #if PLAT_XLAT_TABLES_DYNAMIC
 
+/*
+ * State of a walk from the base table down to the deepest existing table
+ * that fully covers a region: the entry followed at each level, and the
+ * table where the walk stopped. Mapping or unmapping the region can start
+ * directly from the latter, as a walk from the base table would reach it
+ * without modifying any of the intermediate levels.
+ */
+typedef struct xlat_walk_step {
+	uint64_t *table;
+	unsigned int idx;
+	uintptr_t idx_va;
+} xlat_walk_step_t;
+
+typedef struct xlat_region_walk {
+	/* Table where the walk stopped and the VA of its first entry. */
+	uint64_t *table;
+	uintptr_t table_base_va;
+	unsigned int entries;
+	unsigned int level;
+	/* Entry followed at each level above the final table. */
+	xlat_walk_step_t path[XLAT_TABLE_LEVEL_MAX];
+	unsigned int depth;
+} xlat_region_walk_t;
+
+/*
+ * Cache of the last walk done for a dynamic region. The MAP/UNMAP pairs that
+ * the image loading framework issues land in the same few subtables, so the
+ * next walk commonly only has to continue from where the last one stopped.
+ * It is dropped on unmap, as that is the only operation that can release a
+ * translation table.
+ */
+static struct {
+	const xlat_ctx_t *ctx;
+	xlat_region_walk_t walk;
+	bool valid;
+} xlat_last_walk;
+
+static void xlat_region_walk_start(const xlat_ctx_t *ctx,
+				   const mmap_region_t *mm,
+				   xlat_region_walk_t *walk)
+{
+	uintptr_t end_va = mm->base_va + mm->size - 1U;
+
+	if (xlat_last_walk.valid && (xlat_last_walk.ctx == ctx) &&
+	    (mm->base_va >= xlat_last_walk.walk.table_base_va) &&
+	    (end_va <= (xlat_last_walk.walk.table_base_va +
+			(XLAT_BLOCK_SIZE(xlat_last_walk.walk.level) *
+			 xlat_last_walk.walk.entries) - 1U))) {
+		*walk = xlat_last_walk.walk;
+	} else {
+		walk->table = ctx->base_table;
+		walk->table_base_va = 0U;
+		walk->entries = ctx_base_table_entries(ctx);
+		walk->level = ctx_base_level(ctx);
+		walk->depth = 0U;
+	}
+
+	/*
+	 * Descend as long as the whole region falls within a single entry
+	 * that holds a table descriptor. Level 3 cannot be descended into:
+	 * its page descriptors carry the same type bits as table descriptors.
+	 */
+	while (walk->level < XLAT_TABLE_LEVEL_MAX) {
+		unsigned int idx = xlat_tables_va_to_index(walk->table_base_va,
+						mm->base_va, walk->level);
+		uint64_t desc;
+
+		if (idx != xlat_tables_va_to_index(walk->table_base_va, end_va,
+						   walk->level))
+			break;
+
+		desc = walk->table[idx];
+		if ((desc & DESC_MASK) != TABLE_DESC)
+			break;
+
+		walk->path[walk->depth].table = walk->table;
+		walk->path[walk->depth].idx = idx;
+		walk->path[walk->depth].idx_va = walk->table_base_va +
+			((uintptr_t)idx << XLAT_ADDR_SHIFT(walk->level));
+		walk->depth++;
+
+		walk->table_base_va = walk->path[walk->depth - 1U].idx_va;
+		walk->table = (uint64_t *)(uintptr_t)(desc & TABLE_ADDR_MASK);
+		walk->entries = XLAT_TABLE_ENTRIES;
+		walk->level++;
+	}
+
+	xlat_last_walk.ctx = ctx;
+	xlat_last_walk.walk = *walk;
+	xlat_last_walk.valid = true;
+}
+
+/*
+ * Account the region into the tables that the walk descended through. The
+ * table that the walk stopped at is not included: xlat_tables_map_region()
+ * and xlat_tables_unmap_region() already count the tables they visit. The
+ * base table isn't tracked, see struct xlat_ctx.
+ */
+static void xlat_region_walk_inc_regions(const xlat_ctx_t *ctx,
+					 const xlat_region_walk_t *walk)
+{
+	for (unsigned int i = 1U; i < walk->depth; i++)
+		xlat_table_inc_regions_count(ctx, walk->path[i].table);
+}
+
+/*
+ * Unmap a region starting from the table that its walk stopped at, then
+ * propagate the result up the walk path: release the reference that the
+ * region held on each intermediate table and unlink any table left empty,
+ * exactly as xlat_tables_unmap_region() would have done had it descended
+ * from the base table.
+ */
+static void xlat_tables_unmap_region_walk(xlat_ctx_t *ctx, mmap_region_t *mm,
+					  const xlat_region_walk_t *walk)
+{
+	const uint64_t *child = walk->table;
+
+	xlat_tables_unmap_region(ctx, mm, walk->table_base_va, walk->table,
+				 walk->entries, walk->level);
+#if !(HW_ASSISTED_COHERENCY || WARMBOOT_ENABLE_DCACHE_EARLY)
+	xlat_clean_dcache_range((uintptr_t)walk->table,
+				walk->entries * sizeof(uint64_t));
+#endif
+
+	for (unsigned int i = walk->depth; i > 0U; i--) {
+		const xlat_walk_step_t *step = &walk->path[i - 1U];
+
+		if (xlat_table_is_empty(ctx, child)) {
+			step->table[step->idx] = INVALID_DESC;
+			xlat_arch_tlbi_va(step->idx_va, ctx->xlat_regime);
+#if !(HW_ASSISTED_COHERENCY || WARMBOOT_ENABLE_DCACHE_EARLY)
+			xlat_clean_dcache_range(
+				(uintptr_t)&step->table[step->idx],
+				sizeof(uint64_t));
+#endif
+#if XLAT_TABLES_POOL
+			xlat_table_pool_release(ctx, child);
+#endif
+		}
+
+		if ((i - 1U) > 0U)
+			xlat_table_dec_regions_count(ctx, step->table);
+
+		child = step->table;
+	}
+}
+
 int mmap_add_dynamic_region_ctx(xlat_ctx_t *ctx, mmap_region_t *mm)
 {
-	mmap_region_t *mm_cursor = ctx->mmap;
-	const mmap_region_t *mm_last = mm_cursor + ctx->mmap_num;
+	mmap_region_t *mm_cursor;
 	unsigned long long end_pa = mm->base_pa + mm->size - 1U;
 	uintptr_t end_va = mm->base_va + mm->size - 1U;
+	int idx;
 	int ret;
 
 	/* Nothing to do */
@@ -959,46 +1159,46 @@ int mmap_add_dynamic_region_ctx(xlat_ctx_t *ctx, mmap_region_t *mm)
 	 * Find the adequate entry in the mmap array in the same way done for
 	 * static regions in mmap_add_region_ctx().
 	 */
-
-	while (((mm_cursor->base_va + mm_cursor->size - 1U) < end_va)
-	       && (mm_cursor->size != 0U)) {
-		++mm_cursor;
-	}
-
-	while (((mm_cursor->base_va + mm_cursor->size - 1U) == end_va) &&
-	       (mm_cursor->size != 0U) && (mm_cursor->size < mm->size)) {
-		++mm_cursor;
-	}
+	idx = mmap_find_insert_idx(ctx, mm);
+	mm_cursor = ctx->mmap + idx;
 
 	/* Make room for new region by moving other regions up by one place */
 	(void)memmove(mm_cursor + 1U, mm_cursor,
-		     (uintptr_t)mm_last - (uintptr_t)mm_cursor);
+		      sizeof(mmap_region_t) * (size_t)(ctx->mmap_count - idx));
 
 	/*
 	 * Check we haven't lost the empty sentinal from the end of the array.
 	 * This shouldn't happen as we have checked in mmap_add_region_check
 	 * that there is free space.
 	 */
-	assert(mm_last->size == 0U);
+	assert(ctx->mmap[ctx->mmap_num].size == 0U);
 
 	*mm_cursor = *mm;
+	ctx->mmap_count++;
 
 	/*
 	 * Update the translation tables if the xlat tables are initialized. If
 	 * not, this region will be mapped when they are initialized.
 	 */
 	if (ctx->initialized) {
+		xlat_region_walk_t walk;
+
+		xlat_region_walk_start(ctx, mm_cursor, &walk);
+		xlat_region_walk_inc_regions(ctx, &walk);
+
 		end_va = xlat_tables_map_region(ctx, mm_cursor,
-				0U, ctx->base_table, ctx->base_table_entries,
-				ctx->base_level);
+				walk.table_base_va, walk.table, walk.entries,
+				walk.level);
 #if !(HW_ASSISTED_COHERENCY || WARMBOOT_ENABLE_DCACHE_EARLY)
-		xlat_clean_dcache_range((uintptr_t)ctx->base_table,
-				   ctx->base_table_entries * sizeof(uint64_t));
+		xlat_clean_dcache_range((uintptr_t)walk.table,
+				   walk.entries * sizeof(uint64_t));
 #endif
 		/* Failed to map, remove mmap entry, unmap and return error. */
 		if (end_va != (mm_cursor->base_va + mm_cursor->size - 1U)) {
 			(void)memmove(mm_cursor, mm_cursor + 1U,
-				(uintptr_t)mm_last - (uintptr_t)mm_cursor);
+				      sizeof(mmap_region_t) *
+				      (size_t)(ctx->mmap_count - idx));
+			ctx->mmap_count--;
 
 			/*
 			 * Check if the mapping function actually managed to map
@@ -1017,13 +1217,10 @@ int mmap_add_dynamic_region_ctx(xlat_ctx_t *ctx, mmap_region_t *mm)
 					.size = end_va - mm->base_va,
 					.attr = 0U
 			};
-			xlat_tables_unmap_region(ctx, &unmap_mm, 0U,
-				ctx->base_table, ctx->base_table_entries,
-				ctx->base_level);
-#if !(HW_ASSISTED_COHERENCY || WARMBOOT_ENABLE_DCACHE_EARLY)
-			xlat_clean_dcache_range((uintptr_t)ctx->base_table,
-				ctx->base_table_entries * sizeof(uint64_t));
-#endif
+			xlat_region_walk_start(ctx, &unmap_mm, &walk);
+			xlat_tables_unmap_region_walk(ctx, &unmap_mm, &walk);
+			/* The unmap may have released tables. */
+			xlat_last_walk.valid = false;
 			return -ENOMEM;
 		}
 
@@ -1073,22 +1270,25 @@ int mmap_add_dynamic_region_alloc_va_ctx(xlat_ctx_t *ctx, mmap_region_t *mm)
 int mmap_remove_dynamic_region_ctx(xlat_ctx_t *ctx, uintptr_t base_va,
 				   size_t size)
 {
-	mmap_region_t *mm = ctx->mmap;
-	const mmap_region_t *mm_last = mm + ctx->mmap_num;
+	mmap_region_t key = { .base_va = base_va, .size = size };
+	mmap_region_t *mm;
 	int update_max_va_needed = 0;
 	int update_max_pa_needed = 0;
+	int idx;
 
 	/* Check sanity of mmap array. */
-	assert(mm[ctx->mmap_num].size == 0U);
+	assert(ctx->mmap[ctx->mmap_num].size == 0U);
 
-	while (mm->size != 0U) {
-		if ((mm->base_va == base_va) && (mm->size == size))
-			break;
-		++mm;
-	}
+	/*
+	 * The mmap array is sorted by ascending end VA and size, so a region
+	 * with the given base VA and size can only live at one index.
+	 */
+	idx = mmap_find_insert_idx(ctx, &key);
+	mm = ctx->mmap + idx;
 
 	/* Check that the region was found */
-	if (mm->size == 0U)
+	if ((idx >= ctx->mmap_count) || (mm->base_va != base_va) ||
+	    (mm->size != size))
 		return -EINVAL;
 
 	/* If the region is static it can't be removed */
@@ -1103,18 +1303,19 @@ int mmap_remove_dynamic_region_ctx(xlat_ctx_t *ctx, uintptr_t base_va,
 
 	/* Update the translation tables if needed */
 	if (ctx->initialized) {
-		xlat_tables_unmap_region(ctx, mm, 0U, ctx->base_table,
-					 ctx->base_table_entries,
-					 ctx->base_level);
-#if !(HW_ASSISTED_COHERENCY || WARMBOOT_ENABLE_DCACHE_EARLY)
-		xlat_clean_dcache_range((uintptr_t)ctx->base_table,
-			ctx->base_table_entries * sizeof(uint64_t));
-#endif
+		xlat_region_walk_t walk;
+
+		xlat_region_walk_start(ctx, mm, &walk);
+		xlat_tables_unmap_region_walk(ctx, mm, &walk);
+		/* The unmap may have released tables. */
+		xlat_last_walk.valid = false;
 		xlat_arch_tlbi_va_sync();
 	}
 
 	/* Remove this region by moving the rest down by one place. */
-	(void)memmove(mm, mm + 1U, (uintptr_t)mm_last - (uintptr_t)mm);
+	(void)memmove(mm, mm + 1U,
+		      sizeof(mmap_region_t) * (size_t)(ctx->mmap_count - idx));
+	ctx->mmap_count--;
 
 	/* Check if we need to update the max VAs and PAs */
 	if (update_max_va_needed == 1) {
@@ -1157,6 +1358,9 @@ void xlat_setup_dynamic_ctx(xlat_ctx_t *ctx, unsigned long long pa_max,
 
 	ctx->tables = (void *) tables;
 	ctx->tables_num = tables_num;
+#if XLAT_TABLES_POOL
+	ctx->tables_used = 0;
+#endif
 
 	uintptr_t va_space_size = va_max + 1;
 	ctx->base_level = GET_XLAT_TABLE_LEVEL_BASE(va_space_size);
@@ -1188,6 +1392,15 @@ void __init init_xlat_tables_ctx(xlat_ctx_t *ctx)
 	assert(ctx->va_max_address <= (MAX_VIRT_ADDR_SPACE_SIZE - 1U));
 	assert(IS_POWER_OF_TWO(ctx->va_max_address + 1U));
 
+#if XLAT_TABLES_STATIC_LEVELS
+	/*
+	 * The specialized walk relies on every context covering
+	 * PLAT_VIRT_ADDR_SPACE_SIZE of virtual address space.
+	 */
+	assert(ctx->base_level == ctx_base_level(ctx));
+	assert(ctx->base_table_entries == ctx_base_table_entries(ctx));
+#endif
+
 	xlat_mmap_print(mm);
 
 	/* All tables must be zeroed before mapping any region. */
@@ -1197,9 +1410,10 @@ void __init init_xlat_tables_ctx(xlat_ctx_t *ctx)
 #ifdef PLAT_XLAT_BASE
 	inv_dcache_range(PLAT_XLAT_BASE, PLAT_XLAT_SIZE);
 #endif
-	for (unsigned int i = 0U; i < ctx->base_table_entries; i++)
+	for (unsigned int i = 0U; i < ctx_base_table_entries(ctx); i++)
 		ctx->base_table[i] = INVALID_DESC;
 
+#if !XLAT_TABLES_POOL
 	for (int j = 0; j < ctx->tables_num; j++) {
 #if PLAT_XLAT_TABLES_DYNAMIC
 		ctx->tables_mapped_regions[j] = 0;
@@ -1207,14 +1421,15 @@ void __init init_xlat_tables_ctx(xlat_ctx_t *ctx)
 		for (unsigned int i = 0U; i < XLAT_TABLE_ENTRIES; i++)
 			ctx->tables[j][i] = INVALID_DESC;
 	}
+#endif
 
 	while (mm->size != 0U) {
 		uintptr_t end_va = xlat_tables_map_region(ctx, mm, 0U,
-				ctx->base_table, ctx->base_table_entries,
-				ctx->base_level);
+				ctx->base_table, ctx_base_table_entries(ctx),
+				ctx_base_level(ctx));
 #if !(HW_ASSISTED_COHERENCY || WARMBOOT_ENABLE_DCACHE_EARLY)
 		xlat_clean_dcache_range((uintptr_t)ctx->base_table,
-				   ctx->base_table_entries * sizeof(uint64_t));
+				ctx_base_table_entries(ctx) * sizeof(uint64_t));
 #endif
 		if (end_va != (mm->base_va + mm->size - 1U)) {
 			ERROR("Not enough memory to map region:\n"
@@ -1234,3 +1449,207 @@ void __init init_xlat_tables_ctx(xlat_ctx_t *ctx)
 
 	xlat_tables_print(ctx);
 }
+
+/*
+ * Block mapping promotion pass.
+ *
+ * Images are mapped with fine-grained permissions, so by the time an
+ * address space is final it often contains last-level tables whose
+ * entries are uniform: same attributes, physically contiguous output
+ * addresses. Each of those tables costs a TLB entry per page it maps.
+ * The promotion pass folds such tables into a single block descriptor in
+ * the parent table, recovering the reach of the CPU's block TLB entries
+ * for the runtime firmware.
+ *
+ * The pass is meant to run once, after the last mmap update and before
+ * the address space enters service. It is safe with the MMU enabled: the
+ * replacement follows the break-before-make sequence, and a folded block
+ * translates exactly as the pages it replaces did.
+ */
+
+/*
+ * Check whether 'table', a table at 'child_level' reached from a parent
+ * entry, maps one uniform, physically contiguous, correctly aligned run.
+ * On success *block_desc holds the descriptor that can replace the
+ * parent's table descriptor.
+ */
+static bool xlat_table_can_fold(const uint64_t *table,
+				unsigned int child_level,
+				uint64_t *block_desc)
+{
+	uint64_t expected_type = (child_level == XLAT_TABLE_LEVEL_MAX) ?
+				 PAGE_DESC : BLOCK_DESC;
+	unsigned long long step = XLAT_BLOCK_SIZE(child_level);
+	unsigned long long base_pa;
+	uint64_t attrs;
+
+	if ((table[0] & DESC_MASK) != expected_type)
+		return false;
+
+	base_pa = table[0] & TABLE_ADDR_MASK;
+	attrs = table[0] & ~TABLE_ADDR_MASK;
+
+	/* The fold output must be aligned to the parent block size. */
+	if ((base_pa & XLAT_BLOCK_MASK(child_level - 1U)) != 0ULL)
+		return false;
+
+	for (unsigned int i = 1U; i < XLAT_TABLE_ENTRIES; i++) {
+		uint64_t desc = table[i];
+
+		if ((desc & ~TABLE_ADDR_MASK) != attrs)
+			return false;
+		if ((desc & TABLE_ADDR_MASK) !=
+		    (base_pa + ((unsigned long long)i * step)))
+			return false;
+	}
+
+	*block_desc = (attrs & ~DESC_MASK) | BLOCK_DESC | base_pa;
+
+	return true;
+}
+
+#if PLAT_XLAT_TABLES_DYNAMIC
+/*
+ * A block must not absorb pages belonging to a dynamic region: removing
+ * that region later would have to split the block again, which the unmap
+ * path does not do.
+ */
+static bool xlat_va_range_has_dynamic_region(const xlat_ctx_t *ctx,
+					     uintptr_t va, size_t size)
+{
+	const mmap_region_t *mm = ctx->mmap;
+	uintptr_t end_va = va + size - 1U;
+
+	while (mm->size != 0U) {
+		if (((mm->attr & MT_DYNAMIC) != 0U) &&
+		    (mm->base_va <= end_va) &&
+		    ((mm->base_va + mm->size - 1U) >= va))
+			return true;
+		mm++;
+	}
+
+	return false;
+}
+#endif /* PLAT_XLAT_TABLES_DYNAMIC */
+
+/* Return a folded-out table to the allocator, where one exists. */
+static void xlat_table_fold_release(xlat_ctx_t *ctx, uint64_t *table)
+{
+#if PLAT_XLAT_TABLES_DYNAMIC
+	for (unsigned int i = 0U; i < XLAT_TABLE_ENTRIES; i++)
+		table[i] = INVALID_DESC;
+#if !(HW_ASSISTED_COHERENCY || WARMBOOT_ENABLE_DCACHE_EARLY)
+	xlat_clean_dcache_range((uintptr_t)table,
+				XLAT_TABLE_ENTRIES * sizeof(uint64_t));
+#endif
+
+#if XLAT_TABLES_POOL
+	*xlat_table_pool_regions_count(table) = 0;
+	xlat_table_pool_release(ctx, table);
+#else
+	ctx->tables_mapped_regions[xlat_table_get_index(ctx, table)] = 0;
+#endif
+#else /* PLAT_XLAT_TABLES_DYNAMIC */
+	/*
+	 * Without dynamic region support tables are handed out
+	 * monotonically and cannot be recycled; the orphaned table page
+	 * stays allocated.
+	 */
+	(void)ctx;
+	(void)table;
+#endif /* PLAT_XLAT_TABLES_DYNAMIC */
+}
+
+static unsigned int xlat_tables_promote_table(xlat_ctx_t *ctx,
+					      uint64_t *table,
+					      unsigned int entries,
+					      unsigned int level,
+					      uintptr_t table_base_va)
+{
+	unsigned int promoted = 0U;
+
+	for (unsigned int i = 0U; i < entries; i++) {
+		uint64_t desc = table[i];
+		uintptr_t va = table_base_va +
+			((uintptr_t)i << XLAT_ADDR_SHIFT(level));
+		uint64_t *child;
+		uint64_t block_desc;
+
+		if ((desc & DESC_MASK) != TABLE_DESC)
+			continue;
+
+		child = (uint64_t *)(uintptr_t)(desc & TABLE_ADDR_MASK);
+
+		/* Fold bottom-up so block runs can cascade upwards. */
+		if ((level + 1U) < XLAT_TABLE_LEVEL_MAX)
+			promoted += xlat_tables_promote_table(ctx, child,
+						XLAT_TABLE_ENTRIES,
+						level + 1U, va);
+
+		if (level < MIN_LVL_BLOCK_DESC)
+			continue;
+
+		if (!xlat_table_can_fold(child, level + 1U, &block_desc))
+			continue;
+
+#if PLAT_XLAT_TABLES_DYNAMIC
+		if (xlat_va_range_has_dynamic_region(ctx, va,
+						     XLAT_BLOCK_SIZE(level)))
+			continue;
+#endif
+
+		/* Break the table entry... */
+		table[i] = INVALID_DESC;
+#if !(HW_ASSISTED_COHERENCY || WARMBOOT_ENABLE_DCACHE_EARLY)
+		xlat_clean_dcache_range((uintptr_t)&table[i],
+					sizeof(table[i]));
+#endif
+		dsbishst();
+
+		/*
+		 * ...drop every translation cached under it (one entry per
+		 * child descriptor can be live, a single completion barrier
+		 * covers them all)...
+		 */
+		for (uintptr_t p = va; p < (va + XLAT_BLOCK_SIZE(level));
+		     p += XLAT_BLOCK_SIZE(level + 1U))
+			xlat_arch_tlbi_va(p, ctx->xlat_regime);
+		xlat_arch_tlbi_va_sync();
+
+		/* ...and make the block descriptor. */
+		table[i] = block_desc;
+#if !(HW_ASSISTED_COHERENCY || WARMBOOT_ENABLE_DCACHE_EARLY)
+		xlat_clean_dcache_range((uintptr_t)&table[i],
+					sizeof(table[i]));
+#endif
+		dsbishst();
+
+		xlat_table_fold_release(ctx, child);
+
+		promoted++;
+	}
+
+	return promoted;
+}
+
+void xlat_promote_block_mappings_ctx(xlat_ctx_t *ctx)
+{
+	unsigned int promoted;
+
+	assert(ctx != NULL);
+	assert(ctx->initialized);
+
+	promoted = xlat_tables_promote_table(ctx, ctx->base_table,
+					     ctx_base_table_entries(ctx),
+					     ctx_base_level(ctx), 0U);
+
+#if PLAT_XLAT_TABLES_DYNAMIC
+	/* The pass may have released tables the cached walk points at. */
+	xlat_last_walk.valid = false;
+#endif
+
+	if (promoted != 0U) {
+		VERBOSE("Promoted %u table(s) to block mappings\n", promoted);
+		xlat_tables_print(ctx);
+	}
+}
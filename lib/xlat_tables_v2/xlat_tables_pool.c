@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <assert.h>
+#include <stdint.h>
+
+#include <platform_def.h>
+
+#include <lib/cassert.h>
+#include <lib/xlat_tables/xlat_tables_defs.h>
+#include <lib/xlat_tables/xlat_tables_v2.h>
+
+#include "xlat_tables_private.h"
+
+/*
+ * Shared pool of translation table pages. Every context allocates its
+ * sub-tables from here, bounded by its own quota (the `tables_num` it was
+ * registered with), instead of carving a worst-case sized private array at
+ * build time. With dynamic mapping enabled, the pages of fully unmapped
+ * sub-tables return to the pool, so transient mappings recycle pages
+ * rather than growing the high watermark.
+ */
+#ifndef PLAT_XLAT_TABLES_POOL_SIZE
+#define PLAT_XLAT_TABLES_POOL_SIZE	MAX_XLAT_TABLES
+#endif
+
+#ifdef PLAT_XLAT_BASE
+CASSERT(!(PLAT_XLAT_BASE & (XLAT_TABLE_SIZE - 1)), invalid_plat_xlat_base);
+CASSERT(PLAT_XLAT_SIZE >= (sizeof(uint64_t) * XLAT_TABLE_ENTRIES *
+		PLAT_XLAT_TABLES_POOL_SIZE), invalid_plat_xlat_size);
+
+static uint64_t (*const xlat_tables_pool)[XLAT_TABLE_ENTRIES] =
+	(void *)PLAT_XLAT_BASE;
+#else
+static uint64_t xlat_tables_pool[PLAT_XLAT_TABLES_POOL_SIZE]
+	[XLAT_TABLE_ENTRIES] __aligned(XLAT_TABLE_SIZE) __section("xlat_table");
+#endif
+
+/* Owning context of each pool page, NULL while the page is free. */
+static const xlat_ctx_t *xlat_tables_pool_owner[PLAT_XLAT_TABLES_POOL_SIZE];
+
+#if PLAT_XLAT_TABLES_DYNAMIC
+/* Number of regions mapped in each pool page. */
+static int xlat_tables_pool_mapped_regions[PLAT_XLAT_TABLES_POOL_SIZE];
+
+/* Returns the index of the pool page holding the specified table. */
+static int xlat_table_pool_get_index(const uint64_t *table)
+{
+	int idx = (int)((table - xlat_tables_pool[0]) / XLAT_TABLE_ENTRIES);
+
+	assert((table >= xlat_tables_pool[0]) &&
+	       (idx < PLAT_XLAT_TABLES_POOL_SIZE));
+
+	return idx;
+}
+#endif /* PLAT_XLAT_TABLES_DYNAMIC */
+
+uint64_t *xlat_table_pool_alloc(xlat_ctx_t *ctx)
+{
+	/* Don't let one context starve the others of table pages. */
+	if (ctx->tables_used >= ctx->tables_num)
+		return NULL;
+
+	for (int i = 0; i < PLAT_XLAT_TABLES_POOL_SIZE; i++) {
+		if (xlat_tables_pool_owner[i] != NULL)
+			continue;
+
+		xlat_tables_pool_owner[i] = ctx;
+#if PLAT_XLAT_TABLES_DYNAMIC
+		xlat_tables_pool_mapped_regions[i] = 0;
+#endif
+		for (unsigned int j = 0U; j < XLAT_TABLE_ENTRIES; j++)
+			xlat_tables_pool[i][j] = INVALID_DESC;
+
+		ctx->tables_used++;
+
+		return xlat_tables_pool[i];
+	}
+
+	return NULL;
+}
+
+#if PLAT_XLAT_TABLES_DYNAMIC
+
+void xlat_table_pool_release(xlat_ctx_t *ctx, const uint64_t *table)
+{
+	int idx = xlat_table_pool_get_index(table);
+
+	assert(xlat_tables_pool_owner[idx] == ctx);
+	assert(xlat_tables_pool_mapped_regions[idx] == 0);
+	assert(ctx->tables_used > 0);
+
+	xlat_tables_pool_owner[idx] = NULL;
+	ctx->tables_used--;
+}
+
+int *xlat_table_pool_regions_count(const uint64_t *table)
+{
+	return &xlat_tables_pool_mapped_regions[xlat_table_pool_get_index(table)];
+}
+
+#endif /* PLAT_XLAT_TABLES_DYNAMIC */
@@ -13,6 +13,25 @@
 
 #include <lib/xlat_tables/xlat_tables_defs.h>
 
+#if XLAT_TABLES_STATIC_LEVELS
+/*
+ * With XLAT_TABLES_STATIC_LEVELS, every translation context covers
+ * PLAT_VIRT_ADDR_SPACE_SIZE of virtual address space, so the initial lookup
+ * level and the number of base table entries are build time constants. The
+ * level arithmetic below then folds at compile time and the compiler can
+ * specialize the table walk for the resulting depth. Context fields keep
+ * being initialized, and init_xlat_tables_ctx() checks them against the
+ * constants.
+ */
+#define ctx_base_level(_ctx) \
+	GET_XLAT_TABLE_LEVEL_BASE((uintptr_t)PLAT_VIRT_ADDR_SPACE_SIZE)
+#define ctx_base_table_entries(_ctx) \
+	GET_NUM_BASE_LEVEL_ENTRIES((uintptr_t)PLAT_VIRT_ADDR_SPACE_SIZE)
+#else
+#define ctx_base_level(_ctx)		((_ctx)->base_level)
+#define ctx_base_table_entries(_ctx)	((_ctx)->base_table_entries)
+#endif
+
 #if PLAT_XLAT_TABLES_DYNAMIC
 /*
  * Private shifts and masks to access fields of an mmap attribute
@@ -40,6 +59,23 @@
 
 extern uint64_t mmu_cfg_params[MMU_CFG_PARAM_MAX];
 
+#if XLAT_TABLES_POOL
+/*
+ * Claim a free page from the shared translation table pool for the given
+ * context. Returns NULL when the pool is exhausted or the context reached
+ * its quota.
+ */
+uint64_t *xlat_table_pool_alloc(xlat_ctx_t *ctx);
+
+#if PLAT_XLAT_TABLES_DYNAMIC
+/* Return a fully unmapped table page owned by the context to the pool. */
+void xlat_table_pool_release(xlat_ctx_t *ctx, const uint64_t *table);
+
+/* Access the mapped region count of the pool page holding this table. */
+int *xlat_table_pool_regions_count(const uint64_t *table);
+#endif
+#endif /* XLAT_TABLES_POOL */
+
 /*
  * Return the execute-never mask that will prevent instruction fetch at the
  * given translation regime.
@@ -20,6 +20,12 @@
 
 #include "xlat_tables_private.h"
 
+/*
+ * Number of page descriptors processed per break-before-make batch in
+ * xlat_change_mem_attributes_ctx(), bounding its stack usage.
+ */
+#define MEM_ATTR_BATCH_SIZE	U(32)
+
 #if LOG_LEVEL < LOG_LEVEL_VERBOSE
 
 void xlat_mmap_print(__unused const mmap_region_t *mmap)
@@ -226,7 +232,9 @@ void xlat_tables_print(xlat_ctx_t *ctx)
 	VERBOSE("  Entries @initial lookup level: %u\n",
 		ctx->base_table_entries);
 
-#if PLAT_XLAT_TABLES_DYNAMIC
+#if XLAT_TABLES_POOL
+	used_page_tables = ctx->tables_used;
+#elif PLAT_XLAT_TABLES_DYNAMIC
 	used_page_tables = 0;
 	for (int i = 0; i < ctx->tables_num; ++i) {
 		if (ctx->tables_mapped_regions[i] != 0)
@@ -520,52 +528,94 @@ int xlat_change_mem_attributes_ctx(const xlat_ctx_t *ctx, uintptr_t base_va,
 	/* Restore original value. */
 	base_va = base_va_original;
 
-	for (unsigned int i = 0U; i < pages_count; ++i) {
+	/*
+	 * The break-before-make sequence requires that the old descriptor is
+	 * invalidated in the TLBs before the new one is written. Doing that
+	 * page by page costs a synchronized TLBI round trip per page, so the
+	 * range is processed in batches instead: all descriptors of a batch
+	 * are broken, their TLB invalidations are issued back to back and
+	 * completed with a single barrier, and only then are the new
+	 * descriptors written. Pages whose resulting attributes are
+	 * unchanged are left untouched and need no invalidation at all.
+	 */
+	unsigned int i = 0U;
 
-		uint32_t old_attr = 0U, new_attr;
-		uint64_t *entry = NULL;
-		unsigned int level = 0U;
-		unsigned long long addr_pa = 0ULL;
+	while (i < pages_count) {
+		uint64_t *entries[MEM_ATTR_BATCH_SIZE];
+		uint64_t new_descs[MEM_ATTR_BATCH_SIZE];
+		uintptr_t vas[MEM_ATTR_BATCH_SIZE];
+		unsigned int batch = 0U;
 
-		(void) xlat_get_mem_attributes_internal(ctx, base_va, &old_attr,
-					    &entry, &addr_pa, &level);
+		while ((i < pages_count) && (batch < MEM_ATTR_BATCH_SIZE)) {
+			uint32_t old_attr = 0U, new_attr;
+			uint64_t *entry = NULL;
+			unsigned int level = 0U;
+			unsigned long long addr_pa = 0ULL;
 
-		/*
-		 * From attr, only MT_RO/MT_RW, MT_EXECUTE/MT_EXECUTE_NEVER and
-		 * MT_USER/MT_PRIVILEGED are taken into account. Any other
-		 * information is ignored.
-		 */
+			(void) xlat_get_mem_attributes_internal(ctx, base_va,
+						&old_attr, &entry, &addr_pa,
+						&level);
 
-		/* Clean the old attributes so that they can be rebuilt. */
-		new_attr = old_attr & ~(MT_RW | MT_EXECUTE_NEVER | MT_USER);
+			/*
+			 * From attr, only MT_RO/MT_RW,
+			 * MT_EXECUTE/MT_EXECUTE_NEVER and
+			 * MT_USER/MT_PRIVILEGED are taken into account. Any
+			 * other information is ignored.
+			 */
 
-		/*
-		 * Update attributes, but filter out the ones this function
-		 * isn't allowed to change.
-		 */
-		new_attr |= attr & (MT_RW | MT_EXECUTE_NEVER | MT_USER);
+			/* Clean the old attributes so they can be rebuilt. */
+			new_attr = old_attr &
+				   ~(MT_RW | MT_EXECUTE_NEVER | MT_USER);
 
-		/*
-		 * The break-before-make sequence requires writing an invalid
-		 * descriptor and making sure that the system sees the change
-		 * before writing the new descriptor.
-		 */
-		*entry = INVALID_DESC;
+			/*
+			 * Update attributes, but filter out the ones this
+			 * function isn't allowed to change.
+			 */
+			new_attr |= attr & (MT_RW | MT_EXECUTE_NEVER | MT_USER);
+
+			if (new_attr != old_attr) {
+				entries[batch] = entry;
+				new_descs[batch] = xlat_desc(ctx, new_attr,
+							     addr_pa, level);
+				vas[batch] = base_va;
+				batch++;
+			}
+
+			base_va += PAGE_SIZE;
+			i++;
+		}
+
+		if (batch == 0U) {
+			continue;
+		}
+
+		/* Break all descriptors of the batch. */
+		for (unsigned int j = 0U; j < batch; j++) {
+			*entries[j] = INVALID_DESC;
 #if !HW_ASSISTED_COHERENCY
-		dccvac((uintptr_t)entry);
+			dccvac((uintptr_t)entries[j]);
 #endif
-		/* Invalidate any cached copy of this mapping in the TLBs. */
-		xlat_arch_tlbi_va(base_va, ctx->xlat_regime);
+		}
+
+		/* Make the broken descriptors visible to the table walker. */
+		dsbishst();
 
-		/* Ensure completion of the invalidation. */
+		/*
+		 * Invalidate any cached copy of the broken mappings in the
+		 * TLBs, with a single completion barrier for the batch.
+		 */
+		for (unsigned int j = 0U; j < batch; j++) {
+			xlat_arch_tlbi_va(vas[j], ctx->xlat_regime);
+		}
 		xlat_arch_tlbi_va_sync();
 
-		/* Write new descriptor */
-		*entry = xlat_desc(ctx, new_attr, addr_pa, level);
+		/* Write the new descriptors. */
+		for (unsigned int j = 0U; j < batch; j++) {
+			*entries[j] = new_descs[j];
 #if !HW_ASSISTED_COHERENCY
-		dccvac((uintptr_t)entry);
+			dccvac((uintptr_t)entries[j]);
 #endif
-		base_va += PAGE_SIZE;
+		}
 	}
 
 	/* Ensure that the last descriptor writen is seen by the system. */
@@ -6,6 +6,7 @@
 
 #include <assert.h>
 #include <errno.h>
+#include <stdbool.h>
 #include <string.h>
 
 #include <common/debug.h>
@@ -100,3 +101,86 @@ int gunzip(uintptr_t *in_buf, size_t in_len, uintptr_t *out_buf,
 
 	return ret;
 }
+
+/*
+ * Streaming variant of gunzip(), for use when the compressed data arrives
+ * in chunks (e.g. straight from storage reads) instead of being staged as
+ * a whole. Usage: gunzip_stream_init(), then gunzip_stream_feed() for each
+ * chunk, then gunzip_stream_finish().
+ */
+static z_stream gz_stream;
+static bool gz_stream_ended;
+
+int gunzip_stream_init(uintptr_t out_buf, size_t out_len, uintptr_t work_buf,
+		       size_t work_len)
+{
+	int zret;
+
+	zalloc_start = work_buf;
+	zalloc_end = work_buf + work_len;
+	zalloc_current = zalloc_start;
+
+	zeromem(&gz_stream, sizeof(gz_stream));
+	gz_stream.next_out = (typeof(gz_stream.next_out))out_buf;
+	gz_stream.avail_out = out_len;
+	gz_stream.zalloc = zcalloc;
+	gz_stream.zfree = zfree;
+	gz_stream.opaque = (voidpf)0;
+	gz_stream_ended = false;
+
+	zret = inflateInit(&gz_stream);
+	if (zret != Z_OK) {
+		ERROR("zlib: inflate init failed (ret = %d)\n", zret);
+		return (zret == Z_MEM_ERROR) ? -ENOMEM : -EIO;
+	}
+
+	return 0;
+}
+
+int gunzip_stream_feed(uintptr_t in_buf, size_t in_len)
+{
+	int zret;
+
+	if (gz_stream_ended) {
+		/* Trailing padding after the end of the gzip stream */
+		return 0;
+	}
+
+	gz_stream.next_in = (typeof(gz_stream.next_in))in_buf;
+	gz_stream.avail_in = in_len;
+
+	zret = inflate(&gz_stream, Z_NO_FLUSH);
+	if (zret == Z_STREAM_END) {
+		gz_stream_ended = true;
+		return 0;
+	}
+
+	if (zret != Z_OK) {
+		if (gz_stream.msg)
+			ERROR("%s\n", gz_stream.msg);
+		ERROR("zlib: inflate failed (ret = %d)\n", zret);
+		inflateEnd(&gz_stream);
+		return (zret == Z_MEM_ERROR) ? -ENOMEM : -EIO;
+	}
+
+	return 0;
+}
+
+int gunzip_stream_finish(uintptr_t *out_end)
+{
+	int ret;
+
+	if (gz_stream_ended) {
+		VERBOSE("zlib: %lu byte input\n", gz_stream.total_in);
+		VERBOSE("zlib: %lu byte output\n", gz_stream.total_out);
+		*out_end = (uintptr_t)gz_stream.next_out;
+		ret = 0;
+	} else {
+		ERROR("zlib: premature end of input\n");
+		ret = -EIO;
+	}
+
+	inflateEnd(&gz_stream);
+
+	return ret;
+}
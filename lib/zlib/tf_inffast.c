@@ -0,0 +1,370 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Derived from zlib 1.2.11 inffast.c:
+ * Copyright (C) 1995-2017 Mark Adler
+ * For conditions of distribution and use, see copyright notice in zlib.h
+ */
+
+/*
+ * Drop-in replacement for the imported inffast.c, selected by
+ * ZLIB_TUNED_INFFAST in zlib.mk. The decode loop is kept identical to
+ * upstream; only the match copy loops differ.
+ *
+ * TF-A images run with alignment fault checking enabled (SCTLR.A) and are
+ * compiled with -mno-unaligned-access on AArch32, so the usual "unaligned
+ * wide load/store" inflate speedups are off the table. Instead the match
+ * copies below use naturally aligned 32-bit accesses wherever the data
+ * allows it:
+ *
+ *  - distance 1 and 2 matches (byte and halfword runs, which dominate when
+ *    compressing firmware images with large zero-filled or pattern-filled
+ *    regions) are turned into aligned word fills;
+ *  - longer matches whose source and destination are mutually word aligned
+ *    are copied a word at a time;
+ *  - everything else falls back to the upstream byte copy.
+ *
+ * The TF-A gunzip wrappers always present the whole output buffer to
+ * inflate(), so the sliding window stays unused and nearly every match is
+ * copied "direct from output" - exactly the loop tuned here.
+ */
+
+#include <stdint.h>
+
+#include "zutil.h"
+#include "inftrees.h"
+#include "inflate.h"
+#include "inffast.h"
+
+/*
+ * Word accesses into the byte-oriented output buffer; may_alias keeps them
+ * legal without disabling strict aliasing for the whole build.
+ */
+typedef uint32_t __attribute__((may_alias)) tf_inf_word_t;
+
+/* Below this length the alignment preamble is not worth it. */
+#define TF_INF_COPY_MIN		16U
+
+/*
+ * Copy "len" bytes from "from" to "out" with LZ77 match semantics: when the
+ * regions overlap, "from" trails "out" and each byte must be available
+ * before it is (re)read, replicating the pattern in between. A plain
+ * forward byte copy has these semantics; the wide paths below only engage
+ * when they preserve them.
+ */
+static void tf_inf_copy(unsigned char FAR *out,
+			z_const unsigned char FAR *from, unsigned len)
+{
+    unsigned dist;
+    tf_inf_word_t pat;
+    tf_inf_word_t FAR *wout;
+
+    if (len >= TF_INF_COPY_MIN) {
+        /*
+         * A forward copy is unconstrained unless the source trails the
+         * destination; "dist" then limits how wide each access may be.
+         */
+        dist = (out > from) ? (unsigned)(out - from) : len;
+
+        if (dist == 3U)
+            goto bytes;         /* period 3 never aligns with words */
+
+        /* Align the destination. */
+        while (((uintptr_t)out & 3U) != 0U) {
+            *out++ = *from++;
+            len--;
+        }
+
+        if (dist <= 2U) {
+            /*
+             * Run with period 1 or 2: both divide the word size, so the
+             * word at "out" repeats for the rest of the match.
+             */
+            if (dist == 1U) {
+                pat = (tf_inf_word_t)*from;
+                pat |= pat << 8;
+                pat |= pat << 16;
+            } else {
+                pat = (tf_inf_word_t)from[0] | ((tf_inf_word_t)from[1] << 8);
+                pat |= pat << 16;
+            }
+            wout = (tf_inf_word_t FAR *)out;
+            while (len >= 4U) {
+                *wout++ = pat;
+                len -= 4U;
+            }
+            out = (unsigned char FAR *)wout;
+            from = out - dist;
+        } else if (((uintptr_t)from & 3U) == 0U) {
+            /*
+             * Mutually aligned and at least a word apart: copy words.
+             * Reading each source word before storing one word further
+             * on keeps the overlapped case correct.
+             */
+            wout = (tf_inf_word_t FAR *)out;
+            while (len >= 4U) {
+                *wout = *(z_const tf_inf_word_t FAR *)from;
+                wout++;
+                from += 4;
+                len -= 4U;
+            }
+            out = (unsigned char FAR *)wout;
+        }
+        /* else: misaligned source, fall through to the byte loop */
+    }
+
+  bytes:
+    while (len > 2U) {
+        *out++ = *from++;
+        *out++ = *from++;
+        *out++ = *from++;
+        len -= 3U;
+    }
+    if (len != 0U) {
+        *out++ = *from++;
+        if (len > 1U)
+            *out++ = *from++;
+    }
+}
+
+/*
+   Decode literal, length, and distance codes and write out the resulting
+   literal and match bytes until either not enough input or output is
+   available, an end-of-block is encountered, or a data error is encountered.
+   When large enough input and output buffers are supplied to inflate(), for
+   example, a 16K input buffer and a 64K output buffer, more than 95% of the
+   inflate execution time is spent in this routine.
+
+   Entry assumptions:
+
+        state->mode == LEN
+        strm->avail_in >= 6
+        strm->avail_out >= 258
+        start >= strm->avail_out
+        state->bits < 8
+
+   On return, state->mode is one of:
+
+        LEN -- ran out of enough output space or enough available input
+        TYPE -- reached end of block code, inflate() to interpret next block
+        BAD -- error in block data
+ */
+void ZLIB_INTERNAL inflate_fast(strm, start)
+z_streamp strm;
+unsigned start;         /* inflate()'s starting value for strm->avail_out */
+{
+    struct inflate_state FAR *state;
+    z_const unsigned char FAR *in;      /* local strm->next_in */
+    z_const unsigned char FAR *last;    /* have enough input while in < last */
+    unsigned char FAR *out;     /* local strm->next_out */
+    unsigned char FAR *beg;     /* inflate()'s initial strm->next_out */
+    unsigned char FAR *end;     /* while out < end, enough space available */
+#ifdef INFLATE_STRICT
+    unsigned dmax;              /* maximum distance from zlib header */
+#endif
+    unsigned wsize;             /* window size or zero if not using window */
+    unsigned whave;             /* valid bytes in the window */
+    unsigned wnext;             /* window write index */
+    unsigned char FAR *window;  /* allocated sliding window, if wsize != 0 */
+    unsigned long hold;         /* local strm->hold */
+    unsigned bits;              /* local strm->bits */
+    code const FAR *lcode;      /* local strm->lencode */
+    code const FAR *dcode;      /* local strm->distcode */
+    unsigned lmask;             /* mask for first level of length codes */
+    unsigned dmask;             /* mask for first level of distance codes */
+    code here;                  /* retrieved table entry */
+    unsigned op;                /* code bits, operation, extra bits, or */
+                                /*  window position, window bytes to copy */
+    unsigned len;               /* match length, unused bytes */
+    unsigned dist;              /* match distance */
+    unsigned char FAR *from;    /* where to copy match from */
+
+    /* copy state to local variables */
+    state = (struct inflate_state FAR *)strm->state;
+    in = strm->next_in;
+    last = in + (strm->avail_in - 5);
+    out = strm->next_out;
+    beg = out - (start - strm->avail_out);
+    end = out + (strm->avail_out - 257);
+#ifdef INFLATE_STRICT
+    dmax = state->dmax;
+#endif
+    wsize = state->wsize;
+    whave = state->whave;
+    wnext = state->wnext;
+    window = state->window;
+    hold = state->hold;
+    bits = state->bits;
+    lcode = state->lencode;
+    dcode = state->distcode;
+    lmask = (1U << state->lenbits) - 1;
+    dmask = (1U << state->distbits) - 1;
+
+    /* decode literals and length/distances until end-of-block or not enough
+       input data or output space */
+    do {
+        if (bits < 15) {
+            hold += (unsigned long)(*in++) << bits;
+            bits += 8;
+            hold += (unsigned long)(*in++) << bits;
+            bits += 8;
+        }
+        here = lcode[hold & lmask];
+      dolen:
+        op = (unsigned)(here.bits);
+        hold >>= op;
+        bits -= op;
+        op = (unsigned)(here.op);
+        if (op == 0) {                          /* literal */
+            Tracevv((stderr, here.val >= 0x20 && here.val < 0x7f ?
+                    "inflate:         literal '%c'\n" :
+                    "inflate:         literal 0x%02x\n", here.val));
+            *out++ = (unsigned char)(here.val);
+        }
+        else if (op & 16) {                     /* length base */
+            len = (unsigned)(here.val);
+            op &= 15;                           /* number of extra bits */
+            if (op) {
+                if (bits < op) {
+                    hold += (unsigned long)(*in++) << bits;
+                    bits += 8;
+                }
+                len += (unsigned)hold & ((1U << op) - 1);
+                hold >>= op;
+                bits -= op;
+            }
+            Tracevv((stderr, "inflate:         length %u\n", len));
+            if (bits < 15) {
+                hold += (unsigned long)(*in++) << bits;
+                bits += 8;
+                hold += (unsigned long)(*in++) << bits;
+                bits += 8;
+            }
+            here = dcode[hold & dmask];
+          dodist:
+            op = (unsigned)(here.bits);
+            hold >>= op;
+            bits -= op;
+            op = (unsigned)(here.op);
+            if (op & 16) {                      /* distance base */
+                dist = (unsigned)(here.val);
+                op &= 15;                       /* number of extra bits */
+                if (bits < op) {
+                    hold += (unsigned long)(*in++) << bits;
+                    bits += 8;
+                    if (bits < op) {
+                        hold += (unsigned long)(*in++) << bits;
+                        bits += 8;
+                    }
+                }
+                dist += (unsigned)hold & ((1U << op) - 1);
+#ifdef INFLATE_STRICT
+                if (dist > dmax) {
+                    strm->msg = (char *)"invalid distance too far back";
+                    state->mode = BAD;
+                    break;
+                }
+#endif
+                hold >>= op;
+                bits -= op;
+                Tracevv((stderr, "inflate:         distance %u\n", dist));
+                op = (unsigned)(out - beg);     /* max distance in output */
+                if (dist > op) {                /* see if copy from window */
+                    op = dist - op;             /* distance back in window */
+                    if (op > whave) {
+                        if (state->sane) {
+                            strm->msg =
+                                (char *)"invalid distance too far back";
+                            state->mode = BAD;
+                            break;
+                        }
+                    }
+                    from = window;
+                    if (wnext == 0) {           /* very common case */
+                        from += wsize - op;
+                        if (op < len) {         /* some from window */
+                            len -= op;
+                            tf_inf_copy(out, from, op);
+                            out += op;
+                            from = out - dist;  /* rest from output */
+                        }
+                    }
+                    else if (wnext < op) {      /* wrap around window */
+                        from += wsize + wnext - op;
+                        op -= wnext;
+                        if (op < len) {         /* some from end of window */
+                            len -= op;
+                            tf_inf_copy(out, from, op);
+                            out += op;
+                            from = window;
+                            if (wnext < len) {  /* some from start of window */
+                                op = wnext;
+                                len -= op;
+                                tf_inf_copy(out, from, op);
+                                out += op;
+                                from = out - dist;      /* rest from output */
+                            }
+                        }
+                    }
+                    else {                      /* contiguous in window */
+                        from += wnext - op;
+                        if (op < len) {         /* some from window */
+                            len -= op;
+                            tf_inf_copy(out, from, op);
+                            out += op;
+                            from = out - dist;  /* rest from output */
+                        }
+                    }
+                    tf_inf_copy(out, from, len);
+                    out += len;
+                }
+                else {
+                    from = out - dist;          /* copy direct from output */
+                    tf_inf_copy(out, from, len);
+                    out += len;
+                }
+            }
+            else if ((op & 64) == 0) {          /* 2nd level distance code */
+                here = dcode[here.val + (hold & ((1U << op) - 1))];
+                goto dodist;
+            }
+            else {
+                strm->msg = (char *)"invalid distance code";
+                state->mode = BAD;
+                break;
+            }
+        }
+        else if ((op & 64) == 0) {              /* 2nd level length code */
+            here = lcode[here.val + (hold & ((1U << op) - 1))];
+            goto dolen;
+        }
+        else if (op & 32) {                     /* end-of-block */
+            Tracevv((stderr, "inflate:         end of block\n"));
+            state->mode = TYPE;
+            break;
+        }
+        else {
+            strm->msg = (char *)"invalid literal/length code";
+            state->mode = BAD;
+            break;
+        }
+    } while (in < last && out < end);
+
+    /* return unused bytes (on entry, bits < 8, so in won't go too far back) */
+    len = bits >> 3;
+    in -= len;
+    bits -= len << 3;
+    hold &= (1U << bits) - 1;
+
+    /* update state and return */
+    strm->next_in = in;
+    strm->next_out = out;
+    strm->avail_in = (unsigned)(in < last ? 5 + (last - in) : 5 - (in - last));
+    strm->avail_out = (unsigned)(out < end ?
+                                 257 + (end - out) : 257 - (out - end));
+    state->hold = hold;
+    state->bits = bits;
+    return;
+}
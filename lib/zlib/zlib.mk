@@ -23,3 +23,11 @@ INCLUDES	+=	-Iinclude/lib/zlib
 
 # REVISIT: the following flags need not be given globally
 TF_CFLAGS	+=	-DZ_SOLO -DDEF_WBITS=31
+
+# Replace the imported inflate fast loop with the TF-tuned one (aligned wide
+# copies, see tf_inffast.c). Platforms can opt out with ZLIB_TUNED_INFFAST=0.
+ZLIB_TUNED_INFFAST	?=	1
+ifeq (${ZLIB_TUNED_INFFAST},1)
+ZLIB_SOURCES	:=	$(filter-out $(ZLIB_PATH)/inffast.c,$(ZLIB_SOURCES))
+ZLIB_SOURCES	+=	$(ZLIB_PATH)/tf_inffast.c
+endif
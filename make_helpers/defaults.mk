@@ -36,6 +36,13 @@ BL2_IN_XIP_MEM			:= 0
 # Do dcache invalidate upon BL2 entry at EL3
 BL2_INV_DCACHE			:= 1
 
+# Assume a single CPU ever runs and reduce bakery locks to a plain flag
+# update. Only for platforms where no secondary CPU is ever powered on.
+BAKERY_LOCK_SINGLE_CPU		:= 0
+
+# Flag to build the SMC benchmark runtime service
+BENCH_SVC			:= 0
+
 # Select the branch protection features to use.
 BRANCH_PROTECTION		:= 0
 
@@ -50,6 +57,10 @@ COREBOOT			:= 0
 # For Chain of Trust
 CREATE_KEYS			:= 1
 
+# Asynchronous verification queue in the crypto module, so a platform
+# crypto accelerator can overlap verification with CPU work.
+CRYPTO_ASYNC			:= 0
+
 # Build flag to include AArch32 registers in cpu context save and restore during
 # world switch. This flag must be set to 0 for AArch64-only platforms.
 CTX_INCLUDE_AARCH32_REGS	:= 1
@@ -62,6 +73,14 @@ CTX_INCLUDE_FPREGS		:= 0
 # world. It is not needed to use it in the Non-secure world.
 CTX_INCLUDE_PAUTH_REGS		:= 0
 
+# Audit mode for the per-CPU data blocks: verify the cache writeback
+# granule at runtime and count cross-CPU accesses to each CPU's block
+CPU_DATA_CACHELINE_AUDIT	:= 0
+
+# Capture crash diagnostics in a persistent RAM region provided by the
+# platform (CRASH_RAM_BASE/CRASH_RAM_SIZE) instead of relying on the UART
+CRASH_RAM_CAPTURE		:= 0
+
 # Debug build
 DEBUG				:= 0
 
@@ -75,6 +94,17 @@ DISABLE_BIN_GENERATION		:= 0
 # development platforms.
 DYN_DISABLE_AUTH		:= 0
 
+# Flag to enable whole-firmware link-time optimization (GCC only)
+ENABLE_LTO			:= 0
+
+# Flag to patch out erratum workarounds that do not apply to the MIDR
+# revision read at boot. Requires ENABLE_STATIC_BRANCH.
+ENABLE_ERRATA_PRUNING		:= 0
+
+# Flag to checksum-seal critical shared data structures in debug builds and
+# panic when a seal no longer matches at an idle-time check point
+ENABLE_MEM_GUARD		:= 0
+
 # Build option to enable MPAM for lower ELs
 ENABLE_MPAM_FOR_LOWER_ELS	:= 0
 
@@ -93,6 +123,10 @@ ENABLE_RUNTIME_INSTRUMENTATION	:= 0
 # Flag to enable stack corruption protection
 ENABLE_STACK_PROTECTOR		:= 0
 
+# Flag to enable boot-time patched static branches for runtime-constant
+# feature checks
+ENABLE_STATIC_BRANCH		:= 0
+
 # Flag to enable exception handling in EL3
 EL3_EXCEPTION_HANDLING		:= 0
 
@@ -115,6 +149,10 @@ ERROR_DEPRECATED		:= 0
 # Fault injection support
 FAULT_INJECTION_SUPPORT		:= 0
 
+# Resolve device tree properties through a side index built once at load
+# time, instead of a string compare per property per lookup
+FDT_PROP_INDEX			:= 0
+
 # Byte alignment that each component in FIP is aligned to
 FIP_ALIGN			:= 0
 
@@ -139,25 +177,82 @@ HANDLE_EA_EL3_FIRST		:= 0
 # operations.
 HW_ASSISTED_COHERENCY		:= 0
 
+# Reorder the BL2 image load sequence by FIP storage offset so that
+# sequential-access boot media is read front to back
+IMAGE_LOAD_STORAGE_ORDER	:= 0
+
+# Stage the opening burst of the next image in the BL2 load sequence while
+# the CPU authenticates the current one, so the follow-up load starts from
+# an on-chip buffer instead of an idle storage device
+IMAGE_PREFETCH			:= 0
+
 # Set the default algorithm for the generation of Trusted Board Boot keys
 KEY_ALG				:= rsa
 
+# Build a TCG compatible measured boot event log from the image hashes the
+# Trusted Board Boot flow already verifies, without rehashing the images
+MEASURED_BOOT			:= 0
+
+# Replay a precomputed buffer layout in the boot memory pools. Pools with
+# no layout bound log each allocation so a reference boot can be recorded;
+# tools/poolplan turns such a log into a conflict-minimized layout file the
+# platform compiles in, making buffer placement identical across firmware
+# versions instead of shifting with every code change.
+MEMPOOL_LAYOUT			:= 0
+
+# Specialize the MMC driver for one device family: 0 keeps the runtime
+# device type checks, 1 builds for eMMC only and 2 for SD cards only,
+# dropping the negotiation path of the other family from the image
+MMC_DEVICE_TYPE			:= 0
+
 # NS timer register save and restore
 NS_TIMER_SWITCH			:= 0
 
 # Include lib/libc in the final image
 OVERRIDE_LIBC			:= 0
 
+# Chunk image loads and stream them through the crypto hash so that the
+# digest used for authentication is computed while the data is still hot in
+# the data cache, instead of in a separate full-image pass after the load.
+PIPELINED_IMAGE_LOAD		:= 0
+
 # Build PL011 UART driver in minimal generic UART mode
 PL011_GENERIC_UART		:= 0
 
+# Use the PMU cycle counter instead of the generic counter as PMF time-stamp
+# source, for CPU-cycle resolution measurements.
+PMF_CYCLE_COUNTER		:= 0
+
+# Build runtime-togglable PMF capture sites and the SMC interface that
+# enables, disables and queries them, so dormant instrumentation can be
+# switched on in the field without reflashing.
+PMF_DYN_CAPTURE			:= 0
+
+# Keep a per-CPU ring buffer of every PMF time-stamp captured, retrievable
+# through the PMF SMC interface.
+PMF_RING_BUFFER			:= 0
+
 # By default, consider that the platform's reset address is not programmable.
 # The platform Makefile is free to override this value.
 PROGRAMMABLE_RESET_ADDRESS	:= 0
 
+# Function-level cycle attribution for debug builds: compile with
+# -finstrument-functions and trace every C function entry and exit with the
+# PMU cycle counter into a per-CPU RAM ring, decoded off-target against the
+# image symbols by tools/proftrace.
+PROF_INSTRUMENT			:= 0
+
+# Acquire PSCI parent power domain locks lazily on the suspend path, only
+# when state coordination actually reaches the corresponding power level.
+PSCI_LAZY_PD_LOCKS		:= 0
+
 # Flag used to choose the power state format: Extended State-ID or Original
 PSCI_EXTENDED_STATE_ID		:= 0
 
+# Cache validated CPU_SUSPEND power_state parameters per core, so repeat
+# suspend requests skip the validation and state composition arithmetic.
+PSCI_SUSPEND_STATE_CACHE	:= 0
+
 # Enable RAS support
 RAS_EXTENSION			:= 0
 
@@ -178,6 +273,41 @@ SEPARATE_CODE_AND_RODATA	:= 0
 # cores stack
 RECLAIM_INIT_CODE		:= 0
 
+# Account a secure world execution budget on every runtime service dispatch,
+# with per-OEN overrun statistics retrievable through the PMF SMC interface
+# and cooperative checkpoints for divisible services.
+SEC_EXEC_BUDGET			:= 0
+
+# The budget in generic timer ticks (the default is 1ms at a 24 MHz counter)
+SEC_EXEC_BUDGET_TICKS		:= 24000
+
+# Time-stamp the runtime service handler dispatch and bin the latencies into
+# per-CPU, per-OEN histograms retrievable through the PMF SMC interface.
+SMC_LATENCY_TRACE		:= 0
+
+# Draw a token from a per-CPU, per-OEN token bucket on every runtime service
+# dispatch and shed calls with SMC_UNK when the bucket is empty, with per-OEN
+# shed counts retrievable through the PMF SMC interface.
+SMC_RATE_LIMIT			:= 0
+
+# One token is earned every SMC_RATE_LIMIT_TOKEN_TICKS generic timer ticks
+# (the default sustains 10000 SMCs/s per OEN at a 24 MHz counter) and a
+# bucket holds at most SMC_RATE_LIMIT_BURST tokens.
+SMC_RATE_LIMIT_TOKEN_TICKS	:= 2400
+SMC_RATE_LIMIT_BURST		:= 32
+
+# Bit mask of owning entity numbers never shed. The default exempts the Arm
+# architecture (OEN 0) and standard service / PSCI (OEN 4) ranges.
+SMC_RATE_LIMIT_EXEMPT		:= 0x11
+
+# Emit per-function .su frame size artifacts for the worst-case stack depth
+# report (make_helpers/stack_usage.py, "make stack-report")
+STACK_USAGE			:= 0
+
+# Pattern-fill the CPU stacks at boot and report their high-water marks
+# through the PMF SMC interface. Requires ENABLE_PMF.
+STACK_HWM			:= 0
+
 # SPD choice
 SPD				:= none
 
@@ -191,6 +321,11 @@ SPM_MM				:= 1
 # image. This is meant to help debugging the post-BL2 phase.
 SPIN_ON_BL1_EXIT		:= 0
 
+# Capture log messages as binary records (format string pointer plus raw
+# arguments) in a RAM ring instead of formatting to the console, drained at
+# idle and rendered offline by tools/binlog using the firmware ELF
+TF_LOG_BINARY			:= 0
+
 # Flags to build TF with Trusted Boot support
 TRUSTED_BOARD_BOOT		:= 0
 
@@ -0,0 +1,178 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+"""
+Aggregate -fstack-usage artifacts over the static call graph of a linked
+image and report worst-case stack depths per entry point.
+
+Build with STACK_USAGE=1 so every object comes with a .su file, then:
+
+  make_helpers/stack_usage.py --build-dir build/stm32mp1/debug \
+      --elf build/stm32mp1/debug/bl2/bl2.elf \
+      --objdump arm-linux-gnueabihf-objdump \
+      --budget 0x600
+
+The per-function frame sizes come from the .su files; the call edges
+come from disassembling the final ELF, so only code that was actually
+linked contributes. The worst chain of every root function (one no other
+function calls, which covers the entry points and exception handlers) is
+computed by depth-first walk. With --budget the exit status is non-zero
+when any chain exceeds it, making the check enforceable from the build.
+
+Limitations, reported rather than hidden: indirect calls (through
+function pointers, e.g. the runtime service dispatch) contribute no
+edge, so functions making them are flagged and their callees' chains
+show up as separate roots; recursion is broken after one pass and
+flagged; assembly functions without .su data count zero frame bytes and
+are flagged when they appear on a worst chain.
+"""
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+
+# "<file>:<line>:<col>:<function>\t<bytes>\t<qualifier>"
+SU_LINE = re.compile(r"^.*:\d+:\d+:([^\t]+)\t(\d+)\t(.*)$")
+
+# "0001c0f4 <bl2_main>:"
+FUNC_LABEL = re.compile(r"^[0-9a-f]+ <([^>+]+)>:$")
+
+# "...: eb0000c8 bl 1c3a4 <foo>" / "blx" / plain "b" tail calls, and the
+# aarch64 "bl" — the mnemonic match covers both instruction sets.
+CALL_INSN = re.compile(r"\t(?:bl|blx|b|b\.w|bl\.w)\s+[0-9a-f]+\s+<([^>+]+)>")
+
+INDIRECT_INSN = re.compile(r"\t(?:blx\s+(?:r[0-9]+|ip|lr)|blr\s+x[0-9]+)")
+
+
+def parse_su_files(build_dir):
+    """Map function name to its largest frame size over all objects."""
+    frames = {}
+    qualifiers = {}
+    for root, _, files in os.walk(build_dir):
+        for name in files:
+            if not name.endswith(".su"):
+                continue
+            with open(os.path.join(root, name)) as su:
+                for line in su:
+                    m = SU_LINE.match(line.strip())
+                    if not m:
+                        continue
+                    func, size, qual = m.group(1), int(m.group(2)), m.group(3)
+                    if size >= frames.get(func, -1):
+                        frames[func] = size
+                        qualifiers[func] = qual
+    return frames, qualifiers
+
+
+def parse_call_graph(elf, objdump):
+    """Call edges and indirect-call sites from the linked disassembly."""
+    out = subprocess.run([objdump, "-d", elf], check=True,
+                         stdout=subprocess.PIPE, text=True).stdout
+    edges = {}
+    indirect = set()
+    current = None
+    for line in out.splitlines():
+        m = FUNC_LABEL.match(line)
+        if m:
+            current = m.group(1)
+            edges.setdefault(current, set())
+            continue
+        if current is None:
+            continue
+        if INDIRECT_INSN.search(line):
+            indirect.add(current)
+            continue
+        m = CALL_INSN.search(line)
+        if m and m.group(1) != current:
+            edges[current].add(m.group(1))
+    return edges, indirect
+
+
+def worst_chain(func, edges, frames, memo, in_progress, recursive):
+    """Depth and chain of the deepest path below func, inclusive."""
+    if func in memo:
+        return memo[func]
+    if func in in_progress:
+        recursive.add(func)
+        return (0, [])
+    in_progress.add(func)
+    best = (0, [])
+    for callee in sorted(edges.get(func, ())):
+        sub = worst_chain(callee, edges, frames, memo, in_progress,
+                         recursive)
+        if sub[0] > best[0]:
+            best = sub
+    in_progress.discard(func)
+    result = (frames.get(func, 0) + best[0], [func] + best[1])
+    memo[func] = result
+    return result
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__)
+    ap.add_argument("--build-dir", required=True,
+                    help="directory scanned recursively for .su files")
+    ap.add_argument("--elf", required=True, help="linked image to analyze")
+    ap.add_argument("--objdump", default=os.environ.get(
+        "CROSS_COMPILE", "") + "objdump")
+    ap.add_argument("--budget", type=lambda v: int(v, 0), default=0,
+                    help="fail when a chain exceeds this many bytes")
+    ap.add_argument("--top", type=int, default=10,
+                    help="number of worst roots to print")
+    args = ap.parse_args()
+
+    frames, _ = parse_su_files(args.build_dir)
+    if not frames:
+        sys.exit("no .su files under %s (build with STACK_USAGE=1)"
+                 % args.build_dir)
+    edges, indirect = parse_call_graph(args.elf, args.objdump)
+
+    callees = set()
+    for deps in edges.values():
+        callees.update(deps)
+    roots = [f for f in edges if f not in callees]
+
+    memo = {}
+    recursive = set()
+    depths = []
+    for root in roots:
+        depth, chain = worst_chain(root, edges, frames, memo, set(),
+                                   recursive)
+        depths.append((depth, root, chain))
+    depths.sort(reverse=True)
+
+    status = 0
+    print("%s: %u functions, %u roots, worst chains:"
+          % (os.path.basename(args.elf), len(edges), len(roots)))
+    for depth, root, chain in depths[:args.top]:
+        over = args.budget and depth > args.budget
+        if over:
+            status = 1
+        print("  %5u bytes%s %s" % (depth,
+                                    " OVER BUDGET" if over else "",
+                                    " > ".join(chain)))
+        for func in chain:
+            if func not in frames:
+                print("         (no .su data for %s)" % func)
+
+    if recursive:
+        print("recursion broken after one pass: %s"
+              % ", ".join(sorted(recursive)))
+    if indirect:
+        print("%u functions make indirect calls (edges not followed), "
+              "e.g.: %s" % (len(indirect),
+                            ", ".join(sorted(indirect)[:5])))
+    if args.budget:
+        print("budget %u bytes: %s" % (args.budget,
+                                       "FAIL" if status else "ok"))
+    sys.exit(status)
+
+
+if __name__ == "__main__":
+    main()
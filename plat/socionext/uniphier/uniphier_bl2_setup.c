@@ -17,6 +17,9 @@
 #include <plat/common/platform.h>
 #ifdef UNIPHIER_DECOMPRESS_GZIP
 #include <tf_gunzip.h>
+#ifdef UNIPHIER_DECOMPRESS_LZ4
+#include <tf_lz4.h>
+#endif
 #endif
 
 #include "uniphier.h"
@@ -122,6 +125,10 @@ void bl2_plat_preload_setup(void)
 	image_decompress_init(UNIPHIER_IMAGE_BUF_BASE,
 			      UNIPHIER_IMAGE_BUF_SIZE,
 			      gunzip);
+#ifdef UNIPHIER_DECOMPRESS_LZ4
+	image_decompress_register_format(lz4f_magic, sizeof(lz4f_magic),
+					 lz4_decompress);
+#endif
 #endif
 }
 
@@ -26,10 +26,13 @@
 #include <drivers/st/stm32_fmc2_nand.h>
 #include <drivers/st/stm32_qspi.h>
 #include <drivers/st/stm32_sdmmc2.h>
+#include <lib/mempool.h>
 #include <lib/mmio.h>
 #include <lib/utils.h>
 #include <plat/common/platform.h>
 
+#include <stm32mp1_boot_bank.h>
+
 #if STM32MP_UART_PROGRAMMER
 #include <drivers/st/io_uart.h>
 #endif
@@ -49,18 +52,49 @@ static uintptr_t dummy_dev_spec;
 static uintptr_t image_dev_handle;
 static uintptr_t storage_dev_handle;
 
+/*
+ * Bounce buffer pool shared by the boot device drivers. Each driver
+ * allocates its staging buffers once its device is actually selected, so
+ * SYSRAM holds the peak demand of the active boot path instead of every
+ * enabled driver's worst case, and buffers that only serve a bounded
+ * boot stage are recycled through a pool phase.
+ */
+static uint8_t bounce_pool_backing[STM32MP_BOUNCE_POOL_SIZE]
+	__aligned(CACHE_WRITEBACK_GRANULE);
+static MEMPOOL(bounce_pool, bounce_pool_backing);
+
+void *stm32mp_bounce_alloc(size_t size, size_t align)
+{
+	return mempool_alloc(&bounce_pool, size, align);
+}
+
+/*
+ * Late-phase scratch pool in the DDR below the BL33 load address, seeded
+ * at the start of stm32mp_io_setup(), which runs once DDR is trained.
+ * Megabyte-class staging buffers (read-ahead windows, caches) belong
+ * here; the SYSRAM bounce pool keeps only what the early phase needs.
+ */
+static MEMPOOL_UNSEEDED(ddr_pool);
+
+void *stm32mp_late_alloc(size_t size, size_t align)
+{
+	return mempool_alloc(&ddr_pool, size, align);
+}
+
 #if STM32MP_SDMMC || STM32MP_EMMC
 static io_block_spec_t gpt_block_spec = {
 	.offset = 0,
 	.length = 34 * MMC_BLOCK_SIZE, /* Size of GPT table */
 };
 
-static uint32_t block_buffer[MMC_BLOCK_SIZE] __aligned(MMC_BLOCK_SIZE);
+/* Read-ahead cache in the DDR scratch pool, sized so one refill
+ * transaction covers the whole GPT plus the image headers close to it */
+#define MMC_CACHE_SIZE		(128U * MMC_BLOCK_SIZE)
 
-static const io_block_dev_spec_t mmc_block_dev_spec = {
+/* The temp buffer and cache offsets are allocated in boot_mmc() */
+static io_block_dev_spec_t mmc_block_dev_spec = {
 	/* It's used as temp buffer in block driver */
 	.buffer = {
-		.offset = (size_t)&block_buffer,
 		.length = MMC_BLOCK_SIZE,
 	},
 	.ops = {
@@ -68,6 +102,9 @@ static const io_block_dev_spec_t mmc_block_dev_spec = {
 		.write = NULL,
 	},
 	.block_size = MMC_BLOCK_SIZE,
+	.cache = {
+		.length = MMC_CACHE_SIZE,
+	},
 };
 
 static const io_dev_connector_t *mmc_dev_con;
@@ -78,6 +115,8 @@ static io_mtd_dev_spec_t spi_nor_dev_spec = {
 	.ops = {
 		.init = spi_nor_init,
 		.read = spi_nor_read,
+		.write = spi_nor_write,
+		.erase = spi_nor_erase,
 	},
 };
 #endif
@@ -354,6 +393,20 @@ static void boot_mmc(enum mmc_device_type mmc_dev_type,
 		panic();
 	}
 
+	/*
+	 * The io_block bounce buffer only serves the GPT parse: allocate
+	 * it in a pool phase and recycle it once the device is reopened
+	 * through io_mmc, which reads straight to the caller's buffer.
+	 * The read-ahead cache draws from the DDR scratch pool, where a
+	 * window this large costs nothing.
+	 */
+	mempool_phase_enter(&bounce_pool);
+
+	mmc_block_dev_spec.buffer.offset =
+		(size_t)stm32mp_bounce_alloc(MMC_BLOCK_SIZE, MMC_BLOCK_SIZE);
+	mmc_block_dev_spec.cache.offset =
+		(size_t)stm32mp_late_alloc(MMC_CACHE_SIZE, MMC_BLOCK_SIZE);
+
 	/* Open MMC as a block device to read GPT table */
 	io_result = register_io_dev_block(&mmc_dev_con);
 	if (io_result != 0) {
@@ -369,6 +422,8 @@ static void boot_mmc(enum mmc_device_type mmc_dev_type,
 	io_result = io_dev_close(storage_dev_handle);
 	assert(io_result == 0);
 
+	mempool_phase_exit(&bounce_pool);
+
 	stm32image_dev_info_spec.device_size =
 		stm32_sdmmc2_mmc_get_device_size();
 
@@ -407,6 +462,7 @@ static void boot_mmc(enum mmc_device_type mmc_dev_type,
 #if STM32MP_SPI_NOR
 static void boot_spi_nor(boot_api_context_t *boot_context)
 {
+	uint32_t bank_offset = boot_bank_selected() * STM32MP_NOR_BANK_OFFSET;
 	int io_result __unused;
 	uint8_t idx;
 	struct stm32image_part_info *part;
@@ -427,23 +483,23 @@ static void boot_spi_nor(boot_api_context_t *boot_context)
 
 	idx = IMG_IDX_BL33;
 	part = &stm32image_dev_info_spec.part_info[idx];
-	part->part_offset = STM32MP_NOR_BL33_OFFSET;
+	part->part_offset = STM32MP_NOR_BL33_OFFSET + bank_offset;
 	part->bkp_offset = 0U;
 
 #ifdef AARCH32_SP_OPTEE
 	idx = IMG_IDX_OPTEE_HEADER;
 	part = &stm32image_dev_info_spec.part_info[idx];
-	part->part_offset = STM32MP_NOR_TEEH_OFFSET;
+	part->part_offset = STM32MP_NOR_TEEH_OFFSET + bank_offset;
 	part->bkp_offset = 0U;
 
 	idx = IMG_IDX_OPTEE_PAGED;
 	part = &stm32image_dev_info_spec.part_info[idx];
-	part->part_offset = STM32MP_NOR_TEED_OFFSET;
+	part->part_offset = STM32MP_NOR_TEED_OFFSET + bank_offset;
 	part->bkp_offset = 0U;
 
 	idx = IMG_IDX_OPTEE_PAGER;
 	part = &stm32image_dev_info_spec.part_info[idx];
-	part->part_offset = STM32MP_NOR_TEEX_OFFSET;
+	part->part_offset = STM32MP_NOR_TEEX_OFFSET + bank_offset;
 	part->bkp_offset = 0U;
 #endif
 
@@ -460,6 +516,7 @@ static void boot_spi_nor(boot_api_context_t *boot_context)
 #if STM32MP_RAW_NAND
 static void boot_fmc2_nand(boot_api_context_t *boot_context)
 {
+	uint32_t bank_offset = boot_bank_selected() * STM32MP_NAND_BANK_OFFSET;
 	int io_result __unused;
 	uint8_t idx;
 	struct stm32image_part_info *part;
@@ -480,23 +537,23 @@ static void boot_fmc2_nand(boot_api_context_t *boot_context)
 
 	idx = IMG_IDX_BL33;
 	part = &stm32image_dev_info_spec.part_info[idx];
-	part->part_offset = STM32MP_NAND_BL33_OFFSET;
+	part->part_offset = STM32MP_NAND_BL33_OFFSET + bank_offset;
 	part->bkp_offset = nand_dev_spec.erase_size;
 
 #ifdef AARCH32_SP_OPTEE
 	idx = IMG_IDX_OPTEE_HEADER;
 	part = &stm32image_dev_info_spec.part_info[idx];
-	part->part_offset = STM32MP_NAND_TEEH_OFFSET;
+	part->part_offset = STM32MP_NAND_TEEH_OFFSET + bank_offset;
 	part->bkp_offset = nand_dev_spec.erase_size;
 
 	idx = IMG_IDX_OPTEE_PAGED;
 	part = &stm32image_dev_info_spec.part_info[idx];
-	part->part_offset = STM32MP_NAND_TEED_OFFSET;
+	part->part_offset = STM32MP_NAND_TEED_OFFSET + bank_offset;
 	part->bkp_offset = nand_dev_spec.erase_size;
 
 	idx = IMG_IDX_OPTEE_PAGER;
 	part = &stm32image_dev_info_spec.part_info[idx];
-	part->part_offset = STM32MP_NAND_TEEX_OFFSET;
+	part->part_offset = STM32MP_NAND_TEEX_OFFSET + bank_offset;
 	part->bkp_offset = nand_dev_spec.erase_size;
 #endif
 
@@ -513,6 +570,7 @@ static void boot_fmc2_nand(boot_api_context_t *boot_context)
 #if STM32MP_SPI_NAND
 static void boot_spi_nand(boot_api_context_t *boot_context)
 {
+	uint32_t bank_offset = boot_bank_selected() * STM32MP_NAND_BANK_OFFSET;
 	int io_result __unused;
 	uint8_t idx;
 	struct stm32image_part_info *part;
@@ -534,23 +592,23 @@ static void boot_spi_nand(boot_api_context_t *boot_context)
 
 	idx = IMG_IDX_BL33;
 	part = &stm32image_dev_info_spec.part_info[idx];
-	part->part_offset = STM32MP_NAND_BL33_OFFSET;
+	part->part_offset = STM32MP_NAND_BL33_OFFSET + bank_offset;
 	part->bkp_offset = spi_nand_dev_spec.erase_size;
 
 #ifdef AARCH32_SP_OPTEE
 	idx = IMG_IDX_OPTEE_HEADER;
 	part = &stm32image_dev_info_spec.part_info[idx];
-	part->part_offset = STM32MP_NAND_TEEH_OFFSET;
+	part->part_offset = STM32MP_NAND_TEEH_OFFSET + bank_offset;
 	part->bkp_offset = spi_nand_dev_spec.erase_size;
 
 	idx = IMG_IDX_OPTEE_PAGED;
 	part = &stm32image_dev_info_spec.part_info[idx];
-	part->part_offset = STM32MP_NAND_TEED_OFFSET;
+	part->part_offset = STM32MP_NAND_TEED_OFFSET + bank_offset;
 	part->bkp_offset = spi_nand_dev_spec.erase_size;
 
 	idx = IMG_IDX_OPTEE_PAGER;
 	part = &stm32image_dev_info_spec.part_info[idx];
-	part->part_offset = STM32MP_NAND_TEEX_OFFSET;
+	part->part_offset = STM32MP_NAND_TEEX_OFFSET + bank_offset;
 	part->bkp_offset = spi_nand_dev_spec.erase_size;
 #endif
 
@@ -646,6 +704,10 @@ void stm32mp_io_setup(void)
 	boot_api_context_t *boot_context =
 		(boot_api_context_t *)stm32mp_get_boot_ctx_address();
 
+	/* DDR is trained by now: the scratch pool backs the late phase */
+	mempool_seed(&ddr_pool, (void *)STM32MP_DDR_POOL_BASE,
+		     STM32MP_DDR_POOL_SIZE);
+
 	print_boot_device(boot_context);
 
 	if ((boot_context->boot_partition_used_toboot == 1U) ||
@@ -711,6 +773,9 @@ void stm32mp_io_setup(void)
 		panic();
 		break;
 	}
+
+	/* All boot devices for this interface are registered by now */
+	io_storage_freeze();
 }
 
 /*
@@ -759,6 +824,7 @@ int plat_try_next_boot_source(unsigned int image_id)
 	backup_nb++;
 
 	if (backup_nb >= PLATFORM_MTD_BACKUP_BLOCKS) {
+		boot_bank_demote();
 		return 0;
 	}
 
@@ -774,6 +840,7 @@ int plat_try_next_boot_source(unsigned int image_id)
 	assert(idx < STM32_PART_NUM);
 
 	if (part->bkp_offset == 0U) {
+		boot_bank_demote();
 		return 0;
 	}
 
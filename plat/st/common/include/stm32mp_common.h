@@ -9,6 +9,7 @@
 
 #include <cdefs.h>
 #include <stdbool.h>
+#include <stddef.h>
 
 #include <platform_def.h>
 
@@ -40,6 +41,8 @@ uintptr_t stm32mp_rcc_base(void);
 void stm32_gic_pcpu_init(void);
 void stm32_gic_init(void);
 int stm32_gic_enable_spi(int node, const char *name);
+/* Distributor base probed from the device tree, 0 before stm32_gic_init() */
+uintptr_t stm32_gic_get_gicd_base(void);
 
 /* Check MMU status to allow spinlock use */
 bool stm32mp_lock_available(void);
@@ -105,9 +108,38 @@ unsigned long stm32mp_clk_get_rate(unsigned long id);
 void stm32mp_clk_enable(unsigned long id);
 void stm32mp_clk_disable(unsigned long id);
 
+/*
+ * Arm/disarm a GIC SPI as a wfi() wake-up event for the calling core while
+ * IRQs stay masked at the CPU, so a driver can sleep in its completion wait
+ * instead of polling. The line is left pending at the GIC until the driver
+ * clears it at the peripheral, hence disarm masks it again at the
+ * distributor.
+ * @id: GIC interrupt ID of the line (MIN_SPI_ID based)
+ */
+void stm32mp_wfi_wake_enable(uint32_t id);
+void stm32mp_wfi_wake_disable(uint32_t id);
+
 /* Initialise the IO layer and register platform IO devices */
 void stm32mp_io_setup(void);
 
+/*
+ * Allocate a driver staging buffer from the BL2 bounce buffer pool.
+ * Panics when the pool is exhausted.
+ * @size: buffer size in bytes
+ * @align: buffer alignment, a power of two
+ */
+void *stm32mp_bounce_alloc(size_t size, size_t align);
+
+/*
+ * Allocate a late-phase staging buffer from the DDR scratch pool below
+ * the BL33 load address. Only valid from stm32mp_io_setup() onwards,
+ * once DDR is trained; panics before that and when the pool is
+ * exhausted.
+ * @size: buffer size in bytes
+ * @align: buffer alignment, a power of two
+ */
+void *stm32mp_late_alloc(size_t size, size_t align);
+
 /*
  * Check that the STM32 header of a .stm32 binary image is valid
  * @param header: pointer to the stm32 image header
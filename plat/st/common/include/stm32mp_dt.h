@@ -23,6 +23,22 @@ struct dt_node_info {
 	uint32_t status;
 };
 
+#if STM32MP_DT_PREBUILT_OFFSETS
+/*
+ * Table of node offsets pre-resolved at build time from the platform DTB by
+ * the stm32dtmap tool: one entry per compatible string of every node, in
+ * tree order.
+ */
+struct stm32mp_dt_map_entry {
+	const char *compatible;
+	int offset;
+};
+
+extern const struct stm32mp_dt_map_entry stm32mp_dt_map[];
+extern const unsigned int stm32mp_dt_map_count;
+extern const unsigned int stm32mp_dt_map_dtb_size;
+#endif
+
 /*******************************************************************************
  * Function and variable prototypes
  ******************************************************************************/
@@ -14,11 +14,12 @@
 /*
  * Lock/unlock access to shared registers
  *
- * @lock - NULL or pointer to spin lock
+ * @addr - Address of the shared register to be accessed; registers at
+ * different addresses may lock independently.
  */
 
-void stm32mp_lock_shregs(void);
-void stm32mp_unlock_shregs(void);
+void stm32mp_lock_shregs(uintptr_t addr);
+void stm32mp_unlock_shregs(uintptr_t addr);
 void stm32mp_mmio_clrsetbits_32_shregs(uintptr_t addr, uint32_t clear,
 				       uint32_t set);
 void stm32mp_mmio_clrbits_32_shregs(uintptr_t addr, uint32_t clear);
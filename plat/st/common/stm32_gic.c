@@ -145,6 +145,11 @@ void stm32_gic_init(void)
 	stm32_gic_pcpu_init();
 }
 
+uintptr_t stm32_gic_get_gicd_base(void)
+{
+	return platform_gic_data.gicd_base;
+}
+
 void stm32_gic_pcpu_init(void)
 {
 	gicv2_pcpu_distif_init();
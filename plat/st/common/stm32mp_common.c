@@ -7,12 +7,16 @@
 #include <assert.h>
 #include <errno.h>
 
+#include <libfdt.h>
+
 #include <platform_def.h>
 
 #include <arch_helpers.h>
 #include <common/debug.h>
+#include <drivers/arm/gicv2.h>
 #include <drivers/st/stm32mp_clkfunc.h>
 #include <drivers/st/stm32mp_pmic.h>
+#include <lib/mmio.h>
 #include <lib/spinlock.h>
 #include <lib/utils.h>
 #include <plat/common/platform.h>
@@ -113,6 +117,79 @@ uint32_t stm32_get_gpio_bank_offset(unsigned int bank)
 	return bank * GPIO_BANK_OFFSET;
 }
 
+/*
+ * GIC bases for the wfi() wake-up helpers below, read once from the device
+ * tree as in stm32_gic.c. BL2 does not run the GICv2 driver, so the helpers
+ * program the few distributor and CPU interface registers they need directly.
+ * SP_MIN reinitializes the GIC from scratch, no state needs to be preserved.
+ */
+static uintptr_t wfi_wake_gicd_base;
+static uintptr_t wfi_wake_gicc_base;
+
+static void stm32mp_wfi_wake_gic_init(void)
+{
+	void *fdt;
+	int node;
+	const fdt32_t *cuint;
+	struct dt_node_info dt_gic;
+
+	if (wfi_wake_gicd_base != 0U) {
+		return;
+	}
+
+	if (fdt_get_address(&fdt) == 0) {
+		panic();
+	}
+
+	node = dt_get_node(&dt_gic, -1, "arm,cortex-a7-gic");
+	if (node < 0) {
+		panic();
+	}
+
+	cuint = fdt_getprop(fdt, node, "reg", NULL);
+	if (cuint == NULL) {
+		panic();
+	}
+
+	wfi_wake_gicc_base = fdt32_to_cpu(*(cuint + 2));
+	wfi_wake_gicd_base = dt_gic.base;
+}
+
+void stm32mp_wfi_wake_enable(uint32_t id)
+{
+	uintptr_t gicd;
+
+	assert((id >= MIN_SPI_ID) && (id <= MAX_SPI_ID));
+
+	stm32mp_wfi_wake_gic_init();
+
+	gicd = wfi_wake_gicd_base;
+
+	/*
+	 * Route the line to this core as a Group 0 interrupt (the reset value
+	 * of GICD_IGROUPR). With IRQs masked at the CPU it is never taken,
+	 * but its assertion is a wfi() wake-up event.
+	 */
+	mmio_write_8(gicd + GICD_IPRIORITYR + id, STM32MP_IRQ_SEC_SPI_PRIO);
+	mmio_write_8(gicd + GICD_ITARGETSR + id,
+		     (uint8_t)BIT(plat_my_core_pos()));
+	mmio_write_32(gicd + GICD_ISENABLER + ((id >> 5U) << 2U),
+		      BIT(id & 0x1FU));
+	mmio_setbits_32(gicd + GICD_CTLR, CTLR_ENABLE_G0_BIT);
+
+	mmio_write_32(wfi_wake_gicc_base + GICC_PMR, GIC_PRI_MASK);
+	mmio_setbits_32(wfi_wake_gicc_base + GICC_CTLR, CTLR_ENABLE_G0_BIT);
+}
+
+void stm32mp_wfi_wake_disable(uint32_t id)
+{
+	assert((wfi_wake_gicd_base != 0U) &&
+	       (id >= MIN_SPI_ID) && (id <= MAX_SPI_ID));
+
+	mmio_write_32(wfi_wake_gicd_base + GICD_ICENABLER + ((id >> 5U) << 2U),
+		      BIT(id & 0x1FU));
+}
+
 int stm32mp_check_header(boot_api_image_header_t *header, uintptr_t buffer)
 {
 	/*
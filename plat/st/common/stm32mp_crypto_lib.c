@@ -151,6 +151,31 @@ static int crypto_verify_hash(void *data_ptr, unsigned int data_len,
 		goto out;
 	}
 
+#if PIPELINED_IMAGE_LOAD
+	{
+		const unsigned char *stream_hash;
+		unsigned int stream_hash_len;
+
+		/*
+		 * The HASH peripheral already digested this region while it
+		 * was being loaded: compare that digest instead of running
+		 * another full pass over the image.
+		 */
+		if ((crypto_mod_prehash_lookup(data_ptr, data_len,
+					       &stream_hash,
+					       &stream_hash_len) == 0) &&
+		    (stream_hash_len == digest_info_len)) {
+			ret = memcmp(stream_hash, digest_info_ptr,
+				     digest_info_len);
+			if (ret != 0) {
+				VERBOSE("%s: not expected digest\n", __func__);
+				ret = -EAUTH;
+			}
+			goto out;
+		}
+	}
+#endif
+
 	stm32_hash_init(HASH_SHA256);
 	ret = stm32_hash_final_update(data_ptr, data_len, calc_hash);
 	if (ret != 0) {
@@ -171,7 +196,51 @@ out:
 	return ret;
 }
 
+#if PIPELINED_IMAGE_LOAD
+/*
+ * Streaming hash interface for the pipelined image loader, served by the
+ * HASH peripheral. Image digests are thus computed by hardware while the
+ * image is being loaded, instead of by an extra pass at verification time.
+ */
+static int crypto_hash_init(void)
+{
+	stm32_hash_init(HASH_SHA256);
+
+	return CRYPTO_SUCCESS;
+}
+
+static int crypto_hash_update(void *data_ptr, unsigned int data_len)
+{
+	if (stm32_hash_update(data_ptr, data_len) != 0) {
+		return CRYPTO_ERR_HASH;
+	}
+
+	return CRYPTO_SUCCESS;
+}
+
+static int crypto_hash_finish(unsigned char *digest, unsigned int *digest_len)
+{
+	if (stm32_hash_final(digest) != 0) {
+		return CRYPTO_ERR_HASH;
+	}
+
+	*digest_len = BOOT_API_SHA256_DIGEST_SIZE_IN_BYTES;
+
+	return CRYPTO_SUCCESS;
+}
+#endif /* PIPELINED_IMAGE_LOAD */
+
+#if PIPELINED_IMAGE_LOAD
+REGISTER_CRYPTO_LIB("stm32_crypto_lib",
+		    crypto_lib_init,
+		    crypto_verify_signature,
+		    crypto_verify_hash,
+		    crypto_hash_init,
+		    crypto_hash_update,
+		    crypto_hash_finish);
+#else
 REGISTER_CRYPTO_LIB("stm32_crypto_lib",
 		    crypto_lib_init,
 		    crypto_verify_signature,
 		    crypto_verify_hash);
+#endif
@@ -12,6 +12,9 @@
 #include <platform_def.h>
 
 #include <common/debug.h>
+#if FDT_PROP_INDEX
+#include <common/fdt_prop_index.h>
+#endif
 #include <drivers/st/stm32_gpio.h>
 
 #include <stm32mp_dt.h>
@@ -20,6 +23,10 @@ static int fdt_checked;
 
 static void *fdt = (void *)(uintptr_t)STM32MP_DTB_BASE;
 
+#if STM32MP_DT_PREBUILT_OFFSETS
+static bool dt_map_usable;
+#endif
+
 /*******************************************************************************
  * This function checks device tree file with its header.
  * Returns 0 on success and a negative FDT error code on failure.
@@ -30,11 +37,66 @@ int dt_open_and_check(void)
 
 	if (ret == 0) {
 		fdt_checked = 1;
+#if FDT_PROP_INDEX
+		fdt_prop_index_build(fdt);
+#endif
+#if STM32MP_DT_PREBUILT_OFFSETS
+		/*
+		 * Only trust the pre-resolved offsets when the loaded DTB
+		 * is the one the table was generated from.
+		 */
+		dt_map_usable = (fdt_totalsize(fdt) ==
+				 stm32mp_dt_map_dtb_size);
+		if (!dt_map_usable) {
+			WARN("DTB does not match pre-resolved DT map\n");
+		}
+#endif
 	}
 
 	return ret;
 }
 
+/*******************************************************************************
+ * This function returns the offset of the node after @startoffset matching
+ * the compatible string, as fdt_node_offset_by_compatible() does. When the
+ * pre-resolved offset table is available the lookup is an array read and the
+ * resolved offset is cross-checked against the blob; the runtime parser
+ * remains the fallback.
+ ******************************************************************************/
+static int dt_node_offset_by_compatible(int startoffset, const char *compat)
+{
+#if STM32MP_DT_PREBUILT_OFFSETS
+	if (dt_map_usable) {
+		unsigned int i;
+
+		for (i = 0U; i < stm32mp_dt_map_count; i++) {
+			const struct stm32mp_dt_map_entry *entry =
+				&stm32mp_dt_map[i];
+
+			if ((entry->offset <= startoffset) ||
+			    (strcmp(entry->compatible, compat) != 0)) {
+				continue;
+			}
+
+			if (fdt_node_check_compatible(fdt, entry->offset,
+						      compat) == 0) {
+				return entry->offset;
+			}
+
+			/* The blob disagrees: stop using the table */
+			dt_map_usable = false;
+			break;
+		}
+
+		if (dt_map_usable) {
+			return -FDT_ERR_NOTFOUND;
+		}
+	}
+#endif
+
+	return fdt_node_offset_by_compatible(fdt, startoffset, compat);
+}
+
 /*******************************************************************************
  * This function gets the address of the DT.
  * If DT is OK, fdt_addr is filled with DT address.
@@ -362,7 +424,7 @@ int dt_get_node(struct dt_node_info *info, int offset, const char *compat)
 {
 	int node;
 
-	node = fdt_node_offset_by_compatible(fdt, offset, compat);
+	node = dt_node_offset_by_compatible(offset, compat);
 	if (node < 0) {
 		return -FDT_ERR_NOTFOUND;
 	}
@@ -398,7 +460,7 @@ int dt_get_stdout_uart_info(struct dt_node_info *info)
  ******************************************************************************/
 int dt_get_node_by_compatible(const char *compatible)
 {
-	int node = fdt_node_offset_by_compatible(fdt, -1, compatible);
+	int node = dt_node_offset_by_compatible(-1, compatible);
 
 	if (node < 0) {
 		INFO("Cannot find %s node in DT\n", compatible);
@@ -416,9 +478,9 @@ int dt_match_instance_by_compatible(const char *compatible, uintptr_t address)
 {
 	int node;
 
-	for (node = fdt_node_offset_by_compatible(fdt, -1, compatible);
+	for (node = dt_node_offset_by_compatible(-1, compatible);
 	     node != -FDT_ERR_NOTFOUND;
-	     node = fdt_node_offset_by_compatible(fdt, node, compatible)) {
+	     node = dt_node_offset_by_compatible(node, compatible)) {
 		const fdt32_t *cuint;
 
 		assert(fdt_get_node_parent_address_cells(node) == 1);
@@ -695,7 +757,7 @@ const char *dt_get_cpu_regulator_name(void)
  ******************************************************************************/
 const char *dt_get_usb_phy_regulator_name(void)
 {
-	int node = fdt_node_offset_by_compatible(fdt, -1, DT_USBPHYC_COMPAT);
+	int node = dt_node_offset_by_compatible(-1, DT_USBPHYC_COMPAT);
 	int subnode;
 	const char *reg_name = NULL;
 
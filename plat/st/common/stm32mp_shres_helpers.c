@@ -9,55 +9,70 @@
 #include <arch_helpers.h>
 #include <lib/mmio.h>
 #include <lib/spinlock.h>
+#include <lib/utils_def.h>
 
 #include <stm32mp_shres_helpers.h>
 
-static struct spinlock shregs_lock;
+/*
+ * One lock per hashed register address, so that read-modify-write sequences
+ * to the same register serialize while updates to unrelated shared registers
+ * (e.g. two different RCC gate banks) proceed concurrently on both cores.
+ * Registers hashed to the same slot share a lock, which only costs extra
+ * serialization, never correctness.
+ */
+#define SHREGS_LOCK_COUNT	U(8)
+
+static struct spinlock shregs_locks[SHREGS_LOCK_COUNT];
+
+static struct spinlock *shregs_lock(uintptr_t addr)
+{
+	return &shregs_locks[(addr >> 2) & (SHREGS_LOCK_COUNT - 1U)];
+}
 
-void stm32mp_lock_shregs(void)
+void stm32mp_lock_shregs(uintptr_t addr)
 {
 	if (stm32mp_lock_available() == 0U) {
 		return;
 	}
 
 	/* Assume interrupts are masked */
-	spin_lock(&shregs_lock);
+	spin_lock(shregs_lock(addr));
 }
 
-void stm32mp_unlock_shregs(void)
+void stm32mp_unlock_shregs(uintptr_t addr)
 {
 	if (stm32mp_lock_available() == 0U) {
 		return;
 	}
 
-	spin_unlock(&shregs_lock);
+	spin_unlock(shregs_lock(addr));
 }
 
 /* Shared register access: upon shared resource lock */
 void stm32mp_mmio_clrsetbits_32_shregs(uintptr_t addr, uint32_t clear,
 				       uint32_t set)
 {
-	stm32mp_lock_shregs();
+	stm32mp_lock_shregs(addr);
 
 	mmio_clrsetbits_32(addr, clear, set);
 
-	stm32mp_unlock_shregs();
+	stm32mp_unlock_shregs(addr);
 }
 
 void stm32mp_mmio_clrbits_32_shregs(uintptr_t addr, uint32_t clear)
 {
-	stm32mp_lock_shregs();
+	stm32mp_lock_shregs(addr);
 
 	mmio_clrbits_32(addr, clear);
 
-	stm32mp_unlock_shregs();
+	stm32mp_unlock_shregs(addr);
 }
 
 void stm32mp_mmio_setbits_32_shregs(uintptr_t addr, uint32_t set)
 {
-	stm32mp_lock_shregs();
+	stm32mp_lock_shregs(addr);
 
 	mmio_setbits_32(addr, set);
 
-	stm32mp_unlock_shregs();
+	stm32mp_unlock_shregs(addr);
 }
@@ -11,13 +11,22 @@
 
 #include <arch_helpers.h>
 #include <common/bl_common.h>
+#include <common/crash_ram.h>
 #include <common/debug.h>
 #include <common/desc_image_load.h>
+#include <common/prof_trace.h>
+#include <drivers/console_buffered.h>
 #include <drivers/delay_timer.h>
 #include <drivers/generic_delay_timer.h>
 #include <drivers/st/bsec.h>
 #include <drivers/st/stm32_console.h>
+#if STM32MP_FAST_REBOOT_AUTH
+#include <drivers/st/stm32_hash.h>
+#endif
 #include <drivers/st/stm32_iwdg.h>
+#if STM32MP_SDMMC || STM32MP_EMMC
+#include <drivers/st/stm32_sdmmc2.h>
+#endif
 #include <drivers/st/stm32mp_clkfunc.h>
 #include <drivers/st/stm32mp_pmic.h>
 #include <drivers/st/stm32mp_reset.h>
@@ -28,14 +37,24 @@
 #include <drivers/st/stm32mp1xx_hal_uart.h>
 #endif
 #include <drivers/st/stpmic1.h>
+#include <dt-bindings/clock/stm32mp1-clks.h>
+#include <lib/bl_aux_params/bl_aux_params.h>
 #include <lib/mmio.h>
 #include <lib/optee_utils.h>
 #include <lib/xlat_tables/xlat_tables_v2.h>
 #include <plat/common/platform.h>
 
 #include <boot_api.h>
+#include <stm32mp1_boot_bank.h>
+#include <stm32mp1_boot_deadline.h>
+#include <stm32mp1_boot_timeline.h>
 #include <stm32mp1_context.h>
 #include <stm32mp1_dbgmcu.h>
+#include <stm32mp1_handoff.h>
+#if STM32MP_SELF_TEST
+#include <stm32mp1_self_test.h>
+#endif
+#include <stm32mp1_smp.h>
 
 #define PWRLP_TEMPO_5_HSI	5
 
@@ -57,9 +76,49 @@ static const char debug_msg[626] = {
 };
 
 static struct console_stm32 console;
+static console_buffered_t early_console;
 static enum boot_device_e boot_device = BOOT_DEVICE_BOARD;
 static bool wakeup_standby;
 
+#ifndef AARCH32_SP_OPTEE
+/*
+ * Warm handoff records published to sp_min (see stm32mp1_handoff.h).
+ * They stay in BL2 BSS and are consumed by the sp_min early setup,
+ * before BL2's SYSRAM is reused.
+ */
+static struct bl_aux_param_uint64 handoff_console_param = {
+	.h.type = BL_AUX_PARAM_STM32_CONSOLE_BASE,
+};
+
+static struct bl_aux_param_uint64 handoff_ddr_param = {
+	.h.type = BL_AUX_PARAM_STM32_DDR_SIZE,
+};
+
+#if STM32MP_SELF_TEST
+static struct bl_aux_param_stm32_self_test handoff_self_test_param = {
+	.h.type = BL_AUX_PARAM_STM32_SELF_TEST,
+};
+#endif
+
+static uintptr_t stm32_handoff_publish(void)
+{
+	handoff_console_param.h.next = (uintptr_t)&handoff_ddr_param;
+	handoff_ddr_param.value = dt_get_ddr_size();
+
+#if STM32MP_SELF_TEST
+	handoff_ddr_param.h.next = (uintptr_t)&handoff_self_test_param;
+	handoff_self_test_param.storage_kbps =
+		stm32mp1_self_test_result.storage_kbps;
+	handoff_self_test_param.hash_kbps =
+		stm32mp1_self_test_result.hash_kbps;
+	handoff_self_test_param.ddr_kbps =
+		stm32mp1_self_test_result.ddr_kbps;
+#endif
+
+	return (uintptr_t)&handoff_console_param;
+}
+#endif
+
 static void print_reset_reason(void)
 {
 	uint32_t rstsr = mmio_read_32(stm32mp_rcc_base() + RCC_MP_RSTSCLRR);
@@ -155,7 +214,22 @@ void bl2_el3_early_platform_setup(u_register_t arg0,
 				  u_register_t arg2 __unused,
 				  u_register_t arg3 __unused)
 {
+	boot_timeline_capture(BOOT_TL_BL2_ENTRY);
+
 	stm32mp_save_boot_ctx_address(arg0);
+
+	/*
+	 * Capture output issued before the UART can be brought up (clock
+	 * tree and pinmux are not programmed yet) in a SYSRAM ring. It is
+	 * replayed once the crash-capable console below registers, making
+	 * the clock and DDR init phases observable without JTAG.
+	 */
+	if (console_buffered_register_early(&early_console) == 0) {
+		panic();
+	}
+
+	console_set_scope(&early_console.console,
+			  CONSOLE_FLAG_BOOT | CONSOLE_FLAG_CRASH);
 }
 
 void bl2_platform_setup(void)
@@ -177,6 +251,8 @@ void bl2_platform_setup(void)
 		panic();
 	}
 
+	boot_timeline_capture(BOOT_TL_DDR_READY);
+
 	ret = mmap_remove_dynamic_region(STM32MP_DDR_BASE,
 					 STM32MP_DDR_MAX_SIZE);
 	assert(ret == 0);
@@ -213,9 +289,34 @@ void bl2_platform_setup(void)
 	assert(ret == 0);
 #endif
 
+#if PROF_INSTRUMENT
+	/*
+	 * The cacheable DDR mapping above covers the trace rings; the BL2
+	 * functions that ran before DDR training stay uncovered, the boot
+	 * timeline checkpoints remain the reference for that window.
+	 */
+	prof_trace_init(STM32MP_PROF_TRACE_BL2_BASE,
+			STM32MP_PROF_TRACE_BL2_SIZE, 1U, PROF_TRACE_IMG_BL2);
+#endif
+
 	if ((dt_pmic_status() > 0) && (!wakeup_standby)) {
 		configure_pmic();
 	}
+
+	/*
+	 * Late phase: storage bring-up runs with DDR available, so the
+	 * boot device drivers stage their large buffers in the DDR
+	 * scratch pool instead of competing for SYSRAM.
+	 */
+	if (!wakeup_standby) {
+		stm32mp_io_setup();
+
+#if STM32MP_SELF_TEST
+		if (stm32mp1_self_test_requested()) {
+			stm32mp1_self_test_run();
+		}
+#endif
+	}
 }
 
 static void update_monotonic_counter(void)
@@ -510,6 +611,20 @@ void bl2_el3_plat_arch_setup(void)
 	console_set_scope(&console.console, CONSOLE_FLAG_BOOT |
 			  CONSOLE_FLAG_CRASH | CONSOLE_FLAG_TRANSLATE_CRLF);
 
+	/*
+	 * Drain the pre-UART output through the hardware console and retire
+	 * the early ring, its capture duty being over. When no stdout UART is
+	 * available the ring stays registered and keeps the log in SYSRAM for
+	 * debugger inspection.
+	 */
+	console_buffered_bind(&console.console, &early_console);
+	(void)console_unregister(&early_console.console);
+
+#ifndef AARCH32_SP_OPTEE
+	/* The UART passed all the checks above; hand it over to sp_min */
+	handoff_console_param.value = dt_uart_info.base;
+#endif
+
 	stm32mp_print_cpuinfo();
 
 	board_model = dt_get_board_model();
@@ -537,6 +652,18 @@ void bl2_el3_plat_arch_setup(void)
 #endif
 
 skip_console_init:
+#if CRASH_RAM_CAPTURE
+	/*
+	 * The crash capture region lives at the end of Backup SRAM; pin its
+	 * clock so that the panic paths can store to it at any time. Records
+	 * left over by a previous boot are replayed now that the console is
+	 * up, outside of any hot path.
+	 */
+	stm32mp_clk_enable(BKPSRAM);
+	crash_ram_init();
+	crash_ram_drain();
+#endif
+
 #if !TRUSTED_BOARD_BOOT
 	if (stm32mp_is_closed_device()) {
 		/* Closed chip required authentication */
@@ -553,6 +680,12 @@ skip_console_init:
 
 	stm32_iwdg_refresh();
 
+	/*
+	 * Let storage and crypto drivers refresh the watchdogs from their
+	 * inner loops, so image loading can use maximum-size transfers.
+	 */
+	stm32_iwdg_checkpoint_setup(IWDG_CHECKPOINT_PERIOD_MS);
+
 	if (bsec_read_debug_conf() != 0U) {
 		result = stm32mp1_dbgmcu_freeze_iwdg2();
 		if (result != 0) {
@@ -574,6 +707,11 @@ skip_console_init:
 
 	print_reset_reason();
 
+	boot_deadline_init();
+	boot_deadline_enter(BOOT_DL_STAGE_SETUP, STM32MP_BOOT_BUDGET_SETUP_MS);
+
+	boot_bank_init();
+
 	update_monotonic_counter();
 
 	if (dt_pmic_status() > 0) {
@@ -581,9 +719,74 @@ skip_console_init:
 		print_pmic_info_and_debug();
 	}
 
-	if (!wakeup_standby) {
-		stm32mp_io_setup();
+	/* Offload hash/decompression jobs during the image load phase */
+	stm32mp1_bl2_smp_start();
+}
+
+void bl2_el3_plat_prepare_exit(void)
+{
+	/* Send the secondary core back to the ROM holding pen */
+	stm32mp1_bl2_smp_stop();
+
+	boot_timeline_capture(BOOT_TL_BL2_EXIT);
+	boot_timeline_publish();
+
+	boot_deadline_finish();
+	boot_bank_confirm();
+}
+
+/*
+ * Per-image load metrics for the boot medium quality gate: effective load
+ * bandwidth and the medium retries attributed to the load window of each
+ * image, logged on the console and exported through the boot timeline.
+ */
+static unsigned long long image_load_start_ts;
+static unsigned int image_load_start_retries;
+
+static unsigned int boot_media_retry_count(void)
+{
+#if STM32MP_SDMMC || STM32MP_EMMC
+	return stm32_sdmmc2_get_retry_count();
+#else
+	return 0U;
+#endif
+}
+
+static void record_image_load_metrics(unsigned int kbps_tid,
+				      unsigned int retries_tid,
+				      uint32_t image_size)
+{
+	unsigned long long ticks = read_cntpct_el0() - image_load_start_ts;
+	unsigned long long freq = read_cntfrq_el0();
+	unsigned int retries = boot_media_retry_count() -
+			       image_load_start_retries;
+	uint32_t kbps = 0U;
+
+	if (ticks != 0ULL) {
+		kbps = (uint32_t)(((unsigned long long)image_size * freq) /
+				  (ticks * 1024U));
 	}
+
+	INFO("Image load: %u KB at %u KB/s, %u media retries\n",
+	     image_size / 1024U, kbps, retries);
+
+	boot_timeline_record(kbps_tid, kbps);
+	boot_timeline_record(retries_tid, retries);
+}
+
+/*******************************************************************************
+ * Open the deadline accounting stage of the image about to be loaded, so a
+ * watchdog reset during the load or authentication is attributed to it.
+ ******************************************************************************/
+int bl2_plat_handle_pre_image_load(unsigned int image_id)
+{
+	boot_deadline_enter(BOOT_DL_STAGE_IMAGE_BASE + image_id,
+			    STM32MP_BOOT_BUDGET_IMAGE_MS);
+
+	image_load_start_ts = read_cntpct_el0();
+	image_load_start_retries = boot_media_retry_count();
+
+	return 0;
 }
 
 #if defined(AARCH32_SP_OPTEE)
@@ -636,6 +839,10 @@ int bl2_plat_handle_post_image_load(unsigned int image_id)
 
 	switch (image_id) {
 	case BL32_IMAGE_ID:
+		boot_timeline_capture(BOOT_TL_BL32_LOADED);
+		record_image_load_metrics(BOOT_TL_BL32_LOAD_KBPS,
+					  BOOT_TL_BL32_LOAD_RETRIES,
+					  bl_mem_params->image_info.image_size);
 #if defined(AARCH32_SP_OPTEE)
 		bl_mem_params->ep_info.pc =
 					bl_mem_params->image_info.image_base;
@@ -665,18 +872,56 @@ int bl2_plat_handle_post_image_load(unsigned int image_id)
 				paged_mem_params->image_info.image_base;
 		bl_mem_params->ep_info.args.arg1 = 0; /* Unused */
 		bl_mem_params->ep_info.args.arg2 = 0; /* No DT supported */
+#else
+		/*
+		 * Publish the settings BL2 derived from the device tree, so
+		 * the sp_min setup consumes them instead of re-deriving.
+		 */
+		bl_mem_params->ep_info.args.arg1 = stm32_handoff_publish();
 #endif
 		break;
 
 	case BL33_IMAGE_ID:
+		boot_timeline_capture(BOOT_TL_BL33_LOADED);
+		record_image_load_metrics(BOOT_TL_BL33_LOAD_KBPS,
+					  BOOT_TL_BL33_LOAD_RETRIES,
+					  bl_mem_params->image_info.image_size);
 #ifdef AARCH32_SP_OPTEE
 		bl32_mem_params = get_bl_mem_params_node(BL32_IMAGE_ID);
 		assert(bl32_mem_params != NULL);
 		bl32_mem_params->ep_info.lr_svc = bl_mem_params->ep_info.pc;
 #endif
 
-		flush_dcache_range(bl_mem_params->image_info.image_base,
-				   bl_mem_params->image_info.image_max_size);
+		/*
+		 * The image was loaded by the FIP straight to its handoff
+		 * address and load_auth_image() already flushed exactly the
+		 * loaded bytes, so no further cache maintenance is needed.
+		 * image_max_size covers all of the remaining DDR and flushing
+		 * it here by VA costs seconds on large configurations.
+		 */
+
+#if STM32MP_FAST_REBOOT_AUTH
+		/*
+		 * Record the digest of the image just authenticated, so the
+		 * SYSTEM_RESET2 fast reboot path can accept a staged copy of
+		 * it with a hash compare instead of a storage reload.
+		 */
+		if (stm32mp_is_auth_supported()) {
+			uint8_t digest[BOOT_API_SHA256_DIGEST_SIZE_IN_BYTES];
+			uint8_t *base = (uint8_t *)
+				bl_mem_params->image_info.image_base;
+			uint32_t size = bl_mem_params->image_info.image_size;
+
+			stm32_hash_init(HASH_SHA256);
+			if (stm32_hash_final_update(base, size, digest) == 0) {
+				stm32_save_auth_cache((uint32_t)(uintptr_t)base,
+						      size, digest);
+			} else {
+				WARN("BL33 digest not recorded\n");
+				stm32_clean_auth_cache();
+			}
+		}
+#endif
 		break;
 
 	default:
@@ -53,6 +53,9 @@
 #define MAX_IO_BLOCK_DEVICES		U(1)
 #define MAX_IO_MTD_DEVICES		U(1)
 
+/* Fuse adjacent small flash reads into single transactions */
+#define MTD_READ_COALESCE_SIZE		U(512)
+
 /*******************************************************************************
  * BL2 specific defines.
  ******************************************************************************/
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2021, STMicroelectronics - All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef STM32MP1_BOOT_BANK_H
+#define STM32MP1_BOOT_BANK_H
+
+#include <cdefs.h>
+
+#include <lib/utils_def.h>
+
+/*
+ * A/B boot bank selection for MTD devices.
+ *
+ * The flash holds two copies (banks) of the BL33/OP-TEE image set, bank B
+ * at a fixed offset from bank A (STM32MP_NOR_BANK_OFFSET or
+ * STM32MP_NAND_BANK_OFFSET). The bank to boot from is kept in a TAMP
+ * backup register together with a demotion counter, so the selection
+ * costs a single register read at IO setup instead of discovering a bad
+ * bank by failing through it.
+ *
+ * Each boot where the image load path exhausts its fallbacks increments
+ * the demotion counter; once it reaches STM32MP_BOOT_BANK_DEMOTE_LIMIT
+ * the other bank becomes the selected one for the following boots. A
+ * boot which hands over successfully clears the counter, so transient
+ * failures do not accumulate. Within one bank, a corrupted copy is
+ * still detected cheaply: the stm32image layer validates the image
+ * header from the first LBA before reading anything else.
+ */
+
+/* Failed boots tolerated on a bank before switching to the other one */
+#ifndef STM32MP_BOOT_BANK_DEMOTE_LIMIT
+#define STM32MP_BOOT_BANK_DEMOTE_LIMIT	U(3)
+#endif
+
+#if STM32MP_BOOT_BANK
+void boot_bank_init(void);
+unsigned int boot_bank_selected(void);
+void boot_bank_demote(void);
+void boot_bank_confirm(void);
+#else
+static inline void boot_bank_init(void)
+{
+}
+
+static inline unsigned int boot_bank_selected(void)
+{
+	return 0U;
+}
+
+static inline void boot_bank_demote(void)
+{
+}
+
+static inline void boot_bank_confirm(void)
+{
+}
+#endif
+
+#endif /* STM32MP1_BOOT_BANK_H */
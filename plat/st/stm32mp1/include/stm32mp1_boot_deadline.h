@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2021, STMicroelectronics - All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef STM32MP1_BOOT_DEADLINE_H
+#define STM32MP1_BOOT_DEADLINE_H
+
+#include <cdefs.h>
+#include <stdint.h>
+
+#include <lib/utils_def.h>
+
+/*
+ * Boot deadline accounting.
+ *
+ * BL2 keeps the identifier of the stage it is currently executing in a TAMP
+ * backup register, together with the identifier of the first stage which
+ * overran its time budget. The register survives an IWDG reset, so a blind
+ * watchdog reset in the field can be attributed to a stage by reading a
+ * single register on the next boot, and budgets can be tightened with the
+ * overrun markers as evidence.
+ *
+ * Stages are declared with a time budget when entered. The budget of the
+ * previous stage is checked when the next one is entered (and on BL2 exit),
+ * so an overrun is recorded as soon as the hung operation completes; a stage
+ * which never completes is identified by the active stage field alone.
+ */
+
+/* Stage identifiers, recorded in the backup register */
+#define BOOT_DL_STAGE_NONE		U(0)
+#define BOOT_DL_STAGE_SETUP		U(1)
+/* Image load stages are (BOOT_DL_STAGE_IMAGE_BASE + image_id) */
+#define BOOT_DL_STAGE_IMAGE_BASE	U(0x10)
+
+/* Default stage budgets, can be overridden per board from the make line */
+#ifndef STM32MP_BOOT_BUDGET_SETUP_MS
+#define STM32MP_BOOT_BUDGET_SETUP_MS	U(1500)
+#endif
+#ifndef STM32MP_BOOT_BUDGET_IMAGE_MS
+#define STM32MP_BOOT_BUDGET_IMAGE_MS	U(2000)
+#endif
+
+#if STM32MP_BOOT_DEADLINE
+void boot_deadline_init(void);
+void boot_deadline_enter(unsigned int stage, uint32_t budget_ms);
+void boot_deadline_finish(void);
+#else
+static inline void boot_deadline_init(void)
+{
+}
+
+static inline void boot_deadline_enter(unsigned int stage __unused,
+				       uint32_t budget_ms __unused)
+{
+}
+
+static inline void boot_deadline_finish(void)
+{
+}
+#endif
+
+#endif /* STM32MP1_BOOT_DEADLINE_H */
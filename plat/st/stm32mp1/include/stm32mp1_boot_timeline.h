@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2021, STMicroelectronics - All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef STM32MP1_BOOT_TIMELINE_H
+#define STM32MP1_BOOT_TIMELINE_H
+
+#include <cdefs.h>
+
+#include <lib/utils_def.h>
+
+/*
+ * Boot timeline PMF service.
+ *
+ * Named checkpoints are captured from BL2 entry up to the end of the sp_min
+ * setup. The BL2 time-stamps are staged in BL2 BSS (DDR is not available for
+ * the first checkpoints) and copied to a reserved DDR page on BL2 exit.
+ * sp_min imports them from that page and serves the whole timeline through
+ * the PMF "get timestamp" SMC.
+ */
+#define PMF_STM32_BOOT_TIMELINE_SVC_ID	3
+
+/* Checkpoints captured by BL2 */
+#define BOOT_TL_BL2_ENTRY		U(0)
+#define BOOT_TL_DDR_READY		U(1)
+#define BOOT_TL_BL32_LOADED		U(2)
+#define BOOT_TL_BL33_LOADED		U(3)
+#define BOOT_TL_BL2_EXIT		U(4)
+
+/*
+ * DDR micro-benchmark results staged by BL2 (STM32MP_DDR_BENCHMARK). These
+ * entries carry values rather than time-stamps, and read back as zero when
+ * the benchmark is disabled.
+ */
+#define BOOT_TL_DDR_BENCH_RD_BW		U(5)
+#define BOOT_TL_DDR_BENCH_WR_BW		U(6)
+#define BOOT_TL_DDR_BENCH_CP_BW		U(7)
+#define BOOT_TL_DDR_BENCH_LAT		U(8)
+
+/*
+ * Per-image load metrics staged by BL2: effective load bandwidth and the
+ * boot medium retries attributed to the load. Values, not time-stamps.
+ */
+#define BOOT_TL_BL32_LOAD_KBPS		U(9)
+#define BOOT_TL_BL32_LOAD_RETRIES	U(10)
+#define BOOT_TL_BL33_LOAD_KBPS		U(11)
+#define BOOT_TL_BL33_LOAD_RETRIES	U(12)
+
+#define BOOT_TL_BL2_TOTAL_IDS		U(13)
+
+/* Checkpoints captured by sp_min */
+#define BOOT_TL_SP_MIN_ENTRY		U(13)
+#define BOOT_TL_SP_MIN_READY		U(14)
+#define BOOT_TL_TOTAL_IDS		U(15)
+
+#if STM32MP_BOOT_TIMELINE
+void boot_timeline_capture(unsigned int tid);
+void boot_timeline_record(unsigned int tid, unsigned long long value);
+void boot_timeline_publish(void);
+#else
+static inline void boot_timeline_capture(unsigned int tid __unused)
+{
+}
+
+static inline void boot_timeline_record(unsigned int tid __unused,
+					unsigned long long value __unused)
+{
+}
+
+static inline void boot_timeline_publish(void)
+{
+}
+#endif
+
+#endif /* STM32MP1_BOOT_TIMELINE_H */
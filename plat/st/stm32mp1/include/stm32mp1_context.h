@@ -14,6 +14,8 @@
 
 #define DDR_CRC_GRANULE		32
 
+struct stm32mp1_ddrphy_cal;
+
 void stm32_clean_context(void);
 int stm32_save_context(uint32_t zq0cr0_zdata,
 		       struct stm32_rtc_calendar *rtc_time,
@@ -28,6 +30,16 @@ int stm32_save_boot_interface(uint32_t interface, uint32_t instance);
 int stm32_get_boot_interface(uint32_t *interface, uint32_t *instance);
 void stm32_save_ddr_training_area(void);
 void stm32_restore_ddr_training_area(void);
+void stm32_save_ddr_cal(const struct stm32mp1_ddrphy_cal *cal);
+int stm32_get_ddr_cal_from_context(struct stm32mp1_ddrphy_cal *cal);
+void stm32_clean_ddr_cal(void);
+void stm32_save_resume_info(uint32_t uart_base, uint32_t ddr_size);
+int stm32_get_resume_info(uint32_t *uart_base, uint32_t *ddr_size);
+void stm32_save_auth_cache(uint32_t image_base, uint32_t image_size,
+			   const uint8_t *digest);
+void stm32_clean_auth_cache(void);
+int stm32_get_auth_cache(uint32_t *image_base, uint32_t *image_size,
+			 uint8_t *digest);
 uint32_t stm32_pm_get_optee_ep(void);
 
 void stm32mp1_pm_save_clock_cfg(size_t offset, uint8_t *data, size_t size);
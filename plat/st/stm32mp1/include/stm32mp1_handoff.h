@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2021, STMicroelectronics - All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef STM32MP1_HANDOFF_H
+#define STM32MP1_HANDOFF_H
+
+#include <lib/bl_aux_params/bl_aux_params.h>
+#include <lib/utils_def.h>
+
+/*
+ * Warm handoff from BL2 to sp_min.
+ *
+ * BL2 publishes settings it already derived from the device tree as a BL
+ * aux parameter list (lib/bl_aux_params), each record a
+ * struct bl_aux_param_uint64 carrying one of the vendor types below. The
+ * list head is passed in arg1 of the sp_min entry point; the records
+ * live in BL2 memory and are consumed in the sp_min early setup, before
+ * BL2's SYSRAM is reused. sp_min uses them instead of parsing the device
+ * tree again on the boot critical path, and falls back to the device
+ * tree for any record that is absent or zero.
+ */
+
+/* Base address of the stdout UART BL2 registered, 0 when none ('SCON') */
+#define BL_AUX_PARAM_STM32_CONSOLE_BASE	U(0x53434F4E)
+
+/* DDR size in bytes as read from the device tree by BL2 ('SDDR') */
+#define BL_AUX_PARAM_STM32_DDR_SIZE	U(0x53444452)
+
+/* Self-test throughput figures in KB/s, 0 when a test did not run ('STST') */
+#define BL_AUX_PARAM_STM32_SELF_TEST	U(0x53545354)
+
+#ifndef __ASSEMBLER__
+struct bl_aux_param_stm32_self_test {
+	struct bl_aux_param_header h;
+	uint32_t storage_kbps;
+	uint32_t hash_kbps;
+	uint32_t ddr_kbps;
+};
+#endif
+
+#endif /* STM32MP1_HANDOFF_H */
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2026, STMicroelectronics - All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef STM32MP1_NS_INFO_H
+#define STM32MP1_NS_INFO_H
+
+#include <stdint.h>
+
+#include <lib/utils_def.h>
+
+/*
+ * Read-only runtime info page published to the non-secure world, so
+ * that static facts the kernel otherwise queries over and over through
+ * SMCs (SMCCC/PSCI versions, chip identification, SCMI clock rates
+ * that rarely change) cost a memory read instead of a world switch.
+ *
+ * The layout below is an ABI shared with non-secure software. Readers
+ * must check the magic and layout version, then use the seqlock
+ * protocol on @seqcount: sample it, reject odd values (update in
+ * progress), read the fields, and retry when it changed.
+ */
+
+/* "STMI" */
+#define STM32MP1_NS_INFO_MAGIC		U(0x494D5453)
+
+#define STM32MP1_NS_INFO_VERSION	U(1)
+
+#define STM32MP1_NS_INFO_CLOCK_MAX	U(24)
+
+struct stm32mp1_ns_info {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t seqcount;
+	uint32_t smccc_version;
+	uint32_t psci_version;
+	uint32_t chip_dev_id;
+	uint32_t chip_version;
+	uint32_t clock_count;
+	struct {
+		uint32_t scmi_id;
+		uint32_t rate_hz;
+	} clock[STM32MP1_NS_INFO_CLOCK_MAX];
+};
+
+void stm32mp1_ns_info_init(void);
+void stm32mp1_ns_info_update_clock_rates(void);
+
+#endif /* STM32MP1_NS_INFO_H */
@@ -7,10 +7,22 @@
 #ifndef STM32MP1_PRIVATE_H
 #define STM32MP1_PRIVATE_H
 
+#include <cdefs.h>
 #include <stdint.h>
 
 #include <drivers/st/etzpc.h>
 
+/* Place BL32 data in the retained Backup SRAM window (retained_data) */
+#define __retained	__section(".retained_data")
+
+/*
+ * Gather the data a suspend cycle hands over to the wake path in one
+ * contiguous, cache line aligned block (.bss.suspend_ctx), so the low
+ * power driver pushes it to SYSRAM with a single ranged clean on
+ * suspend entry and reads it back after a single ranged invalidate.
+ */
+#define __suspend_ctx	__section(".bss.suspend_ctx")
+
 enum boot_device_e {
 	BOOT_DEVICE_USB,
 	BOOT_DEVICE_BOARD
@@ -23,6 +35,7 @@ void __dead2 stm32mp_wait_cpu_reset(void);
 
 void stm32mp1_arch_security_setup(void);
 void stm32mp1_security_setup(void);
+void stm32mp1_security_setup_resume(uint32_t ddr_size);
 
 enum boot_device_e get_boot_device(void);
 
@@ -34,6 +47,9 @@ void stm32mp1_syscfg_disable_io_compensation(void);
 
 void stm32mp1_deconfigure_uart_pins(void);
 
+uintptr_t stm32mp1_nc_alias(uintptr_t addr);
+void *stm32mp1_nc_alloc(size_t size);
+
 void stm32mp1_init_scmi_server(void);
 void stm32mp1_pm_save_scmi_state(uint8_t *state, size_t size);
 void stm32mp1_pm_restore_scmi_state(uint8_t *state, size_t size);
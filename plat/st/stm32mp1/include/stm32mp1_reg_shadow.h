@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2021, STMicroelectronics - All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef STM32MP1_REG_SHADOW_H
+#define STM32MP1_REG_SHADOW_H
+
+#include <lib/utils_def.h>
+
+/*
+ * Suspend/resume register shadow (STM32MP_REG_SHADOW=1). A declared set
+ * of RCC, GIC distributor, TZC and ETZPC register ranges is snapshot
+ * into a reserved DDR block on every low power entry and diffed against
+ * the live registers after resume. Mismatches land in the crash RAM
+ * record ring as CRASH_RAM_REC_REG_DIFF records, decoded off-target by
+ * tools/crashring, which turns wrong-state-after-wake bugs into a
+ * deterministic red/green check.
+ *
+ * Each declared range carries the resume stages it is valid for: the
+ * GIC distributor is hardware-retained across CSTOP but rebuilt from
+ * scratch after STANDBY, before the non-secure OS restored its own
+ * interrupt state, so diffing it on the STANDBY path would only report
+ * that difference.
+ */
+
+/* Resume stages a declared range is verified on */
+#define REG_SHADOW_STAGE_CSTOP		BIT(0)
+#define REG_SHADOW_STAGE_STANDBY	BIT(1)
+
+/* Snapshot the declared ranges; called on low power entry */
+void stm32mp1_reg_shadow_capture(void);
+
+/* Diff the declared ranges valid for @stage against the snapshot */
+void stm32mp1_reg_shadow_verify(unsigned int stage);
+
+#endif /* STM32MP1_REG_SHADOW_H */
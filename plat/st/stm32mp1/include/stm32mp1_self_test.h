@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2021, STMicroelectronics - All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef STM32MP1_SELF_TEST_H
+#define STM32MP1_SELF_TEST_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <lib/utils_def.h>
+
+/*
+ * Golden-image self-test, built with STM32MP_SELF_TEST=1.
+ *
+ * A remote "why does this unit boot slowly" investigation arms the
+ * request bit below through the STM32_SMC_SELF_TEST SiP call and
+ * reboots the unit. The next BL2 sees the bit, runs bounded
+ * micro-benchmarks with the drivers it already owns - sequential
+ * storage read through the boot device, HASH peripheral digest and DDR
+ * copy, each over a fixed-size scratch window in the not-yet-loaded
+ * BL33 area - and publishes the throughput figures to sp_min in the
+ * warm handoff. The same SiP call then reads them back, splitting
+ * slow-media from slow-silicon from software regressions without
+ * booting a diagnostic OS. A figure of 0 means the test did not run
+ * (e.g. the storage benchmark on a serial-boot unit).
+ *
+ * Backup register layout:
+ *  [31:16] magic, tells a valid record from backup domain garbage
+ *  [0]     benchmark request, cleared by BL2 when it runs them
+ */
+#define SELF_TEST_BKP_REG_ID	U(18)
+#define SELF_TEST_MAGIC		U(0x5E1F)
+#define SELF_TEST_MAGIC_MASK	GENMASK(31, 16)
+#define SELF_TEST_MAGIC_SHIFT	U(16)
+#define SELF_TEST_REQUEST	BIT(0)
+
+/* Throughput figures in KB/s, filled by stm32mp1_self_test_run() */
+struct stm32mp1_self_test_result {
+	uint32_t storage_kbps;
+	uint32_t hash_kbps;
+	uint32_t ddr_kbps;
+};
+
+/* BL2 interface */
+extern struct stm32mp1_self_test_result stm32mp1_self_test_result;
+
+bool stm32mp1_self_test_requested(void);
+void stm32mp1_self_test_run(void);
+
+/* sp_min interface, implemented by the SiP service */
+void self_test_svc_set_results(uint32_t storage_kbps, uint32_t hash_kbps,
+			       uint32_t ddr_kbps);
+uint32_t self_test_scv_handler(u_register_t x1, uint32_t *ret2,
+			       bool *ret2_enabled);
+
+#endif /* STM32MP1_SELF_TEST_H */
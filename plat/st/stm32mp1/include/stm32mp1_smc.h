@@ -99,6 +99,18 @@
  */
 #define STM32_SMC_AUTO_STOP		0x8200100a
 
+/*
+ * SIP function STM32_SMC_SELF_TEST - golden-image throughput self-test,
+ * available when the firmware is built with STM32MP_SELF_TEST=1.
+ *
+ * Argument a0: (input) SMCC ID.
+ *		(output) Status return code.
+ * Argument a1: (input) Service ID (STM32_SMC_SELF_TEST_xxx).
+ * Argument a2: (output) Requested figure in KB/s, 0 when the benchmark
+ *		did not run. Not applicable to the request service.
+ */
+#define STM32_SMC_SELF_TEST		0x8200100b
+
 /*
  * SIP function STM32_SIP_SVC_FUNC_SCMI_AGENT0/1
  *
@@ -156,16 +168,28 @@
 #define STM32_SMC_READ_ALL		0x05
 #define STM32_SMC_WRITE_ALL		0x06
 #define STM32_SMC_WRLOCK_OTP		0x07
+/*
+ * Bulk shadow read: a2 is a 4-byte aligned non-secure buffer address,
+ * a3 packs the first OTP word index in [15:0] and the word count in
+ * [31:16]. Words the non-secure world may not access are zero-filled.
+ */
+#define STM32_SMC_READ_SHADOW_BULK	0x08
 
 /* Service ID for STM32_SMC_RCC_OPP */
 #define STM32_SMC_RCC_OPP_SET		0x0
 #define STM32_SMC_RCC_OPP_ROUND		0x1
 
+/* Service ID for STM32_SMC_SELF_TEST */
+#define STM32_SMC_SELF_TEST_REQUEST	0x0
+#define STM32_SMC_SELF_TEST_STORAGE_KBPS	0x1
+#define STM32_SMC_SELF_TEST_HASH_KBPS	0x2
+#define STM32_SMC_SELF_TEST_DDR_KBPS	0x3
+
 /* STM32 SiP Service Calls version numbers */
 #define STM32_SIP_SVC_VERSION_MAJOR	0x0
 #define STM32_SIP_SVC_VERSION_MINOR	0x1
 
 /* Number of STM32 SiP Calls implemented */
-#define STM32_COMMON_SIP_NUM_CALLS	13
+#define STM32_COMMON_SIP_NUM_CALLS	14
 
 #endif /* STM32MP1_SMC_H */
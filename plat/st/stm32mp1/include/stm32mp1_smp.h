@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef STM32MP1_SMP_H
+#define STM32MP1_SMP_H
+
+#include <stdbool.h>
+
+#if STM32MP_BL2_SMP
+/*
+ * Release the secondary Cortex-A7 core from the ROM holding pen and let it
+ * run a worker loop executing jobs queued by the primary core. Jobs run in
+ * submission order, one at a time, and must be self-contained CPU-bound work
+ * (hashing, decompression, copies): they must not touch clocks, resets or
+ * other shared peripherals.
+ */
+void stm32mp1_bl2_smp_start(void);
+
+/*
+ * Drain the job queue and send the secondary core back to the ROM holding
+ * pen, as the PSCI layer in BL32 expects to find it. Called from
+ * bl2_el3_plat_prepare_exit(), may be called when SMP was never started.
+ */
+void stm32mp1_bl2_smp_stop(void);
+
+bool stm32mp1_bl2_smp_online(void);
+
+/*
+ * Queue a job on the worker, or run it in place when the worker is offline.
+ * Blocks while the queue is full.
+ */
+void stm32mp1_bl2_smp_submit(void (*fn)(void *arg), void *arg);
+
+/* Wait until every queued job has completed */
+void stm32mp1_bl2_smp_wait(void);
+#else
+static inline void stm32mp1_bl2_smp_start(void)
+{
+}
+
+static inline void stm32mp1_bl2_smp_stop(void)
+{
+}
+
+static inline bool stm32mp1_bl2_smp_online(void)
+{
+	return false;
+}
+
+static inline void stm32mp1_bl2_smp_submit(void (*fn)(void *arg), void *arg)
+{
+	fn(arg);
+}
+
+static inline void stm32mp1_bl2_smp_wait(void)
+{
+}
+#endif /* STM32MP_BL2_SMP */
+
+#endif /* STM32MP1_SMP_H */
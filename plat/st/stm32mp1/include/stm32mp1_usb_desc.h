@@ -8,9 +8,7 @@
 #define STM32MP1_USB_DESC_H
 
 #include <lib/usb/usb_core.h>
-
-/* Max DFU Packet Size = 1024 bytes */
-#define USBD_DFU_XFER_SIZE	1024
+#include <lib/usb/usb_st_dfu.h>
 
 #define TRANSFER_SIZE_BYTES(size) \
 	((uint8_t)((size) & 0xFF)), /* XFERSIZEB0 */\
@@ -8,6 +8,9 @@
 
 #include <common/bl_common.h>
 #include <common/desc_image_load.h>
+#if MEASURED_BOOT
+#include <common/measured_boot.h>
+#endif
 #include <lib/mmio.h>
 #include <plat/common/platform.h>
 
@@ -77,11 +80,15 @@ bl_load_info_t *plat_get_bl_image_load_info(void)
 		stm32mp_clk_disable(RTCAPB);
 	}
 
-	/* Max size is non-secure DDR end address minus image_base */
+	/*
+	 * Max size is non-secure DDR end address minus image_base, minus the
+	 * page reserved for the measured boot event log when enabled.
+	 */
 	bl33->image_info.image_max_size = STM32MP_DDR_BASE +
 					  dt_get_ddr_size() -
 					  STM32MP_DDR_S_SIZE -
 					  STM32MP_DDR_SHMEM_SIZE -
+					  STM32MP_MEASURED_BOOT_LOG_SIZE -
 					  bl33->image_info.image_base;
 
 	return get_bl_load_info_from_mem_params_desc();
@@ -92,5 +99,21 @@ bl_load_info_t *plat_get_bl_image_load_info(void)
  ******************************************************************************/
 bl_params_t *plat_get_next_bl_params(void)
 {
-	return get_next_bl_params_from_mem_params_desc();
+	bl_params_t *params = get_next_bl_params_from_mem_params_desc();
+
+#if MEASURED_BOOT
+	bl_mem_params_node_t *bl33 = get_bl_mem_params_node(BL33_IMAGE_ID);
+	uintptr_t log_base = bl33->image_info.image_base +
+			     bl33->image_info.image_max_size;
+
+	/*
+	 * Publish the event log in the non-secure page reserved above the
+	 * BL33 image range and pass the aux parameter list head to BL33.
+	 */
+	bl33->ep_info.args.arg1 =
+		measured_boot_publish(log_base,
+				      STM32MP_MEASURED_BOOT_LOG_SIZE);
+#endif
+
+	return params;
 }
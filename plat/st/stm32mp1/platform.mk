@@ -55,6 +55,113 @@ STM32MP_SPI_NOR		?=	0
 STM32MP_UART_PROGRAMMER	?=	0
 STM32MP_USB_PROGRAMMER	?=	0
 
+# Pre-resolve the DT node offsets from the built DTB so that boot time
+# compatible lookups become array reads, keeping the runtime parser as a
+# fallback when the loaded DTB does not match.
+STM32MP_DT_PREBUILT_OFFSETS	?=	0
+$(eval $(call assert_boolean,STM32MP_DT_PREBUILT_OFFSETS))
+$(eval $(call add_define,STM32MP_DT_PREBUILT_OFFSETS))
+
+# Release the secondary Cortex-A7 core during BL2 to run queued jobs
+# (hashing, decompression, copies) while the primary core drives storage I/O.
+STM32MP_BL2_SMP		?=	0
+$(eval $(call assert_boolean,STM32MP_BL2_SMP))
+$(eval $(call add_define,STM32MP_BL2_SMP))
+
+# Record named boot checkpoints from BL2 entry to the end of the sp_min setup
+# in a reserved DDR page and expose them to the non-secure world through the
+# PMF "get timestamp" SMC. Requires ENABLE_PMF.
+STM32MP_BOOT_TIMELINE	?=	0
+$(eval $(call assert_boolean,STM32MP_BOOT_TIMELINE))
+$(eval $(call add_define,STM32MP_BOOT_TIMELINE))
+ifeq (${STM32MP_BOOT_TIMELINE},1)
+ifneq (${ENABLE_PMF},1)
+$(error "STM32MP_BOOT_TIMELINE=1 requires ENABLE_PMF=1")
+endif
+endif
+
+# Boot from one of two image copies (banks) on MTD devices, selected by a
+# TAMP backup register record with automatic demotion of a failing bank.
+STM32MP_BOOT_BANK	?=	0
+$(eval $(call assert_boolean,STM32MP_BOOT_BANK))
+$(eval $(call add_define,STM32MP_BOOT_BANK))
+
+# Track the BL2 stage being executed and per-stage budget overruns in a TAMP
+# backup register, so a blind IWDG reset in the field can be attributed to a
+# boot stage by reading a single register on the next boot.
+STM32MP_BOOT_DEADLINE	?=	0
+$(eval $(call assert_boolean,STM32MP_BOOT_DEADLINE))
+$(eval $(call add_define,STM32MP_BOOT_DEADLINE))
+
+# Record the digest of the BL33 image authenticated by BL2 in Backup SRAM and
+# have the PSCI SYSTEM_RESET2 fast reboot path verify the staged image against
+# it, instead of accepting any staged image without re-authentication.
+STM32MP_FAST_REBOOT_AUTH	?=	0
+$(eval $(call assert_boolean,STM32MP_FAST_REBOOT_AUTH))
+$(eval $(call add_define,STM32MP_FAST_REBOOT_AUTH))
+
+# Serve the sp_min runtime console scope from a DMA-fed multi-lane TX queue
+# on the console UART, so bulk diagnostics (binary log drains, PMF dumps)
+# stream at wire speed without a polled TX loop. Panic output falls back to
+# polled TX. The DMA stream used must be reserved to the secure world.
+STM32MP_UART_DMA	?=	0
+$(eval $(call assert_boolean,STM32MP_UART_DMA))
+$(eval $(call add_define,STM32MP_UART_DMA))
+
+# Run a short DDR bandwidth/latency micro-benchmark after cold boot DDR
+# training, export the results through the boot timeline service and retrain
+# once when a per-board threshold from the device tree is not met.
+STM32MP_DDR_BENCHMARK	?=	0
+$(eval $(call assert_boolean,STM32MP_DDR_BENCHMARK))
+$(eval $(call add_define,STM32MP_DDR_BENCHMARK))
+
+# Process SCMI messages in place in the SMT mailbox instead of bouncing the
+# payload through a secure buffer. The non-secure mailbox RAM is then mapped
+# cacheable and the SMT driver performs the explicit cache maintenance.
+SCMI_SMT_ZERO_COPY	?=	0
+$(eval $(call assert_boolean,SCMI_SMT_ZERO_COPY))
+$(eval $(call add_define,SCMI_SMT_ZERO_COPY))
+
+# Ramp the SDMMC bus clock from the conservative device tree rate towards the
+# specification ceiling of the selected mode, stepping up after error-free
+# transfers and falling back on data errors. The proven rate is cached in a
+# TAMP backup register and applied directly on the next boot.
+STM32MP_SDMMC_ADAPTIVE_CLK	?=	0
+$(eval $(call assert_boolean,STM32MP_SDMMC_ADAPTIVE_CLK))
+$(eval $(call add_define,STM32MP_SDMMC_ADAPTIVE_CLK))
+
+# Golden-image self-test: a SiP call arms a benchmark request in a TAMP
+# backup register, the next BL2 runs bounded storage/hash/DDR copy
+# micro-benchmarks with its own drivers and the throughput figures are read
+# back through the same SiP call, for in-situ slow-boot diagnosis.
+STM32MP_SELF_TEST	?=	0
+$(eval $(call assert_boolean,STM32MP_SELF_TEST))
+$(eval $(call add_define,STM32MP_SELF_TEST))
+
+# Hysteresis on runtime peripheral clock gating: a gate whose refcount drops
+# to zero is only marked pending-off and a deferred timer multiplexer sweep
+# commits the disable, so that rapid non-secure disable/enable sequences do
+# not thrash the RCC enable registers. The delay is in generic timer ticks.
+STM32MP_CLK_LAZY_GATE	?=	0
+$(eval $(call assert_boolean,STM32MP_CLK_LAZY_GATE))
+$(eval $(call add_define,STM32MP_CLK_LAZY_GATE))
+STM32MP_CLK_LAZY_GATE_TICKS	?=	48000
+$(eval $(call add_define,STM32MP_CLK_LAZY_GATE_TICKS))
+
+# Debug facility: snapshot a declared set of RCC/GICD/TZC/ETZPC register
+# ranges into a reserved DDR block on low power entry and diff it against
+# the live registers after resume. Mismatches are recorded in the crash
+# RAM ring (decoded off-target by tools/crashring), turning
+# wrong-state-after-wake bugs into a deterministic red/green check.
+STM32MP_REG_SHADOW	?=	0
+$(eval $(call assert_boolean,STM32MP_REG_SHADOW))
+$(eval $(call add_define,STM32MP_REG_SHADOW))
+ifeq (${STM32MP_REG_SHADOW},1)
+ifneq (${CRASH_RAM_CAPTURE},1)
+$(error "STM32MP_REG_SHADOW=1 requires CRASH_RAM_CAPTURE=1")
+endif
+endif
+
 ifeq ($(filter 1,${STM32MP_EMMC} ${STM32MP_SDMMC} ${STM32MP_RAW_NAND} \
 	${STM32MP_SPI_NAND} ${STM32MP_SPI_NOR} ${STM32MP_UART_PROGRAMMER} \
 	${STM32MP_USB_PROGRAMMER}),)
@@ -106,6 +213,7 @@ PLAT_BL_COMMON_SOURCES	+=	drivers/arm/tzc/tzc400.c				\
 				drivers/delay_timer/generic_delay_timer.c		\
 				drivers/st/bsec/bsec2.c					\
 				drivers/st/clk/stm32mp_clkfunc.c			\
+				drivers/st/clk/stm32mp_wait_calib.c			\
 				drivers/st/clk/stm32mp1_clk.c				\
 				drivers/st/ddr/stm32mp1_ddr_helpers.c			\
 				drivers/st/gpio/stm32_gpio.c				\
@@ -124,15 +232,21 @@ PLAT_BL_COMMON_SOURCES	+=	drivers/arm/tzc/tzc400.c				\
 				plat/st/stm32mp1/stm32mp1_security.c			\
 				plat/st/stm32mp1/stm32mp1_syscfg.c
 
-BL2_SOURCES		+=	drivers/io/io_block.c					\
+BL2_SOURCES		+=	drivers/console/console_buffered.c			\
+				drivers/io/io_block.c					\
 				drivers/io/io_dummy.c					\
 				drivers/io/io_mtd.c					\
 				drivers/io/io_storage.c					\
 				drivers/st/crypto/stm32_hash.c				\
 				drivers/st/io/io_stm32image.c				\
+				lib/mempool/mempool.c					\
 				plat/st/common/bl2_io_storage.c				\
 				plat/st/stm32mp1/bl2_plat_setup.c
 
+ifeq (${STM32MP_SELF_TEST},1)
+BL2_SOURCES		+=	plat/st/stm32mp1/stm32mp1_self_test.c
+endif
+
 ifeq (${TRUSTED_BOARD_BOOT},1)
 AUTH_SOURCES		:=	drivers/auth/auth_mod.c					\
 				drivers/auth/crypto_mod.c				\
@@ -143,6 +257,10 @@ BL2_SOURCES		+= 	$(AUTH_SOURCES)						\
 				plat/st/common/stm32mp_crypto_lib.c			\
 				plat/st/common/stm32mp_img_parser_lib.c			\
 				plat/st/common/stm32mp_trusted_boot.c
+
+ifeq (${MEASURED_BOOT},1)
+BL2_SOURCES		+=	common/measured_boot.c
+endif
 endif
 
 ifneq ($(filter 1,${STM32MP_EMMC} ${STM32MP_SDMMC}),)
@@ -192,6 +310,23 @@ BL2_SOURCES		+=	common/desc_image_load.c				\
 				plat/st/stm32mp1/plat_bl2_mem_params_desc.c		\
 				plat/st/stm32mp1/plat_image_load.c
 
+ifeq (${STM32MP_BL2_SMP},1)
+BL2_SOURCES		+=	plat/st/stm32mp1/stm32mp1_bl2_smp.S			\
+				plat/st/stm32mp1/stm32mp1_bl2_smp.c
+endif
+
+ifeq (${STM32MP_BOOT_TIMELINE},1)
+BL2_SOURCES		+=	plat/st/stm32mp1/stm32mp1_boot_timeline.c
+endif
+
+ifeq (${STM32MP_BOOT_DEADLINE},1)
+BL2_SOURCES		+=	plat/st/stm32mp1/stm32mp1_boot_deadline.c
+endif
+
+ifeq (${STM32MP_BOOT_BANK},1)
+BL2_SOURCES		+=	plat/st/stm32mp1/stm32mp1_boot_bank.c
+endif
+
 ifeq (${STM32MP_USB_PROGRAMMER},1)
 BL2_SOURCES		+=	drivers/st/io/io_programmer_st_usb.c			\
 				drivers/st/usb_dwc2/usb_dwc2.c				\
@@ -245,6 +380,30 @@ ${STM32IMAGE}: ${STM32IMAGE_SRC}
 clean_stm32image:
 	${Q}${MAKE} --no-print-directory -C ${STM32IMAGEPATH} clean
 
+ifeq (${STM32MP_DT_PREBUILT_OFFSETS},1)
+# Generate the pre-resolved DT node offset table from the built DTB
+STM32DTMAPPATH		?= tools/stm32dtmap
+STM32DTMAP		?= ${STM32DTMAPPATH}/stm32dtmap${BIN_EXT}
+STM32DTMAP_SRC		:= ${STM32DTMAPPATH}/stm32dtmap.c
+STM32_DT_MAP_SRC	:= ${BUILD_PLAT}/stm32mp_dt_map.c
+
+PLAT_BL_COMMON_SOURCES	+=	${STM32_DT_MAP_SRC}
+
+.PHONY: clean_stm32dtmap
+
+distclean realclean clean: clean_stm32dtmap
+
+${STM32DTMAP}: ${STM32DTMAP_SRC}
+	${Q}${MAKE} CPPFLAGS="" --no-print-directory -C ${STM32DTMAPPATH}
+
+clean_stm32dtmap:
+	${Q}${MAKE} --no-print-directory -C ${STM32DTMAPPATH} clean
+
+${STM32_DT_MAP_SRC}: ${STM32DTMAP} ${STM32_TF_DTBFILE}
+	@echo "  GEN     $@"
+	${Q}${STM32DTMAP} ${STM32_TF_DTBFILE} $@
+endif
+
 check_dtc_version:
 	$(eval DTC_V = $(shell $(DTC) -v | awk '{print $$NF}'))
 	$(eval DTC_VERSION = $(shell printf "%d" $(shell echo ${DTC_V} | cut -d- -f1 | sed "s/\./0/g")))
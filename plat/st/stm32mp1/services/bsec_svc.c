@@ -108,6 +108,34 @@ static enum bsec_ssp_status bsec_check_ssp(uint32_t otp, uint32_t update)
 	return BSEC_NO_SSP;
 }
 
+/*
+ * Copy a range of OTP shadow registers into a non-secure buffer. Words
+ * the non-secure world may not access are zero-filled instead of failing
+ * the whole call, as in the READ_ALL service.
+ */
+static uint32_t bsec_read_shadow_bulk(uint32_t *buf, uint32_t first,
+				      uint32_t count)
+{
+	uint32_t i;
+
+	for (i = 0U; i < count; i++) {
+		uint32_t otp = first + i;
+		uint32_t result;
+
+		if (bsec_check_nsec_access_rights(otp) != BSEC_OK) {
+			buf[i] = 0U;
+			continue;
+		}
+
+		result = bsec_read_otp(&buf[i], otp);
+		if (result != BSEC_OK) {
+			return result;
+		}
+	}
+
+	return BSEC_OK;
+}
+
 #if STM32MP_USB_PROGRAMMER || STM32MP_UART_PROGRAMMER
 static uint32_t bsec_read_all_bsec(struct otp_exchange *exchange)
 {
@@ -404,12 +432,17 @@ uint32_t bsec_main(uint32_t x1, uint32_t x2, uint32_t x3,
 {
 	uint32_t result;
 	uint32_t tmp_data = 0U;
+	uint32_t bulk_first;
+	uint32_t bulk_count;
+	uintptr_t bulk_begin;
+	size_t bulk_size;
 	struct otp_exchange *otp_exch __unused;
 	uintptr_t map_begin __unused;
 	size_t map_size __unused = PAGE_SIZE;
 	int ret __unused;
 
 	if ((x1 != STM32_SMC_READ_ALL) && (x1 != STM32_SMC_WRITE_ALL) &&
+	    (x1 != STM32_SMC_READ_SHADOW_BULK) &&
 	    (bsec_check_nsec_access_rights(x2) != BSEC_OK)) {
 		return STM32_SMC_INVALID_PARAMS;
 	}
@@ -498,6 +531,36 @@ uint32_t bsec_main(uint32_t x1, uint32_t x2, uint32_t x3,
 		result = bsec_write_all_bsec(otp_exch, ret_otp_value);
 		break;
 #endif
+	case STM32_SMC_READ_SHADOW_BULK:
+		*ret_otp_value = 0U;
+		bulk_first = x3 & 0xFFFFU;
+		bulk_count = x3 >> 16;
+
+		if ((bulk_count == 0U) || ((x2 & 3U) != 0U) ||
+		    (bulk_first > STM32MP1_OTP_MAX_ID) ||
+		    (bulk_count > (STM32MP1_OTP_MAX_ID - bulk_first + 1U))) {
+			return STM32_SMC_INVALID_PARAMS;
+		}
+
+		bulk_begin = round_down(x2, PAGE_SIZE);
+		bulk_size = round_up(x2 + (bulk_count * sizeof(uint32_t)),
+				     PAGE_SIZE) - bulk_begin;
+
+		ret = mmap_add_dynamic_region(bulk_begin, bulk_begin,
+					      bulk_size,
+					      MT_MEMORY | MT_RW | MT_NS);
+		assert(ret == 0);
+
+		if (ddr_is_nonsecured_area(bulk_begin, bulk_size)) {
+			result = bsec_read_shadow_bulk((uint32_t *)(uintptr_t)x2,
+						       bulk_first, bulk_count);
+		} else {
+			result = BSEC_ERROR;
+		}
+
+		ret = mmap_remove_dynamic_region(bulk_begin, bulk_size);
+		assert(ret == 0);
+		break;
 	case STM32_SMC_WRLOCK_OTP:
 		result = bsec_permanent_lock_otp(x2);
 		break;
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2021, STMicroelectronics - All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <platform_def.h>
+
+#include <drivers/st/stm32mp_clkfunc.h>
+#include <dt-bindings/clock/stm32mp1-clks.h>
+#include <lib/mmio.h>
+
+#include <stm32mp1_self_test.h>
+#include <stm32mp1_smc.h>
+
+/*
+ * Runtime half of the golden-image self-test (see stm32mp1_self_test.h):
+ * arms the next-boot benchmark request in the backup register and hands
+ * out the figures BL2 published in the warm handoff.
+ */
+static struct stm32mp1_self_test_result results;
+
+void self_test_svc_set_results(uint32_t storage_kbps, uint32_t hash_kbps,
+			       uint32_t ddr_kbps)
+{
+	results.storage_kbps = storage_kbps;
+	results.hash_kbps = hash_kbps;
+	results.ddr_kbps = ddr_kbps;
+}
+
+static void self_test_request(void)
+{
+	stm32mp_clk_enable(RTCAPB);
+	mmio_write_32(tamp_bkpr(SELF_TEST_BKP_REG_ID),
+		      (SELF_TEST_MAGIC << SELF_TEST_MAGIC_SHIFT) |
+		      SELF_TEST_REQUEST);
+	stm32mp_clk_disable(RTCAPB);
+}
+
+uint32_t self_test_scv_handler(u_register_t x1, uint32_t *ret2,
+			       bool *ret2_enabled)
+{
+	switch (x1) {
+	case STM32_SMC_SELF_TEST_REQUEST:
+		self_test_request();
+		return STM32_SMC_OK;
+
+	case STM32_SMC_SELF_TEST_STORAGE_KBPS:
+		*ret2 = results.storage_kbps;
+		break;
+
+	case STM32_SMC_SELF_TEST_HASH_KBPS:
+		*ret2 = results.hash_kbps;
+		break;
+
+	case STM32_SMC_SELF_TEST_DDR_KBPS:
+		*ret2 = results.ddr_kbps;
+		break;
+
+	default:
+		return STM32_SMC_INVALID_PARAMS;
+	}
+
+	*ret2_enabled = true;
+
+	return STM32_SMC_OK;
+}
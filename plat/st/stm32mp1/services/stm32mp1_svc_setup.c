@@ -10,10 +10,15 @@
 #include <common/debug.h>
 #include <common/runtime_svc.h>
 #include <drivers/st/scmi-msg.h>
+#include <lib/pmf/pmf.h>
 #include <lib/psci/psci.h>
+#include <lib/utils_def.h>
 #include <tools_share/uuid.h>
 
 #include <stm32mp1_low_power.h>
+#if STM32MP_SELF_TEST
+#include <stm32mp1_self_test.h>
+#endif
 #include <stm32mp1_smc.h>
 
 #include "bsec_svc.h"
@@ -26,9 +31,106 @@ DEFINE_SVC_UUID2(stm32_sip_svc_uid,
 		 0xa778aa50, 0xf49b, 0x144a, 0x8a, 0x5e,
 		 0x26, 0x4d, 0x59, 0x94, 0xc2, 0x14);
 
+/*
+ * The STM32_SMC_xxx functions are allocated contiguously from
+ * STM32_SMC_RCC, so their handler is found with a single bounds-checked
+ * index into a dense table rather than a compare chain on the fast SMC
+ * entry path shared with PSCI. Unallocated IDs leave NULL holes.
+ */
+typedef uint32_t (*stm32_sip_handler_t)(u_register_t x1, u_register_t x2,
+					u_register_t x3, uint32_t *ret2,
+					bool *ret2_enabled);
+
+static uint32_t sip_smc_bsec(u_register_t x1, u_register_t x2,
+			     u_register_t x3, uint32_t *ret2,
+			     bool *ret2_enabled)
+{
+	*ret2_enabled = true;
+
+	return bsec_main(x1, x2, x3, ret2);
+}
+
+static uint32_t sip_smc_rcc(u_register_t x1, u_register_t x2,
+			    u_register_t x3, uint32_t *ret2 __unused,
+			    bool *ret2_enabled __unused)
+{
+	return rcc_scv_handler(x1, x2, x3);
+}
+
+static uint32_t sip_smc_rcc_cal(u_register_t x1, u_register_t x2 __unused,
+				u_register_t x3 __unused,
+				uint32_t *ret2 __unused,
+				bool *ret2_enabled __unused)
+{
+	return rcc_cal_scv_handler(x1);
+}
+
+static uint32_t sip_smc_rcc_opp(u_register_t x1, u_register_t x2,
+				u_register_t x3 __unused, uint32_t *ret2,
+				bool *ret2_enabled)
+{
+	*ret2_enabled = true;
+
+	return rcc_opp_scv_handler(x1, x2, ret2);
+}
+
+static uint32_t sip_smc_pwr(u_register_t x1, u_register_t x2,
+			    u_register_t x3, uint32_t *ret2 __unused,
+			    bool *ret2_enabled __unused)
+{
+	return pwr_scv_handler(x1, x2, x3);
+}
+
+static uint32_t sip_smc_pd_domain(u_register_t x1, u_register_t x2,
+				  u_register_t x3 __unused,
+				  uint32_t *ret2 __unused,
+				  bool *ret2_enabled __unused)
+{
+	return pm_domain_scv_handler(x1, x2);
+}
+
+static uint32_t sip_smc_auto_stop(u_register_t x1 __unused,
+				  u_register_t x2 __unused,
+				  u_register_t x3 __unused,
+				  uint32_t *ret2 __unused,
+				  bool *ret2_enabled __unused)
+{
+	stm32_auto_stop();
+
+	return STM32_SMC_OK;
+}
+
+#if STM32MP_SELF_TEST
+static uint32_t sip_smc_self_test(u_register_t x1, u_register_t x2 __unused,
+				  u_register_t x3 __unused, uint32_t *ret2,
+				  bool *ret2_enabled)
+{
+	return self_test_scv_handler(x1, ret2, ret2_enabled);
+}
+#endif
+
+static const stm32_sip_handler_t stm32_sip_handler[] = {
+	[STM32_SMC_RCC - STM32_SMC_RCC] = sip_smc_rcc,
+	[STM32_SMC_PWR - STM32_SMC_RCC] = sip_smc_pwr,
+	[STM32_SMC_RCC_CAL - STM32_SMC_RCC] = sip_smc_rcc_cal,
+	[STM32_SMC_BSEC - STM32_SMC_RCC] = sip_smc_bsec,
+	[STM32_SMC_PD_DOMAIN - STM32_SMC_RCC] = sip_smc_pd_domain,
+	[STM32_SMC_RCC_OPP - STM32_SMC_RCC] = sip_smc_rcc_opp,
+	[STM32_SMC_AUTO_STOP - STM32_SMC_RCC] = sip_smc_auto_stop,
+#if STM32MP_SELF_TEST
+	[STM32_SMC_SELF_TEST - STM32_SMC_RCC] = sip_smc_self_test,
+#endif
+};
+
 /* Setup STM32MP1 Standard Services */
 static int32_t stm32mp1_svc_setup(void)
 {
+#if ENABLE_PMF
+	if (pmf_setup() != 0) {
+		return 1;
+	}
+#endif
+
 	/*
 	 * PSCI is the only specification implemented as a Standard Service.
 	 * Invoke PSCI setup from here.
@@ -46,8 +148,25 @@ static uintptr_t stm32mp1_svc_smc_handler(uint32_t smc_fid, u_register_t x1,
 					  void *handle, u_register_t flags)
 {
 	uint32_t ret1 = 0U, ret2 = 0U;
+	uint32_t fn_index;
 	bool ret_uid = false, ret2_enabled = false;
 
+#if ENABLE_PMF
+	/* Dispatch PMF calls to the PMF SMC handler */
+	if (is_pmf_fid(smc_fid)) {
+		return pmf_smc_handler(smc_fid, x1, x2, x3, x4, cookie,
+				       handle, flags);
+	}
+#endif
+
+	fn_index = smc_fid - STM32_SMC_RCC;
+	if ((fn_index < ARRAY_SIZE(stm32_sip_handler)) &&
+	    (stm32_sip_handler[fn_index] != NULL)) {
+		ret1 = stm32_sip_handler[fn_index](x1, x2, x3, &ret2,
+						   &ret2_enabled);
+		goto exit;
+	}
+
 	switch (smc_fid) {
 	case STM32_SIP_SVC_CALL_COUNT:
 		ret1 = STM32_COMMON_SIP_NUM_CALLS;
@@ -65,37 +184,6 @@ static uintptr_t stm32mp1_svc_smc_handler(uint32_t smc_fid, u_register_t x1,
 		ret2_enabled = true;
 		break;
 
-	case STM32_SMC_BSEC:
-		ret1 = bsec_main(x1, x2, x3, &ret2);
-		ret2_enabled = true;
-		break;
-
-	case STM32_SMC_RCC:
-		ret1 = rcc_scv_handler(x1, x2, x3);
-		break;
-
-	case STM32_SMC_RCC_CAL:
-		ret1 = rcc_cal_scv_handler(x1);
-		break;
-
-	case STM32_SMC_RCC_OPP:
-		ret1 = rcc_opp_scv_handler(x1, x2, &ret2);
-		ret2_enabled = true;
-		break;
-
-	case STM32_SMC_PWR:
-		ret1 = pwr_scv_handler(x1, x2, x3);
-		break;
-
-	case STM32_SMC_PD_DOMAIN:
-		ret1 = pm_domain_scv_handler(x1, x2);
-		break;
-
-	case STM32_SMC_AUTO_STOP:
-		stm32_auto_stop();
-		ret1 = STM32_SMC_OK;
-		break;
-
 	case STM32_SMC_SCMI_MESSAGE_AGENT0:
 		scmi_smt_fastcall_smc_entry(0U);
 		ret1 = STM32_SMC_OK;
@@ -111,6 +199,8 @@ static uintptr_t stm32mp1_svc_smc_handler(uint32_t smc_fid, u_register_t x1,
 		break;
 	}
 
+exit:
+
 	if (ret_uid) {
 		SMC_UUID_RET(handle, stm32_sip_svc_uid);
 	}
@@ -6,13 +6,21 @@
 
 SP_MIN_WITH_SECURE_FIQ	:=	1
 
+SP_MIN_LAZY_FP_CONTEXT	:=	1
+
+SP_MIN_FAST_SMC		:=	1
+
 BL32_SOURCES		+=	plat/common/aarch32/platform_mp_stack.S		\
+				drivers/console/console_buffered.c		\
 				drivers/st/clk/stm32mp1_calib.c			\
 				drivers/st/etzpc/etzpc.c			\
+				drivers/st/regscript/stm32_reg_script.c		\
 				drivers/st/rng/stm32_rng.c			\
 				drivers/st/rtc/stm32_rtc.c			\
 				drivers/st/tamper/stm32_tamp.c			\
 				drivers/st/timer/stm32_timer.c 			\
+				lib/timer_mux/timer_mux.c			\
+				plat/st/stm32mp1/sp_min/sp_min_fast_smc.c	\
 				plat/st/stm32mp1/sp_min/sp_min_setup.c		\
 				plat/st/stm32mp1/stm32mp1_low_power.c		\
 				plat/st/stm32mp1/stm32mp1_pm.c			\
@@ -29,6 +37,33 @@ BL32_SOURCES		+=	drivers/arm/gic/common/gic_common.c	\
 # Generic PSCI
 BL32_SOURCES		+=	plat/common/plat_psci_common.c
 
+# BL2 -> sp_min warm handoff parameter list
+BL32_SOURCES		+=	lib/bl_aux_params/bl_aux_params.c
+
+ifeq (${ENABLE_PMF},1)
+BL32_SOURCES		+=	lib/pmf/pmf_smc.c
+endif
+
+ifeq (${STM32MP_BOOT_TIMELINE},1)
+BL32_SOURCES		+=	plat/st/stm32mp1/stm32mp1_boot_timeline.c
+endif
+
+ifeq (${STM32MP_FAST_REBOOT_AUTH},1)
+BL32_SOURCES		+=	drivers/st/crypto/stm32_hash.c
+endif
+
+ifeq (${STM32MP_UART_DMA},1)
+BL32_SOURCES		+=	drivers/st/uart/stm32_uart_dma.c
+endif
+
+ifeq (${STM32MP_SELF_TEST},1)
+BL32_SOURCES		+=	plat/st/stm32mp1/services/self_test_svc.c
+endif
+
+ifeq (${STM32MP_REG_SHADOW},1)
+BL32_SOURCES		+=	plat/st/stm32mp1/stm32mp1_reg_shadow.c
+endif
+
 # stm32mp1 specific services
 BL32_SOURCES		+=	plat/st/stm32mp1/services/bsec_svc.c		\
 				plat/st/stm32mp1/services/low_power_svc.c	\
@@ -40,6 +75,9 @@ BL32_SOURCES		+=	plat/st/stm32mp1/services/bsec_svc.c		\
 BL32_SOURCES		+=	drivers/st/scmi-msg/base.c		\
 				drivers/st/scmi-msg/clock.c		\
 				drivers/st/scmi-msg/entry.c		\
+				drivers/st/scmi-msg/perf_domain.c	\
 				drivers/st/scmi-msg/reset_domain.c	\
 				drivers/st/scmi-msg/smt.c		\
+				drivers/st/scmi-msg/voltage_domain.c	\
+				plat/st/stm32mp1/stm32mp1_ns_info.c	\
 				plat/st/stm32mp1/stm32mp1_scmi.c
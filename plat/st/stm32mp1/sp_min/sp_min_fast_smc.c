@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2021, STMicroelectronics - All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <lib/psci/psci.h>
+#include <sp_min_fast_smc.h>
+
+#include <stm32mp1_smc.h>
+
+/*
+ * Query calls answered from the SMC vector with the caller's registers
+ * untouched. These dominate the SMC mix while the normal world boots -
+ * every framework probes the PSCI and SiP revisions before using them -
+ * and their answers are build-time constants.
+ */
+const struct sp_min_fast_smc_ent sp_min_fast_smc_table[] = {
+	{
+		.fid = PSCI_VERSION,
+		.ret0 = PSCI_MAJOR_VER | PSCI_MINOR_VER,
+	},
+	{
+		.fid = STM32_SIP_SVC_CALL_COUNT,
+		.ret0 = STM32_COMMON_SIP_NUM_CALLS,
+	},
+	{
+		.fid = STM32_SIP_SVC_VERSION,
+		.ret0 = STM32_SIP_SVC_VERSION_MAJOR,
+		.ret1 = STM32_SIP_SVC_VERSION_MINOR,
+	},
+	{
+		.fid = 0U,
+	},
+};
@@ -11,10 +11,13 @@
 
 #include <arch_helpers.h>
 #include <common/bl_common.h>
+#include <common/crash_ram.h>
 #include <common/debug.h>
+#include <common/prof_trace.h>
 #include <context.h>
 #include <drivers/arm/gicv2.h>
 #include <drivers/arm/tzc400.h>
+#include <drivers/console_buffered.h>
 #include <drivers/generic_delay_timer.h>
 #include <drivers/st/bsec.h>
 #include <drivers/st/etzpc.h>
@@ -25,19 +28,50 @@
 #include <drivers/st/stm32_rtc.h>
 #include <drivers/st/stm32_tamp.h>
 #include <drivers/st/stm32_timer.h>
+#if STM32MP_UART_DMA
+#include <drivers/st/stm32_uart_dma.h>
+#endif
 #include <drivers/st/stm32mp_clkfunc.h>
 #include <drivers/st/stm32mp_pmic.h>
 #include <drivers/st/stm32mp1_clk.h>
 #include <drivers/st/stm32mp1_ddr_helpers.h>
 #include <drivers/st/stpmic1.h>
 #include <dt-bindings/clock/stm32mp1-clks.h>
+#include <lib/bl_aux_params/bl_aux_params.h>
 #include <lib/el3_runtime/context_mgmt.h>
 #include <lib/mmio.h>
+#include <lib/pmf/pmf.h>
+#include <lib/timer_mux.h>
 #include <lib/xlat_tables/xlat_tables_v2.h>
 #include <plat/common/platform.h>
 
 #include <platform_sp_min.h>
+#include <stm32mp1_boot_timeline.h>
+#include <stm32mp1_context.h>
+#include <stm32mp1_handoff.h>
+#include <stm32mp1_ns_info.h>
+#if STM32MP_SELF_TEST
+#include <stm32mp1_self_test.h>
+#endif
 #include <stm32mp1_power_config.h>
+#if STM32MP_REG_SHADOW
+#include <stm32mp1_reg_shadow.h>
+#endif
+
+/*
+ * Warm boot instrumentation: time-stamps captured along the sp_min setup
+ * phases so the wake latency from STANDBY can be broken down per phase and
+ * retrieved with the PMF SMC interface.
+ */
+#define PMF_STM32_WARMBOOT_SVC_ID	2
+#define WARMBOOT_TS_EARLY_SETUP		U(0)
+#define WARMBOOT_TS_CONSOLE_READY	U(1)
+#define WARMBOOT_TS_SECURITY_DONE	U(2)
+#define WARMBOOT_TS_SETUP_DONE		U(3)
+#define WARMBOOT_TS_TOTAL_IDS		U(4)
+
+PMF_REGISTER_SERVICE_SMC(warmboot_svc, PMF_STM32_WARMBOOT_SVC_ID,
+			 WARMBOOT_TS_TOTAL_IDS, PMF_STORE_ENABLE)
 
 /******************************************************************************
  * Placeholder variables for copying the arguments that have been passed to
@@ -46,8 +80,52 @@
 static entry_point_info_t bl33_image_ep_info;
 
 static struct console_stm32 console;
+
+/*
+ * Fast-resume state: set when the reset is a wake up from STANDBY and the
+ * configuration snapshot saved at cold boot is available, so setup phases
+ * can restore their settings instead of re-deriving them from the device
+ * tree.
+ */
+static bool wakeup_standby;
+static uint32_t resume_uart_base;
+static uint32_t resume_ddr_size;
 static void stm32mp1_tamper_action(int id);
 
+/*
+ * Settings handed off by BL2 (see stm32mp1_handoff.h), consumed on cold
+ * boot instead of re-deriving them from the device tree. Zero when the
+ * corresponding record was not published.
+ */
+static uint32_t handoff_console_base;
+static uint32_t handoff_ddr_size;
+
+static bool handoff_param_handler(struct bl_aux_param_header *param)
+{
+	switch (param->type) {
+	case BL_AUX_PARAM_STM32_CONSOLE_BASE:
+		handoff_console_base =
+			(uint32_t)((struct bl_aux_param_uint64 *)param)->value;
+		return true;
+	case BL_AUX_PARAM_STM32_DDR_SIZE:
+		handoff_ddr_size =
+			(uint32_t)((struct bl_aux_param_uint64 *)param)->value;
+		return true;
+#if STM32MP_SELF_TEST
+	case BL_AUX_PARAM_STM32_SELF_TEST: {
+		struct bl_aux_param_stm32_self_test *st =
+			(struct bl_aux_param_stm32_self_test *)param;
+
+		self_test_svc_set_results(st->storage_kbps, st->hash_kbps,
+					  st->ddr_kbps);
+		return true;
+	}
+#endif
+	default:
+		return false;
+	}
+}
+
 static const char *tamper_name[PLAT_MAX_TAMP_INT] = {
 	"RTC power domain",
 	"Temperature monitoring",
@@ -174,6 +252,105 @@ static void disable_usb_phy_regulator(void)
 	}
 }
 
+#ifdef DEBUG
+static console_buffered_t runtime_console;
+#endif
+
+#if STM32MP_UART_DMA
+static struct stm32_uart_dma dma_console;
+
+/* DMAMUX1 request line of the instance TX, 0 when not wired to DMAMUX1 */
+static uint32_t uart_tx_dma_request(uintptr_t base)
+{
+	switch (base) {
+	case USART2_BASE:
+		return 44U;
+	case USART3_BASE:
+		return 46U;
+	case UART4_BASE:
+		return 64U;
+	case UART5_BASE:
+		return 66U;
+	case USART6_BASE:
+		return 72U;
+	case UART7_BASE:
+		return 80U;
+	case UART8_BASE:
+		return 82U;
+	default:
+		return 0U;
+	}
+}
+
+/*
+ * Serve the runtime scope from the DMA-fed multi-lane console, so bulk
+ * diagnostics (binary log drains, PMF dumps) reach the wire without a
+ * polled TX loop. Boot and crash scopes stay on the polled console.
+ */
+static bool register_dma_console(uintptr_t base)
+{
+	struct stm32_uart_dma_cfg cfg = {
+		.uart_base = base,
+		.dma_base = STM32MP_UART_DMA_CTRL_BASE,
+		.stream = STM32MP_UART_DMA_STREAM,
+		.dma_clock = DMA2,
+		.dmamux_base = STM32MP_DMAMUX1_BASE,
+		.mux_chan = STM32MP_UART_DMA_MUX_CHAN,
+		.dmamux_clock = DMAMUX,
+		.request = uart_tx_dma_request(base),
+	};
+
+	if (cfg.request == 0U) {
+		WARN("No TX DMA request for UART %lx\n", base);
+		return false;
+	}
+
+	if (stm32_uart_dma_register(&cfg, &dma_console) == 0) {
+		panic();
+	}
+
+	console_set_scope(&dma_console.console, CONSOLE_FLAG_RUNTIME |
+			  CONSOLE_FLAG_TRANSLATE_CRLF);
+
+	return true;
+}
+#endif /* STM32MP_UART_DMA */
+
+static void register_console(uintptr_t base)
+{
+	unsigned int console_flags;
+
+	if (console_stm32_register(base, 0, STM32MP_UART_BAUDRATE,
+				   &console) == 0) {
+		panic();
+	}
+
+	console_flags = CONSOLE_FLAG_BOOT | CONSOLE_FLAG_CRASH |
+		CONSOLE_FLAG_TRANSLATE_CRLF;
+	console_set_scope(&console.console, console_flags);
+
+#if STM32MP_UART_DMA
+	if (register_dma_console(base)) {
+		return;
+	}
+#endif
+
+#ifdef DEBUG
+	/*
+	 * Serve the runtime scope from a buffered console so that a log
+	 * line in a PSCI or SMC handler does not stall the caller on the
+	 * UART. The rings are drained when entering idle and on crash.
+	 */
+	if (console_buffered_register(&console.console,
+				      &runtime_console) == 0) {
+		panic();
+	}
+
+	console_set_scope(&runtime_console.console, CONSOLE_FLAG_RUNTIME |
+			  CONSOLE_FLAG_TRANSLATE_CRLF);
+#endif
+}
+
 /*******************************************************************************
  * Interrupt handler for FIQ (secure IRQ)
  ******************************************************************************/
@@ -183,6 +360,9 @@ void sp_min_plat_fiq_handler(uint32_t id)
 
 	switch (id & INT_ID_MASK) {
 	case ARM_IRQ_SEC_PHY_TIMER:
+		/* One compare, many consumers: expire the timer multiplexer */
+		timer_mux_it_handler();
+		break;
 	case STM32MP1_IRQ_MCU_SEV:
 	case STM32MP1_IRQ_RCC_WAKEUP:
 		stm32mp1_calib_it_handler(id);
@@ -342,15 +522,43 @@ void sp_min_early_platform_setup2(u_register_t arg0, u_register_t arg1,
 	int result;
 	bl_params_t *params_from_bl2 = (bl_params_t *)arg0;
 
+	PMF_CAPTURE_TIMESTAMP(warmboot_svc, WARMBOOT_TS_EARLY_SETUP,
+			      PMF_NO_CACHE_MAINT);
+	boot_timeline_capture(BOOT_TL_SP_MIN_ENTRY);
+
 	/* Imprecise aborts can be masked in NonSecure */
 	write_scr(read_scr() | SCR_AW_BIT);
 
+#if ENABLE_STATIC_BRANCH
+	/*
+	 * The code must stay writable until static_branch_apply() has
+	 * rewritten the recorded branch sites in sp_min_main().
+	 */
+	mmap_add_region(BL_CODE_BASE, BL_CODE_BASE,
+			BL_CODE_END - BL_CODE_BASE,
+			MT_MEMORY | MT_RW | MT_SECURE);
+#else
 	mmap_add_region(BL_CODE_BASE, BL_CODE_BASE,
 			BL_CODE_END - BL_CODE_BASE,
 			MT_CODE | MT_SECURE);
+#endif
 
 	configure_mmu();
 
+#if PROF_INSTRUMENT
+	/* Start function tracing as soon as dynamic mappings work */
+	if (mmap_add_dynamic_region(STM32MP_PROF_TRACE_BL32_BASE,
+				    STM32MP_PROF_TRACE_BL32_BASE,
+				    STM32MP_PROF_TRACE_BL32_SIZE,
+				    MT_MEMORY | MT_RW | MT_NS) == 0) {
+		prof_trace_init(STM32MP_PROF_TRACE_BL32_BASE,
+				STM32MP_PROF_TRACE_BL32_SIZE,
+				PLATFORM_CORE_COUNT, PROF_TRACE_IMG_BL32);
+	} else {
+		WARN("Prof trace rings not mapped\n");
+	}
+#endif
+
 	assert(params_from_bl2 != NULL);
 	assert(params_from_bl2->h.type == PARAM_BL_PARAMS);
 	assert(params_from_bl2->h.version >= VERSION_2);
@@ -370,6 +578,12 @@ void sp_min_early_platform_setup2(u_register_t arg0, u_register_t arg1,
 		bl_params = bl_params->next_params_info;
 	}
 
+	/*
+	 * Collect the settings BL2 derived from the device tree, before
+	 * BL2's memory holding the records is reused.
+	 */
+	bl_aux_params_parse(arg1, handoff_param_handler);
+
 	if (dt_open_and_check() < 0) {
 		panic();
 	}
@@ -388,37 +602,76 @@ void sp_min_early_platform_setup2(u_register_t arg0, u_register_t arg1,
 
 	stm32mp1_etzpc_early_setup();
 
-	result = dt_get_stdout_uart_info(&dt_uart_info);
+	/*
+	 * PC is set to 0 when resetting after STANDBY: take the fast-resume
+	 * path when the snapshot saved at cold boot is available.
+	 */
+	wakeup_standby = (bl33_image_ep_info.pc == 0U) &&
+			 (stm32_get_resume_info(&resume_uart_base,
+						&resume_ddr_size) == 0);
+
+	if (wakeup_standby) {
+		if (resume_uart_base != 0U) {
+			register_console(resume_uart_base);
+		}
+	} else {
+		uint32_t console_base = 0U;
+
+		if (handoff_console_base != 0U) {
+			/*
+			 * BL2 already vetted this UART against the device
+			 * tree and the boot interface, and left it clocked
+			 * and configured.
+			 */
+			register_console(handoff_console_base);
+			console_base = handoff_console_base;
+		} else {
+			result = dt_get_stdout_uart_info(&dt_uart_info);
 #if STM32MP_UART_PROGRAMMER
-	stm32_get_boot_interface(&boot_itf, &boot_instance);
+			stm32_get_boot_interface(&boot_itf, &boot_instance);
 
-	if ((result > 0) && (dt_uart_info.status != 0U) &&
-	    !((boot_itf == BOOT_API_CTX_BOOT_INTERFACE_SEL_SERIAL_UART) &&
-	      (get_uart_address(boot_instance) == dt_uart_info.base))) {
+			if ((result > 0) && (dt_uart_info.status != 0U) &&
+			    !((boot_itf ==
+			       BOOT_API_CTX_BOOT_INTERFACE_SEL_SERIAL_UART) &&
+			      (get_uart_address(boot_instance) ==
+			       dt_uart_info.base))) {
 #else
-	if ((result > 0) && (dt_uart_info.status != 0U)) {
+			if ((result > 0) && (dt_uart_info.status != 0U)) {
 #endif
-		unsigned int console_flags;
-
-		if (console_stm32_register(dt_uart_info.base, 0,
-					   STM32MP_UART_BAUDRATE, &console) ==
-		    0) {
-			panic();
+				register_console(dt_uart_info.base);
+				console_base = dt_uart_info.base;
+			}
 		}
 
-		console_flags = CONSOLE_FLAG_BOOT | CONSOLE_FLAG_CRASH |
-			CONSOLE_FLAG_TRANSLATE_CRLF;
-#ifdef DEBUG
-		console_flags |= CONSOLE_FLAG_RUNTIME;
-#endif
-		console_set_scope(&console.console, console_flags);
+		/*
+		 * Save the settings so that the next wake up from STANDBY
+		 * does not derive them again.
+		 */
+		stm32_save_resume_info(console_base,
+				       (handoff_ddr_size != 0U) ?
+				       handoff_ddr_size : dt_get_ddr_size());
 	}
 
+#if CRASH_RAM_CAPTURE
+	/* Keep the Backup SRAM clocked so panic paths can capture state */
+	stm32mp_clk_enable(BKPSRAM);
+	crash_ram_init();
+#endif
+
+	PMF_CAPTURE_TIMESTAMP(warmboot_svc, WARMBOOT_TS_CONSOLE_READY,
+			      PMF_NO_CACHE_MAINT);
+
 	if (dt_pmic_status() > 0) {
 		initialize_pmic();
 	}
 
-	disable_usb_phy_regulator();
+	if (!wakeup_standby) {
+		/*
+		 * On wake up from STANDBY the USB PHY regulator was left
+		 * disabled when entering low power, skip the I2C accesses.
+		 */
+		disable_usb_phy_regulator();
+	}
 
 	initialize_pll1_settings();
 
@@ -444,6 +697,9 @@ static void stm32mp1_sp_min_security_setup(void)
 	ret = stm32_rng_init();
 	if (ret < 0) {
 		WARN("RNG driver init error %i\n", ret);
+	} else {
+		/* Start background entropy pooling, harvested on CPU idle */
+		stm32_rng_pool_refill();
 	}
 
 	/* Init tamper */
@@ -469,7 +725,14 @@ void sp_min_platform_setup(void)
 	ddr_save_sr_mode();
 
 	/* Initialize tzc400 after DDR initialization */
-	stm32mp1_security_setup();
+	if (wakeup_standby) {
+		stm32mp1_security_setup_resume(resume_ddr_size);
+	} else {
+		stm32mp1_security_setup();
+	}
+
+	PMF_CAPTURE_TIMESTAMP(warmboot_svc, WARMBOOT_TS_SECURITY_DONE,
+			      PMF_NO_CACHE_MAINT);
 
 	generic_delay_timer_init();
 
@@ -487,6 +750,31 @@ void sp_min_platform_setup(void)
 	stm32mp_lock_periph_registering();
 
 	stm32mp1_init_scmi_server();
+
+	stm32mp1_ns_info_init();
+
+	/*
+	 * The runtime address space is final: fold page runs left behind
+	 * by the fine-grained setup mappings into section mappings, so
+	 * SMC bursts stop thrashing the A7's TLB between the GIC, UART
+	 * and SYSRAM translations.
+	 */
+	xlat_promote_block_mappings();
+
+#if STM32MP_REG_SHADOW
+	/*
+	 * The secure state the STANDBY wake path is responsible for (TZC,
+	 * ETZPC, RCC) has been fully rebuilt: diff it against the snapshot
+	 * taken on suspend entry.
+	 */
+	if (wakeup_standby) {
+		stm32mp1_reg_shadow_verify(REG_SHADOW_STAGE_STANDBY);
+	}
+#endif
+
+	PMF_CAPTURE_TIMESTAMP(warmboot_svc, WARMBOOT_TS_SETUP_DONE,
+			      PMF_NO_CACHE_MAINT);
+	boot_timeline_capture(BOOT_TL_SP_MIN_READY);
 }
 
 void sp_min_plat_arch_setup(void)
@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdbool.h>
+
+#include <platform_def.h>
+
+#include <arch_helpers.h>
+#include <common/debug.h>
+#include <drivers/arm/gicv2.h>
+#include <drivers/delay_timer.h>
+#include <drivers/st/stm32mp1_rcc.h>
+#include <dt-bindings/clock/stm32mp1-clks.h>
+#include <lib/mmio.h>
+#include <lib/utils_def.h>
+#include <lib/xlat_tables/xlat_mmu_helpers.h>
+#include <plat/common/platform.h>
+
+#include <boot_api.h>
+#include <stm32mp_dt.h>
+#include <stm32mp1_smp.h>
+
+/* GICv2 SGI target list bit for the secondary core */
+#define SECONDARY_CPU_SGI_TARGET	BIT(STM32MP_SECONDARY_CPU)
+
+#define WORKER_START_TIMEOUT_US		U(10000)
+#define WORKER_PARK_TIMEOUT_US		U(100000)
+
+#define JOB_QUEUE_DEPTH			U(8)
+
+struct bl2_smp_job {
+	void (*fn)(void *arg);
+	void *arg;
+};
+
+/*
+ * Single-producer single-consumer ring: the primary core moves job_head, the
+ * worker moves job_tail once the job has run. Both cores are in cluster
+ * coherency with caches enabled while the queue is in use, so plain accesses
+ * ordered by DSB and signalled with SEV/WFE are sufficient.
+ */
+static struct bl2_smp_job job_queue[JOB_QUEUE_DEPTH];
+static volatile unsigned int job_head;
+static volatile unsigned int job_tail;
+static volatile bool worker_exit;
+static volatile bool worker_online;
+/* Written by the worker with its caches off, see stm32mp1_bl2_smp_park() */
+static volatile uint32_t worker_parked;
+
+static uintptr_t gicd_base;
+
+void stm32mp1_bl2_secondary_entrypoint(void);
+void __dead2 stm32mp1_bl2_smp_park(volatile uint32_t *parked);
+void __dead2 stm32mp1_bl2_smp_worker_main(void);
+
+static void raise_secondary_sgi(uint32_t sgi_id)
+{
+	dsb();
+	mmio_write_32(gicd_base + GICD_SGIR,
+		      GICV2_SGIR_VALUE(SGIR_TGT_SPECIFIC,
+				       SECONDARY_CPU_SGI_TARGET, sgi_id));
+}
+
+/*
+ * Worker loop, entered from stm32mp1_bl2_secondary_entrypoint once the
+ * secondary core's stack is set. Runs jobs in submission order until the
+ * primary core asks it to park.
+ */
+void __dead2 stm32mp1_bl2_smp_worker_main(void)
+{
+	/* Join the primary core's translation regime, caches on */
+	enable_mmu_svc_mon(0U);
+
+	worker_online = true;
+	dsb();
+	sev();
+
+	while (true) {
+		unsigned int tail = job_tail;
+
+		if (tail == job_head) {
+			if (worker_exit) {
+				break;
+			}
+			wfe();
+			continue;
+		}
+
+		job_queue[tail % JOB_QUEUE_DEPTH].fn(
+			job_queue[tail % JOB_QUEUE_DEPTH].arg);
+
+		/* Publish completion only once the job's stores are done */
+		dsb();
+		job_tail = tail + 1U;
+		dsb();
+		sev();
+	}
+
+	stm32mp1_bl2_smp_park(&worker_parked);
+}
+
+bool stm32mp1_bl2_smp_online(void)
+{
+	return worker_online;
+}
+
+void stm32mp1_bl2_smp_submit(void (*fn)(void *arg), void *arg)
+{
+	unsigned int head = job_head;
+
+	if (!worker_online) {
+		fn(arg);
+		return;
+	}
+
+	/* Wait for a free slot */
+	while ((head - job_tail) == JOB_QUEUE_DEPTH) {
+		wfe();
+	}
+
+	job_queue[head % JOB_QUEUE_DEPTH].fn = fn;
+	job_queue[head % JOB_QUEUE_DEPTH].arg = arg;
+
+	/* Publish the slot before moving the producer index */
+	dsb();
+	job_head = head + 1U;
+	dsb();
+	sev();
+}
+
+void stm32mp1_bl2_smp_wait(void)
+{
+	while (job_tail != job_head) {
+		wfe();
+	}
+
+	/* Order the jobs' output before the caller reads it */
+	dsb();
+}
+
+void stm32mp1_bl2_smp_start(void)
+{
+	struct dt_node_info dt_gic;
+	uint32_t bkpr_core1_addr =
+		tamp_bkpr(BOOT_API_CORE1_BRANCH_ADDRESS_TAMP_BCK_REG_IDX);
+	uint32_t bkpr_core1_magic =
+		tamp_bkpr(BOOT_API_CORE1_MAGIC_NUMBER_TAMP_BCK_REG_IDX);
+	uint64_t timeout;
+
+	if (worker_online || stm32mp_is_single_core()) {
+		return;
+	}
+
+	if (dt_get_node(&dt_gic, -1, "arm,cortex-a7-gic") < 0) {
+		WARN("BL2 SMP: no GIC node, secondary core kept off\n");
+		return;
+	}
+
+	gicd_base = dt_gic.base;
+
+	stm32mp_clk_enable(RTCAPB);
+
+	/* Reset backup register content */
+	mmio_write_32(bkpr_core1_magic, 0U);
+
+	/* Need to send additional IT 0 after individual core 1 reset */
+	raise_secondary_sgi(ARM_IRQ_NON_SEC_SGI_0);
+
+	/* Wait for this IT to be acknowledged by ROM code. */
+	udelay(10);
+
+	/* Write worker entrypoint and magic number in backup registers */
+	mmio_write_32(bkpr_core1_addr,
+		      (uint32_t)&stm32mp1_bl2_secondary_entrypoint);
+	mmio_write_32(bkpr_core1_magic, BOOT_API_A7_CORE1_MAGIC_NUMBER);
+
+	stm32mp_clk_disable(RTCAPB);
+
+	/*
+	 * The worker starts with the MMU off: clean the whole data cache so
+	 * that it sees the translation tables and the job queue.
+	 */
+	dcsw_op_all(DC_OP_CSW);
+
+	/* Generate an IT to core 1 */
+	raise_secondary_sgi(ARM_IRQ_SEC_SGI_0);
+
+	timeout = timeout_init_us(WORKER_START_TIMEOUT_US);
+	while (!worker_online) {
+		if (timeout_elapsed(timeout)) {
+			WARN("BL2 SMP: secondary core did not start\n");
+			return;
+		}
+	}
+
+	INFO("BL2 SMP: secondary core online\n");
+}
+
+void stm32mp1_bl2_smp_stop(void)
+{
+	uint32_t bkpr_core1_addr =
+		tamp_bkpr(BOOT_API_CORE1_BRANCH_ADDRESS_TAMP_BCK_REG_IDX);
+	uint32_t bkpr_core1_magic =
+		tamp_bkpr(BOOT_API_CORE1_MAGIC_NUMBER_TAMP_BCK_REG_IDX);
+	uint64_t timeout;
+
+	if (!worker_online) {
+		return;
+	}
+
+	stm32mp1_bl2_smp_wait();
+
+	worker_exit = true;
+	dsb();
+	sev();
+
+	/* The worker reports parked once out of coherency, caches off */
+	timeout = timeout_init_us(WORKER_PARK_TIMEOUT_US);
+	do {
+		if (timeout_elapsed(timeout)) {
+			panic();
+		}
+		inv_dcache_range((uintptr_t)&worker_parked,
+				 sizeof(worker_parked));
+	} while (worker_parked == 0U);
+
+	worker_online = false;
+
+	stm32mp_clk_enable(RTCAPB);
+
+	/* Reset backup register content */
+	mmio_write_32(bkpr_core1_addr, 0U);
+	mmio_write_32(bkpr_core1_magic, 0U);
+
+	stm32mp_clk_disable(RTCAPB);
+
+	/*
+	 * Reset the core back into the ROM holding pen, where the PSCI layer
+	 * in BL32 expects to find it.
+	 */
+	mmio_setbits_32(stm32mp_rcc_base() + RCC_MP_GRSTCSETR,
+			RCC_MP_GRSTCSETR_MPUP1RST);
+}
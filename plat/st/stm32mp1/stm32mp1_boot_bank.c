@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2021, STMicroelectronics - All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <platform_def.h>
+
+#include <common/debug.h>
+#include <drivers/st/stm32mp_clkfunc.h>
+#include <dt-bindings/clock/stm32mp1-clks.h>
+#include <lib/mmio.h>
+
+#include <stm32mp1_boot_bank.h>
+
+/*
+ * Backup register layout:
+ *  [31:16] magic, tells a valid record from backup domain garbage
+ *  [15:8]  demotion counter of the selected bank
+ *  [0]     selected bank
+ */
+#define BOOT_BANK_BKP_REG_ID	U(22)
+#define BOOT_BANK_MAGIC		U(0xBB10)
+#define BOOT_BANK_MAGIC_MASK	GENMASK(31, 16)
+#define BOOT_BANK_MAGIC_SHIFT	U(16)
+#define BOOT_BANK_COUNT_MASK	GENMASK(15, 8)
+#define BOOT_BANK_COUNT_SHIFT	U(8)
+#define BOOT_BANK_SELECT	BIT(0)
+
+static unsigned int selected_bank;
+static uint32_t demote_count;
+
+static void boot_bank_write(void)
+{
+	uint32_t reg = (BOOT_BANK_MAGIC << BOOT_BANK_MAGIC_SHIFT) |
+		       ((demote_count << BOOT_BANK_COUNT_SHIFT) &
+			BOOT_BANK_COUNT_MASK) |
+		       ((selected_bank != 0U) ? BOOT_BANK_SELECT : 0U);
+
+	stm32mp_clk_enable(RTCAPB);
+	mmio_write_32(tamp_bkpr(BOOT_BANK_BKP_REG_ID), reg);
+	stm32mp_clk_disable(RTCAPB);
+}
+
+/*
+ * Load the bank record left by the previous boots. A record with a wrong
+ * magic (first boot, backup domain reset) selects bank A.
+ */
+void boot_bank_init(void)
+{
+	uint32_t reg;
+
+	stm32mp_clk_enable(RTCAPB);
+	reg = mmio_read_32(tamp_bkpr(BOOT_BANK_BKP_REG_ID));
+	stm32mp_clk_disable(RTCAPB);
+
+	if (((reg & BOOT_BANK_MAGIC_MASK) >> BOOT_BANK_MAGIC_SHIFT) !=
+	    BOOT_BANK_MAGIC) {
+		selected_bank = 0U;
+		demote_count = 0U;
+		boot_bank_write();
+		return;
+	}
+
+	selected_bank = ((reg & BOOT_BANK_SELECT) != 0U) ? 1U : 0U;
+	demote_count = (reg & BOOT_BANK_COUNT_MASK) >> BOOT_BANK_COUNT_SHIFT;
+
+	if (selected_bank != 0U) {
+		NOTICE("Booting from bank B\n");
+	}
+
+	if (demote_count != 0U) {
+		NOTICE("Boot bank %c failed %u time(s)\n",
+		       (selected_bank == 0U) ? 'A' : 'B', demote_count);
+	}
+}
+
+unsigned int boot_bank_selected(void)
+{
+	return selected_bank;
+}
+
+/*
+ * Record a failed attempt on the selected bank. Reaching the demotion
+ * limit switches the following boots to the other bank; the switch is
+ * not applied to the boot in progress, which has already committed its
+ * IO offsets and is heading for a watchdog reset.
+ */
+void boot_bank_demote(void)
+{
+	demote_count++;
+
+	if (demote_count >= STM32MP_BOOT_BANK_DEMOTE_LIMIT) {
+		selected_bank = (selected_bank == 0U) ? 1U : 0U;
+		demote_count = 0U;
+		WARN("Boot bank demoted, next boots use bank %c\n",
+		     (selected_bank == 0U) ? 'A' : 'B');
+	} else {
+		WARN("Boot bank failure %u/%u recorded\n", demote_count,
+		     STM32MP_BOOT_BANK_DEMOTE_LIMIT);
+	}
+
+	boot_bank_write();
+}
+
+/*
+ * The boot made it past the image load phase: clear the demotion counter
+ * so transient failures do not accumulate across unrelated boots.
+ */
+void boot_bank_confirm(void)
+{
+	if (demote_count == 0U) {
+		return;
+	}
+
+	demote_count = 0U;
+	boot_bank_write();
+}
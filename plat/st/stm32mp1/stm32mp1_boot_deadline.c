@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2021, STMicroelectronics - All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <platform_def.h>
+
+#include <common/debug.h>
+#include <drivers/delay_timer.h>
+#include <drivers/st/stm32mp_clkfunc.h>
+#include <dt-bindings/clock/stm32mp1-clks.h>
+#include <lib/mmio.h>
+
+#include <stm32mp1_boot_deadline.h>
+
+/*
+ * Backup register layout:
+ *  [31:16] magic, tells a valid record from backup domain garbage
+ *  [15]    set when at least one stage overran its budget
+ *  [14:8]  identifier of the first overrunning stage
+ *  [7:0]   identifier of the stage being executed, BOOT_DL_STAGE_NONE
+ *          once BL2 handed over
+ */
+#define BOOT_DL_BKP_REG_ID		U(21)
+#define BOOT_DL_MAGIC			U(0xBD70)
+#define BOOT_DL_MAGIC_MASK		GENMASK(31, 16)
+#define BOOT_DL_MAGIC_SHIFT		U(16)
+#define BOOT_DL_OVERRUN			BIT(15)
+#define BOOT_DL_OVERRUN_STAGE_MASK	GENMASK(14, 8)
+#define BOOT_DL_OVERRUN_STAGE_SHIFT	U(8)
+#define BOOT_DL_STAGE_MASK		GENMASK(7, 0)
+
+static unsigned int active_stage = BOOT_DL_STAGE_NONE;
+static uint32_t active_budget_ms;
+static uint64_t active_deadline;
+
+static void boot_deadline_write(uint32_t value)
+{
+	stm32mp_clk_enable(RTCAPB);
+	mmio_write_32(tamp_bkpr(BOOT_DL_BKP_REG_ID), value);
+	stm32mp_clk_disable(RTCAPB);
+}
+
+/*
+ * Close the budget of the stage being left. The overrun marker only keeps
+ * the first overrunning stage: later overruns are usually collateral of the
+ * first one and the register has a single slot.
+ */
+static void boot_deadline_close_stage(uint32_t *reg)
+{
+	if ((active_stage == BOOT_DL_STAGE_NONE) ||
+	    !timeout_elapsed(active_deadline)) {
+		return;
+	}
+
+	WARN("Boot stage 0x%x overran its %u ms budget\n", active_stage,
+	     active_budget_ms);
+
+	if ((*reg & BOOT_DL_OVERRUN) == 0U) {
+		*reg |= BOOT_DL_OVERRUN |
+			((active_stage << BOOT_DL_OVERRUN_STAGE_SHIFT) &
+			 BOOT_DL_OVERRUN_STAGE_MASK);
+	}
+}
+
+/*
+ * Report and clear the record left by the previous boot. Called once the
+ * console is up; a record still carrying an active stage means the previous
+ * boot never handed over, typically because the IWDG fired in that stage.
+ */
+void boot_deadline_init(void)
+{
+	uint32_t reg;
+
+	stm32mp_clk_enable(RTCAPB);
+	reg = mmio_read_32(tamp_bkpr(BOOT_DL_BKP_REG_ID));
+	stm32mp_clk_disable(RTCAPB);
+
+	if (((reg & BOOT_DL_MAGIC_MASK) >> BOOT_DL_MAGIC_SHIFT) ==
+	    BOOT_DL_MAGIC) {
+		if ((reg & BOOT_DL_STAGE_MASK) != BOOT_DL_STAGE_NONE) {
+			NOTICE("Previous boot hung in stage 0x%x\n",
+			       reg & BOOT_DL_STAGE_MASK);
+		}
+
+		if ((reg & BOOT_DL_OVERRUN) != 0U) {
+			NOTICE("Previous boot overran its budget in stage 0x%x\n",
+			       (reg & BOOT_DL_OVERRUN_STAGE_MASK) >>
+			       BOOT_DL_OVERRUN_STAGE_SHIFT);
+		}
+	}
+
+	boot_deadline_write(BOOT_DL_MAGIC << BOOT_DL_MAGIC_SHIFT);
+}
+
+/*
+ * Enter a stage with its declared time budget. The budget of the previous
+ * stage is checked here, then the backup register tracks the new stage.
+ */
+void boot_deadline_enter(unsigned int stage, uint32_t budget_ms)
+{
+	uint32_t reg;
+
+	stm32mp_clk_enable(RTCAPB);
+	reg = mmio_read_32(tamp_bkpr(BOOT_DL_BKP_REG_ID));
+	stm32mp_clk_disable(RTCAPB);
+
+	boot_deadline_close_stage(&reg);
+
+	reg &= ~BOOT_DL_STAGE_MASK;
+	reg |= stage & BOOT_DL_STAGE_MASK;
+	boot_deadline_write(reg);
+
+	active_stage = stage;
+	active_budget_ms = budget_ms;
+	active_deadline = timeout_init_us(budget_ms * 1000U);
+}
+
+/*
+ * Mark the boot as handed over: clear the active stage so the record is only
+ * reported when the next boot finds a stage still open. Overrun markers are
+ * kept for the next boot to report.
+ */
+void boot_deadline_finish(void)
+{
+	uint32_t reg;
+
+	stm32mp_clk_enable(RTCAPB);
+	reg = mmio_read_32(tamp_bkpr(BOOT_DL_BKP_REG_ID));
+	stm32mp_clk_disable(RTCAPB);
+
+	boot_deadline_close_stage(&reg);
+
+	reg &= ~BOOT_DL_STAGE_MASK;
+	boot_deadline_write(reg);
+
+	active_stage = BOOT_DL_STAGE_NONE;
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2021, STMicroelectronics - All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include <platform_def.h>
+
+#include <arch_helpers.h>
+#include <common/debug.h>
+#include <lib/pmf/pmf.h>
+#include <lib/xlat_tables/xlat_tables_v2.h>
+
+#include <stm32mp1_boot_timeline.h>
+
+#define BOOT_TL_MAGIC		U(0x42544C31)	/* 'BTL1' */
+
+/*
+ * Layout of the reserved DDR page the BL2 time-stamps are handed over in.
+ * The page must be kept out of the non-secure OS memory map with a
+ * reserved-memory node in the device tree.
+ */
+struct boot_timeline {
+	uint32_t magic;
+	uint32_t reserved;
+	unsigned long long ts[BOOT_TL_BL2_TOTAL_IDS];
+};
+
+#if defined(IMAGE_BL2)
+static unsigned long long boot_tl_ts[BOOT_TL_BL2_TOTAL_IDS];
+
+void boot_timeline_record(unsigned int tid, unsigned long long value)
+{
+	assert(tid < BOOT_TL_BL2_TOTAL_IDS);
+
+	boot_tl_ts[tid] = value;
+}
+
+void boot_timeline_capture(unsigned int tid)
+{
+	boot_timeline_record(tid, read_cntpct_el0());
+}
+
+/*
+ * Copy the staged time-stamps into the reserved DDR page so that the sp_min
+ * half of the service can serve them after the handoff. Called on BL2 exit,
+ * once DDR is initialized and the last checkpoint has been captured.
+ */
+void boot_timeline_publish(void)
+{
+	struct boot_timeline *tl = (struct boot_timeline *)STM32MP_BOOT_TL_BASE;
+	int ret;
+
+	ret = mmap_add_dynamic_region(STM32MP_BOOT_TL_BASE,
+				      STM32MP_BOOT_TL_BASE,
+				      STM32MP_BOOT_TL_SIZE,
+				      MT_MEMORY | MT_RW | MT_NS);
+	if (ret != 0) {
+		WARN("Boot timeline not published (%d)\n", ret);
+		return;
+	}
+
+	memcpy(tl->ts, boot_tl_ts, sizeof(tl->ts));
+	tl->reserved = 0U;
+	tl->magic = BOOT_TL_MAGIC;
+	flush_dcache_range(STM32MP_BOOT_TL_BASE, sizeof(*tl));
+
+	ret = mmap_remove_dynamic_region(STM32MP_BOOT_TL_BASE,
+					 STM32MP_BOOT_TL_SIZE);
+	assert(ret == 0);
+}
+#endif /* IMAGE_BL2 */
+
+#if defined(IMAGE_BL32)
+static unsigned long long boot_tl_ts[BOOT_TL_TOTAL_IDS];
+
+void boot_timeline_capture(unsigned int tid)
+{
+	assert((tid >= BOOT_TL_BL2_TOTAL_IDS) && (tid < BOOT_TL_TOTAL_IDS));
+
+	boot_tl_ts[tid] = read_cntpct_el0();
+}
+
+/*
+ * Import the BL2 half of the timeline from the reserved DDR page. Called
+ * from pmf_setup(). A missing or corrupt handover only loses the BL2
+ * time-stamps: the matching entries then read back as zero.
+ */
+static int boot_timeline_svc_init(void)
+{
+	struct boot_timeline *tl = (struct boot_timeline *)STM32MP_BOOT_TL_BASE;
+	int ret;
+
+	ret = mmap_add_dynamic_region(STM32MP_BOOT_TL_BASE,
+				      STM32MP_BOOT_TL_BASE,
+				      STM32MP_BOOT_TL_SIZE,
+				      MT_MEMORY | MT_RO | MT_NS);
+	if (ret != 0) {
+		WARN("Boot timeline handover not mapped (%d)\n", ret);
+		return 0;
+	}
+
+	if (tl->magic == BOOT_TL_MAGIC) {
+		memcpy(boot_tl_ts, tl->ts, sizeof(tl->ts));
+	} else {
+		WARN("No boot timeline handover from BL2\n");
+	}
+
+	ret = mmap_remove_dynamic_region(STM32MP_BOOT_TL_BASE,
+					 STM32MP_BOOT_TL_SIZE);
+	assert(ret == 0);
+
+	return 0;
+}
+
+static unsigned long long boot_timeline_get_ts(unsigned int tid,
+					       u_register_t mpidr __unused,
+					       unsigned int flags __unused)
+{
+	return boot_tl_ts[tid & PMF_TID_MASK];
+}
+
+PMF_REGISTER_SERVICE_SMC_OWN(boot_tl_svc, PMF_ARM_TIF_IMPL_ID,
+			     PMF_STM32_BOOT_TIMELINE_SVC_ID, BOOT_TL_TOTAL_IDS,
+			     boot_timeline_svc_init, boot_timeline_get_ts)
+#endif /* IMAGE_BL32 */
@@ -13,8 +13,10 @@
 #include <context.h>
 #include <drivers/st/stm32_rtc.h>
 #include <drivers/st/stm32mp_clkfunc.h>
+#include <drivers/st/stm32mp1_ddr.h>
 #include <drivers/st/stm32mp1_ddr_regs.h>
 #include <dt-bindings/clock/stm32mp1-clks.h>
+#include <lib/cassert.h>
 #include <lib/el3_runtime/context_mgmt.h>
 #include <lib/mmio.h>
 #include <lib/utils.h>
@@ -22,6 +24,7 @@
 #include <smccc_helpers.h>
 
 #include <stm32mp1_context.h>
+#include <stm32mp1_private.h>
 
 #include <boot_api.h>
 
@@ -66,6 +69,15 @@
 /* SCMI needs only 24 bits to save the state of the 24 exposed clocks */
 #define SCMI_CONTEXT_SIZE		(sizeof(uint8_t) * 4)
 
+/*
+ * Layout identifier of the saved context. The low 16 bits hold the layout
+ * size so that any structure change invalidates contexts saved by older
+ * firmware; the high bits version the format explicitly.
+ */
+#define CONTEXT_MAGIC			((0x0001U << 16) | \
+					 (sizeof(struct backup_data_s) & \
+					  GENMASK_32(15, 0)))
+
 struct backup_data_s {
 #ifdef AARCH32_SP_OPTEE
 	uint32_t magic;
@@ -83,9 +95,97 @@ struct backup_data_s {
 	unsigned long long stgen;
 	uint8_t clock_cfg[CLOCK_CONTEXT_SIZE];
 	uint8_t scmi_context[SCMI_CONTEXT_SIZE];
+	uint32_t magic;
+	/* Number of saves since the context was last cleaned */
+	uint32_t generation;
+#endif
+};
+
+/*
+ * DDR PHY calibration snapshot, stored right after the PM context in Backup
+ * SRAM. It keeps the results of the last DQS training run so that later cold
+ * boots can restore them instead of retraining. The magic embeds the snapshot
+ * size so that a layout change invalidates snapshots taken by older firmware.
+ */
+struct ddr_cal_backup_s {
+	uint32_t magic;
+	uint32_t checksum;
+	struct stm32mp1_ddrphy_cal cal;
+};
+
+#define DDR_CAL_BACKUP_BASE		(STM32MP_BACKUP_RAM_BASE + \
+					 round_up(sizeof(struct backup_data_s), \
+						  sizeof(uint32_t)))
+#define DDR_CAL_MAGIC			((0x0001U << 16) | \
+					 (sizeof(struct ddr_cal_backup_s) & \
+					  GENMASK_32(15, 0)))
+
+CASSERT(round_up(sizeof(struct backup_data_s), sizeof(uint32_t)) +
+	sizeof(struct ddr_cal_backup_s) <= STM32MP_BACKUP_RAM_SIZE,
+	assert_ddr_cal_backup_fits_in_backup_ram);
+
+/*
+ * Platform configuration snapshot used by the sp_min fast-resume path. It
+ * keeps the settings sp_min derives from the device tree at cold boot, so
+ * that the wake up from STANDBY does not pay for the DT parsing again. As
+ * for the calibration snapshot, the magic embeds the record size so that a
+ * layout change invalidates records written by older firmware.
+ */
+struct resume_info_s {
+	uint32_t magic;
+	uint32_t uart_base;
+	uint32_t ddr_size;
+};
+
+#define RESUME_INFO_MAGIC		((0x0002U << 16) | \
+					 (sizeof(struct resume_info_s) & \
+					  GENMASK_32(15, 0)))
+
+#if defined(IMAGE_BL32)
+/*
+ * The record lives in the retained window of Backup SRAM through the
+ * retained_data section, so its placement is resolved by the linker
+ * rather than computed from the PM context layout.
+ */
+static struct resume_info_s resume_info __retained;
 #endif
+
+#if STM32MP_FAST_REBOOT_AUTH
+/*
+ * Digest of the BL33 image authenticated by BL2, stored after the DDR
+ * calibration snapshot. The PSCI SYSTEM_RESET2 fast reboot path compares
+ * the image staged by the caller against it, so a reboot into the verified
+ * image costs a hash pass instead of a storage reload and a signature
+ * chain. The magic embeds the record size so that a layout change
+ * invalidates records written by older firmware.
+ */
+struct auth_cache_s {
+	uint32_t magic;
+	uint32_t image_base;
+	uint32_t image_size;
+	uint8_t digest[BOOT_API_SHA256_DIGEST_SIZE_IN_BYTES];
 };
 
+#define AUTH_CACHE_BASE			(DDR_CAL_BACKUP_BASE +		\
+					 round_up(sizeof(struct ddr_cal_backup_s), \
+						  sizeof(uint32_t)))
+#define AUTH_CACHE_MAGIC		((0x0001U << 16) | \
+					 (sizeof(struct auth_cache_s) & \
+					  GENMASK_32(15, 0)))
+
+CASSERT((AUTH_CACHE_BASE + sizeof(struct auth_cache_s)) <= BL32_RET_RAM_BASE,
+	assert_auth_cache_fits_in_backup_ram);
+#endif /* STM32MP_FAST_REBOOT_AUTH */
+
+/*
+ * The computed-offset structures must stay below the retained_data
+ * window, itself below the crash capture region.
+ */
+CASSERT(round_up(sizeof(struct backup_data_s), sizeof(uint32_t)) +
+	sizeof(struct ddr_cal_backup_s) <=
+	(BL32_RET_RAM_BASE - STM32MP_BACKUP_RAM_BASE),
+	assert_pm_context_fits_in_backup_ram);
+
 #ifdef AARCH32_SP_OPTEE
 uint32_t stm32_pm_get_optee_ep(void)
 {
@@ -125,6 +225,19 @@ void stm32_clean_context(void)
 	stm32mp_clk_disable(BKPSRAM);
 }
 
+/*
+ * Update a context section only if its content changed since the last save.
+ * Backup SRAM writes are slow and most sections (clock tree configuration,
+ * PLL1 OPP settings, SCMI clock states) are stable across suspend cycles,
+ * so a read-and-compare pass is cheaper than rewriting them every time.
+ */
+static void stm32_context_update(void *bkp, const void *cur, size_t size)
+{
+	if (memcmp(bkp, cur, size) != 0) {
+		memcpy(bkp, cur, size);
+	}
+}
+
 void stm32mp1_pm_save_clock_cfg(size_t offset, uint8_t *data, size_t size)
 {
 	struct backup_data_s *backup_data;
@@ -137,7 +250,7 @@ void stm32mp1_pm_save_clock_cfg(size_t offset, uint8_t *data, size_t size)
 
 	stm32mp_clk_enable(BKPSRAM);
 
-	memcpy(backup_data->clock_cfg + offset, data, size);
+	stm32_context_update(backup_data->clock_cfg + offset, data, size);
 
 	stm32mp_clk_disable(BKPSRAM);
 }
@@ -165,6 +278,8 @@ int stm32_save_context(uint32_t zq0cr0_zdata,
 	void *smc_context;
 	void *cpu_context;
 	struct backup_data_s *backup_data;
+	uint8_t pll1_settings[PLL1_SETTINGS_SIZE];
+	uint8_t scmi_context[SCMI_CONTEXT_SIZE];
 
 	stm32mp1_clock_suspend();
 
@@ -179,7 +294,11 @@ int stm32_save_context(uint32_t zq0cr0_zdata,
 	/* Retrieve smc context struct address */
 	cpu_context = cm_get_context(NON_SECURE);
 
-	/* Save context in Backup SRAM */
+	/*
+	 * Save context in Backup SRAM. CPU/SMC contexts, RTC and STGEN
+	 * snapshots differ on every suspend and are copied unconditionally;
+	 * the remaining sections are staged and only written if they changed.
+	 */
 	memcpy(&backup_data->saved_smc_context[0], smc_context,
 	       sizeof(smc_ctx_t) * PLATFORM_CORE_COUNT);
 	memcpy(&backup_data->saved_cpu_context[0], cpu_context,
@@ -190,14 +309,20 @@ int stm32_save_context(uint32_t zq0cr0_zdata,
 	memcpy(&backup_data->rtc, rtc_time, sizeof(struct stm32_rtc_calendar));
 	backup_data->stgen = stgen_cnt;
 
-	stm32mp1_clk_lp_save_opp_pll1_settings(backup_data->pll1_settings,
-					sizeof(backup_data->pll1_settings));
+	stm32mp1_clk_lp_save_opp_pll1_settings(pll1_settings,
+					       sizeof(pll1_settings));
+	stm32_context_update(backup_data->pll1_settings, pll1_settings,
+			     sizeof(pll1_settings));
 
-	stm32mp1_pm_save_scmi_state(backup_data->scmi_context,
-				    sizeof(backup_data->scmi_context));
+	stm32mp1_pm_save_scmi_state(scmi_context, sizeof(scmi_context));
+	stm32_context_update(backup_data->scmi_context, scmi_context,
+			     sizeof(scmi_context));
 
 	save_clock_pm_context();
 
+	backup_data->generation++;
+	backup_data->magic = CONTEXT_MAGIC;
+
 	stm32mp_clk_disable(BKPSRAM);
 
 	return 0;
@@ -222,6 +347,11 @@ int stm32_restore_context(void)
 
 	stm32mp_clk_enable(BKPSRAM);
 
+	if (backup_data->magic != CONTEXT_MAGIC) {
+		ERROR("PM context: bad magic\n");
+		panic();
+	}
+
 	restore_clock_pm_context();
 
 	stm32mp1_pm_restore_scmi_state(backup_data->scmi_context,
@@ -283,6 +413,149 @@ uint32_t stm32_get_zdata_from_context(void)
 	return zdata;
 }
 
+static uint32_t ddr_cal_checksum(const struct stm32mp1_ddrphy_cal *cal)
+{
+	const uint32_t *data = (const uint32_t *)cal;
+	uint32_t sum = 0U;
+	size_t i;
+
+	for (i = 0U; i < (sizeof(*cal) / sizeof(uint32_t)); i++) {
+		sum += data[i];
+	}
+
+	return sum;
+}
+
+void stm32_save_ddr_cal(const struct stm32mp1_ddrphy_cal *cal)
+{
+	struct ddr_cal_backup_s *backup =
+		(struct ddr_cal_backup_s *)DDR_CAL_BACKUP_BASE;
+
+	stm32mp_clk_enable(BKPSRAM);
+
+	memcpy(&backup->cal, cal, sizeof(backup->cal));
+	backup->checksum = ddr_cal_checksum(cal);
+	backup->magic = DDR_CAL_MAGIC;
+
+	stm32mp_clk_disable(BKPSRAM);
+}
+
+int stm32_get_ddr_cal_from_context(struct stm32mp1_ddrphy_cal *cal)
+{
+	struct ddr_cal_backup_s *backup =
+		(struct ddr_cal_backup_s *)DDR_CAL_BACKUP_BASE;
+	int ret = 0;
+
+	stm32mp_clk_enable(BKPSRAM);
+
+	if ((backup->magic != DDR_CAL_MAGIC) ||
+	    (backup->checksum != ddr_cal_checksum(&backup->cal))) {
+		ret = -ENOENT;
+	} else {
+		memcpy(cal, &backup->cal, sizeof(*cal));
+	}
+
+	stm32mp_clk_disable(BKPSRAM);
+
+	return ret;
+}
+
+void stm32_clean_ddr_cal(void)
+{
+	struct ddr_cal_backup_s *backup =
+		(struct ddr_cal_backup_s *)DDR_CAL_BACKUP_BASE;
+
+	stm32mp_clk_enable(BKPSRAM);
+
+	backup->magic = 0U;
+
+	stm32mp_clk_disable(BKPSRAM);
+}
+
+#if defined(IMAGE_BL32)
+void stm32_save_resume_info(uint32_t uart_base, uint32_t ddr_size)
+{
+	stm32mp_clk_enable(BKPSRAM);
+
+	resume_info.uart_base = uart_base;
+	resume_info.ddr_size = ddr_size;
+	resume_info.magic = RESUME_INFO_MAGIC;
+
+	stm32mp_clk_disable(BKPSRAM);
+}
+
+int stm32_get_resume_info(uint32_t *uart_base, uint32_t *ddr_size)
+{
+	int ret = 0;
+
+	stm32mp_clk_enable(BKPSRAM);
+
+	if (resume_info.magic != RESUME_INFO_MAGIC) {
+		ret = -ENOENT;
+	} else {
+		*uart_base = resume_info.uart_base;
+		*ddr_size = resume_info.ddr_size;
+	}
+
+	stm32mp_clk_disable(BKPSRAM);
+
+	return ret;
+}
+#endif /* IMAGE_BL32 */
+
+#if STM32MP_FAST_REBOOT_AUTH
+#if defined(IMAGE_BL2)
+void stm32_save_auth_cache(uint32_t image_base, uint32_t image_size,
+			   const uint8_t *digest)
+{
+	struct auth_cache_s *cache = (struct auth_cache_s *)AUTH_CACHE_BASE;
+
+	stm32mp_clk_enable(BKPSRAM);
+
+	cache->image_base = image_base;
+	cache->image_size = image_size;
+	memcpy(cache->digest, digest, sizeof(cache->digest));
+	cache->magic = AUTH_CACHE_MAGIC;
+
+	stm32mp_clk_disable(BKPSRAM);
+}
+
+void stm32_clean_auth_cache(void)
+{
+	struct auth_cache_s *cache = (struct auth_cache_s *)AUTH_CACHE_BASE;
+
+	stm32mp_clk_enable(BKPSRAM);
+
+	cache->magic = 0U;
+
+	stm32mp_clk_disable(BKPSRAM);
+}
+#endif /* IMAGE_BL2 */
+
+#if defined(IMAGE_BL32)
+int stm32_get_auth_cache(uint32_t *image_base, uint32_t *image_size,
+			 uint8_t *digest)
+{
+	struct auth_cache_s *cache = (struct auth_cache_s *)AUTH_CACHE_BASE;
+	int ret = 0;
+
+	stm32mp_clk_enable(BKPSRAM);
+
+	if (cache->magic != AUTH_CACHE_MAGIC) {
+		ret = -ENOENT;
+	} else {
+		*image_base = cache->image_base;
+		*image_size = cache->image_size;
+		memcpy(digest, cache->digest, sizeof(cache->digest));
+	}
+
+	stm32mp_clk_disable(BKPSRAM);
+
+	return ret;
+}
+#endif /* IMAGE_BL32 */
+#endif /* STM32MP_FAST_REBOOT_AUTH */
+
 #ifdef AARCH32_SP_OPTEE
 static int pll1_settings_in_context(struct backup_data_s *backup_data)
 {
@@ -89,15 +89,66 @@
 #define STM32MP_BACKUP_RAM_BASE		U(0x54000000)
 #define STM32MP_BACKUP_RAM_SIZE		U(0x00001000)
 
+/* Crash/log capture region at the end of Backup SRAM */
+#define CRASH_RAM_SIZE			U(0x00000400)
+#define CRASH_RAM_BASE			(STM32MP_BACKUP_RAM_BASE + \
+					 STM32MP_BACKUP_RAM_SIZE - \
+					 CRASH_RAM_SIZE)
+
+/*
+ * Window of Backup SRAM holding the linker-placed retained_data section,
+ * just below the crash capture region. Data put there by BL32 survives
+ * STANDBY and needs no save/restore through the PM context.
+ */
+#define BL32_RET_RAM_SIZE		U(0x00000100)
+#define BL32_RET_RAM_LIMIT		CRASH_RAM_BASE
+#define BL32_RET_RAM_BASE		(CRASH_RAM_BASE - BL32_RET_RAM_SIZE)
+
 #define STM32MP_NS_SYSRAM_SIZE		PAGE_SIZE
 #define STM32MP_NS_SYSRAM_BASE		(STM32MP_SYSRAM_BASE + \
 					 STM32MP_SYSRAM_SIZE - \
 					 STM32MP_NS_SYSRAM_SIZE)
 
+/*
+ * Read-only runtime info page published to the non-secure world, in the
+ * tail of the non-secure SYSRAM page; the SCMI message buffers occupy
+ * the start of that page.
+ */
+#define STM32MP1_NS_INFO_SIZE		U(0x200)
+#define STM32MP1_NS_INFO_BASE		(STM32MP_NS_SYSRAM_BASE + \
+					 STM32MP_NS_SYSRAM_SIZE - \
+					 STM32MP1_NS_INFO_SIZE)
+
 #define STM32MP_SEC_SYSRAM_BASE		STM32MP_SYSRAM_BASE
 #define STM32MP_SEC_SYSRAM_SIZE		(STM32MP_SYSRAM_SIZE - \
 					 STM32MP_NS_SYSRAM_SIZE)
 
+/*
+ * Non-cacheable alias of SYSRAM: a second virtual window onto the same
+ * physical RAM, mapped Normal Non-cacheable. Small shared structures
+ * allocated with stm32mp1_nc_alloc() are only ever accessed through this
+ * window, which removes the per-access cache maintenance they would
+ * otherwise require. The window occupies an unused part of the address
+ * space below SYSRAM and has no physical backing of its own.
+ */
+#define STM32MP_SYSRAM_NC_ALIAS_BASE	U(0x2FF00000)
+#define STM32MP_SYSRAM_NC_POOL_SIZE	U(0x200)
+
+/*
+ * Backing store of the BL2 bounce buffer pool (see bl2_io_storage.c),
+ * sized for the most demanding enabled boot path rather than for the sum
+ * of every driver's worst case: the MMC partition table parse needs the
+ * io_block bounce buffer plus the read-ahead cache, the USB programmer
+ * one DFU transfer buffer, every other path only small header staging.
+ */
+#if STM32MP_SDMMC || STM32MP_EMMC
+#define STM32MP_BOUNCE_POOL_SIZE	U(0x2A00)
+#elif STM32MP_USB_PROGRAMMER
+#define STM32MP_BOUNCE_POOL_SIZE	U(0x1400)
+#else
+#define STM32MP_BOUNCE_POOL_SIZE	U(0x400)
+#endif
+
 /* DDR configuration */
 #define STM32MP_DDR_BASE		U(0xC0000000)
 #define STM32MP_DDR_MAX_SIZE		U(0x40000000)	/* Max 1GB */
@@ -109,6 +160,16 @@
 #define STM32MP_DDR_SHMEM_SIZE		U(0)
 #endif
 
+/*
+ * Non-secure DDR page carved out below the secure regions for the measured
+ * boot event log handed to BL33, see plat_image_load.c
+ */
+#if MEASURED_BOOT
+#define STM32MP_MEASURED_BOOT_LOG_SIZE	U(0x00001000)
+#else
+#define STM32MP_MEASURED_BOOT_LOG_SIZE	U(0)
+#endif
+
 /* DDR power initializations */
 #ifndef __ASSEMBLER__
 enum ddr_type {
@@ -183,7 +244,7 @@ enum ddr_type {
  #endif
 #endif
 #if defined(IMAGE_BL32)
-  #define MAX_MMAP_REGIONS		6
+  #define MAX_MMAP_REGIONS		7
 #endif
 
 #define XLAT_TABLE_OCTETSIZE		U(0x1000)
@@ -201,6 +262,85 @@ enum ddr_type {
 
 #define STM32MP_BL33_BASE		(STM32MP_DDR_BASE + U(0x100000))
 
+#if STM32MP_BOOT_TIMELINE
+/*
+ * Reserved DDR page used to hand the BL2 boot time-stamps over to the
+ * sp_min boot timeline PMF service.
+ */
+#define STM32MP_BOOT_TL_SIZE		U(0x1000)
+#define STM32MP_BOOT_TL_BASE		(STM32MP_BL33_BASE -	\
+					 STM32MP_BOOT_TL_SIZE)
+#endif
+
+#if STM32MP_REG_SHADOW
+/*
+ * Reserved DDR block holding the pre-suspend snapshot of the declared
+ * register ranges, diffed against the live registers after resume. The
+ * block must be kept out of the non-secure OS memory map with a
+ * reserved-memory node in the device tree.
+ */
+#define STM32MP_REG_SHADOW_SIZE		U(0x2000)
+#if STM32MP_BOOT_TIMELINE
+#define STM32MP_REG_SHADOW_BASE		(STM32MP_BOOT_TL_BASE -	\
+					 STM32MP_REG_SHADOW_SIZE)
+#else
+#define STM32MP_REG_SHADOW_BASE		(STM32MP_BL33_BASE -	\
+					 STM32MP_REG_SHADOW_SIZE)
+#endif
+#endif
+
+#if PROF_INSTRUMENT
+/*
+ * Reserved DDR block for the PROF_INSTRUMENT per-CPU trace rings, split
+ * between the BL2 phase and the SP_min runtime so a wake through BL2
+ * does not overwrite the runtime trace. The block must be kept out of
+ * the non-secure OS memory map with a reserved-memory node.
+ */
+#define STM32MP_PROF_TRACE_SIZE		U(0x80000)
+#if STM32MP_REG_SHADOW
+#define STM32MP_PROF_TRACE_BASE		(STM32MP_REG_SHADOW_BASE -	\
+					 STM32MP_PROF_TRACE_SIZE)
+#elif STM32MP_BOOT_TIMELINE
+#define STM32MP_PROF_TRACE_BASE		(STM32MP_BOOT_TL_BASE -	\
+					 STM32MP_PROF_TRACE_SIZE)
+#else
+#define STM32MP_PROF_TRACE_BASE		(STM32MP_BL33_BASE -	\
+					 STM32MP_PROF_TRACE_SIZE)
+#endif
+#define STM32MP_PROF_TRACE_BL2_BASE	STM32MP_PROF_TRACE_BASE
+#define STM32MP_PROF_TRACE_BL2_SIZE	(STM32MP_PROF_TRACE_SIZE / U(2))
+#define STM32MP_PROF_TRACE_BL32_BASE	(STM32MP_PROF_TRACE_BL2_BASE +	\
+					 STM32MP_PROF_TRACE_BL2_SIZE)
+#define STM32MP_PROF_TRACE_BL32_SIZE	(STM32MP_PROF_TRACE_SIZE / U(2))
+#endif
+
+/*
+ * DDR scratch pool of the late BL2 phase. The DDR below the BL33 load
+ * address carries no image while BL2 runs: once training completed it
+ * backs the large staging buffers (read-ahead windows, caches) that the
+ * SYSRAM bounce pool can never afford.
+ */
+#if PROF_INSTRUMENT
+#define STM32MP_DDR_POOL_LIMIT		STM32MP_PROF_TRACE_BASE
+#elif STM32MP_REG_SHADOW
+#define STM32MP_DDR_POOL_LIMIT		STM32MP_REG_SHADOW_BASE
+#elif STM32MP_BOOT_TIMELINE
+#define STM32MP_DDR_POOL_LIMIT		STM32MP_BOOT_TL_BASE
+#else
+#define STM32MP_DDR_POOL_LIMIT		STM32MP_BL33_BASE
+#endif
+#define STM32MP_DDR_POOL_BASE		STM32MP_DDR_BASE
+#define STM32MP_DDR_POOL_SIZE		(STM32MP_DDR_POOL_LIMIT -	\
+					 STM32MP_DDR_POOL_BASE)
+
+/*
+ * Vendor PSCI SYSTEM_RESET2 reset type: monitor-resident fast reboot.
+ * The normal world is restarted at the entry point passed in the cookie
+ * argument without resetting the SoC, skipping the ROM and BL2 re-entry
+ * and the DDR retraining of a cold reset.
+ */
+#define STM32MP_RESET2_FAST_REBOOT	U(1)
+
 /* Define Temporary Stack size use during low power mode */
 #define STM32MP_INT_STACK_SIZE		0x200
 
@@ -230,6 +370,18 @@ enum ddr_type {
 #define STM32MP_NAND_TEEX_OFFSET	U(0x00700000)
 #endif
 
+/*
+ * Offset of the second image copy (bank B) relative to the offsets above,
+ * for STM32MP_BOOT_BANK. Board-specific, can be overridden from the make
+ * line to match the flash layout.
+ */
+#ifndef STM32MP_NOR_BANK_OFFSET
+#define STM32MP_NOR_BANK_OFFSET		U(0x00400000)
+#endif
+#ifndef STM32MP_NAND_BANK_OFFSET
+#define STM32MP_NAND_BANK_OFFSET	U(0x00800000)
+#endif
+
 /*******************************************************************************
  * STM32MP1 device/io map related constants (used for MMU)
  ******************************************************************************/
@@ -321,6 +473,23 @@ enum ddr_type {
 #define UART8_BASE			U(0x40019000)
 #define STM32MP_UART_BAUDRATE		U(115200)
 
+/*******************************************************************************
+ * STM32MP1 DMA controllers
+ ******************************************************************************/
+#define STM32MP_DMA1_BASE		U(0x48000000)
+#define STM32MP_DMA2_BASE		U(0x48001000)
+#define STM32MP_DMAMUX1_BASE		U(0x48002000)
+
+/*
+ * DMA stream feeding the console UART when STM32MP_UART_DMA is enabled.
+ * DMA2 streams are wired to DMAMUX1 channels 8 to 15. The controller must
+ * be reserved to the secure world and left out of the non-secure device
+ * tree when the stream is in use.
+ */
+#define STM32MP_UART_DMA_CTRL_BASE	STM32MP_DMA2_BASE
+#define STM32MP_UART_DMA_STREAM		U(7)
+#define STM32MP_UART_DMA_MUX_CHAN	(U(8) + STM32MP_UART_DMA_STREAM)
+
 /* For UART crash console */
 #define STM32MP_DEBUG_USART_BASE	UART4_BASE
 /* UART4 on HSI@64MHz, TX on GPIOG11 Alternate 6 */
@@ -383,6 +552,7 @@ enum ddr_type {
 #define STM32MP_SD_HIGH_SPEED_MAX_FREQ		U(50000000)	/*50 MHz*/
 #define STM32MP_EMMC_NORMAL_SPEED_MAX_FREQ	U(26000000)	/*26 MHz*/
 #define STM32MP_EMMC_HIGH_SPEED_MAX_FREQ	U(52000000)	/*52 MHz*/
+#define STM32MP_EMMC_HS200_MAX_FREQ		U(130000000)	/*130 MHz*/
 
 /*******************************************************************************
  * STM32MP1 BSEC / OTP
@@ -14,18 +14,22 @@
 #include <drivers/arm/gicv2.h>
 #include <drivers/delay_timer.h>
 #include <drivers/st/stm32_iwdg.h>
+#include <drivers/st/stm32_reg_script.h>
 #include <drivers/st/stm32_rtc.h>
 #include <drivers/st/stm32mp_clkfunc.h>
 #include <drivers/st/stm32mp_pmic.h>
 #include <drivers/st/stm32mp1_ddr_helpers.h>
+#include <drivers/st/stm32mp1_clk.h>
 #include <drivers/st/stm32mp1_pwr.h>
 #include <drivers/st/stm32mp1_rcc.h>
 #include <drivers/st/stpmic1.h>
 #include <dt-bindings/clock/stm32mp1-clks.h>
 #include <dt-bindings/power/stm32mp1-power.h>
 #include <lib/mmio.h>
+#include <lib/pmf/pmf.h>
 #include <lib/psci/psci.h>
 #include <lib/spinlock.h>
+#include <lib/utils_def.h>
 #include <plat/common/platform.h>
 
 #include <boot_api.h>
@@ -35,12 +39,41 @@
 #include <stm32mp1_low_power.h>
 #include <stm32mp1_power_config.h>
 #include <stm32mp1_private.h>
+#if STM32MP_REG_SHADOW
+#include <stm32mp1_reg_shadow.h>
+#endif
+
+/*
+ * DDR self-refresh instrumentation: the entry/exit pair brackets every
+ * CSTOP/STANDBY cycle, so time-stamps around both transitions expose the
+ * polled-wait cost through the PMF SMC interface.
+ */
+#define PMF_STM32_DDR_SR_SVC_ID		4
+#define DDR_SR_TS_ENTRY			U(0)
+#define DDR_SR_TS_ENTERED		U(1)
+#define DDR_SR_TS_EXIT			U(2)
+#define DDR_SR_TS_EXITED		U(3)
+#define DDR_SR_TS_TOTAL_IDS		U(4)
+
+PMF_REGISTER_SERVICE_SMC(ddr_sr_svc, PMF_STM32_DDR_SR_SVC_ID,
+			 DDR_SR_TS_TOTAL_IDS, PMF_STORE_ENABLE)
+
+/*
+ * State written on suspend entry and read back on wake. The variables sit
+ * in the contiguous .bss.suspend_ctx block so that a single ranged clean
+ * at the end of enter_cstop() pushes all of them to SYSRAM, rather than
+ * relying on the caches keeping their content through the stop modes or
+ * paying a second full set/way sweep.
+ */
+static unsigned int gicc_pmr __suspend_ctx;
+static struct stm32_rtc_calendar sleep_time __suspend_ctx;
+static bool enter_cstop_done __suspend_ctx;
+static unsigned long long stgen_cnt __suspend_ctx;
 
-static unsigned int gicc_pmr;
-static struct stm32_rtc_calendar sleep_time;
-static bool enter_cstop_done;
 static uint32_t int_stack[STM32MP_INT_STACK_SIZE];
-static unsigned long long stgen_cnt;
+
+IMPORT_SYM(uintptr_t, __SUSPEND_CTX_START__, SUSPEND_CTX_START);
+IMPORT_SYM(uintptr_t, __SUSPEND_CTX_END__, SUSPEND_CTX_END);
 
 extern void wfi_svc_int_enable(uintptr_t stack_addr);
 
@@ -93,6 +126,72 @@ static const struct pwr_lp_config config_pwr[STM32_PM_MAX_SOC_MODE] = {
 	},
 };
 
+/*
+ * Fixed register sequences of the low power entry and exit paths as
+ * register scripts (see stm32_reg_script.h): each one executes as a
+ * single sweep over a rodata table instead of scattered single-register
+ * statements, so its timing does not depend on code layout. The two
+ * mode-dependent PWR values are passed as script parameters.
+ */
+#define PWR_PARAM_MPUCR		U(0)
+#define PWR_PARAM_CR1		U(1)
+#define PWR_PARAM_COUNT		U(2)
+
+static const struct reg_script_entry cstop_entry_script[] = {
+	/* Clear RCC interrupt before enabling it */
+	REG_SCRIPT_SETBITS(RCC_BASE + RCC_MP_CIFR, RCC_MP_CIFR_WKUPF),
+	/* Enable RCC Wake-up */
+	REG_SCRIPT_SETBITS(RCC_BASE + RCC_MP_CIER, RCC_MP_CIFR_WKUPF),
+	/* Configure low power mode */
+	REG_SCRIPT_RMW_PARAM(PWR_BASE + PWR_MPUCR, PWR_MPUCR_MASK,
+			     PWR_PARAM_MPUCR),
+	REG_SCRIPT_RMW_PARAM(PWR_BASE + PWR_CR1, PWR_CR1_MASK,
+			     PWR_PARAM_CR1),
+	/* Clear RCC pending interrupt flags */
+	REG_SCRIPT_WRITE(RCC_BASE + RCC_MP_CIFR, RCC_MP_CIFR_MASK),
+	/* Request CSTOP mode to RCC */
+	REG_SCRIPT_SETBITS(RCC_BASE + RCC_MP_SREQSETR,
+			   RCC_MP_SREQSETR_STPREQ_P0 |
+			   RCC_MP_SREQSETR_STPREQ_P1),
+	REG_SCRIPT_END,
+};
+
+/* Enable RETRAM retention in standby and wait for the ready flag */
+static const struct reg_script_entry retram_retention_script[] = {
+	REG_SCRIPT_SETBITS(PWR_BASE + PWR_CR2, PWR_CR2_RREN),
+	REG_SCRIPT_POLL(PWR_BASE + PWR_CR2, PWR_CR2_RRRDY, PWR_CR2_RRRDY),
+	REG_SCRIPT_END,
+};
+
+/* Keep backup RAM content in standby and wait for the ready flag */
+static const struct reg_script_entry bkpsram_retention_script[] = {
+	REG_SCRIPT_SETBITS(PWR_BASE + PWR_CR2, PWR_CR2_BREN),
+	REG_SCRIPT_POLL(PWR_BASE + PWR_CR2, PWR_CR2_BRRDY, PWR_CR2_BRRDY),
+	REG_SCRIPT_END,
+};
+
+static const struct reg_script_entry cstop_exit_script[] = {
+	/* Disable RCC Wake-up */
+	REG_SCRIPT_CLRBITS(RCC_BASE + RCC_MP_CIER, RCC_MP_CIFR_WKUPF),
+	/* Disable STOP request */
+	REG_SCRIPT_SETBITS(RCC_BASE + RCC_MP_SREQCLRR,
+			   RCC_MP_SREQSETR_STPREQ_P0 |
+			   RCC_MP_SREQSETR_STPREQ_P1),
+	REG_SCRIPT_SYNC(),
+	/* Disable retention and backup RAM content after stop */
+	REG_SCRIPT_CLRBITS(PWR_BASE + PWR_CR2, PWR_CR2_BREN | PWR_CR2_RREN),
+	REG_SCRIPT_END,
+};
+
+/* Program the PWR low power configuration for the selected mode */
+static const struct reg_script_entry pwr_lp_config_script[] = {
+	REG_SCRIPT_RMW_PARAM(PWR_BASE + PWR_MPUCR, PWR_MPUCR_MASK,
+			     PWR_PARAM_MPUCR),
+	REG_SCRIPT_RMW_PARAM(PWR_BASE + PWR_CR1, PWR_CR1_MASK,
+			     PWR_PARAM_CR1),
+	REG_SCRIPT_END,
+};
+
 #define GICC_PMR_PRIORITY_8	U(0x8)
 
 enum {
@@ -143,8 +242,16 @@ static void enter_cstop(uint32_t mode, uint32_t nsec_addr)
 	uint32_t bkpr_core1_magic =
 		tamp_bkpr(BOOT_API_CORE1_MAGIC_NUMBER_TAMP_BCK_REG_IDX);
 	uint32_t pwr_cr1 = config_pwr[mode].pwr_cr1;
-	uintptr_t pwr_base = stm32mp_pwr_base();
-	uintptr_t rcc_base = stm32mp_rcc_base();
+	uint32_t pwr_params[PWR_PARAM_COUNT];
+
+#if STM32MP_CLK_LAZY_GATE
+	stm32mp1_clk_lazy_flush();
+#endif
+
+#if STM32MP_REG_SHADOW
+	/* After the lazy gate flush so the snapshot sees committed state */
+	stm32mp1_reg_shadow_capture();
+#endif
 
 	stm32mp1_syscfg_disable_io_compensation();
 
@@ -171,24 +278,13 @@ static void enter_cstop(uint32_t mode, uint32_t nsec_addr)
 		}
 	}
 
-	/* Clear RCC interrupt before enabling it */
-	mmio_setbits_32(rcc_base + RCC_MP_CIFR, RCC_MP_CIFR_WKUPF);
-
-	/* Enable RCC Wake-up */
-	mmio_setbits_32(rcc_base + RCC_MP_CIER, RCC_MP_CIFR_WKUPF);
-
-	/* Configure low power mode */
-	mmio_clrsetbits_32(pwr_base + PWR_MPUCR, PWR_MPUCR_MASK,
-			   config_pwr[mode].pwr_mpucr);
-	mmio_clrsetbits_32(pwr_base + PWR_CR1, PWR_CR1_MASK,
-			   pwr_cr1);
-
-	/* Clear RCC pending interrupt flags */
-	mmio_write_32(rcc_base + RCC_MP_CIFR, RCC_MP_CIFR_MASK);
-
-	/* Request CSTOP mode to RCC */
-	mmio_setbits_32(rcc_base + RCC_MP_SREQSETR,
-			RCC_MP_SREQSETR_STPREQ_P0 | RCC_MP_SREQSETR_STPREQ_P1);
+	/*
+	 * Arm the RCC wake-up, configure the low power mode and raise the
+	 * CSTOP request in one script sweep.
+	 */
+	pwr_params[PWR_PARAM_MPUCR] = config_pwr[mode].pwr_mpucr;
+	pwr_params[PWR_PARAM_CR1] = pwr_cr1;
+	reg_script_run(cstop_entry_script, pwr_params);
 
 	stm32_iwdg_refresh();
 
@@ -198,10 +294,16 @@ static void enter_cstop(uint32_t mode, uint32_t nsec_addr)
 	 * Set DDR in Self-refresh, even if no return address is given.
 	 * This is also the procedure awaited when switching off power supply.
 	 */
+	PMF_CAPTURE_TIMESTAMP(ddr_sr_svc, DDR_SR_TS_ENTRY,
+			      PMF_NO_CACHE_MAINT);
+
 	if (ddr_standby_sr_entry(&zq0cr0_zdata) != 0) {
 		panic();
 	}
 
+	PMF_CAPTURE_TIMESTAMP(ddr_sr_svc, DDR_SR_TS_ENTERED,
+			      PMF_NO_CACHE_MAINT);
+
 	stm32mp_clk_enable(RTCAPB);
 
 	mmio_write_32(bkpr_core1_addr, 0);
@@ -227,24 +329,23 @@ static void enter_cstop(uint32_t mode, uint32_t nsec_addr)
 		}
 
 		if (stm32mp1_get_retram_enabled()) {
-			mmio_setbits_32(pwr_base + PWR_CR2, PWR_CR2_RREN);
-			while ((mmio_read_32(pwr_base + PWR_CR2) &
-				PWR_CR2_RRRDY) == 0U) {
-				;
-			}
+			reg_script_run(retram_retention_script, NULL);
 		}
 
 		/* Keep backup RAM content in standby */
-		mmio_setbits_32(pwr_base + PWR_CR2, PWR_CR2_BREN);
-		while ((mmio_read_32(pwr_base + PWR_CR2) &
-			PWR_CR2_BRRDY) == 0U) {
-			;
-		}
+		reg_script_run(bkpsram_retention_script, NULL);
 	}
 
 	stm32mp_clk_disable(RTCAPB);
 
 	enter_cstop_done = true;
+
+	/*
+	 * Hand the suspend context over to the wake path with a single
+	 * ranged clean covering the whole block.
+	 */
+	clean_dcache_range(SUSPEND_CTX_START,
+			   SUSPEND_CTX_END - SUSPEND_CTX_START);
 }
 
 /*
@@ -252,38 +353,39 @@ static void enter_cstop(uint32_t mode, uint32_t nsec_addr)
  */
 void stm32_exit_cstop(void)
 {
-	uintptr_t pwr_base = stm32mp_pwr_base();
-	uintptr_t rcc_base = stm32mp_rcc_base();
 	unsigned long long stdby_time_in_ms;
 	struct stm32_rtc_calendar current_calendar;
 
+	/*
+	 * Drop any cached copy of the suspend context so the wake path
+	 * reads what suspend entry pushed to SYSRAM.
+	 */
+	inv_dcache_range(SUSPEND_CTX_START,
+			 SUSPEND_CTX_END - SUSPEND_CTX_START);
+
 	if (!enter_cstop_done) {
 		return;
 	}
 
 	enter_cstop_done = false;
 
+	PMF_CAPTURE_TIMESTAMP(ddr_sr_svc, DDR_SR_TS_EXIT,
+			      PMF_NO_CACHE_MAINT);
+
 	if (ddr_sw_self_refresh_exit() != 0) {
 		panic();
 	}
 
+	PMF_CAPTURE_TIMESTAMP(ddr_sr_svc, DDR_SR_TS_EXITED,
+			      PMF_NO_CACHE_MAINT);
+
 	/* Switch to memorized Self-Refresh mode */
 	ddr_restore_sr_mode();
 
 	plat_ic_set_priority_mask(gicc_pmr);
 
-	/* Disable RCC Wake-up */
-	mmio_clrbits_32(rcc_base + RCC_MP_CIER, RCC_MP_CIFR_WKUPF);
-
-	/* Disable STOP request */
-	mmio_setbits_32(rcc_base + RCC_MP_SREQCLRR,
-			RCC_MP_SREQSETR_STPREQ_P0 | RCC_MP_SREQSETR_STPREQ_P1);
-
-	dsb();
-	isb();
-
-	/* Disable retention and backup RAM content after stop */
-	mmio_clrbits_32(pwr_base + PWR_CR2, PWR_CR2_BREN | PWR_CR2_RREN);
+	/* Disarm the RCC wake-up, STOP request and retention enables */
+	reg_script_run(cstop_exit_script, NULL);
 
 	/* Update STGEN counter with low power mode duration */
 	stm32_rtc_get_calendar(&current_calendar);
@@ -297,6 +399,10 @@ void stm32_exit_cstop(void)
 	if (stm32mp1_clock_stopmode_resume() != 0) {
 		panic();
 	}
+
+#if STM32MP_REG_SHADOW
+	stm32mp1_reg_shadow_verify(REG_SHADOW_STAGE_CSTOP);
+#endif
 }
 
 static int get_locked(volatile int *state)
@@ -315,8 +421,20 @@ static void set_locked(volatile int *state, int val)
 	spin_lock(&lp_lock);
 	*state = val;
 	spin_unlock(&lp_lock);
+
+	/* Wake a peer parked in WFE on this state */
+	dsb();
+	sev();
 }
 
+/*
+ * Rendezvous with the other core. The waiter parks in WFE between checks
+ * instead of spinning on the state word, so it costs no memory traffic
+ * while the peer is busy; set_locked() publishes every state change with
+ * an SEV. A peer sitting in WFI additionally needs an SGI to wake: the
+ * SGI stays pending at the distributor, so one kick per WFE cycle is
+ * enough and the lost-wakeup race is closed by the event register.
+ */
 static void smp_synchro(int state, bool wake_up)
 {
 	/* if the other CPU is stopped, no need to synchronize */
@@ -332,8 +450,8 @@ static void smp_synchro(int state, bool wake_up)
 				/* wakeup secondary CPU */
 				gicv2_raise_sgi(ARM_IRQ_SEC_SGI_6,
 						STM32MP_SECONDARY_CPU);
-				udelay(10);
 			}
+			wfe();
 		};
 	} else {
 		while (get_locked(&cpu0_state) != state) {
@@ -341,8 +459,8 @@ static void smp_synchro(int state, bool wake_up)
 				/* wakeup primary CPU */
 				gicv2_raise_sgi(ARM_IRQ_SEC_SGI_6,
 						STM32MP_PRIMARY_CPU);
-				udelay(10);
 			}
+			wfe();
 		};
 
 		set_locked(&cpu1_state, state);
@@ -410,12 +528,11 @@ static void enter_shutdown(void)
 
 static void enter_csleep(void)
 {
-	uintptr_t pwr_base = stm32mp_pwr_base();
+	uint32_t pwr_params[PWR_PARAM_COUNT];
 
-	mmio_clrsetbits_32(pwr_base + PWR_MPUCR, PWR_MPUCR_MASK,
-			   config_pwr[STM32_PM_CSLEEP_RUN].pwr_mpucr);
-	mmio_clrsetbits_32(pwr_base + PWR_CR1, PWR_CR1_MASK,
-			   config_pwr[STM32_PM_CSLEEP_RUN].pwr_cr1);
+	pwr_params[PWR_PARAM_MPUCR] = config_pwr[STM32_PM_CSLEEP_RUN].pwr_mpucr;
+	pwr_params[PWR_PARAM_CR1] = config_pwr[STM32_PM_CSLEEP_RUN].pwr_cr1;
+	reg_script_run(pwr_lp_config_script, pwr_params);
 
 	stm32_pwr_down_wfi();
 }
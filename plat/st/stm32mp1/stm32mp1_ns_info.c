@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2026, STMicroelectronics - All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <platform_def.h>
+
+#include <arch_helpers.h>
+#include <common/debug.h>
+#include <drivers/st/scmi-msg.h>
+#include <lib/psci/psci.h>
+#include <lib/smccc.h>
+#include <lib/utils.h>
+
+#include <stm32mp1_dbgmcu.h>
+#include <stm32mp1_ns_info.h>
+
+/*
+ * Publisher side of the runtime info page, see stm32mp1_ns_info.h for
+ * the layout and the reader protocol. The page sits in the tail of the
+ * non-secure SYSRAM page, after the SCMI message buffers, so it is
+ * readable by the normal world without any extra firewall setup.
+ */
+
+CASSERT(sizeof(struct stm32mp1_ns_info) <= STM32MP1_NS_INFO_SIZE,
+	assert_ns_info_page_fits_reserved_area);
+
+static struct stm32mp1_ns_info *ns_info =
+	(struct stm32mp1_ns_info *)STM32MP1_NS_INFO_BASE;
+
+static void ns_info_write_begin(void)
+{
+	ns_info->seqcount++;
+	dmbish();
+}
+
+static void ns_info_write_end(void)
+{
+	dmbish();
+	ns_info->seqcount++;
+
+	/*
+	 * With SCMI_SMT_ZERO_COPY the non-secure SYSRAM page is mapped
+	 * cacheable on the secure side while the agent may use an
+	 * uncached view, as for the SCMI message buffers. Make the
+	 * update visible; on the uncached mapping this is a no-op.
+	 */
+	flush_dcache_range(STM32MP1_NS_INFO_BASE, sizeof(*ns_info));
+}
+
+/*
+ * Re-publish the agent 0 SCMI clock rates. Rates only move on an OPP
+ * change of ck_mpu, so this runs once at boot and then only from the
+ * SCMI handlers that change a rate.
+ */
+void stm32mp1_ns_info_update_clock_rates(void)
+{
+	size_t count = plat_scmi_clock_count(0U);
+	size_t i;
+
+	if (count > STM32MP1_NS_INFO_CLOCK_MAX) {
+		count = STM32MP1_NS_INFO_CLOCK_MAX;
+	}
+
+	ns_info_write_begin();
+
+	for (i = 0U; i < count; i++) {
+		ns_info->clock[i].scmi_id = (uint32_t)i;
+		ns_info->clock[i].rate_hz =
+			(uint32_t)plat_scmi_clock_get_rate(0U, i);
+	}
+	ns_info->clock_count = (uint32_t)count;
+
+	ns_info_write_end();
+}
+
+void stm32mp1_ns_info_init(void)
+{
+	uint32_t chip_version = 0U;
+	uint32_t chip_dev_id = 0U;
+
+	zeromem(ns_info, sizeof(*ns_info));
+
+	if (stm32mp1_dbgmcu_get_chip_version(&chip_version) != 0) {
+		chip_version = 0U;
+	}
+	if (stm32mp1_dbgmcu_get_chip_dev_id(&chip_dev_id) != 0) {
+		chip_dev_id = 0U;
+	}
+
+	ns_info_write_begin();
+
+	ns_info->version = STM32MP1_NS_INFO_VERSION;
+	ns_info->smccc_version = MAKE_SMCCC_VERSION(SMCCC_MAJOR_VERSION,
+						    SMCCC_MINOR_VERSION);
+	ns_info->psci_version = PSCI_MAJOR_VER | PSCI_MINOR_VER;
+	ns_info->chip_version = chip_version;
+	ns_info->chip_dev_id = chip_dev_id;
+	ns_info->magic = STM32MP1_NS_INFO_MAGIC;
+
+	ns_info_write_end();
+
+	stm32mp1_ns_info_update_clock_rates();
+
+	INFO("Runtime info page published at 0x%x\n", STM32MP1_NS_INFO_BASE);
+}
@@ -6,28 +6,60 @@
 
 #include <assert.h>
 #include <errno.h>
+#if STM32MP_FAST_REBOOT_AUTH
+#include <string.h>
+#endif
 
 #include <platform_def.h>
 
 #include <arch_helpers.h>
 #include <bl32/sp_min/platform_sp_min.h>
+#include <common/bl_common.h>
 #include <common/debug.h>
+#if TF_LOG_BINARY
+#include <common/tf_log_binary.h>
+#endif
+#include <context.h>
 #include <drivers/arm/gic_common.h>
 #include <drivers/arm/gicv2.h>
+#include <drivers/console.h>
 #include <drivers/delay_timer.h>
+#if STM32MP_FAST_REBOOT_AUTH
+#include <drivers/st/stm32_hash.h>
+#endif
+#include <drivers/st/stm32_rng.h>
+#include <drivers/st/stm32_tamp.h>
 #include <drivers/st/stm32mp1_clk.h>
+#include <drivers/st/stm32mp1_ddr_helpers.h>
 #include <drivers/st/stm32mp1_rcc.h>
 #include <dt-bindings/clock/stm32mp1-clks.h>
+#include <lib/el3_runtime/context_mgmt.h>
+#include <lib/mem_guard.h>
 #include <lib/mmio.h>
 #include <lib/psci/psci.h>
+#include <lib/psci/psci_lib.h>
+#include <lib/utils.h>
+#if STM32MP_FAST_REBOOT_AUTH
+#include <lib/xlat_tables/xlat_tables_v2.h>
+#endif
 #include <plat/common/platform.h>
+#include <smccc_helpers.h>
 
+#if STM32MP_FAST_REBOOT_AUTH
+#include <stm32mp1_context.h>
+#endif
 #include <stm32mp1_low_power.h>
 #include <stm32mp1_power_config.h>
+#include <stm32mp1_private.h>
 
-static uintptr_t stm32_sec_entrypoint;
-static uint32_t cntfrq_core0;
-static uintptr_t saved_entrypoint;
+/*
+ * Entrypoints and counter frequency are consumed on the wake path, so
+ * they join the suspend context block cleaned in one sweep on suspend
+ * entry.
+ */
+static uintptr_t stm32_sec_entrypoint __suspend_ctx;
+static uint32_t cntfrq_core0 __suspend_ctx;
+static uintptr_t saved_entrypoint __suspend_ctx;
 
 /*******************************************************************************
  * STM32MP1 handler called when a CPU is about to enter standby.
@@ -39,6 +71,21 @@ static void stm32_cpu_standby(plat_local_state_t cpu_state)
 
 	assert(cpu_state == ARM_LOCAL_STATE_RET);
 
+	/* Drain any log output buffered on runtime paths */
+#if TF_LOG_BINARY
+	tf_log_binary_drain();
+#endif
+	(void)console_flush();
+
+	/* Top up the RNG entropy pool with words generated since last idle */
+	stm32_rng_pool_refill();
+
+	/* Handle tamper events latched by the interrupt handler */
+	stm32_tamp_drain_events();
+
+	/* Verify the seals on guarded shared state while the CPU is quiet */
+	mem_guard_check("cpu_standby");
+
 	/*
 	 * Enter standby state.
 	 * Synchronize on memory accesses and instruction flow before the WFI
@@ -59,6 +106,23 @@ static void stm32_cpu_standby(plat_local_state_t cpu_state)
 	}
 }
 
+/*******************************************************************************
+ * Warm the shared L2 cache with the secure warm-boot code before releasing a
+ * core from the BootROM holding pen. The released core starts with cold
+ * private caches and takes every miss of the warm entry path serially, so
+ * making its fetches hit in the unified L2 shortens release-to-kernel-entry.
+ * Reads are issued from the releasing core, whose view is fully coherent.
+ ******************************************************************************/
+static void stm32_preload_warm_boot_path(void)
+{
+	uintptr_t addr;
+
+	for (addr = BL_CODE_BASE; addr < BL_CODE_END;
+	     addr += CACHE_WRITEBACK_GRANULE) {
+		(void)mmio_read_32(addr);
+	}
+}
+
 /*******************************************************************************
  * STM32MP1 handler called when a power domain is about to be turned on. The
  * mpidr determines the CPU to be turned on.
@@ -106,6 +170,8 @@ static int stm32_pwr_domain_on(u_register_t mpidr)
 
 	stm32mp_clk_disable(RTCAPB);
 
+	stm32_preload_warm_boot_path();
+
 	/* Generate an IT to core 1 */
 	gicv2_raise_sgi(ARM_IRQ_SEC_SGI_0, STM32MP_SECONDARY_CPU);
 
@@ -129,6 +195,18 @@ static void stm32_pwr_domain_suspend(const psci_power_state_t *target_state)
 {
 	uint32_t soc_mode = stm32mp1_get_lp_soc_mode(PSCI_MODE_SYSTEM_SUSPEND);
 
+	/* Drain any log output buffered on runtime paths */
+#if TF_LOG_BINARY
+	tf_log_binary_drain();
+#endif
+	(void)console_flush();
+
+	/* Handle tamper events latched by the interrupt handler */
+	stm32_tamp_drain_events();
+
+	/* Verify the seals on guarded shared state before the state is lost */
+	mem_guard_check("pwr_domain_suspend");
+
 	stm32_enter_low_power(soc_mode, saved_entrypoint);
 }
 
@@ -223,6 +301,185 @@ static void __dead2 stm32_system_reset(void)
 	}
 }
 
+#if STM32MP_FAST_REBOOT_AUTH
+/*******************************************************************************
+ * Verify the image staged for a fast reboot against the digest BL2 recorded
+ * in Backup SRAM when it authenticated BL33. The staged image must be an
+ * exact copy of the verified one, loaded at the same address, so the reboot
+ * costs a hash pass over the image instead of a storage reload and a
+ * signature chain. Return 0 when the staged image matches.
+ ******************************************************************************/
+static int stm32mp1_fast_reboot_check_image(uintptr_t ep)
+{
+	static bool hash_registered;
+	uint8_t ref_digest[BOOT_API_SHA256_DIGEST_SIZE_IN_BYTES];
+	uint8_t digest[BOOT_API_SHA256_DIGEST_SIZE_IN_BYTES];
+	uint32_t image_base;
+	uint32_t image_size;
+	uintptr_t map_base;
+	size_t map_size;
+	int ret;
+
+	if (stm32_get_auth_cache(&image_base, &image_size, ref_digest) != 0) {
+		WARN("Fast reboot: no verified boot digest recorded\n");
+		return -ENOENT;
+	}
+
+	if ((ep != image_base) || (image_size == 0U)) {
+		WARN("Fast reboot: staged image does not match boot layout\n");
+		return -EINVAL;
+	}
+
+	if (!hash_registered) {
+		if (stm32_hash_register() != 0) {
+			return -ENODEV;
+		}
+
+		hash_registered = true;
+	}
+
+	/* The staged image is in DDR, which is not part of the BL32 map */
+	map_base = round_down(image_base, PAGE_SIZE);
+	map_size = round_up(image_base + image_size, PAGE_SIZE) - map_base;
+	ret = mmap_add_dynamic_region(map_base, map_base, map_size,
+				      MT_MEMORY | MT_RO | MT_NS);
+	if (ret != 0) {
+		return ret;
+	}
+
+	stm32_hash_init(HASH_SHA256);
+	ret = stm32_hash_final_update((uint8_t *)(uintptr_t)image_base,
+				      image_size, digest);
+
+	(void)mmap_remove_dynamic_region(map_base, map_size);
+
+	if (ret != 0) {
+		return ret;
+	}
+
+	if (memcmp(digest, ref_digest, sizeof(digest)) != 0) {
+		ERROR("Fast reboot: staged image does not match the verified boot digest\n");
+		return -EINVAL;
+	}
+
+	return 0;
+}
+#endif /* STM32MP_FAST_REBOOT_AUTH */
+
+/*******************************************************************************
+ * Vendor SYSTEM_RESET2 type STM32MP_RESET2_FAST_REBOOT: restart the normal
+ * world at the entry point passed in 'cookie' without resetting the SoC.
+ * The resident monitor rebuilds the non-secure context as BL2 does for the
+ * BL33 hand-over and ERETs into the staged image, skipping the ROM and BL2
+ * re-entry and the DDR retraining of a cold reset. The caller must have
+ * staged the image to reboot into in DDR, powered every other core off and
+ * quiesced its devices: only the CPU context is reset here. DDR is sealed
+ * in self-refresh while the old world is torn down.
+ ******************************************************************************/
+static int stm32_system_reset2(int is_vendor, int reset_type,
+			       u_register_t cookie)
+{
+	entry_point_info_t bl33_ep;
+	smc_ctx_t *smc_ctx;
+	regs_t *regs_ctx;
+	u_register_t ns_sctlr;
+
+	if (is_vendor == 0) {
+		/* Architectural warm reset is not supported */
+		return PSCI_E_NOT_SUPPORTED;
+	}
+
+	if (((uint32_t)reset_type & ~PSCI_RESET2_TYPE_VENDOR) !=
+	    STM32MP_RESET2_FAST_REBOOT) {
+		return PSCI_E_INVALID_PARAMS;
+	}
+
+	/* The entry point of the staged image must be in DDR */
+	if (cookie < STM32MP_DDR_BASE) {
+		return PSCI_E_INVALID_ADDRESS;
+	}
+
+	/* The world must be quiesced: no other core may still be on */
+	if (psci_is_last_on_cpu() == 0U) {
+		return PSCI_E_DENIED;
+	}
+
+	/*
+	 * Skipping the ROM re-entry is only safe while the warm entry
+	 * installed at boot still points at the SYSRAM-resident monitor.
+	 */
+	if ((stm32_sec_entrypoint != (uintptr_t)&sp_min_warm_entrypoint) ||
+	    (stm32_sec_entrypoint < STM32MP_SYSRAM_BASE) ||
+	    (stm32_sec_entrypoint >= (STM32MP_SYSRAM_BASE +
+				      STM32MP_SYSRAM_SIZE))) {
+		return PSCI_E_INVALID_ADDRESS;
+	}
+
+#if STM32MP_FAST_REBOOT_AUTH
+	if (stm32mp1_fast_reboot_check_image(cookie) != 0) {
+		return PSCI_E_DENIED;
+	}
+#endif
+
+	INFO("Fast reboot to 0x%lx\n", cookie);
+
+	(void)console_flush();
+
+	/*
+	 * Push the staged image out of the caches and seal the DDR in
+	 * self-refresh while the old world context is torn down, so its
+	 * content cannot be disturbed before the new image takes over.
+	 */
+	dcsw_op_all(DC_OP_CISW);
+
+	ddr_set_sr_mode(DDR_SSR_MODE);
+	if (ddr_standby_sr_entry(NULL) != 0) {
+		panic();
+	}
+
+	/* Rebuild the non-secure context as BL2 does for the BL33 entry */
+	zeromem(&bl33_ep, sizeof(bl33_ep));
+	SET_PARAM_HEAD(&bl33_ep, PARAM_EP, VERSION_1,
+		       NON_SECURE | EXECUTABLE);
+	bl33_ep.pc = cookie;
+	bl33_ep.spsr = SPSR_MODE32(MODE32_svc, SPSR_T_ARM, SPSR_E_LITTLE,
+				   DISABLE_ALL_EXCEPTIONS);
+
+	psci_prepare_next_non_secure_ctx(&bl33_ep);
+
+	regs_ctx = get_regs_ctx(cm_get_context(NON_SECURE));
+	smc_ctx = smc_get_ctx(NON_SECURE);
+
+	smc_ctx->r0 = read_ctx_reg(regs_ctx, CTX_GPREG_R0);
+	smc_ctx->r1 = read_ctx_reg(regs_ctx, CTX_GPREG_R1);
+	smc_ctx->r2 = read_ctx_reg(regs_ctx, CTX_GPREG_R2);
+	smc_ctx->lr_mon = read_ctx_reg(regs_ctx, CTX_LR);
+	smc_ctx->spsr_mon = read_ctx_reg(regs_ctx, CTX_SPSR);
+	smc_ctx->scr = read_ctx_reg(regs_ctx, CTX_SCR);
+
+	/* Reset the banked non-secure SCTLR: the image starts with MMU off */
+	write_scr(read_scr() | SCR_NS_BIT);
+	isb();
+	ns_sctlr = read_ctx_reg(regs_ctx, CTX_NS_SCTLR);
+	write_sctlr(ns_sctlr);
+	isb();
+
+	write_scr(read_scr() & ~SCR_NS_BIT);
+	isb();
+
+	if (ddr_sw_self_refresh_exit() != 0) {
+		panic();
+	}
+
+	ddr_restore_sr_mode();
+
+	/*
+	 * The returned value lands in r0 of the rebuilt context: the monitor
+	 * exit path now ERETs into the staged image.
+	 */
+	return PSCI_E_SUCCESS;
+}
+
 static int stm32_validate_power_state(unsigned int power_state,
 				      psci_power_state_t *req_state)
 {
@@ -298,6 +555,7 @@ static const plat_psci_ops_t stm32_psci_ops = {
 	.pwr_domain_pwr_down_wfi = stm32_pwr_domain_pwr_down_wfi,
 	.system_off = stm32_system_off,
 	.system_reset = stm32_system_reset,
+	.system_reset2 = stm32_system_reset2,
 	.validate_power_state = stm32_validate_power_state,
 	.validate_ns_entrypoint = stm32_validate_ns_entrypoint,
 	.get_node_hw_state = stm32_node_hw_state,
@@ -58,6 +58,19 @@
 					MT_SECURE | \
 					MT_EXECUTE_NEVER)
 
+#if SCMI_SMT_ZERO_COPY
+/*
+ * Non-secure SYSRAM holds the SCMI message area, processed in place from a
+ * cacheable mapping. The SMT driver performs the cache maintenance against
+ * the agent's uncached view of the mailbox.
+ */
+#define MAP_NS_SYSRAM	MAP_REGION_FLAT(STM32MP_NS_SYSRAM_BASE, \
+					STM32MP_NS_SYSRAM_SIZE, \
+					MT_MEMORY | \
+					MT_RW | \
+					MT_NS | \
+					MT_EXECUTE_NEVER)
+#else
 /* Non-secure SYSRAM is used a uncached memory for SCMI message transfer */
 #define MAP_NS_SYSRAM	MAP_REGION_FLAT(STM32MP_NS_SYSRAM_BASE, \
 					STM32MP_NS_SYSRAM_SIZE, \
@@ -67,6 +80,21 @@
 					MT_EXECUTE_NEVER)
 #endif
 
+/*
+ * Non-cacheable alias of the whole SYSRAM, backing stm32mp1_nc_alloc().
+ * Accesses through this window do not allocate in the data cache, so
+ * structures shared at high rate with the other core or with interrupt
+ * handlers need no clean/invalidate sequences.
+ */
+#define MAP_SYSRAM_NC	MAP_REGION(STM32MP_SYSRAM_BASE, \
+				   STM32MP_SYSRAM_NC_ALIAS_BASE, \
+				   STM32MP_SYSRAM_SIZE, \
+				   MT_NON_CACHEABLE | \
+				   MT_RW | \
+				   MT_SECURE | \
+				   MT_EXECUTE_NEVER)
+#endif
+
 #define MAP_SRAM_MCU	MAP_REGION_FLAT(STM32MP_SRAM_MCU_BASE, \
 					STM32MP_SRAM_MCU_SIZE, \
 					MT_MEMORY | \
@@ -110,6 +138,7 @@ static const mmap_region_t stm32mp1_mmap[] = {
 static const mmap_region_t stm32mp1_mmap[] = {
 	MAP_SEC_SYSRAM,
 	MAP_NS_SYSRAM,
+	MAP_SYSRAM_NC,
 	MAP_DEVICE1,
 	MAP_DEVICE2,
 	{0}
@@ -130,6 +159,48 @@ void configure_mmu(void)
 #endif
 }
 
+#if defined(IMAGE_BL32)
+/*
+ * Allocation pool behind the non-cacheable SYSRAM alias. The pool lives
+ * in the BL32 data section, so every byte of it is reachable through the
+ * alias window. Allocations are granule sized and granule aligned so that
+ * no cache line is shared between an allocation and unrelated cacheable
+ * data.
+ */
+static uint8_t stm32mp1_nc_pool[STM32MP_SYSRAM_NC_POOL_SIZE]
+	__aligned(CACHE_WRITEBACK_GRANULE);
+static size_t stm32mp1_nc_pool_used;
+
+uintptr_t stm32mp1_nc_alias(uintptr_t addr)
+{
+	assert((addr >= STM32MP_SYSRAM_BASE) &&
+	       (addr < (STM32MP_SYSRAM_BASE + STM32MP_SYSRAM_SIZE)));
+
+	return STM32MP_SYSRAM_NC_ALIAS_BASE + (addr - STM32MP_SYSRAM_BASE);
+}
+
+void *stm32mp1_nc_alloc(size_t size)
+{
+	uintptr_t chunk = (uintptr_t)&stm32mp1_nc_pool[stm32mp1_nc_pool_used];
+
+	size = round_up(size, CACHE_WRITEBACK_GRANULE);
+
+	if (size > (sizeof(stm32mp1_nc_pool) - stm32mp1_nc_pool_used)) {
+		return NULL;
+	}
+
+	stm32mp1_nc_pool_used += size;
+
+	/*
+	 * Evict the chunk from the cacheable view once, so that no stale
+	 * line can later mask updates performed through the alias.
+	 */
+	flush_dcache_range(chunk, size);
+
+	return (void *)stm32mp1_nc_alias(chunk);
+}
+#endif
+
 #if STM32MP_UART_PROGRAMMER
 /*
  * UART Management
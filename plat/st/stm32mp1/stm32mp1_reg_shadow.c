@@ -0,0 +1,282 @@
+/*
+ * Copyright (c) 2021, STMicroelectronics - All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <assert.h>
+#include <stdio.h>
+
+#include <platform_def.h>
+
+#include <arch_helpers.h>
+#include <common/crash_ram.h>
+#include <common/debug.h>
+#include <drivers/arm/gic_common.h>
+#include <drivers/arm/gicv2.h>
+#include <drivers/st/stm32mp1_rcc.h>
+#include <lib/mmio.h>
+#include <lib/utils_def.h>
+#include <lib/xlat_tables/xlat_tables_v2.h>
+
+#include <stm32mp_common.h>
+#include <stm32mp1_reg_shadow.h>
+
+#define REG_SHADOW_MAGIC	U(0x52534831)	/* 'RSH1' */
+
+/* Ring records emitted per verify, the rest is only counted */
+#define REG_SHADOW_DIFF_MAX	U(32)
+
+struct reg_shadow_header {
+	uint32_t magic;
+	uint32_t reserved;
+};
+
+struct reg_shadow_range {
+	const char *name;
+	uintptr_t base;
+	size_t size;		/* Bytes, a multiple of 4 */
+	unsigned int stages;
+};
+
+/*
+ * Declared register set. Only configuration registers belong here:
+ * status and write-one-to-clear registers legitimately differ across a
+ * suspend cycle and would defeat the red/green property. The RCC ranges
+ * cover the clock source selectors, dividers, PLL settings and the
+ * secure gate enables the resume paths are expected to rebuild; the
+ * oscillator control words are left out for their ready flags.
+ */
+static const struct reg_shadow_range reg_shadow_static_ranges[] = {
+	{
+		.name = "RCC core clock tree",
+		.base = RCC_BASE + RCC_MPCKSELR,
+		.size = (RCC_MSSCKSELR + U(4)) - RCC_MPCKSELR,
+		.stages = REG_SHADOW_STAGE_CSTOP | REG_SHADOW_STAGE_STANDBY,
+	},
+	{
+		.name = "RCC PLL1/PLL2 and secure kernel clocks",
+		.base = RCC_BASE + RCC_PLL1CR,
+		.size = (RCC_DDRITFCR + U(4)) - RCC_PLL1CR,
+		.stages = REG_SHADOW_STAGE_CSTOP | REG_SHADOW_STAGE_STANDBY,
+	},
+	{
+		.name = "RCC secure gate enables",
+		.base = RCC_BASE + RCC_MP_APB5ENSETR,
+		.size = (RCC_MP_AHB6ENSETR + U(4)) - RCC_MP_APB5ENSETR,
+		.stages = REG_SHADOW_STAGE_CSTOP | REG_SHADOW_STAGE_STANDBY,
+	},
+	{
+		.name = "RCC PLL3/PLL4 and kernel clocks",
+		.base = RCC_BASE + RCC_MCO2CFGR,
+		.size = (RCC_UART24CKSELR + U(4)) - RCC_MCO2CFGR,
+		.stages = REG_SHADOW_STAGE_CSTOP | REG_SHADOW_STAGE_STANDBY,
+	},
+	{
+		.name = "TZC gate keeper and speculation control",
+		.base = STM32MP1_TZC_BASE + U(0x004),
+		.size = U(0x00C),
+		.stages = REG_SHADOW_STAGE_CSTOP | REG_SHADOW_STAGE_STANDBY,
+	},
+	{
+		.name = "TZC region registers",
+		.base = STM32MP1_TZC_BASE + U(0x100),
+		.size = U(0x120),
+		.stages = REG_SHADOW_STAGE_CSTOP | REG_SHADOW_STAGE_STANDBY,
+	},
+	{
+		.name = "ETZPC TZMA sizes",
+		.base = STM32MP1_ETZPC_BASE,
+		.size = U(0x008),
+		.stages = REG_SHADOW_STAGE_CSTOP | REG_SHADOW_STAGE_STANDBY,
+	},
+	{
+		.name = "ETZPC DECPROT",
+		.base = STM32MP1_ETZPC_BASE + U(0x010),
+		.size = U(0x018),
+		.stages = REG_SHADOW_STAGE_CSTOP | REG_SHADOW_STAGE_STANDBY,
+	},
+};
+
+/*
+ * GIC distributor layout, sized from GICD_TYPER at walk time. The
+ * Distributor is hardware-retained across CSTOP; after STANDBY it is
+ * rebuilt from the device tree before the non-secure OS restored its
+ * own interrupt state, so diffing it there would only report that.
+ */
+static const struct {
+	const char *name;
+	uint32_t offset;
+	size_t bits_per_line;
+} reg_shadow_gicd_layout[] = {
+	{ "GICD_IGROUPR", GICD_IGROUPR, 1 },
+	{ "GICD_ISENABLER", GICD_ISENABLER, 1 },
+	{ "GICD_IPRIORITYR", GICD_IPRIORITYR, 8 },
+	{ "GICD_ITARGETSR", GICD_ITARGETSR, 8 },
+	{ "GICD_ICFGR", GICD_ICFGR, 2 },
+};
+
+static bool reg_shadow_mapped;
+
+static int reg_shadow_map(void)
+{
+	int ret;
+
+	if (reg_shadow_mapped) {
+		return 0;
+	}
+
+	ret = mmap_add_dynamic_region(STM32MP_REG_SHADOW_BASE,
+				      STM32MP_REG_SHADOW_BASE,
+				      STM32MP_REG_SHADOW_SIZE,
+				      MT_MEMORY | MT_RW | MT_NS);
+	if (ret != 0) {
+		WARN("Reg shadow block not mapped (%d)\n", ret);
+		return ret;
+	}
+
+	reg_shadow_mapped = true;
+
+	return 0;
+}
+
+static void reg_shadow_report(uintptr_t addr, uint32_t saved, uint32_t live,
+			      unsigned int *diffs)
+{
+	uint32_t rec[3] = { (uint32_t)addr, saved, live };
+
+	if (*diffs < REG_SHADOW_DIFF_MAX) {
+		crash_ram_put(CRASH_RAM_REC_REG_DIFF, rec, sizeof(rec));
+	}
+
+	(*diffs)++;
+}
+
+/*
+ * Shared walker: capture stores every declared word in table order,
+ * verify replays the same order so each word lands on its slot. Ranges
+ * not valid for the verify stage are skipped but keep their slots.
+ */
+static uint32_t *reg_shadow_range_walk(const struct reg_shadow_range *r,
+				       uint32_t *slot, bool verify,
+				       unsigned int stage, unsigned int *diffs)
+{
+	size_t i;
+
+	for (i = 0U; i < r->size; i += sizeof(uint32_t)) {
+		uintptr_t addr = r->base + i;
+
+		if (!verify) {
+			*slot = mmio_read_32(addr);
+		} else if ((r->stages & stage) != 0U) {
+			uint32_t live = mmio_read_32(addr);
+
+			if (live != *slot) {
+				reg_shadow_report(addr, *slot, live, diffs);
+			}
+		}
+
+		slot++;
+	}
+
+	return slot;
+}
+
+static uint32_t *reg_shadow_walk(bool verify, unsigned int stage,
+				 unsigned int *diffs)
+{
+	uint32_t *slot = (uint32_t *)(STM32MP_REG_SHADOW_BASE +
+				      sizeof(struct reg_shadow_header));
+	uintptr_t gicd = stm32_gic_get_gicd_base();
+	size_t i;
+
+	for (i = 0U; i < ARRAY_SIZE(reg_shadow_static_ranges); i++) {
+		slot = reg_shadow_range_walk(&reg_shadow_static_ranges[i],
+					     slot, verify, stage, diffs);
+	}
+
+	if (gicd != 0U) {
+		size_t lines = U(32) *
+			((mmio_read_32(gicd + GICD_TYPER) &
+			  TYPER_IT_LINES_NO_MASK) + U(1));
+		struct reg_shadow_range r = {
+			.name = "GICD_CTLR",
+			.base = gicd + GICD_CTLR,
+			.size = sizeof(uint32_t),
+			.stages = REG_SHADOW_STAGE_CSTOP,
+		};
+
+		slot = reg_shadow_range_walk(&r, slot, verify, stage, diffs);
+
+		for (i = 0U; i < ARRAY_SIZE(reg_shadow_gicd_layout); i++) {
+			r.name = reg_shadow_gicd_layout[i].name;
+			r.base = gicd + reg_shadow_gicd_layout[i].offset;
+			r.size = (lines *
+				  reg_shadow_gicd_layout[i].bits_per_line) / 8U;
+
+			slot = reg_shadow_range_walk(&r, slot, verify, stage,
+						     diffs);
+		}
+	}
+
+	return slot;
+}
+
+void stm32mp1_reg_shadow_capture(void)
+{
+	struct reg_shadow_header *hdr =
+		(struct reg_shadow_header *)STM32MP_REG_SHADOW_BASE;
+	uint32_t *end;
+
+	if (reg_shadow_map() != 0) {
+		return;
+	}
+
+	end = reg_shadow_walk(false, 0U, NULL);
+
+	assert(((uintptr_t)end - STM32MP_REG_SHADOW_BASE) <=
+	       STM32MP_REG_SHADOW_SIZE);
+
+	hdr->reserved = 0U;
+	hdr->magic = REG_SHADOW_MAGIC;
+
+	flush_dcache_range(STM32MP_REG_SHADOW_BASE,
+			   (uintptr_t)end - STM32MP_REG_SHADOW_BASE);
+}
+
+void stm32mp1_reg_shadow_verify(unsigned int stage)
+{
+	struct reg_shadow_header *hdr =
+		(struct reg_shadow_header *)STM32MP_REG_SHADOW_BASE;
+	unsigned int diffs = 0U;
+
+	if (reg_shadow_map() != 0) {
+		return;
+	}
+
+	inv_dcache_range(STM32MP_REG_SHADOW_BASE, STM32MP_REG_SHADOW_SIZE);
+
+	if (hdr->magic != REG_SHADOW_MAGIC) {
+		/* No snapshot: first boot, or capture could not map */
+		return;
+	}
+
+	(void)reg_shadow_walk(true, stage, &diffs);
+
+	/* A snapshot is diffed at most once */
+	hdr->magic = 0U;
+	flush_dcache_range(STM32MP_REG_SHADOW_BASE, sizeof(*hdr));
+
+	if (diffs != 0U) {
+		char msg[64];
+
+		snprintf(msg, sizeof(msg),
+			 "reg shadow: %u mismatch(es) after %s wake", diffs,
+			 (stage == REG_SHADOW_STAGE_STANDBY) ? "standby" :
+			 "cstop");
+		crash_ram_put_str(msg);
+		WARN("%s\n", msg);
+	} else {
+		INFO("Reg shadow: clean after wake\n");
+	}
+}
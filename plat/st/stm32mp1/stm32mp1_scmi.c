@@ -12,16 +12,26 @@
 #include <drivers/st/scmi-msg.h>
 #include <drivers/st/scmi.h>
 #include <drivers/st/stm32mp1_clk.h>
+#include <drivers/st/stm32mp_pmic.h>
 #include <drivers/st/stm32mp_reset.h>
+#include <drivers/st/stpmic1.h>
 #include <dt-bindings/clock/stm32mp1-clks.h>
+#include <dt-bindings/regulator/st,stm32mp15-regulator.h>
 #include <dt-bindings/reset/stm32mp1-resets.h>
 #include <lib/cassert.h>
 #include <lib/utils.h>
 
+#include <stm32mp1_ns_info.h>
+
 #define TIMEOUT_US_1MS		1000U
 
 #define SCMI_CLOCK_NAME_SIZE	16U
 #define SCMI_RD_NAME_SIZE	16U
+#define SCMI_VOLTD_NAME_SIZE	16U
+#define SCMI_PERFD_NAME_SIZE	16U
+
+/* Worst case DVFS transition latency: buck1 voltage ramp plus PLL1 relock */
+#define SCMI_PERFD_LATENCY_US	500U
 
 /*
  * struct stm32_scmi_clk - Data for the exposed clock
@@ -45,6 +55,50 @@ struct stm32_scmi_rd {
 	const char *name;
 };
 
+/*
+ * struct stm32_scmi_voltd - Data for the exposed voltage domain
+ * @regu_name: Regulator node name in the PMIC driver
+ * @name: Voltage domain string ID exposed to agent
+ * @level_uv: Cached voltage level of the regulator, in microvolts
+ * @enabled: Cached state of the regulator
+ * @present: True once the regulator was reached and the cache primed
+ * @always_on: Agent cannot disable the rail (e.g. it supplies the MPU)
+ *
+ * @level_uv and @enabled form a write-through cache of the PMIC settings:
+ * they are primed at init and updated on each successful set operation, so
+ * read requests are served from SRAM without an I2C transfer.
+ */
+struct stm32_scmi_voltd {
+	const char *regu_name;
+	const char *name;
+	long level_uv;
+	bool enabled;
+	bool present;
+	bool always_on;
+};
+
+/*
+ * struct stm32_scmi_perfd - Data for the exposed performance domain
+ * @name: Performance domain string ID exposed to agent
+ * @freq_khz: Operating point frequencies in ascending order, in kHz
+ * @volt_mv: Voltage paired with each operating point, in millivolts
+ * @level_count: Number of valid cells in @freq_khz and @volt_mv
+ * @limit_min_khz: Lowest operating point the agent may request
+ * @limit_max_khz: Highest operating point the agent may request
+ *
+ * The table is primed at init from the PLL1 settings the clock driver
+ * computed, so a level transition executes from SRAM resident data:
+ * no DT parsing nor PLL parameter computation on the SMC path.
+ */
+struct stm32_scmi_perfd {
+	const char *name;
+	uint32_t freq_khz[PLAT_MAX_OPP_NB];
+	uint32_t volt_mv[PLAT_MAX_OPP_NB];
+	size_t level_count;
+	uint32_t limit_min_khz;
+	uint32_t limit_max_khz;
+};
+
 /* Locate all non-secure SMT message buffers in last page of SYSRAM */
 #define SMT_BUFFER_BASE		STM32MP_NS_SYSRAM_BASE
 #define SMT_SLOT_SIZE		0x200U
@@ -52,8 +106,8 @@ struct stm32_scmi_rd {
 #define SMT_BUFFER1_BASE	(SMT_BUFFER_BASE + SMT_SLOT_SIZE)
 #define SMT_BUFFER_END		(SMT_BUFFER1_BASE + SMT_BUF_SLOT_SIZE)
 
-CASSERT(SMT_BUFFER_END < (STM32MP_NS_SYSRAM_BASE + STM32MP_NS_SYSRAM_SIZE),
-	assert_scmi_shm_fits_in_non_secure_sysram);
+CASSERT(SMT_BUFFER_END < STM32MP1_NS_INFO_BASE,
+	assert_scmi_shm_fits_below_runtime_info_page);
 
 static struct scmi_msg_channel scmi_channel[] = {
 	[0] = {
@@ -131,11 +185,44 @@ static struct stm32_scmi_rd stm32_scmi0_reset_domain[] = {
 	RESET_CELL(RST_SCMI0_MCU_HOLD_BOOT, MCU_HOLD_BOOT_R, "mcu_hold_boot"),
 };
 
+#define VOLTD_CELL(_scmi_id, _regu_name, _name, _always_on) \
+	[_scmi_id] = { \
+		.regu_name = _regu_name, \
+		.name = _name, \
+		.always_on = _always_on, \
+	}
+
+/*
+ * The DDR rails (buck2, ldo3 and vref_ddr) are deliberately not exposed:
+ * they stay under control of the secure low power sequences.
+ */
+static struct stm32_scmi_voltd stm32_scmi0_voltage_domain[] = {
+	VOLTD_CELL(VOLTD_SCMI0_BUCK1, "buck1", "buck1", true),
+	VOLTD_CELL(VOLTD_SCMI0_BUCK3, "buck3", "buck3", false),
+	VOLTD_CELL(VOLTD_SCMI0_BUCK4, "buck4", "buck4", false),
+	VOLTD_CELL(VOLTD_SCMI0_LDO1, "ldo1", "ldo1", false),
+	VOLTD_CELL(VOLTD_SCMI0_LDO2, "ldo2", "ldo2", false),
+	VOLTD_CELL(VOLTD_SCMI0_LDO4, "ldo4", "ldo4", false),
+	VOLTD_CELL(VOLTD_SCMI0_LDO5, "ldo5", "ldo5", false),
+	VOLTD_CELL(VOLTD_SCMI0_LDO6, "ldo6", "ldo6", false),
+};
+
+/* Single performance domain: the Cortex-A7 cores, fed by PLL1 */
+static struct stm32_scmi_perfd stm32_scmi0_perfd[] = {
+	[0] = {
+		.name = "ck_mpu",
+	},
+};
+
 struct scmi_agent_resources {
 	struct stm32_scmi_clk *clock;
 	size_t clock_count;
 	struct stm32_scmi_rd *rd;
 	size_t rd_count;
+	struct stm32_scmi_voltd *voltd;
+	size_t voltd_count;
+	struct stm32_scmi_perfd *perfd;
+	size_t perfd_count;
 };
 
 static const struct scmi_agent_resources agent_resources[] = {
@@ -144,6 +231,10 @@ static const struct scmi_agent_resources agent_resources[] = {
 		.clock_count = ARRAY_SIZE(stm32_scmi0_clock),
 		.rd = stm32_scmi0_reset_domain,
 		.rd_count = ARRAY_SIZE(stm32_scmi0_reset_domain),
+		.voltd = stm32_scmi0_voltage_domain,
+		.voltd_count = ARRAY_SIZE(stm32_scmi0_voltage_domain),
+		.perfd = stm32_scmi0_perfd,
+		.perfd_count = ARRAY_SIZE(stm32_scmi0_perfd),
 	},
 	[1] = {
 		.clock = stm32_scmi1_clock,
@@ -178,6 +269,20 @@ static size_t plat_scmi_protocol_count_paranoid(void)
 		}
 	}
 
+	for (n = 0U; n < ARRAY_SIZE(agent_resources); n++) {
+		if (agent_resources[n].voltd_count) {
+			count++;
+			break;
+		}
+	}
+
+	for (n = 0U; n < ARRAY_SIZE(agent_resources); n++) {
+		if (agent_resources[n].perfd_count) {
+			count++;
+			break;
+		}
+	}
+
 	return count;
 }
 #endif
@@ -195,10 +300,15 @@ const char *plat_scmi_sub_vendor_name(void)
 	return sub_vendor;
 }
 
-/* Currently supporting Clocks and Reset Domains */
+/*
+ * Currently supporting Performance, Clocks, Reset Domains and
+ * Voltage Domains
+ */
 static const uint8_t plat_protocol_list[] = {
+	SCMI_PROTOCOL_ID_PERF,
 	SCMI_PROTOCOL_ID_CLOCK,
 	SCMI_PROTOCOL_ID_RESET_DOMAIN,
+	SCMI_PROTOCOL_ID_VOLTAGE_DOMAIN,
 	0U /* Null termination */
 };
 
@@ -328,6 +438,7 @@ int32_t plat_scmi_clock_set_rate(unsigned int agent_id,
 		if (ret != 0) {
 			return SCMI_INVALID_PARAMETERS;
 		}
+		stm32mp1_ns_info_update_clock_rates();
 		break;
 	default:
 		if (rate != stm32mp_clk_get_rate(clock->clock_id)) {
@@ -377,6 +488,16 @@ int32_t plat_scmi_clock_set_state(unsigned int agent_id, unsigned int scmi_id,
 		return SCMI_DENIED;
 	}
 
+	/*
+	 * Pinned clocks stay enabled whatever the agent requests: only
+	 * track the agent view of the state, without entering the clock
+	 * driver. The agent OS pulses some of these at each suspend cycle.
+	 */
+	if (stm32mp1_clk_is_pinned(clock->clock_id)) {
+		clock->enabled = enable_not_disable;
+		return SCMI_SUCCESS;
+	}
+
 	if (enable_not_disable) {
 		if (!clock->enabled) {
 			VERBOSE("SCMI clock %u enable\n", scmi_id);
@@ -502,6 +623,457 @@ int32_t plat_scmi_rd_set_state(unsigned int agent_id, unsigned int scmi_id,
 	return SCMI_SUCCESS;
 }
 
+/*
+ * Platform SCMI voltage domains
+ *
+ * Read requests are served from the write-through cache in SRAM, the PMIC
+ * I2C bus is only reached on set requests and at cache priming.
+ */
+static struct stm32_scmi_voltd *find_voltd(unsigned int agent_id,
+					   unsigned int scmi_id)
+{
+	const struct scmi_agent_resources *resource = find_resource(agent_id);
+	size_t n;
+
+	if (resource != NULL) {
+		for (n = 0U; n < resource->voltd_count; n++) {
+			if (n == scmi_id) {
+				return &resource->voltd[n];
+			}
+		}
+	}
+
+	return NULL;
+}
+
+size_t plat_scmi_voltd_count(unsigned int agent_id)
+{
+	const struct scmi_agent_resources *resource = find_resource(agent_id);
+
+	if (resource == NULL) {
+		return 0U;
+	}
+
+	return resource->voltd_count;
+}
+
+const char *plat_scmi_voltd_get_name(unsigned int agent_id,
+				     unsigned int scmi_id)
+{
+	const struct stm32_scmi_voltd *voltd = find_voltd(agent_id, scmi_id);
+
+	if ((voltd == NULL) || !voltd->present) {
+		return NULL;
+	}
+
+	return voltd->name;
+}
+
+int32_t plat_scmi_voltd_levels_array(unsigned int agent_id,
+				     unsigned int scmi_id, size_t start_index,
+				     long *levels, size_t *nb_elts)
+{
+	const struct stm32_scmi_voltd *voltd = find_voltd(agent_id, scmi_id);
+	const uint16_t *mv_levels = NULL;
+	size_t full_count = 0U;
+	size_t n;
+
+	if ((voltd == NULL) || !voltd->present) {
+		return SCMI_NOT_FOUND;
+	}
+
+	if (stpmic1_regulator_levels_mv(voltd->regu_name, &mv_levels,
+					&full_count) != 0) {
+		return SCMI_GENERIC_ERROR;
+	}
+
+	if (levels == NULL) {
+		*nb_elts = full_count;
+		return SCMI_SUCCESS;
+	}
+
+	if (start_index >= full_count) {
+		return SCMI_OUT_OF_RANGE;
+	}
+
+	*nb_elts = MIN(*nb_elts, full_count - start_index);
+
+	for (n = 0U; n < *nb_elts; n++) {
+		levels[n] = (long)mv_levels[start_index + n] * 1000L;
+	}
+
+	return SCMI_SUCCESS;
+}
+
+int32_t plat_scmi_voltd_get_level(unsigned int agent_id, unsigned int scmi_id,
+				  long *level_uv)
+{
+	const struct stm32_scmi_voltd *voltd = find_voltd(agent_id, scmi_id);
+
+	if ((voltd == NULL) || !voltd->present) {
+		return SCMI_NOT_FOUND;
+	}
+
+	*level_uv = voltd->level_uv;
+
+	return SCMI_SUCCESS;
+}
+
+int32_t plat_scmi_voltd_set_level(unsigned int agent_id, unsigned int scmi_id,
+				  long level_uv)
+{
+	struct stm32_scmi_voltd *voltd = find_voltd(agent_id, scmi_id);
+	const uint16_t *mv_levels = NULL;
+	size_t count = 0U;
+	size_t n;
+	uint16_t level_mv;
+
+	if ((voltd == NULL) || !voltd->present) {
+		return SCMI_NOT_FOUND;
+	}
+
+	if ((level_uv < 0L) || ((level_uv % 1000L) != 0L) ||
+	    ((level_uv / 1000L) > (long)UINT16_MAX)) {
+		return SCMI_OUT_OF_RANGE;
+	}
+
+	level_mv = (uint16_t)(level_uv / 1000L);
+
+	if (voltd->level_uv == level_uv) {
+		return SCMI_SUCCESS;
+	}
+
+	/* The PMIC driver panics on levels outside the regulator table */
+	if (stpmic1_regulator_levels_mv(voltd->regu_name, &mv_levels,
+					&count) != 0) {
+		return SCMI_GENERIC_ERROR;
+	}
+
+	for (n = 0U; n < count; n++) {
+		if (mv_levels[n] == level_mv) {
+			break;
+		}
+	}
+
+	if (n == count) {
+		return SCMI_OUT_OF_RANGE;
+	}
+
+	VERBOSE("SCMI voltd %u level set to %umV\n", scmi_id, level_mv);
+
+	if (stpmic1_regulator_voltage_set(voltd->regu_name, level_mv) != 0) {
+		return SCMI_HARDWARE_ERROR;
+	}
+
+	voltd->level_uv = level_uv;
+
+	return SCMI_SUCCESS;
+}
+
+int32_t plat_scmi_voltd_get_config(unsigned int agent_id, unsigned int scmi_id,
+				   uint32_t *config)
+{
+	const struct stm32_scmi_voltd *voltd = find_voltd(agent_id, scmi_id);
+
+	if ((voltd == NULL) || !voltd->present) {
+		return SCMI_NOT_FOUND;
+	}
+
+	*config = voltd->enabled ? SCMI_VOLTD_CONFIG_ON : SCMI_VOLTD_CONFIG_OFF;
+
+	return SCMI_SUCCESS;
+}
+
+int32_t plat_scmi_voltd_set_config(unsigned int agent_id, unsigned int scmi_id,
+				   uint32_t config)
+{
+	struct stm32_scmi_voltd *voltd = find_voltd(agent_id, scmi_id);
+
+	if ((voltd == NULL) || !voltd->present) {
+		return SCMI_NOT_FOUND;
+	}
+
+	switch (config) {
+	case SCMI_VOLTD_CONFIG_ON:
+		if (!voltd->enabled) {
+			VERBOSE("SCMI voltd %u enable\n", scmi_id);
+			if (stpmic1_regulator_enable(voltd->regu_name) != 0) {
+				return SCMI_HARDWARE_ERROR;
+			}
+			voltd->enabled = true;
+		}
+		break;
+	case SCMI_VOLTD_CONFIG_OFF:
+		if (voltd->always_on) {
+			return SCMI_DENIED;
+		}
+		if (voltd->enabled) {
+			VERBOSE("SCMI voltd %u disable\n", scmi_id);
+			if (stpmic1_regulator_disable(voltd->regu_name) != 0) {
+				return SCMI_HARDWARE_ERROR;
+			}
+			voltd->enabled = false;
+		}
+		break;
+	default:
+		return SCMI_INVALID_PARAMETERS;
+	}
+
+	return SCMI_SUCCESS;
+}
+
+/*
+ * Platform SCMI performance domains
+ *
+ * A level set request executes the full DVFS sequence in firmware from
+ * the precomputed operating point table: the supply is moved through
+ * the buck1 voltage domain cache and PLL1 is reprogrammed from stored
+ * dividers, so the whole transition costs a single SMC to the agent.
+ */
+static struct stm32_scmi_perfd *find_perfd(unsigned int agent_id,
+					   unsigned int scmi_id)
+{
+	const struct scmi_agent_resources *resource = find_resource(agent_id);
+	size_t n;
+
+	if (resource != NULL) {
+		for (n = 0U; n < resource->perfd_count; n++) {
+			if (n == scmi_id) {
+				return &resource->perfd[n];
+			}
+		}
+	}
+
+	return NULL;
+}
+
+size_t plat_scmi_perfd_count(unsigned int agent_id)
+{
+	const struct scmi_agent_resources *resource = find_resource(agent_id);
+
+	if (resource == NULL) {
+		return 0U;
+	}
+
+	return resource->perfd_count;
+}
+
+const char *plat_scmi_perfd_get_name(unsigned int agent_id,
+				     unsigned int scmi_id)
+{
+	const struct stm32_scmi_perfd *perfd = find_perfd(agent_id, scmi_id);
+
+	if ((perfd == NULL) || (perfd->level_count == 0U)) {
+		return NULL;
+	}
+
+	return perfd->name;
+}
+
+unsigned int plat_scmi_perfd_sustained_level(unsigned int agent_id,
+					     unsigned int scmi_id)
+{
+	const struct stm32_scmi_perfd *perfd = find_perfd(agent_id, scmi_id);
+
+	if ((perfd == NULL) || (perfd->level_count == 0U)) {
+		return 0U;
+	}
+
+	return perfd->freq_khz[perfd->level_count - 1U];
+}
+
+int32_t plat_scmi_perfd_levels_array(unsigned int agent_id,
+				     unsigned int scmi_id, size_t start_index,
+				     struct scmi_perfd_level *levels,
+				     size_t *nb_elts)
+{
+	const struct stm32_scmi_perfd *perfd = find_perfd(agent_id, scmi_id);
+	size_t n;
+
+	if ((perfd == NULL) || (perfd->level_count == 0U)) {
+		return SCMI_NOT_FOUND;
+	}
+
+	if (levels == NULL) {
+		*nb_elts = perfd->level_count;
+		return SCMI_SUCCESS;
+	}
+
+	if (start_index >= perfd->level_count) {
+		return SCMI_OUT_OF_RANGE;
+	}
+
+	*nb_elts = MIN(*nb_elts, perfd->level_count - start_index);
+
+	for (n = 0U; n < *nb_elts; n++) {
+		levels[n].performance_level =
+			perfd->freq_khz[start_index + n];
+		levels[n].power_cost = perfd->volt_mv[start_index + n];
+		levels[n].latency_us = SCMI_PERFD_LATENCY_US;
+	}
+
+	return SCMI_SUCCESS;
+}
+
+int32_t plat_scmi_perfd_get_level(unsigned int agent_id, unsigned int scmi_id,
+				  unsigned int *level)
+{
+	const struct stm32_scmi_perfd *perfd = find_perfd(agent_id, scmi_id);
+
+	if ((perfd == NULL) || (perfd->level_count == 0U)) {
+		return SCMI_NOT_FOUND;
+	}
+
+	*level = stm32mp1_clk_get_current_opp_khz();
+
+	return SCMI_SUCCESS;
+}
+
+/* Move the MPU supply through the buck1 domain so both caches agree */
+static int32_t perfd_set_mpu_voltage(unsigned int agent_id, uint32_t volt_mv)
+{
+	int32_t status;
+
+	if (dt_pmic_status() <= 0) {
+		/* Fixed supply board: operating points share one voltage */
+		return SCMI_SUCCESS;
+	}
+
+	status = plat_scmi_voltd_set_level(agent_id, VOLTD_SCMI0_BUCK1,
+					   (long)volt_mv * 1000L);
+	if (status == SCMI_NOT_FOUND) {
+		/* Regulator not reachable at init, treat as fixed supply */
+		return SCMI_SUCCESS;
+	}
+
+	return status;
+}
+
+int32_t plat_scmi_perfd_set_level(unsigned int agent_id, unsigned int scmi_id,
+				  unsigned int level)
+{
+	const struct stm32_scmi_perfd *perfd = find_perfd(agent_id, scmi_id);
+	uint32_t current_khz;
+	uint32_t current_mv = 0U;
+	int32_t status;
+	size_t n;
+	size_t target = 0U;
+
+	if ((perfd == NULL) || (perfd->level_count == 0U)) {
+		return SCMI_NOT_FOUND;
+	}
+
+	if ((level < perfd->limit_min_khz) || (level > perfd->limit_max_khz)) {
+		return SCMI_OUT_OF_RANGE;
+	}
+
+	for (n = 0U; n < perfd->level_count; n++) {
+		if (perfd->freq_khz[n] == level) {
+			target = n;
+			break;
+		}
+	}
+
+	if (n == perfd->level_count) {
+		return SCMI_OUT_OF_RANGE;
+	}
+
+	current_khz = stm32mp1_clk_get_current_opp_khz();
+	if (current_khz == level) {
+		return SCMI_SUCCESS;
+	}
+
+	for (n = 0U; n < perfd->level_count; n++) {
+		if (perfd->freq_khz[n] == current_khz) {
+			current_mv = perfd->volt_mv[n];
+			break;
+		}
+	}
+
+	VERBOSE("SCMI perfd %u level set to %ukHz\n", scmi_id, level);
+
+	if (level > current_khz) {
+		/* Raise the supply before speeding up */
+		status = perfd_set_mpu_voltage(agent_id,
+					       perfd->volt_mv[target]);
+		if (status != SCMI_SUCCESS) {
+			return status;
+		}
+	}
+
+	if (stm32mp1_set_opp_khz(level) != 0) {
+		if ((level > current_khz) && (current_mv != 0U)) {
+			/* Back to the voltage matching the kept frequency */
+			(void)perfd_set_mpu_voltage(agent_id, current_mv);
+		}
+		return SCMI_HARDWARE_ERROR;
+	}
+
+	if (level < current_khz) {
+		/*
+		 * Lower the supply once the frequency is safe. A failure
+		 * here leaves the rail at a higher, still valid, level:
+		 * the performance transition itself did succeed.
+		 */
+		(void)perfd_set_mpu_voltage(agent_id, perfd->volt_mv[target]);
+	}
+
+	stm32mp1_ns_info_update_clock_rates();
+
+	return SCMI_SUCCESS;
+}
+
+int32_t plat_scmi_perfd_get_limits(unsigned int agent_id, unsigned int scmi_id,
+				   unsigned int *range_max,
+				   unsigned int *range_min)
+{
+	const struct stm32_scmi_perfd *perfd = find_perfd(agent_id, scmi_id);
+
+	if ((perfd == NULL) || (perfd->level_count == 0U)) {
+		return SCMI_NOT_FOUND;
+	}
+
+	*range_max = perfd->limit_max_khz;
+	*range_min = perfd->limit_min_khz;
+
+	return SCMI_SUCCESS;
+}
+
+int32_t plat_scmi_perfd_set_limits(unsigned int agent_id, unsigned int scmi_id,
+				   unsigned int range_max,
+				   unsigned int range_min)
+{
+	struct stm32_scmi_perfd *perfd = find_perfd(agent_id, scmi_id);
+	size_t n;
+	bool opp_in_range = false;
+
+	if ((perfd == NULL) || (perfd->level_count == 0U)) {
+		return SCMI_NOT_FOUND;
+	}
+
+	if (range_max < range_min) {
+		return SCMI_INVALID_PARAMETERS;
+	}
+
+	/* At least one operating point shall remain reachable */
+	for (n = 0U; n < perfd->level_count; n++) {
+		if ((perfd->freq_khz[n] >= range_min) &&
+		    (perfd->freq_khz[n] <= range_max)) {
+			opp_in_range = true;
+			break;
+		}
+	}
+
+	if (!opp_in_range) {
+		return SCMI_OUT_OF_RANGE;
+	}
+
+	perfd->limit_min_khz = range_min;
+	perfd->limit_max_khz = range_max;
+
+	return SCMI_SUCCESS;
+}
+
 /*
  * Initialize platform SCMI resources
  */
@@ -542,6 +1114,82 @@ void stm32mp1_init_scmi_server(void)
 				panic();
 			}
 		}
+
+		for (j = 0U; j < res->voltd_count; j++) {
+			struct stm32_scmi_voltd *voltd = &res->voltd[j];
+			int level_mv;
+
+			if ((voltd->name == NULL) ||
+			    (strlen(voltd->name) >= SCMI_VOLTD_NAME_SIZE)) {
+				ERROR("Invalid SCMI voltage domain name\n");
+				panic();
+			}
+
+			if (dt_pmic_status() <= 0) {
+				continue;
+			}
+
+			/* Prime the write-through cache from the PMIC */
+			level_mv =
+				stpmic1_regulator_voltage_get(voltd->regu_name);
+			if (level_mv < 0) {
+				continue;
+			}
+
+			voltd->level_uv = (long)level_mv * 1000L;
+			voltd->enabled =
+				stpmic1_is_regulator_enabled(voltd->regu_name);
+			voltd->present = true;
+		}
+
+		for (j = 0U; j < res->perfd_count; j++) {
+			struct stm32_scmi_perfd *perfd = &res->perfd[j];
+			unsigned int k;
+
+			if ((perfd->name == NULL) ||
+			    (strlen(perfd->name) >= SCMI_PERFD_NAME_SIZE)) {
+				ERROR("Invalid SCMI perf domain name\n");
+				panic();
+			}
+
+			/*
+			 * Prime the operating point table from the PLL1
+			 * settings. When the DT carries no OPP table the
+			 * domain stays empty and is reported not found.
+			 */
+			for (k = 0U; k < PLAT_MAX_OPP_NB; k++) {
+				uint32_t freq_khz;
+				uint32_t volt_mv;
+				size_t m;
+
+				if (stm32mp1_clk_get_opp(k, &freq_khz,
+							 &volt_mv) != 0) {
+					continue;
+				}
+
+				/* Keep the table sorted by frequency */
+				m = perfd->level_count;
+				while ((m > 0U) &&
+				       (perfd->freq_khz[m - 1U] > freq_khz)) {
+					perfd->freq_khz[m] =
+						perfd->freq_khz[m - 1U];
+					perfd->volt_mv[m] =
+						perfd->volt_mv[m - 1U];
+					m--;
+				}
+
+				perfd->freq_khz[m] = freq_khz;
+				perfd->volt_mv[m] = volt_mv;
+				perfd->level_count++;
+			}
+
+			if (perfd->level_count != 0U) {
+				perfd->limit_min_khz = perfd->freq_khz[0];
+				perfd->limit_max_khz =
+					perfd->freq_khz[perfd->level_count -
+							1U];
+			}
+		}
 	}
 }
 
@@ -31,16 +31,21 @@
  * Initialize the TrustZone Controller. Configure Region 0 with Secure RW access
  * and allow Non-Secure masters full access.
  ******************************************************************************/
-static void init_tzc400(void)
+static void init_tzc400(uint32_t dram_size)
 {
 	unsigned long long region_base, region_top;
 	unsigned long long ddr_base = STM32MP_DDR_BASE;
-	unsigned long long ddr_size = (unsigned long long)dt_get_ddr_size();
+	unsigned long long ddr_size = (unsigned long long)dram_size;
 	unsigned long long ddr_top = ddr_base + (ddr_size - 1U);
 
 	tzc400_init(STM32MP1_TZC_BASE);
 
-	tzc400_disable_filters();
+	/*
+	 * Batch the region updates so that an unchanged configuration, as
+	 * replayed on the resume path, skips both the register writes and
+	 * the gate-keeper close/open sequence.
+	 */
+	tzc400_config_begin();
 
 #ifdef AARCH32_SP_OPTEE
 	/*
@@ -92,7 +97,7 @@ static void init_tzc400(void)
 	 */
 	tzc400_set_action(TZC_ACTION_INT);
 
-	tzc400_enable_filters();
+	tzc400_config_commit();
 }
 
 /*******************************************************************************
@@ -139,5 +144,15 @@ void stm32mp1_arch_security_setup(void)
  ******************************************************************************/
 void stm32mp1_security_setup(void)
 {
-	init_tzc400();
+	init_tzc400(dt_get_ddr_size());
+}
+
+/*******************************************************************************
+ * Resume variant of stm32mp1_security_setup(): restore the TrustZone
+ * Controller configuration with the DDR size saved at cold boot instead of
+ * parsing the device tree again.
+ ******************************************************************************/
+void stm32mp1_security_setup_resume(uint32_t ddr_size)
+{
+	init_tzc400(ddr_size);
 }
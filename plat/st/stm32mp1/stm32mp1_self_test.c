@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2021, STMicroelectronics - All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <string.h>
+
+#include <platform_def.h>
+
+#include <arch_helpers.h>
+#include <common/debug.h>
+#if STM32MP_SDMMC || STM32MP_EMMC
+#include <drivers/mmc.h>
+#endif
+#include <drivers/st/stm32_hash.h>
+#include <drivers/st/stm32mp_clkfunc.h>
+#include <dt-bindings/clock/stm32mp1-clks.h>
+#include <lib/mmio.h>
+
+#include <boot_api.h>
+#include <stm32mp1_self_test.h>
+
+/*
+ * Each benchmark covers SELF_TEST_SIZE bytes, large enough to hide the
+ * per-transfer setup cost yet bounded to a few hundred milliseconds on
+ * the slowest supported media. The scratch windows sit in the BL33 load
+ * area, which is mapped and free at this point of BL2 and overwritten
+ * by the image load right after.
+ */
+#define SELF_TEST_SIZE		U(0x400000)
+#define SELF_TEST_BUF0		STM32MP_BL33_BASE
+#define SELF_TEST_BUF1		(STM32MP_BL33_BASE + SELF_TEST_SIZE)
+#define SELF_TEST_DDR_ROUNDS	4U
+
+struct stm32mp1_self_test_result stm32mp1_self_test_result;
+
+static uint32_t self_test_kbps(size_t bytes, unsigned long long ticks)
+{
+	if (ticks == 0ULL) {
+		return 0U;
+	}
+
+	return (uint32_t)(((unsigned long long)bytes * read_cntfrq_el0()) /
+			  (ticks * 1024ULL));
+}
+
+bool stm32mp1_self_test_requested(void)
+{
+	uint32_t reg;
+
+	stm32mp_clk_enable(RTCAPB);
+	reg = mmio_read_32(tamp_bkpr(SELF_TEST_BKP_REG_ID));
+
+	if ((((reg & SELF_TEST_MAGIC_MASK) >> SELF_TEST_MAGIC_SHIFT) !=
+	     SELF_TEST_MAGIC) || ((reg & SELF_TEST_REQUEST) == 0U)) {
+		stm32mp_clk_disable(RTCAPB);
+		return false;
+	}
+
+	/* One-shot: the request does not survive the boot serving it */
+	mmio_write_32(tamp_bkpr(SELF_TEST_BKP_REG_ID),
+		      SELF_TEST_MAGIC << SELF_TEST_MAGIC_SHIFT);
+	stm32mp_clk_disable(RTCAPB);
+
+	return true;
+}
+
+static void self_test_storage(void)
+{
+#if STM32MP_SDMMC || STM32MP_EMMC
+	boot_api_context_t *boot_context =
+		(boot_api_context_t *)stm32mp_get_boot_ctx_address();
+	unsigned long long start;
+	size_t size;
+
+	switch (boot_context->boot_interface_selected) {
+	case BOOT_API_CTX_BOOT_INTERFACE_SEL_FLASH_SD:
+	case BOOT_API_CTX_BOOT_INTERFACE_SEL_FLASH_EMMC:
+		break;
+	default:
+		return;
+	}
+
+	start = read_cntpct_el0();
+	size = mmc_read_blocks(0, SELF_TEST_BUF0, SELF_TEST_SIZE);
+	if (size != SELF_TEST_SIZE) {
+		WARN("Self-test: storage read failed\n");
+		return;
+	}
+
+	stm32mp1_self_test_result.storage_kbps =
+		self_test_kbps(size, read_cntpct_el0() - start);
+#endif
+}
+
+static void self_test_hash(void)
+{
+	uint8_t digest[32];
+	unsigned long long start;
+
+	if (stm32_hash_register() != 0) {
+		return;
+	}
+
+	stm32_hash_init(HASH_SHA256);
+
+	start = read_cntpct_el0();
+	if (stm32_hash_final_update((uint8_t *)SELF_TEST_BUF0, SELF_TEST_SIZE,
+				    digest) != 0) {
+		WARN("Self-test: hash failed\n");
+		return;
+	}
+
+	stm32mp1_self_test_result.hash_kbps =
+		self_test_kbps(SELF_TEST_SIZE, read_cntpct_el0() - start);
+}
+
+static void self_test_ddr(void)
+{
+	unsigned long long start;
+	unsigned int i;
+
+	start = read_cntpct_el0();
+	for (i = 0U; i < SELF_TEST_DDR_ROUNDS; i++) {
+		memcpy((void *)SELF_TEST_BUF1, (void *)SELF_TEST_BUF0,
+		       SELF_TEST_SIZE);
+	}
+
+	stm32mp1_self_test_result.ddr_kbps =
+		self_test_kbps((size_t)SELF_TEST_SIZE * SELF_TEST_DDR_ROUNDS,
+			       read_cntpct_el0() - start);
+}
+
+void stm32mp1_self_test_run(void)
+{
+	NOTICE("Self-test benchmarks requested\n");
+
+	self_test_storage();
+	self_test_hash();
+	self_test_ddr();
+
+	NOTICE("Self-test: storage %u KB/s, hash %u KB/s, DDR copy %u KB/s\n",
+	       stm32mp1_self_test_result.storage_kbps,
+	       stm32mp1_self_test_result.hash_kbps,
+	       stm32mp1_self_test_result.ddr_kbps);
+}
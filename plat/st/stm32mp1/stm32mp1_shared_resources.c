@@ -38,6 +38,18 @@ static int8_t gpioz_nbpin = -1;
 
 static uint8_t shres_state[STM32MP1_SHRES_COUNT];
 
+/*
+ * Snapshot of the assignments, frozen when registering gets locked.
+ * A bit is set when the resource of same index is assigned to the secure
+ * world; unregistered resources are non-secure hence read as zero. The
+ * runtime queries issued from the SCMI clock and reset paths then cost a
+ * single bit test instead of walking the registration state.
+ */
+static uint32_t shres_secure_mask;
+static unsigned int gpioz_secure_count;
+
+CASSERT(STM32MP1_SHRES_COUNT <= 32U, assert_shres_count_fits_secure_mask);
+
 static const char *shres2str_id_tbl[STM32MP1_SHRES_COUNT] = {
 	[STM32MP1_SHRES_GPIOZ(0)] = "GPIOZ0",
 	[STM32MP1_SHRES_GPIOZ(1)] = "GPIOZ1",
@@ -403,83 +415,74 @@ void stm32mp1_register_etzpc_decprot(unsigned int id,
 /* Get resource state: these accesses lock the registering support */
 static void lock_registering(void)
 {
+	unsigned int id;
+
+	if (registering_locked) {
+		return;
+	}
+
 	registering_locked = true;
+
+	/* Assignments cannot change anymore: freeze them in the snapshot */
+	for (id = 0U; id < STM32MP1_SHRES_COUNT; id++) {
+		if (shres_state[id] == SHRES_SECURE) {
+			shres_secure_mask |= BIT_32(id);
+		}
+	}
+
+	for (id = 0U; id < get_gpioz_nbpin(); id++) {
+		if ((shres_secure_mask & BIT_32(STM32MP1_SHRES_GPIOZ(id))) !=
+		    0U) {
+			gpioz_secure_count++;
+		}
+	}
 }
 
 bool stm32mp1_periph_is_non_secure(unsigned long id)
 {
-	lock_registering();
-
 	/* Resource not registered are assumed non-secure */
-	return (shres_state[id] == SHRES_NON_SECURE) ||
-	       (shres_state[id] == SHRES_UNREGISTERED);
+	return !stm32mp1_periph_is_secure(id);
 }
 
 bool stm32mp1_periph_is_secure(unsigned long id)
 {
 	lock_registering();
 
-	return shres_state[id] == SHRES_SECURE;
+	return (shres_secure_mask & BIT_32(id)) != 0U;
 }
 
 bool stm32mp_gpio_bank_is_shared(unsigned int bank)
 {
-	unsigned int non_secure = 0;
-	unsigned int i;
-
 	lock_registering();
 
 	if (bank != GPIO_BANK_Z) {
 		return false;
 	}
 
-	for (i = 0U; i < get_gpioz_nbpin(); i++) {
-		if (!stm32mp1_periph_is_secure(STM32MP1_SHRES_GPIOZ(i))) {
-			non_secure++;
-		}
-	}
-
-	return (non_secure != 0) && (non_secure < get_gpioz_nbpin());
+	return (gpioz_secure_count != 0U) &&
+	       (gpioz_secure_count < get_gpioz_nbpin());
 }
 
 bool stm32mp_gpio_bank_is_non_secure(unsigned int bank)
 {
-	unsigned int non_secure = 0;
-	unsigned int i;
-
 	lock_registering();
 
 	if (bank != GPIO_BANK_Z) {
 		return true;
 	}
 
-	for (i = 0U; i < get_gpioz_nbpin(); i++) {
-		if (!stm32mp1_periph_is_secure(STM32MP1_SHRES_GPIOZ(i))) {
-			non_secure++;
-		}
-	}
-
-	return non_secure == get_gpioz_nbpin();
+	return gpioz_secure_count == 0U;
 }
 
 static bool stm32mp_gpio_bank_is_secure(unsigned int bank)
 {
-	unsigned int secure = 0;
-	unsigned int i;
-
 	lock_registering();
 
 	if (bank != GPIO_BANK_Z) {
 		return false;
 	}
 
-	for (i = 0U; i < get_gpioz_nbpin(); i++) {
-		if (stm32mp1_periph_is_secure(STM32MP1_SHRES_GPIOZ(i))) {
-			secure++;
-		}
-	}
-
-	return secure == get_gpioz_nbpin();
+	return gpioz_secure_count == get_gpioz_nbpin();
 }
 
 CASSERT((CK_HSE == 0) &&
@@ -729,7 +732,7 @@ void stm32mp_lock_periph_registering(void)
 {
 	uint32_t __unused id;
 
-	registering_locked = true;
+	lock_registering();
 
 	for (id = 0; id < STM32MP1_SHRES_COUNT; id++) {
 		uint8_t state = shres_state[id];
@@ -119,12 +119,39 @@ static uint8_t usb_stm32mp1_config_desc[USB_DFU_CONFIG_DESC_SIZ] = {
 	 *  when using DMA USBD_DFU_XFER_SIZE should be set
 	 *  to 64 in usbd_conf.h
 	 */
-	TRANSFER_SIZE_BYTES(USBD_DFU_XFER_SIZE),/* TransferSize = 1024 Byte*/
+	TRANSFER_SIZE_BYTES(USBD_DFU_XFER_SIZE),/* TransferSize */
 	((USB_DFU_VERSION >> 0) & 0xFF), /* bcdDFUVersion*/
 	((USB_DFU_VERSION >> 8) & 0xFF)
 };
 
-static uint8_t usb_local_string_dec[USBD_MAX_STR_DESC_SIZ];
+/*
+ * String descriptors are built once at init time into these slots;
+ * enumeration then serves every GET_DESCRIPTOR request straight from the
+ * precomputed blobs, without per-request ASCII-to-UTF-16 conversion or,
+ * for the serial number, OTP shadow reads.
+ */
+#define USBD_PRECOMP_STR_SIZ		128U
+
+struct usb_precomp_str {
+	uint8_t desc[USBD_PRECOMP_STR_SIZ];
+	uint16_t len;
+};
+
+static struct usb_precomp_str usb_manufacturer_str;
+static struct usb_precomp_str usb_product_str;
+static struct usb_precomp_str usb_configuration_str;
+static struct usb_precomp_str usb_interface_str;
+static struct usb_precomp_str usb_usr_str[USBD_DESC_MAX_ITF_NUM];
+
+/* Alternate-setting memory mapping strings, indices 6 to 11 */
+static const char *const usb_usr_strings[USBD_DESC_MAX_ITF_NUM] = {
+	"@Partition0 /0x00/1*256Ke",
+	"@FSBL /0x01/1*1Me",
+	"@Partition2 /0x02/1*1Me",
+	"@Partition3 /0x03/1*16Me",
+	"@Partition4 /0x04/1*16Me",
+	"@virtual /0xF1/1*512Ba",
+};
 
 /*
  * Convert Hex 32Bits value into char
@@ -276,10 +303,9 @@ static uint8_t *stm32mp1_lang_id_desc(uint16_t *length)
  */
 static uint8_t *stm32mp1_product_desc(uint16_t *length)
 {
-	stm32mp1_get_string((uint8_t *)USBD_PRODUCT_HS_STRING,
-			    usb_local_string_dec, length);
+	*length = usb_product_str.len;
 
-	return usb_local_string_dec;
+	return usb_product_str.desc;
 }
 
 /*
@@ -290,10 +316,9 @@ static uint8_t *stm32mp1_product_desc(uint16_t *length)
  */
 static uint8_t *stm32mp1_manufacturer_desc(uint16_t *length)
 {
-	stm32mp1_get_string((uint8_t *)USBD_MANUFACTURER_STRING,
-			    usb_local_string_dec, length);
+	*length = usb_manufacturer_str.len;
 
-	return usb_local_string_dec;
+	return usb_manufacturer_str.desc;
 }
 
 /*
@@ -304,13 +329,9 @@ static uint8_t *stm32mp1_manufacturer_desc(uint16_t *length)
  */
 static uint8_t *stm32mp1_serial_desc(uint16_t *length)
 {
+	/* Built once at init time from the unique ID OTP words */
 	*length = USB_SIZ_STRING_SERIAL;
 
-	/* Update the serial number string descriptor
-	 * with the data from the unique ID
-	 */
-	update_serial_num_string();
-
 	return (uint8_t *)usb_stm32mp1_serial;
 }
 
@@ -322,10 +343,9 @@ static uint8_t *stm32mp1_serial_desc(uint16_t *length)
  */
 static uint8_t *stm32mp1_config_desc(uint16_t *length)
 {
-	stm32mp1_get_string((uint8_t *)USBD_CONFIGURATION_HS_STRING,
-			    usb_local_string_dec, length);
+	*length = usb_configuration_str.len;
 
-	return usb_local_string_dec;
+	return usb_configuration_str.desc;
 }
 
 /*
@@ -336,10 +356,9 @@ static uint8_t *stm32mp1_config_desc(uint16_t *length)
  */
 static uint8_t *stm32mp1_interface_desc(uint16_t *length)
 {
-	stm32mp1_get_string((uint8_t *)USBD_INTERFACE_HS_STRING,
-			    usb_local_string_dec, length);
+	*length = usb_interface_str.len;
 
-	return usb_local_string_dec;
+	return usb_interface_str.desc;
 }
 
 /*
@@ -352,48 +371,13 @@ static uint8_t *stm32mp1_interface_desc(uint16_t *length)
  */
 static uint8_t *stm32mp1_get_usr_desc(uint8_t index, uint16_t *length)
 {
-	uint8_t *ret;
-
-	if (index > (USBD_IDX_INTERFACE_STR + USBD_DESC_MAX_ITF_NUM))
+	if ((index <= USBD_IDX_INTERFACE_STR) ||
+	    (index > (USBD_IDX_INTERFACE_STR + USBD_DESC_MAX_ITF_NUM)))
 		return NULL;
 
-	switch (index) {
-	case 6:
-		stm32mp1_get_string((uint8_t *)"@Partition0 /0x00/1*256Ke",
-				    usb_local_string_dec, length);
-		ret = usb_local_string_dec;
-		break;
-	case 7:
-		stm32mp1_get_string((uint8_t *)"@FSBL /0x01/1*1Me",
-				    usb_local_string_dec, length);
-		ret = usb_local_string_dec;
-		break;
-	case 8:
-		stm32mp1_get_string((uint8_t *)"@Partition2 /0x02/1*1Me",
-				    usb_local_string_dec, length);
-		ret = usb_local_string_dec;
-		break;
-	case 9:
-		stm32mp1_get_string((uint8_t *)"@Partition3 /0x03/1*16Me",
-				    usb_local_string_dec, length);
-		ret = usb_local_string_dec;
-		break;
-	case 10:
-		stm32mp1_get_string((uint8_t *)"@Partition4 /0x04/1*16Me",
-				    usb_local_string_dec, length);
-		ret = usb_local_string_dec;
-		break;
-	case 11:
-		stm32mp1_get_string((uint8_t *)"@virtual /0xF1/1*512Ba",
-				    usb_local_string_dec, length);
-		ret = usb_local_string_dec;
-		break;
-	default:
-		ret = NULL;
-		break;
-	}
+	*length = usb_usr_str[index - USBD_IDX_INTERFACE_STR - 1].len;
 
-	return ret;
+	return usb_usr_str[index - USBD_IDX_INTERFACE_STR - 1].desc;
 }
 
 static const usb_desc_t dfu_desc = {
@@ -414,5 +398,26 @@ static const usb_desc_t dfu_desc = {
 
 void stm32mp_usb_init_desc(usb_handle_t *pdev)
 {
+	uint8_t i;
+
+	/* Build every string descriptor once, before enumeration starts */
+	stm32mp1_get_string((uint8_t *)USBD_MANUFACTURER_STRING,
+			    usb_manufacturer_str.desc,
+			    &usb_manufacturer_str.len);
+	stm32mp1_get_string((uint8_t *)USBD_PRODUCT_HS_STRING,
+			    usb_product_str.desc, &usb_product_str.len);
+	stm32mp1_get_string((uint8_t *)USBD_CONFIGURATION_HS_STRING,
+			    usb_configuration_str.desc,
+			    &usb_configuration_str.len);
+	stm32mp1_get_string((uint8_t *)USBD_INTERFACE_HS_STRING,
+			    usb_interface_str.desc, &usb_interface_str.len);
+
+	for (i = 0; i < USBD_DESC_MAX_ITF_NUM; i++) {
+		stm32mp1_get_string((uint8_t *)usb_usr_strings[i],
+				    usb_usr_str[i].desc, &usb_usr_str[i].len);
+	}
+
+	update_serial_num_string();
+
 	register_platform(pdev, &dfu_desc);
 }
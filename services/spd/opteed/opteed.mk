@@ -16,3 +16,17 @@ NEED_BL32		:=	yes
 
 # required so that optee code can control access to the timer registers
 NS_TIMER_SWITCH		:=	1
+
+# Route non-secure interrupts taken during a Yielding SMC Call to EL3 so the
+# dispatcher can preempt OPTEE, cache the continuation and hand the CPU back
+# to the normal world without a secure context unwind.
+OPTEED_NS_INTR_ASYNC_PREEMPT	:=	0
+
+ifeq ($(EL3_EXCEPTION_HANDLING),1)
+ifeq ($(OPTEED_NS_INTR_ASYNC_PREEMPT),1)
+$(error OPTEED_NS_INTR_ASYNC_PREEMPT is not supported when EL3_EXCEPTION_HANDLING=1)
+endif
+endif
+
+$(eval $(call assert_boolean,OPTEED_NS_INTR_ASYNC_PREEMPT))
+$(eval $(call add_define,OPTEED_NS_INTR_ASYNC_PREEMPT))
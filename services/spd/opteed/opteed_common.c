@@ -76,8 +76,7 @@ uint64_t opteed_synchronous_sp_entry(optee_context_t *optee_ctx)
 
 	/* Apply the Secure EL1 system register context and switch to it */
 	assert(cm_get_context(SECURE) == &optee_ctx->cpu_ctx);
-	cm_el1_sysregs_context_restore(SECURE);
-	cm_set_next_eret_context(SECURE);
+	cm_el1_sysregs_context_restore_and_set_next(SECURE);
 
 	rc = opteed_enter_sp(&optee_ctx->c_rt_ctx);
 #if ENABLE_ASSERTIONS
@@ -17,6 +17,7 @@
 #include <assert.h>
 #include <errno.h>
 #include <stddef.h>
+#include <string.h>
 
 #include <arch_helpers.h>
 #include <bl31/bl31.h>
@@ -24,6 +25,7 @@
 #include <common/debug.h>
 #include <common/runtime_svc.h>
 #include <lib/el3_runtime/context_mgmt.h>
+#include <lib/static_branch.h>
 #include <plat/common/platform.h>
 #include <tools_share/uuid.h>
 
@@ -43,8 +45,87 @@ struct optee_vectors *optee_vector_table;
 optee_context_t opteed_sp_context[OPTEED_CORE_COUNT];
 uint32_t opteed_rw;
 
+/*******************************************************************************
+ * Fast yield capability bits negotiated with OPTEE through
+ * TEESMC_OPTEED_RETURN_FAST_YIELD_QUERY. While the SYSREG_SHIM capability
+ * is set, OPTEE's entry shim preserves the EL1 system registers across
+ * yielding calls itself and the dispatcher skips the full context round
+ * trip on that path.
+ ******************************************************************************/
+uint32_t opteed_fast_yield;
+
+/*
+ * Static key mirroring the SYSREG_SHIM capability. The protocol is
+ * negotiated during opteed_init(), before bl31_main() applies the branch
+ * patches, so the capability check on the yielding call path costs a
+ * single patched instruction.
+ */
+static struct static_key opteed_fyield_sysreg_shim = STATIC_KEY_INIT(0);
+
 static int32_t opteed_init(void);
 
+#if OPTEED_NS_INTR_ASYNC_PREEMPT
+/*******************************************************************************
+ * This helper function handles the preemption of a call delegated to OPTEE
+ * by an EL3 routed non-secure interrupt. The general purpose and EL3 state
+ * of the preempted continuation were cached in the per-cpu context by the
+ * EL3 entry code, so only the S-EL1 system registers still need
+ * snapshotting before the normal world is re-entered to take its pending
+ * interrupt.
+ ******************************************************************************/
+static uint64_t opteed_handle_sp_preemption(void *handle)
+{
+	cpu_context_t *ns_cpu_context;
+	uint32_t linear_id = plat_my_core_pos();
+	optee_context_t *optee_ctx = &opteed_sp_context[linear_id];
+
+	assert(handle == cm_get_context(SECURE));
+	cm_el1_sysregs_context_save(SECURE);
+
+	set_optee_preempt_flag(optee_ctx->state);
+	set_optee_ns_stale_flag(optee_ctx->state);
+
+	/* Get a reference to the non-secure context */
+	ns_cpu_context = cm_get_context(NON_SECURE);
+	assert(ns_cpu_context);
+
+	/*
+	 * Restore non-secure state.
+	 */
+	cm_el1_sysregs_context_restore_and_set_next(NON_SECURE);
+
+	/*
+	 * OPTEE was preempted during execution of a Yielding SMC Call.
+	 * Return back to the normal world with SMC_PREEMPTED as error
+	 * code in x0. The normal world takes its pending interrupt and
+	 * then resumes the call with TEESMC_OPTEED_NS_RESUME.
+	 */
+	SMC_RET1(ns_cpu_context, SMC_PREEMPTED);
+}
+
+/*******************************************************************************
+ * This function is the handler registered for non-secure interrupts by the
+ * OPTEED. It validates the interrupt and upon success arranges entry into
+ * the normal world for handling the interrupt.
+ ******************************************************************************/
+static uint64_t opteed_ns_interrupt_handler(uint32_t id,
+					    uint32_t flags,
+					    void *handle,
+					    void *cookie)
+{
+	/* Check the security state when the exception was generated */
+	assert(get_interrupt_src_ss(flags) == SECURE);
+
+	/*
+	 * Disable the routing of NS interrupts from secure world to EL3 while
+	 * interrupted on this core.
+	 */
+	disable_intr_rm_local(INTR_TYPE_NS, SECURE);
+
+	return opteed_handle_sp_preemption(handle);
+}
+#endif
+
 /*******************************************************************************
  * This function is the handler registered for S-EL1 interrupts by the
  * OPTEED. It validates the interrupt and upon success arranges entry into
@@ -57,6 +138,9 @@ static uint64_t opteed_sel1_interrupt_handler(uint32_t id,
 {
 	uint32_t linear_id;
 	optee_context_t *optee_ctx;
+#if OPTEED_NS_INTR_ASYNC_PREEMPT
+	uint64_t spsr;
+#endif
 
 	/* Check the security state when the exception was generated */
 	assert(get_interrupt_src_ss(flags) == NON_SECURE);
@@ -72,9 +156,38 @@ static uint64_t opteed_sel1_interrupt_handler(uint32_t id,
 	optee_ctx = &opteed_sp_context[linear_id];
 	assert(&optee_ctx->cpu_ctx == cm_get_context(SECURE));
 
+#if OPTEED_NS_INTR_ASYNC_PREEMPT
+	/*
+	 * A preempted continuation may be cached in this context. Preserve
+	 * the EL3 state and the caller-saved registers which entry into
+	 * OPTEE's fiq handler will clobber; OPTEE preserves the callee-saved
+	 * registers and the S-EL1 system registers itself. The cached SPSR
+	 * belongs to the preempted continuation, so the fiq handler is
+	 * entered with a freshly constructed one instead.
+	 */
+	if (get_optee_preempt_flag(optee_ctx->state)) {
+		optee_ctx->saved_spsr_el3 = (uint32_t)SMC_GET_EL3(
+						&optee_ctx->cpu_ctx,
+						CTX_SPSR_EL3);
+		optee_ctx->saved_elr_el3 = SMC_GET_EL3(&optee_ctx->cpu_ctx,
+						       CTX_ELR_EL3);
+		memcpy(&optee_ctx->sp_ctx, &optee_ctx->cpu_ctx,
+		       OPTEED_SP_CTX_SIZE);
+
+		if (opteed_rw == OPTEE_AARCH64)
+			spsr = SPSR_64(MODE_EL1, MODE_SP_ELX,
+				       DISABLE_ALL_EXCEPTIONS);
+		else
+			spsr = SPSR_MODE32(MODE32_svc, SPSR_T_ARM,
+					   SPSR_E_LITTLE,
+					   DAIF_FIQ_BIT | DAIF_IRQ_BIT |
+					   DAIF_ABT_BIT);
+		SMC_SET_EL3(&optee_ctx->cpu_ctx, CTX_SPSR_EL3, spsr);
+	}
+#endif
+
 	cm_set_elr_el3(SECURE, (uint64_t)&optee_vector_table->fiq_entry);
-	cm_el1_sysregs_context_restore(SECURE);
-	cm_set_next_eret_context(SECURE);
+	cm_el1_sysregs_context_restore_and_set_next(SECURE);
 
 	/*
 	 * Tell the OPTEE that it has to handle an FIQ (synchronously).
@@ -200,6 +313,7 @@ static uintptr_t opteed_smc_handler(uint32_t smc_fid,
 	cpu_context_t *ns_cpu_context;
 	uint32_t linear_id = plat_my_core_pos();
 	optee_context_t *optee_ctx = &opteed_sp_context[linear_id];
+	uint32_t fast_yield;
 	uint64_t rc;
 
 	/*
@@ -215,7 +329,61 @@ static uintptr_t opteed_smc_handler(uint32_t smc_fid,
 		 */
 		assert(handle == cm_get_context(NON_SECURE));
 
-		cm_el1_sysregs_context_save(NON_SECURE);
+#if OPTEED_NS_INTR_ASYNC_PREEMPT
+		/*
+		 * Request from the normal world to resume a preempted
+		 * Yielding SMC Call at its cached continuation. Re-entry is
+		 * a plain return to the preempted point with the S-EL1
+		 * system registers reloaded.
+		 */
+		if (smc_fid == TEESMC_OPTEED_NS_RESUME) {
+			if (!get_optee_preempt_flag(optee_ctx->state))
+				SMC_RET1(handle, SMC_UNK);
+
+			cm_el1_sysregs_context_save(NON_SECURE);
+			clr_optee_preempt_flag(optee_ctx->state);
+
+			/*
+			 * Enable the routing of NS interrupts to EL3 during
+			 * resumption of the Yielding SMC Call on this core.
+			 */
+			enable_intr_rm_local(INTR_TYPE_NS, SECURE);
+
+			cm_el1_sysregs_context_restore_and_set_next(SECURE);
+			SMC_RET0(&optee_ctx->cpu_ctx);
+		}
+
+		/*
+		 * While a preempted continuation is cached, delegating
+		 * anything else to OPTEE would clobber it. The normal world
+		 * must resume the preempted call first.
+		 */
+		if (get_optee_preempt_flag(optee_ctx->state))
+			SMC_RET1(handle, SMC_UNK);
+#endif
+
+		/*
+		 * With the fast yield protocol negotiated, OPTEE's entry
+		 * shim preserves the EL1 system registers across yielding
+		 * calls itself, so leave the normal world values live
+		 * instead of swapping in the stored secure copies.
+		 */
+		if (static_branch_unlikely(&opteed_fyield_sysreg_shim) &&
+		    (GET_SMC_TYPE(smc_fid) != SMC_TYPE_FAST)) {
+			fast_yield = 1U;
+#if OPTEED_NS_INTR_ASYNC_PREEMPT
+			/*
+			 * A preemption would have to hand the CPU back to
+			 * the normal world mid-call, so keep a current copy
+			 * of its EL1 system registers even though OPTEE's
+			 * shim owns the round trip for the call itself.
+			 */
+			cm_el1_sysregs_context_save(NON_SECURE);
+#endif
+		} else {
+			fast_yield = 0U;
+			cm_el1_sysregs_context_save(NON_SECURE);
+		}
 
 		/*
 		 * We are done stashing the non-secure context. Ask the
@@ -241,9 +409,23 @@ static uintptr_t opteed_smc_handler(uint32_t smc_fid,
 		} else {
 			cm_set_elr_el3(SECURE, (uint64_t)
 					&optee_vector_table->yield_smc_entry);
+#if OPTEED_NS_INTR_ASYNC_PREEMPT
+			/*
+			 * Enable the routing of NS interrupts to EL3 during
+			 * processing of a Yielding SMC Call on this core.
+			 */
+			enable_intr_rm_local(INTR_TYPE_NS, SECURE);
+#endif
 		}
 
-		cm_el1_sysregs_context_restore(SECURE);
+		if (fast_yield == 0U) {
+			cm_el1_sysregs_context_restore(SECURE);
+			set_optee_fyield(optee_ctx->state,
+					 OPTEE_FYIELD_INACTIVE);
+		} else {
+			set_optee_fyield(optee_ctx->state,
+					 OPTEE_FYIELD_ACTIVE);
+		}
 		cm_set_next_eret_context(SECURE);
 
 		write_ctx_reg(get_gpregs_ctx(&optee_ctx->cpu_ctx),
@@ -304,6 +486,28 @@ static uintptr_t opteed_smc_handler(uint32_t smc_fid,
 						flags);
 			if (rc)
 				panic();
+
+#if OPTEED_NS_INTR_ASYNC_PREEMPT
+			/*
+			 * Register an interrupt handler for NS interrupts
+			 * when generated during code executing in secure
+			 * state are routed to EL3.
+			 */
+			flags = 0;
+			set_interrupt_rm_flag(flags, SECURE);
+
+			rc = register_interrupt_type_handler(INTR_TYPE_NS,
+						opteed_ns_interrupt_handler,
+						flags);
+			if (rc)
+				panic();
+
+			/*
+			 * Disable the NS interrupt locally. It is enabled
+			 * only while a Yielding SMC Call is being processed.
+			 */
+			disable_intr_rm_local(INTR_TYPE_NS, SECURE);
+#endif
 		}
 
 		/*
@@ -361,23 +565,84 @@ static uintptr_t opteed_smc_handler(uint32_t smc_fid,
 		 * and return to the non-secure state.
 		 */
 		assert(handle == cm_get_context(SECURE));
-		cm_el1_sysregs_context_save(SECURE);
 
 		/* Get a reference to the non-secure context */
 		ns_cpu_context = cm_get_context(NON_SECURE);
 		assert(ns_cpu_context);
 
-		/* Restore non-secure state */
-		cm_el1_sysregs_context_restore(NON_SECURE);
+		/*
+		 * On the fast yield path OPTEE's shim has already put the
+		 * normal world EL1 system registers back in place, so only
+		 * the results in x1-x4 need propagating.
+		 */
+		if (get_optee_fyield(optee_ctx->state) !=
+		    OPTEE_FYIELD_ACTIVE) {
+			cm_el1_sysregs_context_save(SECURE);
+
+			/* Restore non-secure state */
+			cm_el1_sysregs_context_restore(NON_SECURE);
+		}
+#if OPTEED_NS_INTR_ASYNC_PREEMPT
+		else if (get_optee_ns_stale_flag(optee_ctx->state)) {
+			/*
+			 * The call was preempted, so the normal world values
+			 * OPTEE's shim reinstated predate the interrupt
+			 * handling; reload the copy stashed on the last
+			 * normal world entry.
+			 */
+			cm_el1_sysregs_context_restore(NON_SECURE);
+		}
+		clr_optee_ns_stale_flag(optee_ctx->state);
+
+		/*
+		 * Disable the routing of NS interrupts to EL3 after
+		 * processing of the call on this core is finished.
+		 */
+		disable_intr_rm_local(INTR_TYPE_NS, SECURE);
+#endif
 		cm_set_next_eret_context(NON_SECURE);
 
 		SMC_RET4(ns_cpu_context, x1, x2, x3, x4);
 
+	/*
+	 * OPTEE is negotiating the fast yield protocol. Record the accepted
+	 * capability set and answer by re-entering OPTEE directly; no world
+	 * switch is involved.
+	 */
+	case TEESMC_OPTEED_RETURN_FAST_YIELD_QUERY:
+		assert(handle == cm_get_context(SECURE));
+
+		opteed_fast_yield = (uint32_t)x1 &
+				    TEESMC_OPTEED_FYIELD_CAP_SYSREG_SHIM;
+
+		if ((opteed_fast_yield &
+		     TEESMC_OPTEED_FYIELD_CAP_SYSREG_SHIM) != 0U)
+			static_key_enable(&opteed_fyield_sysreg_shim);
+		else
+			static_key_disable(&opteed_fyield_sysreg_shim);
+
+		SMC_RET1(handle, opteed_fast_yield);
+
 	/*
 	 * OPTEE has finished handling a S-EL1 FIQ interrupt. Execution
 	 * should resume in the normal world.
 	 */
 	case TEESMC_OPTEED_RETURN_FIQ_DONE:
+#if OPTEED_NS_INTR_ASYNC_PREEMPT
+		/*
+		 * Reinstate the preempted continuation which entry into
+		 * OPTEE's fiq handler clobbered.
+		 */
+		if (get_optee_preempt_flag(optee_ctx->state)) {
+			SMC_SET_EL3(&optee_ctx->cpu_ctx, CTX_SPSR_EL3,
+				    optee_ctx->saved_spsr_el3);
+			SMC_SET_EL3(&optee_ctx->cpu_ctx, CTX_ELR_EL3,
+				    optee_ctx->saved_elr_el3);
+			memcpy(&optee_ctx->cpu_ctx, &optee_ctx->sp_ctx,
+			       OPTEED_SP_CTX_SIZE);
+		}
+#endif
+
 		/* Get a reference to the non-secure context */
 		ns_cpu_context = cm_get_context(NON_SECURE);
 		assert(ns_cpu_context);
@@ -387,8 +652,7 @@ static uintptr_t opteed_smc_handler(uint32_t smc_fid,
 		 * secure system register context since OPTEE was supposed
 		 * to preserve it during S-EL1 interrupt handling.
 		 */
-		cm_el1_sysregs_context_restore(NON_SECURE);
-		cm_set_next_eret_context(NON_SECURE);
+		cm_el1_sysregs_context_restore_and_set_next(NON_SECURE);
 
 		SMC_RET0((uint64_t) ns_cpu_context);
 
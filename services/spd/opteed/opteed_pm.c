@@ -35,6 +35,15 @@ static int32_t opteed_cpu_off_handler(u_register_t unused)
 	assert(optee_vector_table);
 	assert(get_optee_pstate(optee_ctx->state) == OPTEE_PSTATE_ON);
 
+#if OPTEED_NS_INTR_ASYNC_PREEMPT
+	/*
+	 * Entering OPTEE would clobber a cached preempted continuation. The
+	 * normal world must resume the preempted call before turning the
+	 * core off.
+	 */
+	assert(!get_optee_preempt_flag(optee_ctx->state));
+#endif
+
 	/* Program the entry point and enter OPTEE */
 	cm_set_elr_el3(SECURE, (uint64_t) &optee_vector_table->cpu_off_entry);
 	rc = opteed_synchronous_sp_entry(optee_ctx);
@@ -68,6 +77,15 @@ static void opteed_cpu_suspend_handler(u_register_t max_off_pwrlvl)
 	assert(optee_vector_table);
 	assert(get_optee_pstate(optee_ctx->state) == OPTEE_PSTATE_ON);
 
+#if OPTEED_NS_INTR_ASYNC_PREEMPT
+	/*
+	 * Entering OPTEE would clobber a cached preempted continuation. The
+	 * normal world must resume the preempted call before suspending the
+	 * core.
+	 */
+	assert(!get_optee_preempt_flag(optee_ctx->state));
+#endif
+
 	write_ctx_reg(get_gpregs_ctx(&optee_ctx->cpu_ctx), CTX_GPREG_X0,
 		      max_off_pwrlvl);
 
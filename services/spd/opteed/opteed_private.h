@@ -34,6 +34,52 @@
 				} while (0)
 
 
+/*******************************************************************************
+ * OPTEE fast yield state. It records whether the SMC last delegated to OPTEE
+ * on this core used the negotiated fast yield protocol, so that the matching
+ * TEESMC_OPTEED_RETURN_CALL_DONE skips the EL1 system register round trip.
+ ******************************************************************************/
+#define OPTEE_FYIELD_INACTIVE		0
+#define OPTEE_FYIELD_ACTIVE		1
+#define OPTEE_FYIELD_SHIFT		2
+#define OPTEE_FYIELD_MASK		0x1
+#define get_optee_fyield(state)	((state >> OPTEE_FYIELD_SHIFT) & \
+					 OPTEE_FYIELD_MASK)
+#define clr_optee_fyield(state)	(state &= ~(OPTEE_FYIELD_MASK \
+						    << OPTEE_FYIELD_SHIFT))
+#define set_optee_fyield(st, f)	do {					       \
+						clr_optee_fyield(st);	       \
+						st |= (f & OPTEE_FYIELD_MASK) <<   \
+							OPTEE_FYIELD_SHIFT;    \
+					} while (0)
+
+/*******************************************************************************
+ * OPTEE preemption state. The PREEMPT flag records that a call delegated to
+ * OPTEE was preempted by an EL3 routed non-secure interrupt and that its
+ * continuation is cached in the per-cpu context until the normal world
+ * resumes it. The NS_STALE flag records that such a preemption happened
+ * during the call in flight, so the normal world EL1 system registers
+ * OPTEE's entry shim reinstates on the fast yield path predate the normal
+ * world interrupt handling and must be reloaded from the dispatcher's copy.
+ ******************************************************************************/
+#define OPTEE_PREEMPT_SHIFT		3
+#define OPTEE_PREEMPT_MASK		0x1
+#define get_optee_preempt_flag(state)	((state >> OPTEE_PREEMPT_SHIFT) & \
+					 OPTEE_PREEMPT_MASK)
+#define set_optee_preempt_flag(state)	(state |= OPTEE_PREEMPT_MASK << \
+					 OPTEE_PREEMPT_SHIFT)
+#define clr_optee_preempt_flag(state)	(state &= ~(OPTEE_PREEMPT_MASK << \
+						    OPTEE_PREEMPT_SHIFT))
+
+#define OPTEE_NS_STALE_SHIFT		4
+#define OPTEE_NS_STALE_MASK		0x1
+#define get_optee_ns_stale_flag(state)	((state >> OPTEE_NS_STALE_SHIFT) & \
+					 OPTEE_NS_STALE_MASK)
+#define set_optee_ns_stale_flag(state)	(state |= OPTEE_NS_STALE_MASK << \
+					 OPTEE_NS_STALE_SHIFT)
+#define clr_optee_ns_stale_flag(state)	(state &= ~(OPTEE_NS_STALE_MASK << \
+						    OPTEE_NS_STALE_SHIFT))
+
 /*******************************************************************************
  * OPTEE execution state information i.e. aarch32 or aarch64
  ******************************************************************************/
@@ -79,6 +125,34 @@
 #define OPTEED_C_RT_CTX_SIZE		0x60
 #define OPTEED_C_RT_CTX_ENTRIES		(OPTEED_C_RT_CTX_SIZE >> DWORD_SHIFT)
 
+/*******************************************************************************
+ * Constants that allow the preempted OPTEE caller-saved register context to
+ * be preserved while OPTEE is re-entered through the "fiq" vector.
+ * Note: These offsets have to match with the offsets for the corresponding
+ * registers in cpu_context as we are using memcpy to copy the values from
+ * cpu_context to sp_ctx.
+ ******************************************************************************/
+#define OPTEED_SP_CTX_X0		0x0
+#define OPTEED_SP_CTX_X1		0x8
+#define OPTEED_SP_CTX_X2		0x10
+#define OPTEED_SP_CTX_X3		0x18
+#define OPTEED_SP_CTX_X4		0x20
+#define OPTEED_SP_CTX_X5		0x28
+#define OPTEED_SP_CTX_X6		0x30
+#define OPTEED_SP_CTX_X7		0x38
+#define OPTEED_SP_CTX_X8		0x40
+#define OPTEED_SP_CTX_X9		0x48
+#define OPTEED_SP_CTX_X10		0x50
+#define OPTEED_SP_CTX_X11		0x58
+#define OPTEED_SP_CTX_X12		0x60
+#define OPTEED_SP_CTX_X13		0x68
+#define OPTEED_SP_CTX_X14		0x70
+#define OPTEED_SP_CTX_X15		0x78
+#define OPTEED_SP_CTX_X16		0x80
+#define OPTEED_SP_CTX_X17		0x88
+#define OPTEED_SP_CTX_SIZE		0x90
+#define OPTEED_SP_CTX_ENTRIES		(OPTEED_SP_CTX_SIZE >> DWORD_SHIFT)
+
 #ifndef __ASSEMBLER__
 
 #include <stdint.h>
@@ -116,6 +190,19 @@ DEFINE_REG_STRUCT(c_rt_regs, OPTEED_C_RT_CTX_ENTRIES);
 CASSERT(OPTEED_C_RT_CTX_SIZE == sizeof(c_rt_regs_t),	\
 	assert_spd_c_rt_regs_size_mismatch);
 
+#if OPTEED_NS_INTR_ASYNC_PREEMPT
+/* OPTEE caller saved register context structure. */
+DEFINE_REG_STRUCT(sp_ctx_regs, OPTEED_SP_CTX_ENTRIES);
+
+/*
+ * Compile time assertion to ensure that both the compiler and linker
+ * have the same double word aligned view of the size of the caller-saved
+ * register context.
+ */
+CASSERT(OPTEED_SP_CTX_SIZE == sizeof(sp_ctx_regs_t),	\
+	assert_spd_sp_regs_size_mismatch);
+#endif
+
 /*******************************************************************************
  * Structure which helps the OPTEED to maintain the per-cpu state of OPTEE.
  * 'state'          - collection of flags to track OPTEE state e.g. on/off
@@ -123,12 +210,24 @@ CASSERT(OPTEED_C_RT_CTX_SIZE == sizeof(c_rt_regs_t),	\
  * 'c_rt_ctx'       - stack address to restore C runtime context from after
  *                    returning from a synchronous entry into OPTEE.
  * 'cpu_ctx'        - space to maintain OPTEE architectural state
+ * 'saved_elr_el3'  - temporary copy to allow S-EL1 interrupt handling when
+ *                    a preempted continuation is cached in 'cpu_ctx'.
+ * 'saved_spsr_el3' - temporary copy to allow S-EL1 interrupt handling when
+ *                    a preempted continuation is cached in 'cpu_ctx'.
+ * 'sp_ctx'         - space to save the OPTEE caller saved register context
+ *                    while OPTEE is re-entered through the "fiq" vector with
+ *                    a preempted continuation cached in 'cpu_ctx'.
  ******************************************************************************/
 typedef struct optee_context {
 	uint32_t state;
 	uint64_t mpidr;
 	uint64_t c_rt_ctx;
 	cpu_context_t cpu_ctx;
+#if OPTEED_NS_INTR_ASYNC_PREEMPT
+	uint64_t saved_elr_el3;
+	uint32_t saved_spsr_el3;
+	sp_ctx_regs_t sp_ctx;
+#endif
 } optee_context_t;
 
 /* OPTEED power management handlers */
@@ -156,6 +255,7 @@ void opteed_init_optee_ep_state(struct entry_point_info *optee_entry_point,
 
 extern optee_context_t opteed_sp_context[OPTEED_CORE_COUNT];
 extern uint32_t opteed_rw;
+extern uint32_t opteed_fast_yield;
 extern struct optee_vectors *optee_vector_table;
 #endif /*__ASSEMBLER__*/
 
@@ -120,4 +120,49 @@
 #define TEESMC_OPTEED_RETURN_SYSTEM_RESET_DONE \
 	TEESMC_OPTEED_RV(TEESMC_OPTEED_FUNCID_RETURN_SYSTEM_RESET_DONE)
 
+/*
+ * Issued by OP-TEE, normally during its initialization, to negotiate the
+ * fast yield protocol. The dispatcher answers by re-entering OP-TEE
+ * directly with the accepted capability set; no world switch is involved.
+ *
+ * Once TEESMC_OPTEED_FYIELD_CAP_SYSREG_SHIM has been accepted, OP-TEE's
+ * entry shim takes over preservation of the EL1 system registers for
+ * yielding calls in both directions: the dispatcher leaves the normal
+ * world values live when delegating a yielding SMC and when OP-TEE
+ * returns with TEESMC_OPTEED_RETURN_CALL_DONE, and OP-TEE must neither
+ * rely on the dispatcher to carry its S-EL1 system register state across
+ * yielding calls nor leave the normal world values modified on return.
+ * Fast SMCs and the FIQ path keep the full context round trip.
+ *
+ * Register usage:
+ * r0/x0	SMC Function ID, TEESMC_OPTEED_RETURN_FAST_YIELD_QUERY
+ * r1/x1	Requested capability bits (TEESMC_OPTEED_FYIELD_CAP_*)
+ *
+ * Returns to OP-TEE with the accepted capability bits in r0/x0.
+ */
+#define TEESMC_OPTEED_FUNCID_RETURN_FAST_YIELD_QUERY	9
+#define TEESMC_OPTEED_RETURN_FAST_YIELD_QUERY \
+	TEESMC_OPTEED_RV(TEESMC_OPTEED_FUNCID_RETURN_FAST_YIELD_QUERY)
+
+/* OP-TEE preserves the EL1 system registers across yielding calls. */
+#define TEESMC_OPTEED_FYIELD_CAP_SYSREG_SHIM		0x1
+
+/*
+ * Issued by the normal world to resume a call that was preempted by an EL3
+ * routed non-secure interrupt (OPTEED_NS_INTR_ASYNC_PREEMPT=1). Such a
+ * preemption makes the original SMC return with SMC_PREEMPTED and leaves the
+ * continuation cached in the dispatcher; the normal world must take its
+ * pending interrupt and then issue this call, before any other SMC towards
+ * OP-TEE on the same core, to re-enter OP-TEE at the preempted point.
+ *
+ * Register usage:
+ * r0/x0	SMC Function ID, TEESMC_OPTEED_NS_RESUME
+ *
+ * Returns as the original, resumed call. SMC_UNK is returned if no preempted
+ * continuation is cached on this core.
+ */
+#define TEESMC_OPTEED_FUNCID_NS_RESUME			0x10
+#define TEESMC_OPTEED_NS_RESUME \
+	TEESMC_OPTEED_NS_RV(TEESMC_OPTEED_FUNCID_NS_RESUME)
+
 #endif /*TEESMC_OPTEED_H*/
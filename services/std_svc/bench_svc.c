@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdint.h>
+
+#include <arch_helpers.h>
+#include <common/debug.h>
+#include <common/runtime_svc.h>
+#include <lib/pmf/pmf.h>
+#include <services/bench_svc.h>
+#include <smccc_helpers.h>
+
+/*
+ * SMC benchmark service.
+ *
+ * BENCH_SVC_ECHO is the cheapest possible round trip: the arguments are
+ * handed straight back, so its latency measured from the normal world is
+ * the world-switch plus dispatch cost. BENCH_SVC_ECHO_TS additionally
+ * captures EL3 entry and exit time-stamps, retrievable through the PMF SMC
+ * interface, so a caller comparing them with its own counter reads around
+ * the call can split the round trip into entry path, EL3 residency and
+ * exit path. The two stamps also bound the overhead of a PMF capture
+ * itself, which calibrates the timestamped PSCI instrumentation
+ * (ENABLE_RUNTIME_INSTRUMENTATION) this service is meant to be used with.
+ */
+PMF_REGISTER_SERVICE_SMC(bench_svc, PMF_BENCH_SVC_ID, BENCH_TS_TOTAL_IDS,
+			 PMF_STORE_ENABLE)
+
+uintptr_t bench_svc_smc_handler(uint32_t smc_fid,
+				u_register_t x1,
+				u_register_t x2,
+				u_register_t x3,
+				u_register_t x4,
+				void *cookie,
+				void *handle,
+				u_register_t flags)
+{
+	switch (smc_fid) {
+	case BENCH_SVC_VERSION:
+		SMC_RET2(handle, BENCH_SVC_VERSION_MAJOR,
+			 BENCH_SVC_VERSION_MINOR);
+
+	case BENCH_SVC_ECHO:
+		SMC_RET4(handle, 0, x1, x2, x3);
+
+	case BENCH_SVC_SPIN: {
+		/*
+		 * Calibrated EL3 residency for contention soak tests: load
+		 * generators on other cores pile up on the secure state
+		 * while this CPU sits here.
+		 */
+		uint64_t end = read_cntpct_el0() + x1;
+
+		while (read_cntpct_el0() < end) {
+		}
+		SMC_RET4(handle, 0, x1, x2, x3);
+	}
+
+	case BENCH_SVC_ECHO_TS:
+		PMF_CAPTURE_TIMESTAMP(bench_svc, BENCH_TS_ENTER,
+				      PMF_NO_CACHE_MAINT);
+		PMF_CAPTURE_TIMESTAMP(bench_svc, BENCH_TS_EXIT,
+				      PMF_NO_CACHE_MAINT);
+		SMC_RET4(handle, 0, x1, x2, x3);
+
+	default:
+		WARN("Unimplemented benchmark service call: 0x%x\n", smc_fid);
+		SMC_RET1(handle, SMC_UNK);
+	}
+}
@@ -6,12 +6,42 @@
 
 #include <assert.h>
 
+#include <platform_def.h>
+
+#include <lib/cassert.h>
 #include <lib/utils.h>
 
 #include "sdei_private.h"
 
 #define MAP_OFF(_map, _mapping) ((_map) - (_mapping)->map)
 
+/* Number of slots in the per-CPU interrupt number lookup cache */
+#define INTR_MAP_CACHE_SLOTS	U(16)
+
+CASSERT((INTR_MAP_CACHE_SLOTS & (INTR_MAP_CACHE_SLOTS - 1U)) == 0U,
+		assert_intr_map_cache_slots_power_of_2);
+
+/*
+ * Per-CPU, direct-mapped cache of recent interrupt number to event mapping
+ * translations, filled as a side effect of the linear search below. Bound
+ * interrupts fire repeatedly, so the dispatch path normally hits here and
+ * resolves its mapping in a constant small number of loads.
+ *
+ * The cache is maintained without locking: each CPU only ever touches its own
+ * slots, and a hit is only trusted after re-checking the mapping's current
+ * interrupt number. Releasing a binding resets the mapping's interrupt number
+ * to SDEI_DYN_IRQ, so stale slots fail that check and fall back to the scan.
+ */
+static sdei_ev_map_t *intr_map_cache[PLATFORM_CORE_COUNT]
+				    [INTR_MAP_CACHE_SLOTS];
+
+static sdei_ev_map_t **intr_map_cache_slot(unsigned int intr_num)
+{
+	unsigned int idx = intr_num & (INTR_MAP_CACHE_SLOTS - 1U);
+
+	return &intr_map_cache[plat_my_core_pos()][idx];
+}
+
 /*
  * Get SDEI entry with the given mapping: on success, returns pointer to SDEI
  * entry. On error, returns NULL.
@@ -58,9 +88,22 @@ sdei_entry_t *get_event_entry(sdei_ev_map_t *map)
 sdei_ev_map_t *find_event_map_by_intr(unsigned int intr_num, bool shared)
 {
 	const sdei_mapping_t *mapping;
+	sdei_ev_map_t **slot;
 	sdei_ev_map_t *map;
 	unsigned int i;
 
+	/*
+	 * Consult this CPU's lookup cache first. A hit is only valid if the
+	 * cached mapping still carries this interrupt number and is of the
+	 * requested type.
+	 */
+	slot = intr_map_cache_slot(intr_num);
+	map = *slot;
+	if ((map != NULL) && (map->intr == intr_num) &&
+			(is_event_shared(map) == shared)) {
+		return map;
+	}
+
 	/*
 	 * Look for a match in private and shared mappings, as requested. This
 	 * is a linear search. However, if the mappings are required to be
@@ -68,8 +111,10 @@ sdei_ev_map_t *find_event_map_by_intr(unsigned int intr_num, bool shared)
 	 */
 	mapping = shared ? SDEI_SHARED_MAPPING() : SDEI_PRIVATE_MAPPING();
 	iterate_mapping(mapping, i, map) {
-		if (map->intr == intr_num)
+		if (map->intr == intr_num) {
+			*slot = map;
 			return map;
+		}
 	}
 
 	return NULL;
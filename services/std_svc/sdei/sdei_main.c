@@ -40,6 +40,17 @@ CASSERT(PLAT_SDEI_CRITICAL_PRI < PLAT_SDEI_NORMAL_PRI,
 
 static unsigned int num_dyn_priv_slots, num_dyn_shrd_slots;
 
+/*
+ * Generation count of the shared event registration state. Bumped on every
+ * successful operation that alters a shared event registration, its enable
+ * state or routing, or a dynamic interrupt binding. Clients snapshot this
+ * via SDEI_FEATURES before suspending and validate it on resume to skip
+ * replaying their register/enable/bind sequence when the firmware-side
+ * state survived. The counter lives in BL31 .bss, so any reset that loses
+ * firmware context also zeroes it and forces a mismatch.
+ */
+static uint64_t sdei_reg_generation;
+
 /* Initialise SDEI map entries */
 static void init_map(sdei_ev_map_t *map)
 {
@@ -321,6 +332,8 @@ static int sdei_event_routing_set(int ev_num, uint64_t flags, uint64_t mpidr)
 	 */
 	plat_ic_set_spi_routing(map->intr, routing, (u_register_t) mpidr);
 
+	sdei_reg_generation++;
+
 finish:
 	sdei_map_unlock(map);
 
@@ -433,6 +446,9 @@ static int64_t sdei_event_register(int ev_num, uint64_t ep, uint64_t arg,
 	/* Increment register count */
 	map->reg_count++;
 
+	if (is_event_shared(map))
+		sdei_reg_generation++;
+
 	sdei_map_unlock(map);
 
 	return 0;
@@ -477,6 +493,9 @@ static int64_t sdei_event_enable(int ev_num)
 	if (is_map_bound(map) && (!before && after))
 		plat_ic_enable_interrupt(map->intr);
 
+	if (is_event_shared(map))
+		sdei_reg_generation++;
+
 	ret = 0;
 
 finish:
@@ -517,6 +536,9 @@ static int sdei_event_disable(int ev_num)
 	if (is_map_bound(map) && (before && !after))
 		plat_ic_disable_interrupt(map->intr);
 
+	if (is_event_shared(map))
+		sdei_reg_generation++;
+
 	ret = 0;
 
 finish:
@@ -644,6 +666,9 @@ static int sdei_event_unregister(int ev_num)
 
 	clear_event_entries(se);
 
+	if (is_event_shared(map))
+		sdei_reg_generation++;
+
 	/*
 	 * If the handler is running at the time of unregister, return the
 	 * pending error code.
@@ -745,6 +770,7 @@ static int sdei_interrupt_bind(unsigned int intr_num)
 		if (!is_map_bound(map)) {
 			map->intr = intr_num;
 			set_map_bound(map);
+			sdei_reg_generation++;
 			retry = false;
 		}
 		sdei_map_unlock(map);
@@ -804,6 +830,7 @@ static int sdei_interrupt_release(int ev_num)
 
 		map->intr = SDEI_DYN_IRQ;
 		clr_map_bound(map);
+		sdei_reg_generation++;
 	} else {
 		SDEI_LOG("Error release bound:%d cnt:%d\n", is_map_bound(map),
 				map->reg_count);
@@ -922,9 +949,25 @@ static uint64_t sdei_features(unsigned int feature)
 				num_dyn_shrd_slots);
 	}
 
+	if (feature == SDEI_FEATURE_REG_GENERATION)
+		return sdei_reg_generation;
+
 	return (uint64_t) SDEI_EINVAL;
 }
 
+/*
+ * Validate a registration snapshot on resume. Returns 0 if no shared event
+ * registration, enable, routing or binding change occurred since the
+ * snapshot was taken, in which case the client may skip replaying its
+ * register/enable/bind sequence for shared events. Private events are
+ * re-initialised per PE on power-up and must still be restored by the
+ * client.
+ */
+static int64_t sdei_event_resume_validate(uint64_t snapshot)
+{
+	return (snapshot == sdei_reg_generation) ? 0 : SDEI_EDENY;
+}
+
 /* SDEI top level handler for servicing SMCs */
 uint64_t sdei_smc_handler(uint32_t smc_fid,
 			  uint64_t x1,
@@ -1071,6 +1114,12 @@ uint64_t sdei_smc_handler(uint32_t smc_fid,
 		SDEI_LOG("< FTRS:%llx\n", ret);
 		SMC_RET1(ctx, ret);
 
+	case SDEI_EVENT_RESUME_VALIDATE:
+		SDEI_LOG("> RES_VAL(g:%llx)\n", x1);
+		ret = sdei_event_resume_validate(x1);
+		SDEI_LOG("< RES_VAL:%lld\n", ret);
+		SMC_RET1(ctx, ret);
+
 	case SDEI_EVENT_SIGNAL:
 		SDEI_LOG("> SIGNAL(e:%d t:%llx)\n", ev_num, x2);
 		ret = sdei_signal(ev_num, x2);
@@ -85,6 +85,8 @@
 
 /* SDEI_FEATURES */
 #define SDEI_FEATURE_BIND_SLOTS		0U
+/* Implementation-specific: shared event registration generation count */
+#define SDEI_FEATURE_REG_GENERATION	1U
 #define BIND_SLOTS_MASK			0xffffU
 #define FEATURES_SHARED_SLOTS_SHIFT	16U
 #define FEATURES_PRIVATE_SLOTS_SHIFT	0U
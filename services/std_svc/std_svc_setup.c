@@ -13,6 +13,9 @@
 #include <lib/pmf/pmf.h>
 #include <lib/psci/psci.h>
 #include <lib/runtime_instr.h>
+#if BENCH_SVC
+#include <services/bench_svc.h>
+#endif
 #include <services/sdei.h>
 #include <services/spm_svc.h>
 #include <services/std_svc.h>
@@ -121,6 +124,13 @@ static uintptr_t std_svc_smc_handler(uint32_t smc_fid,
 	}
 #endif
 
+#if BENCH_SVC
+	if (is_bench_svc_fid(smc_fid)) {
+		return bench_svc_smc_handler(smc_fid, x1, x2, x3, x4, cookie,
+				handle, flags);
+	}
+#endif
+
 	switch (smc_fid) {
 	case ARM_STD_SVC_CALL_COUNT:
 		/*
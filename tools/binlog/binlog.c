@@ -0,0 +1,345 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Renderer for the TF-A binary log stream (TF_LOG_BINARY=1).
+ * Feed it a capture of the console output and the matching firmware ELF,
+ * which provides the format and argument strings referenced by address:
+ *
+ *   binlog <console capture file> <firmware elf>
+ *
+ * Plain text in the capture is passed through unchanged, so a capture mixing
+ * boot-time text logs and drained binary records renders in order. See
+ * include/common/tf_log_binary.h for the record wire format.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <common/tf_log_binary.h>
+
+/* Loadable segment of the firmware ELF, backing store for string lookups */
+struct segment {
+	uint64_t vaddr;
+	uint64_t size;
+	const uint8_t *data;
+};
+
+static struct segment *segments;
+static size_t num_segments;
+static int elf_is_64;
+
+static const char *log_prefix[] = {
+	"ERROR:   ", "NOTICE:  ", "WARNING: ", "INFO:    ", "VERBOSE: "
+};
+
+static uint64_t get_le(const uint8_t *p, size_t size)
+{
+	uint64_t val = 0;
+	size_t i;
+
+	for (i = 0; i < size; i++)
+		val |= (uint64_t)p[i] << (8 * i);
+	return val;
+}
+
+/*
+ * Map a target address to the ELF image. Strings must be NUL-terminated
+ * inside their segment to be accepted.
+ */
+static const char *resolve_str(uint64_t addr)
+{
+	size_t i;
+
+	for (i = 0; i < num_segments; i++) {
+		const struct segment *seg = &segments[i];
+
+		if (addr < seg->vaddr || addr >= seg->vaddr + seg->size)
+			continue;
+
+		if (memchr(seg->data + (addr - seg->vaddr), '\0',
+			   seg->size - (addr - seg->vaddr)) == NULL)
+			return NULL;
+
+		return (const char *)seg->data + (addr - seg->vaddr);
+	}
+
+	return NULL;
+}
+
+static uint8_t *read_file(const char *name, size_t *size)
+{
+	FILE *fp = fopen(name, "rb");
+	uint8_t *buf;
+	long len;
+
+	if (fp == NULL) {
+		fprintf(stderr, "Cannot open %s\n", name);
+		exit(1);
+	}
+
+	fseek(fp, 0, SEEK_END);
+	len = ftell(fp);
+	fseek(fp, 0, SEEK_SET);
+
+	buf = malloc(len);
+	if (buf == NULL || fread(buf, 1, len, fp) != (size_t)len) {
+		fprintf(stderr, "Cannot read %s\n", name);
+		exit(1);
+	}
+
+	fclose(fp);
+	*size = len;
+	return buf;
+}
+
+/* Minimal little-endian ELF32/ELF64 program header walk */
+static void load_elf(const char *name)
+{
+	size_t size;
+	uint8_t *elf = read_file(name, &size);
+	uint64_t phoff;
+	unsigned int phentsize, phnum, i;
+
+	if (size < 64 || memcmp(elf, "\x7f""ELF", 4) != 0 || elf[5] != 1) {
+		fprintf(stderr, "%s is not a little-endian ELF file\n", name);
+		exit(1);
+	}
+
+	elf_is_64 = (elf[4] == 2);
+
+	if (elf_is_64) {
+		phoff = get_le(elf + 0x20, 8);
+		phentsize = get_le(elf + 0x36, 2);
+		phnum = get_le(elf + 0x38, 2);
+	} else {
+		phoff = get_le(elf + 0x1c, 4);
+		phentsize = get_le(elf + 0x2a, 2);
+		phnum = get_le(elf + 0x2c, 2);
+	}
+
+	segments = calloc(phnum, sizeof(*segments));
+	if (segments == NULL) {
+		fprintf(stderr, "Out of memory\n");
+		exit(1);
+	}
+
+	for (i = 0; i < phnum; i++) {
+		const uint8_t *ph = elf + phoff + (uint64_t)i * phentsize;
+		uint64_t type, offset, vaddr, filesz;
+
+		type = get_le(ph, 4);
+		if (type != 1) /* PT_LOAD */
+			continue;
+
+		if (elf_is_64) {
+			offset = get_le(ph + 0x08, 8);
+			vaddr = get_le(ph + 0x10, 8);
+			filesz = get_le(ph + 0x20, 8);
+		} else {
+			offset = get_le(ph + 0x04, 4);
+			vaddr = get_le(ph + 0x08, 4);
+			filesz = get_le(ph + 0x10, 4);
+		}
+
+		if (offset + filesz > size)
+			continue;
+
+		segments[num_segments].vaddr = vaddr;
+		segments[num_segments].size = filesz;
+		segments[num_segments].data = elf + offset;
+		num_segments++;
+	}
+}
+
+static void print_num(uint64_t val, unsigned int radix, int is_signed,
+		      int padn)
+{
+	char buf[32];
+	int i = 0;
+
+	if (is_signed && (int64_t)val < 0) {
+		putchar('-');
+		val = (uint64_t)(-(int64_t)val);
+		padn--;
+	}
+
+	do {
+		unsigned int rem = val % radix;
+
+		buf[i++] = (rem < 10) ? '0' + rem : 'a' + (rem - 10);
+		val /= radix;
+	} while (val != 0);
+
+	while (i < padn--)
+		putchar('0');
+
+	while (--i >= 0)
+		putchar(buf[i]);
+}
+
+/*
+ * Render one record with the conversion subset of the firmware vprintf():
+ * d, i, u, x, p and s with l, ll and z length modifiers and %0NN padding.
+ * Argument widths were normalized to 64 bits at capture; the ELF class
+ * tells how wide the target's long and non-ll values really are.
+ */
+static void render(const char *fmt, const uint64_t *args, unsigned int nargs)
+{
+	unsigned int next = 0;
+	int l_count, padn;
+	uint64_t val;
+
+	if (*fmt >= 10 && *fmt <= 50 && (*fmt % 10) == 0) {
+		fputs(log_prefix[*fmt / 10 - 1], stdout);
+		fmt++;
+	}
+
+	while (*fmt != '\0') {
+		if (*fmt != '%') {
+			putchar(*fmt++);
+			continue;
+		}
+
+		fmt++;
+		l_count = 0;
+		padn = 0;
+loop:
+		switch (*fmt) {
+		case '0':
+			fmt++;
+			while (*fmt >= '0' && *fmt <= '9')
+				padn = padn * 10 + (*fmt++ - '0');
+			goto loop;
+		case 'z':
+			if (elf_is_64)
+				l_count = 2;
+			fmt++;
+			goto loop;
+		case 'l':
+			l_count++;
+			fmt++;
+			goto loop;
+		case 'i':
+		case 'd':
+		case 'u':
+		case 'x':
+			if (next >= nargs)
+				return;
+			val = args[next++];
+			if (l_count < 2 && !(l_count == 1 && elf_is_64))
+				val &= 0xffffffffULL;
+			if (*fmt == 'x')
+				print_num(val, 16, 0, padn);
+			else if (*fmt == 'u')
+				print_num(val, 10, 0, padn);
+			else if (l_count < 2 && !(l_count == 1 && elf_is_64))
+				print_num((uint64_t)(int64_t)(int32_t)val,
+					  10, 1, padn);
+			else
+				print_num(val, 10, 1, padn);
+			fmt++;
+			break;
+		case 'p':
+			if (next >= nargs)
+				return;
+			val = args[next++];
+			if (val != 0) {
+				fputs("0x", stdout);
+				padn -= 2;
+			}
+			print_num(val, 16, 0, padn);
+			fmt++;
+			break;
+		case 's': {
+			const char *str;
+
+			if (next >= nargs)
+				return;
+			str = resolve_str(args[next++]);
+			if (str != NULL)
+				fputs(str, stdout);
+			else
+				printf("<string at 0x%llx>",
+				       (unsigned long long)args[next - 1]);
+			fmt++;
+			break;
+		}
+		default:
+			/* The firmware vprintf() exits here as well */
+			return;
+		}
+	}
+}
+
+/*
+ * Try to decode a record at 'p'. Returns the number of bytes consumed, or
+ * zero when the bytes do not form a valid record and must pass through.
+ */
+static size_t decode_record(const uint8_t *p, size_t avail)
+{
+	uint64_t args[TF_LOG_BIN_MAX_ARGS];
+	uint64_t fmt_addr;
+	const char *fmt;
+	unsigned int nargs, i;
+
+	if (avail < 11 || p[0] != TF_LOG_BIN_SYNC0 || p[1] != TF_LOG_BIN_SYNC1)
+		return 0;
+
+	fmt_addr = get_le(p + 2, 8);
+	nargs = p[10];
+
+	if (nargs > TF_LOG_BIN_MAX_ARGS || avail < 11 + (size_t)nargs * 8)
+		return 0;
+
+	for (i = 0; i < nargs; i++)
+		args[i] = get_le(p + 11 + i * 8, 8);
+
+	if (fmt_addr == 0) {
+		if (nargs != 1)
+			return 0;
+		printf("binlog: %llu message(s) dropped on ring overflow\n",
+		       (unsigned long long)args[0]);
+		return 11 + 8;
+	}
+
+	fmt = resolve_str(fmt_addr);
+	if (fmt == NULL)
+		return 0;
+
+	render(fmt, args, nargs);
+	return 11 + (size_t)nargs * 8;
+}
+
+int main(int argc, char *argv[])
+{
+	uint8_t *capture;
+	size_t size, pos = 0;
+
+	if (argc != 3) {
+		fprintf(stderr, "Usage: %s <console capture file> <firmware elf>\n",
+			argv[0]);
+		return 1;
+	}
+
+	capture = read_file(argv[1], &size);
+	load_elf(argv[2]);
+
+	while (pos < size) {
+		size_t used = decode_record(capture + pos, size - pos);
+
+		if (used == 0) {
+			putchar(capture[pos]);
+			pos++;
+		} else {
+			pos += used;
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,616 @@
+/*
+ * Copyright (c) 2026, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Reproducible boot timing rig.
+ *
+ * Drives a board through N cold-boot, reset or soft-reboot cycles over a
+ * serial console, using externally supplied shell commands for power and
+ * reset control (relay boxes, PDUs, ST-Link reset scripts...), and turns
+ * the boot timeline published by the firmware into regression-ready
+ * per-stage statistics (min/median/p95/max).
+ *
+ * Two time sources are combined:
+ *
+ *  - host-side wall time from trigger to the first console byte and to a
+ *    configurable boot-complete marker (e.g. the login prompt);
+ *
+ *  - the firmware boot timeline (STM32MP_BOOT_TIMELINE=1), whose CNTPCT
+ *    checkpoints BL2 and sp_min capture and serve over the PMF "get
+ *    timestamp" SMC. The harness retrieves them by sending a command on
+ *    the booted target's console (--timeline-cmd) whose output carries
+ *    the token "BTL1" followed by the tick values in checkpoint order,
+ *    e.g. a small utility wrapping the PMF SMC, or a hexdump of the
+ *    handover page at STM32MP_BOOT_TL_BASE piped through awk.
+ *
+ * Example:
+ *
+ *   bootbench -p /dev/ttyUSB0 -n 20 --mode cold \
+ *       --power-off-cmd "pdu off 3" --power-on-cmd "pdu on 3" \
+ *       --done "login:" --timeline-cmd "boot_tl" --tick-hz 24000000
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <getopt.h>
+#include <poll.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Checkpoint order, as in stm32mp1_boot_timeline.h */
+#define TL_BL2_ENTRY		0
+#define TL_DDR_READY		1
+#define TL_BL32_LOADED		2
+#define TL_BL33_LOADED		3
+#define TL_BL2_EXIT		4
+#define TL_SP_MIN_ENTRY		5
+#define TL_SP_MIN_READY		6
+#define TL_TOTAL_IDS		7
+
+#define MAX_ITERATIONS		1000
+#define LINE_MAX_LEN		512
+
+enum boot_mode {
+	MODE_COLD,
+	MODE_WARM,
+	MODE_SOFT,
+	MODE_STANDBY,
+};
+
+/* One derived duration per boot, in milliseconds */
+struct stage {
+	const char *name;
+	double samples[MAX_ITERATIONS];
+	int nr_samples;
+};
+
+static struct stage stages[] = {
+	{ .name = "trigger->console" },
+	{ .name = "trigger->done" },
+	{ .name = "bl2: entry->ddr" },
+	{ .name = "bl2: ddr->bl32" },
+	{ .name = "bl2: bl32->bl33" },
+	{ .name = "bl2: bl33->exit" },
+	{ .name = "sp_min: entry->ready" },
+	{ .name = "fw total (bl2+sp_min)" },
+};
+
+#define NR_STAGES		(sizeof(stages) / sizeof(stages[0]))
+#define STAGE_CONSOLE		0
+#define STAGE_DONE		1
+#define STAGE_FW_FIRST		2
+
+static int serial_fd = -1;
+static const char *opt_port;
+static int opt_baud = 115200;
+static int opt_iterations = 10;
+static int opt_timeout = 120;
+static enum boot_mode opt_mode = MODE_WARM;
+static const char *opt_power_on_cmd;
+static const char *opt_power_off_cmd;
+static const char *opt_reset_cmd;
+static const char *opt_soft_cmd = "reboot\n";
+static const char *opt_suspend_cmd = "echo mem > /sys/power/state\n";
+static const char *opt_wake_cmd;
+static const char *opt_done_marker = "login:";
+static const char *opt_timeline_cmd;
+static double opt_tick_hz = 24000000.0;
+static int opt_verbose;
+
+static double now_ms(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1e6;
+}
+
+static speed_t baud_to_speed(int baud)
+{
+	switch (baud) {
+	case 9600:    return B9600;
+	case 19200:   return B19200;
+	case 38400:   return B38400;
+	case 57600:   return B57600;
+	case 115200:  return B115200;
+	case 230400:  return B230400;
+	case 460800:  return B460800;
+	case 921600:  return B921600;
+#ifdef B3000000
+	case 3000000: return B3000000;
+#endif
+	default:
+		fprintf(stderr, "Unsupported baud rate %d\n", baud);
+		exit(1);
+	}
+}
+
+static int serial_open(void)
+{
+	struct termios tio;
+
+	serial_fd = open(opt_port, O_RDWR | O_NOCTTY | O_NONBLOCK);
+	if (serial_fd < 0) {
+		fprintf(stderr, "Cannot open %s: %s\n", opt_port,
+			strerror(errno));
+		return -1;
+	}
+
+	if (tcgetattr(serial_fd, &tio) != 0) {
+		fprintf(stderr, "tcgetattr: %s\n", strerror(errno));
+		return -1;
+	}
+
+	cfmakeraw(&tio);
+	tio.c_cflag |= CLOCAL | CREAD;
+	tio.c_cc[VMIN] = 0;
+	tio.c_cc[VTIME] = 0;
+	cfsetispeed(&tio, baud_to_speed(opt_baud));
+	cfsetospeed(&tio, baud_to_speed(opt_baud));
+
+	if (tcsetattr(serial_fd, TCSANOW, &tio) != 0) {
+		fprintf(stderr, "tcsetattr: %s\n", strerror(errno));
+		return -1;
+	}
+
+	return 0;
+}
+
+static void serial_flush(void)
+{
+	tcflush(serial_fd, TCIOFLUSH);
+}
+
+static int serial_write_str(const char *s)
+{
+	size_t len = strlen(s);
+
+	while (len > 0) {
+		ssize_t ret = write(serial_fd, s, len);
+
+		if (ret < 0) {
+			if (errno == EAGAIN || errno == EINTR)
+				continue;
+			return -1;
+		}
+		s += ret;
+		len -= (size_t)ret;
+	}
+
+	return 0;
+}
+
+/*
+ * Read one console line, waiting at most until 'deadline_ms'. Returns the
+ * line length, 0 on an empty line, -1 on timeout/error. '*stamp_ms' is
+ * set to the arrival time of the line's first byte.
+ */
+static int serial_read_line(char *buf, size_t size, double deadline_ms,
+			    double *stamp_ms)
+{
+	size_t pos = 0;
+	int stamped = 0;
+
+	for (;;) {
+		struct pollfd pfd = { .fd = serial_fd, .events = POLLIN };
+		double remaining = deadline_ms - now_ms();
+		unsigned char c;
+		ssize_t ret;
+
+		if (remaining <= 0.0)
+			return -1;
+
+		ret = poll(&pfd, 1, (int)remaining + 1);
+		if (ret <= 0)
+			return -1;
+
+		ret = read(serial_fd, &c, 1);
+		if (ret < 0) {
+			if (errno == EAGAIN || errno == EINTR)
+				continue;
+			return -1;
+		}
+		if (ret == 0)
+			continue;
+
+		if (!stamped) {
+			if (stamp_ms != NULL)
+				*stamp_ms = now_ms();
+			stamped = 1;
+		}
+
+		if (c == '\n')
+			break;
+		if (c == '\r')
+			continue;
+		if (pos < size - 1)
+			buf[pos++] = (char)c;
+	}
+
+	buf[pos] = '\0';
+	return (int)pos;
+}
+
+static int run_cmd(const char *cmd)
+{
+	int ret;
+
+	if (opt_verbose)
+		fprintf(stderr, "+ %s\n", cmd);
+
+	ret = system(cmd);
+	if (ret != 0) {
+		fprintf(stderr, "Command failed (%d): %s\n", ret, cmd);
+		return -1;
+	}
+
+	return 0;
+}
+
+/*
+ * Kick one boot cycle and set '*t_trigger' to the moment the action that
+ * actually starts the boot was issued (after any preparatory steps, such
+ * as powering off or entering STANDBY).
+ */
+static int trigger_boot(double *t_trigger)
+{
+	switch (opt_mode) {
+	case MODE_COLD:
+		if (run_cmd(opt_power_off_cmd) != 0)
+			return -1;
+		/* Let the supplies discharge */
+		usleep(500 * 1000);
+		serial_flush();
+		*t_trigger = now_ms();
+		return run_cmd(opt_power_on_cmd);
+	case MODE_WARM:
+		serial_flush();
+		*t_trigger = now_ms();
+		return run_cmd(opt_reset_cmd);
+	case MODE_SOFT:
+		serial_flush();
+		*t_trigger = now_ms();
+		return serial_write_str(opt_soft_cmd);
+	case MODE_STANDBY:
+		/*
+		 * Enter STANDBY from the running OS, give it time to reach
+		 * the low-power state, then wake it. Only the wake half is
+		 * timed.
+		 */
+		if (serial_write_str(opt_suspend_cmd) != 0)
+			return -1;
+		sleep(3);
+		serial_flush();
+		*t_trigger = now_ms();
+		return run_cmd(opt_wake_cmd);
+	default:
+		return -1;
+	}
+}
+
+static void stage_add(int idx, double value_ms)
+{
+	struct stage *s = &stages[idx];
+
+	if (s->nr_samples < MAX_ITERATIONS)
+		s->samples[s->nr_samples++] = value_ms;
+}
+
+/*
+ * Parse a console line for the "BTL1" token followed by the timeline tick
+ * values, decimal or 0x-prefixed. Returns 0 when all of them were found.
+ */
+static int parse_timeline_line(const char *line, uint64_t *ticks)
+{
+	const char *p = strstr(line, "BTL1");
+	int i;
+
+	if (p == NULL)
+		return -1;
+	p += strlen("BTL1");
+
+	for (i = 0; i < TL_TOTAL_IDS; i++) {
+		char *end;
+
+		ticks[i] = strtoull(p, &end, 0);
+		if (end == p)
+			return -1;
+		p = end;
+	}
+
+	return 0;
+}
+
+static double ticks_to_ms(uint64_t from, uint64_t to)
+{
+	if (to < from)
+		return 0.0;
+	return (double)(to - from) * 1000.0 / opt_tick_hz;
+}
+
+static int fetch_timeline(double deadline_ms)
+{
+	uint64_t ticks[TL_TOTAL_IDS];
+	char line[LINE_MAX_LEN];
+
+	/* Wake the console first: autologin shells eat the first newline */
+	serial_write_str("\n");
+	usleep(100 * 1000);
+	serial_write_str(opt_timeline_cmd);
+	serial_write_str("\n");
+
+	while (serial_read_line(line, sizeof(line), deadline_ms, NULL) >= 0) {
+		if (parse_timeline_line(line, ticks) != 0)
+			continue;
+
+		stage_add(STAGE_FW_FIRST + 0,
+			  ticks_to_ms(ticks[TL_BL2_ENTRY],
+				      ticks[TL_DDR_READY]));
+		stage_add(STAGE_FW_FIRST + 1,
+			  ticks_to_ms(ticks[TL_DDR_READY],
+				      ticks[TL_BL32_LOADED]));
+		stage_add(STAGE_FW_FIRST + 2,
+			  ticks_to_ms(ticks[TL_BL32_LOADED],
+				      ticks[TL_BL33_LOADED]));
+		stage_add(STAGE_FW_FIRST + 3,
+			  ticks_to_ms(ticks[TL_BL33_LOADED],
+				      ticks[TL_BL2_EXIT]));
+		stage_add(STAGE_FW_FIRST + 4,
+			  ticks_to_ms(ticks[TL_SP_MIN_ENTRY],
+				      ticks[TL_SP_MIN_READY]));
+		stage_add(STAGE_FW_FIRST + 5,
+			  ticks_to_ms(ticks[TL_BL2_ENTRY],
+				      ticks[TL_SP_MIN_READY]));
+		return 0;
+	}
+
+	fprintf(stderr, "No timeline record received\n");
+	return -1;
+}
+
+static int run_iteration(int n)
+{
+	char line[LINE_MAX_LEN];
+	double t_trigger, t_console = 0.0, t_done = 0.0;
+	double deadline;
+	int got_console = 0;
+
+	if (trigger_boot(&t_trigger) != 0)
+		return -1;
+
+	deadline = now_ms() + (double)opt_timeout * 1000.0;
+
+	for (;;) {
+		double stamp;
+		int len = serial_read_line(line, sizeof(line), deadline,
+					   &stamp);
+
+		if (len < 0) {
+			fprintf(stderr,
+				"Iteration %d: timed out waiting for \"%s\"\n",
+				n, opt_done_marker);
+			return -1;
+		}
+
+		if (!got_console && len > 0) {
+			t_console = stamp;
+			got_console = 1;
+		}
+
+		if (opt_verbose && len > 0)
+			fprintf(stderr, "  | %s\n", line);
+
+		if (strstr(line, opt_done_marker) != NULL) {
+			t_done = stamp;
+			break;
+		}
+	}
+
+	stage_add(STAGE_CONSOLE, t_console - t_trigger);
+	stage_add(STAGE_DONE, t_done - t_trigger);
+
+	if (opt_timeline_cmd != NULL)
+		return fetch_timeline(deadline);
+
+	return 0;
+}
+
+static int cmp_double(const void *a, const void *b)
+{
+	double da = *(const double *)a, db = *(const double *)b;
+
+	return (da > db) - (da < db);
+}
+
+static double percentile(const double *sorted, int n, double p)
+{
+	int idx = (int)((p / 100.0) * (double)(n - 1) + 0.5);
+
+	return sorted[idx];
+}
+
+static void report(void)
+{
+	unsigned int i;
+
+	printf("\n%-22s %6s %9s %9s %9s %9s\n",
+	       "stage", "n", "min", "median", "p95", "max");
+
+	for (i = 0; i < NR_STAGES; i++) {
+		struct stage *s = &stages[i];
+
+		if (s->nr_samples == 0)
+			continue;
+
+		qsort(s->samples, (size_t)s->nr_samples, sizeof(double),
+		      cmp_double);
+
+		printf("%-22s %6d %8.1fms %8.1fms %8.1fms %8.1fms\n",
+		       s->name, s->nr_samples,
+		       s->samples[0],
+		       percentile(s->samples, s->nr_samples, 50.0),
+		       percentile(s->samples, s->nr_samples, 95.0),
+		       s->samples[s->nr_samples - 1]);
+	}
+}
+
+static void usage(const char *prog)
+{
+	printf("Usage: %s -p <port> [options]\n", prog);
+	printf("\n");
+	printf("  -p, --port <dev>        serial console device\n");
+	printf("  -b, --baud <rate>       baud rate (default 115200)\n");
+	printf("  -n, --iterations <n>    boot cycles to run (default 10)\n");
+	printf("  -t, --timeout <sec>     per-boot timeout (default 120)\n");
+	printf("  -m, --mode <mode>       cold | warm | soft | standby\n");
+	printf("                          (default warm)\n");
+	printf("      --power-on-cmd <c>  shell command powering the board on\n");
+	printf("      --power-off-cmd <c> shell command powering the board off\n");
+	printf("      --reset-cmd <c>     shell command pulsing the reset line\n");
+	printf("      --soft-cmd <s>      console string triggering a soft\n");
+	printf("                          reboot (default \"reboot\\n\")\n");
+	printf("      --suspend-cmd <s>   console string entering STANDBY\n");
+	printf("                          (default \"echo mem > /sys/power/state\\n\")\n");
+	printf("      --wake-cmd <c>      shell command waking the board\n");
+	printf("      --done <marker>     boot-complete console marker\n");
+	printf("                          (default \"login:\")\n");
+	printf("      --timeline-cmd <c>  console command whose output carries\n");
+	printf("                          \"BTL1\" plus the %d timeline ticks\n",
+	       TL_TOTAL_IDS);
+	printf("      --tick-hz <hz>      timeline counter rate (default 24M)\n");
+	printf("  -v, --verbose           echo console traffic and commands\n");
+	exit(1);
+}
+
+static const struct option long_opts[] = {
+	{ "port",		required_argument,	NULL, 'p' },
+	{ "baud",		required_argument,	NULL, 'b' },
+	{ "iterations",		required_argument,	NULL, 'n' },
+	{ "timeout",		required_argument,	NULL, 't' },
+	{ "mode",		required_argument,	NULL, 'm' },
+	{ "power-on-cmd",	required_argument,	NULL, 1 },
+	{ "power-off-cmd",	required_argument,	NULL, 2 },
+	{ "reset-cmd",		required_argument,	NULL, 3 },
+	{ "soft-cmd",		required_argument,	NULL, 4 },
+	{ "done",		required_argument,	NULL, 5 },
+	{ "timeline-cmd",	required_argument,	NULL, 6 },
+	{ "tick-hz",		required_argument,	NULL, 7 },
+	{ "suspend-cmd",	required_argument,	NULL, 8 },
+	{ "wake-cmd",		required_argument,	NULL, 9 },
+	{ "verbose",		no_argument,		NULL, 'v' },
+	{ NULL, 0, NULL, 0 }
+};
+
+int main(int argc, char **argv)
+{
+	int failures = 0;
+	int opt, i;
+
+	while ((opt = getopt_long(argc, argv, "p:b:n:t:m:v", long_opts,
+				  NULL)) != -1) {
+		switch (opt) {
+		case 'p':
+			opt_port = optarg;
+			break;
+		case 'b':
+			opt_baud = atoi(optarg);
+			break;
+		case 'n':
+			opt_iterations = atoi(optarg);
+			break;
+		case 't':
+			opt_timeout = atoi(optarg);
+			break;
+		case 'm':
+			if (strcmp(optarg, "cold") == 0)
+				opt_mode = MODE_COLD;
+			else if (strcmp(optarg, "warm") == 0)
+				opt_mode = MODE_WARM;
+			else if (strcmp(optarg, "soft") == 0)
+				opt_mode = MODE_SOFT;
+			else if (strcmp(optarg, "standby") == 0)
+				opt_mode = MODE_STANDBY;
+			else
+				usage(argv[0]);
+			break;
+		case 1:
+			opt_power_on_cmd = optarg;
+			break;
+		case 2:
+			opt_power_off_cmd = optarg;
+			break;
+		case 3:
+			opt_reset_cmd = optarg;
+			break;
+		case 4:
+			opt_soft_cmd = optarg;
+			break;
+		case 5:
+			opt_done_marker = optarg;
+			break;
+		case 6:
+			opt_timeline_cmd = optarg;
+			break;
+		case 7:
+			opt_tick_hz = atof(optarg);
+			break;
+		case 8:
+			opt_suspend_cmd = optarg;
+			break;
+		case 9:
+			opt_wake_cmd = optarg;
+			break;
+		case 'v':
+			opt_verbose = 1;
+			break;
+		default:
+			usage(argv[0]);
+		}
+	}
+
+	if (opt_port == NULL ||
+	    opt_iterations < 1 || opt_iterations > MAX_ITERATIONS)
+		usage(argv[0]);
+
+	if (opt_mode == MODE_COLD &&
+	    (opt_power_on_cmd == NULL || opt_power_off_cmd == NULL)) {
+		fprintf(stderr,
+			"cold mode needs --power-on-cmd and --power-off-cmd\n");
+		return 1;
+	}
+	if (opt_mode == MODE_WARM && opt_reset_cmd == NULL) {
+		fprintf(stderr, "warm mode needs --reset-cmd\n");
+		return 1;
+	}
+	if (opt_mode == MODE_STANDBY && opt_wake_cmd == NULL) {
+		fprintf(stderr, "standby mode needs --wake-cmd\n");
+		return 1;
+	}
+
+	if (serial_open() != 0)
+		return 1;
+
+	for (i = 1; i <= opt_iterations; i++) {
+		printf("Iteration %d/%d...\n", i, opt_iterations);
+		if (run_iteration(i) != 0)
+			failures++;
+	}
+
+	report();
+
+	if (failures != 0) {
+		fprintf(stderr, "\n%d of %d iterations failed\n",
+			failures, opt_iterations);
+		return 1;
+	}
+
+	return 0;
+}
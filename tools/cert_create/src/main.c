@@ -7,10 +7,12 @@
 #include <assert.h>
 #include <ctype.h>
 #include <getopt.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
+#include <unistd.h>
 
 #include <openssl/conf.h>
 #include <openssl/engine.h>
@@ -67,6 +69,8 @@
 #define NUM_ELEM(x)			((sizeof(x)) / (sizeof(x[0])))
 #define HELP_OPT_MAX_LEN		128
 
+#define MAX_BATCH_LINE_LEN		4096
+
 /* Global options */
 static int key_alg;
 static int hash_alg;
@@ -75,6 +79,10 @@ static int new_keys;
 static int save_keys;
 static int print_cert;
 
+/* Image hash algorithm selected for the current run */
+static const EVP_MD *md_info;
+static unsigned int md_len;
+
 /* Info messages created in the Makefile */
 extern const char build_msg[];
 extern const char platform_msg[];
@@ -90,6 +98,141 @@ static char *strdup(const char *str)
 	return dup;
 }
 
+/*
+ * Run fn(0..count - 1, arg) across the host cores. Work items must be
+ * independent; the order they run in is unspecified.
+ */
+typedef void (*work_fn_t)(size_t index, void *arg);
+
+struct work_pool {
+	work_fn_t fn;
+	void *arg;
+	size_t count;
+	size_t next;
+	pthread_mutex_t lock;
+};
+
+static void *work_pool_thread(void *pool_arg)
+{
+	struct work_pool *pool = pool_arg;
+
+	while (1) {
+		size_t index;
+
+		pthread_mutex_lock(&pool->lock);
+		index = pool->next++;
+		pthread_mutex_unlock(&pool->lock);
+
+		if (index >= pool->count) {
+			return NULL;
+		}
+		pool->fn(index, pool->arg);
+	}
+}
+
+static void run_parallel(work_fn_t fn, void *arg, size_t count)
+{
+	struct work_pool pool;
+	pthread_t *threads;
+	long nr_threads;
+	long i;
+
+	nr_threads = sysconf(_SC_NPROCESSORS_ONLN);
+	if (nr_threads < 1) {
+		nr_threads = 1;
+	}
+	if ((size_t)nr_threads > count) {
+		nr_threads = count;
+	}
+
+	if (nr_threads == 1) {
+		size_t index;
+
+		for (index = 0; index < count; index++) {
+			fn(index, arg);
+		}
+		return;
+	}
+
+	pool.fn = fn;
+	pool.arg = arg;
+	pool.count = count;
+	pool.next = 0;
+	pthread_mutex_init(&pool.lock, NULL);
+
+	threads = malloc(nr_threads * sizeof(*threads));
+	if (threads == NULL) {
+		ERROR("Cannot allocate worker threads\n");
+		exit(1);
+	}
+	for (i = 0; i < nr_threads; i++) {
+		if (pthread_create(&threads[i], NULL, work_pool_thread,
+				   &pool) != 0) {
+			ERROR("Cannot create worker thread\n");
+			exit(1);
+		}
+	}
+	for (i = 0; i < nr_threads; i++) {
+		pthread_join(threads[i], NULL);
+	}
+	free(threads);
+	pthread_mutex_destroy(&pool.lock);
+}
+
+/*
+ * Cache of private keys loaded (or created) so far, indexed by filename.
+ * In batch mode the board variants usually share most of their keys, so
+ * each PEM file is only parsed once per process.
+ */
+struct key_cache_entry {
+	char *fn;
+	EVP_PKEY *key;
+	struct key_cache_entry *next;
+};
+
+static struct key_cache_entry *key_cache_head;
+
+static EVP_PKEY *key_cache_get(const char *fn)
+{
+	struct key_cache_entry *entry;
+
+	for (entry = key_cache_head; entry != NULL; entry = entry->next) {
+		if (strcmp(entry->fn, fn) == 0) {
+			return entry->key;
+		}
+	}
+
+	return NULL;
+}
+
+static void key_cache_put(const char *fn, EVP_PKEY *key)
+{
+	struct key_cache_entry *entry;
+
+	entry = malloc(sizeof(*entry));
+	if (entry == NULL) {
+		ERROR("Cannot allocate key cache entry\n");
+		exit(1);
+	}
+	entry->fn = strdup(fn);
+	entry->key = key;
+	entry->next = key_cache_head;
+	key_cache_head = entry;
+}
+
+static int key_cache_owns(const EVP_PKEY *key)
+{
+	struct key_cache_entry *entry;
+
+	for (entry = key_cache_head; entry != NULL; entry = entry->next) {
+		if (entry->key == key) {
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
 static const char *key_algs_str[] = {
 	[KEY_ALG_RSA] = "rsa",
 #ifndef OPENSSL_NO_EC
@@ -297,55 +440,188 @@ static const cmd_opt_t common_cmd_opt[] = {
 	{
 		{ "print-cert", no_argument, NULL, 'p' },
 		"Print the certificates in the standard output"
+	},
+	{
+		{ "batch", required_argument, NULL, 'B' },
+		"Process one set of certificates per line of the given file in a single invocation, reusing loaded keys"
 	}
 };
 
-int main(int argc, char *argv[])
+/*
+ * Create one certificate: build its extension stack, hash the associated
+ * images and sign it. Runs concurrently for independent certificates, so
+ * it must only write to its own certificate slot.
+ */
+static void create_cert_work(size_t index, void *arg)
 {
+	const unsigned int *cert_list = arg;
+	cert_t *cert = &certs[cert_list[index]];
 	STACK_OF(X509_EXTENSION) * sk;
 	X509_EXTENSION *cert_ext = NULL;
+	ext_t *ext;
+	unsigned char md[SHA512_DIGEST_LENGTH];
+	int j, ext_nid, nvctr;
+
+	/* Create a new stack of extensions. This stack will be used
+	 * to create the certificate */
+	CHECK_NULL(sk, sk_X509_EXTENSION_new_null());
+
+	for (j = 0 ; j < cert->num_ext ; j++) {
+
+		ext = &extensions[cert->ext[j]];
+
+		/* Get OpenSSL internal ID for this extension */
+		CHECK_OID(ext_nid, ext->oid);
+
+		/*
+		 * Three types of extensions are currently supported:
+		 *     - EXT_TYPE_NVCOUNTER
+		 *     - EXT_TYPE_HASH
+		 *     - EXT_TYPE_PKEY
+		 */
+		switch (ext->type) {
+		case EXT_TYPE_NVCOUNTER:
+			if (ext->arg) {
+				nvctr = atoi(ext->arg);
+				CHECK_NULL(cert_ext, ext_new_nvcounter(ext_nid,
+					EXT_CRIT, nvctr));
+			}
+			break;
+		case EXT_TYPE_HASH:
+			if (ext->arg == NULL) {
+				if (ext->optional) {
+					/* Include a hash filled with zeros */
+					memset(md, 0x0, SHA512_DIGEST_LENGTH);
+				} else {
+					/* Do not include this hash in the certificate */
+					break;
+				}
+			} else {
+				/* Calculate the hash of the file */
+				if (!sha_file(hash_alg, ext->arg, md)) {
+					ERROR("Cannot calculate hash of %s\n",
+						ext->arg);
+					exit(1);
+				}
+			}
+			CHECK_NULL(cert_ext, ext_new_hash(ext_nid,
+					EXT_CRIT, md_info, md,
+					md_len));
+			break;
+		case EXT_TYPE_PKEY:
+			CHECK_NULL(cert_ext, ext_new_key(ext_nid,
+				EXT_CRIT, keys[ext->attr.key].key));
+			break;
+		default:
+			ERROR("Unknown extension type '%d' in %s\n",
+					ext->type, cert->cn);
+			exit(1);
+		}
+
+		/* Push the extension into the stack */
+		sk_X509_EXTENSION_push(sk, cert_ext);
+	}
+
+	/* Create certificate. Signed with corresponding key */
+	if (cert->fn && !cert_new(hash_alg, cert, VAL_DAYS, 0, sk)) {
+		ERROR("Cannot create %s\n", cert->cn);
+		exit(1);
+	}
+
+	sk_X509_EXTENSION_free(sk);
+}
+
+/*
+ * Create all requested certificates across the host cores. Certificates
+ * are scheduled in waves so that a certificate signed by an issuer
+ * certificate created earlier in the array still sees it, matching the
+ * sequential creation order. TBBR certificates are all self-signed, so
+ * they form a single wave.
+ */
+static void create_certs(void)
+{
+	unsigned int *cert_list;
+	bool *done;
+	unsigned int i, issuer, nr_done = 0, nr_batch;
+
+	cert_list = malloc(num_certs * sizeof(*cert_list));
+	done = calloc(num_certs, sizeof(*done));
+	if ((cert_list == NULL) || (done == NULL)) {
+		ERROR("Cannot allocate certificate work list\n");
+		exit(1);
+	}
+
+	while (nr_done < num_certs) {
+		nr_batch = 0;
+		for (i = 0; i < num_certs; i++) {
+			if (done[i]) {
+				continue;
+			}
+			issuer = certs[i].issuer;
+			/*
+			 * Wait for an issuer earlier in the array that is
+			 * requested but not created yet. Later issuers are
+			 * still NULL in sequential order, which makes the
+			 * certificate self-signed.
+			 */
+			if ((issuer != i) && (issuer < i) &&
+			    (certs[issuer].fn != NULL) && !done[issuer]) {
+				continue;
+			}
+			cert_list[nr_batch++] = i;
+		}
+
+		assert(nr_batch != 0);
+
+		run_parallel(create_cert_work, cert_list, nr_batch);
+
+		for (i = 0; i < nr_batch; i++) {
+			done[cert_list[i]] = true;
+		}
+		nr_done += nr_batch;
+	}
+
+	free(cert_list);
+	free(done);
+}
+
+static int run_once(int argc, char *argv[])
+{
 	ext_t *ext;
 	key_t *key;
 	cert_t *cert;
 	FILE *file;
-	int i, j, ext_nid, nvctr;
+	int i;
 	int c, opt_idx = 0;
 	const struct option *cmd_opt;
 	const char *cur_opt;
 	unsigned int err_code;
-	unsigned char md[SHA512_DIGEST_LENGTH];
-	unsigned int  md_len;
-	const EVP_MD *md_info;
-
-	NOTICE("CoT Generation Tool: %s\n", build_msg);
-	NOTICE("Target platform: %s\n", platform_msg);
 
-	/* Set default options */
+	/* Reset the per-run state, needed when processing a batch */
+	optind = 0;
 	key_alg = KEY_ALG_RSA;
 	hash_alg = HASH_ALG_SHA256;
 	key_size = -1;
-
-	/* Add common command line options */
-	for (i = 0; i < NUM_ELEM(common_cmd_opt); i++) {
-		cmd_opt_add(&common_cmd_opt[i]);
-	}
-
-	/* Initialize the certificates */
-	if (cert_init() != 0) {
-		ERROR("Cannot initialize certificates\n");
-		exit(1);
+	new_keys = 0;
+	save_keys = 0;
+	print_cert = 0;
+	for (i = 0; i < num_certs; i++) {
+		free((char *)certs[i].fn);
+		certs[i].fn = NULL;
+		X509_free(certs[i].x);
+		certs[i].x = NULL;
 	}
-
-	/* Initialize the keys */
-	if (key_init() != 0) {
-		ERROR("Cannot initialize keys\n");
-		exit(1);
+	for (i = 0; i < num_extensions; i++) {
+		free((char *)extensions[i].arg);
+		extensions[i].arg = NULL;
 	}
-
-	/* Initialize the new types and register OIDs for the extensions */
-	if (ext_init() != 0) {
-		ERROR("Cannot initialize TBB extensions\n");
-		exit(1);
+	for (i = 0; i < num_keys; i++) {
+		free(keys[i].fn);
+		keys[i].fn = NULL;
+		if ((keys[i].key != NULL) && !key_cache_owns(keys[i].key)) {
+			EVP_PKEY_free(keys[i].key);
+		}
+		keys[i].key = NULL;
 	}
 
 	/* Get the command line options populated during the initialization */
@@ -394,6 +670,9 @@ int main(int argc, char *argv[])
 				exit(1);
 			}
 			break;
+		case 'B':
+			ERROR("--batch cannot be used inside a batch file\n");
+			exit(1);
 		case CMD_OPT_EXT:
 			cur_opt = cmd_opt_get_name(opt_idx);
 			ext = ext_get_by_opt(cur_opt);
@@ -439,6 +718,14 @@ int main(int argc, char *argv[])
 
 	/* Load private keys from files (or generate new ones) */
 	for (i = 0 ; i < num_keys ; i++) {
+		/* Reuse a key already loaded for a previous batch entry */
+		if (keys[i].fn != NULL) {
+			keys[i].key = key_cache_get(keys[i].fn);
+			if (keys[i].key != NULL) {
+				continue;
+			}
+		}
+
 		if (!key_new(&keys[i])) {
 			ERROR("Failed to allocate key container\n");
 			exit(1);
@@ -447,6 +734,7 @@ int main(int argc, char *argv[])
 		/* First try to load the key from disk */
 		if (key_load(&keys[i], &err_code)) {
 			/* Key loaded successfully */
+			key_cache_put(keys[i].fn, keys[i].key);
 			continue;
 		}
 
@@ -475,82 +763,14 @@ int main(int argc, char *argv[])
 			}
 			exit(1);
 		}
-	}
-
-	/* Create the certificates */
-	for (i = 0 ; i < num_certs ; i++) {
-
-		cert = &certs[i];
-
-		/* Create a new stack of extensions. This stack will be used
-		 * to create the certificate */
-		CHECK_NULL(sk, sk_X509_EXTENSION_new_null());
-
-		for (j = 0 ; j < cert->num_ext ; j++) {
-
-			ext = &extensions[cert->ext[j]];
-
-			/* Get OpenSSL internal ID for this extension */
-			CHECK_OID(ext_nid, ext->oid);
-
-			/*
-			 * Three types of extensions are currently supported:
-			 *     - EXT_TYPE_NVCOUNTER
-			 *     - EXT_TYPE_HASH
-			 *     - EXT_TYPE_PKEY
-			 */
-			switch (ext->type) {
-			case EXT_TYPE_NVCOUNTER:
-				if (ext->arg) {
-					nvctr = atoi(ext->arg);
-					CHECK_NULL(cert_ext, ext_new_nvcounter(ext_nid,
-						EXT_CRIT, nvctr));
-				}
-				break;
-			case EXT_TYPE_HASH:
-				if (ext->arg == NULL) {
-					if (ext->optional) {
-						/* Include a hash filled with zeros */
-						memset(md, 0x0, SHA512_DIGEST_LENGTH);
-					} else {
-						/* Do not include this hash in the certificate */
-						break;
-					}
-				} else {
-					/* Calculate the hash of the file */
-					if (!sha_file(hash_alg, ext->arg, md)) {
-						ERROR("Cannot calculate hash of %s\n",
-							ext->arg);
-						exit(1);
-					}
-				}
-				CHECK_NULL(cert_ext, ext_new_hash(ext_nid,
-						EXT_CRIT, md_info, md,
-						md_len));
-				break;
-			case EXT_TYPE_PKEY:
-				CHECK_NULL(cert_ext, ext_new_key(ext_nid,
-					EXT_CRIT, keys[ext->attr.key].key));
-				break;
-			default:
-				ERROR("Unknown extension type '%d' in %s\n",
-						ext->type, cert->cn);
-				exit(1);
-			}
-
-			/* Push the extension into the stack */
-			sk_X509_EXTENSION_push(sk, cert_ext);
-		}
 
-		/* Create certificate. Signed with corresponding key */
-		if (cert->fn && !cert_new(hash_alg, cert, VAL_DAYS, 0, sk)) {
-			ERROR("Cannot create %s\n", cert->cn);
-			exit(1);
+		if (keys[i].fn != NULL) {
+			key_cache_put(keys[i].fn, keys[i].key);
 		}
-
-		sk_X509_EXTENSION_free(sk);
 	}
 
+	/* Create the certificates */
+	create_certs();
 
 	/* Print the certificates */
 	if (print_cert) {
@@ -585,10 +805,126 @@ int main(int argc, char *argv[])
 		}
 	}
 
+	return 0;
+}
+
+/*
+ * Process a batch file: each non-empty line that does not start with '#'
+ * holds the command line options for one set of certificates. Keys loaded
+ * or created for one line are reused by the following ones.
+ */
+static int run_batch(const char *argv0, const char *batch_fn)
+{
+	char line[MAX_BATCH_LINE_LEN];
+	char **batch_argv;
+	int batch_argc, lineno = 0;
+	size_t max_args;
+	char *p;
+	FILE *fp;
+
+	fp = fopen(batch_fn, "r");
+	if (fp == NULL) {
+		ERROR("Cannot open batch file %s\n", batch_fn);
+		exit(1);
+	}
+
+	/* Worst case: one argument every two characters, plus argv[0] */
+	max_args = (MAX_BATCH_LINE_LEN / 2) + 2;
+	batch_argv = malloc(max_args * sizeof(*batch_argv));
+	if (batch_argv == NULL) {
+		ERROR("Cannot allocate batch argument list\n");
+		exit(1);
+	}
+
+	while (fgets(line, sizeof(line), fp) != NULL) {
+		lineno++;
+
+		if ((strlen(line) == (sizeof(line) - 1)) &&
+		    (line[sizeof(line) - 2] != '\n')) {
+			ERROR("Batch line %d is too long\n", lineno);
+			exit(1);
+		}
+
+		batch_argc = 1;
+		batch_argv[0] = (char *)argv0;
+		for (p = strtok(line, " \t\r\n"); p != NULL;
+		     p = strtok(NULL, " \t\r\n")) {
+			batch_argv[batch_argc++] = p;
+		}
+
+		/* Skip empty lines and comments */
+		if ((batch_argc == 1) || (batch_argv[1][0] == '#')) {
+			continue;
+		}
+
+		NOTICE("Processing batch line %d\n", lineno);
+		run_once(batch_argc, batch_argv);
+	}
+
+	free(batch_argv);
+	fclose(fp);
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+	const char *batch_fn = NULL;
+	int i, ret;
+
+	NOTICE("CoT Generation Tool: %s\n", build_msg);
+	NOTICE("Target platform: %s\n", platform_msg);
+
+	/* Add common command line options */
+	for (i = 0; i < NUM_ELEM(common_cmd_opt); i++) {
+		cmd_opt_add(&common_cmd_opt[i]);
+	}
+
+	/* Initialize the certificates */
+	if (cert_init() != 0) {
+		ERROR("Cannot initialize certificates\n");
+		exit(1);
+	}
+
+	/* Initialize the keys */
+	if (key_init() != 0) {
+		ERROR("Cannot initialize keys\n");
+		exit(1);
+	}
+
+	/* Initialize the new types and register OIDs for the extensions */
+	if (ext_init() != 0) {
+		ERROR("Cannot initialize TBB extensions\n");
+		exit(1);
+	}
+
+	/* Batch mode must be the only option on the command line */
+	for (i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--batch") == 0) {
+			if (i + 1 >= argc) {
+				ERROR("--batch requires a filename\n");
+				exit(1);
+			}
+			batch_fn = argv[i + 1];
+		} else if (strncmp(argv[i], "--batch=",
+				   strlen("--batch=")) == 0) {
+			batch_fn = argv[i] + strlen("--batch=");
+		}
+	}
+
+	if (batch_fn != NULL) {
+		if (argc > 3) {
+			ERROR("--batch cannot be combined with other options\n");
+			exit(1);
+		}
+		ret = run_batch(argv[0], batch_fn);
+	} else {
+		ret = run_once(argc, argv);
+	}
+
 #ifndef OPENSSL_NO_ENGINE
 	ENGINE_cleanup();
 #endif
 	CRYPTO_cleanup_all_ex_data();
 
-	return 0;
+	return ret;
 }
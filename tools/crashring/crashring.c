@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Decoder for the TF-A crash RAM capture region (CRASH_RAM_CAPTURE=1).
+ * Feed it a raw dump of the region, e.g. taken with dd from /dev/mem or
+ * extracted from a saved memory image:
+ *
+ *   crashring <region dump file>
+ *
+ * See include/common/crash_ram.h for the region layout.
+ */
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <common/crash_ram.h>
+
+struct record {
+	uint8_t type;
+	uint8_t flags;
+	uint16_t len;
+	uint32_t seq;
+	const uint8_t *payload;
+};
+
+static uint32_t get_u32(const uint8_t *p)
+{
+	return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+	       ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint64_t get_reg(const uint8_t *p, size_t reg_size)
+{
+	uint64_t val = 0;
+	size_t i;
+
+	for (i = 0; i < reg_size; i++)
+		val |= (uint64_t)p[i] << (8 * i);
+	return val;
+}
+
+static int cmp_record(const void *a, const void *b)
+{
+	const struct record *ra = a, *rb = b;
+
+	return (ra->seq > rb->seq) - (ra->seq < rb->seq);
+}
+
+/*
+ * Collect the records stored in the ring. The stream is contiguous from
+ * offset zero up to the end marker left at the current write offset; the
+ * bytes after the marker belong to records from before the last wrap whose
+ * start may have been overwritten, so resynchronize on the next plausible
+ * record header and keep going.
+ */
+static size_t scan_ring(const uint8_t *ring, size_t ring_size,
+			struct record *recs, size_t max_recs)
+{
+	size_t off = 0, count = 0;
+
+	while ((off + 8) <= ring_size && count < max_recs) {
+		uint8_t type = ring[off];
+		uint16_t len = (uint16_t)(ring[off + 2] |
+					  (ring[off + 3] << 8));
+
+		if (type == CRASH_RAM_REC_END ||
+		    type > CRASH_RAM_REC_REG_DIFF ||
+		    (off + 8 + len) > ring_size) {
+			/* End marker or garbage: resync 4 bytes further */
+			off += 4;
+			continue;
+		}
+
+		recs[count].type = type;
+		recs[count].flags = ring[off + 1];
+		recs[count].len = len;
+		recs[count].seq = get_u32(ring + off + 4);
+		recs[count].payload = ring + off + 8;
+		count++;
+
+		off += 8 + ((len + 3u) & ~3u);
+	}
+
+	return count;
+}
+
+static void print_record(const struct record *rec)
+{
+	size_t reg_size = (rec->flags & CRASH_RAM_REC_FLAG_64BIT) ? 8 : 4;
+	size_t i;
+
+	switch (rec->type) {
+	case CRASH_RAM_REC_TEXT:
+		printf("[%u] %.*s\n", rec->seq, rec->len, rec->payload);
+		break;
+	case CRASH_RAM_REC_BACKTRACE:
+		printf("[%u] backtrace:\n", rec->seq);
+		for (i = 0; (i + reg_size) <= rec->len; i += reg_size)
+			printf("    %zu: 0x%llx\n", i / reg_size,
+			       (unsigned long long)get_reg(rec->payload + i,
+							   reg_size));
+		break;
+	case CRASH_RAM_REC_PANIC:
+		if (rec->len < reg_size)
+			break;
+		printf("[%u] PANIC in %.*s at 0x%llx\n", rec->seq,
+		       (int)(rec->len - reg_size), rec->payload + reg_size,
+		       (unsigned long long)get_reg(rec->payload, reg_size));
+		break;
+	case CRASH_RAM_REC_REG_DIFF:
+		if (rec->len < 12)
+			break;
+		printf("[%u] reg diff: 0x%08x saved 0x%08x resumed 0x%08x\n",
+		       rec->seq, get_u32(rec->payload),
+		       get_u32(rec->payload + 4), get_u32(rec->payload + 8));
+		break;
+	default:
+		break;
+	}
+}
+
+static const char *const regs_names_a32[] = {
+	"r0", "r1", "r2", "r3", "r4", "r5", "r6", "r7", "r8", "r9", "r10",
+	"r11", "r12", "sp", "lr",
+};
+
+static const char *const regs_names_a64[] = {
+	"x0", "x1", "x2", "x3", "x4", "x5", "x6", "x7", "x8", "x9", "x10",
+	"x11", "x12", "x13", "x14", "x15", "x16", "x17", "x18", "x19", "x20",
+	"x21", "x22", "x23", "x24", "x25", "x26", "x27", "x28", "x29", "x30",
+	"spsr_el3", "elr_el3", "esr_el3", "far_el3", "sctlr_el3",
+};
+
+static void print_regs(const uint8_t *slab)
+{
+	const char *const *names;
+	size_t reg_size, count, i;
+	uint32_t arch;
+
+	if (get_u32(slab) != CRASH_RAM_REGS_MAGIC) {
+		printf("No register snapshot.\n");
+		return;
+	}
+
+	arch = get_u32(slab + 4);
+	if (arch == CRASH_RAM_REGS_ARCH_AARCH64) {
+		reg_size = 8;
+		names = regs_names_a64;
+		count = sizeof(regs_names_a64) / sizeof(regs_names_a64[0]);
+	} else {
+		reg_size = 4;
+		names = regs_names_a32;
+		count = sizeof(regs_names_a32) / sizeof(regs_names_a32[0]);
+	}
+
+	printf("Register snapshot (AArch%u):\n", arch);
+	for (i = 0; i < count; i++)
+		printf("    %-9s = 0x%llx\n", names[i],
+		       (unsigned long long)get_reg(slab +
+						   CRASH_RAM_REGS_VALS +
+						   (i * reg_size), reg_size));
+}
+
+int main(int argc, char **argv)
+{
+	uint8_t buf[1 << 20];
+	struct record recs[4096];
+	size_t size, ring_size, count, i;
+	FILE *f;
+
+	if (argc != 2) {
+		fprintf(stderr, "Usage: %s <region dump file>\n", argv[0]);
+		return 1;
+	}
+
+	f = fopen(argv[1], "rb");
+	if (f == NULL) {
+		fprintf(stderr, "Cannot open %s: %s\n", argv[1],
+			strerror(errno));
+		return 1;
+	}
+	size = fread(buf, 1, sizeof(buf), f);
+	fclose(f);
+
+	if (size < CRASH_RAM_RING_OFFSET ||
+	    get_u32(buf) != CRASH_RAM_MAGIC) {
+		fprintf(stderr, "%s: not a crash RAM region dump\n", argv[1]);
+		return 1;
+	}
+
+	printf("Region size:  %u bytes (%zu read)\n", get_u32(buf + 4), size);
+	printf("Boot count:   %u\n", get_u32(buf + 8));
+	printf("Next seq:     %u\n", get_u32(buf + 16));
+	printf("Drained seq:  %u\n", get_u32(buf + 20));
+
+	print_regs(buf + CRASH_RAM_REGS_OFFSET);
+
+	ring_size = size - CRASH_RAM_RING_OFFSET;
+	count = scan_ring(buf + CRASH_RAM_RING_OFFSET, ring_size, recs,
+			  sizeof(recs) / sizeof(recs[0]));
+	qsort(recs, count, sizeof(recs[0]), cmp_record);
+
+	printf("%zu record(s):\n", count);
+	for (i = 0; i < count; i++)
+		print_record(&recs[i]);
+
+	return 0;
+}
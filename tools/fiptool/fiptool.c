@@ -6,10 +6,18 @@
 
 #include <sys/types.h>
 #include <sys/stat.h>
+#ifndef _MSC_VER
+#include <sys/mman.h>
+#include <sys/uio.h>
+#endif
 
 #include <assert.h>
 #include <errno.h>
 #include <limits.h>
+#ifndef _MSC_VER
+#include <fcntl.h>
+#include <pthread.h>
+#endif
 #include <stdarg.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -19,9 +27,21 @@
 #include "fiptool.h"
 #include "tbbr_config.h"
 
+#include "../stm32image/stm32image.h"
+
+#ifndef IOV_MAX
+#define IOV_MAX 1024
+#endif
+
 #define OPT_TOC_ENTRY 0
 #define OPT_PLAT_TOC_FLAGS 1
 #define OPT_ALIGN 2
+#define OPT_LOAD_ORDER 3
+#define OPT_TRACE 4
+#define OPT_GEOMETRY 5
+#define OPT_BLKSIZE 6
+#define OPT_STM32 7
+#define OPT_COMP 8
 
 static int info_cmd(int argc, char *argv[]);
 static void info_usage(void);
@@ -33,6 +53,10 @@ static int unpack_cmd(int argc, char *argv[]);
 static void unpack_usage(void);
 static int remove_cmd(int argc, char *argv[]);
 static void remove_usage(void);
+static int reorder_cmd(int argc, char *argv[]);
+static void reorder_usage(void);
+static int interleave_cmd(int argc, char *argv[]);
+static void interleave_usage(void);
 static int version_cmd(int argc, char *argv[]);
 static void version_usage(void);
 static int help_cmd(int argc, char *argv[]);
@@ -45,6 +69,9 @@ static cmd_t cmds[] = {
 	{ .name = "update",  .handler = update_cmd,  .usage = update_usage  },
 	{ .name = "unpack",  .handler = unpack_cmd,  .usage = unpack_usage  },
 	{ .name = "remove",  .handler = remove_cmd,  .usage = remove_usage  },
+	{ .name = "reorder", .handler = reorder_cmd, .usage = reorder_usage },
+	{ .name = "interleave", .handler = interleave_cmd,
+	  .usage = interleave_usage },
 	{ .name = "version", .handler = version_cmd, .usage = version_usage },
 	{ .name = "help",    .handler = help_cmd,    .usage = NULL          },
 };
@@ -134,6 +161,144 @@ static void xfwrite(void *buf, size_t size, FILE *fp, const char *filename)
 		log_errx("Failed to write %s", filename);
 }
 
+#ifndef _MSC_VER
+/*
+ * Input files are mapped read-only instead of being copied to the heap, so
+ * image buffers may alias file contents. The mappings are kept until exit;
+ * the list only exists so they can be released in one place.
+ */
+typedef struct mapping {
+	void           *base;
+	size_t          size;
+	struct mapping *next;
+} mapping_t;
+
+static mapping_t *mapping_head;
+static pthread_mutex_t mapping_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static void *map_file(const char *filename, size_t *size_out)
+{
+	struct BLD_PLAT_STAT st;
+	mapping_t *mapping;
+	void *base;
+	FILE *fp;
+
+	fp = fopen(filename, "rb");
+	if (fp == NULL)
+		log_err("fopen %s", filename);
+
+	if (fstat(fileno(fp), &st) == -1)
+		log_err("fstat %s", filename);
+
+	/* Zero-length files cannot be mapped, let the caller read them. */
+	if (st.st_size == 0) {
+		fclose(fp);
+		return NULL;
+	}
+
+	base = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fileno(fp), 0);
+	fclose(fp);
+	if (base == MAP_FAILED)
+		return NULL;
+
+	mapping = xmalloc(sizeof(*mapping),
+	    "failed to allocate memory for file mapping");
+	mapping->base = base;
+	mapping->size = st.st_size;
+
+	pthread_mutex_lock(&mapping_lock);
+	mapping->next = mapping_head;
+	mapping_head = mapping;
+	pthread_mutex_unlock(&mapping_lock);
+
+	*size_out = st.st_size;
+	return base;
+}
+
+static void unmap_files(void)
+{
+	mapping_t *mapping = mapping_head, *tmp;
+
+	while (mapping != NULL) {
+		tmp = mapping->next;
+		munmap(mapping->base, mapping->size);
+		free(mapping);
+		mapping = tmp;
+	}
+	mapping_head = NULL;
+}
+
+/*
+ * Run fn(0..count - 1, arg) across the host cores. Work items must be
+ * independent; the order they run in is unspecified.
+ */
+typedef void (*work_fn_t)(size_t index, void *arg);
+
+struct work_pool {
+	work_fn_t       fn;
+	void           *arg;
+	size_t          count;
+	size_t          next;
+	pthread_mutex_t lock;
+};
+
+static void *work_pool_thread(void *pool_arg)
+{
+	struct work_pool *pool = pool_arg;
+
+	for (;;) {
+		size_t index;
+
+		pthread_mutex_lock(&pool->lock);
+		index = pool->next++;
+		pthread_mutex_unlock(&pool->lock);
+
+		if (index >= pool->count)
+			return NULL;
+		pool->fn(index, pool->arg);
+	}
+}
+
+static void run_parallel(work_fn_t fn, void *arg, size_t count)
+{
+	struct work_pool pool;
+	pthread_t *threads;
+	long nr_threads;
+	long i;
+
+	nr_threads = sysconf(_SC_NPROCESSORS_ONLN);
+	if (nr_threads < 1)
+		nr_threads = 1;
+	if ((size_t)nr_threads > count)
+		nr_threads = count;
+
+	if (nr_threads == 1) {
+		size_t index;
+
+		for (index = 0; index < count; index++)
+			fn(index, arg);
+		return;
+	}
+
+	pool.fn = fn;
+	pool.arg = arg;
+	pool.count = count;
+	pool.next = 0;
+	pthread_mutex_init(&pool.lock, NULL);
+
+	threads = xmalloc(nr_threads * sizeof(*threads),
+	    "failed to allocate memory for worker threads");
+	for (i = 0; i < nr_threads; i++)
+		if (pthread_create(&threads[i], NULL, work_pool_thread,
+		    &pool) != 0)
+			log_errx("Failed to create worker thread");
+	for (i = 0; i < nr_threads; i++)
+		pthread_join(threads[i], NULL);
+	free(threads);
+	pthread_mutex_destroy(&pool.lock);
+}
+#endif /* !_MSC_VER */
+
 static image_desc_t *new_image_desc(const uuid_t *uuid,
     const char *name, const char *cmdline_name)
 {
@@ -169,8 +334,10 @@ static void free_image_desc(image_desc_t *desc)
 	free(desc->name);
 	free(desc->cmdline_name);
 	free(desc->action_arg);
+	free(desc->stm32_params);
 	if (desc->image) {
-		free(desc->image->buffer);
+		if (!desc->image->mapped)
+			free(desc->image->buffer);
 		free(desc->image);
 	}
 	free(desc);
@@ -217,6 +384,77 @@ static void fill_image_descs(void)
 	}
 }
 
+/*
+ * The order in which the boot firmware consumes the package contents on a
+ * TBBR boot: BL1 loads BL2's content certificate, BL2 itself and its
+ * configs, then BL2 walks each payload's certificate chain immediately
+ * before the payload. Laying the file out this way lets a boot from
+ * sequential-access storage read the FIP front to back without backward
+ * seeks.
+ */
+static const char *const load_order_names[] = {
+	"tb-fw-cert",
+	"tb-fw",
+	"tb-fw-config",
+	"hw-config",
+	"rot-cert",
+	"trusted-key-cert",
+	"scp-fw-key-cert",
+	"scp-fw-cert",
+	"scp-fw",
+	"soc-fw-key-cert",
+	"soc-fw-cert",
+	"soc-fw",
+	"soc-fw-config",
+	"tos-fw-key-cert",
+	"tos-fw-cert",
+	"tos-fw",
+	"tos-fw-extra1",
+	"tos-fw-extra2",
+	"tos-fw-config",
+	"nt-fw-key-cert",
+	"nt-fw-cert",
+	"nt-fw",
+	"nt-fw-config",
+	"fwu-cert",
+	"scp-fwu-cfg",
+	"ap-fwu-cfg",
+	"fwu",
+};
+
+/*
+ * Stable-sort the image list into boot-load order. Images without a known
+ * load position (blobs) keep their relative order behind the known ones.
+ */
+static void reorder_image_descs_load_order(void)
+{
+	image_desc_t *head = NULL, **tail = &head;
+	size_t i;
+
+	for (i = 0;
+	     i < sizeof(load_order_names) / sizeof(load_order_names[0]);
+	     i++) {
+		image_desc_t **p = &image_desc_head;
+
+		while (*p != NULL) {
+			if (strcmp((*p)->cmdline_name,
+			    load_order_names[i]) == 0) {
+				image_desc_t *desc = *p;
+
+				*p = desc->next;
+				desc->next = NULL;
+				*tail = desc;
+				tail = &desc->next;
+			} else {
+				p = &(*p)->next;
+			}
+		}
+	}
+
+	*tail = image_desc_head;
+	image_desc_head = head;
+}
+
 static image_desc_t *lookup_image_desc_from_uuid(const uuid_t *uuid)
 {
 	image_desc_t *desc;
@@ -278,29 +516,173 @@ static void uuid_from_str(uuid_t *u, const char *s)
 		log_errx("Invalid UUID: %s", s);
 }
 
-static int parse_fip(const char *filename, fip_toc_header_t *toc_header_out)
+/*
+ * Stable-sort the image list into the order recorded in an access trace.
+ * Images the trace does not mention keep their relative order behind the
+ * traced ones, so content never consumed on the traced boot path ends up
+ * at the back of the file.
+ */
+static void reorder_image_descs_trace(char **trace, size_t nr_trace)
+{
+	image_desc_t *head = NULL, **tail = &head;
+	size_t i;
+
+	for (i = 0; i < nr_trace; i++) {
+		image_desc_t **p = &image_desc_head;
+		int found = 0;
+
+		while (*p != NULL) {
+			char uuid_str[_UUID_STR_LEN + 1];
+
+			uuid_to_str(uuid_str, sizeof(uuid_str), &(*p)->uuid);
+			if (strcmp((*p)->cmdline_name, trace[i]) == 0 ||
+			    strcmp(uuid_str, trace[i]) == 0) {
+				image_desc_t *desc = *p;
+
+				*p = desc->next;
+				desc->next = NULL;
+				*tail = desc;
+				tail = &desc->next;
+				found = 1;
+			} else {
+				p = &(*p)->next;
+			}
+		}
+
+		if (!found)
+			log_warnx("Traced image %s not found in FIP",
+			    trace[i]);
+	}
+
+	*tail = image_desc_head;
+	image_desc_head = head;
+}
+
+/*
+ * Read an access trace: one image per line, identified by its ToC entry
+ * command line name or its UUID, in the order a debug BL2 build reported
+ * opening them. Blank lines and '#' comments are skipped; duplicate
+ * entries keep their first position.
+ */
+static char **read_trace_file(const char *filename, size_t *nr_trace_out)
+{
+	char line[PATH_MAX];
+	char **trace = NULL;
+	size_t nr_trace = 0;
+	FILE *fp;
+
+	fp = fopen(filename, "r");
+	if (fp == NULL)
+		log_err("fopen %s", filename);
+
+	while (fgets(line, sizeof(line), fp) != NULL) {
+		size_t i, len;
+		char *p = line;
+
+		while (*p == ' ' || *p == '\t')
+			p++;
+		p[strcspn(p, "#\r\n")] = '\0';
+		len = strlen(p);
+		while (len > 0 && (p[len - 1] == ' ' || p[len - 1] == '\t'))
+			p[--len] = '\0';
+		if (len == 0)
+			continue;
+
+		for (i = 0; i < nr_trace; i++)
+			if (strcmp(trace[i], p) == 0)
+				break;
+		if (i < nr_trace)
+			continue;
+
+		trace = realloc(trace, (nr_trace + 1) * sizeof(*trace));
+		if (trace == NULL)
+			log_err("realloc");
+		trace[nr_trace++] = xstrdup(p,
+		    "failed to allocate memory for trace entry");
+	}
+
+	fclose(fp);
+
+	if (nr_trace == 0)
+		log_errx("Trace file %s contains no images", filename);
+
+	*nr_trace_out = nr_trace;
+	return trace;
+}
+
+static void free_trace(char **trace, size_t nr_trace)
+{
+	size_t i;
+
+	for (i = 0; i < nr_trace; i++)
+		free(trace[i]);
+	free(trace);
+}
+
+/* Erase/read block geometries of the supported boot device types. */
+static const struct {
+	const char   *name;
+	unsigned long blksize;
+} geometries[] = {
+	{ "emmc",    512 },	/* eMMC/SD block */
+	{ "nor",    4096 },	/* NOR erase sector */
+	{ "nand-2k", 2048 },	/* small-page NAND */
+	{ "nand-4k", 4096 },	/* large-page NAND */
+	{ "nand-8k", 8192 },
+};
+
+static unsigned long get_geometry_blksize(const char *arg)
+{
+	int i;
+
+	for (i = 0; i < NELEM(geometries); i++)
+		if (strcmp(geometries[i].name, arg) == 0)
+			return geometries[i].blksize;
+
+	log_errx("Unknown device geometry: %s", arg);
+	return 0;
+}
+
+/*
+ * With zero_copy set, the FIP stays mapped and the image buffers alias its
+ * contents. Callers rewriting the parsed file must not use it: truncating
+ * the file would invalidate the mapping.
+ */
+static int parse_fip(const char *filename, fip_toc_header_t *toc_header_out,
+    int zero_copy)
 {
 	struct BLD_PLAT_STAT st;
 	FILE *fp;
-	char *buf, *bufend;
+	char *buf = NULL, *bufend;
 	fip_toc_header_t *toc_header;
 	fip_toc_entry_t *toc_entry;
 	int terminated = 0;
+	size_t fip_size = 0;
 
-	fp = fopen(filename, "rb");
-	if (fp == NULL)
-		log_err("fopen %s", filename);
+#ifndef _MSC_VER
+	if (zero_copy)
+		buf = map_file(filename, &fip_size);
+#endif
 
-	if (fstat(fileno(fp), &st) == -1)
-		log_err("fstat %s", filename);
+	if (buf == NULL) {
+		zero_copy = 0;
 
-	buf = xmalloc(st.st_size, "failed to load file into memory");
-	if (fread(buf, 1, st.st_size, fp) != st.st_size)
-		log_errx("Failed to read %s", filename);
-	bufend = buf + st.st_size;
-	fclose(fp);
+		fp = fopen(filename, "rb");
+		if (fp == NULL)
+			log_err("fopen %s", filename);
+
+		if (fstat(fileno(fp), &st) == -1)
+			log_err("fstat %s", filename);
 
-	if (st.st_size < sizeof(fip_toc_header_t))
+		buf = xmalloc(st.st_size, "failed to load file into memory");
+		if (fread(buf, 1, st.st_size, fp) != st.st_size)
+			log_errx("Failed to read %s", filename);
+		fip_size = st.st_size;
+		fclose(fp);
+	}
+	bufend = buf + fip_size;
+
+	if (fip_size < sizeof(fip_toc_header_t))
 		log_errx("FIP %s is truncated", filename);
 
 	toc_header = (fip_toc_header_t *)buf;
@@ -331,16 +713,21 @@ static int parse_fip(const char *filename, fip_toc_header_t *toc_header_out)
 		image = xzalloc(sizeof(*image),
 		    "failed to allocate memory for image");
 		image->toc_e = *toc_entry;
-		image->buffer = xmalloc(toc_entry->size,
-		    "failed to allocate image buffer, is FIP file corrupted?");
-		/* Overflow checks before memory copy. */
+		/* Overflow checks before the buffer is referenced. */
 		if (toc_entry->size > (uint64_t)-1 - toc_entry->offset_address)
 			log_errx("FIP %s is corrupted", filename);
-		if (toc_entry->size + toc_entry->offset_address > st.st_size)
+		if (toc_entry->size + toc_entry->offset_address > fip_size)
 			log_errx("FIP %s is corrupted", filename);
 
-		memcpy(image->buffer, buf + toc_entry->offset_address,
-		    toc_entry->size);
+		if (zero_copy) {
+			image->buffer = buf + toc_entry->offset_address;
+			image->mapped = 1;
+		} else {
+			image->buffer = xmalloc(toc_entry->size,
+			    "failed to allocate image buffer, is FIP file corrupted?");
+			memcpy(image->buffer, buf + toc_entry->offset_address,
+			    toc_entry->size);
+		}
 
 		/* If this is an unknown image, create a descriptor for it. */
 		desc = lookup_image_desc_from_uuid(&toc_entry->uuid);
@@ -366,7 +753,8 @@ static int parse_fip(const char *filename, fip_toc_header_t *toc_header_out)
 	if (terminated == 0)
 		log_errx("FIP %s does not have a ToC terminator entry",
 		    filename);
-	free(buf);
+	if (!zero_copy)
+		free(buf);
 	return 0;
 }
 
@@ -379,6 +767,23 @@ static image_t *read_image_from_file(const uuid_t *uuid, const char *filename)
 	assert(uuid != NULL);
 	assert(filename != NULL);
 
+#ifndef _MSC_VER
+	{
+		size_t size;
+		void *base = map_file(filename, &size);
+
+		if (base != NULL) {
+			image = xzalloc(sizeof(*image),
+			    "failed to allocate memory for image");
+			image->toc_e.uuid = *uuid;
+			image->buffer = base;
+			image->mapped = 1;
+			image->toc_e.size = size;
+			return image;
+		}
+	}
+#endif
+
 	fp = fopen(filename, "rb");
 	if (fp == NULL)
 		log_err("fopen %s", filename);
@@ -442,16 +847,35 @@ static void md_print(const unsigned char *md, size_t len)
 		printf("%02x", md[i]);
 }
 
+#ifndef _MSC_VER
+struct hash_images_ctx {
+	image_t      **images;
+	unsigned char *mds;
+};
+
+static void hash_image_work(size_t index, void *arg)
+{
+	struct hash_images_ctx *ctx = arg;
+
+	SHA256(ctx->images[index]->buffer, ctx->images[index]->toc_e.size,
+	    &ctx->mds[index * SHA256_DIGEST_LENGTH]);
+}
+#endif
+
 static int info_cmd(int argc, char *argv[])
 {
 	image_desc_t *desc;
 	fip_toc_header_t toc_header;
+#ifndef _MSC_VER
+	struct hash_images_ctx ctx = { NULL, NULL };
+	size_t i, nr_images = 0;
+#endif
 
 	if (argc != 2)
 		info_usage();
 	argc--, argv++;
 
-	parse_fip(argv[0], &toc_header);
+	parse_fip(argv[0], &toc_header, 1);
 
 	if (verbose) {
 		log_dbgx("toc_header[name]: 0x%llX",
@@ -462,6 +886,28 @@ static int info_cmd(int argc, char *argv[])
 		    (unsigned long long)toc_header.flags);
 	}
 
+#ifndef _MSC_VER	/* We don't have SHA256 for Visual Studio. */
+	/* Digest all images across the host cores before printing. */
+	if (verbose) {
+		for (desc = image_desc_head; desc != NULL; desc = desc->next)
+			if (desc->image != NULL)
+				nr_images++;
+		if (nr_images != 0) {
+			ctx.images = xmalloc(nr_images * sizeof(*ctx.images),
+			    "failed to allocate memory for digest list");
+			ctx.mds = xmalloc(nr_images * SHA256_DIGEST_LENGTH,
+			    "failed to allocate memory for digest list");
+			i = 0;
+			for (desc = image_desc_head; desc != NULL;
+			     desc = desc->next)
+				if (desc->image != NULL)
+					ctx.images[i++] = desc->image;
+			run_parallel(hash_image_work, &ctx, nr_images);
+		}
+	}
+	i = 0;
+#endif
+
 	for (desc = image_desc_head; desc != NULL; desc = desc->next) {
 		image_t *image = desc->image;
 
@@ -472,18 +918,32 @@ static int info_cmd(int argc, char *argv[])
 		       (unsigned long long)image->toc_e.offset_address,
 		       (unsigned long long)image->toc_e.size,
 		       desc->cmdline_name);
+		switch (image->toc_e.flags & FIP_TOC_ENTRY_COMP_MASK) {
+		case FIP_TOC_ENTRY_COMP_ZLIB:
+			printf(", comp=\"zlib\"");
+			break;
+		case FIP_TOC_ENTRY_COMP_LZ4:
+			printf(", comp=\"lz4\"");
+			break;
+		default:
+			break;
+		}
 #ifndef _MSC_VER	/* We don't have SHA256 for Visual Studio. */
 		if (verbose) {
-			unsigned char md[SHA256_DIGEST_LENGTH];
-
-			SHA256(image->buffer, image->toc_e.size, md);
 			printf(", sha256=");
-			md_print(md, sizeof(md));
+			md_print(&ctx.mds[i * SHA256_DIGEST_LENGTH],
+			    SHA256_DIGEST_LENGTH);
+			i++;
 		}
 #endif
 		putchar('\n');
 	}
 
+#ifndef _MSC_VER
+	free(ctx.images);
+	free(ctx.mds);
+#endif
+
 	return 0;
 }
 
@@ -493,14 +953,97 @@ static void info_usage(void)
 	exit(1);
 }
 
-static int pack_images(const char *filename, uint64_t toc_flags, unsigned long align)
+#ifndef _MSC_VER
+/* Shared source of padding bytes for the gather-write output path. */
+static const unsigned char zero_pad[4096];
+
+static struct iovec *append_iov(struct iovec *iov, size_t *nr_iov,
+    const void *base, size_t len)
+{
+	if (len == 0)
+		return iov;
+	iov = realloc(iov, (*nr_iov + 1) * sizeof(*iov));
+	if (iov == NULL)
+		log_err("realloc");
+	/* writev() does not write through iov_base, the cast is safe. */
+	iov[*nr_iov].iov_base = (void *)base;
+	iov[*nr_iov].iov_len = len;
+	++*nr_iov;
+	return iov;
+}
+
+static struct iovec *append_pad_iov(struct iovec *iov, size_t *nr_iov,
+    size_t len)
+{
+	while (len > sizeof(zero_pad)) {
+		iov = append_iov(iov, nr_iov, zero_pad, sizeof(zero_pad));
+		len -= sizeof(zero_pad);
+	}
+	return append_iov(iov, nr_iov, zero_pad, len);
+}
+
+static void xwritev(int fd, struct iovec *iov, size_t nr_iov,
+    const char *filename)
+{
+	while (nr_iov > 0) {
+		ssize_t written;
+
+		written = writev(fd, iov,
+		    nr_iov > IOV_MAX ? IOV_MAX : (int)nr_iov);
+		if (written <= 0)
+			log_err("writev %s", filename);
+
+		while ((size_t)written > 0) {
+			if ((size_t)written >= iov->iov_len) {
+				written -= iov->iov_len;
+				iov++;
+				nr_iov--;
+			} else {
+				iov->iov_base = (char *)iov->iov_base + written;
+				iov->iov_len -= written;
+				written = 0;
+			}
+		}
+	}
+}
+#endif /* !_MSC_VER */
+
+/*
+ * Place the next image at entry_offset, subject to the requested alignment
+ * and, with blksize set, to the device geometry: an image that does not fit
+ * in the tail of the current storage block is pushed to the next block
+ * boundary. Consecutively accessed images share a block when they can, so
+ * a sequential boot touches the minimum number of device blocks without
+ * spending a full block of padding on every small certificate.
+ */
+static uint64_t place_image(uint64_t entry_offset, uint64_t size,
+    unsigned long align, unsigned long blksize)
 {
+	entry_offset = (entry_offset + align - 1) & ~((uint64_t)align - 1);
+
+	if (blksize != 0) {
+		uint64_t tail = entry_offset & (blksize - 1);
+
+		if (tail != 0 && size > blksize - tail)
+			entry_offset = (entry_offset + blksize - 1) &
+			    ~((uint64_t)blksize - 1);
+	}
+
+	return entry_offset;
+}
+
+static int pack_images(const char *filename, uint64_t toc_flags,
+    unsigned long align, unsigned long blksize)
+{
+#ifdef _MSC_VER
 	FILE *fp;
+	uint64_t pad_size;
+#endif
 	image_desc_t *desc;
 	fip_toc_header_t *toc_header;
 	fip_toc_entry_t *toc_entry;
 	char *buf;
-	uint64_t entry_offset, buf_size, payload_size = 0, pad_size;
+	uint64_t entry_offset, buf_size, payload_size = 0;
 	size_t nr_images = 0;
 
 	for (desc = image_desc_head; desc != NULL; desc = desc->next)
@@ -528,7 +1071,8 @@ static int pack_images(const char *filename, uint64_t toc_flags, unsigned long a
 		if (image == NULL)
 			continue;
 		payload_size += image->toc_e.size;
-		entry_offset = (entry_offset + align - 1) & ~(align - 1);
+		entry_offset = place_image(entry_offset, image->toc_e.size,
+		    align, blksize);
 		image->toc_e.offset_address = entry_offset;
 		*toc_entry++ = image->toc_e;
 		entry_offset += image->toc_e.size;
@@ -542,19 +1086,57 @@ static int pack_images(const char *filename, uint64_t toc_flags, unsigned long a
 	memset(toc_entry, 0, sizeof(*toc_entry));
 	toc_entry->offset_address = (entry_offset + align - 1) & ~(align - 1);
 
+	if (verbose) {
+		log_dbgx("Metadata size: %zu bytes", buf_size);
+		log_dbgx("Payload size: %zu bytes", payload_size);
+	}
+
+#ifndef _MSC_VER
+	{
+		/*
+		 * Generate the FIP file with a single gather write: the
+		 * metadata, images and alignment padding go out in one
+		 * batch straight from their buffers or file mappings.
+		 */
+		struct iovec *iov = NULL;
+		size_t nr_iov = 0;
+		uint64_t cur_offset = buf_size;
+		int fd;
+
+		fd = open(filename, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+		if (fd < 0)
+			log_err("open %s", filename);
+
+		iov = append_iov(iov, &nr_iov, buf, buf_size);
+		for (desc = image_desc_head; desc != NULL; desc = desc->next) {
+			image_t *image = desc->image;
+
+			if (image == NULL)
+				continue;
+			iov = append_pad_iov(iov, &nr_iov,
+			    image->toc_e.offset_address - cur_offset);
+			iov = append_iov(iov, &nr_iov, image->buffer,
+			    image->toc_e.size);
+			cur_offset = image->toc_e.offset_address +
+			    image->toc_e.size;
+		}
+		iov = append_pad_iov(iov, &nr_iov,
+		    toc_entry->offset_address - cur_offset);
+
+		xwritev(fd, iov, nr_iov, filename);
+
+		free(iov);
+		if (close(fd) < 0)
+			log_err("close %s", filename);
+	}
+#else
 	/* Generate the FIP file. */
 	fp = fopen(filename, "wb");
 	if (fp == NULL)
 		log_err("fopen %s", filename);
 
-	if (verbose)
-		log_dbgx("Metadata size: %zu bytes", buf_size);
-
 	xfwrite(buf, buf_size, fp, filename);
 
-	if (verbose)
-		log_dbgx("Payload size: %zu bytes", payload_size);
-
 	for (desc = image_desc_head; desc != NULL; desc = desc->next) {
 		image_t *image = desc->image;
 
@@ -573,11 +1155,137 @@ static int pack_images(const char *filename, uint64_t toc_flags, unsigned long a
 	while (pad_size--)
 		fputc(0x0, fp);
 
-	free(buf);
 	fclose(fp);
+#endif
+
+	free(buf);
 	return 0;
 }
 
+/*
+ * Parse an --stm32 option:
+ *   image=<name>,load=<addr>,entry=<addr>[,version=<n>][,major=<n>][,minor=<n>]
+ * where <name> is the ToC entry command line name of an image packed in
+ * the same invocation.
+ */
+static struct stm32image_params *parse_stm32_opt(char *arg, char *name,
+    size_t len)
+{
+	struct stm32image_params *params;
+	int have_load = 0, have_entry = 0;
+	char *p;
+
+	params = xzalloc(sizeof(*params),
+	    "failed to allocate memory for STM32 header parameters");
+	params->major = STM32IMAGE_HEADER_VERSION_V1;
+	name[0] = '\0';
+
+	for (p = strtok(arg, ","); p != NULL; p = strtok(NULL, ",")) {
+		if (strncmp(p, "image=", strlen("image=")) == 0) {
+			snprintf(name, len, "%s", p + strlen("image="));
+		} else if (strncmp(p, "load=", strlen("load=")) == 0) {
+			params->loadaddr =
+			    strtoul(p + strlen("load="), NULL, 0);
+			have_load = 1;
+		} else if (strncmp(p, "entry=", strlen("entry=")) == 0) {
+			params->entry =
+			    strtoul(p + strlen("entry="), NULL, 0);
+			have_entry = 1;
+		} else if (strncmp(p, "version=", strlen("version=")) == 0) {
+			params->version =
+			    strtoul(p + strlen("version="), NULL, 0);
+		} else if (strncmp(p, "major=", strlen("major=")) == 0) {
+			params->major =
+			    strtoul(p + strlen("major="), NULL, 0);
+		} else if (strncmp(p, "minor=", strlen("minor=")) == 0) {
+			params->minor =
+			    strtoul(p + strlen("minor="), NULL, 0);
+		} else {
+			log_errx("Unknown --stm32 parameter: %s", p);
+		}
+	}
+
+	if (name[0] == '\0' || !have_load || !have_entry)
+		log_errx("--stm32 requires image=, load= and entry=");
+
+	return params;
+}
+
+static void set_stm32_opt(char *arg)
+{
+	char name[PATH_MAX];
+	struct stm32image_params *params;
+	image_desc_t *desc;
+
+	params = parse_stm32_opt(arg, name, sizeof(name));
+	desc = lookup_image_desc_from_opt(name);
+	if (desc == NULL)
+		log_errx("Unknown image \"%s\" in --stm32 option", name);
+	free(desc->stm32_params);
+	desc->stm32_params = params;
+}
+
+/*
+ * Parse a --comp option:
+ *   <name>=<none|zlib|lz4>
+ * recording the compression format of the named image's payload in its
+ * ToC entry flags.
+ */
+static void set_comp_opt(char *arg)
+{
+	image_desc_t *desc;
+	uint64_t comp;
+	char *fmt;
+
+	fmt = strchr(arg, '=');
+	if (fmt == NULL)
+		log_errx("--comp format is <image>=<none|zlib|lz4>");
+	*fmt++ = '\0';
+
+	if (strcmp(fmt, "none") == 0)
+		comp = FIP_TOC_ENTRY_COMP_NONE;
+	else if (strcmp(fmt, "zlib") == 0)
+		comp = FIP_TOC_ENTRY_COMP_ZLIB;
+	else if (strcmp(fmt, "lz4") == 0)
+		comp = FIP_TOC_ENTRY_COMP_LZ4;
+	else
+		log_errx("Unknown compression format \"%s\" in --comp option",
+		    fmt);
+
+	desc = lookup_image_desc_from_opt(arg);
+	if (desc == NULL)
+		log_errx("Unknown image \"%s\" in --comp option", arg);
+	desc->toc_flags &= ~FIP_TOC_ENTRY_COMP_MASK;
+	desc->toc_flags |= comp;
+}
+
+/*
+ * Prefix an image with an STM32 boot header in memory: the payload is
+ * copied once, from its file mapping into the wrapped buffer, and goes
+ * to disk with the rest of the FIP. No intermediate file is written.
+ */
+static void stm32image_wrap_image(image_t *image,
+    const struct stm32image_params *params)
+{
+	char *buf;
+	uint64_t payload_size = image->toc_e.size;
+
+	if (payload_size > UINT32_MAX - STM32IMAGE_HEADER_SIZE)
+		log_errx("Image too large for an STM32 header");
+
+	buf = xmalloc(payload_size + STM32IMAGE_HEADER_SIZE,
+	    "failed to allocate memory for wrapped image");
+	stm32image_make_header((struct stm32_header *)buf, image->buffer,
+	    (uint32_t)payload_size, params);
+	memcpy(buf + STM32IMAGE_HEADER_SIZE, image->buffer, payload_size);
+
+	if (!image->mapped)
+		free(image->buffer);
+	image->buffer = buf;
+	image->mapped = 0;
+	image->toc_e.size = payload_size + STM32IMAGE_HEADER_SIZE;
+}
+
 /*
  * This function is shared between the create and update subcommands.
  * The difference between the two subcommands is that when the FIP file
@@ -585,10 +1293,70 @@ static int pack_images(const char *filename, uint64_t toc_flags, unsigned long a
  * in update_fip() creating the new FIP file from scratch because the
  * internal image table is not populated.
  */
+#ifndef _MSC_VER
+struct load_images_ctx {
+	image_desc_t **descs;
+	image_t      **images;
+};
+
+static void load_image_work(size_t index, void *arg)
+{
+	struct load_images_ctx *ctx = arg;
+
+	ctx->images[index] = read_image_from_file(&ctx->descs[index]->uuid,
+	    ctx->descs[index]->action_arg);
+	ctx->images[index]->toc_e.flags |= ctx->descs[index]->toc_flags;
+	if (ctx->descs[index]->stm32_params != NULL)
+		stm32image_wrap_image(ctx->images[index],
+		    ctx->descs[index]->stm32_params);
+}
+#endif
+
 static void update_fip(void)
 {
 	image_desc_t *desc;
+#ifndef _MSC_VER
+	struct load_images_ctx ctx;
+	size_t i, nr_packs = 0;
+
+	/* Load all images to be packed across the host cores. */
+	for (desc = image_desc_head; desc != NULL; desc = desc->next)
+		if (desc->action == DO_PACK)
+			nr_packs++;
+
+	if (nr_packs == 0)
+		return;
+
+	ctx.descs = xmalloc(nr_packs * sizeof(*ctx.descs),
+	    "failed to allocate memory for image load list");
+	ctx.images = xmalloc(nr_packs * sizeof(*ctx.images),
+	    "failed to allocate memory for image load list");
+	i = 0;
+	for (desc = image_desc_head; desc != NULL; desc = desc->next)
+		if (desc->action == DO_PACK)
+			ctx.descs[i++] = desc;
+
+	run_parallel(load_image_work, &ctx, nr_packs);
+
+	/* Add or replace images in the FIP file. */
+	for (i = 0; i < nr_packs; i++) {
+		desc = ctx.descs[i];
+		if (desc->image != NULL) {
+			if (verbose) {
+				log_dbgx("Replacing %s with %s",
+				    desc->cmdline_name,
+				    desc->action_arg);
+			}
+			free(desc->image);
+		} else if (verbose) {
+			log_dbgx("Adding image %s", desc->action_arg);
+		}
+		desc->image = ctx.images[i];
+	}
 
+	free(ctx.descs);
+	free(ctx.images);
+#else
 	/* Add or replace images in the FIP file. */
 	for (desc = image_desc_head; desc != NULL; desc = desc->next) {
 		image_t *image;
@@ -598,6 +1366,9 @@ static void update_fip(void)
 
 		image = read_image_from_file(&desc->uuid,
 		    desc->action_arg);
+		image->toc_e.flags |= desc->toc_flags;
+		if (desc->stm32_params != NULL)
+			stm32image_wrap_image(image, desc->stm32_params);
 		if (desc->image != NULL) {
 			if (verbose) {
 				log_dbgx("Replacing %s with %s",
@@ -613,6 +1384,7 @@ static void update_fip(void)
 			desc->image = image;
 		}
 	}
+#endif
 }
 
 static void parse_plat_toc_flags(const char *arg, unsigned long long *toc_flags)
@@ -667,6 +1439,7 @@ static int create_cmd(int argc, char *argv[])
 	size_t nr_opts = 0;
 	unsigned long long toc_flags = 0;
 	unsigned long align = 1;
+	int load_order = 0;
 
 	if (argc < 2)
 		create_usage();
@@ -675,6 +1448,10 @@ static int create_cmd(int argc, char *argv[])
 	opts = add_opt(opts, &nr_opts, "plat-toc-flags", required_argument,
 	    OPT_PLAT_TOC_FLAGS);
 	opts = add_opt(opts, &nr_opts, "align", required_argument, OPT_ALIGN);
+	opts = add_opt(opts, &nr_opts, "load-order", no_argument,
+	    OPT_LOAD_ORDER);
+	opts = add_opt(opts, &nr_opts, "stm32", required_argument, OPT_STM32);
+	opts = add_opt(opts, &nr_opts, "comp", required_argument, OPT_COMP);
 	opts = add_opt(opts, &nr_opts, "blob", required_argument, 'b');
 	opts = add_opt(opts, &nr_opts, NULL, 0, 0);
 
@@ -699,6 +1476,15 @@ static int create_cmd(int argc, char *argv[])
 		case OPT_ALIGN:
 			align = get_image_align(optarg);
 			break;
+		case OPT_LOAD_ORDER:
+			load_order = 1;
+			break;
+		case OPT_STM32:
+			set_stm32_opt(optarg);
+			break;
+		case OPT_COMP:
+			set_comp_opt(optarg);
+			break;
 		case 'b': {
 			char name[_UUID_STR_LEN + 1];
 			char filename[PATH_MAX] = { 0 };
@@ -734,7 +1520,10 @@ static int create_cmd(int argc, char *argv[])
 
 	update_fip();
 
-	pack_images(argv[0], toc_flags, align);
+	if (load_order)
+		reorder_image_descs_load_order();
+
+	pack_images(argv[0], toc_flags, align, 0);
 	return 0;
 }
 
@@ -747,7 +1536,13 @@ static void create_usage(void)
 	printf("Options:\n");
 	printf("  --align <value>\t\tEach image is aligned to <value> (default: 1).\n");
 	printf("  --blob uuid=...,file=...\tAdd an image with the given UUID pointed to by file.\n");
+	printf("  --load-order\t\t\tLay out images in the order the boot firmware reads them.\n");
 	printf("  --plat-toc-flags <value>\t16-bit platform specific flag field occupying bits 32-47 in 64-bit ToC header.\n");
+	printf("  --stm32 image=...,load=...,entry=...\tWrap the named image with an STM32 boot\n");
+	printf("\t\t\theader while packing, without an intermediate file.\n");
+	printf("\t\t\tOptional: version=<n>, major=<n>, minor=<n>.\n");
+	printf("  --comp <image>=<none|zlib|lz4>\tTag the named image's compression format\n");
+	printf("\t\t\tin its ToC entry flags.\n");
 	printf("\n");
 	printf("Specific images are packed with the following options:\n");
 	for (; toc_entry->cmdline_name != NULL; toc_entry++)
@@ -764,6 +1559,7 @@ static int update_cmd(int argc, char *argv[])
 	fip_toc_header_t toc_header = { 0 };
 	unsigned long long toc_flags = 0;
 	unsigned long align = 1;
+	int load_order = 0;
 	int pflag = 0;
 
 	if (argc < 2)
@@ -771,6 +1567,10 @@ static int update_cmd(int argc, char *argv[])
 
 	opts = fill_common_opts(opts, &nr_opts, required_argument);
 	opts = add_opt(opts, &nr_opts, "align", required_argument, OPT_ALIGN);
+	opts = add_opt(opts, &nr_opts, "load-order", no_argument,
+	    OPT_LOAD_ORDER);
+	opts = add_opt(opts, &nr_opts, "stm32", required_argument, OPT_STM32);
+	opts = add_opt(opts, &nr_opts, "comp", required_argument, OPT_COMP);
 	opts = add_opt(opts, &nr_opts, "blob", required_argument, 'b');
 	opts = add_opt(opts, &nr_opts, "out", required_argument, 'o');
 	opts = add_opt(opts, &nr_opts, "plat-toc-flags", required_argument,
@@ -821,6 +1621,15 @@ static int update_cmd(int argc, char *argv[])
 		case OPT_ALIGN:
 			align = get_image_align(optarg);
 			break;
+		case OPT_LOAD_ORDER:
+			load_order = 1;
+			break;
+		case OPT_STM32:
+			set_stm32_opt(optarg);
+			break;
+		case OPT_COMP:
+			set_comp_opt(optarg);
+			break;
 		case 'o':
 			snprintf(outfile, sizeof(outfile), "%s", optarg);
 			break;
@@ -838,8 +1647,10 @@ static int update_cmd(int argc, char *argv[])
 	if (outfile[0] == '\0')
 		snprintf(outfile, sizeof(outfile), "%s", argv[0]);
 
+	/* Only keep the parsed FIP mapped when it is not being rewritten. */
 	if (access(argv[0], F_OK) == 0)
-		parse_fip(argv[0], &toc_header);
+		parse_fip(argv[0], &toc_header,
+		    strcmp(outfile, argv[0]) != 0);
 
 	if (pflag)
 		toc_header.flags &= ~(0xffffULL << 32);
@@ -847,7 +1658,10 @@ static int update_cmd(int argc, char *argv[])
 
 	update_fip();
 
-	pack_images(outfile, toc_flags, align);
+	if (load_order)
+		reorder_image_descs_load_order();
+
+	pack_images(outfile, toc_flags, align, 0);
 	return 0;
 }
 
@@ -860,8 +1674,14 @@ static void update_usage(void)
 	printf("Options:\n");
 	printf("  --align <value>\t\tEach image is aligned to <value> (default: 1).\n");
 	printf("  --blob uuid=...,file=...\tAdd or update an image with the given UUID pointed to by file.\n");
+	printf("  --load-order\t\t\tLay out images in the order the boot firmware reads them.\n");
 	printf("  --out FIP_FILENAME\t\tSet an alternative output FIP file.\n");
 	printf("  --plat-toc-flags <value>\t16-bit platform specific flag field occupying bits 32-47 in 64-bit ToC header.\n");
+	printf("  --stm32 image=...,load=...,entry=...\tWrap the named image with an STM32 boot\n");
+	printf("\t\t\theader while packing, without an intermediate file.\n");
+	printf("\t\t\tOptional: version=<n>, major=<n>, minor=<n>.\n");
+	printf("  --comp <image>=<none|zlib|lz4>\tTag the named image's compression format\n");
+	printf("\t\t\tin its ToC entry flags.\n");
 	printf("\n");
 	printf("Specific images are packed with the following options:\n");
 	for (; toc_entry->cmdline_name != NULL; toc_entry++)
@@ -944,7 +1764,7 @@ static int unpack_cmd(int argc, char *argv[])
 	if (argc == 0)
 		unpack_usage();
 
-	parse_fip(argv[0], NULL);
+	parse_fip(argv[0], NULL, 1);
 
 	if (outdir[0] != '\0')
 		if (chdir(outdir) == -1)
@@ -1088,7 +1908,8 @@ static int remove_cmd(int argc, char *argv[])
 	if (outfile[0] == '\0')
 		snprintf(outfile, sizeof(outfile), "%s", argv[0]);
 
-	parse_fip(argv[0], &toc_header);
+	/* Only keep the parsed FIP mapped when it is not being rewritten. */
+	parse_fip(argv[0], &toc_header, strcmp(outfile, argv[0]) != 0);
 
 	for (desc = image_desc_head; desc != NULL; desc = desc->next) {
 		if (desc->action != DO_REMOVE)
@@ -1106,7 +1927,7 @@ static int remove_cmd(int argc, char *argv[])
 		}
 	}
 
-	pack_images(outfile, toc_header.flags, align);
+	pack_images(outfile, toc_header.flags, align, 0);
 	return 0;
 }
 
@@ -1129,6 +1950,214 @@ static void remove_usage(void)
 	exit(1);
 }
 
+static int reorder_cmd(int argc, char *argv[])
+{
+	struct option *opts = NULL;
+	size_t nr_opts = 0;
+	char outfile[PATH_MAX] = { 0 };
+	char tracefile[PATH_MAX] = { 0 };
+	fip_toc_header_t toc_header;
+	char **trace;
+	size_t nr_trace;
+	unsigned long align = 1;
+	unsigned long blksize = 0;
+	int fflag = 0;
+
+	if (argc < 2)
+		reorder_usage();
+
+	opts = add_opt(opts, &nr_opts, "align", required_argument, OPT_ALIGN);
+	opts = add_opt(opts, &nr_opts, "block-size", required_argument,
+	    OPT_BLKSIZE);
+	opts = add_opt(opts, &nr_opts, "force", no_argument, 'f');
+	opts = add_opt(opts, &nr_opts, "geometry", required_argument,
+	    OPT_GEOMETRY);
+	opts = add_opt(opts, &nr_opts, "out", required_argument, 'o');
+	opts = add_opt(opts, &nr_opts, "trace", required_argument, OPT_TRACE);
+	opts = add_opt(opts, &nr_opts, NULL, 0, 0);
+
+	while (1) {
+		int c, opt_index = 0;
+
+		c = getopt_long(argc, argv, "fo:", opts, &opt_index);
+		if (c == -1)
+			break;
+
+		switch (c) {
+		case OPT_ALIGN:
+			align = get_image_align(optarg);
+			break;
+		case OPT_BLKSIZE:
+			blksize = get_image_align(optarg);
+			break;
+		case OPT_GEOMETRY:
+			blksize = get_geometry_blksize(optarg);
+			break;
+		case OPT_TRACE:
+			snprintf(tracefile, sizeof(tracefile), "%s", optarg);
+			break;
+		case 'f':
+			fflag = 1;
+			break;
+		case 'o':
+			snprintf(outfile, sizeof(outfile), "%s", optarg);
+			break;
+		default:
+			reorder_usage();
+		}
+	}
+	argc -= optind;
+	argv += optind;
+	free(opts);
+
+	if (argc == 0 || tracefile[0] == '\0')
+		reorder_usage();
+
+	if (outfile[0] != '\0' && access(outfile, F_OK) == 0 && !fflag)
+		log_errx("File %s already exists, use --force to overwrite it",
+		    outfile);
+
+	if (outfile[0] == '\0')
+		snprintf(outfile, sizeof(outfile), "%s", argv[0]);
+
+	/* Only keep the parsed FIP mapped when it is not being rewritten. */
+	parse_fip(argv[0], &toc_header, strcmp(outfile, argv[0]) != 0);
+
+	trace = read_trace_file(tracefile, &nr_trace);
+	reorder_image_descs_trace(trace, nr_trace);
+	free_trace(trace, nr_trace);
+
+	pack_images(outfile, toc_header.flags, align, blksize);
+	return 0;
+}
+
+static void reorder_usage(void)
+{
+	int i;
+
+	printf("fiptool reorder --trace FILENAME [opts] FIP_FILENAME\n");
+	printf("\n");
+	printf("Options:\n");
+	printf("  --align <value>\tEach image is aligned to <value> (default: 1).\n");
+	printf("  --block-size <value>\tPack for a device with <value>-byte blocks: an image\n");
+	printf("\t\t\tthat fits in the tail of the previous block is packed\n");
+	printf("\t\t\twithout padding, anything else starts on a block boundary.\n");
+	printf("  --force\t\tIf the output FIP file already exists, use --force to overwrite it.\n");
+	printf("  --geometry <type>\tShorthand for --block-size by device type:\n");
+	for (i = 0; i < NELEM(geometries); i++)
+		printf("\t\t\t  %-8s %lu bytes\n", geometries[i].name,
+		    geometries[i].blksize);
+	printf("  --out FIP_FILENAME\tSet an alternative output FIP file.\n");
+	printf("  --trace FILENAME\tAccess trace to lay the images out by: one ToC entry\n");
+	printf("\t\t\tcommand line name or UUID per line, in the order a debug\n");
+	printf("\t\t\tBL2 build reported opening them. '#' starts a comment.\n");
+	printf("\t\t\tImages not in the trace are placed last.\n");
+	exit(1);
+}
+
+/*
+ * Split a flashable image into the two per-device images of a dual-flash
+ * (byte-interleaved) QSPI layout: even bytes go to the first flash, odd
+ * bytes to the second. An odd-sized input is padded with 0xFF (erased
+ * flash) so both halves are the same size.
+ */
+static int interleave_cmd(int argc, char *argv[])
+{
+	struct option *opts = NULL;
+	size_t nr_opts = 0;
+	struct BLD_PLAT_STAT st;
+	FILE *fp;
+	unsigned char *buf, *half[2];
+	size_t size, half_size, i;
+	int fflag = 0;
+	int j;
+
+	if (argc < 2)
+		interleave_usage();
+
+	opts = add_opt(opts, &nr_opts, "force", no_argument, 'f');
+	opts = add_opt(opts, &nr_opts, NULL, 0, 0);
+
+	while (1) {
+		int c, opt_index = 0;
+
+		c = getopt_long(argc, argv, "f", opts, &opt_index);
+		if (c == -1)
+			break;
+
+		switch (c) {
+		case 'f':
+			fflag = 1;
+			break;
+		default:
+			interleave_usage();
+		}
+	}
+	argc -= optind;
+	argv += optind;
+	free(opts);
+
+	if (argc != 3)
+		interleave_usage();
+
+	for (j = 1; j < 3; j++)
+		if (access(argv[j], F_OK) == 0 && !fflag)
+			log_errx("File %s already exists, "
+			    "use --force to overwrite it", argv[j]);
+
+	fp = fopen(argv[0], "rb");
+	if (fp == NULL)
+		log_err("fopen %s", argv[0]);
+
+	if (fstat(fileno(fp), &st) == -1)
+		log_err("fstat %s", argv[0]);
+
+	size = st.st_size;
+	buf = xmalloc(size, "failed to load file into memory");
+	if (fread(buf, 1, size, fp) != size)
+		log_errx("Failed to read %s", argv[0]);
+	fclose(fp);
+
+	half_size = (size + 1) / 2;
+	half[0] = xmalloc(half_size, "failed to allocate even half");
+	half[1] = xmalloc(half_size, "failed to allocate odd half");
+	half[0][half_size - 1] = 0xFF;
+	half[1][half_size - 1] = 0xFF;
+
+	for (i = 0; i < size; i++)
+		half[i & 1][i / 2] = buf[i];
+
+	for (j = 0; j < 2; j++) {
+		fp = fopen(argv[j + 1], "wb");
+		if (fp == NULL)
+			log_err("fopen %s", argv[j + 1]);
+		xfwrite(half[j], half_size, fp, argv[j + 1]);
+		fclose(fp);
+		free(half[j]);
+	}
+	free(buf);
+
+	if (verbose)
+		log_dbgx("Split %zu bytes into two %zu-byte flash images",
+		    size, half_size);
+
+	return 0;
+}
+
+static void interleave_usage(void)
+{
+	printf("fiptool interleave [--force] IMAGE FLASH0_FILENAME FLASH1_FILENAME\n");
+	printf("\n");
+	printf("Splits IMAGE into the two per-device images of a dual-flash\n");
+	printf("(byte-interleaved) QSPI layout: even bytes of IMAGE go to\n");
+	printf("FLASH0_FILENAME, odd bytes to FLASH1_FILENAME. An odd-sized\n");
+	printf("image is padded with 0xFF.\n");
+	printf("\n");
+	printf("Options:\n");
+	printf("  --force\tOverwrite the output files if they already exist.\n");
+	exit(1);
+}
+
 static int version_cmd(int argc, char *argv[])
 {
 #ifdef VERSION
@@ -1176,6 +2205,10 @@ static void usage(void)
 	printf("  update\tUpdate an existing FIP with the given images.\n");
 	printf("  unpack\tUnpack images from FIP.\n");
 	printf("  remove\tRemove images from FIP.\n");
+	printf("  reorder\tRewrite a FIP with image order and padding optimized for a\n");
+	printf("\t\trecorded access trace and the boot device geometry.\n");
+	printf("  interleave\tSplit an image into the two per-device images of a\n");
+	printf("\t\tdual-flash (byte-interleaved) QSPI layout.\n");
 	printf("  version\tShow fiptool version.\n");
 	printf("  help\t\tShow help for given command.\n");
 	exit(1);
@@ -1226,5 +2259,8 @@ int main(int argc, char *argv[])
 	if (i == NELEM(cmds))
 		usage();
 	free_image_descs();
+#ifndef _MSC_VER
+	unmap_files();
+#endif
 	return ret;
 }
@@ -30,12 +30,18 @@ enum {
 	LOG_ERR
 };
 
+struct stm32image_params;
+
 typedef struct image_desc {
 	uuid_t             uuid;
 	char              *name;
 	char              *cmdline_name;
 	int                action;
 	char              *action_arg;
+	/* Set when the image gets an STM32 boot header while packing. */
+	struct stm32image_params *stm32_params;
+	/* ToC entry flags to apply when packing, e.g. the --comp tag. */
+	uint64_t           toc_flags;
 	struct image      *image;
 	struct image_desc *next;
 } image_desc_t;
@@ -43,6 +49,8 @@ typedef struct image_desc {
 typedef struct image {
 	struct fip_toc_entry toc_e;
 	void                *buffer;
+	/* Nonzero when buffer points into a file mapping, not the heap. */
+	int                  mapped;
 } image_t;
 
 typedef struct cmd {
@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Layout generator for the MEMPOOL_LAYOUT placement replay. Feed it a
+ * boot log recorded with MEMPOOL_LAYOUT=1 and no layout bound - the
+ * pools then print one line per persistent allocation:
+ *
+ *   MEMPOOL bounce_pool #0 size 512 align 64
+ *
+ * and it writes, on stdout, the C file implementing
+ * plat_mempool_layout() with a conflict-minimized offset for every
+ * allocation:
+ *
+ *   poolplan <boot log> > plat/.../plat_pool_layout.c
+ *
+ * Offsets are chosen greedily in allocation order: each buffer goes to
+ * the lowest aligned non-overlapping offset whose cache lines land on
+ * the least crowded cache sets, so same-set pile-ups from buffers that
+ * share large alignments are spread out instead of conflicting. The
+ * geometry defaults to a 64-byte line and 128 sets (32 KB 4-way L1);
+ * override with -l and -s.
+ */
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_POOLS	8
+#define MAX_ALLOCS	512
+#define MAX_CANDIDATES	1024
+
+struct alloc {
+	unsigned long size;
+	unsigned long align;
+	unsigned long offset;
+};
+
+struct pool {
+	char name[64];
+	struct alloc allocs[MAX_ALLOCS];
+	size_t count;
+};
+
+static struct pool pools[MAX_POOLS];
+static size_t pool_count;
+
+static unsigned long line_size = 64;
+static unsigned long num_sets = 128;
+
+static struct pool *get_pool(const char *name)
+{
+	size_t i;
+
+	for (i = 0; i < pool_count; i++)
+		if (strcmp(pools[i].name, name) == 0)
+			return &pools[i];
+
+	if (pool_count == MAX_POOLS) {
+		fprintf(stderr, "Too many pools (max %d)\n", MAX_POOLS);
+		exit(1);
+	}
+
+	snprintf(pools[pool_count].name, sizeof(pools[pool_count].name),
+		 "%s", name);
+	return &pools[pool_count++];
+}
+
+static int parse_log(FILE *f)
+{
+	char record[512];
+
+	while (fgets(record, sizeof(record), f) != NULL) {
+		char name[64];
+		unsigned long idx, size, align;
+		struct pool *pool;
+		const char *p = strstr(record, "MEMPOOL ");
+
+		if (p == NULL)
+			continue;
+		if (sscanf(p, "MEMPOOL %63s #%lu size %lu align %lu",
+			   name, &idx, &size, &align) != 4)
+			continue;
+
+		pool = get_pool(name);
+		if (idx != pool->count) {
+			fprintf(stderr,
+				"%s: allocation #%lu out of order "
+				"(expected #%zu)\n", name, idx, pool->count);
+			return -1;
+		}
+		if (pool->count == MAX_ALLOCS) {
+			fprintf(stderr, "%s: too many allocations\n", name);
+			return -1;
+		}
+
+		pool->allocs[pool->count].size = size;
+		pool->allocs[pool->count].align = align;
+		pool->count++;
+	}
+
+	return 0;
+}
+
+static int overlaps(const struct pool *pool, size_t placed,
+		    unsigned long offset, unsigned long size)
+{
+	size_t i;
+
+	for (i = 0; i < placed; i++) {
+		const struct alloc *a = &pool->allocs[i];
+
+		if (offset < (a->offset + a->size) &&
+		    a->offset < (offset + size))
+			return 1;
+	}
+
+	return 0;
+}
+
+static unsigned long conflict(const unsigned long *set_load,
+			      unsigned long offset, unsigned long size)
+{
+	unsigned long first = offset / line_size;
+	unsigned long last = (offset + size - 1) / line_size;
+	unsigned long score = 0, l;
+
+	for (l = first; l <= last; l++)
+		score += set_load[l % num_sets];
+
+	return score;
+}
+
+static void place_pool(struct pool *pool)
+{
+	unsigned long *set_load = calloc(num_sets, sizeof(*set_load));
+	size_t i;
+
+	if (set_load == NULL)
+		exit(1);
+
+	for (i = 0; i < pool->count; i++) {
+		struct alloc *a = &pool->allocs[i];
+		unsigned long best = 0, best_score = ~0ul;
+		unsigned long c, tried, l;
+
+		for (c = 0, tried = 0; tried < MAX_CANDIDATES;
+		     c += a->align) {
+			unsigned long score;
+
+			if (overlaps(pool, i, c, a->size))
+				continue;
+			tried++;
+
+			score = conflict(set_load, c, a->size);
+			if (score < best_score) {
+				best_score = score;
+				best = c;
+			}
+			if (score == 0)
+				break;
+		}
+
+		a->offset = best;
+		for (l = best / line_size;
+		     l <= ((best + a->size - 1) / line_size); l++)
+			set_load[l % num_sets]++;
+	}
+
+	free(set_load);
+}
+
+static void emit(void)
+{
+	size_t i, j;
+
+	printf("/*\n"
+	       " * Generated by tools/poolplan, do not edit. Regenerate\n"
+	       " * from a reference boot log when the allocation sequence\n"
+	       " * of a pool changes.\n"
+	       " */\n\n"
+	       "#include <string.h>\n\n"
+	       "#include <lib/mempool.h>\n");
+
+	for (i = 0; i < pool_count; i++) {
+		const struct pool *pool = &pools[i];
+
+		printf("\nstatic const struct mempool_layout_entry "
+		       "%s_entries[] = {\n", pool->name);
+		for (j = 0; j < pool->count; j++)
+			printf("\t{ %lu, %lu, %lu },\n",
+			       pool->allocs[j].size, pool->allocs[j].align,
+			       pool->allocs[j].offset);
+		printf("};\n\nstatic const struct mempool_layout "
+		       "%s_layout = {\n\t\"%s\", %zu, %s_entries,\n};\n",
+		       pool->name, pool->name, pool->count, pool->name);
+	}
+
+	printf("\nconst struct mempool_layout *"
+	       "plat_mempool_layout(const char *pool)\n{\n");
+	for (i = 0; i < pool_count; i++)
+		printf("\tif (strcmp(pool, \"%s\") == 0) {\n"
+		       "\t\treturn &%s_layout;\n\t}\n",
+		       pools[i].name, pools[i].name);
+	printf("\n\treturn NULL;\n}\n");
+}
+
+int main(int argc, char **argv)
+{
+	const char *log_path = NULL;
+	FILE *f;
+	int i;
+
+	for (i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "-l") == 0 && (i + 1) < argc)
+			line_size = strtoul(argv[++i], NULL, 0);
+		else if (strcmp(argv[i], "-s") == 0 && (i + 1) < argc)
+			num_sets = strtoul(argv[++i], NULL, 0);
+		else if (log_path == NULL)
+			log_path = argv[i];
+		else
+			log_path = "";
+	}
+
+	if (log_path == NULL || log_path[0] == '\0' ||
+	    line_size == 0 || num_sets == 0) {
+		fprintf(stderr,
+			"Usage: %s [-l line_size] [-s cache_sets]"
+			" <boot log>\n", argv[0]);
+		return 1;
+	}
+
+	f = fopen(log_path, "r");
+	if (f == NULL) {
+		fprintf(stderr, "Cannot open %s: %s\n", log_path,
+			strerror(errno));
+		return 1;
+	}
+
+	if (parse_log(f) != 0) {
+		fclose(f);
+		return 1;
+	}
+	fclose(f);
+
+	if (pool_count == 0) {
+		fprintf(stderr, "%s: no MEMPOOL records found\n", log_path);
+		return 1;
+	}
+
+	for (i = 0; (size_t)i < pool_count; i++)
+		place_pool(&pools[i]);
+
+	emit();
+
+	return 0;
+}
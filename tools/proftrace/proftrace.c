@@ -0,0 +1,288 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Decoder for the PROF_INSTRUMENT function trace rings. Feed it a raw
+ * dump of the trace region, e.g. taken with dd from /dev/mem, and one
+ * nm -n listing per traced image:
+ *
+ *   proftrace <region dump file> <bl2 nm -n listing> [<bl32 listing>]
+ *
+ * The enter/exit stream of each ring is replayed against the matching
+ * symbol list and the per-function call counts, self cycles (excluding
+ * callees) and cumulative cycles are printed, hottest self time first.
+ * See include/common/prof_trace.h for the ring layout.
+ */
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <common/prof_trace.h>
+
+#define MAX_STACK	512
+
+struct symbol {
+	uint32_t addr;
+	char *name;
+	uint64_t calls;
+	uint64_t self;
+	uint64_t cum;
+};
+
+struct symtab {
+	struct symbol *syms;
+	size_t count;
+};
+
+struct frame {
+	size_t sym;
+	uint32_t enter_cycles;
+	uint64_t child;
+};
+
+static uint32_t get_u32(const uint8_t *p)
+{
+	return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+	       ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static int load_symbols(const char *path, struct symtab *tab)
+{
+	char line[512];
+	size_t cap = 0;
+	FILE *f;
+
+	f = fopen(path, "r");
+	if (f == NULL) {
+		fprintf(stderr, "Cannot open %s: %s\n", path,
+			strerror(errno));
+		return -1;
+	}
+
+	tab->syms = NULL;
+	tab->count = 0;
+
+	while (fgets(line, sizeof(line), f) != NULL) {
+		unsigned long long addr;
+		char type;
+		char name[256];
+
+		if (sscanf(line, "%llx %c %255s", &addr, &type, name) != 3)
+			continue;
+		/* Only function symbols attribute cycles */
+		if (type != 'T' && type != 't' && type != 'W' && type != 'w')
+			continue;
+
+		if (tab->count == cap) {
+			cap = (cap == 0) ? 1024 : (cap * 2);
+			tab->syms = realloc(tab->syms,
+					    cap * sizeof(*tab->syms));
+			if (tab->syms == NULL) {
+				fclose(f);
+				return -1;
+			}
+		}
+
+		memset(&tab->syms[tab->count], 0, sizeof(*tab->syms));
+		tab->syms[tab->count].addr = (uint32_t)addr;
+		tab->syms[tab->count].name = strdup(name);
+		tab->count++;
+	}
+
+	fclose(f);
+
+	if (tab->count == 0) {
+		fprintf(stderr, "%s: no function symbols found\n", path);
+		return -1;
+	}
+
+	return 0;
+}
+
+/* nm -n output is sorted: greatest symbol address not above pc */
+static size_t lookup(const struct symtab *tab, uint32_t pc)
+{
+	size_t lo = 0, hi = tab->count;
+
+	if (pc < tab->syms[0].addr)
+		return tab->count;
+
+	while ((hi - lo) > 1) {
+		size_t mid = lo + ((hi - lo) / 2);
+
+		if (tab->syms[mid].addr <= pc)
+			lo = mid;
+		else
+			hi = mid;
+	}
+
+	return lo;
+}
+
+static void replay_ring(const uint8_t *rec, uint32_t count,
+			struct symtab *tab)
+{
+	struct frame stack[MAX_STACK];
+	int depth = 0;
+	uint32_t i;
+
+	for (i = 0; i < count; i++, rec += 8) {
+		uint32_t addr = get_u32(rec);
+		uint32_t cycles = get_u32(rec + 4);
+		size_t sym = lookup(tab, addr & ~(uint32_t)1);
+
+		if (sym == tab->count)
+			continue;
+
+		if ((addr & PROF_TRACE_REC_EXIT) == 0) {
+			if (depth == MAX_STACK)
+				continue;
+			stack[depth].sym = sym;
+			stack[depth].enter_cycles = cycles;
+			stack[depth].child = 0;
+			depth++;
+			continue;
+		}
+
+		/*
+		 * Unwind to the matching frame: a function that never
+		 * returns (panic paths) leaves its callers unpaired.
+		 */
+		while (depth > 0 && stack[depth - 1].sym != sym)
+			depth--;
+
+		if (depth > 0) {
+			struct frame *fr = &stack[--depth];
+			uint32_t total = cycles - fr->enter_cycles;
+			uint64_t self = (uint64_t)total - fr->child;
+
+			tab->syms[sym].calls++;
+			tab->syms[sym].self += self;
+			tab->syms[sym].cum += total;
+			if (depth > 0)
+				stack[depth - 1].child += total;
+		}
+	}
+}
+
+static int cmp_self(const void *a, const void *b)
+{
+	const struct symbol *sa = a, *sb = b;
+
+	return (sa->self < sb->self) - (sa->self > sb->self);
+}
+
+static void print_table(struct symtab *tab)
+{
+	size_t i;
+
+	qsort(tab->syms, tab->count, sizeof(*tab->syms), cmp_self);
+
+	printf("  %12s %14s %14s  %s\n", "calls", "self cycles",
+	       "cum cycles", "function");
+	for (i = 0; i < tab->count; i++) {
+		const struct symbol *s = &tab->syms[i];
+
+		if (s->calls == 0)
+			continue;
+		printf("  %12llu %14llu %14llu  %s\n",
+		       (unsigned long long)s->calls,
+		       (unsigned long long)s->self,
+		       (unsigned long long)s->cum, s->name);
+	}
+}
+
+static void reset_counts(struct symtab *tab)
+{
+	size_t i;
+
+	for (i = 0; i < tab->count; i++) {
+		tab->syms[i].calls = 0;
+		tab->syms[i].self = 0;
+		tab->syms[i].cum = 0;
+	}
+}
+
+int main(int argc, char **argv)
+{
+	struct symtab bl2_tab = { NULL, 0 }, bl32_tab = { NULL, 0 };
+	uint8_t *buf;
+	size_t size, off;
+	long fsize;
+	FILE *f;
+
+	if (argc < 3 || argc > 4) {
+		fprintf(stderr,
+			"Usage: %s <region dump file> <bl2 nm -n listing>"
+			" [<bl32 listing>]\n", argv[0]);
+		return 1;
+	}
+
+	f = fopen(argv[1], "rb");
+	if (f == NULL) {
+		fprintf(stderr, "Cannot open %s: %s\n", argv[1],
+			strerror(errno));
+		return 1;
+	}
+	fseek(f, 0, SEEK_END);
+	fsize = ftell(f);
+	fseek(f, 0, SEEK_SET);
+	if (fsize <= 0) {
+		fclose(f);
+		fprintf(stderr, "%s: empty dump\n", argv[1]);
+		return 1;
+	}
+	buf = malloc((size_t)fsize);
+	if (buf == NULL || fread(buf, 1, (size_t)fsize, f) != (size_t)fsize) {
+		fclose(f);
+		fprintf(stderr, "%s: read failed\n", argv[1]);
+		return 1;
+	}
+	fclose(f);
+	size = (size_t)fsize;
+
+	if (load_symbols(argv[2], &bl2_tab) != 0)
+		return 1;
+	if (argc == 4 && load_symbols(argv[3], &bl32_tab) != 0)
+		return 1;
+
+	for (off = 0; (off + 32) <= size; ) {
+		uint32_t image = get_u32(buf + off + 4);
+		uint32_t capacity = get_u32(buf + off + 12);
+		uint32_t count = get_u32(buf + off + 16);
+		uint32_t dropped = get_u32(buf + off + 20);
+		struct symtab *tab;
+
+		if (get_u32(buf + off) != PROF_TRACE_MAGIC) {
+			off += 8;
+			continue;
+		}
+
+		if (count > capacity ||
+		    (off + 32 + ((size_t)count * 8)) > size)
+			break;
+
+		tab = (image == PROF_TRACE_IMG_BL32 && bl32_tab.count != 0) ?
+		      &bl32_tab : &bl2_tab;
+
+		printf("ring: image %s cpu %u, %u record(s), %u dropped\n",
+		       (image == PROF_TRACE_IMG_BL32) ? "BL32" : "BL2",
+		       get_u32(buf + off + 8), count, dropped);
+		if (dropped != 0)
+			printf("  (ring filled, tail of the run lost)\n");
+
+		reset_counts(tab);
+		replay_ring(buf + off + 32, count, tab);
+		print_table(tab);
+
+		off += 32 + ((size_t)capacity * 8);
+	}
+
+	return 0;
+}
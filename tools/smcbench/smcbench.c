@@ -0,0 +1,146 @@
+// SPDX-License-Identifier: (BSD-3-Clause OR GPL-2.0)
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * Linux driver for the TF-A SMC benchmark runtime service (BENCH_SVC=1).
+ *
+ * Reading /sys/kernel/debug/smcbench/echo runs a burst of BENCH_SVC_ECHO
+ * calls and prints min/avg/max round-trip latency with a log2 histogram.
+ * Reading /sys/kernel/debug/smcbench/echo_ts does the same with
+ * BENCH_SVC_ECHO_TS and additionally fetches the EL3 entry/exit
+ * time-stamps of the last call through the PMF SMC interface, splitting
+ * the round trip into entry path, EL3 residency and exit path. The PMF
+ * time-stamps are generic counter values (unless the firmware was built
+ * with PMF_CYCLE_COUNTER) and share the time base with CNTVCT read here.
+ *
+ * PSCI suspend/resume latency comes from the rt_instr_svc PMF service
+ * when the firmware is built with ENABLE_RUNTIME_INSTRUMENTATION=1; the
+ * same PMF fetch helper below applies with service ID 1.
+ *
+ * Build against the target kernel tree:
+ *   make -C <kernel-dir> M=$(pwd) modules
+ */
+
+#include <linux/arm-smccc.h>
+#include <linux/debugfs.h>
+#include <linux/ktime.h>
+#include <linux/module.h>
+#include <linux/seq_file.h>
+#include <linux/slab.h>
+
+#define BENCH_SVC_ECHO		0x84000041U
+#define BENCH_SVC_ECHO_TS	0x84000042U
+
+#define PMF_SMC_GET_TIMESTAMP	0x82000010U
+#define PMF_IMPL_ID_ARM_TIF	0x41U
+#define PMF_BENCH_SVC_ID	5U
+#define BENCH_TS_ENTER		0U
+#define BENCH_TS_EXIT		1U
+
+#define HIST_BUCKETS		16U
+
+static unsigned int iterations = 10000;
+module_param(iterations, uint, 0644);
+MODULE_PARM_DESC(iterations, "SMC calls per measurement burst");
+
+static struct dentry *smcbench_dir;
+
+/* PMF time-stamp identifier: impl[31:24] svc[15:10] tid[7:0] */
+static u32 pmf_tid(u32 svc, u32 tid)
+{
+	return (PMF_IMPL_ID_ARM_TIF << 24) | (svc << 10) | tid;
+}
+
+static int pmf_get_timestamp(u32 svc, u32 tid, u64 *ts)
+{
+	struct arm_smccc_res res;
+
+	arm_smccc_smc(PMF_SMC_GET_TIMESTAMP, pmf_tid(svc, tid),
+		      read_cpuid_mpidr(), 0, 0, 0, 0, 0, &res);
+	if ((long)res.a0 != 0)
+		return -ENXIO;
+
+	*ts = ((u64)res.a2 << 32) | res.a1;
+	return 0;
+}
+
+static void bench_run(struct seq_file *s, u32 fid)
+{
+	u64 hist[HIST_BUCKETS] = { 0 };
+	u64 min = U64_MAX, max = 0, total = 0;
+	struct arm_smccc_res res;
+	unsigned int i;
+
+	for (i = 0; i < iterations; i++) {
+		u64 t0, dt;
+
+		t0 = ktime_get_ns();
+		arm_smccc_smc(fid, i, 0, 0, 0, 0, 0, 0, &res);
+		dt = ktime_get_ns() - t0;
+
+		if ((long)res.a0 != 0) {
+			seq_printf(s, "SMC 0x%x failed: %ld (BENCH_SVC=1 firmware?)\n",
+				   fid, (long)res.a0);
+			return;
+		}
+
+		min = min(min, dt);
+		max = max(max, dt);
+		total += dt;
+		hist[min_t(unsigned int, fls64(dt), HIST_BUCKETS - 1)]++;
+	}
+
+	seq_printf(s, "fid 0x%x calls %u min %lluns avg %lluns max %lluns\n",
+		   fid, iterations, min, total / iterations, max);
+
+	for (i = 0; i < HIST_BUCKETS; i++) {
+		if (hist[i] == 0)
+			continue;
+		seq_printf(s, "  < %8lluns: %llu\n", 1ULL << i, hist[i]);
+	}
+}
+
+static int echo_show(struct seq_file *s, void *unused)
+{
+	bench_run(s, BENCH_SVC_ECHO);
+	return 0;
+}
+DEFINE_SHOW_ATTRIBUTE(echo);
+
+static int echo_ts_show(struct seq_file *s, void *unused)
+{
+	u64 enter, exit;
+
+	bench_run(s, BENCH_SVC_ECHO_TS);
+
+	if (pmf_get_timestamp(PMF_BENCH_SVC_ID, BENCH_TS_ENTER, &enter) ||
+	    pmf_get_timestamp(PMF_BENCH_SVC_ID, BENCH_TS_EXIT, &exit)) {
+		seq_puts(s, "no PMF time-stamps (ENABLE_PMF=1 firmware?)\n");
+		return 0;
+	}
+
+	seq_printf(s, "last call: el3 enter %llu exit %llu residency %llu ticks\n",
+		   enter, exit, exit - enter);
+	return 0;
+}
+DEFINE_SHOW_ATTRIBUTE(echo_ts);
+
+static int __init smcbench_init(void)
+{
+	smcbench_dir = debugfs_create_dir("smcbench", NULL);
+	debugfs_create_file("echo", 0444, smcbench_dir, NULL, &echo_fops);
+	debugfs_create_file("echo_ts", 0444, smcbench_dir, NULL,
+			    &echo_ts_fops);
+	return 0;
+}
+
+static void __exit smcbench_exit(void)
+{
+	debugfs_remove_recursive(smcbench_dir);
+}
+
+module_init(smcbench_init);
+module_exit(smcbench_exit);
+
+MODULE_DESCRIPTION("TF-A SMC benchmark service driver");
+MODULE_LICENSE("Dual BSD/GPL");
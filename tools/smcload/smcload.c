@@ -0,0 +1,258 @@
+// SPDX-License-Identifier: (BSD-3-Clause OR GPL-2.0)
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * Multi-core SMC load generator for soak-testing the TF-A dispatch path.
+ *
+ * Reading /sys/kernel/debug/smcload/run starts one generator thread per
+ * online CPU for 'seconds'. Each thread issues a randomized mix of SMCs
+ * drawn from weighted classes:
+ *
+ *   psci   PSCI_VERSION polls                   (always available)
+ *   echo   BENCH_SVC_ECHO with random arguments (BENCH_SVC=1 firmware)
+ *   spin   BENCH_SVC_SPIN holding EL3 for spin_ticks timer ticks, to
+ *          pile the other cores up on the secure state
+ *   sip    SiP service UID query
+ *   tos    Trusted OS calls UID query
+ *   scmi   STM32 SCMI agent0 doorbell. Default weight 0: ringing it
+ *          while the OS SCMI driver owns the SMT channel corrupts the
+ *          channel protocol, enable only on setups without that driver.
+ *
+ * Classes the firmware does not implement return SMC_UNK; they still
+ * exercise the dispatch path and are counted separately. Round-trip
+ * latency is captured per class and per CPU; the EL3-internal split of
+ * echo-class calls remains available through the PMF time-stamps of the
+ * smcbench module, whose service this generator shares.
+ *
+ * rate limits each thread to that many calls per second; 0 runs flat
+ * out.
+ *
+ * Build against the target kernel tree:
+ *   make -C <kernel-dir> M=$(pwd) modules
+ */
+
+#include <linux/arm-smccc.h>
+#include <linux/debugfs.h>
+#include <linux/delay.h>
+#include <linux/kthread.h>
+#include <linux/ktime.h>
+#include <linux/module.h>
+#include <linux/seq_file.h>
+#include <linux/slab.h>
+
+#define PSCI_VERSION_FID	0x84000000U
+#define BENCH_SVC_ECHO		0x84000041U
+#define BENCH_SVC_SPIN		0x84000043U
+#define SIP_SVC_UID		0x8200FF01U
+#define TOS_CALLS_UID		0xBF00FF01U
+#define STM32_SCMI_AGENT0	0x82002000U
+
+#define SMC_UNK			0xFFFFFFFFUL
+
+static unsigned int seconds = 10;
+module_param(seconds, uint, 0644);
+MODULE_PARM_DESC(seconds, "Soak duration per run");
+
+static unsigned int rate;
+module_param(rate, uint, 0644);
+MODULE_PARM_DESC(rate, "Calls per second per CPU, 0 = unthrottled");
+
+static unsigned int spin_ticks = 50;
+module_param(spin_ticks, uint, 0644);
+MODULE_PARM_DESC(spin_ticks, "EL3 hold time of a spin call, timer ticks");
+
+struct smc_class {
+	const char *name;
+	u32 fid;
+	unsigned int weight;
+	bool random_args;
+};
+
+static struct smc_class classes[] = {
+	{ "psci", PSCI_VERSION_FID,  4, false },
+	{ "echo", BENCH_SVC_ECHO,    4, true  },
+	{ "spin", BENCH_SVC_SPIN,    1, false },
+	{ "sip",  SIP_SVC_UID,       2, false },
+	{ "tos",  TOS_CALLS_UID,     1, false },
+	{ "scmi", STM32_SCMI_AGENT0, 0, false },
+};
+
+module_param_named(wt_psci, classes[0].weight, uint, 0644);
+module_param_named(wt_echo, classes[1].weight, uint, 0644);
+module_param_named(wt_spin, classes[2].weight, uint, 0644);
+module_param_named(wt_sip,  classes[3].weight, uint, 0644);
+module_param_named(wt_tos,  classes[4].weight, uint, 0644);
+module_param_named(wt_scmi, classes[5].weight, uint, 0644);
+
+struct class_stats {
+	u64 calls;
+	u64 unknown;
+	u64 min_ns;
+	u64 max_ns;
+	u64 total_ns;
+};
+
+struct cpu_stats {
+	struct task_struct *task;
+	struct class_stats cls[ARRAY_SIZE(classes)];
+};
+
+static struct cpu_stats *stats;
+static struct dentry *smcload_dir;
+
+/* xorshift32: cheap, and reproducible per CPU for a given seed */
+static u32 prng_next(u32 *state)
+{
+	u32 x = *state;
+
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	*state = x;
+	return x;
+}
+
+static unsigned int pick_class(u32 *prng, unsigned int total_weight)
+{
+	u32 draw = prng_next(prng) % total_weight;
+	unsigned int i;
+
+	for (i = 0; i < ARRAY_SIZE(classes); i++) {
+		if (draw < classes[i].weight)
+			return i;
+		draw -= classes[i].weight;
+	}
+	return 0;
+}
+
+static int smcload_thread(void *data)
+{
+	struct cpu_stats *st = data;
+	u32 prng = 0x5eed0000U + smp_processor_id();
+	unsigned int total_weight = 0;
+	u64 end, period_ns, next = 0;
+	unsigned int i;
+
+	for (i = 0; i < ARRAY_SIZE(classes); i++)
+		total_weight += classes[i].weight;
+	if (total_weight == 0)
+		return 0;
+
+	period_ns = rate ? div_u64(NSEC_PER_SEC, rate) : 0;
+	end = ktime_get_ns() + (u64)seconds * NSEC_PER_SEC;
+
+	while (!kthread_should_stop() && ktime_get_ns() < end) {
+		struct arm_smccc_res res;
+		struct class_stats *cs;
+		u64 t0, dt, a1 = 0, a2 = 0, a3 = 0;
+		unsigned int c = pick_class(&prng, total_weight);
+
+		if (classes[c].random_args) {
+			a1 = prng_next(&prng);
+			a2 = prng_next(&prng);
+			a3 = prng_next(&prng);
+		} else if (classes[c].fid == BENCH_SVC_SPIN) {
+			a1 = spin_ticks;
+		}
+
+		t0 = ktime_get_ns();
+		arm_smccc_smc(classes[c].fid, a1, a2, a3, 0, 0, 0, 0, &res);
+		dt = ktime_get_ns() - t0;
+
+		cs = &st->cls[c];
+		cs->calls++;
+		if (res.a0 == SMC_UNK)
+			cs->unknown++;
+		cs->min_ns = min_not_zero(cs->min_ns, dt);
+		cs->max_ns = max(cs->max_ns, dt);
+		cs->total_ns += dt;
+
+		if (period_ns) {
+			if (next == 0)
+				next = t0;
+			next += period_ns;
+			t0 = ktime_get_ns();
+			if (next > t0)
+				ndelay(next - t0);
+		}
+	}
+
+	while (!kthread_should_stop())
+		msleep(10);
+
+	return 0;
+}
+
+static int run_show(struct seq_file *s, void *unused)
+{
+	unsigned int cpu, i;
+
+	memset(stats, 0, nr_cpu_ids * sizeof(*stats));
+
+	for_each_online_cpu(cpu) {
+		struct task_struct *t;
+
+		t = kthread_create(smcload_thread, &stats[cpu],
+				   "smcload/%u", cpu);
+		if (IS_ERR(t))
+			continue;
+		kthread_bind(t, cpu);
+		stats[cpu].task = t;
+		wake_up_process(t);
+	}
+
+	msleep(seconds * MSEC_PER_SEC + 100);
+
+	for_each_online_cpu(cpu) {
+		if (!stats[cpu].task)
+			continue;
+		kthread_stop(stats[cpu].task);
+		stats[cpu].task = NULL;
+	}
+
+	seq_printf(s, "soak %us rate %s spin_ticks %u\n", seconds,
+		   rate ? "limited" : "unthrottled", spin_ticks);
+
+	for_each_online_cpu(cpu) {
+		seq_printf(s, "cpu%u:\n", cpu);
+		for (i = 0; i < ARRAY_SIZE(classes); i++) {
+			struct class_stats *cs = &stats[cpu].cls[i];
+
+			if (cs->calls == 0)
+				continue;
+			seq_printf(s,
+				   "  %-5s calls %8llu unk %8llu min %6lluns avg %6lluns max %8lluns\n",
+				   classes[i].name, cs->calls, cs->unknown,
+				   cs->min_ns,
+				   div64_u64(cs->total_ns, cs->calls),
+				   cs->max_ns);
+		}
+	}
+
+	return 0;
+}
+DEFINE_SHOW_ATTRIBUTE(run);
+
+static int __init smcload_init(void)
+{
+	stats = kcalloc(nr_cpu_ids, sizeof(*stats), GFP_KERNEL);
+	if (!stats)
+		return -ENOMEM;
+
+	smcload_dir = debugfs_create_dir("smcload", NULL);
+	debugfs_create_file("run", 0444, smcload_dir, NULL, &run_fops);
+
+	return 0;
+}
+
+static void __exit smcload_exit(void)
+{
+	debugfs_remove_recursive(smcload_dir);
+	kfree(stats);
+}
+
+module_init(smcload_init);
+module_exit(smcload_exit);
+
+MODULE_LICENSE("Dual BSD/GPL");
+MODULE_DESCRIPTION("Multi-core SMC load generator for TF-A soak testing");
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <libfdt.h>
+
+/*
+ * Generate a C table of pre-resolved device tree node offsets from a DTB.
+ * The table holds one entry per compatible string of every node, in tree
+ * order, so the firmware can resolve its compatible lookups with array
+ * reads instead of walking the blob at boot time.
+ */
+
+static void *read_dtb(const char *path, size_t *size)
+{
+	FILE *file;
+	void *buf;
+	long len;
+
+	file = fopen(path, "rb");
+	if (file == NULL) {
+		fprintf(stderr, "Cannot open %s: %s\n", path,
+			strerror(errno));
+		return NULL;
+	}
+
+	if ((fseek(file, 0, SEEK_END) != 0) || ((len = ftell(file)) < 0) ||
+	    (fseek(file, 0, SEEK_SET) != 0)) {
+		fprintf(stderr, "Cannot get size of %s\n", path);
+		fclose(file);
+		return NULL;
+	}
+
+	buf = malloc(len);
+	if (buf == NULL) {
+		fprintf(stderr, "Out of memory\n");
+		fclose(file);
+		return NULL;
+	}
+
+	if (fread(buf, 1, len, file) != (size_t)len) {
+		fprintf(stderr, "Cannot read %s\n", path);
+		free(buf);
+		fclose(file);
+		return NULL;
+	}
+
+	fclose(file);
+	*size = len;
+
+	return buf;
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned int count = 0U;
+	size_t dtb_size;
+	FILE *out;
+	void *fdt;
+	int offset;
+
+	if (argc != 3) {
+		fprintf(stderr, "Usage: %s <dtb file> <output C file>\n",
+			argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	fdt = read_dtb(argv[1], &dtb_size);
+	if (fdt == NULL) {
+		return EXIT_FAILURE;
+	}
+
+	if ((fdt_check_header(fdt) != 0) ||
+	    (fdt_totalsize(fdt) > dtb_size)) {
+		fprintf(stderr, "%s is not a valid DTB\n", argv[1]);
+		free(fdt);
+		return EXIT_FAILURE;
+	}
+
+	out = fopen(argv[2], "w");
+	if (out == NULL) {
+		fprintf(stderr, "Cannot create %s: %s\n", argv[2],
+			strerror(errno));
+		free(fdt);
+		return EXIT_FAILURE;
+	}
+
+	fprintf(out,
+		"/*\n"
+		" * Pre-resolved device tree node offsets, generated by\n"
+		" * stm32dtmap from %s. Do not edit.\n"
+		" */\n"
+		"\n"
+		"#include <stm32mp_dt.h>\n"
+		"\n"
+		"const struct stm32mp_dt_map_entry stm32mp_dt_map[] = {\n",
+		argv[1]);
+
+	for (offset = fdt_next_node(fdt, -1, NULL); offset >= 0;
+	     offset = fdt_next_node(fdt, offset, NULL)) {
+		const char *prop;
+		int len;
+
+		prop = fdt_getprop(fdt, offset, "compatible", &len);
+		if (prop == NULL) {
+			continue;
+		}
+
+		while (len > 0) {
+			int slen = strnlen(prop, len);
+
+			fprintf(out,
+				"\t{ .compatible = \"%s\", .offset = %d },\n",
+				prop, offset);
+			count++;
+
+			prop += slen + 1;
+			len -= slen + 1;
+		}
+	}
+
+	fprintf(out,
+		"};\n"
+		"\n"
+		"const unsigned int stm32mp_dt_map_count = %uU;\n"
+		"const unsigned int stm32mp_dt_map_dtb_size = %uU;\n",
+		count, fdt_totalsize(fdt));
+
+	fclose(out);
+	free(fdt);
+
+	return EXIT_SUCCESS;
+}
@@ -16,77 +16,37 @@
 #include <sys/types.h>
 #include <unistd.h>
 
-/* Magic = 'S' 'T' 'M' 0x32 */
-#define HEADER_MAGIC		__be32_to_cpu(0x53544D32)
-#define VER_MAJOR		2
-#define VER_MINOR		1
-#define VER_VARIANT		0
-#define HEADER_VERSION_V1	0x1
-#define TF_BINARY_TYPE		0x10
-
-/* Default option : bit0 => no signature */
-#define HEADER_DEFAULT_OPTION	(__cpu_to_le32(0x00000001))
-
-struct stm32_header {
-	uint32_t magic_number;
-	uint8_t image_signature[64];
-	uint32_t image_checksum;
-	uint8_t  header_version[4];
-	uint32_t image_length;
-	uint32_t image_entry_point;
-	uint32_t reserved1;
-	uint32_t load_address;
-	uint32_t reserved2;
-	uint32_t version_number;
-	uint32_t option_flags;
-	uint32_t ecdsa_algorithm;
-	uint8_t ecdsa_public_key[64];
-	uint8_t padding[83];
-	uint8_t binary_type;
-};
-
-static void stm32image_default_header(struct stm32_header *ptr)
-{
-	if (!ptr) {
-		return;
-	}
-
-	ptr->magic_number = HEADER_MAGIC;
-	ptr->option_flags = HEADER_DEFAULT_OPTION;
-	ptr->ecdsa_algorithm = __cpu_to_le32(1);
-	ptr->version_number = __cpu_to_le32(0);
-	ptr->binary_type = TF_BINARY_TYPE;
-}
-
-static uint32_t stm32image_checksum(void *start, uint32_t len)
-{
-	uint32_t csum = 0;
-	uint32_t hdr_len = sizeof(struct stm32_header);
-	uint8_t *p;
-
-	if (len < hdr_len) {
-		return 0;
-	}
+#include "stm32image.h"
 
-	p = (unsigned char *)start + hdr_len;
-	len -= hdr_len;
+/* Sparse format parameters, shared with the BL2 stm32image loader */
+#define SPARSE_MAGIC		0x53505253	/* 'S' 'P' 'R' 'S' */
+#define SPARSE_MAX_SEGMENTS	30
+#define SPARSE_BLOCK_SIZE	512
+/* Zero runs shorter than this are not worth an extra storage seek */
+#define SPARSE_MIN_HOLE		4096
 
-	while (len > 0) {
-		csum += *p;
-		p++;
-		len--;
-	}
-
-	return csum;
-}
+/*
+ * Sized so that header plus table fill the first 512-byte LBA exactly;
+ * packed segment data starts on the next LBA.
+ */
+struct stm32_sparse_table {
+	uint32_t magic;
+	uint32_t expanded_length;
+	uint32_t segment_count;
+	uint32_t reserved;
+	struct {
+		uint32_t offset;
+		uint32_t length;
+	} segment[SPARSE_MAX_SEGMENTS];
+};
 
 static void stm32image_print_header(const void *ptr)
 {
 	struct stm32_header *stm32hdr = (struct stm32_header *)ptr;
 
 	printf("Image Type   : ST Microelectronics STM32 V%d.%d\n",
-	       stm32hdr->header_version[VER_MAJOR],
-	       stm32hdr->header_version[VER_MINOR]);
+	       stm32hdr->header_version[STM32IMAGE_VER_MAJOR],
+	       stm32hdr->header_version[STM32IMAGE_VER_MINOR]);
 	printf("Image Size   : %lu bytes\n",
 	       (unsigned long)__le32_to_cpu(stm32hdr->image_length));
 	printf("Image Load   : 0x%08x\n",
@@ -103,32 +63,154 @@ static void stm32image_print_header(const void *ptr)
 
 static void stm32image_set_header(void *ptr, struct stat *sbuf, int ifd,
 				  uint32_t loadaddr, uint32_t ep, uint32_t ver,
-				  uint32_t major, uint32_t minor)
+				  uint32_t major, uint32_t minor,
+				  uint32_t extra_options)
 {
-	struct stm32_header *stm32hdr = (struct stm32_header *)ptr;
+	struct stm32image_params params = {
+		.loadaddr = loadaddr,
+		.entry = ep,
+		.version = ver,
+		.major = major,
+		.minor = minor,
+		.option_flags = extra_options,
+	};
+
+	stm32image_make_header((struct stm32_header *)ptr,
+			       (unsigned char *)ptr + STM32IMAGE_HEADER_SIZE,
+			       (uint32_t)sbuf->st_size - STM32IMAGE_HEADER_SIZE,
+			       &params);
+}
+
+static int stm32image_block_is_zero(const unsigned char *ptr, uint32_t len)
+{
+	while (len > 0) {
+		if (*ptr != 0) {
+			return 0;
+		}
+		ptr++;
+		len--;
+	}
+
+	return 1;
+}
+
+/*
+ * Split the payload into data segments separated by zero runs of at
+ * least SPARSE_MIN_HOLE bytes.  Returns the packed data size (segments
+ * padded to SPARSE_BLOCK_SIZE), or 0 when the payload does not shrink.
+ */
+static uint32_t stm32image_build_sparse_table(const unsigned char *ptr,
+					      uint32_t size,
+					      struct stm32_sparse_table *table)
+{
+	uint32_t off, blk, seg_start = 0, zero_run = 0, packed = 0, i;
+	int in_segment = 0;
+
+	memset(table, 0, sizeof(struct stm32_sparse_table));
+	table->magic = SPARSE_MAGIC;
+	table->expanded_length = size;
+
+	for (off = 0; off < size; off += blk) {
+		blk = size - off < SPARSE_BLOCK_SIZE ?
+			size - off : SPARSE_BLOCK_SIZE;
+
+		if (stm32image_block_is_zero(ptr + off, blk)) {
+			zero_run += blk;
+			continue;
+		}
+
+		if (!in_segment) {
+			in_segment = 1;
+			seg_start = off;
+		} else if (zero_run >= SPARSE_MIN_HOLE &&
+			   table->segment_count + 1 < SPARSE_MAX_SEGMENTS) {
+			table->segment[table->segment_count].offset = seg_start;
+			table->segment[table->segment_count].length =
+				off - zero_run - seg_start;
+			table->segment_count++;
+			seg_start = off;
+		}
+
+		zero_run = 0;
+	}
+
+	if (!in_segment) {
+		return 0;
+	}
+
+	/* Trailing zeros are dropped: no seek needed, just a shorter read */
+	table->segment[table->segment_count].offset = seg_start;
+	table->segment[table->segment_count].length =
+		size - zero_run - seg_start;
+	table->segment_count++;
+
+	for (i = 0; i < table->segment_count; i++) {
+		packed += (table->segment[i].length + SPARSE_BLOCK_SIZE - 1) &
+			~(SPARSE_BLOCK_SIZE - 1);
+	}
+
+	if (sizeof(struct stm32_sparse_table) + packed >= size) {
+		return 0;
+	}
+
+	return packed;
+}
+
+static int stm32image_write_sparse(int dest_fd,
+				   const struct stm32_sparse_table *table,
+				   const unsigned char *ptr)
+{
+	static const unsigned char pad[SPARSE_BLOCK_SIZE];
+	struct stm32_sparse_table le_table;
+	uint32_t i;
+
+	memset(&le_table, 0, sizeof(le_table));
+	le_table.magic = __cpu_to_le32(table->magic);
+	le_table.expanded_length = __cpu_to_le32(table->expanded_length);
+	le_table.segment_count = __cpu_to_le32(table->segment_count);
+	for (i = 0; i < table->segment_count; i++) {
+		le_table.segment[i].offset =
+			__cpu_to_le32(table->segment[i].offset);
+		le_table.segment[i].length =
+			__cpu_to_le32(table->segment[i].length);
+	}
+
+	if (write(dest_fd, &le_table, sizeof(le_table)) !=
+	    sizeof(le_table)) {
+		return -1;
+	}
+
+	for (i = 0; i < table->segment_count; i++) {
+		uint32_t len = table->segment[i].length;
+		uint32_t pad_len = (SPARSE_BLOCK_SIZE - len) &
+			(SPARSE_BLOCK_SIZE - 1);
+
+		if (write(dest_fd, ptr + table->segment[i].offset, len) !=
+		    (ssize_t)len) {
+			return -1;
+		}
+
+		if (pad_len && write(dest_fd, pad, pad_len) !=
+		    (ssize_t)pad_len) {
+			return -1;
+		}
+	}
 
-	stm32image_default_header(stm32hdr);
-
-	stm32hdr->header_version[VER_MAJOR] = major;
-	stm32hdr->header_version[VER_MINOR] = minor;
-	stm32hdr->load_address = __cpu_to_le32(loadaddr);
-	stm32hdr->image_entry_point = __cpu_to_le32(ep);
-	stm32hdr->image_length = __cpu_to_le32((uint32_t)sbuf->st_size -
-					     sizeof(struct stm32_header));
-	stm32hdr->image_checksum =
-		__cpu_to_le32(stm32image_checksum(ptr, sbuf->st_size));
-	stm32hdr->version_number = __cpu_to_le32(ver);
+	return 0;
 }
 
 static int stm32image_create_header_file(char *srcname, char *destname,
 					 uint32_t loadaddr, uint32_t entry,
 					 uint32_t version, uint32_t major,
-					 uint32_t minor)
+					 uint32_t minor, int sparse)
 {
 	int src_fd, dest_fd;
 	struct stat sbuf;
 	unsigned char *ptr;
 	struct stm32_header stm32image_header;
+	struct stm32_sparse_table sparse_table;
+	uint32_t packed = 0;
+	uint32_t extra_options = 0;
 
 	dest_fd = open(destname, O_RDWR | O_CREAT | O_TRUNC | O_APPEND, 0666);
 	if (dest_fd == -1) {
@@ -163,7 +245,24 @@ static int stm32image_create_header_file(char *srcname, char *destname,
 		return -1;
 	}
 
-	if (write(dest_fd, ptr, sbuf.st_size) != sbuf.st_size) {
+	if (sparse) {
+		packed = stm32image_build_sparse_table(ptr,
+						       (uint32_t)sbuf.st_size,
+						       &sparse_table);
+	}
+
+	if (packed != 0) {
+		extra_options |= STM32IMAGE_HEADER_OPTION_SPARSE;
+		if (stm32image_write_sparse(dest_fd, &sparse_table, ptr)) {
+			fprintf(stderr, "Write error on %s: %s\n", destname,
+				strerror(errno));
+			return -1;
+		}
+		printf("Sparse       : %u segments, %lu -> %lu payload bytes\n",
+		       sparse_table.segment_count,
+		       (unsigned long)sbuf.st_size,
+		       (unsigned long)(sizeof(sparse_table) + packed));
+	} else if (write(dest_fd, ptr, sbuf.st_size) != sbuf.st_size) {
 		fprintf(stderr, "Write error on %s: %s\n", destname,
 			strerror(errno));
 		return -1;
@@ -185,7 +284,7 @@ static int stm32image_create_header_file(char *srcname, char *destname,
 	}
 
 	stm32image_set_header(ptr, &sbuf, dest_fd, loadaddr, entry, version,
-			      major, minor);
+			      major, minor, extra_options);
 
 	stm32image_print_header(ptr);
 
@@ -197,11 +296,12 @@ static int stm32image_create_header_file(char *srcname, char *destname,
 int main(int argc, char *argv[])
 {
 	int opt, loadaddr = -1, entry = -1, err = 0, version = 0;
-	int major = HEADER_VERSION_V1;
+	int major = STM32IMAGE_HEADER_VERSION_V1;
 	int minor = 0;
+	int sparse = 0;
 	char *dest = NULL, *src = NULL;
 
-	while ((opt = getopt(argc, argv, ":s:d:l:e:v:m:n:")) != -1) {
+	while ((opt = getopt(argc, argv, ":s:d:l:e:v:m:n:z")) != -1) {
 		switch (opt) {
 		case 's':
 			src = optarg;
@@ -224,9 +324,12 @@ int main(int argc, char *argv[])
 		case 'n':
 			minor = strtol(optarg, NULL, 0);
 			break;
+		case 'z':
+			sparse = 1;
+			break;
 		default:
 			fprintf(stderr,
-				"Usage : %s [-s srcfile] [-d destfile] [-l loadaddr] [-e entry_point] [-m major] [-n minor]\n",
+				"Usage : %s [-s srcfile] [-d destfile] [-l loadaddr] [-e entry_point] [-m major] [-n minor] [-z]\n",
 					argv[0]);
 			return -1;
 		}
@@ -253,7 +356,8 @@ int main(int argc, char *argv[])
 	}
 
 	err = stm32image_create_header_file(src, dest, loadaddr,
-					    entry, version, major, minor);
+					    entry, version, major, minor,
+					    sparse);
 
 	return err;
 }
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2017-2020, STMicroelectronics - All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef STM32IMAGE_H
+#define STM32IMAGE_H
+
+#include <stdint.h>
+
+#define STM32IMAGE_VER_MAJOR		2
+#define STM32IMAGE_VER_MINOR		1
+#define STM32IMAGE_VER_VARIANT		0
+#define STM32IMAGE_HEADER_VERSION_V1	0x1
+#define STM32IMAGE_TF_BINARY_TYPE	0x10
+
+/* Default option : bit0 => no signature */
+#define STM32IMAGE_HEADER_DEFAULT_OPTION	0x00000001U
+/* Option bit2 => sparse payload, segment table follows the header */
+#define STM32IMAGE_HEADER_OPTION_SPARSE		0x00000004U
+
+/* All 32-bit fields are little-endian in the file */
+struct stm32_header {
+	uint32_t magic_number;
+	uint8_t image_signature[64];
+	uint32_t image_checksum;
+	uint8_t  header_version[4];
+	uint32_t image_length;
+	uint32_t image_entry_point;
+	uint32_t reserved1;
+	uint32_t load_address;
+	uint32_t reserved2;
+	uint32_t version_number;
+	uint32_t option_flags;
+	uint32_t ecdsa_algorithm;
+	uint8_t ecdsa_public_key[64];
+	uint8_t padding[83];
+	uint8_t binary_type;
+};
+
+#define STM32IMAGE_HEADER_SIZE		sizeof(struct stm32_header)
+
+/*
+ * struct stm32image_params - STM32 header parameters
+ * @loadaddr: Address the boot ROM loads the payload at
+ * @entry: Payload entry point address
+ * @version: Image version number (anti-rollback counter)
+ * @major: Header format major version
+ * @minor: Header format minor version
+ * @option_flags: Extra option flags OR'ed on top of the default options
+ */
+struct stm32image_params {
+	uint32_t loadaddr;
+	uint32_t entry;
+	uint32_t version;
+	uint32_t major;
+	uint32_t minor;
+	uint32_t option_flags;
+};
+
+/*
+ * Fill an STM32 header for the payload that follows it. @hdr and the
+ * payload need not be contiguous: the checksum is computed over
+ * @payload, so a packager can build the header in one buffer while the
+ * payload stays in a read-only file mapping.
+ */
+void stm32image_make_header(struct stm32_header *hdr, const void *payload,
+			    uint32_t payload_len,
+			    const struct stm32image_params *params);
+
+#endif /* STM32IMAGE_H */
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2017-2020, STMicroelectronics - All Rights Reserved
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <string.h>
+
+#include "stm32image.h"
+
+/* Magic = 'S' 'T' 'M' 0x32, stored as a byte sequence */
+static const uint8_t stm32image_magic[4] = { 0x53, 0x54, 0x4D, 0x32 };
+
+/*
+ * The header is written field by field in little-endian order so the
+ * library behaves the same on any build host.
+ */
+static uint32_t cpu_to_le32(uint32_t val)
+{
+	uint8_t bytes[4];
+	uint32_t le;
+
+	bytes[0] = (uint8_t)(val & 0xFF);
+	bytes[1] = (uint8_t)((val >> 8) & 0xFF);
+	bytes[2] = (uint8_t)((val >> 16) & 0xFF);
+	bytes[3] = (uint8_t)((val >> 24) & 0xFF);
+
+	memcpy(&le, bytes, sizeof(le));
+
+	return le;
+}
+
+static uint32_t stm32image_checksum(const void *payload, uint32_t len)
+{
+	const uint8_t *p = payload;
+	uint32_t csum = 0;
+
+	while (len > 0) {
+		csum += *p;
+		p++;
+		len--;
+	}
+
+	return csum;
+}
+
+void stm32image_make_header(struct stm32_header *hdr, const void *payload,
+			    uint32_t payload_len,
+			    const struct stm32image_params *params)
+{
+	memset(hdr, 0, sizeof(*hdr));
+
+	memcpy(&hdr->magic_number, stm32image_magic, sizeof(hdr->magic_number));
+	hdr->option_flags = cpu_to_le32(STM32IMAGE_HEADER_DEFAULT_OPTION |
+					params->option_flags);
+	hdr->ecdsa_algorithm = cpu_to_le32(1);
+	hdr->binary_type = STM32IMAGE_TF_BINARY_TYPE;
+	hdr->header_version[STM32IMAGE_VER_MAJOR] = (uint8_t)params->major;
+	hdr->header_version[STM32IMAGE_VER_MINOR] = (uint8_t)params->minor;
+	hdr->load_address = cpu_to_le32(params->loadaddr);
+	hdr->image_entry_point = cpu_to_le32(params->entry);
+	hdr->image_length = cpu_to_le32(payload_len);
+	hdr->image_checksum =
+		cpu_to_le32(stm32image_checksum(payload, payload_len));
+	hdr->version_number = cpu_to_le32(params->version);
+}